@@ -60,7 +60,7 @@
 /***************************************************************************************/
 #define EXCLUDE_DLG_GAP             (0)
 #define EXCLUDE_DLG_TIMER           (0)
-#define EXCLUDE_DLG_MSG             (1)
+#define EXCLUDE_DLG_MSG             (0)
 #define EXCLUDE_DLG_SEC             (1)
 #define EXCLUDE_DLG_DISS            (0)
 #define EXCLUDE_DLG_PROXR           (1)
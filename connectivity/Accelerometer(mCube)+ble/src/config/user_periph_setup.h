@@ -155,6 +155,13 @@
 #else // (other configuration)
 #endif
 
+/****************************************************************************************/
+/* MC36xx interrupt pin configuration                                                   */
+/****************************************************************************************/
+
+#define MC36XX_INT_PORT     GPIO_PORT_1
+#define MC36XX_INT_PIN      GPIO_PIN_1
+
 /***************************************************************************************/
 /* Production debug output configuration                                               */
 /***************************************************************************************/
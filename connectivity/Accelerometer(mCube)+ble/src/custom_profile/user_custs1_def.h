@@ -63,9 +63,9 @@
 #define DEF_SVC2_G_DATA_UUID_128           {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11}
 
 
-#define DEF_SVC1_ACCEL_X_DATA_CHAR_LEN     8
-#define DEF_SVC1_ACCEL_Y_DATA_CHAR_LEN     8
-#define DEF_SVC1_ACCEL_Z_DATA_CHAR_LEN     8
+#define DEF_SVC1_ACCEL_X_DATA_CHAR_LEN     2
+#define DEF_SVC1_ACCEL_Y_DATA_CHAR_LEN     2
+#define DEF_SVC1_ACCEL_Z_DATA_CHAR_LEN     2
 #define DEF_SVC2_G_DATA_CHAR_LEN           6
 
 
@@ -118,9 +118,7 @@ void periph_init(void)
 
     m_drv_i2c_init();
 
-    M_DRV_MC36XX_Init();
-#ifdef FIFO_DEMO
-    M_DRV_MC36XX_EnableFIFO(E_M_DRV_MC36XX_FIFO_CTL_ENABLE, E_M_DRV_MC36XX_FIFO_MODE_WATERMARK, FIFO_THRESHOLD);
-#endif
-    M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_CWAKE);
+    // Interrupt pin of the sensor, the sensor itself is configured by the application
+    RESERVE_GPIO(, MC36XX_INT_PORT, MC36XX_INT_PIN, PID_GPIO);
+    GPIO_ConfigurePin(MC36XX_INT_PORT, MC36XX_INT_PIN, INPUT_PULLUP, PID_GPIO, false);
 }
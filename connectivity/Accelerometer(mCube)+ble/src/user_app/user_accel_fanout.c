@@ -0,0 +1,155 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_accel_fanout.c
+ *
+ * @brief Accelerometer sample fan-out source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "user_accel_fanout.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+int16_t accel_fanout_mg(int16_t raw)
+{
+    int32_t ug = (int32_t)raw * ACCEL_FANOUT_UG_PER_LSB;
+    int32_t mg = (ug >= 0) ? ((ug + 500) / 1000) : ((ug - 500) / 1000);
+
+    if (mg > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (mg < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return (int16_t)mg;
+}
+
+void accel_fanout_subscribe(struct accel_fanout *fanout, uint8_t chr, bool enable)
+{
+    if (chr >= ACCEL_FANOUT_CHAR_NUM)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        fanout->subscribed |= 1 << chr;
+    }
+    else
+    {
+        fanout->subscribed &= ~(1 << chr);
+    }
+}
+
+uint16_t accel_fanout_period(const struct accel_fanout *fanout)
+{
+    uint16_t count = 0;
+    uint16_t period;
+    uint8_t chr;
+
+    for (chr = 0; chr < ACCEL_FANOUT_CHAR_NUM; chr++)
+    {
+        if (fanout->subscribed & (1 << chr))
+        {
+            count++;
+        }
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // count notifications every period of 10 ms units, at most ACCEL_FANOUT_NTF_PER_SEC
+    period = (count * 100 + ACCEL_FANOUT_NTF_PER_SEC - 1) / ACCEL_FANOUT_NTF_PER_SEC;
+
+    return (period < ACCEL_FANOUT_PERIOD_MIN) ? ACCEL_FANOUT_PERIOD_MIN : period;
+}
+
+static uint8_t accel_fanout_put(uint8_t *value, int16_t v)
+{
+    value[0] = (uint16_t)v & 0xFF;
+    value[1] = (uint16_t)v >> 8;
+
+    return 2;
+}
+
+uint8_t accel_fanout_value(const int16_t *raw, uint8_t chr, uint8_t *value)
+{
+    uint8_t len = 0;
+    uint8_t axis;
+
+    if (chr == ACCEL_FANOUT_G)
+    {
+        for (axis = 0; axis < 3; axis++)
+        {
+            len += accel_fanout_put(&value[len], raw[axis]);
+        }
+    }
+    else if (chr < ACCEL_FANOUT_G)
+    {
+        len = accel_fanout_put(value, accel_fanout_mg(raw[chr]));
+    }
+
+    return len;
+}
+
+uint8_t accel_fanout_tick(const struct accel_fanout *fanout, const int16_t *raw, accel_fanout_send_t send)
+{
+    uint8_t value[ACCEL_FANOUT_VALUE_MAX];
+    uint8_t sent = 0;
+    uint8_t chr;
+
+    for (chr = 0; chr < ACCEL_FANOUT_CHAR_NUM; chr++)
+    {
+        if (fanout->subscribed & (1 << chr))
+        {
+            send(chr, value, accel_fanout_value(raw, chr, value));
+            sent++;
+        }
+    }
+
+    return sent;
+}
+
+/// @} APP
@@ -0,0 +1,173 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_accel_fanout.h
+ *
+ * @brief Accelerometer sample fan-out header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_ACCEL_FANOUT_H_
+#define _USER_ACCEL_FANOUT_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * One sampling tick serves all the notified characteristics: the sensor is read once
+ * per tick and every subscribed characteristic is notified from the same sample. The
+ * axis characteristics carry the acceleration in milli-g, a signed 16-bit integer
+ * least significant byte first. The G data characteristic carries the raw X, Y and Z
+ * samples, as the Evothings application expects.
+ *
+ * The tick runs only while a characteristic is subscribed. Its period is the shortest
+ * one that keeps the notifications below ACCEL_FANOUT_NTF_PER_SEC, and never shorter
+ * than ACCEL_FANOUT_PERIOD_MIN.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Shortest tick period, in timer units of 10 ms
+#ifndef ACCEL_FANOUT_PERIOD_MIN
+#define ACCEL_FANOUT_PERIOD_MIN     (5)
+#endif
+
+/// Notifications per second for all the characteristics together
+#ifndef ACCEL_FANOUT_NTF_PER_SEC
+#define ACCEL_FANOUT_NTF_PER_SEC    (40)
+#endif
+
+/// Sensor resolution in micro-g per LSB
+#define ACCEL_FANOUT_UG_PER_LSB     (1950)
+
+/// Longest characteristic value
+#define ACCEL_FANOUT_VALUE_MAX      (6)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Notified characteristics
+enum accel_fanout_char
+{
+    ACCEL_FANOUT_X,
+    ACCEL_FANOUT_Y,
+    ACCEL_FANOUT_Z,
+    /// Raw samples of the three axes
+    ACCEL_FANOUT_G,
+    ACCEL_FANOUT_CHAR_NUM,
+};
+
+struct accel_fanout
+{
+    /// One bit per subscribed characteristic
+    uint8_t subscribed;
+};
+
+/**
+ ****************************************************************************************
+ * @brief Sends the notification of a characteristic.
+ * @param[in] chr       Characteristic, enum accel_fanout_char.
+ * @param[in] value     Value.
+ * @param[in] len       Value length.
+ ****************************************************************************************
+ */
+typedef void (*accel_fanout_send_t)(uint8_t chr, const uint8_t *value, uint8_t len);
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Converts a raw sample to milli-g, rounded to the nearest integer.
+ * @param[in] raw       Raw sample.
+ * @return Acceleration in milli-g, saturated to the int16_t range.
+ ****************************************************************************************
+ */
+int16_t accel_fanout_mg(int16_t raw);
+
+/**
+ ****************************************************************************************
+ * @brief Subscribes or unsubscribes a characteristic.
+ * @param[in] fanout    Fan-out state.
+ * @param[in] chr       Characteristic, enum accel_fanout_char.
+ * @param[in] enable    True to subscribe.
+ ****************************************************************************************
+ */
+void accel_fanout_subscribe(struct accel_fanout *fanout, uint8_t chr, bool enable);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the tick period for the current subscriptions.
+ * @param[in] fanout    Fan-out state.
+ * @return Period in timer units of 10 ms, 0 if no characteristic is subscribed.
+ ****************************************************************************************
+ */
+uint16_t accel_fanout_period(const struct accel_fanout *fanout);
+
+/**
+ ****************************************************************************************
+ * @brief Builds the value of a characteristic from a sample.
+ * @param[in] raw       Raw X, Y and Z samples.
+ * @param[in] chr       Characteristic, enum accel_fanout_char.
+ * @param[out] value    Value, ACCEL_FANOUT_VALUE_MAX bytes.
+ * @return Value length.
+ ****************************************************************************************
+ */
+uint8_t accel_fanout_value(const int16_t *raw, uint8_t chr, uint8_t *value);
+
+/**
+ ****************************************************************************************
+ * @brief Notifies every subscribed characteristic from one sample.
+ * @param[in] fanout    Fan-out state.
+ * @param[in] raw       Raw X, Y and Z samples.
+ * @param[in] send      Sends one notification.
+ * @return Number of notifications sent.
+ ****************************************************************************************
+ */
+uint8_t accel_fanout_tick(const struct accel_fanout *fanout, const int16_t *raw, accel_fanout_send_t send);
+
+/// @} APP
+
+#endif // _USER_ACCEL_FANOUT_H_
@@ -0,0 +1,192 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_accel_motion.c
+ *
+ * @brief Interrupt driven accelerometer motion pipeline source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "user_accel_motion.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// FIFO at or above the threshold, STATUS_1 register
+#define ACCEL_MOTION_STATUS_1_FIFO_THRESH   (0x40)
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Switches the sensor mode through standby, as the mode register requires.
+ ****************************************************************************************
+ */
+static void accel_motion_set_mode(e_m_drv_mc36xx_mode_t mode)
+{
+    M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_STANDBY);
+    M_DRV_MC36XX_SetMode(mode);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Updates the inactivity count from a sample.
+ ****************************************************************************************
+ */
+static void accel_motion_track(struct accel_motion *motion, const short *sample)
+{
+    bool moved = false;
+    uint8_t axis;
+
+    for (axis = 0; axis < M_DRV_MC36XX_AXES_NUM; axis++)
+    {
+        int32_t delta = (int32_t)sample[axis] - motion->anchor[axis];
+
+        if ((delta > ACCEL_MOTION_DELTA) || (delta < -ACCEL_MOTION_DELTA))
+        {
+            moved = true;
+        }
+        motion->last[axis] = sample[axis];
+    }
+
+    if (moved)
+    {
+        memcpy(motion->anchor, motion->last, sizeof(motion->anchor));
+        motion->idle = 0;
+    }
+    else if (motion->idle < ACCEL_MOTION_IDLE_SAMPLES)
+    {
+        motion->idle++;
+    }
+}
+
+int accel_motion_start(struct accel_motion *motion)
+{
+    int ret;
+    uint8_t axis;
+
+    memset(motion, 0, sizeof(struct accel_motion));
+
+    ret = M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_STANDBY);
+    if (ret == M_DRV_MC36XX_RETCODE_ERROR_SETUP)
+    {
+        return ret;
+    }
+
+    for (axis = 0; axis < M_DRV_MC36XX_AXES_NUM; axis++)
+    {
+        M_DRV_MC36XX_SetSniffThreshold(axis, ACCEL_MOTION_SNIFF_THRESHOLD);
+        M_DRV_MC36XX_SetSniffDetectCount(axis, ACCEL_MOTION_SNIFF_COUNT);
+    }
+    M_DRV_MC36XX_EnableFIFO(E_M_DRV_MC36XX_FIFO_CTL_ENABLE, E_M_DRV_MC36XX_FIFO_MODE_WATERMARK,
+                            ACCEL_MOTION_FIFO_THRESHOLD);
+    // FIFO threshold and sniff wake events on the same pin
+    M_DRV_MC36XX_ConfigINT(1, 0, 0, 0, 1);
+
+    ret = M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_CWAKE);
+    if (ret != M_DRV_MC36XX_RETCODE_SUCCESS)
+    {
+        return ret;
+    }
+
+    motion->mode = ACCEL_MOTION_WAKE;
+
+    return M_DRV_MC36XX_RETCODE_SUCCESS;
+}
+
+uint8_t accel_motion_irq(struct accel_motion *motion,
+                         short samples[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM])
+{
+    s_m_drv_mc36xx_int_t event;
+    uint8_t count = 0;
+    uint8_t i;
+    int ret;
+
+    M_DRV_MC36XX_HandleINT(&event);
+
+    if (motion->mode == ACCEL_MOTION_SNIFF)
+    {
+        if (event.bWAKE || event.bSWAKE_SNIFF)
+        {
+            accel_motion_set_mode(E_M_DRV_MC36XX_MODE_CWAKE);
+            motion->mode = ACCEL_MOTION_WAKE;
+            motion->idle = 0;
+            motion->wakes++;
+        }
+        return 0;
+    }
+
+    if ((motion->mode != ACCEL_MOTION_WAKE) || !event.bFIFO_THRESHOLD)
+    {
+        return 0;
+    }
+
+    // Bursts are read while the threshold holds, it guarantees a full burst. The event
+    // may be stale: its samples already read by the previous interrupt
+    while ((count + ACCEL_MOTION_FIFO_THRESHOLD <= M_DRV_MC36XX_FIFO_DEPTH) &&
+           (M_DRV_MC36XX_ReadReg(E_M_DRV_MC36XX_REG_STATUS_1) & ACCEL_MOTION_STATUS_1_FIFO_THRESH))
+    {
+        ret = M_DRV_MC36XX_ReadRawFIFO(&samples[count], ACCEL_MOTION_FIFO_THRESHOLD);
+        if (ret <= 0)
+        {
+            break;
+        }
+        count += ret;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        accel_motion_track(motion, samples[i]);
+    }
+
+    if (motion->idle >= ACCEL_MOTION_IDLE_SAMPLES)
+    {
+        accel_motion_set_mode(E_M_DRV_MC36XX_MODE_SNIFF);
+        motion->mode = ACCEL_MOTION_SNIFF;
+        motion->sniffs++;
+    }
+
+    return count;
+}
+
+/// @} APP
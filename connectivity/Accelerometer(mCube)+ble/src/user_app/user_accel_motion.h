@@ -0,0 +1,152 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_accel_motion.h
+ *
+ * @brief Interrupt driven accelerometer motion pipeline header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_ACCEL_MOTION_H_
+#define _USER_ACCEL_MOTION_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The MC36xx streams without any CPU timer. In wake mode the FIFO fills at the wake
+ * sample rate and raises the interrupt pin when it reaches ACCEL_MOTION_FIFO_THRESHOLD
+ * samples; the interrupt handler reads them in one burst. When no sample moves more
+ * than ACCEL_MOTION_DELTA away from the last motion for ACCEL_MOTION_IDLE_SAMPLES
+ * samples, the sensor is put in sniff mode, where it samples slowly and does not fill
+ * the FIFO. A sniff wake event on the same pin brings it back to wake mode. Inactivity
+ * is counted in samples, so the sensor itself is the clock.
+ *
+ * The FIFO, the interrupts and the sniff detection are configured once, switching mode
+ * only writes the mode register. The sensor is accessed through the mCube driver, which
+ * can be compiled on a host against a simulated bus.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include "m_drv_mc36xx.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Samples read per FIFO threshold interrupt
+#ifndef ACCEL_MOTION_FIFO_THRESHOLD
+#define ACCEL_MOTION_FIFO_THRESHOLD     (8)
+#endif
+
+/// Raw LSB an axis must move away from the last motion to count as motion
+#ifndef ACCEL_MOTION_DELTA
+#define ACCEL_MOTION_DELTA              (40)
+#endif
+
+/// Samples without motion before sniff mode, 5 s at the 54 Hz wake rate
+#ifndef ACCEL_MOTION_IDLE_SAMPLES
+#define ACCEL_MOTION_IDLE_SAMPLES       (270)
+#endif
+
+/// Sniff detection threshold and count of every axis
+#define ACCEL_MOTION_SNIFF_THRESHOLD    (3)
+#define ACCEL_MOTION_SNIFF_COUNT        (1)
+
+#if (ACCEL_MOTION_FIFO_THRESHOLD >= M_DRV_MC36XX_FIFO_DEPTH)
+#error "FIFO threshold should be less than FIFO depth"
+#endif
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+enum accel_motion_mode
+{
+    ACCEL_MOTION_STOPPED,
+    /// Streaming through the FIFO
+    ACCEL_MOTION_WAKE,
+    /// Waiting for a sniff wake event
+    ACCEL_MOTION_SNIFF,
+};
+
+struct accel_motion
+{
+    /// Mode, enum accel_motion_mode
+    uint8_t mode;
+    /// Samples since the last motion
+    uint16_t idle;
+    /// Sample of the last motion
+    int16_t anchor[M_DRV_MC36XX_AXES_NUM];
+    /// Latest sample
+    int16_t last[M_DRV_MC36XX_AXES_NUM];
+    /// Sniff to wake transitions
+    uint16_t wakes;
+    /// Wake to sniff transitions
+    uint16_t sniffs;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Configures the FIFO, the interrupts and the sniff detection, and starts
+ *        streaming in wake mode.
+ * @param[in] motion    Pipeline state.
+ * @return M_DRV_MC36XX_RETCODE_SUCCESS or the driver error.
+ ****************************************************************************************
+ */
+int accel_motion_start(struct accel_motion *motion);
+
+/**
+ ****************************************************************************************
+ * @brief Handles an interrupt of the sensor. A sniff wake event switches to wake mode.
+ *        A FIFO threshold event reads the FIFO in bursts of ACCEL_MOTION_FIFO_THRESHOLD
+ *        samples until it is below the threshold, and switches to sniff mode after
+ *        ACCEL_MOTION_IDLE_SAMPLES samples without motion.
+ * @param[in] motion    Pipeline state.
+ * @param[out] samples  Samples read.
+ * @return Number of samples read.
+ ****************************************************************************************
+ */
+uint8_t accel_motion_irq(struct accel_motion *motion,
+                         short samples[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM]);
+
+/// @} APP
+
+#endif // _USER_ACCEL_MOTION_H_
@@ -53,15 +53,25 @@
 #include "user_custs1_def.h"
 #include "user_periph_setup.h"
 #include "custs1_task.h"
+#include "wkupct_quadec.h"
+#include "app_easy_msg_utils.h"
 #include "m_drv_mc36xx.h"
-#include <math.h>
+#include "user_accel_fanout.h"
+#include "user_accel_motion.h"
+#include "user_delay.h"
 
 /*
- * TYPE DEFINITIONS
+ * DEFINES
  ****************************************************************************************
  */
 
-#define NOTIFICATION_DELAY 50 //The time interval between sent notifications
+/// Interrupt handler passes while the interrupt pin stays asserted
+#define USER_ACCEL_INT_PASSES_MAX   (4)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
 
 // Manufacturer Specific Data ADV structure type
 struct mnf_specific_data_ad_structure
@@ -72,19 +82,8 @@ struct mnf_specific_data_ad_structure
     uint8_t proprietary_data[APP_AD_MSD_DATA_LEN];
 };
 
-typedef struct {
-    short RawData[FIFO_DEEP][M_DRV_MC_UTL_AXES_NUM];
-    float fRawData[FIFO_DEEP][M_DRV_MC_UTL_AXES_NUM];
-    short DataLen;
-    uint32_t TimeStamp[FIFO_DEEP]; //ms
-}AccData;    //FIFO DEEP
-
-static AccData GensorData;
-
-#ifdef SNIFF_DEMO
-static uint8_t m_polling_counter = 0;
-static uint8_t sniff_delay = 1;
-#endif
+// Samples of one FIFO burst read
+static short accel_fifo_burst[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM];
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -94,16 +93,9 @@ static uint8_t sniff_delay = 1;
 uint8_t app_connection_idx                      __attribute__((section(".bss.")));//@RETENTION MEMORY
 timer_hnd app_adv_data_update_timer_used        __attribute__((section(".bss."))); //@RETENTION MEMORY
 timer_hnd app_param_update_request_timer_used   __attribute__((section(".bss.")));//@RETENTION MEMORY
-int16_t X_data                 __attribute__((section(".bss."))); //@RETENTION MEMORY
-int16_t Y_data                 __attribute__((section(".bss."))); //@RETENTION MEMORY
-int16_t Z_data                 __attribute__((section(".bss.")));//@RETENTION MEMORY
-uint8_t X_string[8]               __attribute__((section(".bss."))); //@RETENTION MEMORY
-uint8_t Y_string[8]               __attribute__((section(".bss."))); //@RETENTION MEMORY
-uint8_t Z_string[8]               __attribute__((section(".bss."))); //@RETENTION MEMORY
-uint8_t X_timer                   __attribute__((section(".bss.")));//@RETENTION MEMORY
-uint8_t Y_timer                   __attribute__((section(".bss.")));//@RETENTION MEMORY
-uint8_t Z_timer                   __attribute__((section(".bss."))); //@RETENTION MEMORY
-uint8_t g_timer                   __attribute__((section(".bss.")));//@RETENTION MEMORY
+timer_hnd accel_timer             __attribute__((section(".bss."))); //@RETENTION MEMORY
+struct accel_fanout accel_fanout  __attribute__((section(".bss."))); //@RETENTION MEMORY
+struct accel_motion accel_motion  __attribute__((section(".bss."))); //@RETENTION MEMORY
 // Retained variables
 struct mnf_specific_data_ad_structure mnf_data  __attribute__((section(".bss."))); //@RETENTION MEMORY
 // Index of manufacturer data in advertising data or scan response data (when MSB is 1)
@@ -118,31 +110,6 @@ uint8_t stored_scan_rsp_data[SCAN_RSP_DATA_LEN] __attribute__((section(".bss."))
  ****************************************************************************************
 */
 
-uint8_t user_int_to_string(int16_t input, uint8_t *s){
-    uint8_t length = 1;
-    if(input < 0){
-        s[0] = '-';
-    } else {
-        s[0] = ' ';
-    }
-    input = abs(input);
-    if(input  >= 10000){
-        s[length++] = '0' + ((input / 10000) % 10);
-    }
-    if(input  >= 1000){
-        s[length++] = '0' + ((input / 1000) % 10);
-    }
-    if(input  >= 100){
-        s[length++] = '0' + ((input / 100) % 10);
-    }
-    if(input  >= 10){
-        s[length++] = '0' + ((input / 10) % 10);
-    }
-
-    s[length++] = '0' + (input% 10);
-    return length;
-}
-
 /**
  ****************************************************************************************
  * @brief Initialize Manufacturer Specific Data
@@ -161,38 +128,73 @@ static void mnf_data_init()
 
 /**
  ****************************************************************************************
- * @brief Update Manufacturer Specific Data
+ * @brief Update Manufacturer Specific Data with the latest sample of the sensor
  * @return void
  ****************************************************************************************
  */
 static void mnf_data_update()
 {
-    uint8_t fifo_size = 1;
-#ifdef FIFO_DEMO
-    fifo_size = FIFO_THRESHOLD;
-#endif
-    M_DRV_MC36XX_ReadRawData(GensorData.RawData, fifo_size);
-
-#ifdef SNIFF_DEMO       //Set sensor into sniff mode after data is updated.
-    if(m_polling_counter<(32*sniff_delay)) {
-        m_polling_counter++;
-    } else {
-        M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_STANDBY);      // Set MC36XX to stanby mode
-        M_DRV_MC36XX_SetGain(E_M_DRV_MC36XX_WAKE_GAIN_LOW, E_M_DRV_MC36XX_SNIFF_GAIN_HIGH);
-        /* Orion 2X SNIFF threshold*/
-        M_DRV_MC36XX_SetSniffThreshold(M_DRV_MC36XX_AXIS_X, 3);
-        M_DRV_MC36XX_SetSniffThreshold(M_DRV_MC36XX_AXIS_Y, 3);
-        M_DRV_MC36XX_SetSniffThreshold(M_DRV_MC36XX_AXIS_Z, 3);
-        /* Sniff count set */
-        M_DRV_MC36XX_SetSniffDetectCount(M_DRV_MC36XX_AXIS_X, 1);
-        M_DRV_MC36XX_SetSniffDetectCount(M_DRV_MC36XX_AXIS_Y, 1);
-        M_DRV_MC36XX_SetSniffDetectCount(M_DRV_MC36XX_AXIS_Z, 1);
-        M_DRV_MC36XX_SetSampleRate(E_M_DRV_MC36XX_CWAKE_SR_UL_26Hz, E_M_DRV_MC36XX_SNIFF_SR_DEFAULT_6Hz);
-        M_DRV_MC36XX_ConfigINT(0,0,0,0,1);
-        M_DRV_MC36XX_SetMode(E_M_DRV_MC36XX_MODE_SNIFF);    // Initialize MC36XX
-        m_polling_counter = 0;
+    uint8_t axis;
+
+    for (axis = 0; axis < M_DRV_MC36XX_AXES_NUM; axis++)
+    {
+        mnf_data.proprietary_data[2 * axis] = accel_motion.last[axis] & 0xFF;
+        mnf_data.proprietary_data[2 * axis + 1] = (accel_motion.last[axis] >> 8) & 0xFF;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Wake-up controller callback of the interrupt pin of the sensor. The bus is
+ *        not accessed from the interrupt, the handler runs in the application task.
+ * @return void
+ ****************************************************************************************
+ */
+static void user_accel_int_cb(void)
+{
+    app_easy_wakeup();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Arms the wake-up controller on the interrupt pin of the sensor.
+ * @return void
+ ****************************************************************************************
+ */
+static void user_accel_int_enable(void)
+{
+    wkupct_register_callback(user_accel_int_cb);
+    wkupct_enable_irq(WKUPCT_PIN_SELECT(MC36XX_INT_PORT, MC36XX_INT_PIN),
+                      WKUPCT_PIN_POLARITY(MC36XX_INT_PORT, MC36XX_INT_PIN, WKUPCT_PIN_POLARITY_LOW),
+                      1,    // 1 event
+                      0);   // no debouncing
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles an interrupt of the sensor in the application task: reads the FIFO
+ *        or switches between sniff and wake mode, then arms the pin again.
+ * @return void
+ ****************************************************************************************
+ */
+static void user_accel_int_handler(void)
+{
+    uint8_t passes = 0;
+
+    // The wake-up controller only counts a new edge of the pin. An event raised while
+    // the previous one was handled keeps the pin asserted, so it is handled here.
+    do
+    {
+        accel_motion_irq(&accel_motion, accel_fifo_burst);
+
+        user_accel_int_enable();
+    } while (!GPIO_GetPinStatus(MC36XX_INT_PORT, MC36XX_INT_PIN) && (++passes < USER_ACCEL_INT_PASSES_MAX));
+
+    if (passes == USER_ACCEL_INT_PASSES_MAX)
+    {
+        // Still asserted, try again from the scheduler instead of blocking it
+        app_easy_wakeup();
     }
-#endif
 }
 
 /**
@@ -304,10 +306,17 @@ void user_app_init(void)
     stored_adv_data_len = USER_ADVERTISE_DATA_LEN;
     memcpy(stored_scan_rsp_data, USER_ADVERTISE_SCAN_RESPONSE_DATA, USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN);
     stored_scan_rsp_data_len = USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN;
-    X_timer = EASY_TIMER_INVALID_TIMER; //Initialise timer handlers
-    Y_timer = EASY_TIMER_INVALID_TIMER; //Initialise timer handlers
-    Z_timer = EASY_TIMER_INVALID_TIMER; //Initialise timer handlers
-    g_timer = EASY_TIMER_INVALID_TIMER; //Initialise timer handlers
+    accel_timer = EASY_TIMER_INVALID_TIMER; //Initialise timer handler
+
+    // The sensor reset and mode changes wait on the calibrated delay
+    user_delay_calibrate();
+
+    // Configure the sensor once, it streams on its interrupt pin from now on
+    M_DRV_MC36XX_Init();
+    accel_motion_start(&accel_motion);
+    app_easy_wakeup_set(user_accel_int_handler);
+    user_accel_int_enable();
+
     default_app_on_init();
 }
 
@@ -396,23 +405,12 @@ void user_app_disconnect(struct gapc_disconnect_ind const *param)
         app_param_update_request_timer_used = EASY_TIMER_INVALID_TIMER;
     }
 
-    // Stop the notification timers
-    if(X_timer != EASY_TIMER_INVALID_TIMER){
-        app_easy_timer_cancel(X_timer);
-        X_timer = EASY_TIMER_INVALID_TIMER;
-    }
-    if(Y_timer != EASY_TIMER_INVALID_TIMER){
-        app_easy_timer_cancel(Y_timer);
-        Y_timer = EASY_TIMER_INVALID_TIMER;
-    }
-    if(Z_timer != EASY_TIMER_INVALID_TIMER){
-        app_easy_timer_cancel(Z_timer);
-        Z_timer = EASY_TIMER_INVALID_TIMER;
-    }
-    if(g_timer != EASY_TIMER_INVALID_TIMER){
-        app_easy_timer_cancel(g_timer);
-        g_timer = EASY_TIMER_INVALID_TIMER;
+    // Stop the sampling tick, the subscriptions end with the connection
+    if(accel_timer != EASY_TIMER_INVALID_TIMER){
+        app_easy_timer_cancel(accel_timer);
+        accel_timer = EASY_TIMER_INVALID_TIMER;
     }
+    accel_fanout.subscribed = 0;
 
     // Update manufacturer data for the next advertsing event
     mnf_data_update();
@@ -420,209 +418,79 @@ void user_app_disconnect(struct gapc_disconnect_ind const *param)
     user_app_adv_start();
 }
 
-/**
- ****************************************************************************************
- * @brief User application function to send accelerometer X-axis data notification.
- * @return void
- ****************************************************************************************
-*/
-void user_svc1_accel_X_send_ntf()
+// Value handle of each characteristic of the fan-out
+static const uint16_t accel_ntf_handle[ACCEL_FANOUT_CHAR_NUM] =
 {
-    //Construct the string to send as a notification
-    mnf_data_update();
-    uint8_t string_length = user_int_to_string(GensorData.RawData[0][M_DRV_MC36XX_AXIS_X] * 1.95, X_string); //Read data and multipy by 1.95 to get acceleration in mg
-
-    //Allocate a new message
-    struct custs1_val_ntf_ind_req* req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,                   //Message id
-                                        prf_get_task_from_id(TASK_ID_CUSTS1), //Target task
-                                        TASK_APP,                             //Source of the message
-                                        custs1_val_ntf_ind_req,               //The type of structure in the message,
-                                                        //This structure should match the ID
-                                                        //The ID's and strucures are found in custs1_task.h
-                                        string_length);                       //How many bytes of data will be added
-
-    req->conidx = 0;                            //Connection ID to send the data to (this application can only have one connection(0))
-    req->notification = true;                   //Data is sent as a notification and not as indication
-    req->handle = SVC1_IDX_ACCEL_X_DATA_VAL;    //The handle of the characteristic we want to write to
-    req->length = string_length;                //Data length in bytes
-    memcpy(req->value, X_string, string_length);//Copy the string to the message
-
-    ke_msg_send(req);                           //Send the message to the task
-
-    X_timer = app_easy_timer(NOTIFICATION_DELAY / 10, user_svc1_accel_X_send_ntf); //Set a timer for 100 ms (10*10)
-}
-
-/**
- ****************************************************************************************
- * @brief User application function to set X-Axis notification handler.
- * @return void
- ****************************************************************************************
-*/
-void user_svc1_accel_X_wr_ntf_handler(struct custs1_val_write_ind const *param){
-    if(param->value[0]){
-        //If the client subscribed to the notification
-        if(X_timer == EASY_TIMER_INVALID_TIMER){
-            //Start the X timer if it is not running
-            app_easy_timer(10, user_svc1_accel_X_send_ntf);
-        }
-    }
-    else{
-        //If the client unsubscribed from the notification
-        if(X_timer != EASY_TIMER_INVALID_TIMER){
-            //Stop the X timer if it is running
-            app_easy_timer_cancel(X_timer);
-            X_timer = EASY_TIMER_INVALID_TIMER;
-        }
-    }
-}
+    [ACCEL_FANOUT_X] = SVC1_IDX_ACCEL_X_DATA_VAL,
+    [ACCEL_FANOUT_Y] = SVC1_IDX_ACCEL_Y_DATA_VAL,
+    [ACCEL_FANOUT_Z] = SVC1_IDX_ACCEL_Z_DATA_VAL,
+    [ACCEL_FANOUT_G] = SVC2_IDX_G_DATA_VAL,
+};
 
 /**
  ****************************************************************************************
- * @brief User application function to send accelerometer Y-axis data notification.
+ * @brief User application function to send the notification of an accelerometer
+ *        characteristic.
  * @return void
  ****************************************************************************************
 */
-void user_svc1_accel_Y_send_ntf()
+static void user_accel_send_ntf(uint8_t chr, const uint8_t *value, uint8_t len)
 {
-    mnf_data_update();
-    uint8_t string_length = user_int_to_string(GensorData.RawData[0][M_DRV_MC36XX_AXIS_Y] * 1.95, Y_string);
-
     struct custs1_val_ntf_ind_req* req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
                              prf_get_task_from_id(TASK_ID_CUSTS1),
                              TASK_APP,
                              custs1_val_ntf_ind_req,
-                             string_length);
+                             len);
 
-    req->conidx = 0;
+    req->conidx = app_connection_idx;
     req->notification = true;
-    req->handle = SVC1_IDX_ACCEL_Y_DATA_VAL;
-    req->length = string_length;
-    for(uint8_t i = 0; i < string_length; i++){
-        req->value[i] = Y_string[i];
-    }
+    req->handle = accel_ntf_handle[chr];
+    req->length = len;
+    memcpy(req->value, value, len);
 
     ke_msg_send(req);
-
-    Y_timer = app_easy_timer(NOTIFICATION_DELAY / 10, user_svc1_accel_Y_send_ntf); //Do this again in 100 ms (10*10)
 }
 
 /**
  ****************************************************************************************
- * @brief User application function to set Y-Axis notification handler.
+ * @brief User application timer callback function of the sampling tick. All the
+ *        subscribed characteristics are notified from the latest sample of the sensor.
  * @return void
  ****************************************************************************************
 */
-void user_svc1_accel_Y_wr_ntf_handler(struct custs1_val_write_ind const *param){
-    if(param->value[0]){
-        if(Y_timer == EASY_TIMER_INVALID_TIMER){
-            //Start the Y timer if it is not running
-            Y_timer = app_easy_timer(10, user_svc1_accel_Y_send_ntf);
-            }
-        }
-        else{
-        if(Y_timer != EASY_TIMER_INVALID_TIMER){
-            //Stop the Y timer if it is running
-            app_easy_timer_cancel(Y_timer);
-            Y_timer = EASY_TIMER_INVALID_TIMER;
-        }
-    }
-}
-
-/**
- ****************************************************************************************
- * @brief User application function to send accelerometer Z-axis data notification.
- * @return void
- ****************************************************************************************
-*/
-void user_svc1_accel_Z_send_ntf()
+static void user_accel_tick_cb(void)
 {
-    mnf_data_update();
-    uint8_t string_length = user_int_to_string(GensorData.RawData[0][M_DRV_MC36XX_AXIS_Z] * 1.95, Z_string);
-
-    struct custs1_val_ntf_ind_req* req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
-                             prf_get_task_from_id(TASK_ID_CUSTS1),
-                             TASK_APP,
-                             custs1_val_ntf_ind_req,
-                             string_length);
+    uint16_t period = accel_fanout_period(&accel_fanout);
 
-
-    req->conidx = 0;
-    req->notification = true;
-    req->handle = SVC1_IDX_ACCEL_Z_DATA_VAL;
-    req->length = string_length;
-    for(uint8_t i = 0; i < string_length; i++){
-        req->value[i] = Z_string[i];
+    accel_timer = EASY_TIMER_INVALID_TIMER;
+    if(period == 0){
+        return;
     }
 
-    ke_msg_send(req);
+    accel_fanout_tick(&accel_fanout, accel_motion.last, user_accel_send_ntf);
 
-    Z_timer = app_easy_timer(NOTIFICATION_DELAY / 10, user_svc1_accel_Z_send_ntf); //Do this again in 100 ms (10*10)
-}
-
-/**
- ****************************************************************************************
- * @brief User application function to set Z-Axis notification handler.
- * @return void
- ****************************************************************************************
-*/
-void user_svc1_accel_Z_wr_ntf_handler(struct custs1_val_write_ind const *param){
-    if(param->value[0]){
-        if(Z_timer == EASY_TIMER_INVALID_TIMER){
-            //Start the Z timer if it is not running
-            Z_timer = app_easy_timer(10, user_svc1_accel_Z_send_ntf);
-        }
-    }
-    else{
-        if(Z_timer != EASY_TIMER_INVALID_TIMER){
-            //Stop the Z timer if it is running
-            app_easy_timer_cancel(Z_timer);
-            Z_timer = EASY_TIMER_INVALID_TIMER;
-        }
-    }
+    accel_timer = app_easy_timer(period, user_accel_tick_cb);
 }
 
 /**
  ****************************************************************************************
- * @brief User application timer callback function to handle Gyro data service.
+ * @brief User application function to handle the notification configuration of an
+ *        accelerometer characteristic. Starts the sampling tick on the first
+ *        subscription and stops it on the last unsubscription.
  * @return void
  ****************************************************************************************
 */
-void user_svc2_g_timer_cb_handler(void)
-{
-    struct custs1_val_ntf_ind_req *req =
-                    KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
-                    prf_get_task_from_id(TASK_ID_CUSTS1),
-                    TASK_APP,
-                    custs1_val_ntf_ind_req,
-                    DEF_SVC2_G_DATA_CHAR_LEN);
-    mnf_data_update();
-    req->handle = SVC2_IDX_G_DATA_VAL;
-    req->length = DEF_SVC2_G_DATA_CHAR_LEN;
-    req->notification = true;
-    memcpy(req->value, GensorData.RawData, DEF_SVC2_G_DATA_CHAR_LEN);
-    ke_msg_send(req);
-    g_timer = app_easy_timer(NOTIFICATION_DELAY / 10, user_svc2_g_timer_cb_handler);
-}
+static void user_accel_wr_ntf_handler(uint8_t chr, struct custs1_val_write_ind const *param){
+    accel_fanout_subscribe(&accel_fanout, chr, param->value[0] != 0);
 
-/**
- ****************************************************************************************
- * @brief User application function to set Gyro data notification handler.
- * @return void
- ****************************************************************************************
-*/
-void user_svc2_g_wr_ntf_handler(struct custs1_val_write_ind const *param){
-    if(param->value[0]){
-        if(g_timer == EASY_TIMER_INVALID_TIMER){
-            //Start the g timer if it is not running
-            g_timer = app_easy_timer(10, user_svc2_g_timer_cb_handler);
+    if(accel_fanout_period(&accel_fanout) == 0){
+        if(accel_timer != EASY_TIMER_INVALID_TIMER){
+            app_easy_timer_cancel(accel_timer);
+            accel_timer = EASY_TIMER_INVALID_TIMER;
         }
     }
-    else{
-        if(g_timer != EASY_TIMER_INVALID_TIMER){
-            //Stop the g timer if it is running
-            app_easy_timer_cancel(g_timer);
-            g_timer = EASY_TIMER_INVALID_TIMER;
-        }
+    else if(accel_timer == EASY_TIMER_INVALID_TIMER){
+        accel_timer = app_easy_timer(accel_fanout_period(&accel_fanout), user_accel_tick_cb);
     }
 }
 
@@ -657,29 +525,22 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
         {
             struct custs1_val_write_ind const *msg_param = (struct custs1_val_write_ind const *)(param);
 
-#ifdef SNIFF_DEMO
-            if (msg_param->value[0])
-                sniff_delay++;
-            else
-                sniff_delay--;
-#endif
-
             switch (msg_param->handle)
             {
                 case SVC1_IDX_ACCEL_X_NTF_CFG:
-                    user_svc1_accel_X_wr_ntf_handler(msg_param);
+                    user_accel_wr_ntf_handler(ACCEL_FANOUT_X, msg_param);
                     break;
 
                 case SVC1_IDX_ACCEL_Y_NTF_CFG:
-                    user_svc1_accel_Y_wr_ntf_handler(msg_param);
+                    user_accel_wr_ntf_handler(ACCEL_FANOUT_Y, msg_param);
                     break;
 
                 case SVC1_IDX_ACCEL_Z_NTF_CFG:
-                    user_svc1_accel_Z_wr_ntf_handler(msg_param);
+                    user_accel_wr_ntf_handler(ACCEL_FANOUT_Z, msg_param);
                     break;
 
                 case SVC2_IDX_G_NTF_CFG:
-                    user_svc2_g_wr_ntf_handler(msg_param);
+                    user_accel_wr_ntf_handler(ACCEL_FANOUT_G, msg_param);
                     break;
 
                 default:
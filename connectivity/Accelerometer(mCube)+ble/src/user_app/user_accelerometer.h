@@ -64,20 +64,6 @@
  ****************************************************************************************
  */
 
-//#define SNIFF_DEMO            //Remove this comment to show the sniff DEMO
-//#define FIFO_DEMO             //Remove this comment to show the FIFO DEMO
-
-#if (defined (SNIFF_DEMO) && defined (FIFO_DEMO))
-#error "DO NOT ENABLE sniff and FIFO demo at the same time!"
-#endif
-
-#define FIFO_DEEP           32
-#define FIFO_THRESHOLD      5
-
-#if (FIFO_THRESHOLD >= FIFO_DEEP)
-#error "FIFO threshold should be less than FIFO deepth"
-#endif
-
 /* Duration of timer for connection parameter update request */
 #define APP_PARAM_UPDATE_REQUEST_TO         (1000)   // 1000*10ms = 10sec, The maximum allowed value is 41943sec (4194300 * 10ms)
 
@@ -89,15 +75,6 @@
 #define APP_AD_MSD_COMPANY_ID_LEN   (2)
 #define APP_AD_MSD_DATA_LEN          6
 
-/*
- * TYPE DEFINITIONS
- ****************************************************************************************
- */
-
-int16_t extern X_data;
-int16_t extern Y_data;
-int16_t extern Z_data;
-
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
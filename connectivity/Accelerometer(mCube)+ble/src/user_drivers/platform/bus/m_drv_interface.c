@@ -24,6 +24,7 @@
  *****************************************************************************/
 /** Please include interface driver from platform SDK */
 #include "user_periph_setup.h"
+#include "user_delay.h"
 
 /** mCube functions include */
 #include "m_drv_interface.h"
@@ -67,7 +68,7 @@ enum I2C_ADDRESS_MODES
 /** Delay required milliseconds */
 void mcube_delay_ms(unsigned int ms)
 {
-    /** Function hook by customer. */
+    user_delay_ms(ms);
 }
 
 /** I2C init function */
@@ -588,26 +588,21 @@ static int _M_DRV_MC36XX_SetMode(e_m_drv_mc36xx_mode_t eNextMode)
 }
 
 /******************************************************************************
- *** _M_DRV_MC36XX_ReadRawData
+ *** _M_DRV_MC36XX_UnpackRawData
  *****************************************************************************/
-static int _M_DRV_MC36XX_ReadRawData(signed short Output[M_DRV_MC36XX_AXES_NUM])
+static void _M_DRV_MC36XX_UnpackRawData(const uint8_t *pbData,              \
+                                        signed short Output[M_DRV_MC36XX_AXES_NUM])
 {
-    M_PRINTF("[%s]\r\n", __func__);
-
     signed short _waRaw[M_DRV_MC36XX_AXES_NUM] = { 0 };
-    m_drv_buffer(180) _baData = {0};
     const S_M_DRV_MC_UTIL_OrientationReMap *_ptOrienMap                     \
             = &g_MDrvUtilOrientationReMap[M_DRV_MC36XX_CFG_ORIENTATION_MAP];
 
-    _M_DRV_MC36XX_REG_READ(E_M_DRV_MC36XX_REG_XOUT_LSB,                     \
-                           (uint_dev *)_baData.words ,6);
-
-    _waRaw[M_DRV_MC36XX_AXIS_X] = ((signed short) ((_baData.bytes[0])       \
-                                                 | (_baData.bytes[1] << 8)));
-    _waRaw[M_DRV_MC36XX_AXIS_Y] = ((signed short) ((_baData.bytes[2])       \
-                                                 | (_baData.bytes[3] << 8)));
-    _waRaw[M_DRV_MC36XX_AXIS_Z] = ((signed short) ((_baData.bytes[4])       \
-                                                 | (_baData.bytes[5] << 8)));
+    _waRaw[M_DRV_MC36XX_AXIS_X] = ((signed short) ((pbData[0])              \
+                                                 | (pbData[1] << 8)));
+    _waRaw[M_DRV_MC36XX_AXIS_Y] = ((signed short) ((pbData[2])              \
+                                                 | (pbData[3] << 8)));
+    _waRaw[M_DRV_MC36XX_AXIS_Z] = ((signed short) ((pbData[4])              \
+                                                 | (pbData[5] << 8)));
 
 #ifdef M_DRV_MC36XX_SUPPORT_LPF
     _M_DRV_MC36XX_LowPassFilter(_waRaw);
@@ -622,6 +617,21 @@ static int _M_DRV_MC36XX_ReadRawData(signed short Output[M_DRV_MC36XX_AXES_NUM])
     Output[M_DRV_MC36XX_AXIS_Z] =
             ((_ptOrienMap->bSign[M_DRV_MC36XX_AXIS_Z]                       \
             * _waRaw[_ptOrienMap->bMap[M_DRV_MC36XX_AXIS_Z]]));
+}
+
+/******************************************************************************
+ *** _M_DRV_MC36XX_ReadRawData
+ *****************************************************************************/
+static int _M_DRV_MC36XX_ReadRawData(signed short Output[M_DRV_MC36XX_AXES_NUM])
+{
+    M_PRINTF("[%s]\r\n", __func__);
+
+    m_drv_buffer(180) _baData = {0};
+
+    _M_DRV_MC36XX_REG_READ(E_M_DRV_MC36XX_REG_XOUT_LSB,                     \
+                           (uint_dev *)_baData.words ,6);
+
+    _M_DRV_MC36XX_UnpackRawData(_baData.bytes, Output);
 
     return (M_DRV_MC36XX_RETCODE_SUCCESS);
 }
@@ -1104,6 +1114,40 @@ int M_DRV_MC36XX_ReadRawData(                                               \
     return (_nDataCount);
 }
 
+/******************************************************************************
+ *** M_DRV_MC36XX_ReadRawFIFO
+ *****************************************************************************/
+/**
+ * Reads nNumOfSample samples from the FIFO in a single bus transaction. With
+ * the FIFO enabled the register address wraps from ZOUT_MSB back to XOUT_LSB
+ * and every wrap pops one sample. No status register is read: the caller must
+ * know the samples are there, e.g. from a FIFO threshold interrupt.
+ */
+int M_DRV_MC36XX_ReadRawFIFO(                                               \
+    short Output[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM],           \
+    int nNumOfSample)
+{
+    M_PRINTF("[%s] %d\r\n", __func__, nNumOfSample);
+
+    int _nDataCount = 0;
+    m_drv_buffer(M_DRV_MC36XX_FIFO_DEPTH * 6) _baData = {0};
+
+    if ((M_DRV_MC36XX_NULL_ADDR == Output) || (0 >= nNumOfSample))
+        return (M_DRV_MC36XX_RETCODE_ERROR_WRONG_ARGUMENT);
+
+    if (M_DRV_MC36XX_FIFO_DEPTH < nNumOfSample)
+        nNumOfSample = M_DRV_MC36XX_FIFO_DEPTH;
+
+    _M_DRV_MC36XX_REG_READ(E_M_DRV_MC36XX_REG_XOUT_LSB,                     \
+                           (uint_dev *)_baData.words, nNumOfSample * 6);
+
+    for (_nDataCount = 0; _nDataCount < nNumOfSample; _nDataCount++)
+        _M_DRV_MC36XX_UnpackRawData(&_baData.bytes[_nDataCount * 6],        \
+                                    Output[_nDataCount]);
+
+    return (_nDataCount);
+}
+
 /******************************************************************************
  *** M_DRV_MC36XX_ReadReg
  *****************************************************************************/
@@ -367,6 +367,9 @@ extern int  M_DRV_MC36XX_ReadData(                                          \
 extern int  M_DRV_MC36XX_ReadRawData(
             short Output[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM],   \
             int nNumOfSample);
+extern int  M_DRV_MC36XX_ReadRawFIFO(
+            short Output[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM],   \
+            int nNumOfSample);
 
 extern uint8_t  M_DRV_MC36XX_ReadReg(uint8_t bRegAddr);
 extern int  M_DRV_MC36XX_ReadRegMap(                                        \
@@ -0,0 +1,158 @@
+/**
+ ****************************************************************************************
+ *
+ * @file accel_fanout_test.c
+ *
+ * @brief Host test of the accelerometer sample fan-out.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc/user_app -o accel_fanout_test tools/accel_fanout_test.c src/user_app/user_accel_fanout.c
+ *   ./accel_fanout_test
+ *
+ * Checks the milli-g conversion against round(raw * 1.95) over the 12-bit range and its
+ * saturation, the value encoding and the subscription mask, then prints the sensor reads
+ * and notifications per second for 0 to 4 subscriptions, against the previous timer
+ * per characteristic (20 reads per second each).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "user_accel_fanout.h"
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+static int sent[ACCEL_FANOUT_CHAR_NUM];
+static uint8_t last[ACCEL_FANOUT_CHAR_NUM][ACCEL_FANOUT_VALUE_MAX];
+static uint8_t last_len[ACCEL_FANOUT_CHAR_NUM];
+
+static void send(uint8_t chr, const uint8_t *value, uint8_t len)
+{
+    sent[chr]++;
+    memcpy(last[chr], value, len);
+    last_len[chr] = len;
+}
+
+static int16_t le16(const uint8_t *p)
+{
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static void test_mg(void)
+{
+    int raw;
+
+    CHECK(accel_fanout_mg(0) == 0);
+    CHECK(accel_fanout_mg(1) == 2 && accel_fanout_mg(-1) == -2);
+    CHECK(accel_fanout_mg(513) == 1000);
+    CHECK(accel_fanout_mg(32767) == INT16_MAX && accel_fanout_mg(-32768) == INT16_MIN);
+
+    for (raw = -2048; raw <= 2047; raw++)
+    {
+        double mg = raw * 1.95;
+        int expected = (int)((mg < 0) ? (mg - 0.5) : (mg + 0.5));
+
+        if (accel_fanout_mg(raw) != expected)
+        {
+            printf("raw %d: %d mg, expected %d\n", raw, accel_fanout_mg(raw), expected);
+            fails++;
+            break;
+        }
+    }
+}
+
+static void test_tick(void)
+{
+    struct accel_fanout fanout = {0};
+    int16_t raw[3] = {100, -200, 512};
+
+    CHECK(accel_fanout_period(&fanout) == 0);
+    CHECK(accel_fanout_tick(&fanout, raw, send) == 0);
+
+    accel_fanout_subscribe(&fanout, ACCEL_FANOUT_Y, true);
+    accel_fanout_subscribe(&fanout, ACCEL_FANOUT_G, true);
+    CHECK(accel_fanout_tick(&fanout, raw, send) == 2);
+    CHECK(sent[ACCEL_FANOUT_X] == 0 && sent[ACCEL_FANOUT_Y] == 1 && sent[ACCEL_FANOUT_G] == 1);
+    CHECK(last_len[ACCEL_FANOUT_Y] == 2 && le16(last[ACCEL_FANOUT_Y]) == -390);
+    CHECK(last_len[ACCEL_FANOUT_G] == 6 && le16(last[ACCEL_FANOUT_G]) == 100);
+    CHECK(le16(&last[ACCEL_FANOUT_G][2]) == -200 && le16(&last[ACCEL_FANOUT_G][4]) == 512);
+
+    // Out of range characteristics are ignored
+    accel_fanout_subscribe(&fanout, 9, true);
+    CHECK(fanout.subscribed == 0x0A);
+    accel_fanout_subscribe(&fanout, ACCEL_FANOUT_Y, false);
+    CHECK(fanout.subscribed == 0x08);
+}
+
+static void test_rate(void)
+{
+    static const uint16_t period[] = {0, 5, 5, 8, 10};
+    int16_t raw[3] = {0, 0, 0};
+    uint8_t n, c;
+
+    printf("subscriptions  period  reads/s  notifications/s  (before: reads/s)\n");
+    for (n = 0; n <= ACCEL_FANOUT_CHAR_NUM; n++)
+    {
+        struct accel_fanout fanout = {0};
+        uint16_t p;
+        int reads = 0, ntf = 0, t;
+
+        for (c = 0; c < n; c++)
+        {
+            accel_fanout_subscribe(&fanout, c, true);
+        }
+        p = accel_fanout_period(&fanout);
+        for (t = 0; p && (t + p <= 100); t += p)
+        {
+            reads++;
+            ntf += accel_fanout_tick(&fanout, raw, send);
+        }
+
+        printf("%13u  %3u ms  %7d  %15d  (%d)\n", n, p * 10, reads, ntf, 20 * n);
+        CHECK(p == period[n]);
+        CHECK(ntf <= ACCEL_FANOUT_NTF_PER_SEC);
+    }
+}
+
+int main(void)
+{
+    test_mg();
+    test_tick();
+    test_rate();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
@@ -0,0 +1,419 @@
+/**
+ ****************************************************************************************
+ *
+ * @file accel_motion_sim.c
+ *
+ * @brief Host simulation of the MC36xx interrupt streaming.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   D=src/user_drivers
+ *   gcc -O2 -Isrc/user_app -I$D/sensor/accel/mc36xx -I$D/sensor/accel -I$D/platform/bus \
+ *       -I$D/platform/console -o accel_motion_sim tools/accel_motion_sim.c \
+ *       src/user_app/user_accel_motion.c $D/sensor/accel/mc36xx/m_drv_mc36xx.c \
+ *       $D/sensor/accel/m_drv_mc_utility.c -lm
+ *   ./accel_motion_sim
+ *
+ * The MC36xx driver runs against a register model of the sensor: FIFO, threshold and
+ * sniff wake interrupts on an active low pin cleared by reading STATUS_2. The wake-up
+ * controller is modelled as edge triggered and disarmed after one event, as it is used
+ * by user_accelerometer.c.
+ *
+ * 20 s of samples at 54 Hz are streamed: motion, rest, motion again. Every fourth
+ * interrupt, the sensor raises a new event after the FIFO was read but before the pin
+ * is armed again. The stream is run with the handler of user_accelerometer.c, which
+ * handles the pin again while it is asserted, and without that check. Checked: with
+ * the check no sample is lost or out of order and the sniff and wake transitions come
+ * on time; without it the stream stalls.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "m_drv_mc36xx.h"
+#include "user_accel_motion.h"
+
+/// Sample rate in wake mode
+#define SIM_RATE            (54)
+#define SIM_SAMPLES         (SIM_RATE * 20)
+/// As in user_accelerometer.c
+#define INT_PASSES_MAX      (4)
+
+#define REG_STATUS_1        (0x08)
+#define REG_STATUS_2        (0x09)
+#define REG_MODE            (0x10)
+#define REG_FIFO_CTL        (0x16)
+#define REG_INTR_CTRL       (0x17)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+/*
+ * Register model of the MC36xx
+ */
+static uint8_t regs[64];
+static int16_t fifo[M_DRV_MC36XX_FIFO_DEPTH][3];
+static int fifo_head, fifo_count;
+static bool fifo_above;
+static uint8_t status2;
+static int16_t prev[3];
+static int bus_reads;
+
+/*
+ * Interrupt pin and wake-up controller
+ */
+static bool int_pin;
+static bool pin_prev;
+static bool armed;
+static bool pending;
+
+/*
+ * Stream
+ */
+static int16_t hist[SIM_SAMPLES][3];
+static int now;
+static int next;
+static int dropped, errors, received, irqs, replays;
+static int sniff_at, wake_at;
+static struct accel_motion motion;
+
+static uint8_t mode(void)
+{
+    return regs[REG_MODE] & 7;
+}
+
+static bool fifo_enabled(void)
+{
+    return regs[REG_FIFO_CTL] & 0x40;
+}
+
+static int fifo_threshold(void)
+{
+    return regs[REG_FIFO_CTL] & 0x1F;
+}
+
+static void pin_update(void)
+{
+    // Edge triggered, one event per arming
+    if (int_pin && !pin_prev && armed)
+    {
+        armed = false;
+        pending = true;
+    }
+    pin_prev = int_pin;
+}
+
+void mcube_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+void mcube_printf(const char *format, ...)
+{
+    (void)format;
+}
+
+uint8_t mcube_write_regs(bool spi, uint8_t cs, uint8_t reg, uint8_t *value, uint8_t size)
+{
+    uint8_t i;
+
+    (void)spi;
+    (void)cs;
+    for (i = 0; i < size; i++)
+    {
+        regs[reg + i] = value[i];
+    }
+
+    return 0;
+}
+
+static uint8_t status1(void)
+{
+    uint8_t s = mode();
+
+    if (fifo_count == 0)
+    {
+        s |= 0x10;
+    }
+    if (fifo_count == M_DRV_MC36XX_FIFO_DEPTH)
+    {
+        s |= 0x20;
+    }
+    if (fifo_count >= fifo_threshold())
+    {
+        s |= 0x40;
+    }
+
+    return s;
+}
+
+uint8_t mcube_read_regs(bool spi, uint8_t cs, uint8_t reg, uint8_t *value, uint8_t size)
+{
+    uint8_t i;
+
+    (void)spi;
+    (void)cs;
+    bus_reads++;
+    for (i = 0; i < size; i++)
+    {
+        uint8_t r = reg + i;
+
+        if ((reg == 0x02) && fifo_enabled())
+        {
+            // The burst wraps from ZOUT_MSB to XOUT_LSB, each wrap pops a sample
+            int b = i % 6;
+            int16_t *sample = fifo[fifo_head];
+
+            value[i] = (b & 1) ? (uint8_t)(sample[b / 2] >> 8) : (uint8_t)sample[b / 2];
+            if (b == 5)
+            {
+                if (fifo_count == 0)
+                {
+                    printf("FIFO read while empty\n");
+                    exit(1);
+                }
+                fifo_head = (fifo_head + 1) % M_DRV_MC36XX_FIFO_DEPTH;
+                fifo_count--;
+                fifo_above = fifo_count >= fifo_threshold();
+            }
+        }
+        else if (r == REG_STATUS_1)
+        {
+            value[i] = status1();
+        }
+        else if (r == REG_STATUS_2)
+        {
+            value[i] = status2;
+            status2 = 0;
+            int_pin = false;
+            pin_update();
+        }
+        else
+        {
+            value[i] = regs[r];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * One sample period of the sensor.
+ */
+static void deliver(void)
+{
+    const int16_t *s;
+    double t;
+    bool moving;
+    int axis;
+
+    if (now >= SIM_SAMPLES)
+    {
+        return;
+    }
+
+    t = (double)now / SIM_RATE;
+    moving = (t < 2.0) || ((t >= 12.0) && (t < 13.0));
+    hist[now][0] = moving ? (int16_t)(300 * sin(t * 9)) : 5 * (now & 1);
+    hist[now][1] = moving ? (int16_t)(-200 * cos(t * 7)) : -3;
+    hist[now][2] = 512 + (moving ? (int16_t)(100 * sin(t * 5)) : 0);
+    s = hist[now];
+
+    if ((mode() == E_M_DRV_MC36XX_MODE_CWAKE) && fifo_enabled())
+    {
+        if (fifo_count == M_DRV_MC36XX_FIFO_DEPTH)
+        {
+            dropped++;
+        }
+        else
+        {
+            memcpy(fifo[(fifo_head + fifo_count) % M_DRV_MC36XX_FIFO_DEPTH], s, sizeof(fifo[0]));
+            fifo_count++;
+        }
+        if ((fifo_count >= fifo_threshold()) && !fifo_above && (regs[REG_INTR_CTRL] & 0x40))
+        {
+            status2 |= 0x40;
+            int_pin = true;
+        }
+        fifo_above = fifo_count >= fifo_threshold();
+    }
+    else if (mode() == E_M_DRV_MC36XX_MODE_SNIFF)
+    {
+        for (axis = 0; axis < 3; axis++)
+        {
+            if (abs(s[axis] - prev[axis]) > 20)
+            {
+                // The stream resumes with the next sample
+                regs[REG_MODE] = (regs[REG_MODE] & ~7) | E_M_DRV_MC36XX_MODE_CWAKE;
+                next = now + 1;
+                if (regs[REG_INTR_CTRL] & 0x04)
+                {
+                    status2 |= 0x04;
+                    int_pin = true;
+                }
+                break;
+            }
+        }
+    }
+    memcpy(prev, s, sizeof(prev));
+    now++;
+    pin_update();
+}
+
+static void motion_irq(void)
+{
+    static short out[M_DRV_MC36XX_FIFO_DEPTH][M_DRV_MC36XX_AXES_NUM];
+    uint8_t count = accel_motion_irq(&motion, out);
+    uint8_t i;
+
+    irqs++;
+    for (i = 0; i < count; i++, next++)
+    {
+        // TOP_RIGHT_UP orientation: X and Y negated
+        if ((out[i][0] != -hist[next][0]) || (out[i][1] != -hist[next][1]) || (out[i][2] != hist[next][2]))
+        {
+            errors++;
+        }
+    }
+    received += count;
+    if ((motion.mode == ACCEL_MOTION_SNIFF) && (sniff_at < 0))
+    {
+        sniff_at = now;
+    }
+    if (motion.wakes && (wake_at < 0))
+    {
+        wake_at = now;
+    }
+}
+
+/**
+ * Samples the sensor takes after the FIFO was read, before the pin is armed again:
+ * on every fourth interrupt, until the sensor raises a new event.
+ */
+static void race_window(void)
+{
+    int i;
+
+    if (irqs % 4 != 0)
+    {
+        return;
+    }
+    for (i = 0; (i <= ACCEL_MOTION_FIFO_THRESHOLD) && !int_pin; i++)
+    {
+        deliver();
+    }
+}
+
+/**
+ * user_accel_int_handler() of user_accelerometer.c.
+ */
+static void int_handler(bool check_level)
+{
+    int passes = 0;
+
+    do
+    {
+        motion_irq();
+        race_window();
+        // wkupct_enable_irq()
+        armed = true;
+        pin_prev = int_pin;
+        if (!check_level || !int_pin)
+        {
+            break;
+        }
+        replays++;
+    } while (++passes < INT_PASSES_MAX);
+
+    if (passes == INT_PASSES_MAX)
+    {
+        // app_easy_wakeup()
+        pending = true;
+    }
+}
+
+static void run(bool check_level)
+{
+    memset(regs, 0, sizeof(regs));
+    fifo_head = fifo_count = 0;
+    fifo_above = false;
+    status2 = 0;
+    memset(prev, 0, sizeof(prev));
+    int_pin = pin_prev = pending = false;
+    now = next = 0;
+    dropped = errors = received = irqs = replays = 0;
+    sniff_at = wake_at = -1;
+    bus_reads = 0;
+
+    CHECK(accel_motion_start(&motion) == 0 && motion.mode == ACCEL_MOTION_WAKE);
+    CHECK(regs[REG_FIFO_CTL] == (0x40 | 0x20 | ACCEL_MOTION_FIFO_THRESHOLD));
+    CHECK((regs[REG_INTR_CTRL] & 0x44) == 0x44);
+    armed = true;
+
+    while (now < SIM_SAMPLES)
+    {
+        deliver();
+        while (pending)
+        {
+            pending = false;
+            int_handler(check_level);
+        }
+    }
+
+    printf("%s level check: %d interrupts (%d while asserted), %d samples, %d out of order, "
+           "%d dropped, sniff at %.2f s, wake at %.2f s, %.2f bus reads per sample\n",
+           check_level ? "with   " : "without", irqs, replays, received, errors, dropped,
+           (double)sniff_at / SIM_RATE, (double)wake_at / SIM_RATE,
+           received ? (double)bus_reads / received : 0.0);
+}
+
+int main(void)
+{
+    run(true);
+    CHECK(replays > 0 && errors == 0 && dropped == 0);
+    CHECK(motion.sniffs == 2 && motion.wakes == 1);
+    // Motion stops at 2 s, 270 samples at rest; moves again at 12 s
+    CHECK(sniff_at > 6.9 * SIM_RATE && sniff_at < 7.3 * SIM_RATE);
+    CHECK(wake_at >= 12 * SIM_RATE && wake_at < 12.05 * SIM_RATE);
+
+    run(false);
+    CHECK(dropped > 0);
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
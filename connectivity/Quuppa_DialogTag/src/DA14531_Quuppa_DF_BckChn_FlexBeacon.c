@@ -51,6 +51,8 @@
 #include "rf_531.h"
 
 #include "port_bmi270.h"
+#include "user_adv_timeline.h"
+#include "lld_evt.h"
 #include "user_periph_setup.h"
 #include "adc.h"
 #include "battery.h"
@@ -59,29 +61,8 @@
 #include "wkup_keys.h"
 #endif // HAS_WKUP_KEYS
 
-#ifdef CFG_PRINTF // If UART debug is enabled SysTick Timer is used to get Timestamps
+#ifdef CFG_PRINTF
 #include "uart_utils.h"
-
-#include "systick.h"
-
-#define SYSTICK_PERIOD_US   15000000   // Systick timer is 24bit(max value 16.777.215), period for systick timer in us, so 15.000.000 ticks = 15 seconds
-#define SYSTICK_EXCEPTION   0          // do not generate exceptions
-
-/**
- ****************************************************************************************
- * @brief SysTick ISR routine
- ****************************************************************************************
- */
-static void systick_isr(void)
-{
-}
-
-void systick_init(void)
-{
-    systick_register_callback(systick_isr);
-    // Systick will be initialized to use a reference clock frequency of 1 MHz
-    systick_start(SYSTICK_PERIOD_US, SYSTICK_EXCEPTION);
-}
 #endif
 
 
@@ -122,9 +103,9 @@ static const struct scan_configuration user_scan_conf ={
     /// Own BD address source of the device
     .addr_src = GAPM_STATIC_ADDR,
     /// Scan interval
-    .interval = SCAN_INTERVAL_MS,                     
+    .interval = MS_TO_BLESLOTS(SCAN_INTERVAL_MS),
     /// Scan window size
-    .window = SCAN_WINDOW_MS,                         
+    .window = MS_TO_BLESLOTS(SCAN_WINDOW_MS),
     /// Scanning mode
     .mode = GAP_OBSERVER_MODE,
     /// Scan filter policy
@@ -140,21 +121,13 @@ static const struct scan_configuration user_scan_conf ={
 
 uint8_t app_connection_idx                                __SECTION_ZERO("retention_mem_area0");
 
-timer_hnd user_periodic_rx_on_timer                       __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-timer_hnd user_rx_on_cancel_timer                         __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-timer_hnd user_rsp_cancel_timer                           __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-timer_hnd user_scan_cancel_timer                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+timer_hnd user_timeline_timer                             __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 timer_hnd user_enable_extended_sleep_timer                __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-timer_hnd user_dev_info_cancel_timer                      __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 
 timer_hnd app_param_update_request_timer_used             __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-timer_hnd app_push_button_timer                           __SECTION_ZERO("retention_mem_area0");
 
 advertising_state adv_state                               __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-advertising_state adv_state_before_sleep                  __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-uint8_t user_periodic_timer_init_once                     __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-uint8_t cancel_motion_adv                                 __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
-static advertising_state adv_state_before                 __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+struct adv_timeline adv_timeline                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 
 extern last_ble_evt arch_rwble_last_event;
 uint16_t ui16temperature_k;
@@ -181,6 +154,19 @@ uint32_t actual_size;
  ****************************************************************************************
 */
 
+#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
+/**
+ ****************************************************************************************
+ * @brief Time stamp of the debug messages.
+ * @return Time since the current duty cycle started, in us.
+ ****************************************************************************************
+ */
+static uint32_t user_timeline_us(void)
+{
+    return adv_timeline_cycle_us(&adv_timeline, lld_evt_time_get());
+}
+#endif
+
 #define TOPBIT   (((uint8_t)1) << 7)
 
 /*********************************************************************
@@ -245,8 +231,8 @@ static void get_device_info(void)
 	}
 
 	#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1) 
-	 uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	 arch_printf("\n\r[%08d us] 5.Status: %d, Battery Voltage[mV]: %d, Temp[C]: %d, Temp[K]: 0x%04X, ", current_sys_tick, ui8status, ui16battery_CR2032_mv, i8temperature_c, ui16temperature_k);
+	 uint32_t timestamp_us = user_timeline_us();
+	 arch_printf("\n\r[%08d us] 5.Status: %d, Battery Voltage[mV]: %d, Temp[C]: %d, Temp[K]: 0x%04X, ", timestamp_us, ui8status, ui16battery_CR2032_mv, i8temperature_c, ui16temperature_k);
 	#endif
 
 }
@@ -414,17 +400,6 @@ static void user_ble_gap_stop_ongoing_operation(void)
 }
 
 
-static void scan_cancell_timer_cb()
-{	
-	#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-     uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	   arch_printf("\n\r[%08d us] X.Scan_cancell_timer_cb...", current_sys_tick);
-	#endif	
-
-	user_scan_cancel_timer = EASY_TIMER_INVALID_TIMER;
-	user_ble_gap_stop_ongoing_operation();
-}
-
 /**
  ****************************************************************************************
  * @brief Scan for devices
@@ -447,56 +422,84 @@ static void user_scan_start(void)
     cmd->filter_duplic =user_scan_conf.filter_duplic;
 		
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] 4.Start Scanning...", current_sys_tick);
+        uint32_t timestamp_us = user_timeline_us();
+	      arch_printf("\n\r[%08d us] 4.Start Scanning...", timestamp_us);
 		#endif
-    // Schedule SCAN cancel timeout
-		user_scan_cancel_timer = app_easy_timer(SCAN_CANCEL_TIMER, scan_cancell_timer_cb);
     // Send the message
     ke_msg_send(cmd);
 }
 
+static void user_timeline_cancel_timer(void)
+{
+    if (user_timeline_timer != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(user_timeline_timer);
+        user_timeline_timer = EASY_TIMER_INVALID_TIMER;
+    }
+}
+
 /**
  ****************************************************************************************
-* @brief RX_ON cancel timer: used to have only one RX_ON adv packet
+ * @brief Timeline timer callback, the hold time of the current mode elapsed. The air
+ *        operation is stopped, its completion enters the next mode.
  * @return void
  ****************************************************************************************
 */
-static void rx_on_cancel_timer_cb()
-{	
+static void user_timeline_timer_cb()
+{
  		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] 3.RX_ON_timer_cancellation_cb...", current_sys_tick);
-		#endif	
-		user_rx_on_cancel_timer = EASY_TIMER_INVALID_TIMER;
-	  adv_state = SCAN;
-    app_easy_gap_advertise_stop();
+        uint32_t timestamp_us = user_timeline_us();
+	      arch_printf("\n\r[%08d us] X.Timeline_timer_cb, end of mode %d...", timestamp_us, adv_state);
+		#endif
+		user_timeline_timer = EASY_TIMER_INVALID_TIMER;
+		user_ble_gap_stop_ongoing_operation();
 }
 
+/**
+ ****************************************************************************************
+ * @brief Enters the mode that follows the current one, once its air operation completed.
+ * @return void
+ ****************************************************************************************
+*/
+static void user_timeline_advance(void)
+{
+    user_timeline_cancel_timer();
+    adv_state = (advertising_state)adv_timeline_next(&adv_timeline, req_found);
+    req_found = false;
+    user_app_adv_start();
+}
 
+/**
+ ****************************************************************************************
+ * @brief Leaves the current mode before its hold time elapsed.
+ * @param[in] state Mode entered once the air operation is stopped
+ * @return void
+ ****************************************************************************************
+*/
+static void user_timeline_preempt(advertising_state state)
+{
+    adv_timeline_request(&adv_timeline, state);
+    user_ble_gap_stop_ongoing_operation();
+}
 
 /**
  ****************************************************************************************
- * @brief Periodic scan timer callback function.
+ * @brief Changes the base mode. A base mode is left at once, a back channel cycle in
+ *        progress completes and returns to the new base mode.
+ * @param[in] state MOTION_ADVERTISING or STATIC_ADVERTISING
  * @return void
  ****************************************************************************************
 */
-static void periodic_rx_on_timer_cb()
-{	
- 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] 1.Periodic_RX_ON_timer_cb...", current_sys_tick);
-		#endif	
-	
-		user_periodic_rx_on_timer = EASY_TIMER_INVALID_TIMER;
-
-	  // Save current adv state
-  	adv_state_before = adv_state;
- 
-    // change state
-  	adv_state = RX_ON_ADVERTISING; //user_change_adv_state(RX_ON_ADVERTISING);
-	  app_easy_gap_advertise_stop();
-	
+static void user_timeline_switch_base(advertising_state state)
+{
+    if (adv_timeline_at_base(&adv_timeline))
+    {
+        user_timeline_preempt(state);
+    }
+    else
+    {
+        adv_timeline_return_to(&adv_timeline, state);
+    }
 }
 
 static void user_enable_extended_sleep_timer_cb()
@@ -505,111 +508,19 @@ static void user_enable_extended_sleep_timer_cb()
 			#ifdef CFG_PRINTF
 			 arch_printf("\n\n\r SLEEP timer elapsed...");
 			#endif
-//			  user_change_adv_state(SLEEP);
-//			  app_easy_gap_advertise_stop();
-				adv_state = SLEEP;
-				user_enable_extended_sleep();
-				user_ble_gap_stop_ongoing_operation();
-
+				user_timeline_preempt(SLEEP);
 }
 
-static void rsp_cancel_timer_cb()
-{	
- 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] 8.RSP_timer_cancellation cb...", current_sys_tick);
-		#endif	
-		user_rsp_cancel_timer = EASY_TIMER_INVALID_TIMER;    
-
-	  user_change_adv_state(DEV_INFO);
-    app_easy_gap_advertise_stop();
-}
-
-static void dev_info_cancel_timer_cb()
-{	
- 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] 9.Dev_info_timer_cancellation cb...", current_sys_tick);
-		#endif	
-		user_dev_info_cancel_timer = EASY_TIMER_INVALID_TIMER;    
-	 if(adv_state_before == MOTION_ADVERTISING &&	cancel_motion_adv == 1)
-		 {
-			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-					uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-					arch_printf("\n\r[%08d us] X.Motion_ADV_cancellation...", current_sys_tick);
-			#endif
-			cancel_motion_adv = 0;
-			adv_state_before = STATIC_ADVERTISING;
-		 }
-		 if(adv_state_before == STATIC_ADVERTISING){
-			 user_periodic_rx_on_timer = app_easy_timer(PERIODIC_RX_ON_INTERVAL_STATIC, periodic_rx_on_timer_cb);
-		 }else{
-			 user_periodic_rx_on_timer = app_easy_timer(PERIODIC_RX_ON_INTERVAL_MOTION, periodic_rx_on_timer_cb);
-		 }
-	  user_change_adv_state(adv_state_before);
-    app_easy_gap_advertise_stop();
-}
-
-
 void user_app_adv_undirect_complete(uint8_t status)
 {
 		 #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-        uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\n\r[%08d us] X.User_app_adv_undirect_complete...", current_sys_tick);
+        uint32_t timestamp_us = user_timeline_us();
+	      arch_printf("\n\r[%08d us] X.User_app_adv_undirect_complete...", timestamp_us);
 		 #endif	
 
     if (status == GAP_ERR_CANCELED)
     {
-			switch (adv_state)
-			{
-				case MOTION_ADVERTISING:
-					if (user_dev_info_cancel_timer != EASY_TIMER_INVALID_TIMER)
-					{
-							app_easy_timer_cancel(user_dev_info_cancel_timer);
-							user_dev_info_cancel_timer = EASY_TIMER_INVALID_TIMER;
-					}
-					user_app_adv_start();
-				break;
-				case STATIC_ADVERTISING:
-					if (user_dev_info_cancel_timer != EASY_TIMER_INVALID_TIMER)
-					{
-							app_easy_timer_cancel(user_dev_info_cancel_timer);
-							user_dev_info_cancel_timer = EASY_TIMER_INVALID_TIMER;
-					}
-					user_app_adv_start();
-				break;
-				case RX_ON_ADVERTISING:
-					if (user_periodic_rx_on_timer != EASY_TIMER_INVALID_TIMER)
-						{
-								app_easy_timer_cancel(user_periodic_rx_on_timer);
-								user_periodic_rx_on_timer = EASY_TIMER_INVALID_TIMER;
-						}
-						user_app_adv_start();
-				break;				
-				case SCAN:
-					if (user_rx_on_cancel_timer != EASY_TIMER_INVALID_TIMER)
-						{
-								app_easy_timer_cancel(user_rx_on_cancel_timer);
-								user_rx_on_cancel_timer = EASY_TIMER_INVALID_TIMER;
-						}
-					user_scan_start();
-				break;
-			  case SLEEP:
-				  user_enable_extended_sleep();
-					#ifdef CFG_PRINTF
-            arch_puts("\n\n\rAdv Cancel, Sleep case, set arch_ble_ext_wakeup_on...\n");
-					#endif
-			  break;
-				case DEV_INFO:
-					if (user_rsp_cancel_timer != EASY_TIMER_INVALID_TIMER)
-					{
-							app_easy_timer_cancel(user_rsp_cancel_timer);
-							user_rsp_cancel_timer = EASY_TIMER_INVALID_TIMER;
-					}
-					user_app_adv_start();
-				default :
-				break;			
-			}
+        user_timeline_advance();
     }
 }
 
@@ -631,21 +542,18 @@ void user_app_init(void)
 #endif
 	
 		adv_state = MOTION_ADVERTISING;
-	  cancel_motion_adv = 0;
+		adv_timeline_init(&adv_timeline, adv_timeline_table, MOTION_ADVERTISING);
 	  
     //Reset all timers
   	app_param_update_request_timer_used = EASY_TIMER_INVALID_TIMER;	
 		user_enable_extended_sleep_timer = EASY_TIMER_INVALID_TIMER;    
-    user_periodic_rx_on_timer = EASY_TIMER_INVALID_TIMER;
+    user_timeline_timer = EASY_TIMER_INVALID_TIMER;
 
     // Get own BD Address
   	uint32_t bdaddr_msb = (GetWord32(BLE_BDADDRU_REG))&0x1FFFF;
     uint32_t bdaddr_lsb = (GetWord32(BLE_BDADDRL_REG));
     memcpy(&own_bd_addr, &bdaddr_lsb, 4);
     memcpy(&own_bd_addr[4], &bdaddr_msb, 2);	
-    
-    //Set the flag to update periodic timers once
-  	user_periodic_timer_init_once = 1;
 
 		user_set_led_state(false);
 	
@@ -655,9 +563,6 @@ void user_app_init(void)
     memcpy(stored_scan_rsp_data, USER_ADVERTISE_SCAN_RESPONSE_DATA, USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN);
     stored_scan_rsp_data_len = USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN;
     
-#ifdef CFG_PRINTF
-    systick_init();
-#endif
     req_found = false;
 	  default_app_on_init();
 }
@@ -674,9 +579,9 @@ void user_motion_undirect_adv_start(void)
     struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_undirected_advertise_get_active();
     
-		cmd->intv_min = MS_TO_BLESLOTS(MOTION_ADV_INTERVAL);
-		cmd->intv_max = MS_TO_BLESLOTS(MOTION_ADV_INTERVAL);
-	  cmd->channel_map = ADV_ALL_CHNLS_EN;
+		cmd->intv_min = MS_TO_BLESLOTS(adv_timeline_table[MOTION_ADVERTISING].adv_intv);
+		cmd->intv_max = MS_TO_BLESLOTS(adv_timeline_table[MOTION_ADVERTISING].adv_intv);
+	  cmd->channel_map = adv_timeline_table[MOTION_ADVERTISING].channels;
 		
 #if defined (__DA14531__)  // Power output change is possible for DA14531 only
   	rf_pa_pwr_set(MOTION_ADV_POWER);
@@ -700,10 +605,8 @@ void user_motion_undirect_adv_start(void)
 	
     app_easy_gap_undirected_advertise_start();
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-      systick_stop();
-      systick_start(SYSTICK_PERIOD_US, SYSTICK_EXCEPTION);
-      uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			arch_printf("\n\n\r[%08d us] 0.Motion Advertising...", current_sys_tick);
+      uint32_t timestamp_us = user_timeline_us();
+			arch_printf("\n\n\r[%08d us] 0.Motion Advertising...", timestamp_us);
 		#endif
 }
 
@@ -718,9 +621,9 @@ void user_static_undirect_adv_start(void)
     struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_undirected_advertise_get_active();
     
-		cmd->intv_min = MS_TO_BLESLOTS(STATIC_ADV_INTERVAL);
-		cmd->intv_max = MS_TO_BLESLOTS(STATIC_ADV_INTERVAL);
-	  cmd->channel_map = ADV_ALL_CHNLS_EN;
+		cmd->intv_min = MS_TO_BLESLOTS(adv_timeline_table[STATIC_ADVERTISING].adv_intv);
+		cmd->intv_max = MS_TO_BLESLOTS(adv_timeline_table[STATIC_ADVERTISING].adv_intv);
+	  cmd->channel_map = adv_timeline_table[STATIC_ADVERTISING].channels;
 
 #if defined (__DA14531__)  // Power output change is possible for DA14531 only		
 		rf_pa_pwr_set(STATIC_ADV_POWER);
@@ -745,45 +648,22 @@ void user_static_undirect_adv_start(void)
 	
     app_easy_gap_undirected_advertise_start();
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-      systick_stop();
-      systick_start(SYSTICK_PERIOD_US, SYSTICK_EXCEPTION);
-      uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			arch_printf("\n\n\r[%08d us] 0.Static Advertising...", current_sys_tick);
+      uint32_t timestamp_us = user_timeline_us();
+			arch_printf("\n\n\r[%08d us] 0.Static Advertising...", timestamp_us);
 		#endif
 }
 
 void user_app_adv_start(void)
 {
-	
-	if(user_periodic_timer_init_once)
-		 {
-  	   user_periodic_timer_init_once = 0;
-
-  		if(user_periodic_rx_on_timer != EASY_TIMER_INVALID_TIMER)
-        {
-            app_easy_timer_cancel(user_periodic_rx_on_timer);
-            user_periodic_rx_on_timer = EASY_TIMER_INVALID_TIMER;		
-        }
-        // Schedule the next periodic scan to check for REQ packets
-        if(adv_state == STATIC_ADVERTISING)
-        {
-          user_periodic_rx_on_timer = app_easy_timer(PERIODIC_RX_ON_INTERVAL_STATIC, periodic_rx_on_timer_cb);
-				}
-        else
-        {
-            user_periodic_rx_on_timer = app_easy_timer(PERIODIC_RX_ON_INTERVAL_MOTION, periodic_rx_on_timer_cb);
-        }
-
-//				if(user_enable_extended_sleep_timer != EASY_TIMER_INVALID_TIMER)
-//				{
-//						app_easy_timer_cancel(user_enable_extended_sleep_timer);
-//						user_enable_extended_sleep_timer = EASY_TIMER_INVALID_TIMER;		
-//				}
-
-//			  user_enable_extended_sleep_timer =	app_easy_timer(TIMEOUT_FOR_SLEEP, user_enable_extended_sleep_timer_cb);
-			
-		 } 
+    uint32_t hold;
 
+    // Stamp the transition and schedule the end of the mode
+    user_timeline_cancel_timer();
+    hold = adv_timeline_enter(&adv_timeline, adv_state, lld_evt_time_get());
+    if (hold > 0)
+    {
+        user_timeline_timer = app_easy_timer(hold, user_timeline_timer_cb);
+    }
 
 	 switch (adv_state)
 		{
@@ -796,6 +676,9 @@ void user_app_adv_start(void)
       case RX_ON_ADVERTISING:
 				user_rx_on_undirect_adv_start();
 			break;				
+      case SCAN:
+				user_scan_start();
+			break;
       case RSP_ADVERTISING:
 				user_rsp_undirect_adv_start();
 			break;
@@ -818,8 +701,8 @@ void user_app_connection(uint8_t connection_idx, struct gapc_connection_req_ind
     {
         app_connection_idx = connection_idx;
 
-        // Stop the advertising data update timer
-        app_easy_timer_cancel(user_periodic_rx_on_timer);
+        // Stop the duty cycle
+        user_timeline_cancel_timer();
 
         // Check if the parameters of the established connection are the preferred ones.
         // If not then schedule a connection parameter update request.
@@ -834,16 +717,10 @@ void user_app_connection(uint8_t connection_idx, struct gapc_connection_req_ind
     }
     else
     {
-        // No connection has been established, restart advertising
-				user_periodic_timer_init_once = 1;
-			  if(adv_state_before == MOTION_ADVERTISING)
-				{
-					cancel_motion_adv = 1;
-				}
-		    user_change_adv_state(adv_state_before);
+        // No connection has been established, restart the duty cycle
+		    user_change_adv_state((advertising_state)adv_timeline.base);
 			  user_app_adv_start();
     }
-  	adv_state_before = adv_state;
     default_app_on_connection(connection_idx, param);
 }
 
@@ -858,7 +735,7 @@ void user_app_disconnect(struct gapc_disconnect_ind const *param)
     }
     // Restart Advertising
 		
-		user_change_adv_state(adv_state_before);
+		user_change_adv_state((advertising_state)adv_timeline.base);
     user_app_adv_start();
 }
 
@@ -1017,22 +894,19 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 */ 
 void user_rx_on_undirect_adv_start(void)
 {
-    // Schedule the rx on advertising cancellation
-    user_rx_on_cancel_timer = app_easy_timer(RX_ON_CANCEL_TIMER, rx_on_cancel_timer_cb);
-
 	  struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_undirected_advertise_get_active();
     
-		cmd->intv_min = MS_TO_BLESLOTS(RX_ON_ADV_INTERVAL);
-		cmd->intv_max = MS_TO_BLESLOTS(RX_ON_ADV_INTERVAL);
-	  cmd->channel_map = ADV_ALL_CHNLS_EN;
+		cmd->intv_min = MS_TO_BLESLOTS(adv_timeline_table[RX_ON_ADVERTISING].adv_intv);
+		cmd->intv_max = MS_TO_BLESLOTS(adv_timeline_table[RX_ON_ADVERTISING].adv_intv);
+	  cmd->channel_map = adv_timeline_table[RX_ON_ADVERTISING].channels;
 
 #if defined (__DA14531__)  // Power output change is possible for DA14531 only	
 		rf_pa_pwr_set(RX_ON_ADV_POWER);
 	  set_recommended_settings();
 #endif	
 
-    if(adv_state_before == MOTION_ADVERTISING){
+    if(adv_timeline.base == MOTION_ADVERTISING){
   	  mnf_data.proprietary_data[2] = RX_ON_MOTION_ADV_HEADER;
 		} else{
 			mnf_data.proprietary_data[2] = RX_ON_STATIC_ADV_HEADER;
@@ -1045,8 +919,8 @@ void user_rx_on_undirect_adv_start(void)
     app_easy_gap_undirected_advertise_start();
 	
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		  uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			arch_printf("\n\r[%08d us] 2.RX_ON_adv_start... Header: %02X RX_ON_Hanldler: %02X", current_sys_tick, mnf_data.proprietary_data[2], user_periodic_rx_on_timer);
+		  uint32_t timestamp_us = user_timeline_us();
+			arch_printf("\n\r[%08d us] 2.RX_ON_adv_start... Header: %02X Base: %d", timestamp_us, mnf_data.proprietary_data[2], adv_timeline.base);
 		#endif
 	
 }
@@ -1059,15 +933,12 @@ void user_rx_on_undirect_adv_start(void)
 */ 
 void user_rsp_undirect_adv_start(void)
 {
-    // Schedule the rsp advertising cancellation
-    user_rsp_cancel_timer = app_easy_timer(RSP_CANCEL_TIMER, rsp_cancel_timer_cb);
-
 	  struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_undirected_advertise_get_active();
     
-		cmd->intv_min = MS_TO_BLESLOTS(RSP_ADV_INTERVAL);
-		cmd->intv_max = MS_TO_BLESLOTS(RSP_ADV_INTERVAL);
-	  cmd->channel_map = ADV_CHNL_37_EN;
+		cmd->intv_min = MS_TO_BLESLOTS(adv_timeline_table[RSP_ADVERTISING].adv_intv);
+		cmd->intv_max = MS_TO_BLESLOTS(adv_timeline_table[RSP_ADVERTISING].adv_intv);
+	  cmd->channel_map = adv_timeline_table[RSP_ADVERTISING].channels;
 		//cmd->channel_map = ADV_ALL_CHNLS_EN;
 	
 #if defined (__DA14531__)  // Power output change is possible for DA14531 only	
@@ -1081,8 +952,8 @@ void user_rsp_undirect_adv_start(void)
     app_easy_gap_undirected_advertise_start();
 	
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		  uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			arch_printf("\n\r[%08d us] 7.User_RSP_undirect_adv_start...", current_sys_tick);
+		  uint32_t timestamp_us = user_timeline_us();
+			arch_printf("\n\r[%08d us] 7.User_RSP_undirect_adv_start...", timestamp_us);
 		#endif
 	
 }
@@ -1095,15 +966,12 @@ void user_rsp_undirect_adv_start(void)
 */ 
 void user_dev_info_undirect_adv_start(void)
 {
-    // Schedule the device info advertising cancellation
-    user_dev_info_cancel_timer = app_easy_timer(DEV_INFO_CANCEL_TIMER, dev_info_cancel_timer_cb);
-
 	  struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_undirected_advertise_get_active();
     
-		cmd->intv_min = MS_TO_BLESLOTS(DEV_INFO_ADV_INTERVAL);
-		cmd->intv_max = MS_TO_BLESLOTS(DEV_INFO_ADV_INTERVAL);
-		cmd->channel_map = ADV_ALL_CHNLS_EN;
+		cmd->intv_min = MS_TO_BLESLOTS(adv_timeline_table[DEV_INFO].adv_intv);
+		cmd->intv_max = MS_TO_BLESLOTS(adv_timeline_table[DEV_INFO].adv_intv);
+		cmd->channel_map = adv_timeline_table[DEV_INFO].channels;
 	
 #if defined (__DA14531__)  // Power output change is possible for DA14531 only	
 		rf_pa_pwr_set(DEV_INFO_ADV_POWER);
@@ -1118,8 +986,8 @@ void user_dev_info_undirect_adv_start(void)
     app_easy_gap_undirected_advertise_start();
 	
 		#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		  uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			arch_printf("\n\r[%08d us] 9.User_DEV_INFO_undirect_adv_start...", current_sys_tick);
+		  uint32_t timestamp_us = user_timeline_us();
+			arch_printf("\n\r[%08d us] 9.User_DEV_INFO_undirect_adv_start...", timestamp_us);
 		#endif
 	
 }
@@ -1222,12 +1090,18 @@ static void _user_app_sensor_init()
     #else
     uint8_t var;
     uint8_t feat_cfg[4];
+    int8_t rslt;
     
     // Start communication
     port_bmi270_itf_begin();
     
-    // Initialize the sensor
-    port_bmi270_init();
+    // Initialize the sensor, the configuration file is uploaded only if not already loaded
+    rslt = port_bmi270_init();
+		
+		#ifdef CFG_PRINTF
+		arch_printf("\n\n\r port_bmi270_init = %d, uploads %d, warm %d", rslt,
+		            port_bmi270_boot_record_ptr()->uploads, port_bmi270_boot_record_ptr()->warm_boots);
+		#endif
 
     /* Feature Configuration */
     bmi2_set_adv_power_save(BMI2_DISABLE,  port_bmi270_dev_ptr());
@@ -1251,7 +1125,7 @@ static void _user_app_sensor_init()
     feat_cfg[3] |= 0x80; // Enabling the no motion feature
     bmi2_set_regs(BMI2_FEATURES_REG_ADDR, (uint8_t*)feat_cfg, 4, port_bmi270_dev_ptr());
     
-    bmi2_set_adv_power_save(BMI2_ENABLE,  port_bmi270_dev_ptr());
+    rslt = bmi2_set_adv_power_save(BMI2_ENABLE,  port_bmi270_dev_ptr());
 		
 		#ifdef CFG_PRINTF
 		arch_printf("\n\n\r bmi2_set_adv_power_save = %s", rslt==0? "OK":"NOT OK");
@@ -1352,19 +1226,16 @@ void user_app_on_db_init_complete(void)
 
 static void _user_pb1_long_press_handler()
 {
-	app_push_button_timer = EASY_TIMER_INVALID_TIMER;
-
 	#ifdef CFG_PRINTF
-			arch_printf("\n\n\r Button pressed > %d sec...\n",APP_BUTTON_LONG_PRESS_TO/100);
+			arch_printf("\n\n\r Button long press...\n");
 	#endif
 }
 
-static void _user_pb1_key_handler(bool pressed)
+static void _user_pb1_key_handler(bool pressed, bool after_long_press)
 {
 	if(pressed) 
 		{ // Do something when button is firstly pressed
-			// Start timer to check about long press
-			app_push_button_timer = app_easy_timer(APP_BUTTON_LONG_PRESS_TO, _user_pb1_long_press_handler);
+			// The long press is reported by the wakeup keys
 
 #if (WKUP_KEYS_NUM > 1)			
 
@@ -1376,7 +1247,7 @@ static void _user_pb1_key_handler(bool pressed)
 			}
 
 			#ifdef CFG_PRINTF
-			arch_printf("\n\n\r Button pressed: Started long press timer and cancelled Sleep timer...\n");
+			arch_printf("\n\n\r Button pressed: cancelled Sleep timer...\n");
 			#endif
 
 #endif
@@ -1385,11 +1256,8 @@ static void _user_pb1_key_handler(bool pressed)
 	else
 		{ // Button Released
 
-			// Clear the long press timer if we did not reach the long press timeout
-			if(app_push_button_timer != EASY_TIMER_INVALID_TIMER) 
+			if(!after_long_press) 
 				{ //Released after a Short press
-					app_easy_timer_cancel(app_push_button_timer);
-					app_push_button_timer = EASY_TIMER_INVALID_TIMER;
 
 #if (WKUP_KEYS_NUM > 1)
 			
@@ -1397,7 +1265,7 @@ static void _user_pb1_key_handler(bool pressed)
 						arch_printf("\n\n\r Button released after a short press...\n");
 					#endif
 	
-						if (adv_state_before == MOTION_ADVERTISING && !arch_ble_ext_wakeup_get())				
+						if (adv_timeline.base == MOTION_ADVERTISING && !arch_ble_ext_wakeup_get())				
 						{// If already in MOTION ADVERTISING do nothing (accelerometer is taking care)
 							#ifdef CFG_PRINTF
 							arch_printf("\n\n\r Motion adv still on, do nothing as accelerometer is in NO_MOTION detect mode\n");
@@ -1408,9 +1276,6 @@ static void _user_pb1_key_handler(bool pressed)
 							int_feat_enable = 0x20; // enable the NO_MOTION interrupt and disable the ANY_MOTION
 							arch_set_sleep_mode(app_default_sleep_mode);
 							arch_ble_force_wakeup();
-							adv_state = MOTION_ADVERTISING;
-							user_periodic_timer_init_once = 1;
-							//cancel_motion_adv = 1;
 
 							if (adv_state == SLEEP || arch_ble_ext_wakeup_get())
 								{// If we are in sleep => Wake up from sleep
@@ -1419,6 +1284,7 @@ static void _user_pb1_key_handler(bool pressed)
 									 arch_printf("\n\n\rRestart Motion adv\n");
 									 #endif
 									 arch_ble_ext_wakeup_off();
+									 adv_state = MOTION_ADVERTISING;
 									 user_app_adv_start();			
 								}	
 							else
@@ -1426,10 +1292,10 @@ static void _user_pb1_key_handler(bool pressed)
 									 #ifdef CFG_PRINTF
 									 arch_printf("\n\n\rSwitch to Motion adv due to Button press");
 									 #endif
-									 app_easy_gap_advertise_stop();
+									 user_timeline_switch_base(MOTION_ADVERTISING);
 								}
 
-							} // end of adv_state_before =! MOTION_ADVERTISING
+							} // end of base mode != MOTION_ADVERTISING
 #endif					
         }// End of Released after a Short press
 			else 
@@ -1443,14 +1309,11 @@ static void _user_pb1_key_handler(bool pressed)
 							#ifdef CFG_PRINTF
 							arch_puts("\n\n\rSet Sensor to ANY_MOTION detection, Stop adv and going to sleep...\n");
 							#endif
-							adv_state = SLEEP;
-//							app_easy_gap_advertise_stop();
-              user_enable_extended_sleep();
-							user_ble_gap_stop_ongoing_operation();
+							user_timeline_preempt(SLEEP);
 						}
 					else
 						{
-							// if system is already in SLEEP this point will never been reached as app_push_button_timer is not started
+							// Already in SLEEP, nothing to do
 						}
 #endif
 
@@ -1496,8 +1359,6 @@ static void _user_inertial_handle_interrupt()
 					 #endif
 						arch_ble_ext_wakeup_off();
 				    adv_state = MOTION_ADVERTISING;
-		        // This flag will recharge user_sleep_timout_timer with TIMEOUT_FOR_SLEEP and RX_ON timer with RX_ON value
-		        user_periodic_timer_init_once = 1;
 						user_app_adv_start();			
 					}	
         else
@@ -1505,16 +1366,13 @@ static void _user_inertial_handle_interrupt()
 					 #ifdef CFG_PRINTF
 						arch_printf("\n\n\rSwitch to Motion adv\n");
 					 #endif
-				    adv_state = MOTION_ADVERTISING;
-		        // This flag will recharge user_sleep_timout_timer with TIMEOUT_FOR_SLEEP and RX_ON timer with RX_ON value
-		        user_periodic_timer_init_once = 1;
-						app_easy_gap_advertise_stop(); // Stop Static ADV
+						user_timeline_switch_base(MOTION_ADVERTISING);
 					}
         
     } else if(int0_status & BMI270_NO_MOT_STATUS_MASK) {
-        // Timeout for NO_MOTION elapsed got to Static Adv!
+        // Timeout for NO_MOTION elapsed, go to Static Adv at the end of the duty cycle
         int_feat_enable = 0x40; // enable the ANY_MOTION interrupt and disable the NO_MOTION
-				cancel_motion_adv = 1;
+				adv_timeline_return_to(&adv_timeline, STATIC_ADVERTISING);
     }
     
     if(int_feat_enable) {
@@ -1571,8 +1429,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
   			uint16_t DeveloperID;
 				memcpy(&DeveloperID, &temp_report_data[16], sizeof(uint16_t));
-		    uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			  arch_printf("\n\r[%08d us] 5.REQ F1 found,", current_sys_tick);
+		    uint32_t timestamp_us = user_timeline_us();
+			  arch_printf("\n\r[%08d us] 5.REQ F1 found,", timestamp_us);
   			arch_printf("\r\n              5.Raw Data: %s", format_hex_string(temp_report_data, param->report.data_len));
   			arch_printf("\r\n              5.Header: %02x, Payload Type: %02x, DevID: %04x, Data: %s", temp_report_data[8], temp_report_data[15], DeveloperID, format_hex_string(temp_report_data + 16, param->report.data_len-16));
 	      arch_printf("\r\n              5.BD Tgt: %s , BD Own: %s", format_hex_string(temp_report_data + 9, 6), format_hex_string(reverse_bd_addr, 6));
@@ -1581,8 +1439,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
     if(!memcmp(temp_report_data + 9, reverse_bd_addr, 6))
 			{
 			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		    uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	      arch_printf("\r\n[%08d us] 5.BD Tgt: %s = BD Own: %s => STOP SCAN", current_sys_tick, format_hex_string(temp_report_data + 9, 6), format_hex_string(reverse_bd_addr, 6));
+		    uint32_t timestamp_us = user_timeline_us();
+	      arch_printf("\r\n[%08d us] 5.BD Tgt: %s = BD Own: %s => STOP SCAN", timestamp_us, format_hex_string(temp_report_data + 9, 6), format_hex_string(reverse_bd_addr, 6));
 			#endif
       req_found = true;
       memcpy(report_data, temp_report_data, param->report.data_len);
@@ -1594,8 +1452,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 					case BACK_CHANNEL_INFO: // Payload Type: 0x02
 					{
 				    #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		         uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			       arch_printf("\n\r[%08d us] 5.Payload Type: 0x02 Back Channel Info received", current_sys_tick);
+		         uint32_t timestamp_us = user_timeline_us();
+			       arch_printf("\n\r[%08d us] 5.Payload Type: 0x02 Back Channel Info received", timestamp_us);
 				    #endif
 
 						mnf_data.proprietary_data[0] = 0xF2; // Quuppa Packet ID: 0xF2 = RSP Packet;
@@ -1628,8 +1486,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 					case DEVICE_INFO: // Payload Type: 0x01
 					{
 				    #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		         uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			       arch_printf("\n\r[%08d us] 5.Payload Type: 0x01 Device Info received", current_sys_tick);
+		         uint32_t timestamp_us = user_timeline_us();
+			       arch_printf("\n\r[%08d us] 5.Payload Type: 0x01 Device Info received", timestamp_us);
 				    #endif
 
 						get_device_info();
@@ -1665,8 +1523,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 					case DEVELOPER_SPECIFIC: // Payload Type: 0xFF
 					{
 				    #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		         uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			       arch_printf("\n\r[%08d us] 5.Payload Type: 0xFF Developer Specific received", current_sys_tick);
+		         uint32_t timestamp_us = user_timeline_us();
+			       arch_printf("\n\r[%08d us] 5.Payload Type: 0xFF Developer Specific received", timestamp_us);
 				    #endif
 
             // Prepare manufacturer specific data general part
@@ -1690,8 +1548,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
                 // Execute command
                 toggle_led();
 								#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-		              uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-			            arch_printf("\n\r[%08d us] 5.Command LED Toggled executed", current_sys_tick);
+		              uint32_t timestamp_us = user_timeline_us();
+			            arch_printf("\n\r[%08d us] 5.Command LED Toggled executed", timestamp_us);
 			          #endif
                 // Prepare the rest of the payload
 								mnf_data.proprietary_data[11] = 0x01;      // Command type: 0x01 = Toggle LED
@@ -1737,8 +1595,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 					default: //UNSUPPORTED_REQ
 					{
 				    #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-              uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	            arch_printf("\n\r[%08d us] 5.Payload Type: 0x00 Unsupported REQ received", current_sys_tick);
+              uint32_t timestamp_us = user_timeline_us();
+	            arch_printf("\n\r[%08d us] 5.Payload Type: 0x00 Unsupported REQ received", timestamp_us);
 				    #endif
 
 						mnf_data.proprietary_data[0] = 0xF2; // Quuppa Packet ID: 0xF2 = RSP Packet;
@@ -1770,8 +1628,8 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 					}
         }	// switch(report_data[15])			
 				#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-					current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-					arch_printf("\n\r[%08d us] 5.Stop Scan", current_sys_tick);
+					timestamp_us = user_timeline_us();
+					arch_printf("\n\r[%08d us] 5.Stop Scan", timestamp_us);
 				#endif
 				user_ble_gap_stop_ongoing_operation();	
 			} //if(!memcmp(temp_report_data + 9, reverse_bd_addr, 6))
@@ -1788,55 +1646,29 @@ void user_on_adv_report_ind(struct gapm_adv_report_ind const * param)
 void user_on_scanning_completed(uint8_t reason)
 {
 			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-         uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-	       arch_printf("\n\r[%08d us] 6.Scanning completed", current_sys_tick);
+         uint32_t timestamp_us = user_timeline_us();
+	       arch_printf("\n\r[%08d us] 6.Scanning completed", timestamp_us);
 			#endif
 
-	if (adv_state != SLEEP)
+	if(reason == GAP_ERR_CANCELED)
 		{
-			if(reason == GAP_ERR_CANCELED)
-				{
-					#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-						 uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-						 arch_printf("\n\r[%08d us] 6.Scanning cancelled", current_sys_tick);
-					#endif
-		 
-					if (user_scan_cancel_timer != EASY_TIMER_INVALID_TIMER)
-						{
-								app_easy_timer_cancel(user_scan_cancel_timer);
-								user_scan_cancel_timer = EASY_TIMER_INVALID_TIMER;
-						}
-
-					if (req_found == false)
-						{
-						 #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-							 uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-							 arch_printf("\n\r[%08d us] 6.No REQ packet received", current_sys_tick);
-						 #endif
+			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
+				 uint32_t timestamp_us = user_timeline_us();
+				 arch_printf("\n\r[%08d us] 6.Scanning cancelled, %s", timestamp_us,
+				             req_found ? "REQ packet received, start sending RSP" : "No REQ packet received");
+			#endif
 
-						 user_change_adv_state(DEV_INFO);
-						}
-					if (req_found == true)
-						{
-						 #if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-							 uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-							 arch_printf("\n\r[%08d us] 6.REQ packet received, start sending RSP", current_sys_tick);
-						 #endif
-						 user_change_adv_state(RSP_ADVERTISING);
-						 req_found = false;
-						}
-					user_app_adv_start();
-				}
-				else
-				{
-					#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
-						uint32_t current_sys_tick = SYSTICK_PERIOD_US - systick_value();
-						arch_printf("\n\r[%08d us] 6.Scan Error", current_sys_tick);
-						arch_printf("\n\r                 %s: ERR: reason: %d", __func__, reason);
-		//			arch_puts("\n\rscanning completed, start advertising");
-					#endif
-				}
-			}
+			// The timeline goes on with RSP after a REQ packet, with DEV_INFO otherwise
+			user_timeline_advance();
+		}
+		else
+		{
+			#if (defined CFG_PRINTF && SHOW_ALL_MESSAGES == 1)
+				uint32_t timestamp_us = user_timeline_us();
+				arch_printf("\n\r[%08d us] 6.Scan Error", timestamp_us);
+				arch_printf("\n\r                 %s: ERR: reason: %d", __func__, reason);
+			#endif
+		}
 }
 
 static void _user_inertial_sensor_int_key_handler(bool pressed)
@@ -1849,20 +1681,29 @@ static void _user_inertial_sensor_int_key_handler(bool pressed)
 }
 
 #ifdef HAS_WKUP_KEYS
-void user_wkup_keys_notification_cb(enum wkup_keys key, bool pressed)
+void user_wkup_keys_notification_cb(const struct wkup_keys_event *evt)
 {
-    switch(key)
+    switch(evt->type)
     {
-        case PUSH_BUTTON_1_KEY:
-            _user_pb1_key_handler(pressed);
+        case WKUP_KEYS_EVT_CHANGE:
+            if(evt->keys & WKUP_KEY_BIT(INERTIAL_SENSOR_INTERRUPT_KEY)) {
+                _user_inertial_sensor_int_key_handler((evt->pressed & WKUP_KEY_BIT(INERTIAL_SENSOR_INTERRUPT_KEY)) != 0);
+            }
+            if(evt->keys & WKUP_KEY_BIT(PUSH_BUTTON_1_KEY)) {
+                _user_pb1_key_handler((evt->pressed & WKUP_KEY_BIT(PUSH_BUTTON_1_KEY)) != 0,
+                                      (evt->long_keys & WKUP_KEY_BIT(PUSH_BUTTON_1_KEY)) != 0);
+            }
             break;
             
-        case INERTIAL_SENSOR_INTERRUPT_KEY:
-            _user_inertial_sensor_int_key_handler(pressed);
+        case WKUP_KEYS_EVT_LONG_PRESS:
+            if(evt->keys & WKUP_KEY_BIT(PUSH_BUTTON_1_KEY)) {
+                _user_pb1_long_press_handler();
+            }
             break;
             
         default:
-            ASSERT_ERROR(0);
+            // No chords configured
+            break;
     }
 }
 #endif
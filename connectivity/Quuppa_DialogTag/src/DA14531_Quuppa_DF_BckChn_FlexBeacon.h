@@ -58,6 +58,7 @@
 #include "app.h"                       // application definitions
 #include "app_callback.h"
 #include "arch_api.h"
+#include "user_adv_timeline.h"
 
 /*
  * DEFINES
@@ -169,8 +170,6 @@
 /* Advertising data update timer */
 #define APP_ADV_DATA_UPDATE_TO              (3000)   // 3000*10ms = 30sec, The maximum allowed value is 41943sec (4194300 * 10ms)
 
-#define APP_BUTTON_LONG_PRESS_TO            (400)    // 400*10ms = 4sec, The maximum allowed value is 41943sec (4194300 * 10ms)
-
 #define APP_PERIPHERAL_CTRL_TIMER_DELAY 100
 
 /*
@@ -188,6 +187,18 @@ typedef enum
 	  DEV_INFO,
 		SLEEP 						
 }advertising_state;
+
+/// Number of advertising states
+#define ADV_STATE_COUNT     (SLEEP + 1)
+
+/*
+ * GLOBAL VARIABLE DECLARATIONS
+ ****************************************************************************************
+ */
+
+/// Duty cycle of the tag, indexed by advertising_state (user_adv_timeline_table.c)
+extern const struct adv_timeline_slot adv_timeline_table[ADV_STATE_COUNT];
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
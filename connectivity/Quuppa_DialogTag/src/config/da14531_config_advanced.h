@@ -200,7 +200,7 @@
 /****************************************************************************************************************/
 /* Maximum uninitialized retained data required by the application.                                             */
 /****************************************************************************************************************/
-#define CFG_RET_DATA_UNINIT_SIZE (0)
+#define CFG_RET_DATA_UNINIT_SIZE (16)
 
 /****************************************************************************************************************/
 /* RAM cell(s) retention mode handling. The user has to select which RAM cells must be retained during the      */
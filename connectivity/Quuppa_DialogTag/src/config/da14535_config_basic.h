@@ -117,7 +117,7 @@
 /****************************************************************************************************************/
 #undef CFG_UART_DMA_SUPPORT
 #undef CFG_SPI_DMA_SUPPORT
-#undef CFG_I2C_DMA_SUPPORT
+#define CFG_I2C_DMA_SUPPORT
 #undef CFG_ADC_DMA_SUPPORT
 
 /****************************************************************************************************************/
@@ -31,22 +31,32 @@
 #ifdef HAS_WKUP_KEYS
 #include "wkup_keys.h"
 #include "wkupct_quadec.h"
+#include "app_easy_timer.h"
+#include "lld_evt.h"
 
 #define WKUP_KEYS_DEBOUNCE_TIME_MS   (WKUP_KEYS_CFG_DEBOUNCE_TIME_MS)
 
-typedef struct
-{
-   bool pressed;
-   bool notif_pending;
-} wkup_key_async_notif_t;
-
-bool wkup_key_last_state[WKUP_KEYS_NUM]                  __SECTION_ZERO("retention_mem_area0");
-wkup_key_async_notif_t wkup_key_notif[WKUP_KEYS_NUM]     __SECTION_ZERO("retention_mem_area0");
+struct wkup_keys_evt_state wkup_keys_evt                 __SECTION_ZERO("retention_mem_area0");
+// Level the wakeup controller is armed against, updated by the interrupt
+uint16_t wkup_key_raw                                    __SECTION_ZERO("retention_mem_area0");
+// Keys in their settle window, as seen by the interrupt
+uint16_t wkup_key_settling                               __SECTION_ZERO("retention_mem_area0");
+uint16_t wkup_key_channel_keys[WKUP_KEYS_CHANNEL_NUM]    __SECTION_ZERO("retention_mem_area0");
+bool wkup_key_msg_pending                                __SECTION_ZERO("retention_mem_area0");
+timer_hnd wkup_key_timer                                 __SECTION_ZERO("retention_mem_area0");
 uint16_t wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_NUM]     __SECTION_ZERO("retention_mem_area0");
 uint16_t wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_NUM]     __SECTION_ZERO("retention_mem_area0");  
 uint16_t wkup_key_mask[WKUP_KEYS_CHANNEL_NUM]       __SECTION_ZERO("retention_mem_area0");
 
-typedef void (*wkup_keys_notification_t)(enum wkup_keys key, bool pressed);
+static const struct wkup_keys_evt_cfg wkup_keys_evt_cfg = {
+    .settle     = WKUP_KEYS_EVT_MS_TO_SLOTS(WKUP_KEYS_CFG_SETTLE_TIME_MS),
+    .long_press = WKUP_KEYS_EVT_MS_TO_SLOTS(WKUP_KEYS_CFG_LONG_PRESS_MS),
+    .chord      = WKUP_KEYS_EVT_MS_TO_SLOTS(WKUP_KEYS_CFG_CHORD_WINDOW_MS),
+    .long_mask  = WKUP_KEYS_CFG_LONG_PRESS_MASK,
+    .chord_mask = WKUP_KEYS_CFG_CHORD_MASK,
+};
+
+typedef void (*wkup_keys_notification_t)(const struct wkup_keys_event *evt);
 static const wkup_keys_notification_t wkup_keys_notification = WKUP_KEYS_NOTIFICATION_CB;
 
 static void _wkup_interrupt_handler(uint8_t channel);
@@ -55,10 +65,10 @@ static void _wkup_keys_handler(void);
 static void _wkup_keys_handler_2(void);
 #endif // WKUP_KEYS_USE_BOTH_CHANNELS
 static bool _wkup_get_pin_state(uint8_t pin);
-static void _wkup_keys_send_async_notification(enum wkup_keys key, bool pressed);
-static void _wkup_keys_process_async_notification(void);
+static uint16_t _wkup_keys_sample(void);
+static void _wkup_keys_post(void);
+static void _wkup_keys_run(void);
 static void _wkup_keys_enable_irq(uint8_t channel);
-static void _wkup_keys_handle_key_channel_event(uint8_t wkup_channel);
 
 static void _wkup_keys_enable_channel_irq(uint8_t chan, uint16_t mask)
 {
@@ -73,11 +83,22 @@ static void _wkup_keys_disable_channel_irq(uint8_t chan, uint16_t mask)
 
 static void _wkup_interrupt_handler(uint8_t channel)
 {
+    uint16_t keys = wkup_key_channel_keys[channel];
+    uint16_t raw;
+    uint16_t changed;
+    
     wkup_keys_init(true);
     
-    arch_ble_force_wakeup();
+    raw = _wkup_keys_sample();
+    changed = (raw ^ wkup_key_raw) & keys;
+    wkup_key_raw = (wkup_key_raw & ~keys) | (raw & keys);
     
-    _wkup_keys_handle_key_channel_event(channel);
+    // The edges of settling keys are picked up by the timer when their window closes,
+    // the application is not woken up for them. The timer does not run while the BLE
+    // waits for an external wakeup, then every edge is passed on.
+    if ((changed & ~wkup_key_settling) || (changed && arch_ble_ext_wakeup_get())) {
+        _wkup_keys_post();
+    }
     
     _wkup_keys_enable_irq(channel);
 }
@@ -111,37 +132,80 @@ static bool _wkup_get_pin_state(uint8_t i)
     return GPIO_GetPinStatus((GPIO_PORT)wkup_keys_pins[i].port, (GPIO_PIN)wkup_keys_pins[i].pin); 
 }
 
-static void _wkup_keys_process_async_notification()
+static uint16_t _wkup_keys_sample()
 {
+    uint16_t pressed = 0;
     uint8_t i;
-    for (i = 0; i < WKUP_KEYS_NUM; i++)
-    {
-        // Search for the first key that there is a notification pending
-        if(wkup_key_notif[i].notif_pending) {
-            
-            // Set the pending flag to false
-            wkup_key_notif[i].notif_pending = false;
-            
-            // And call the user callback for that key
-            wkup_keys_notification((enum wkup_keys)i, wkup_key_notif[i].pressed);   
-            return;
+    
+    for (i = 0; i < WKUP_KEYS_NUM; i++) {
+        if (_wkup_get_pin_state(i) != wkup_keys_pins[i].high) {
+            pressed |= WKUP_KEY_BIT(i);
         }
     }
+    
+    return pressed;
 }
 
-static void _wkup_keys_send_async_notification(enum wkup_keys key, bool pressed)
+static void _wkup_keys_process_msg()
 {
-    ASSERT_WARNING((int)key <= WKUP_KEYS_NUM);
+    wkup_key_msg_pending = false;
+    _wkup_keys_run();
+}
 
-    // Set the notification pending to true
-    wkup_key_notif[key].notif_pending = true;
+static void _wkup_keys_timer_cb()
+{
+    wkup_key_timer = EASY_TIMER_INVALID_TIMER;
+    _wkup_keys_run();
+}
+
+static void _wkup_keys_post()
+{
+    // One message carries all the edges until it is processed
+    if (!wkup_key_msg_pending) {
+        wkup_key_msg_pending = true;
+        arch_ble_force_wakeup();
+        
+        // Create a message to process the event on normal context
+        ke_msg_id_t msg = app_easy_msg_set(_wkup_keys_process_msg);
+        ke_msg_send_basic(msg, TASK_APP, 0);
+    }
+}
+
+static void _wkup_keys_run()
+{
+    struct wkup_keys_event evt;
+    uint16_t settling = wkup_key_settling;
+    uint32_t now = lld_evt_time_get();
+    uint32_t deadline;
+    uint32_t ticks;
+    
+    wkup_keys_evt_update(&wkup_keys_evt, now, wkup_key_raw);
+    
+    // The debounce of a channel is longer while one of its keys settles
+    if (wkup_keys_evt.settling != settling) {
+        GLOBAL_INT_DISABLE();
+        wkup_key_settling = wkup_keys_evt.settling;
+        _wkup_keys_enable_irq(WKUP_KEYS_CHANNEL_1);
+#if WKUP_KEYS_USE_BOTH_CHANNELS
+        _wkup_keys_enable_irq(WKUP_KEYS_CHANNEL_2);
+#endif
+        GLOBAL_INT_RESTORE();
+    }
     
-    // Pass the current button status
-    wkup_key_notif[key].pressed = pressed;
+    if (wkup_key_timer != EASY_TIMER_INVALID_TIMER) {
+        app_easy_timer_cancel(wkup_key_timer);
+        wkup_key_timer = EASY_TIMER_INVALID_TIMER;
+    }
     
-    // Create a message to process the event on normal context
-    ke_msg_id_t msg = app_easy_msg_set(_wkup_keys_process_async_notification);
-    ke_msg_send_basic(msg, TASK_APP, 0);
+    if (wkup_keys_evt_deadline(&wkup_keys_evt, &deadline)) {
+        // Slots to 10 ms timer ticks, rounded up
+        ticks = (wkup_keys_evt_elapsed(deadline, now) * 625 + 9999) / 10000;
+        wkup_key_timer = app_easy_timer((ticks > 0) ? ticks : 1, _wkup_keys_timer_cb);
+    }
+    
+    while (wkup_keys_evt_pop(&wkup_keys_evt, &evt)) {
+        wkup_keys_notification(&evt);
+    }
 }
 
 
@@ -149,21 +213,26 @@ static void _wkup_keys_enable_irq(uint8_t channel)
 {
     uint8_t i;
     uint16_t pol[2] = {0, 0};
+    uint16_t debounce;
     bool pressed;
     
+    // Armed for the next edge of the sampled level, not of the reported one, so that an
+    // edge held back by the settle window does not trigger again
     for(i = 0; i < WKUP_KEYS_NUM; i++) {
         if(wkup_keys_pins[i].channel == channel) {
-            pressed = wkup_key_last_state[i];
+            pressed = (wkup_key_raw & WKUP_KEY_BIT(i)) != 0;
             if( (wkup_keys_pins[i].high == 0) ? pressed : !pressed) {
                 pol[wkup_keys_pins[i].channel] |= WKUPCT_PIN_SELECT(wkup_keys_pins[i].port, wkup_keys_pins[i].pin);
             }
         }
     }   
     
+    debounce = (wkup_key_settling & wkup_key_channel_keys[channel]) ? WKUP_KEYS_CFG_SETTLE_DEBOUNCE_MS : WKUP_KEYS_DEBOUNCE_TIME_MS;
+    
     if(channel == WKUP_KEYS_CHANNEL_1) {
         wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_1] = wkup_key_mask[WKUP_KEYS_CHANNEL_1];
         wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_1]  = (wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_1] & ~wkup_key_mask[WKUP_KEYS_CHANNEL_1]) | (pol[WKUP_KEYS_CHANNEL_1] & wkup_key_mask[WKUP_KEYS_CHANNEL_1]);
-        wkupct_enable_irq(wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_1], wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_1], 1, WKUP_KEYS_DEBOUNCE_TIME_MS);
+        wkupct_enable_irq(wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_1], wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_1], 1, debounce);
         return;
     }
     
@@ -171,31 +240,12 @@ static void _wkup_keys_enable_irq(uint8_t channel)
     if (channel == WKUP_KEYS_CHANNEL_2) {
         wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_2] = wkup_key_mask[WKUP_KEYS_CHANNEL_2];
         wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_2]  = (wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_2] & ~wkup_key_mask[WKUP_KEYS_CHANNEL_2]) | (pol[WKUP_KEYS_CHANNEL_2] & wkup_key_mask[WKUP_KEYS_CHANNEL_2]);
-        wkupct2_enable_irq(wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_2], wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_2], 1, WKUP_KEYS_DEBOUNCE_TIME_MS);
+        wkupct2_enable_irq(wkup_key_pin_cfg[WKUP_KEYS_CHANNEL_2], wkup_key_pol_cfg[WKUP_KEYS_CHANNEL_2], 1, debounce);
         return;
     }
 #endif
 }
 
-
-static void _wkup_keys_handle_key_channel_event(uint8_t wkup_channel)
-{
-    uint8_t current_state,i;
-    
-    for(i = 0; i < WKUP_KEYS_NUM; i++) {
-        if(wkup_channel == wkup_keys_pins[i].channel) {
-            current_state = _wkup_get_pin_state(i);       
-            current_state = (wkup_keys_pins[i].high == 0)?(current_state):(!current_state);
-            if(wkup_key_last_state[i] != current_state) {
-                wkup_key_last_state[i] = current_state;
-                _wkup_keys_send_async_notification((enum wkup_keys)i, current_state);
-            }
-        }
-    }
-    
-    _wkup_keys_enable_irq(wkup_channel);
-}
-
 void wkup_keys_modify_irq(uint8_t key, bool enable)
 {
     
@@ -222,30 +272,27 @@ void wkup_keys_modify_irq(uint8_t key, bool enable)
 
 uint8_t wkup_keys_is_pressed(uint8_t key)
 {
-    return wkup_key_last_state[key];
+    return (wkup_keys_evt.pressed & WKUP_KEY_BIT(key)) != 0;
 }
 
 bool wkup_keys_get_state(uint8_t key)
 {   
-    uint8_t status;
-    
-    status = _wkup_get_pin_state(key);
-    
-    wkup_key_last_state[key] = (wkup_keys_pins[key].high == 0) ? status : !status;
-    return (bool)wkup_key_last_state[key];
+    return _wkup_get_pin_state(key) != wkup_keys_pins[key].high;
 }
 
 void wkup_keys_init(bool init_pins_only)
 {
     uint8_t i;
 
+    for(i = 0; i < WKUP_KEYS_NUM; i++) {
+        GPIO_SetPinFunction((GPIO_PORT)wkup_keys_pins[i].port, (GPIO_PIN)wkup_keys_pins[i].pin, 
+            (GPIO_PUPD)(wkup_keys_pins[i].mode_function & 0xFF00),  (GPIO_FUNCTION)(wkup_keys_pins[i].mode_function & 0xFF));
+    }
+    
     if(!init_pins_only) {
-        for(i = 0; i < WKUP_KEYS_NUM; i++) {
-            wkup_key_last_state[i] =  _wkup_get_pin_state(i);
-            if(wkup_keys_pins[i].high) {
-                wkup_key_last_state[i] = !wkup_key_last_state[i];
-            }
-        }
+        wkup_key_raw = _wkup_keys_sample();
+        wkup_key_settling = 0;
+        wkup_keys_evt_init(&wkup_keys_evt, &wkup_keys_evt_cfg, wkup_key_raw);
         
         _wkup_keys_enable_irq(WKUP_KEYS_CHANNEL_1);
         
@@ -253,11 +300,6 @@ void wkup_keys_init(bool init_pins_only)
         _wkup_keys_enable_irq(WKUP_KEYS_CHANNEL_2);
 #endif // WKUP_KEYS_USE_BOTH_CHANNELS
     }
-    
-    for(i = 0; i < WKUP_KEYS_NUM; i++) {
-        GPIO_SetPinFunction((GPIO_PORT)wkup_keys_pins[i].port, (GPIO_PIN)wkup_keys_pins[i].pin, 
-            (GPIO_PUPD)(wkup_keys_pins[i].mode_function & 0xFF00),  (GPIO_FUNCTION)(wkup_keys_pins[i].mode_function & 0xFF));
-    }
 }
 
 void wkup_keys_setup()
@@ -270,8 +312,18 @@ void wkup_keys_setup()
     for(i = 0; i < WKUP_KEYS_CHANNEL_NUM; i++) {
         wkup_key_pin_cfg[i] = 0;
         wkup_key_pol_cfg[i] = 0;
+        wkup_key_channel_keys[i] = 0;
     }
     
+    for(i = 0; i < WKUP_KEYS_NUM; i++) {
+        if(wkup_keys_pins[i].channel < WKUP_KEYS_CHANNEL_NUM) {
+            wkup_key_channel_keys[wkup_keys_pins[i].channel] |= WKUP_KEY_BIT(i);
+        }
+    }
+    
+    wkup_key_msg_pending = false;
+    wkup_key_timer = EASY_TIMER_INVALID_TIMER;
+    
     wkupct_disable_irq();
     wkupct_register_callback(_wkup_keys_handler);
     
@@ -8,8 +8,37 @@
 #define WKUP_KEYS_CHANNEL_2     (1)
 #define WKUP_KEYS_CHANNEL_NUM   (2)
 
+#define WKUP_KEY_BIT(key)       (1U << (key))
+
+#include "wkup_keys_events.h"
 #include "wkup_keys_config.h"
 
+// Wakeup controller debounce while a key settles, at most 63 ms
+#ifndef WKUP_KEYS_CFG_SETTLE_DEBOUNCE_MS
+    #define WKUP_KEYS_CFG_SETTLE_DEBOUNCE_MS    (WKUP_KEYS_CFG_DEBOUNCE_TIME_MS)
+#endif
+
+// Edges of a key within this time of a reported change are held back, 0 disables it
+#ifndef WKUP_KEYS_CFG_SETTLE_TIME_MS
+    #define WKUP_KEYS_CFG_SETTLE_TIME_MS        (0)
+#endif
+
+#ifndef WKUP_KEYS_CFG_LONG_PRESS_MS
+    #define WKUP_KEYS_CFG_LONG_PRESS_MS         (0)
+#endif
+
+#ifndef WKUP_KEYS_CFG_LONG_PRESS_MASK
+    #define WKUP_KEYS_CFG_LONG_PRESS_MASK       (0)
+#endif
+
+#ifndef WKUP_KEYS_CFG_CHORD_WINDOW_MS
+    #define WKUP_KEYS_CFG_CHORD_WINDOW_MS       (0)
+#endif
+
+#ifndef WKUP_KEYS_CFG_CHORD_MASK
+    #define WKUP_KEYS_CFG_CHORD_MASK            (0)
+#endif
+
 #define PORT_UNUSED  0xFF
 #define PIN_UNUSED   0xFF
 #define CHANNEL_NONE 0xFF
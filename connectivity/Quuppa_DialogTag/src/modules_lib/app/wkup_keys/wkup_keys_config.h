@@ -63,6 +63,20 @@
 
 #define WKUP_KEYS_CFG_DEBOUNCE_TIME_MS  (10)
 
+// Wakeup controller debounce while a key settles, at most 63 ms
+#define WKUP_KEYS_CFG_SETTLE_DEBOUNCE_MS    (30)
+
+// Edges of a key within this time of a reported change are held back
+#define WKUP_KEYS_CFG_SETTLE_TIME_MS        (50)
+
+// Long press of the push button
+#define WKUP_KEYS_CFG_LONG_PRESS_MS         (4000)
+#define WKUP_KEYS_CFG_LONG_PRESS_MASK       (WKUP_KEY_BIT(PUSH_BUTTON_1_KEY))
+
+// No chords, the sensor interrupt is not a key to combine with the push button. Keys set
+// in the chord mask also need WKUP_KEYS_CFG_CHORD_WINDOW_MS
+#define WKUP_KEYS_CFG_CHORD_MASK            (0)
+
 #define WKUP_KEYS_USE_BOTH_CHANNELS     (1)
 
 enum wkup_keys
@@ -71,12 +85,13 @@ enum wkup_keys
     PUSH_BUTTON_1_KEY,
 };
 
-void user_wkup_keys_notification_cb(enum wkup_keys key, bool pressed);
+void user_wkup_keys_notification_cb(const struct wkup_keys_event *evt);
 
 /**
  ****************************************************************************************
- * \brief This callback will be called to notify the application that a key has been
- *        pressed or released.
+ * \brief This callback will be called to notify the application that keys have been
+ *        pressed or released, held for the long press time or pressed as a chord. The
+ *        keys of the event are a bit mask, see WKUP_KEY_BIT().
  ****************************************************************************************
  */
 
@@ -0,0 +1,250 @@
+/**
+ ****************************************************************************************
+ *
+ * @file wkup_keys_events.c
+ *
+ * @brief Wakeup keys event queue source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "wkup_keys_events.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Half the BLE base time period, the longest time that can be told from a past one
+#define WKUP_KEYS_EVT_HALF_PERIOD   ((WKUP_KEYS_EVT_TIME_MASK + 1) / 2)
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// True if t is not later than now
+static bool wkup_keys_evt_due(uint32_t now, uint32_t t)
+{
+    return wkup_keys_evt_elapsed(now, t) < WKUP_KEYS_EVT_HALF_PERIOD;
+}
+
+static uint32_t wkup_keys_evt_long_end(const struct wkup_keys_evt_state *st)
+{
+    return (st->long_start + st->cfg->long_press) & WKUP_KEYS_EVT_TIME_MASK;
+}
+
+static void wkup_keys_evt_push(struct wkup_keys_evt_state *st, uint8_t type, uint32_t time,
+                               uint16_t keys, uint16_t long_keys)
+{
+    struct wkup_keys_event *evt;
+
+    if (st->count == WKUP_KEYS_EVT_QUEUE_LEN)
+    {
+        st->head = (st->head + 1) % WKUP_KEYS_EVT_QUEUE_LEN;
+        st->count--;
+
+        if (st->overflows < UINT8_MAX)
+        {
+            st->overflows++;
+        }
+    }
+
+    evt = &st->queue[(st->head + st->count) % WKUP_KEYS_EVT_QUEUE_LEN];
+    evt->time = time;
+    evt->pressed = st->pressed;
+    evt->keys = keys;
+    evt->long_keys = long_keys;
+    evt->type = type;
+    st->count++;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Reports the sampled level of the changed keys and starts their settle window.
+ ****************************************************************************************
+ */
+static void wkup_keys_evt_change(struct wkup_keys_evt_state *st, uint32_t time, uint16_t changed)
+{
+    const struct wkup_keys_evt_cfg *cfg = st->cfg;
+    uint16_t before = st->pressed;
+    uint16_t down;
+    uint16_t up;
+    uint16_t chord;
+
+    st->pressed = (before & ~changed) | (st->raw & changed);
+    down = changed & st->pressed;
+    up = changed & before;
+
+    wkup_keys_evt_push(st, WKUP_KEYS_EVT_CHANGE, time, changed, up & st->long_fired);
+    st->long_fired &= ~up;
+
+    if (cfg->settle != 0)
+    {
+        st->settling |= changed;
+        st->settle_end = (time + cfg->settle) & WKUP_KEYS_EVT_TIME_MASK;
+    }
+
+    // A chord collects the keys pressed within the window of the first one
+    if (down & cfg->chord_mask)
+    {
+        if ((before & cfg->chord_mask) == 0)
+        {
+            st->chord_start = time;
+            st->chord_keys = down & cfg->chord_mask;
+        }
+        else if ((st->chord_keys != 0) && (wkup_keys_evt_elapsed(time, st->chord_start) <= cfg->chord))
+        {
+            st->chord_keys |= down & cfg->chord_mask;
+        }
+
+        if ((st->chord_keys & (st->chord_keys - 1)) && (down & st->chord_keys))
+        {
+            wkup_keys_evt_push(st, WKUP_KEYS_EVT_CHORD, time, st->chord_keys, 0);
+        }
+    }
+
+    if ((st->pressed & cfg->chord_mask) == 0)
+    {
+        st->chord_keys = 0;
+    }
+
+    // Keys of a chord do not report a long press
+    chord = (st->chord_keys & (st->chord_keys - 1)) ? st->chord_keys : 0;
+
+    if (down & cfg->long_mask & ~chord)
+    {
+        st->long_start = time;
+    }
+
+    st->long_armed = st->pressed & cfg->long_mask & ~st->long_fired & ~chord;
+}
+
+void wkup_keys_evt_init(struct wkup_keys_evt_state *st, const struct wkup_keys_evt_cfg *cfg,
+                        uint16_t pressed)
+{
+    st->cfg = cfg;
+    st->pressed = pressed;
+    st->raw = pressed;
+    st->settling = 0;
+    st->long_armed = 0;
+    st->long_fired = 0;
+    st->chord_keys = 0;
+    st->settle_end = 0;
+    st->long_start = 0;
+    st->chord_start = 0;
+    st->head = 0;
+    st->count = 0;
+    st->overflows = 0;
+}
+
+void wkup_keys_evt_update(struct wkup_keys_evt_state *st, uint32_t now, uint16_t raw)
+{
+    uint16_t changed;
+
+    // The windows that closed before now run first, in time order
+    for (;;)
+    {
+        bool settle_due = (st->settling != 0) && wkup_keys_evt_due(now, st->settle_end);
+        bool long_due = (st->long_armed != 0) && wkup_keys_evt_due(now, wkup_keys_evt_long_end(st));
+
+        if (settle_due && (!long_due || wkup_keys_evt_due(wkup_keys_evt_long_end(st), st->settle_end)))
+        {
+            // The settled keys report the level they ended on
+            uint32_t time = st->settle_end;
+
+            st->settling = 0;
+            changed = st->raw ^ st->pressed;
+
+            if (changed)
+            {
+                wkup_keys_evt_change(st, time, changed);
+            }
+        }
+        else if (long_due)
+        {
+            wkup_keys_evt_push(st, WKUP_KEYS_EVT_LONG_PRESS, wkup_keys_evt_long_end(st), st->long_armed, 0);
+            st->long_fired |= st->long_armed;
+            st->long_armed = 0;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    st->raw = raw;
+    changed = (raw ^ st->pressed) & ~st->settling;
+
+    if (changed)
+    {
+        wkup_keys_evt_change(st, now, changed);
+    }
+}
+
+bool wkup_keys_evt_deadline(const struct wkup_keys_evt_state *st, uint32_t *deadline)
+{
+    bool pending = false;
+
+    if (st->settling != 0)
+    {
+        *deadline = st->settle_end;
+        pending = true;
+    }
+
+    if ((st->long_armed != 0) && (!pending || wkup_keys_evt_due(*deadline, wkup_keys_evt_long_end(st))))
+    {
+        *deadline = wkup_keys_evt_long_end(st);
+        pending = true;
+    }
+
+    return pending;
+}
+
+bool wkup_keys_evt_pop(struct wkup_keys_evt_state *st, struct wkup_keys_event *evt)
+{
+    if (st->count == 0)
+    {
+        return false;
+    }
+
+    *evt = st->queue[st->head];
+    st->head = (st->head + 1) % WKUP_KEYS_EVT_QUEUE_LEN;
+    st->count--;
+
+    return true;
+}
+
+/// @} APP
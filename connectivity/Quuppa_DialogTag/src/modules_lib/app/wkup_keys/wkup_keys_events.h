@@ -0,0 +1,221 @@
+/**
+ ****************************************************************************************
+ *
+ * @file wkup_keys_events.h
+ *
+ * @brief Wakeup keys event queue header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef WKUP_KEYS_EVENTS_H
+#define WKUP_KEYS_EVENTS_H
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * Debounced key state, gestures and a time stamped event queue for the wakeup keys. The
+ * keys are handled as bit masks, bit n for key n.
+ *
+ * The wakeup controller filters bounces shorter than its debounce time while the system
+ * sleeps, so every sample given to wkup_keys_evt_update() is a stable level. A reported
+ * change starts a settle window for the keys that changed. Further edges of these keys
+ * within the window are not reported, the level they end on is reported when the window
+ * closes. The keys are handled together, a key that changes during the window of
+ * another one extends that window.
+ *
+ * Keys of the long press mask that are held for the long press time are reported once,
+ * the time counts from the last of them pressed. Their release event flags them, so
+ * that a short and a long press can be told apart. Keys
+ * of the chord mask that are pressed within the chord window of the first one are
+ * reported as a chord, and do not report a long press.
+ *
+ * Times are in 625 us slots of the BLE base time, on 27 bits. Elapsed times are taken
+ * modulo its period.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// BLE base time period mask, 27 bits
+#define WKUP_KEYS_EVT_TIME_MASK     (0x07FFFFFFUL)
+
+/// Converts milliseconds to 625 us slots
+#define WKUP_KEYS_EVT_MS_TO_SLOTS(ms)   (((uint32_t)(ms) * 8) / 5)
+
+/// Events held between two dispatches. When full, the oldest event is dropped
+#define WKUP_KEYS_EVT_QUEUE_LEN     (8)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+enum wkup_keys_evt_type
+{
+    /// Keys pressed or released
+    WKUP_KEYS_EVT_CHANGE,
+    /// Keys held for the long press time
+    WKUP_KEYS_EVT_LONG_PRESS,
+    /// Keys pressed together
+    WKUP_KEYS_EVT_CHORD,
+};
+
+struct wkup_keys_event
+{
+    /// BLE base time of the event
+    uint32_t time;
+    /// Keys pressed after the event
+    uint16_t pressed;
+    /// Keys the event is about
+    uint16_t keys;
+    /// Change event: released keys that had reported a long press
+    uint16_t long_keys;
+    /// One of enum wkup_keys_evt_type
+    uint8_t type;
+};
+
+struct wkup_keys_evt_cfg
+{
+    /// Settle window after a reported change, in slots
+    uint32_t settle;
+    /// Long press time, in slots
+    uint32_t long_press;
+    /// Chord window, in slots
+    uint32_t chord;
+    /// Keys that report a long press
+    uint16_t long_mask;
+    /// Keys that report chords
+    uint16_t chord_mask;
+};
+
+struct wkup_keys_evt_state
+{
+    const struct wkup_keys_evt_cfg *cfg;
+    /// Reported state
+    uint16_t pressed;
+    /// Last sampled state
+    uint16_t raw;
+    /// Keys in the settle window
+    uint16_t settling;
+    /// Pressed keys waiting for the long press time
+    uint16_t long_armed;
+    /// Pressed keys that reported a long press
+    uint16_t long_fired;
+    /// Keys of the current chord
+    uint16_t chord_keys;
+    uint32_t settle_end;
+    uint32_t long_start;
+    uint32_t chord_start;
+    uint8_t head;
+    uint8_t count;
+    /// Events dropped because the queue was full, saturates
+    uint8_t overflows;
+    struct wkup_keys_event queue[WKUP_KEYS_EVT_QUEUE_LEN];
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Time elapsed between two BLE base time values.
+ * @param[in] now       Current time.
+ * @param[in] then      Earlier time.
+ * @return Elapsed slots.
+ ****************************************************************************************
+ */
+static inline uint32_t wkup_keys_evt_elapsed(uint32_t now, uint32_t then)
+{
+    return (now - then) & WKUP_KEYS_EVT_TIME_MASK;
+}
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Initializes the state, the queue is emptied.
+ * @param[in] st        State.
+ * @param[in] cfg       Configuration, must stay valid.
+ * @param[in] pressed   Keys pressed at start.
+ ****************************************************************************************
+ */
+void wkup_keys_evt_init(struct wkup_keys_evt_state *st, const struct wkup_keys_evt_cfg *cfg,
+                        uint16_t pressed);
+
+/**
+ ****************************************************************************************
+ * @brief Runs the windows that have closed by now, then applies a new sample. The
+ *        events are queued in time order.
+ * @param[in] st        State.
+ * @param[in] now       Current time.
+ * @param[in] raw       Keys pressed now.
+ ****************************************************************************************
+ */
+void wkup_keys_evt_update(struct wkup_keys_evt_state *st, uint32_t now, uint16_t raw);
+
+/**
+ ****************************************************************************************
+ * @brief Next time wkup_keys_evt_update() has to run, even without a new sample.
+ * @param[in] st        State.
+ * @param[out] deadline Time of the next settle window end or long press.
+ * @return False if nothing is pending.
+ ****************************************************************************************
+ */
+bool wkup_keys_evt_deadline(const struct wkup_keys_evt_state *st, uint32_t *deadline);
+
+/**
+ ****************************************************************************************
+ * @brief Takes the oldest event from the queue.
+ * @param[in] st        State.
+ * @param[out] evt      Event.
+ * @return False if the queue is empty.
+ ****************************************************************************************
+ */
+bool wkup_keys_evt_pop(struct wkup_keys_evt_state *st, struct wkup_keys_event *evt);
+
+/// @} APP
+
+#endif // WKUP_KEYS_EVENTS_H
@@ -30,6 +30,8 @@
 
 #include "port_bmi270.h"
 #include "port_bmi270_config.h"
+#include "port_bmi270_boot.h"
+#include "systick.h"
 
 
 
@@ -55,6 +57,10 @@ static const spi_cfg_t _port_bmi270_spi_cfg = {
 #if defined (__DA14531__)
     .spi_capture = SPI_MASTER_EDGE_CAPTURE,
 #endif
+#if defined (CFG_SPI_DMA_SUPPORT)
+    .spi_dma_channel = SPI_DMA_CHANNEL_01,
+    .spi_dma_priority = DMA_PRIO_0,
+#endif
 };
 #else
 		
@@ -77,10 +83,90 @@ i2c_cfg_t i2c_cfg = {
     
 struct bmi2_dev port_bmi270_dev                             __SECTION_ZERO("retention_mem_area0");
 
+// Survives a reset of the device, CFG_RET_DATA_UNINIT_SIZE must cover it
+struct port_bmi270_boot_record port_bmi270_boot_rec         __SECTION_ZERO("retention_mem_area_uninit");
+
+static volatile bool _port_bmi270_busy;
+
+#if defined (CFG_I2C_DMA_SUPPORT) && (PORT_BMI270_INTERFACE==PORT_BMI270_INTERFACE_I2C)
+// I2C_DATA_CMD_REG words, one buffer is filled while the other one is sent
+static uint16_t _port_bmi270_dma_buf[2][PORT_BMI270_I2C_DMA_CHUNK];
+#endif
+
 int8_t port_bmi270_read(uint8_t id, uint8_t reg_addr, uint8_t *data, uint16_t len);
 int8_t port_bmi270_write(uint8_t id, uint8_t reg_addr, uint8_t *data, uint16_t len);
 void port_bmi270_delay_us( uint32_t period_us);
 
+/**
+ ****************************************************************************************
+ * @brief Sleeps until an interrupt callback clears _port_bmi270_busy. The flag is tested
+ *        with the interrupts disabled, a pending interrupt still ends the WFI.
+ ****************************************************************************************
+ */
+static void _port_bmi270_wait(void)
+{
+    while (_port_bmi270_busy)
+    {
+        GLOBAL_INT_DISABLE();
+        if (_port_bmi270_busy)
+        {
+            __WFI();
+        }
+        GLOBAL_INT_RESTORE();
+    }
+}
+
+#if defined (CFG_I2C_DMA_SUPPORT) && (PORT_BMI270_INTERFACE==PORT_BMI270_INTERFACE_I2C)
+static void _port_bmi270_i2c_dma_cb(void *cb_data, uint16_t len, bool success)
+{
+    _port_bmi270_busy = false;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sends the register address and the data in one I2C transfer. The data is copied
+ *        into the DMA buffers in chunks, the DA14531 holds the bus while its TX FIFO is
+ *        empty so the transfer continues over the chunks without interrupts disabled.
+ ****************************************************************************************
+ */
+static void _port_bmi270_i2c_write_dma(uint8_t reg, const uint8_t *data, uint16_t size)
+{
+    uint16_t *buf;
+    uint16_t n;
+    uint8_t sel = 0;
+
+    buf = _port_bmi270_dma_buf[sel];
+    buf[0] = reg;
+    n = 1;
+
+    do {
+        while ((n < PORT_BMI270_I2C_DMA_CHUNK) && size) {
+            buf[n++] = *data++;
+            size--;
+        }
+
+        // The previous chunk is sent while this one is filled
+        _port_bmi270_wait();
+        _port_bmi270_busy = true;
+        i2c_master_transmit_buffer_dma(I2C_DMA_CHANNEL_PAIR_1, buf, n, _port_bmi270_i2c_dma_cb, NULL,
+                                       size ? I2C_F_NONE : I2C_F_ADD_STOP);
+
+        sel ^= 1;
+        buf = _port_bmi270_dma_buf[sel];
+        n = 0;
+    } while (size);
+
+    _port_bmi270_wait();
+}
+#endif
+
+#if defined (CFG_SPI_DMA_SUPPORT) && (PORT_BMI270_INTERFACE!=PORT_BMI270_INTERFACE_I2C)
+static void _port_bmi270_spi_dma_cb(uint16_t length)
+{
+    _port_bmi270_busy = false;
+}
+#endif
+
 static inline int8_t _port_bmi270_itf_read(uint8_t reg, uint8_t *data, uint16_t size)
 {
 #if(PORT_BMI270_INTERFACE!=PORT_BMI270_INTERFACE_I2C)
@@ -117,11 +203,26 @@ static inline int8_t _port_bmi270_itf_write(uint8_t reg, uint8_t *data, uint16_t
 #if(PORT_BMI270_INTERFACE!=PORT_BMI270_INTERFACE_I2C)
     /* Issue the register address*/       
     spi_access(reg);
+  #if defined (CFG_SPI_DMA_SUPPORT)
+    if (size >= PORT_BMI270_DMA_MIN_LEN) {
+        spi_register_send_cb(_port_bmi270_spi_dma_cb);
+        _port_bmi270_busy = true;
+        spi_send(data, size, SPI_OP_DMA);
+        _port_bmi270_wait();
+        return 0;
+    }
+  #endif
     while(size--) {
         spi_access(*data);
         ++data;
     }
 #else
+  #if defined (CFG_I2C_DMA_SUPPORT)
+    if (size >= PORT_BMI270_DMA_MIN_LEN) {
+        _port_bmi270_i2c_write_dma(reg, data, size);
+        return 0;
+    }
+  #endif
     
     // Critical section
     GLOBAL_INT_DISABLE();
@@ -137,28 +238,36 @@ static inline int8_t _port_bmi270_itf_write(uint8_t reg, uint8_t *data, uint16_t
 }
 
 
-static inline void __nop(void)
+static void _port_bmi270_systick_cb(void)
 {
-    __asm volatile ("nop");
+    _port_bmi270_busy = false;
 }
 
-
-
-static inline void _port_bmi270_delay_us(volatile uint32_t nof_us)
+/**
+ ****************************************************************************************
+ * @brief Waits on the SysTick, counting the 1 MHz reference clock, so the delay does not
+ *        depend on the system clock. Short delays poll the counter, longer ones sleep
+ *        until the SysTick interrupt. The SysTick is stopped when the wait is over, it
+ *        only runs during the sensor bring-up and the 450 us bus idle time of the
+ *        accesses in advanced power save, never between events.
+ ****************************************************************************************
+ */
+static void _port_bmi270_delay_us(uint32_t nof_us)
 {
-    while( nof_us-- ){
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
+    if (nof_us == 0) {
+        return;
     }
+
+    if (nof_us < PORT_BMI270_DELAY_WFI_US) {
+        systick_wait(nof_us);
+        return;
+    }
+
+    systick_register_callback(_port_bmi270_systick_cb);
+    _port_bmi270_busy = true;
+    systick_start(nof_us, true);
+    _port_bmi270_wait();
+    systick_stop();
 }
 
 static inline void _port_bmi270_comm_init()
@@ -244,6 +353,8 @@ void port_bmi270_delay_us(uint32_t period_us)
 
 int8_t port_bmi270_init(void)
 {
+    int8_t rslt;
+
     port_bmi270_dev.read = (bmi2_read_fptr_t)port_bmi270_read;
     port_bmi270_dev.write = (bmi2_write_fptr_t)port_bmi270_write;
     port_bmi270_dev.delay_us = (bmi2_delay_fptr_t)port_bmi270_delay_us;
@@ -266,8 +377,14 @@ int8_t port_bmi270_init(void)
 //    port_bmi270_dev.config_file_ptr = NULL;
     port_bmi270_dev.config_file_addr = 0;
 
-    /* Initialize BMI2  */
-    return bmi270_init(&port_bmi270_dev);
+    /* Initialize BMI2 without the reset, the configuration file is checked and uploaded below */
+    rslt = bmi270_attach(&port_bmi270_dev);
+    if (rslt == BMI2_OK) {
+        rslt = port_bmi270_boot(&port_bmi270_dev, (const uint8_t *)port_bmi270_dev.config_file_addr,
+                                port_bmi270_dev.config_size, PORT_BMI270_UPLOAD_BURST, &port_bmi270_boot_rec);
+    }
+
+    return rslt;
 }
 
 void port_bmi270_itf_begin()
@@ -284,3 +401,8 @@ struct bmi2_dev* port_bmi270_dev_ptr(void)
 {
     return &port_bmi270_dev;
 }
+
+const struct port_bmi270_boot_record* port_bmi270_boot_record_ptr(void)
+{
+    return &port_bmi270_boot_rec;
+}
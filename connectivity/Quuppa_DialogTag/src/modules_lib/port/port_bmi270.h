@@ -2,6 +2,7 @@
 #define _PORT_BMI270_H
 #include "bmi2.h"
 #include "bmi270.h"
+#include "port_bmi270_boot.h"
 int8_t port_bmi270_init(void);
 
 void port_bmi270_itf_begin(void);
@@ -9,4 +10,6 @@ void port_bmi270_itf_begin(void);
 void port_bmi270_itf_end(void);
 
 struct bmi2_dev* port_bmi270_dev_ptr(void);
+
+const struct port_bmi270_boot_record* port_bmi270_boot_record_ptr(void);
 #endif // _PORT_BMI270_H
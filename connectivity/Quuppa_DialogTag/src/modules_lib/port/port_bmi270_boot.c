@@ -0,0 +1,307 @@
+/**
+ ****************************************************************************************
+ *
+ * @file port_bmi270_boot.c
+ *
+ * @brief BMI270 bring-up source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "bmi270.h"
+#include "port_bmi270_boot.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+uint32_t port_bmi270_boot_crc32(const uint8_t *data, uint16_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint8_t bit;
+
+    while (len--)
+    {
+        crc ^= *data++;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+uint16_t port_bmi270_boot_burst(uint16_t size, uint16_t offset, uint16_t max_burst)
+{
+    uint16_t len;
+
+    if (offset >= size)
+    {
+        return 0;
+    }
+
+    max_burst &= ~1;
+    if (max_burst < 2)
+    {
+        max_burst = 2;
+    }
+
+    len = size - offset;
+
+    return (len > max_burst) ? max_burst : len;
+}
+
+static bool boot_spi(const struct bmi2_dev *dev)
+{
+    return (dev->intf == BMI2_SPI_INTERFACE) || (dev->intf == BMI2_SPI_3W_INTERFACE);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Waits for the bus idle time the power mode of the sensor requires.
+ ****************************************************************************************
+ */
+static void boot_idle(const struct bmi2_dev *dev)
+{
+    dev->delay_us((dev->aps_status == BMI2_ENABLE) ? PORT_BMI270_BOOT_IDLE_APS_US : PORT_BMI270_BOOT_IDLE_US);
+}
+
+static int8_t boot_read(const struct bmi2_dev *dev, uint8_t reg, uint8_t *value)
+{
+    uint8_t buf[2];
+    int8_t rslt;
+
+    if (boot_spi(dev))
+    {
+        reg |= BMI2_SPI_RD_MASK;
+    }
+
+    rslt = dev->read(dev->dev_id, reg, buf, 1 + dev->dummy_byte);
+    boot_idle(dev);
+    *value = buf[dev->dummy_byte];
+
+    return (rslt == BMI2_OK) ? BMI2_OK : BMI2_E_COM_FAIL;
+}
+
+static int8_t boot_write(const struct bmi2_dev *dev, uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    int8_t rslt;
+
+    if (boot_spi(dev))
+    {
+        reg &= BMI2_SPI_WR_MASK;
+    }
+
+    rslt = dev->write(dev->dev_id, reg, data, len);
+    boot_idle(dev);
+
+    return (rslt == BMI2_OK) ? BMI2_OK : BMI2_E_COM_FAIL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sets or clears the advanced power save bit of PWR_CONF, keeping the other bits.
+ ****************************************************************************************
+ */
+static int8_t boot_set_aps(struct bmi2_dev *dev, uint8_t enable)
+{
+    uint8_t val;
+    int8_t rslt;
+
+    rslt = boot_read(dev, BMI2_PWR_CONF_ADDR, &val);
+    if (rslt == BMI2_OK)
+    {
+        val = enable ? (val | BMI2_ADV_POW_EN_MASK) : (val & ~BMI2_ADV_POW_EN_MASK);
+
+        // Idle for the slower of the two modes after the change
+        dev->aps_status = BMI2_ENABLE;
+        rslt = boot_write(dev, BMI2_PWR_CONF_ADDR, &val, 1);
+        dev->aps_status = enable;
+    }
+
+    return rslt;
+}
+
+static int8_t boot_upload(struct bmi2_dev *dev, const uint8_t *config, uint16_t size,
+                          uint16_t max_burst, struct port_bmi270_boot_record *record)
+{
+    uint8_t val = BMI2_SOFT_RESET_CMD;
+    uint8_t addr[2];
+    uint16_t offset, len;
+    uint32_t waited = 0;
+    int8_t rslt;
+
+    rslt = boot_write(dev, BMI2_CMD_REG_ADDR, &val, 1);
+    dev->delay_us(PORT_BMI270_BOOT_RESET_US);
+    dev->aps_status = BMI2_ENABLE;
+
+    // The soft reset brings the interface back to I2C, a read switches it to SPI
+    if ((rslt == BMI2_OK) && boot_spi(dev))
+    {
+        rslt = boot_read(dev, BMI2_CHIP_ID_ADDR, &val);
+        if ((rslt == BMI2_OK) && (dev->intf == BMI2_SPI_3W_INTERFACE))
+        {
+            val = 0x01;
+            rslt = boot_write(dev, BMI2_IF_CONF_ADDR, &val, 1);
+        }
+    }
+
+    if (rslt == BMI2_OK)
+    {
+        rslt = boot_set_aps(dev, BMI2_DISABLE);
+    }
+
+    if (rslt == BMI2_OK)
+    {
+        val = 0;
+        rslt = boot_write(dev, BMI2_INIT_CTRL_ADDR, &val, 1);
+    }
+
+    for (offset = 0; (rslt == BMI2_OK) && (len = port_bmi270_boot_burst(size, offset, max_burst)); offset += len)
+    {
+        // INIT_ADDR counts 16-bit words, bits 3:0 in the first register, 11:4 in the second
+        addr[0] = (uint8_t)((offset / 2) & 0x0F);
+        addr[1] = (uint8_t)((offset / 2) >> 4);
+
+        rslt = boot_write(dev, BMI2_INIT_ADDR_0, addr, 2);
+        if (rslt == BMI2_OK)
+        {
+            rslt = boot_write(dev, BMI2_INIT_DATA_ADDR, &config[offset], len);
+        }
+    }
+
+    if (rslt == BMI2_OK)
+    {
+        val = 1;
+        rslt = boot_write(dev, BMI2_INIT_CTRL_ADDR, &val, 1);
+    }
+
+    // Poll until the ASIC is initialized instead of waiting for the worst case
+    record->polls = 0;
+    while (rslt == BMI2_OK)
+    {
+        dev->delay_us(PORT_BMI270_BOOT_POLL_US);
+        waited += PORT_BMI270_BOOT_POLL_US;
+        record->polls++;
+
+        rslt = boot_read(dev, BMI2_INTERNAL_STATUS_ADDR, &val);
+        if ((rslt == BMI2_OK) && ((val & PORT_BMI270_BOOT_STATUS_MSG_MASK) == PORT_BMI270_BOOT_STATUS_INIT_OK))
+        {
+            break;
+        }
+
+        if ((rslt == BMI2_OK) && (waited >= PORT_BMI270_BOOT_INIT_TIMEOUT_US))
+        {
+            rslt = BMI2_E_CONFIG_LOAD;
+        }
+    }
+
+    if (rslt == BMI2_OK)
+    {
+        rslt = boot_set_aps(dev, BMI2_ENABLE);
+    }
+
+    return rslt;
+}
+
+int8_t port_bmi270_boot(struct bmi2_dev *dev, const uint8_t *config, uint16_t size,
+                        uint16_t max_burst, struct port_bmi270_boot_record *record)
+{
+    uint32_t crc = port_bmi270_boot_crc32(config, size);
+    uint8_t val;
+    int8_t rslt = BMI2_OK;
+
+    // The power mode is not known yet, use the longer idle time
+    dev->aps_status = BMI2_ENABLE;
+
+    // After a power-up the interface is I2C until a read switches it to SPI
+    if (boot_spi(dev))
+    {
+        rslt = boot_read(dev, BMI2_CHIP_ID_ADDR, &val);
+    }
+
+    if (rslt == BMI2_OK)
+    {
+        rslt = boot_read(dev, BMI2_CHIP_ID_ADDR, &val);
+        if ((rslt == BMI2_OK) && (val != BMI270_CHIP_ID))
+        {
+            rslt = BMI2_E_DEV_NOT_FOUND;
+        }
+    }
+
+    if (rslt != BMI2_OK)
+    {
+        return rslt;
+    }
+
+    if ((record->magic == PORT_BMI270_BOOT_MAGIC) && (record->crc == crc) && (record->size == size))
+    {
+        rslt = boot_read(dev, BMI2_INTERNAL_STATUS_ADDR, &val);
+        if ((rslt == BMI2_OK) && ((val & PORT_BMI270_BOOT_STATUS_MSG_MASK) == PORT_BMI270_BOOT_STATUS_INIT_OK))
+        {
+            // Same configuration still running, only the power mode has to be known
+            rslt = boot_read(dev, BMI2_PWR_CONF_ADDR, &val);
+            dev->aps_status = (val & BMI2_ADV_POW_EN_MASK) ? BMI2_ENABLE : BMI2_DISABLE;
+            record->warm_boots++;
+
+            return rslt;
+        }
+    }
+    else
+    {
+        // Not a record of this configuration file, start counting again
+        memset(record, 0, sizeof(struct port_bmi270_boot_record));
+    }
+
+    // Invalid until the sensor confirms the upload
+    record->magic = 0;
+
+    rslt = boot_upload(dev, config, size, max_burst, record);
+    if (rslt == BMI2_OK)
+    {
+        record->magic = PORT_BMI270_BOOT_MAGIC;
+        record->crc = crc;
+        record->size = size;
+        record->uploads++;
+    }
+
+    return rslt;
+}
+
+/// @} APP
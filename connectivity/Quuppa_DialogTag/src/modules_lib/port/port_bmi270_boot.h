@@ -0,0 +1,157 @@
+/**
+ ****************************************************************************************
+ *
+ * @file port_bmi270_boot.h
+ *
+ * @brief BMI270 bring-up header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _PORT_BMI270_BOOT_H_
+#define _PORT_BMI270_BOOT_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The BMI270 keeps its feature configuration as long as it is powered, but the BMI2 API
+ * soft resets it and uploads the whole configuration file on every initialization. The
+ * sensor offers no readable checksum of the loaded configuration, so a record of the
+ * last successful upload (CRC-32 and size of the file) is kept in RAM that survives a
+ * reset of the DA1453x. When the record matches the compiled configuration file and the
+ * sensor reports that its ASIC is initialized, the upload is skipped.
+ *
+ * Otherwise the file is uploaded in bursts of at most max_burst bytes, a single burst
+ * when the bus allows it, and INTERNAL_STATUS is polled until the ASIC is initialized
+ * instead of waiting for the worst case.
+ *
+ * All bus accesses and waits go through the read, write and delay_us callbacks of the
+ * bmi2_dev structure. This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include "bmi2_defs.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define PORT_BMI270_BOOT_MAGIC              (0x30374D42)    // "BM70"
+
+/// Bus idle time after an access, advanced power save enabled (us)
+#define PORT_BMI270_BOOT_IDLE_APS_US        (450)
+
+/// Bus idle time after an access, advanced power save disabled (us)
+#define PORT_BMI270_BOOT_IDLE_US            (2)
+
+/// Wait after a soft reset (us)
+#define PORT_BMI270_BOOT_RESET_US           (2000)
+
+/// INTERNAL_STATUS poll period after the configuration is loaded (us)
+#define PORT_BMI270_BOOT_POLL_US            (1000)
+
+/// Longest wait for the ASIC initialization, the fixed wait of the BMI2 API (us)
+#define PORT_BMI270_BOOT_INIT_TIMEOUT_US    (150000)
+
+/// INTERNAL_STATUS message field and the init_ok value
+#define PORT_BMI270_BOOT_STATUS_MSG_MASK    (0x0F)
+#define PORT_BMI270_BOOT_STATUS_INIT_OK     (0x01)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Record of the last configuration upload, kept in uninitialized retention memory
+struct port_bmi270_boot_record
+{
+    uint32_t magic;
+    /// CRC-32 of the uploaded configuration file
+    uint32_t crc;
+    /// Size of the uploaded configuration file
+    uint16_t size;
+    /// Configuration uploads since the record was created
+    uint16_t uploads;
+    /// Initializations that found the configuration loaded
+    uint16_t warm_boots;
+    /// Polls of INTERNAL_STATUS after the last upload
+    uint16_t polls;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Computes the CRC-32 (IEEE 802.3) of a buffer.
+ * @param[in] data      Data.
+ * @param[in] len       Data length.
+ * @return CRC-32.
+ ****************************************************************************************
+ */
+uint32_t port_bmi270_boot_crc32(const uint8_t *data, uint16_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Length of the upload burst starting at offset. Bursts are even, since the
+ *        sensor is addressed in 16-bit words, and the last one carries the remainder.
+ * @param[in] size      Configuration file size.
+ * @param[in] offset    Offset of the burst.
+ * @param[in] max_burst Longest burst the bus allows.
+ * @return Burst length, 0 past the end of the file.
+ ****************************************************************************************
+ */
+uint16_t port_bmi270_boot_burst(uint16_t size, uint16_t offset, uint16_t max_burst);
+
+/**
+ ****************************************************************************************
+ * @brief Brings the sensor to the state the BMI2 API leaves it in after initialization:
+ *        configuration file loaded, advanced power save enabled when uploaded. The intf,
+ *        dev_id, dummy_byte and callbacks of dev must be set.
+ * @param[in] dev       BMI2 device, aps_status is updated.
+ * @param[in] config    Configuration file.
+ * @param[in] size      Configuration file size.
+ * @param[in] max_burst Longest write burst the bus allows.
+ * @param[in,out] record Record of the last upload.
+ * @return BMI2_OK, BMI2_E_COM_FAIL, BMI2_E_DEV_NOT_FOUND or BMI2_E_CONFIG_LOAD.
+ ****************************************************************************************
+ */
+int8_t port_bmi270_boot(struct bmi2_dev *dev, const uint8_t *config, uint16_t size,
+                        uint16_t max_burst, struct port_bmi270_boot_record *record);
+
+/// @} APP
+
+#endif // _PORT_BMI270_BOOT_H_
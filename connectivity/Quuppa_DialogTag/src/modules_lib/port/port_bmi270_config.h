@@ -73,4 +73,21 @@
 // SCLK Pin definition
 #define PORT_BMI270_SCLK_PORT    SPI_CLK_PORT
 #define PORT_BMI270_SCLK_PIN     SPI_CLK_PIN 
+
+// Writes of at least this many bytes are sent by DMA, if enabled for the interface
+#define PORT_BMI270_DMA_MIN_LEN     (32)
+
+// I2C DMA staging buffers, in bytes per buffer (two buffers of 16-bit words)
+#define PORT_BMI270_I2C_DMA_CHUNK   (64)
+
+// Longest configuration file burst. Without DMA an I2C burst runs with the interrupts
+// disabled, so it is kept short
+#if (PORT_BMI270_INTERFACE!=PORT_BMI270_INTERFACE_I2C) || defined (CFG_I2C_DMA_SUPPORT)
+#define PORT_BMI270_UPLOAD_BURST    (0xFFFF)
+#else
+#define PORT_BMI270_UPLOAD_BURST    (256)
+#endif
+
+// Delays of at least this many microseconds sleep on the SysTick interrupt
+#define PORT_BMI270_DELAY_WFI_US    (1000)
 #endif // _PORT_BMI270_CONFIG_H_
@@ -0,0 +1,239 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_adv_timeline.c
+ *
+ * @brief Advertising mode timeline source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "user_adv_timeline.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Timer unit in us
+#define ADV_TIMELINE_TICK_US        (10000UL)
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+void adv_timeline_init(struct adv_timeline *tl, const struct adv_timeline_slot *table, uint8_t base)
+{
+    memset(tl, 0, sizeof(struct adv_timeline));
+    tl->table = table;
+    tl->mode = ADV_TIMELINE_NONE;
+    tl->base = base;
+    tl->next_base = ADV_TIMELINE_NONE;
+    tl->request = ADV_TIMELINE_NONE;
+}
+
+uint32_t adv_timeline_enter(struct adv_timeline *tl, uint8_t mode, uint32_t now)
+{
+    now &= ADV_TIMELINE_TIME_MASK;
+
+    tl->mode = mode;
+    tl->entered = now;
+    tl->request = ADV_TIMELINE_NONE;
+
+    if (tl->table[mode].base)
+    {
+        tl->base = mode;
+        tl->next_base = ADV_TIMELINE_NONE;
+        tl->cycle = now;
+    }
+
+    tl->log[tl->log_pos].time = now;
+    tl->log[tl->log_pos].mode = mode;
+    tl->log_pos = (tl->log_pos + 1) % ADV_TIMELINE_LOG_LEN;
+
+    return tl->table[mode].hold;
+}
+
+uint8_t adv_timeline_next(const struct adv_timeline *tl, bool alt)
+{
+    const struct adv_timeline_slot *slot;
+    uint8_t next;
+
+    if (tl->request != ADV_TIMELINE_NONE)
+    {
+        return tl->request;
+    }
+
+    if (tl->mode == ADV_TIMELINE_NONE)
+    {
+        return tl->base;
+    }
+
+    slot = &tl->table[tl->mode];
+    next = (alt && (slot->alt != ADV_TIMELINE_NONE)) ? slot->alt : slot->next;
+
+    if (next == ADV_TIMELINE_BASE)
+    {
+        next = (tl->next_base != ADV_TIMELINE_NONE) ? tl->next_base : tl->base;
+    }
+    else if (next == ADV_TIMELINE_NONE)
+    {
+        // Held until an event, restarted if it ends anyway
+        next = tl->mode;
+    }
+
+    return next;
+}
+
+void adv_timeline_request(struct adv_timeline *tl, uint8_t mode)
+{
+    tl->request = mode;
+}
+
+void adv_timeline_return_to(struct adv_timeline *tl, uint8_t mode)
+{
+    tl->next_base = (mode == tl->base) ? ADV_TIMELINE_NONE : mode;
+}
+
+bool adv_timeline_at_base(const struct adv_timeline *tl)
+{
+    return (tl->mode != ADV_TIMELINE_NONE) && tl->table[tl->mode].base;
+}
+
+uint32_t adv_timeline_cycle_us(const struct adv_timeline *tl, uint32_t now)
+{
+    uint64_t us = (uint64_t)adv_timeline_elapsed(now, tl->cycle) * ADV_TIMELINE_SLOT_US;
+
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+static uint8_t adv_timeline_channels(uint8_t map)
+{
+    uint8_t n = 0;
+
+    for (; map; map >>= 1)
+    {
+        n += map & 1;
+    }
+
+    return n;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Adds the radio time of a slot. The advertising events start at the entry in the
+ *        mode and repeat at the advertising interval, the scan windows start at the entry
+ *        and repeat at the scan interval. The random advertising delay is ignored.
+ ****************************************************************************************
+ */
+static void adv_timeline_add(const struct adv_timeline_slot *slot, struct adv_timeline_budget *budget)
+{
+    uint32_t hold_us = slot->hold * ADV_TIMELINE_TICK_US;
+    uint32_t start;
+
+    budget->period_us += hold_us;
+
+    if (slot->adv_intv > 0)
+    {
+        uint32_t intv_us = slot->adv_intv * 1000UL;
+        uint32_t events = (hold_us + intv_us - 1) / intv_us;
+
+        budget->adv_events += events;
+        budget->tx_us += events * adv_timeline_channels(slot->channels) * ADV_TIMELINE_ADV_PDU_US;
+    }
+
+    if (slot->scan_intv > 0)
+    {
+        for (start = 0; start < hold_us; start += slot->scan_intv * 1000UL)
+        {
+            uint32_t left = hold_us - start;
+            uint32_t win_us = slot->scan_win * 1000UL;
+
+            budget->rx_us += (win_us < left) ? win_us : left;
+        }
+    }
+}
+
+bool adv_timeline_budget(const struct adv_timeline_slot *table, uint8_t modes, uint8_t base,
+                         bool alt, struct adv_timeline_budget *budget)
+{
+    uint8_t mode = base;
+    uint8_t steps;
+
+    memset(budget, 0, sizeof(struct adv_timeline_budget));
+
+    if ((base >= modes) || !table[base].base)
+    {
+        return false;
+    }
+
+    for (steps = 0; steps < modes; steps++)
+    {
+        const struct adv_timeline_slot *slot = &table[mode];
+
+        if (slot->hold == 0)
+        {
+            return false;
+        }
+
+        adv_timeline_add(slot, budget);
+
+        mode = (alt && (slot->alt != ADV_TIMELINE_NONE)) ? slot->alt : slot->next;
+        if ((mode == ADV_TIMELINE_BASE) || (mode == base))
+        {
+            return true;
+        }
+        if (mode >= modes)
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+uint32_t adv_timeline_duty_ppm(const struct adv_timeline_budget *budget)
+{
+    if (budget->period_us == 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)budget->tx_us + budget->rx_us) * 1000000UL / budget->period_us);
+}
+
+/// @} APP
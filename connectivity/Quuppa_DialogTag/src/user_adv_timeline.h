@@ -0,0 +1,275 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_adv_timeline.h
+ *
+ * @brief Advertising mode timeline header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_ADV_TIMELINE_H_
+#define _USER_ADV_TIMELINE_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The duty cycle of the tag is a table with one slot per mode. A base mode (motion or
+ * static advertising) is held until its periodic RX ON, then the back channel cycle
+ * runs through its modes, each one held for a fixed time, and returns to the base mode.
+ * A mode that receives has an alternative next mode, taken when a back channel request
+ * was found. Events from outside the table, such as motion or sleep, either request the
+ * next mode at once or change the base mode the cycle returns to.
+ *
+ * Transitions are stamped with the BLE base time, which keeps counting in sleep. It
+ * counts 625 us slots on 27 bits, elapsed times are taken modulo its period.
+ *
+ * The radio budget of a cycle is computed from the table: the advertising events that
+ * fit in each hold time, the transmit time of their packets and the scan windows.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// BLE base time period mask, 27 bits
+#define ADV_TIMELINE_TIME_MASK      (0x07FFFFFFUL)
+
+/// BLE base time unit in us
+#define ADV_TIMELINE_SLOT_US        (625)
+
+/// Transmit time of a full legacy advertising packet on one channel, 47 bytes at 1 Mbps
+#define ADV_TIMELINE_ADV_PDU_US     (376)
+
+/// Next mode: the base mode of the cycle
+#define ADV_TIMELINE_BASE           (0xFE)
+
+/// No mode
+#define ADV_TIMELINE_NONE           (0xFF)
+
+/// Transitions kept in the log
+#define ADV_TIMELINE_LOG_LEN        (8)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Timeline slot of a mode
+struct adv_timeline_slot
+{
+    /// Time in the mode in timer units of 10 ms, 0 to stay until an event
+    uint32_t hold;
+    /// Advertising interval in ms, 0 if the mode does not advertise
+    uint16_t adv_intv;
+    /// Scan interval in ms, 0 if the mode does not scan
+    uint16_t scan_intv;
+    /// Scan window in ms
+    uint16_t scan_win;
+    /// Advertising channel map, one bit per channel
+    uint8_t channels;
+    /// Mode entered when the hold time elapses, ADV_TIMELINE_BASE for the base mode
+    uint8_t next;
+    /// Mode entered instead of next after a back channel request, ADV_TIMELINE_NONE
+    /// if the mode does not receive
+    uint8_t alt;
+    /// True for a base mode, entering it starts a duty cycle
+    bool base;
+};
+
+/// Logged transition
+struct adv_timeline_entry
+{
+    /// BLE base time of the transition
+    uint32_t time;
+    /// Mode entered
+    uint8_t mode;
+};
+
+/// Timeline state
+struct adv_timeline
+{
+    const struct adv_timeline_slot *table;
+    /// Current mode
+    uint8_t mode;
+    /// Base mode the cycle returns to
+    uint8_t base;
+    /// Base mode for the next return, ADV_TIMELINE_NONE to keep the current one
+    uint8_t next_base;
+    /// Mode for the next transition, ADV_TIMELINE_NONE to follow the table
+    uint8_t request;
+    /// Time the current mode was entered
+    uint32_t entered;
+    /// Time the current duty cycle started
+    uint32_t cycle;
+    /// Next log entry to write
+    uint8_t log_pos;
+    struct adv_timeline_entry log[ADV_TIMELINE_LOG_LEN];
+};
+
+/// Radio budget of a duty cycle
+struct adv_timeline_budget
+{
+    /// Duration of the cycle in us
+    uint32_t period_us;
+    /// Transmit time in us
+    uint32_t tx_us;
+    /// Receive time in us
+    uint32_t rx_us;
+    /// Advertising events
+    uint16_t adv_events;
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Time between two BLE base time values, correct across one wrap of the counter.
+ * @param[in] now       Current time.
+ * @param[in] then      Earlier time.
+ * @return Elapsed time in 625 us slots.
+ ****************************************************************************************
+ */
+static inline uint32_t adv_timeline_elapsed(uint32_t now, uint32_t then)
+{
+    return (now - then) & ADV_TIMELINE_TIME_MASK;
+}
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Initializes the timeline. No mode is entered.
+ * @param[in] tl        Timeline.
+ * @param[in] table     Slots, indexed by mode.
+ * @param[in] base      Initial base mode.
+ ****************************************************************************************
+ */
+void adv_timeline_init(struct adv_timeline *tl, const struct adv_timeline_slot *table, uint8_t base);
+
+/**
+ ****************************************************************************************
+ * @brief Enters a mode and logs the transition. Entering a base mode starts a cycle.
+ * @param[in] tl        Timeline.
+ * @param[in] mode      Mode entered.
+ * @param[in] now       BLE base time.
+ * @return Hold time of the mode in timer units of 10 ms, 0 if it is held until an event.
+ ****************************************************************************************
+ */
+uint32_t adv_timeline_enter(struct adv_timeline *tl, uint8_t mode, uint32_t now);
+
+/**
+ ****************************************************************************************
+ * @brief Gives the mode that follows the current one.
+ * @param[in] tl        Timeline.
+ * @param[in] alt       True if a back channel request was found.
+ * @return Requested mode if any, otherwise the next mode of the table.
+ ****************************************************************************************
+ */
+uint8_t adv_timeline_next(const struct adv_timeline *tl, bool alt);
+
+/**
+ ****************************************************************************************
+ * @brief Requests a mode for the next transition, the table is not followed.
+ * @param[in] tl        Timeline.
+ * @param[in] mode      Mode.
+ ****************************************************************************************
+ */
+void adv_timeline_request(struct adv_timeline *tl, uint8_t mode);
+
+/**
+ ****************************************************************************************
+ * @brief Sets the base mode the current cycle returns to.
+ * @param[in] tl        Timeline.
+ * @param[in] mode      Base mode.
+ ****************************************************************************************
+ */
+void adv_timeline_return_to(struct adv_timeline *tl, uint8_t mode);
+
+/**
+ ****************************************************************************************
+ * @brief Tells whether the current mode is a base mode.
+ * @param[in] tl        Timeline.
+ * @return True in a base mode, false in the back channel cycle or in an event mode.
+ ****************************************************************************************
+ */
+bool adv_timeline_at_base(const struct adv_timeline *tl);
+
+/**
+ ****************************************************************************************
+ * @brief Time since the current duty cycle started.
+ * @param[in] tl        Timeline.
+ * @param[in] now       BLE base time.
+ * @return Time in us, saturated.
+ ****************************************************************************************
+ */
+uint32_t adv_timeline_cycle_us(const struct adv_timeline *tl, uint32_t now);
+
+/**
+ ****************************************************************************************
+ * @brief Computes the radio budget of one duty cycle, from a base mode back to it.
+ * @param[in] table     Slots, indexed by mode.
+ * @param[in] modes     Number of slots.
+ * @param[in] base      Base mode.
+ * @param[in] alt       True to follow the alternative modes, as after a request.
+ * @param[out] budget   Budget.
+ * @return False if the cycle does not return to the base mode.
+ ****************************************************************************************
+ */
+bool adv_timeline_budget(const struct adv_timeline_slot *table, uint8_t modes, uint8_t base,
+                         bool alt, struct adv_timeline_budget *budget);
+
+/**
+ ****************************************************************************************
+ * @brief Radio duty cycle of a budget.
+ * @param[in] budget    Budget.
+ * @return Radio on time in parts per million of the cycle.
+ ****************************************************************************************
+ */
+uint32_t adv_timeline_duty_ppm(const struct adv_timeline_budget *budget);
+
+/// @} APP
+
+#endif // _USER_ADV_TIMELINE_H_
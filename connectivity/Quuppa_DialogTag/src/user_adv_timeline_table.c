@@ -0,0 +1,71 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_adv_timeline_table.c
+ *
+ * @brief Advertising mode timeline of the tag.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "co_bt.h"
+#include "DA14531_Quuppa_DF_BckChn_FlexBeacon.h"
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+// Duty cycle of the tag, indexed by advertising_state. A base mode advertises until the
+// periodic RX ON, then the back channel cycle announces RX ON, scans for a REQ packet,
+// answers it with RSP packets and sends the device info before returning to the base mode.
+const struct adv_timeline_slot adv_timeline_table[ADV_STATE_COUNT] =
+{
+    [MOTION_ADVERTISING] = {.hold = PERIODIC_RX_ON_INTERVAL_MOTION, .adv_intv = MOTION_ADV_INTERVAL,
+                            .channels = ADV_ALL_CHNLS_EN, .next = RX_ON_ADVERTISING, .alt = ADV_TIMELINE_NONE, .base = true},
+    [STATIC_ADVERTISING] = {.hold = PERIODIC_RX_ON_INTERVAL_STATIC, .adv_intv = STATIC_ADV_INTERVAL,
+                            .channels = ADV_ALL_CHNLS_EN, .next = RX_ON_ADVERTISING, .alt = ADV_TIMELINE_NONE, .base = true},
+    [RX_ON_ADVERTISING]  = {.hold = RX_ON_CANCEL_TIMER, .adv_intv = RX_ON_ADV_INTERVAL,
+                            .channels = ADV_ALL_CHNLS_EN, .next = SCAN, .alt = ADV_TIMELINE_NONE},
+    [SCAN]               = {.hold = SCAN_CANCEL_TIMER, .scan_intv = SCAN_INTERVAL_MS, .scan_win = SCAN_WINDOW_MS,
+                            .next = DEV_INFO, .alt = RSP_ADVERTISING},
+    [RSP_ADVERTISING]    = {.hold = RSP_CANCEL_TIMER, .adv_intv = RSP_ADV_INTERVAL,
+                            .channels = ADV_CHNL_37_EN, .next = DEV_INFO, .alt = ADV_TIMELINE_NONE},
+    [DEV_INFO]           = {.hold = DEV_INFO_CANCEL_TIMER, .adv_intv = DEV_INFO_ADV_INTERVAL,
+                            .channels = ADV_ALL_CHNLS_EN, .next = ADV_TIMELINE_BASE, .alt = ADV_TIMELINE_NONE},
+    [SLEEP]              = {.hold = 0, .next = ADV_TIMELINE_NONE, .alt = ADV_TIMELINE_NONE},
+};
+
+/// @} APP
@@ -881,6 +881,60 @@ int8_t bmi270_init(struct bmi2_dev *dev)
     return rslt;
 }
 
+/*!
+ * @brief This API updates the device structure the way bmi270_init() does,
+ * without resetting the sensor or writing the configuration file. It is used
+ * when the configuration file is already loaded in the sensor.
+ */
+int8_t bmi270_attach(struct bmi2_dev *dev)
+{
+    /* Variable to define error */
+    int8_t rslt;
+
+    /* Default axes re-mapping of bmi2_sec_init(): x, y, z with positive signs */
+    struct bmi2_axes_remap axes_remap = {
+        .x_axis = 0, .x_axis_sign = 1, .y_axis = 1, .y_axis_sign = 1,
+        .z_axis = 2, .z_axis_sign = 1
+    };
+
+    /* Null-pointer check */
+    rslt = null_ptr_check(dev);
+    if (rslt == BMI2_OK)
+    {
+        dev->chip_id = BMI270_CHIP_ID;
+        dev->config_size = sizeof(bmi270_config_file);
+        dev->variant_feature = BMI2_GYRO_CROSS_SENS_ENABLE | BMI2_CRT_RTOSK_ENABLE;
+
+        if (dev->intf == BMI2_SPI_INTERFACE || dev->intf == BMI2_SPI_3W_INTERFACE)
+        {
+            dev->dummy_byte = 1;
+        }
+        else
+        {
+            dev->dummy_byte = 0;
+        }
+
+        if (!dev->config_file_addr)
+        {
+            dev->config_file_addr = (uint32_t)bmi270_config_file;
+        }
+
+        /* Set by bmi2_sec_init() and bmi2_soft_reset() */
+        dev->resolution = 16;
+        dev->aux_man_en = 1;
+        dev->remap = axes_remap;
+        dev->sens_en_stat = 0;
+
+        dev->feat_config = bmi270_feat_in;
+        dev->feat_output = bmi270_feat_out;
+        dev->page_max = BMI270_MAX_PAGE_NUM;
+        dev->input_sens = BMI270_MAX_FEAT_IN;
+        dev->out_sens = BMI270_MAX_FEAT_OUT;
+    }
+
+    return rslt;
+}
+
 /***************************************************************************/
 
 /*!         Local Function Definitions
@@ -133,6 +133,21 @@ extern "C" {
  */
 int8_t bmi270_init(struct bmi2_dev *dev);
 
+/*!
+ *  @brief This API updates the device structure like bmi270_init(), without
+ *  resetting the sensor or writing the configuration file. The configuration
+ *  file must already be loaded and the advanced power save status set in
+ *  dev->aps_status.
+ *
+ * @param[in, out] dev      : Structure instance of bmi2_dev.
+ *
+ * @return Result of API execution status
+ *
+ * @retval BMI2_OK - Success
+ * @retval BMI2_E_NULL_PTR - Error: Null pointer error
+ */
+int8_t bmi270_attach(struct bmi2_dev *dev);
+
 /******************************************************************************/
 /*! @name       C++ Guard Macros                                      */
 /******************************************************************************/
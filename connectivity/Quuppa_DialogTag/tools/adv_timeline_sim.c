@@ -0,0 +1,503 @@
+/**
+ ****************************************************************************************
+ *
+ * @file adv_timeline_sim.c
+ *
+ * @brief Host simulation of the advertising mode timeline of the tag.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -I../../helpers/host_stub -Isrc -o adv_timeline_sim tools/adv_timeline_sim.c \
+ *       src/user_adv_timeline.c src/user_adv_timeline_table.c
+ *   ./adv_timeline_sim
+ *
+ * The timeline of the tag (user_adv_timeline_table.c) is stepped by a model of the
+ * application: the hold timer, the sleep timer, the air operations and their cancel, a
+ * REQ packet found by the scan. The advertising events start at the entry in a mode and
+ * repeat at its interval, the scan windows at the scan interval. The BLE base time
+ * starts close to the wrap of its 27 bits.
+ *
+ * Checked, against values computed by hand for the profile set in
+ * DA14531_Quuppa_DF_BckChn_FlexBeacon.h: the radio budget and the duty cycle of the
+ * motion and static cycles with and without a REQ; the mode sequence and hold times of a
+ * cycle, with the advertising events, transmit and scan time equal to the budget; the
+ * RSP packets on channel 37 after a REQ; the base mode changes; no air activity in
+ * sleep. Build again with QUUPPA_DEVICE_TYPE changed to check the other profile.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "co_bt.h"
+#include "DA14531_Quuppa_DF_BckChn_FlexBeacon.h"
+
+/// Timer unit of app_easy_timer() (us)
+#define TICK_US             (10000ULL)
+/// Modes traced
+#define TRACE_LEN           (64)
+/// Time from the cancel of an air operation to its completion (us)
+#define CANCEL_US           (1000ULL)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+/// Duty cycle computed by hand
+struct expected_cycle
+{
+    const char *name;
+    uint8_t base;
+    bool req;
+    struct adv_timeline_budget budget;
+    uint32_t duty_ppm;
+};
+
+/*
+ * Advertising events in a hold time: ceil(hold / interval), 376 us per packet and
+ * channel. Scan: a 40 ms window every 50 ms from the entry in the mode.
+ */
+#if (QUUPPA_DEVICE_TYPE == 0x20)
+// Motion 2000 ms at 333 ms: 7 events on 3 channels, 7896 us
+// RX ON and DEV INFO 250 ms at 300 ms: 1 event on 3 channels, 1128 us each
+// Scan 250 ms: windows at 0, 50, 100, 150 and 200 ms, 200 ms
+// RSP 250 ms at 100 ms: 3 events on channel 37, 1128 us
+// Static 9990 ms at 10000 ms: 1 event on 3 channels, 1128 us
+static const struct expected_cycle expected[] =
+{
+    {"motion",          MOTION_ADVERTISING, false, {2750000, 10152, 200000,  9}, 76418},
+    {"motion with REQ", MOTION_ADVERTISING, true,  {3000000, 11280, 200000, 12}, 70426},
+    {"static",          STATIC_ADVERTISING, false, {10740000, 3384, 200000,  3}, 18937},
+};
+#define RSP_EVENTS          (3)
+#elif (QUUPPA_DEVICE_TYPE == 0x80)
+// Motion 200 ms at 111 ms: 2 events on 3 channels, 2256 us
+// RX ON and DEV INFO 40 ms at 60 ms: 1 event on 3 channels, 1128 us each
+// Scan 50 ms: one window, 40 ms
+// RSP 70 ms at 20 ms: 4 events on channel 37, 1504 us
+// Static 9990 ms at 10000 ms: 1 event on 3 channels, 1128 us
+static const struct expected_cycle expected[] =
+{
+    {"motion",          MOTION_ADVERTISING, false, {330000,    4512, 40000, 4}, 134884},
+    {"motion with REQ", MOTION_ADVERTISING, true,  {400000,    6016, 40000, 8}, 115040},
+    {"static",          STATIC_ADVERTISING, false, {10120000,  3384, 40000, 3},   4286},
+};
+#define RSP_EVENTS          (4)
+#endif
+
+/// Simulated time (us), and the BLE base time at its origin
+static uint64_t now;
+static uint32_t time_origin;
+/// Cancel latency in use
+static uint64_t cancel_us;
+
+/// Application state, as in DA14531_Quuppa_DF_BckChn_FlexBeacon.c
+static struct adv_timeline tl;
+static uint8_t mode;
+static bool req_found;
+static uint64_t hold_end, sleep_end;
+
+/// Air operation, and the arrival of a REQ packet (0 for none)
+static bool air_on, stopping;
+static uint64_t air_start, stop_end, next_adv, req_at;
+
+/// Radio use
+static uint64_t tx_us, rx_us;
+static unsigned adv_events[ADV_STATE_COUNT];
+
+/// Modes entered and when
+static uint8_t trace_mode[TRACE_LEN];
+static uint64_t trace_t[TRACE_LEN];
+static int traced;
+
+static uint32_t ble_time(void)
+{
+    return (uint32_t)((now / ADV_TIMELINE_SLOT_US + time_origin) & ADV_TIMELINE_TIME_MASK);
+}
+
+static unsigned channels(uint8_t map)
+{
+    return (map & 1) + ((map >> 1) & 1) + ((map >> 2) & 1);
+}
+
+/// user_app_adv_start()
+static void app_adv_start(void)
+{
+    uint32_t hold = adv_timeline_enter(&tl, mode, ble_time());
+
+    hold_end = (hold > 0) ? now + hold * TICK_US : 0;
+    if (mode == MOTION_ADVERTISING)
+    {
+        sleep_end = now + TIMEOUT_FOR_SLEEP * TICK_US;
+    }
+    if (traced < TRACE_LEN)
+    {
+        trace_mode[traced] = mode;
+        trace_t[traced++] = now;
+    }
+    air_on = (mode != SLEEP);
+    stopping = false;
+    air_start = now;
+    next_adv = now;
+}
+
+/// user_ble_gap_stop_ongoing_operation()
+static void air_cancel(void)
+{
+    if (air_on && !stopping)
+    {
+        stopping = true;
+        stop_end = now + cancel_us;
+    }
+}
+
+/// user_timeline_preempt()
+static void preempt(uint8_t state)
+{
+    adv_timeline_request(&tl, state);
+    air_cancel();
+}
+
+/// user_timeline_switch_base()
+static void switch_base(uint8_t state)
+{
+    if (adv_timeline_at_base(&tl))
+    {
+        preempt(state);
+    }
+    else
+    {
+        adv_timeline_return_to(&tl, state);
+    }
+}
+
+/// Scan time in [from, to) of the current scan
+static void add_scan(uint64_t from, uint64_t to)
+{
+    const struct adv_timeline_slot *slot = &adv_timeline_table[SCAN];
+    uint64_t intv = slot->scan_intv * 1000ULL;
+    uint64_t win = slot->scan_win * 1000ULL;
+
+    while (from < to)
+    {
+        uint64_t phase = (from - air_start) % intv;
+        uint64_t end;
+
+        if (phase < win)
+        {
+            end = from + win - phase;
+            end = (end < to) ? end : to;
+            rx_us += end - from;
+            from = end;
+        }
+        else
+        {
+            from += intv - phase;
+        }
+    }
+}
+
+static uint64_t earliest(uint64_t step, uint64_t t)
+{
+    return (t > 0 && t < step) ? t : step;
+}
+
+/// Runs the model until t, the timers are served before the advertising events
+static void run_until(uint64_t t)
+{
+    while (now < t)
+    {
+        const struct adv_timeline_slot *slot = &adv_timeline_table[mode];
+        bool active = air_on && !stopping;
+        uint64_t step = t;
+
+        step = earliest(step, hold_end);
+        step = earliest(step, sleep_end);
+        if (stopping)
+        {
+            step = (stop_end < step) ? stop_end : step;
+        }
+        if (active && slot->adv_intv > 0)
+        {
+            step = (next_adv < step) ? next_adv : step;
+        }
+        if (active && mode == SCAN && req_at > now)
+        {
+            step = earliest(step, req_at);
+        }
+        if (air_on && mode == SCAN)
+        {
+            add_scan(now, step);
+        }
+        now = step;
+
+        if (active && mode == SCAN && now == req_at)
+        {
+            req_found = true;
+            air_cancel();
+        }
+        if (hold_end && now == hold_end)
+        {
+            hold_end = 0;
+            air_cancel();
+        }
+        if (sleep_end && now == sleep_end)
+        {
+            sleep_end = 0;
+            preempt(SLEEP);
+        }
+        if (air_on && !stopping && slot->adv_intv > 0 && now == next_adv)
+        {
+            adv_events[mode]++;
+            tx_us += channels(slot->channels) * ADV_TIMELINE_ADV_PDU_US;
+            next_adv += slot->adv_intv * 1000ULL;
+        }
+        if (stopping && now == stop_end)
+        {
+            // user_timeline_advance()
+            air_on = false;
+            stopping = false;
+            hold_end = 0;
+            mode = adv_timeline_next(&tl, req_found);
+            req_found = false;
+            app_adv_start();
+        }
+    }
+}
+
+/// Starts the model in the motion base mode, t = 0 is the given BLE base time
+static void start(uint32_t origin, uint64_t cancel)
+{
+    now = 0;
+    time_origin = origin;
+    cancel_us = cancel;
+    req_found = false;
+    hold_end = sleep_end = req_at = 0;
+    air_on = stopping = false;
+    tx_us = rx_us = 0;
+    memset(adv_events, 0, sizeof(adv_events));
+    traced = 0;
+
+    adv_timeline_init(&tl, adv_timeline_table, MOTION_ADVERTISING);
+    mode = MOTION_ADVERTISING;
+    app_adv_start();
+}
+
+static uint64_t hold_us(uint8_t state)
+{
+    return adv_timeline_table[state].hold * TICK_US;
+}
+
+static unsigned events(void)
+{
+    unsigned n = 0;
+    int i;
+
+    for (i = 0; i < ADV_STATE_COUNT; i++)
+    {
+        n += adv_events[i];
+    }
+
+    return n;
+}
+
+static void test_budget(void)
+{
+    struct adv_timeline_budget b;
+    size_t i;
+
+    for (i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        const struct expected_cycle *e = &expected[i];
+
+        CHECK(adv_timeline_budget(adv_timeline_table, ADV_STATE_COUNT, e->base, e->req, &b));
+        CHECK(b.period_us == e->budget.period_us);
+        CHECK(b.tx_us == e->budget.tx_us);
+        CHECK(b.rx_us == e->budget.rx_us);
+        CHECK(b.adv_events == e->budget.adv_events);
+        CHECK(adv_timeline_duty_ppm(&b) == e->duty_ppm);
+        printf("%-16s %8u ms  tx %5u us  rx %6u us  %2u events  %6u ppm\n", e->name,
+               (unsigned)(b.period_us / 1000), (unsigned)b.tx_us, (unsigned)b.rx_us,
+               (unsigned)b.adv_events, (unsigned)adv_timeline_duty_ppm(&b));
+    }
+
+    // Only a base mode starts a cycle, a mode held until an event has no budget
+    CHECK(!adv_timeline_budget(adv_timeline_table, ADV_STATE_COUNT, SCAN, false, &b));
+    CHECK(!adv_timeline_budget(adv_timeline_table, ADV_STATE_COUNT, SLEEP, false, &b));
+    CHECK(!adv_timeline_budget(adv_timeline_table, ADV_STATE_COUNT, ADV_STATE_COUNT, false, &b));
+    memset(&b, 0, sizeof(b));
+    CHECK(adv_timeline_duty_ppm(&b) == 0);
+}
+
+/// One motion cycle without REQ across the wrap of the BLE base time: the modes, their
+/// hold times and the radio use equal the budget
+static void test_cycle(void)
+{
+    static const uint8_t seq[] = {MOTION_ADVERTISING, RX_ON_ADVERTISING, SCAN, DEV_INFO,
+                                  MOTION_ADVERTISING};
+    const struct expected_cycle *e = &expected[0];
+    int i;
+
+    start(ADV_TIMELINE_TIME_MASK - (uint32_t)(hold_us(MOTION_ADVERTISING) / 2 / ADV_TIMELINE_SLOT_US), 0);
+    run_until(e->budget.period_us);
+
+    CHECK(traced == 5);
+    for (i = 0; i < 5 && i < traced; i++)
+    {
+        CHECK(trace_mode[i] == seq[i]);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        uint32_t logged = adv_timeline_elapsed(tl.log[i + 1].time, tl.log[i].time) * ADV_TIMELINE_SLOT_US;
+
+        CHECK(trace_t[i + 1] - trace_t[i] == hold_us(seq[i]));
+        CHECK(logged + ADV_TIMELINE_SLOT_US > hold_us(seq[i]) && logged < hold_us(seq[i]) + ADV_TIMELINE_SLOT_US);
+    }
+    CHECK(tl.log[1].time < tl.log[0].time);
+    CHECK(adv_timeline_cycle_us(&tl, ble_time()) == 0);
+
+    CHECK(tx_us == e->budget.tx_us);
+    CHECK(rx_us == e->budget.rx_us);
+    CHECK(events() == e->budget.adv_events);
+    CHECK(adv_events[RSP_ADVERTISING] == 0);
+}
+
+/// A REQ found in the scan: RSP packets on channel 37, then DEV INFO and the base mode
+static void test_req(void)
+{
+    static const uint8_t seq[] = {MOTION_ADVERTISING, RX_ON_ADVERTISING, SCAN, RSP_ADVERTISING,
+                                  DEV_INFO, MOTION_ADVERTISING};
+    const struct expected_cycle *e = &expected[1];
+    uint64_t scan_start;
+    int i;
+
+    start(0, CANCEL_US);
+    scan_start = hold_us(MOTION_ADVERTISING) + hold_us(RX_ON_ADVERTISING) + 2 * CANCEL_US;
+    req_at = scan_start + hold_us(SCAN) / 2;
+    run_until(req_at + hold_us(RSP_ADVERTISING) + hold_us(DEV_INFO) + 3 * CANCEL_US);
+
+    CHECK(traced == 6);
+    for (i = 0; i < 6 && i < traced; i++)
+    {
+        CHECK(trace_mode[i] == seq[i]);
+    }
+    CHECK(trace_t[2] == scan_start);
+    CHECK(trace_t[3] == req_at + CANCEL_US);
+    CHECK(trace_t[4] - trace_t[3] == hold_us(RSP_ADVERTISING) + CANCEL_US);
+    CHECK(trace_t[5] - trace_t[4] == hold_us(DEV_INFO) + CANCEL_US);
+
+    CHECK(adv_timeline_table[RSP_ADVERTISING].channels == ADV_CHNL_37_EN);
+    CHECK(adv_events[RSP_ADVERTISING] == RSP_EVENTS);
+    CHECK(adv_events[DEV_INFO] == 1);
+
+    // The scan stops at the REQ, the budget counts the whole scan
+    CHECK(tx_us == e->budget.tx_us);
+    CHECK(rx_us < e->budget.rx_us);
+    CHECK(events() == e->budget.adv_events);
+}
+
+/// Base mode changes: at once from a base mode, after the cycle from the back channel
+static void test_base(void)
+{
+    uint64_t cycle = hold_us(RX_ON_ADVERTISING) + hold_us(SCAN) + hold_us(DEV_INFO) + 3 * CANCEL_US;
+    uint64_t t;
+    int n;
+
+    // No motion in the motion base mode: static after the cycle
+    start(0, CANCEL_US);
+    run_until(hold_us(MOTION_ADVERTISING) / 2);
+    adv_timeline_return_to(&tl, STATIC_ADVERTISING);
+    run_until(hold_us(MOTION_ADVERTISING) + CANCEL_US + cycle + 1);
+    CHECK(traced == 5 && trace_mode[4] == STATIC_ADVERTISING);
+    CHECK(tl.base == STATIC_ADVERTISING);
+
+    // Motion in the static base mode: motion at once
+    t = now + 100000;
+    run_until(t);
+    n = traced;
+    switch_base(MOTION_ADVERTISING);
+    run_until(t + 2 * CANCEL_US);
+    CHECK(traced == n + 1 && trace_mode[n] == MOTION_ADVERTISING && trace_t[n] == t + CANCEL_US);
+    CHECK(tl.base == MOTION_ADVERTISING);
+
+    // Motion in the scan of a static cycle: the cycle completes, then motion
+    adv_timeline_return_to(&tl, STATIC_ADVERTISING);
+    while (mode != SCAN)
+    {
+        run_until(now + 1000);
+    }
+    run_until(now + 1000);
+    n = traced;
+    switch_base(MOTION_ADVERTISING);
+    CHECK(!stopping);
+    run_until(now + hold_us(SCAN) + hold_us(DEV_INFO) + 3 * CANCEL_US);
+    CHECK(traced == n + 2 && trace_mode[n] == DEV_INFO && trace_mode[n + 1] == MOTION_ADVERTISING);
+    CHECK(tl.base == MOTION_ADVERTISING);
+}
+
+/// Sleep timeout: no air activity until motion
+static void test_sleep(void)
+{
+    uint64_t tx;
+
+    start(0, CANCEL_US);
+    run_until(hold_us(MOTION_ADVERTISING) / 2);
+    adv_timeline_return_to(&tl, STATIC_ADVERTISING);
+    run_until(TIMEOUT_FOR_SLEEP * TICK_US + 12000000ULL);
+    CHECK(mode == SLEEP && !air_on && hold_end == 0);
+
+    tx = tx_us;
+    run_until(now + 60000000ULL);
+    CHECK(tx_us == tx && mode == SLEEP);
+
+    // Motion wakes the tag up in the motion base mode
+    mode = MOTION_ADVERTISING;
+    app_adv_start();
+    CHECK(adv_timeline_cycle_us(&tl, ble_time()) == 0);
+    run_until(now + 10000);
+    CHECK(mode == MOTION_ADVERTISING && adv_events[MOTION_ADVERTISING] > 0);
+    CHECK(tx_us == tx + channels(ADV_ALL_CHNLS_EN) * ADV_TIMELINE_ADV_PDU_US);
+}
+
+int main(void)
+{
+    printf("profile 0x%02X\n", QUUPPA_DEVICE_TYPE);
+
+    test_budget();
+    test_cycle();
+    test_req();
+    test_base();
+    test_sleep();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
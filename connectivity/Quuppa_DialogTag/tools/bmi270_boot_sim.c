@@ -0,0 +1,270 @@
+/**
+ ****************************************************************************************
+ *
+ * @file bmi270_boot_sim.c
+ *
+ * @brief Host check of the BMI270 bring-up against a register model of the sensor.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc/modules_lib/port -Isrc/user_drivers/bmi270 -o bmi270_boot_sim \
+ *       tools/bmi270_boot_sim.c src/modules_lib/port/port_bmi270_boot.c
+ *   ./bmi270_boot_sim
+ *
+ * port_bmi270_boot() runs against a register model of the BMI270: chip id, soft reset,
+ * PWR_CONF, INIT_CTRL, INIT_ADDR, INIT_DATA and INTERNAL_STATUS. The model reports
+ * init_ok 12 ms after INIT_CTRL is set if the loaded configuration is the one it
+ * expects, and flags any access that comes sooner than the bus idle time of the current
+ * power mode. Time advances with the bus accesses and the delay_us callback.
+ *
+ * Checked: a cold boot loads the file in a single burst; a warm boot (reset of the
+ * DA1453x only) reads a few registers and writes nothing; the upload is done again when
+ * the sensor lost its configuration or the firmware carries another file; a load the
+ * sensor refuses is reported and not recorded; the burst plan.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "port_bmi270_boot.h"
+
+#define CFG_SIZE            (8192)
+
+#define REG_CHIP_ID         (0x00)
+#define REG_INTERNAL_STATUS (0x21)
+#define REG_INIT_CTRL       (0x59)
+#define REG_INIT_ADDR_0     (0x5B)
+#define REG_INIT_DATA       (0x5E)
+#define REG_PWR_CONF        (0x7C)
+#define REG_CMD             (0x7E)
+
+/// Time from INIT_CTRL to init_ok (us)
+#define MODEL_INIT_US       (12000)
+/// Bus time of a byte at 400 kHz (us)
+#define MODEL_BYTE_US       (25)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+/// Configuration the sensor accepts, and the one the firmware carries
+static uint8_t expected[CFG_SIZE];
+static uint8_t firmware[CFG_SIZE];
+
+/// Sensor state
+static uint8_t mem[CFG_SIZE];
+static uint8_t pwr_conf, init_ctrl, status, init_addr[2];
+static uint64_t ready_at;
+static int load_ok;
+
+/// Bus and time
+static uint64_t now, last_access;
+static int writes, bursts, resets, violations;
+
+static void sensor_power_up(void)
+{
+    memset(mem, 0, sizeof(mem));
+    pwr_conf = 0x03;
+    init_ctrl = 0;
+    status = 0;
+    ready_at = 0;
+}
+
+static void bus_access(uint16_t len)
+{
+    uint64_t idle = (pwr_conf & 0x01) ? PORT_BMI270_BOOT_IDLE_APS_US : PORT_BMI270_BOOT_IDLE_US;
+
+    if (status == 0 && init_ctrl == 1 && ready_at && now >= ready_at)
+    {
+        status = load_ok ? 1 : 2;
+    }
+    if (last_access && now - last_access < idle)
+    {
+        violations++;
+    }
+    last_access = now;
+    now += MODEL_BYTE_US * (1 + len);
+}
+
+static int8_t model_read(uint8_t dev_id, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    (void)dev_id;
+    bus_access(len);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint8_t r = reg + i;
+
+        data[i] = (r == REG_CHIP_ID) ? 0x24 :
+                  (r == REG_INTERNAL_STATUS) ? status :
+                  (r == REG_PWR_CONF) ? pwr_conf :
+                  (r == REG_INIT_CTRL) ? init_ctrl : 0;
+    }
+    return 0;
+}
+
+static int8_t model_write(uint8_t dev_id, uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    (void)dev_id;
+    bus_access(len);
+    writes++;
+
+    switch (reg)
+    {
+        case REG_CMD:
+            if (data[0] == 0xB6)
+            {
+                sensor_power_up();
+                resets++;
+            }
+            break;
+        case REG_PWR_CONF:
+            pwr_conf = data[0];
+            break;
+        case REG_INIT_CTRL:
+            init_ctrl = data[0];
+            if (init_ctrl == 1)
+            {
+                load_ok = !memcmp(mem, expected, sizeof(mem));
+                ready_at = now + MODEL_INIT_US;
+            }
+            break;
+        case REG_INIT_ADDR_0:
+            // The configuration may only be written with advanced power save disabled
+            violations += pwr_conf & 0x01;
+            init_addr[0] = data[0];
+            if (len > 1)
+            {
+                init_addr[1] = data[1];
+            }
+            break;
+        case REG_INIT_DATA:
+        {
+            uint32_t offset = ((init_addr[1] << 4) | (init_addr[0] & 0x0F)) * 2;
+
+            violations += pwr_conf & 0x01;
+            bursts++;
+            if (offset + len > sizeof(mem))
+            {
+                violations++;
+                break;
+            }
+            memcpy(&mem[offset], data, len);
+            break;
+        }
+        default:
+            break;
+    }
+    return 0;
+}
+
+static void model_delay_us(uint32_t period)
+{
+    now += period;
+}
+
+int main(void)
+{
+    struct bmi2_dev dev = {0};
+    struct port_bmi270_boot_record record;
+    uint64_t start;
+    int w;
+
+    for (int i = 0; i < CFG_SIZE; i++)
+    {
+        expected[i] = rand();
+    }
+    memcpy(firmware, expected, sizeof(firmware));
+    sensor_power_up();
+    // Uninitialized retention memory after a power-up
+    memset(&record, 0xA5, sizeof(record));
+
+    dev.read = model_read;
+    dev.write = model_write;
+    dev.delay_us = model_delay_us;
+    dev.intf = BMI2_I2C_INTERFACE;
+
+    // Cold boot, the bus takes the file in one burst
+    CHECK(port_bmi270_boot(&dev, firmware, CFG_SIZE, 0xFFFF, &record) == BMI2_OK);
+    printf("cold boot: %.1f ms, %d bursts, %d polls\n", now / 1000.0, bursts, record.polls);
+    CHECK(status == 1 && bursts == 1 && resets == 1);
+    CHECK(record.magic == PORT_BMI270_BOOT_MAGIC && record.uploads == 1 && record.warm_boots == 0);
+    CHECK(dev.aps_status == BMI2_ENABLE && (pwr_conf & 0x01));
+    // Polled, not the fixed 150 ms + 20 ms of the BMI2 API
+    CHECK(record.polls > 0 && record.polls < 20);
+
+    // Reset of the DA1453x only, the sensor kept its configuration
+    start = now;
+    w = writes;
+    CHECK(port_bmi270_boot(&dev, firmware, CFG_SIZE, 0xFFFF, &record) == BMI2_OK);
+    printf("warm boot: %.2f ms, %d writes\n", (now - start) / 1000.0, writes - w);
+    CHECK(writes == w && resets == 1);
+    CHECK(record.uploads == 1 && record.warm_boots == 1);
+    CHECK(dev.aps_status == BMI2_ENABLE);
+    CHECK(now - start < 5000);
+
+    // The sensor was power cycled, the record is still valid; 256-byte bursts
+    sensor_power_up();
+    bursts = 0;
+    CHECK(port_bmi270_boot(&dev, firmware, CFG_SIZE, 256, &record) == BMI2_OK);
+    CHECK(status == 1 && bursts == CFG_SIZE / 256);
+    CHECK(record.uploads == 2 && record.warm_boots == 1);
+
+    // New firmware with another configuration file, 3000-byte bursts
+    firmware[100] ^= 0x01;
+    expected[100] ^= 0x01;
+    bursts = 0;
+    CHECK(port_bmi270_boot(&dev, firmware, CFG_SIZE, 3000, &record) == BMI2_OK);
+    CHECK(status == 1 && bursts == 3);
+    CHECK(record.crc == port_bmi270_boot_crc32(firmware, CFG_SIZE));
+    CHECK(record.uploads == 1 && record.warm_boots == 0);
+
+    // The sensor refuses the configuration: reported after the timeout, not recorded
+    firmware[7] ^= 0xFF;
+    CHECK(port_bmi270_boot(&dev, firmware, CFG_SIZE, 0xFFFF, &record) == BMI2_E_CONFIG_LOAD);
+    CHECK(record.magic != PORT_BMI270_BOOT_MAGIC);
+    CHECK(record.polls * PORT_BMI270_BOOT_POLL_US >= PORT_BMI270_BOOT_INIT_TIMEOUT_US);
+
+    // No access came sooner than the idle time of the power mode
+    CHECK(violations == 0);
+
+    // Burst plan: even lengths, the last burst carries the remainder
+    CHECK(port_bmi270_boot_burst(CFG_SIZE, 0, 0xFFFF) == CFG_SIZE);
+    CHECK(port_bmi270_boot_burst(CFG_SIZE, 8190, 255) == 2);
+    CHECK(port_bmi270_boot_burst(CFG_SIZE, 8064, 254) == 128);
+    CHECK(port_bmi270_boot_burst(100, 100, 8) == 0);
+    CHECK(port_bmi270_boot_burst(100, 0, 1) == 2);
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
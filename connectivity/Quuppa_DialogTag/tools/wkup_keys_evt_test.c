@@ -0,0 +1,381 @@
+/**
+ ****************************************************************************************
+ *
+ * @file wkup_keys_evt_test.c
+ *
+ * @brief Host test of the wakeup key events.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc/modules_lib/app/wkup_keys -o wkup_keys_evt_test \
+ *       tools/wkup_keys_evt_test.c src/modules_lib/app/wkup_keys/wkup_keys_events.c
+ *   ./wkup_keys_evt_test
+ *
+ * wkup_keys_events.c is fed samples of three keys as the wakeup controller gives them:
+ * key 0 plain, key 1 with a long press, keys 1 and 2 as a chord. Times are in slots, a
+ * 50 ms settle window, a 4 s long press and a 200 ms chord window.
+ *
+ * Checked: bounces inside the settle window are not reported and the level they end on is
+ * reported when the window closes; chatter gives at most one event per window; a long
+ * press is reported once at its time even when the update runs late, and flags the
+ * release; chords within the window and not past it, without a long press; the deadline
+ * of the next update; the order and overflow of the queue. Every case runs once away
+ * from and once across the wrap of the 27-bit BLE base time.
+ */
+
+#include <stdio.h>
+#include "wkup_keys_events.h"
+
+#define K0                  (1 << 0)
+#define K1                  (1 << 1)
+#define K2                  (1 << 2)
+
+#define SETTLE              WKUP_KEYS_EVT_MS_TO_SLOTS(50)
+#define LONG_PRESS          WKUP_KEYS_EVT_MS_TO_SLOTS(4000)
+#define CHORD               WKUP_KEYS_EVT_MS_TO_SLOTS(200)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+#define EXPECT(type, t, keys, pressed, long_keys) \
+    expect(__LINE__, WKUP_KEYS_EVT_##type, t, keys, pressed, long_keys)
+
+static const struct wkup_keys_evt_cfg cfg =
+{
+    .settle     = SETTLE,
+    .long_press = LONG_PRESS,
+    .chord      = CHORD,
+    .long_mask  = K1,
+    .chord_mask = K1 | K2,
+};
+
+static struct wkup_keys_evt_state st;
+
+/// Time origin of the current run
+static uint32_t t0;
+
+static uint32_t at(uint32_t t)
+{
+    return (t0 + t) & WKUP_KEYS_EVT_TIME_MASK;
+}
+
+static void sample(uint32_t t, uint16_t raw)
+{
+    wkup_keys_evt_update(&st, at(t), raw);
+}
+
+static void expect(int line, uint8_t type, uint32_t t, uint16_t keys, uint16_t pressed,
+                   uint16_t long_keys)
+{
+    struct wkup_keys_event evt;
+
+    if (!wkup_keys_evt_pop(&st, &evt))
+    {
+        printf("%s:%d: no event\n", __FILE__, line);
+        fails++;
+    }
+    else if ((evt.type != type) || (evt.time != at(t)) || (evt.keys != keys) ||
+             (evt.pressed != pressed) || (evt.long_keys != long_keys))
+    {
+        printf("%s:%d: event %u at %lu keys %02X pressed %02X long %02X\n", __FILE__, line,
+               evt.type, (unsigned long)wkup_keys_evt_elapsed(evt.time, t0), evt.keys,
+               evt.pressed, evt.long_keys);
+        fails++;
+    }
+}
+
+static bool no_event(void)
+{
+    struct wkup_keys_event evt;
+
+    return !wkup_keys_evt_pop(&st, &evt);
+}
+
+static bool deadline_at(uint32_t t)
+{
+    uint32_t deadline;
+
+    return wkup_keys_evt_deadline(&st, &deadline) && (deadline == at(t));
+}
+
+static bool idle(void)
+{
+    uint32_t deadline;
+
+    return !wkup_keys_evt_deadline(&st, &deadline);
+}
+
+/// Bounces inside the settle window
+static void test_bounce(void)
+{
+    wkup_keys_evt_init(&st, &cfg, 0);
+    CHECK(idle());
+
+    // Press: reported at once, the bounces are not, the key ends pressed
+    sample(0, K0);
+    EXPECT(CHANGE, 0, K0, K0, 0);
+    CHECK(deadline_at(SETTLE));
+    sample(10, 0);
+    sample(20, K0);
+    sample(30, 0);
+    sample(40, K0);
+    CHECK(no_event());
+    CHECK(deadline_at(SETTLE));
+    sample(SETTLE, K0);
+    CHECK(no_event());
+    CHECK(idle());
+
+    // Release that bounces back and ends released
+    sample(200, 0);
+    EXPECT(CHANGE, 200, K0, 0, 0);
+    sample(210, K0);
+    sample(220, 0);
+    sample(200 + SETTLE, 0);
+    CHECK(no_event());
+
+    // Press that ends released inside the window: the release is reported at its end
+    sample(400, K0);
+    sample(420, 0);
+    EXPECT(CHANGE, 400, K0, K0, 0);
+    CHECK(no_event());
+    CHECK(deadline_at(400 + SETTLE));
+    sample(400 + SETTLE, 0);
+    EXPECT(CHANGE, 400 + SETTLE, K0, 0, 0);
+    CHECK(deadline_at(400 + 2 * SETTLE));
+    sample(400 + 2 * SETTLE, 0);
+    CHECK(no_event());
+    CHECK(idle());
+
+    // A key that changes in the window of another one extends the window
+    sample(1000, K0);
+    sample(1020, K0 | K2);
+    EXPECT(CHANGE, 1000, K0, K0, 0);
+    EXPECT(CHANGE, 1020, K2, K0 | K2, 0);
+    CHECK(deadline_at(1020 + SETTLE));
+    sample(1000 + SETTLE, 0);
+    CHECK(no_event());
+    sample(1020 + SETTLE, 0);
+    EXPECT(CHANGE, 1020 + SETTLE, K0 | K2, 0, 0);
+}
+
+/// A key that chatters for a long time
+static void test_chatter(void)
+{
+    struct wkup_keys_event evt;
+    uint32_t last = 0;
+    uint16_t raw = 0;
+    uint16_t pressed = 0;
+    unsigned events = 0;
+    uint32_t t;
+
+    wkup_keys_evt_init(&st, &cfg, 0);
+
+    for (t = 0; t < 2000; t += 7)
+    {
+        raw ^= K0;
+        sample(t, raw);
+
+        while (wkup_keys_evt_pop(&st, &evt))
+        {
+            uint32_t time = wkup_keys_evt_elapsed(evt.time, t0);
+
+            CHECK(evt.type == WKUP_KEYS_EVT_CHANGE && evt.keys == K0);
+            CHECK(evt.pressed != pressed);
+            CHECK(events == 0 || time - last >= SETTLE);
+            pressed = evt.pressed;
+            last = time;
+            events++;
+        }
+    }
+
+    CHECK(events <= 2000 / SETTLE + 1);
+    CHECK(st.overflows == 0);
+
+    // The level it ends on is reported when the last window closes
+    sample(t + SETTLE, raw);
+    if (raw != pressed)
+    {
+        CHECK(wkup_keys_evt_pop(&st, &evt) && evt.pressed == raw);
+    }
+    sample(t + 3 * SETTLE, raw);
+    CHECK(no_event());
+    CHECK(idle());
+    CHECK(st.pressed == raw);
+}
+
+static void test_long_press(void)
+{
+    wkup_keys_evt_init(&st, &cfg, 0);
+
+    // Held: reported once at the long press time, the release is flagged
+    sample(0, K1);
+    EXPECT(CHANGE, 0, K1, K1, 0);
+    CHECK(deadline_at(SETTLE));
+    sample(SETTLE, K1);
+    CHECK(deadline_at(LONG_PRESS));
+    sample(LONG_PRESS - 1, K1);
+    CHECK(no_event());
+    sample(LONG_PRESS, K1);
+    EXPECT(LONG_PRESS, LONG_PRESS, K1, K1, 0);
+    CHECK(idle());
+    sample(2 * LONG_PRESS, K1);
+    CHECK(no_event());
+    sample(2 * LONG_PRESS + 10, 0);
+    EXPECT(CHANGE, 2 * LONG_PRESS + 10, K1, 0, K1);
+    sample(2 * LONG_PRESS + 10 + SETTLE, 0);
+    CHECK(no_event());
+    CHECK(idle());
+
+    // Short press: no long press, the release is not flagged
+    sample(20000, K1);
+    sample(21000, 0);
+    EXPECT(CHANGE, 20000, K1, K1, 0);
+    EXPECT(CHANGE, 21000, K1, 0, 0);
+    sample(21000 + LONG_PRESS, 0);
+    CHECK(no_event());
+
+    // Late update: the events keep their time and their order
+    sample(30000, K1);
+    EXPECT(CHANGE, 30000, K1, K1, 0);
+    sample(30000 + 3 * LONG_PRESS, 0);
+    EXPECT(LONG_PRESS, 30000 + LONG_PRESS, K1, K1, 0);
+    EXPECT(CHANGE, 30000 + 3 * LONG_PRESS, K1, 0, K1);
+    CHECK(no_event());
+
+    // A key without long press
+    sample(50000, K0);
+    sample(50000 + 2 * LONG_PRESS, K0);
+    EXPECT(CHANGE, 50000, K0, K0, 0);
+    CHECK(no_event());
+    CHECK(idle());
+}
+
+static void test_chord(void)
+{
+    wkup_keys_evt_init(&st, &cfg, 0);
+
+    // Second key within the window: a chord, and no long press
+    sample(0, K1);
+    sample(100, K1 | K2);
+    EXPECT(CHANGE, 0, K1, K1, 0);
+    EXPECT(CHANGE, 100, K2, K1 | K2, 0);
+    EXPECT(CHORD, 100, K1 | K2, K1 | K2, 0);
+    sample(100 + SETTLE, K1 | K2);
+    CHECK(idle());
+    sample(2 * LONG_PRESS, K1 | K2);
+    CHECK(no_event());
+    sample(2 * LONG_PRESS + 10, 0);
+    EXPECT(CHANGE, 2 * LONG_PRESS + 10, K1 | K2, 0, 0);
+    sample(2 * LONG_PRESS + 10 + SETTLE, 0);
+
+    // Last slot of the window, second key first
+    sample(20000, K2);
+    sample(20000 + CHORD, K1 | K2);
+    EXPECT(CHANGE, 20000, K2, K2, 0);
+    EXPECT(CHANGE, 20000 + CHORD, K1, K1 | K2, 0);
+    EXPECT(CHORD, 20000 + CHORD, K1 | K2, K1 | K2, 0);
+    sample(20000 + CHORD + SETTLE, K1 | K2);
+    CHECK(idle());
+    sample(21000, 0);
+    EXPECT(CHANGE, 21000, K1 | K2, 0, 0);
+    sample(21000 + SETTLE, 0);
+
+    // One slot past the window: two presses, the long press of key 1 runs from its press
+    sample(30000, K1);
+    sample(30000 + CHORD + 1, K1 | K2);
+    EXPECT(CHANGE, 30000, K1, K1, 0);
+    EXPECT(CHANGE, 30000 + CHORD + 1, K2, K1 | K2, 0);
+    CHECK(no_event());
+    CHECK(deadline_at(30000 + CHORD + 1 + SETTLE));
+    sample(30000 + CHORD + 1 + SETTLE, K1 | K2);
+    CHECK(deadline_at(30000 + LONG_PRESS));
+    sample(30000 + LONG_PRESS, K1 | K2);
+    EXPECT(LONG_PRESS, 30000 + LONG_PRESS, K1, K1 | K2, 0);
+    sample(40000, 0);
+    EXPECT(CHANGE, 40000, K1 | K2, 0, K1);
+    sample(40000 + SETTLE, 0);
+
+    // A key outside the chord mask does not make a chord
+    sample(50000, K1);
+    sample(50010, K0 | K1);
+    EXPECT(CHANGE, 50000, K1, K1, 0);
+    EXPECT(CHANGE, 50010, K0, K0 | K1, 0);
+    CHECK(no_event());
+    CHECK(st.long_armed == K1);
+}
+
+static void test_queue(void)
+{
+    struct wkup_keys_event evt;
+    uint32_t t;
+
+    // Nine changes without a pop: the oldest is dropped
+    wkup_keys_evt_init(&st, &cfg, 0);
+    for (t = 0; t < 9; t++)
+    {
+        sample(t * 2 * SETTLE, (t & 1) ? 0 : K0);
+    }
+    CHECK(st.overflows == 1);
+    for (t = 1; t < 9; t++)
+    {
+        CHECK(wkup_keys_evt_pop(&st, &evt) && evt.time == at(t * 2 * SETTLE));
+    }
+    CHECK(no_event());
+}
+
+int main(void)
+{
+    static const uint32_t origins[] =
+    {
+        // Away from the wrap, and with every case across it
+        1000,
+        WKUP_KEYS_EVT_TIME_MASK - 5000,
+        WKUP_KEYS_EVT_TIME_MASK - 10,
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(origins) / sizeof(origins[0]); i++)
+    {
+        t0 = origins[i];
+        test_bounce();
+        test_chatter();
+        test_long_press();
+        test_chord();
+        test_queue();
+    }
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
@@ -0,0 +1,212 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_clk_discipline.c
+ *
+ * @brief RTC clock discipline source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "user_clk_discipline.h"
+#include "user_rtc_timestamp.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static int64_t div_round(int64_t num, int64_t den)
+{
+    return (num >= 0) ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+static int32_t clamp(int64_t val, int32_t limit)
+{
+    return (val > limit) ? limit : ((val < -limit) ? -limit : (int32_t)val);
+}
+
+bool clk_discipline_to_ms(uint16_t year, uint8_t month, uint8_t mday, uint8_t hour,
+                          uint8_t minute, uint8_t sec, uint16_t msec, int64_t *ms)
+{
+    struct rtc_ts_fields fields;
+
+    if (msec > 999)
+    {
+        return false;
+    }
+
+    fields.year = year;
+    fields.month = month;
+    fields.mday = mday;
+    fields.hour = hour;
+    fields.minute = minute;
+    fields.sec = sec;
+    fields.hsec = 0;
+    fields.pm = false;
+
+    // Same conversion as the RTC timestamps, so that references and RTC readings compare
+    if (!rtc_timestamp_from_fields(&fields, false, ms))
+    {
+        return false;
+    }
+    *ms += msec;
+
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Starts slewing the offset out over CLK_DISC_SLEW_PERIOD_S, or longer if the rate
+ *        would exceed CLK_DISC_SLEW_MAX_PPB.
+ ****************************************************************************************
+ */
+static void clk_discipline_slew(struct clk_discipline *cd, int32_t offset_ms)
+{
+    int32_t mag = (offset_ms < 0) ? -offset_ms : offset_ms;
+
+    cd->slew_s = CLK_DISC_SLEW_PERIOD_S;
+    if ((int64_t)mag * 1000000 > (int64_t)CLK_DISC_SLEW_MAX_PPB * CLK_DISC_SLEW_PERIOD_S)
+    {
+        cd->slew_s = ((int64_t)mag * 1000000 + CLK_DISC_SLEW_MAX_PPB - 1) / CLK_DISC_SLEW_MAX_PPB;
+    }
+
+    cd->slew_ms = offset_ms;
+    cd->slew_ppb = (int64_t)offset_ms * 1000000 / cd->slew_s;
+    cd->slewing = true;
+}
+
+static void clk_discipline_step(struct clk_discipline *cd)
+{
+    cd->slew_ms = 0;
+    cd->slew_ppb = 0;
+    cd->slewing = false;
+}
+
+enum clk_disc_action clk_discipline_update(struct clk_discipline *cd, int64_t ref_ms, int64_t local_ms)
+{
+    int64_t offset = local_ms - ref_ms;
+    int64_t interval_s = (ref_ms - cd->ref_ms) / 1000;
+    bool small = (offset >= -CLK_DISC_SLEW_MAX_MS) && (offset <= CLK_DISC_SLEW_MAX_MS);
+
+    if (cd->ref_valid && (interval_s >= 0) && (interval_s < CLK_DISC_MIN_INTERVAL_S))
+    {
+        // Too close to the last reference to tell drift from reference jitter
+        if (small)
+        {
+            return CLK_DISC_NONE;
+        }
+        cd->ref_valid = false;
+    }
+    else if (cd->ref_valid && (interval_s > 0))
+    {
+        // Part of the previous offset not slewed yet
+        int64_t left = cd->slew_ms;
+        int64_t drift_ppb;
+
+        if (interval_s < cd->slew_s)
+        {
+            left -= left * interval_s / cd->slew_s;
+        }
+        else
+        {
+            left = 0;
+        }
+
+        // Frequency error left by the current correction over the interval
+        drift_ppb = (offset - left) * 1000000 / interval_s;
+
+        if ((drift_ppb > CLK_DISC_FREQ_MAX_PPB) || (drift_ppb < -CLK_DISC_FREQ_MAX_PPB))
+        {
+            // Not a drift, the time was changed
+            cd->ref_valid = false;
+        }
+        else
+        {
+            int64_t tau = (int64_t)CLK_DISC_TAU_S * cd->samples / 4;
+
+            cd->freq_ppb = clamp(cd->freq_ppb + drift_ppb * interval_s / (interval_s + tau), CLK_DISC_FREQ_MAX_PPB);
+            if (cd->samples < 4)
+            {
+                cd->samples++;
+            }
+        }
+    }
+
+    cd->ref_ms = ref_ms;
+
+    if (small && cd->ref_valid)
+    {
+        clk_discipline_slew(cd, (int32_t)offset);
+        return CLK_DISC_SLEW;
+    }
+
+    // First reference, or an offset too large to slew
+    cd->ref_valid = true;
+    clk_discipline_step(cd);
+    return CLK_DISC_STEP;
+}
+
+void clk_discipline_slew_done(struct clk_discipline *cd)
+{
+    cd->slewing = false;
+}
+
+void clk_discipline_restart(struct clk_discipline *cd)
+{
+    cd->ref_valid = false;
+    clk_discipline_step(cd);
+}
+
+int32_t clk_discipline_steps(struct clk_discipline *cd, int32_t step_ppb, bool tick)
+{
+    int32_t target = cd->freq_ppb + (cd->slewing ? cd->slew_ppb : 0);
+    int32_t steps;
+
+    if (tick)
+    {
+        // First order noise shaping, the average of the applied steps follows the target
+        cd->dither_err_ppb = clamp((int64_t)cd->dither_err_ppb + cd->dither_target_ppb - cd->dither_applied_ppb, step_ppb);
+    }
+
+    steps = (int32_t)div_round((int64_t)target + cd->dither_err_ppb, step_ppb);
+
+    cd->dither_target_ppb = target;
+    cd->dither_applied_ppb = steps * step_ppb;
+
+    return steps;
+}
+
+/// @} APP
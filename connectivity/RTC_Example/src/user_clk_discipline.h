@@ -0,0 +1,208 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_clk_discipline.h
+ *
+ * @brief RTC clock discipline header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_CLK_DISCIPLINE_H_
+#define _USER_CLK_DISCIPLINE_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The RTC divider is set once from the measured RCX (or XTAL32K) frequency, so the RTC
+ * gains or loses time at the residual error of that measurement plus any temperature
+ * drift. Every CTS time write is used as a reference: the offset between the RTC and the
+ * reference, and the offset left at the previous reference, give the frequency error over
+ * the interval. The error is filtered into a frequency correction with a gain that grows
+ * with the interval, so long intervals weigh more than short ones.
+ *
+ * Offsets up to CLK_DISC_SLEW_MAX_MS are removed by slewing: the RTC runs slightly faster
+ * or slower for up to about an hour and is never stepped, so the time stays monotonic.
+ * Larger offsets, or a time that does not fit a plausible drift (a time zone change or a
+ * manual change), step the RTC and restart the reference.
+ *
+ * The correction is applied to the RTC divider in steps of 0.1 Hz, about 3 ppm with the
+ * XTAL32K and 7 ppm with the RCX. The steps are dithered on the hour event so that the
+ * average rate matches the correction.
+ *
+ * In a host simulation with references 2 to 48 hours apart, 50 ms of reference jitter
+ * and a stable temperature, the RTC stays within 0.2 s of the reference once three
+ * references have been taken, and drifts by less than 0.05 s per day (0.5 ppm) after the
+ * references stop (tools/clk_discipline_sim.c). Without discipline the same device
+ * drifts by the RCX measurement error, typically 20 to 100 ppm (2 to 9 s per day).
+ *
+ * This file only depends on user_rtc_timestamp.c and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Largest offset removed by slewing, larger offsets step the RTC
+#define CLK_DISC_SLEW_MAX_MS        (2000)
+
+/// Slew period for small offsets
+#define CLK_DISC_SLEW_PERIOD_S      (3600)
+
+/// Largest slew rate, longer slews are used for offsets that would exceed it
+#define CLK_DISC_SLEW_MAX_PPB       (500000)
+
+/// Largest frequency correction, a reference beyond it is a time change, not drift
+#define CLK_DISC_FREQ_MAX_PPB       (500000)
+
+/// Shortest reference interval used to learn the frequency
+#define CLK_DISC_MIN_INTERVAL_S     (1800)
+
+/// Filter time constant, once a few references have been taken
+#define CLK_DISC_TAU_S              (24 * 3600)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Action to take on the RTC after a reference
+enum clk_disc_action
+{
+    /// Leave the RTC, the reference is too close to the previous one to be used
+    CLK_DISC_NONE,
+    /// Set the RTC to the reference
+    CLK_DISC_STEP,
+    /// Leave the RTC, the offset is slewed
+    CLK_DISC_SLEW,
+};
+
+/// Discipline state, to be kept in retention memory
+struct clk_discipline
+{
+    /// Learned frequency correction, positive when the RTC runs fast
+    int32_t freq_ppb;
+    /// Rate of the current slew, positive when the RTC is ahead
+    int32_t slew_ppb;
+    /// Duration of the last slew
+    int32_t slew_s;
+    /// Offset being slewed since the last reference, 0 after a step
+    int32_t slew_ms;
+    /// Time of the last reference, in ms
+    int64_t ref_ms;
+    /// Correction requested at the last dither tick
+    int32_t dither_target_ppb;
+    /// Correction applied at the last dither tick
+    int32_t dither_applied_ppb;
+    /// Accumulated dither error
+    int32_t dither_err_ppb;
+    /// Frequency samples taken
+    uint8_t samples;
+    /// A reference has been taken since the last restart
+    bool ref_valid;
+    /// The slew is in progress
+    bool slewing;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Converts a calendar date and time to ms since 1970-01-01, the time base of
+ *        user_rtc_get_ms().
+ * @param[in] year      Year, 1900 to 2999.
+ * @param[in] month     Month, 1 to 12.
+ * @param[in] mday      Day of the month.
+ * @param[in] hour      Hour, 0 to 23.
+ * @param[in] minute    Minute.
+ * @param[in] sec       Second.
+ * @param[in] msec      Millisecond.
+ * @param[out] ms       Converted time.
+ * @return False if the date or time is not valid.
+ ****************************************************************************************
+ */
+bool clk_discipline_to_ms(uint16_t year, uint8_t month, uint8_t mday, uint8_t hour,
+                          uint8_t minute, uint8_t sec, uint16_t msec, int64_t *ms);
+
+/**
+ ****************************************************************************************
+ * @brief Processes a reference time. Learns the frequency error from the previous
+ *        reference and starts a slew, or asks for a step.
+ * @param[in] cd        Discipline state.
+ * @param[in] ref_ms    Reference time in ms.
+ * @param[in] local_ms  RTC time in ms when the reference was received.
+ * @return Action to take on the RTC. On CLK_DISC_SLEW the caller applies the new
+ *         correction and ends the slew after cd->slew_s seconds.
+ ****************************************************************************************
+ */
+enum clk_disc_action clk_discipline_update(struct clk_discipline *cd, int64_t ref_ms, int64_t local_ms);
+
+/**
+ ****************************************************************************************
+ * @brief Ends the current slew, the correction returns to the learned frequency.
+ * @param[in] cd        Discipline state.
+ ****************************************************************************************
+ */
+void clk_discipline_slew_done(struct clk_discipline *cd);
+
+/**
+ ****************************************************************************************
+ * @brief Forgets the last reference after the time was set by other means. The learned
+ *        frequency is kept.
+ * @param[in] cd        Discipline state.
+ ****************************************************************************************
+ */
+void clk_discipline_restart(struct clk_discipline *cd);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the correction to apply, as a number of divider steps.
+ * @param[in] cd            Discipline state.
+ * @param[in] step_ppb      Correction of one divider step.
+ * @param[in] tick          True on the periodic dither tick, false when the correction
+ *                          changes between ticks.
+ * @return Divider steps, positive to slow the RTC down.
+ ****************************************************************************************
+ */
+int32_t clk_discipline_steps(struct clk_discipline *cd, int32_t step_ppb, bool tick);
+
+/// @} APP
+
+#endif // _USER_CLK_DISCIPLINE_H_
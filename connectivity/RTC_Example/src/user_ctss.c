@@ -42,11 +42,17 @@
  ****************************************************************************************
  */
  #include "user_ctss.h"
+ #include "rtc.h"
+ #include "app_easy_timer.h"
+ #include "user_rtc_util.h"
+ #include "user_clk_discipline.h"
  
  
 struct cts_curr_time cts_current_time                   __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 struct cts_loc_time_info cts_current_dst_tz             __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 struct cts_ref_time_info ref_time                       __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+struct clk_discipline clk_disc                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+timer_hnd clk_disc_slew_timer                           __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
  
  /*
  * FUNCTION DEFINITIONS
@@ -74,6 +80,93 @@ static void rtc_to_cts_date_time_struct(rtc_time_t *rtc_time, rtc_calendar_t *rt
     cts_time->exact_time_256.day_date_time.date_time.sec = rtc_time->sec;
 }
 
+/**
+ ****************************************************************************************
+ * @brief Applies the correction of the clock discipline to the RTC divider.
+ * @param[in] tick true on the hour event, which advances the dithering of the divider
+ * @return void
+ ****************************************************************************************
+*/
+static void clk_disc_apply(bool tick)
+{
+    rtc_clock_trim(clk_discipline_steps(&clk_disc, rtc_clock_step_ppb(), tick));
+}
+
+static void clk_disc_slew_timer_cb(void)
+{
+    clk_disc_slew_timer = EASY_TIMER_INVALID_TIMER;
+    clk_discipline_slew_done(&clk_disc);
+    clk_disc_apply(false);
+}
+
+static void clk_disc_cancel_slew(void)
+{
+    if (clk_disc_slew_timer != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(clk_disc_slew_timer);
+        clk_disc_slew_timer = EASY_TIMER_INVALID_TIMER;
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Uses a reference time to discipline the RTC. The RTC is stepped to the
+ *        reference only if the offset is too large to slew.
+ * @param[in] rtc_time_t reference time in 24H mode
+ * @param[in] rtc_calendar_t reference date
+ * @return false if the date/time entry is not valid
+ ****************************************************************************************
+*/
+static bool clk_disc_reference(rtc_time_t *rtc_ref_time, rtc_calendar_t *rtc_ref_clndr)
+{
+    int64_t ref_ms;
+    
+    if ((rtc_ref_clndr->wday < 1) || (rtc_ref_clndr->wday > 7) ||
+        !clk_discipline_to_ms(rtc_ref_clndr->year, rtc_ref_clndr->month, rtc_ref_clndr->mday,
+                              rtc_ref_time->hour, rtc_ref_time->minute, rtc_ref_time->sec,
+                              rtc_ref_time->hsec * 10, &ref_ms))
+    {
+        return false;
+    }
+    
+    switch (clk_discipline_update(&clk_disc, ref_ms, user_rtc_get_ms()))
+    {
+        case CLK_DISC_STEP:
+            clk_disc_cancel_slew();
+            if (user_rtc_set_time_clndr(rtc_ref_time, rtc_ref_clndr) != RTC_STATUS_CODE_VALID_ENTRY)
+            {
+                clk_discipline_restart(&clk_disc);
+                clk_disc_apply(false);
+                return false;
+            }
+            break;
+        
+        case CLK_DISC_SLEW:
+            clk_disc_cancel_slew();
+            // Timer delay is in 10ms units
+            clk_disc_slew_timer = app_easy_timer(clk_disc.slew_s * 100, clk_disc_slew_timer_cb);
+            break;
+        
+        default:
+            return true;
+    }
+    
+    clk_disc_apply(false);
+    return true;
+}
+
+void update_clk_discipline(void)
+{
+    clk_disc_apply(true);
+}
+
+void user_ctss_time_changed(void)
+{
+    clk_disc_cancel_slew();
+    clk_discipline_restart(&clk_disc);
+    clk_disc_apply(false);
+}
+
 void update_ref_time_info(void)
 {
     ref_time.hours_update++;
@@ -114,13 +207,13 @@ void user_ctss_init(void)
     ref_time.time_accuracy = ACCURACY_UNKNOWN;
     ref_time.days_update = 0;
     ref_time.hours_update = 0;
+    
+    clk_disc_slew_timer = EASY_TIMER_INVALID_TIMER;
 }
 
 void ext_cts_adjust_time_date(rtc_time_t *rtc_chg_time, rtc_calendar_t *rtc_chg_clndr, struct cts_loc_time_info time_zone_dst_off)
 {
-    rtc_status_code_t status = rtc_set_time_clndr(rtc_chg_time, rtc_chg_clndr);
-    
-    if (status != RTC_STATUS_CODE_VALID_ENTRY)
+    if (clk_disc_reference(rtc_chg_time, rtc_chg_clndr))
     {
         cts_current_time.adjust_reason = CTSS_REASON_FLAG_EXT_TIME_UPDATE;
         // Convert from RTC date and time format to CTS date and time format
@@ -187,10 +280,11 @@ uint8_t user_on_cur_time_write_req(const struct cts_curr_time *ct)
     rtc_current_time.hour   = ct->exact_time_256.day_date_time.date_time.hour;
     rtc_current_time.minute = ct->exact_time_256.day_date_time.date_time.min;
     rtc_current_time.sec    = ct->exact_time_256.day_date_time.date_time.sec;
-    // First have the RTC driver to check if the date/time entry is valid
-    rtc_status_code_t status = rtc_set_time_clndr(&rtc_current_time, &rtc_current_date);
-    
-    if(status != RTC_STATUS_CODE_VALID_ENTRY)
+    rtc_current_time.hsec   = (ct->exact_time_256.fraction_256 * 100) >> 8;
+    rtc_current_time.hour_mode = RTC_HOUR_MODE_24H;
+    rtc_current_time.pm_flag = 0;
+    // Discipline the RTC with the new time, it is only set if the offset is too large to slew
+    if(!clk_disc_reference(&rtc_current_time, &rtc_current_date))
     {
         return ATT_ERR_APP_ERROR;
     }
@@ -159,6 +159,22 @@ void user_on_ref_time_info_read(struct cts_ref_time_info *rt);
 */
 void update_ref_time_info(void);
 
+/**
+ ****************************************************************************************
+ * @brief Callback triggered on the hour event to advance the dithering of the RTC
+ * divider correction.
+ ****************************************************************************************
+*/
+void update_clk_discipline(void);
+
+/**
+ ****************************************************************************************
+ * @brief Informs the clock discipline that the RTC was set by other means than CTS, the
+ * next CTS write starts a new reference. The learned frequency correction is kept.
+ ****************************************************************************************
+*/
+void user_ctss_time_changed(void);
+
 #endif /* #if (BLE_CTS_SERVER) */
 
 /// @} CTSS
@@ -50,6 +50,11 @@
 #include "user_real_time_clk.h"
 #include "user_rtc_util.h"
 
+#if BLE_CTS_SERVER
+#include "ctss.h"
+#include "user_ctss.h"
+#endif
+
 timer_hnd ntf_update_tmr_hnd                            __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 bool rec_alarm_flag                                     __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 
@@ -110,12 +115,19 @@ void user_svc1_current_time_wr_ind_handler(ke_msg_id_t const msgid,
         rtc_current_time.pm_flag    = current_timestamp.pm_flag;
 
     // First have the RTC driver to check if the date/time entry is valid
-    rtc_status_code_t status = rtc_set_time_clndr(&rtc_current_time, &rtc_current_date);
+    rtc_status_code_t status = user_rtc_set_time_clndr(&rtc_current_time, &rtc_current_date);
     
     if(status != RTC_STATUS_CODE_VALID_ENTRY)
     {
         rtc_error_ntf_send(param->handle, status);
     }
+#if BLE_CTS_SERVER
+    else
+    {
+        // The RTC was stepped, CTS disciplining starts over from the next reference
+        user_ctss_time_changed();
+    }
+#endif
 }
 
 static void app_ntf_rtc_update_handler(void)
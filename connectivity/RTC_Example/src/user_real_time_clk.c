@@ -326,7 +326,11 @@ void rtc_wakeup_event(uint8_t event)
 #endif  // BLE_CUSTOM1_SERVER
 #if (BLE_CTS_SERVER)    
     if (event & RTC_EVENT_HOUR)
-        update_ref_time_info();
+    {
+        if(APP_CTS_FEATURES & CTSS_REF_TIME_INFO_SUP)
+            update_ref_time_info();
+        update_clk_discipline();
+    }
 #endif
 }
 
@@ -380,9 +384,8 @@ void user_app_on_init(void)
     
 #if BLE_CTS_SERVER
     user_ctss_init();
-/// If the Reference Time Feature is enabled activate the RTC interrupt on hour event
-    if(APP_CTS_FEATURES & CTSS_REF_TIME_INFO_SUP)
-        user_rtc_register_intr(rtc_wakeup_event, RTC_HOUR_INT_EN);
+/// The hour event updates the Reference Time Information, if the feature is enabled, and the RTC clock discipline
+    user_rtc_register_intr(rtc_wakeup_event, RTC_HOUR_INT_EN);
 #endif
 
     adv_data_date_init();
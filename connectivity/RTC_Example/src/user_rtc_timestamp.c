@@ -0,0 +1,244 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_rtc_timestamp.c
+ *
+ * @brief RTC epoch timestamp source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "user_rtc_timestamp.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define MS_PER_HOUR                 (3600000L)
+#define MS_PER_DAY                  (86400000L)
+
+/// Days from 0000-03-01 to 1970-01-01
+#define DAYS_0000_TO_1970           (719468L)
+
+#define BCD_DIGIT(reg, pos)         (((reg) >> (pos)) & 0xF)
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// Milliseconds of each BCD digit of RTC_TIME_REG
+static const uint32_t hr_t_ms[3] = {0, 10 * MS_PER_HOUR, 20 * MS_PER_HOUR};
+static const uint32_t hr_u_ms[10] = {0, MS_PER_HOUR, 2 * MS_PER_HOUR, 3 * MS_PER_HOUR, 4 * MS_PER_HOUR,
+                                     5 * MS_PER_HOUR, 6 * MS_PER_HOUR, 7 * MS_PER_HOUR, 8 * MS_PER_HOUR, 9 * MS_PER_HOUR};
+static const uint32_t m_t_ms[6] = {0, 600000, 1200000, 1800000, 2400000, 3000000};
+static const uint32_t m_u_ms[10] = {0, 60000, 120000, 180000, 240000, 300000, 360000, 420000, 480000, 540000};
+static const uint16_t s_t_ms[6] = {0, 10000, 20000, 30000, 40000, 50000};
+static const uint16_t s_u_ms[10] = {0, 1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000};
+static const uint16_t h_t_ms[10] = {0, 100, 200, 300, 400, 500, 600, 700, 800, 900};
+static const uint8_t h_u_ms[10] = {0, 10, 20, 30, 40, 50, 60, 70, 80, 90};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static bool is_leap_year(uint16_t year)
+{
+    return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Days from 1970-01-01 to a date, with the year starting in March so that the
+ *        leap day is the last day of the year.
+ ****************************************************************************************
+ */
+static int32_t days_from_civil(uint16_t year, uint8_t month, uint8_t mday)
+{
+    int32_t y = year - (month <= 2);
+    int32_t era = y / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5 + mday - 1;
+
+    return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - DAYS_0000_TO_1970;
+}
+
+static void civil_from_days(int32_t days, struct rtc_ts_fields *fields)
+{
+    int32_t z = days + DAYS_0000_TO_1970;
+    int32_t era = z / 146097;
+    int32_t doe = z - era * 146097;
+    int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int32_t mp = (5 * doy + 2) / 153;
+
+    fields->mday = doy - (153 * mp + 2) / 5 + 1;
+    fields->month = (mp < 10) ? mp + 3 : mp - 9;
+    fields->year = yoe + era * 400 + (fields->month <= 2);
+}
+
+static int64_t anchor_from_reg(uint32_t cal_reg)
+{
+    uint16_t year = BCD_DIGIT(cal_reg, RTC_TS_CAL_C_T) * 1000 + BCD_DIGIT(cal_reg, RTC_TS_CAL_C_U) * 100 +
+                    BCD_DIGIT(cal_reg, RTC_TS_CAL_Y_T) * 10 + BCD_DIGIT(cal_reg, RTC_TS_CAL_Y_U);
+    uint8_t month = ((cal_reg >> RTC_TS_CAL_M_T) & 0x1) * 10 + BCD_DIGIT(cal_reg, RTC_TS_CAL_M_U);
+    uint8_t mday = BCD_DIGIT(cal_reg, RTC_TS_CAL_D_T) * 10 + BCD_DIGIT(cal_reg, RTC_TS_CAL_D_U);
+
+    return (int64_t)days_from_civil(year, month, mday) * MS_PER_DAY;
+}
+
+void rtc_timestamp_init(struct rtc_timestamp *ts, bool hour_12, uint32_t time_reg, uint32_t cal_reg)
+{
+    ts->hour_12 = hour_12;
+    ts->anchor_valid = false;
+    ts->mono_offset_ms = 0;
+    ts->mono_offset_ms = -rtc_timestamp_get(ts, time_reg, cal_reg);
+}
+
+int64_t rtc_timestamp_get(struct rtc_timestamp *ts, uint32_t time_reg, uint32_t cal_reg)
+{
+    uint32_t ms;
+
+    cal_reg &= RTC_TS_CAL_MASK;
+    time_reg &= RTC_TS_TIME_MASK;
+
+    if (!ts->anchor_valid || (cal_reg != ts->cal_reg))
+    {
+        // Once a day, or after the RTC was set
+        ts->anchor_ms = anchor_from_reg(cal_reg);
+        ts->cal_reg = cal_reg;
+        ts->anchor_valid = true;
+    }
+
+    ms = hr_t_ms[(time_reg >> RTC_TS_TIME_HR_T) & 0x3] + hr_u_ms[BCD_DIGIT(time_reg, RTC_TS_TIME_HR_U)] +
+         m_t_ms[(time_reg >> RTC_TS_TIME_M_T) & 0x7] + m_u_ms[BCD_DIGIT(time_reg, RTC_TS_TIME_M_U)] +
+         s_t_ms[(time_reg >> RTC_TS_TIME_S_T) & 0x7] + s_u_ms[BCD_DIGIT(time_reg, RTC_TS_TIME_S_U)] +
+         h_t_ms[BCD_DIGIT(time_reg, RTC_TS_TIME_H_T)] + h_u_ms[BCD_DIGIT(time_reg, RTC_TS_TIME_H_U)];
+
+    if (ts->hour_12)
+    {
+        // 12 AM is 00 and 12 PM is 12 in 24H mode
+        if (((time_reg >> RTC_TS_TIME_HR_U) & 0x3F) == 0x12)
+        {
+            ms -= 12 * MS_PER_HOUR;
+        }
+        if (time_reg & (1UL << RTC_TS_TIME_PM))
+        {
+            ms += 12 * MS_PER_HOUR;
+        }
+    }
+
+    return ts->anchor_ms + ms;
+}
+
+uint64_t rtc_timestamp_mono(const struct rtc_timestamp *ts, int64_t ms)
+{
+    return (uint64_t)(ms + ts->mono_offset_ms);
+}
+
+void rtc_timestamp_set(struct rtc_timestamp *ts, int64_t before_ms, int64_t after_ms)
+{
+    ts->mono_offset_ms += before_ms - after_ms;
+    ts->anchor_valid = false;
+}
+
+void rtc_timestamp_hour_mode(struct rtc_timestamp *ts, bool hour_12)
+{
+    ts->hour_12 = hour_12;
+}
+
+bool rtc_timestamp_from_fields(const struct rtc_ts_fields *fields, bool hour_12, int64_t *ms)
+{
+    uint8_t hour = fields->hour;
+
+    if (hour_12)
+    {
+        if ((hour < 1) || (hour > 12))
+        {
+            return false;
+        }
+        hour = (hour % 12) + (fields->pm ? 12 : 0);
+    }
+
+    if ((fields->year < 1900) || (fields->year > 2999) || (fields->month < 1) || (fields->month > 12) ||
+        (fields->mday < 1) ||
+        (fields->mday > days_in_month[fields->month - 1] + ((fields->month == 2) && is_leap_year(fields->year))) ||
+        (hour > 23) || (fields->minute > 59) || (fields->sec > 59) || (fields->hsec > 99))
+    {
+        return false;
+    }
+
+    *ms = (int64_t)days_from_civil(fields->year, fields->month, fields->mday) * MS_PER_DAY +
+          hour * MS_PER_HOUR + fields->minute * 60000L + fields->sec * 1000L + fields->hsec * 10;
+
+    return true;
+}
+
+void rtc_timestamp_to_fields(int64_t ms, bool hour_12, struct rtc_ts_fields *fields)
+{
+    int32_t days = (int32_t)(ms / MS_PER_DAY);
+    int32_t rem = (int32_t)(ms % MS_PER_DAY);
+
+    if (rem < 0)
+    {
+        // Before 1970
+        days--;
+        rem += MS_PER_DAY;
+    }
+
+    civil_from_days(days, fields);
+    // 1970-01-01 was a Thursday
+    fields->wday = ((days % 7) + 10) % 7 + 1;
+
+    fields->hour = rem / MS_PER_HOUR;
+    rem -= fields->hour * MS_PER_HOUR;
+    fields->minute = rem / 60000;
+    rem -= fields->minute * 60000;
+    fields->sec = rem / 1000;
+    fields->hsec = (rem - fields->sec * 1000) / 10;
+    fields->pm = false;
+
+    if (hour_12)
+    {
+        fields->pm = (fields->hour >= 12);
+        fields->hour = (fields->hour % 12) ? (fields->hour % 12) : 12;
+    }
+}
+
+/// @} APP
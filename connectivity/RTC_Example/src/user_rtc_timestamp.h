@@ -0,0 +1,220 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_rtc_timestamp.h
+ *
+ * @brief RTC epoch timestamp header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_RTC_TIMESTAMP_H_
+#define _USER_RTC_TIMESTAMP_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The RTC keeps the time and the calendar in BCD registers. Converting them to a
+ * timestamp takes a days-from-date calculation, which only changes once a day. The
+ * timestamp is kept as an anchor, the epoch time at 00:00 of the day in the calendar
+ * register, and the time register is added to it with one table lookup per BCD digit.
+ * The anchor is recalculated when the calendar register changes. Reading a timestamp
+ * takes additions and a compare only.
+ *
+ * Timestamps are milliseconds since 1970-01-01 00:00 in the time zone of the RTC, with
+ * 10 ms resolution. The monotonic time starts at 0 when the timestamps are initialized
+ * and does not jump when the RTC is set.
+ *
+ * Calendar fields are only derived from a timestamp when they are needed, e.g. for
+ * display or CTS.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// RTC_TIME_REG fields
+#define RTC_TS_TIME_H_U             (0)     // Hundredths of a second, units
+#define RTC_TS_TIME_H_T             (4)     // Hundredths of a second, tens
+#define RTC_TS_TIME_S_U             (8)
+#define RTC_TS_TIME_S_T             (12)
+#define RTC_TS_TIME_M_U             (16)
+#define RTC_TS_TIME_M_T             (20)
+#define RTC_TS_TIME_HR_U            (24)
+#define RTC_TS_TIME_HR_T            (28)
+#define RTC_TS_TIME_PM              (30)
+
+/// RTC_CALENDAR_REG fields
+#define RTC_TS_CAL_WD               (0)
+#define RTC_TS_CAL_M_U              (3)
+#define RTC_TS_CAL_M_T              (7)
+#define RTC_TS_CAL_D_U              (8)
+#define RTC_TS_CAL_D_T              (12)
+#define RTC_TS_CAL_Y_U              (16)
+#define RTC_TS_CAL_Y_T              (20)
+#define RTC_TS_CAL_C_U              (24)
+#define RTC_TS_CAL_C_T              (28)
+
+/// Time and calendar bits, without the entry valid (CH) bit
+#define RTC_TS_TIME_MASK            (0x7F7F7FFF)
+#define RTC_TS_CAL_MASK             (0x3FFF3FFF)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Calendar form of a timestamp
+struct rtc_ts_fields
+{
+    /// 1900 to 2999
+    uint16_t year;
+    /// 1 to 12
+    uint8_t month;
+    /// 1 to 31
+    uint8_t mday;
+    /// 1 (Monday) to 7 (Sunday)
+    uint8_t wday;
+    /// 0 to 23, or 1 to 12 in 12H mode
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t sec;
+    /// Hundredths of a second
+    uint8_t hsec;
+    /// Afternoon, in 12H mode
+    bool pm;
+};
+
+/// Timestamp state, to be kept in retention memory
+struct rtc_timestamp
+{
+    /// Calendar register the anchor was calculated for
+    uint32_t cal_reg;
+    /// Timestamp at 00:00 of the anchor day
+    int64_t anchor_ms;
+    /// Difference between the monotonic time and the timestamp
+    int64_t mono_offset_ms;
+    /// The RTC runs in 12H mode
+    bool hour_12;
+    /// The anchor matches cal_reg
+    bool anchor_valid;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Initializes the timestamps. The monotonic time starts at 0.
+ * @param[in] ts        Timestamp state.
+ * @param[in] hour_12   True if the RTC runs in 12H mode.
+ * @param[in] time_reg  Current RTC_TIME_REG value.
+ * @param[in] cal_reg   Current RTC_CALENDAR_REG value.
+ ****************************************************************************************
+ */
+void rtc_timestamp_init(struct rtc_timestamp *ts, bool hour_12, uint32_t time_reg, uint32_t cal_reg);
+
+/**
+ ****************************************************************************************
+ * @brief Converts the RTC registers to a timestamp. RTC_TIME_REG must be read first,
+ *        the RTC holds RTC_CALENDAR_REG until it is read.
+ * @param[in] ts        Timestamp state.
+ * @param[in] time_reg  RTC_TIME_REG value.
+ * @param[in] cal_reg   RTC_CALENDAR_REG value.
+ * @return Timestamp in ms.
+ ****************************************************************************************
+ */
+int64_t rtc_timestamp_get(struct rtc_timestamp *ts, uint32_t time_reg, uint32_t cal_reg);
+
+/**
+ ****************************************************************************************
+ * @brief Converts a timestamp to the monotonic time.
+ * @param[in] ts        Timestamp state.
+ * @param[in] ms        Timestamp returned by rtc_timestamp_get().
+ * @return Monotonic time in ms.
+ ****************************************************************************************
+ */
+uint64_t rtc_timestamp_mono(const struct rtc_timestamp *ts, int64_t ms);
+
+/**
+ ****************************************************************************************
+ * @brief Keeps the monotonic time continuous when the RTC is set.
+ * @param[in] ts        Timestamp state.
+ * @param[in] before_ms Timestamp just before the RTC was set.
+ * @param[in] after_ms  Timestamp just after the RTC was set.
+ ****************************************************************************************
+ */
+void rtc_timestamp_set(struct rtc_timestamp *ts, int64_t before_ms, int64_t after_ms);
+
+/**
+ ****************************************************************************************
+ * @brief Sets the hour mode the time register is read in. Must be called whenever the
+ *        RTC hour mode changes.
+ * @param[in] ts        Timestamp state.
+ * @param[in] hour_12   True if the RTC runs in 12H mode.
+ ****************************************************************************************
+ */
+void rtc_timestamp_hour_mode(struct rtc_timestamp *ts, bool hour_12);
+
+/**
+ ****************************************************************************************
+ * @brief Converts calendar fields to a timestamp.
+ * @param[in] fields    Calendar fields, the day of the week is not used.
+ * @param[in] hour_12   True if the hour is in 12H mode.
+ * @param[out] ms       Timestamp.
+ * @return False if the date or time is not valid.
+ ****************************************************************************************
+ */
+bool rtc_timestamp_from_fields(const struct rtc_ts_fields *fields, bool hour_12, int64_t *ms);
+
+/**
+ ****************************************************************************************
+ * @brief Converts a timestamp to calendar fields.
+ * @param[in] ms        Timestamp, from 1900-01-01 to 2999-12-31.
+ * @param[in] hour_12   True to return the hour in 12H mode.
+ * @param[out] fields   Calendar fields.
+ ****************************************************************************************
+ */
+void rtc_timestamp_to_fields(int64_t ms, bool hour_12, struct rtc_ts_fields *fields);
+
+/// @} APP
+
+#endif // _USER_RTC_TIMESTAMP_H_
@@ -42,8 +42,11 @@
 #include "arch_system.h"
 #include "user_rtc_util.h"
 #include "rtc.h"
+#include "user_rtc_timestamp.h"
  
 static uint8_t rtc_interrupt_enable_reg_r               __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static uint32_t rtc_clk_freq                            __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static struct rtc_timestamp rtc_ts                      __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 extern rcx_time_data_t rcx_time_data;
  
 void rtc_clock_set(void)
@@ -51,10 +54,28 @@ void rtc_clock_set(void)
     // Set the frequency that the RTC will operate
     if (arch_clk_is_RCX20()) {
         // Calculate RCX frequency. (1000000 / 625 >> 20) is equal to (100 >> 16), which is equal to 25 >> 14
-        rtc_clk_config(RTC_DIV_DENOM_1000, rcx_time_data.rcx_freq);
+        rtc_clk_freq = rcx_time_data.rcx_freq;
     } else {
-        rtc_clk_config(RTC_DIV_DENOM_1000, 32768);
+        rtc_clk_freq = 32768;
     }
+    rtc_clk_config(RTC_DIV_DENOM_1000, rtc_clk_freq);
+}
+
+int32_t rtc_clock_step_ppb(void)
+{
+    // One step of the fractional divider is 0.1 Hz
+    return 100000000 / rtc_clk_freq;
+}
+
+void rtc_clock_trim(int32_t steps)
+{
+    // The divider is frequency / 100 in 1/1000 units, so the frequency is counted in 0.1 Hz
+    uint32_t div = rtc_clk_freq * 10 + steps;
+    
+    GLOBAL_INT_DISABLE();
+    SetBits32(CLK_RTCDIV_REG, RTC_DIV_INT, div / 1000);
+    SetBits32(CLK_RTCDIV_REG, RTC_DIV_FRAC, div % 1000);
+    GLOBAL_INT_RESTORE();
 }
 
 rtc_status_code_t rtc_configure(rtc_time_t *time, rtc_calendar_t *cal, rtc_config_t *config)
@@ -69,7 +90,56 @@ rtc_status_code_t rtc_configure(rtc_time_t *time, rtc_calendar_t *cal, rtc_confi
     rtc_clock_set();
     // Enable the RTC clk
     rtc_clock_enable();
-    return rtc_set_time_clndr(time, cal);
+    rtc_status_code_t status = rtc_set_time_clndr(time, cal);
+    // The monotonic time starts from the configured time
+    rtc_timestamp_init(&rtc_ts, config->hour_clk_mode == RTC_HOUR_MODE_12H, GetWord32(RTC_TIME_REG), GetWord32(RTC_CALENDAR_REG));
+    return status;
+}
+
+int64_t user_rtc_get_ms(void)
+{
+    // Reading the time register holds the calendar register until it is read
+    uint32_t time_reg = GetWord32(RTC_TIME_REG);
+    
+    return rtc_timestamp_get(&rtc_ts, time_reg, GetWord32(RTC_CALENDAR_REG));
+}
+
+uint64_t user_rtc_get_mono_ms(void)
+{
+    return rtc_timestamp_mono(&rtc_ts, user_rtc_get_ms());
+}
+
+rtc_status_code_t user_rtc_set_time_clndr(rtc_time_t *time, rtc_calendar_t *cal)
+{
+    int64_t before_ms = user_rtc_get_ms();
+    rtc_status_code_t status = rtc_set_time_clndr(time, cal);
+    
+    if (status == RTC_STATUS_CODE_VALID_ENTRY)
+    {
+        // The entry may have switched the RTC to the other hour mode
+        rtc_timestamp_hour_mode(&rtc_ts, rtc_get_hour_clk_mode() == RTC_HOUR_MODE_12H);
+        rtc_timestamp_set(&rtc_ts, before_ms, user_rtc_get_ms());
+    }
+    
+    return status;
+}
+
+void user_rtc_ms_to_time_clndr(int64_t ms, rtc_time_t *time, rtc_calendar_t *cal)
+{
+    struct rtc_ts_fields fields;
+    
+    rtc_timestamp_to_fields(ms, rtc_ts.hour_12, &fields);
+    
+    cal->year = fields.year;
+    cal->month = fields.month;
+    cal->mday = fields.mday;
+    cal->wday = fields.wday;
+    time->hour_mode = rtc_ts.hour_12 ? RTC_HOUR_MODE_12H : RTC_HOUR_MODE_24H;
+    time->pm_flag = fields.pm;
+    time->hour = fields.hour;
+    time->minute = fields.minute;
+    time->sec = fields.sec;
+    time->hsec = fields.hsec;
 }
 
 uint32_t rtc_convert_time_to_msec(rtc_time_t *time)
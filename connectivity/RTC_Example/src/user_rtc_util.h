@@ -70,6 +70,24 @@
  ****************************************************************************************
  */
 void rtc_clock_set(void);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the frequency correction of one RTC divider step
+ * @return int32_t correction in ppb
+ ****************************************************************************************
+ */
+int32_t rtc_clock_step_ppb(void);
+
+/**
+ ****************************************************************************************
+ * @brief Trims the RTC divider set by rtc_clock_set()
+ * @details Each step adds 0.1 Hz to the frequency the divider is set for, i.e. slows
+ *          the RTC down by rtc_clock_step_ppb(). The divider is changed on the fly.
+ * @param[in] steps number of divider steps, negative to speed the RTC up
+ ****************************************************************************************
+ */
+void rtc_clock_trim(int32_t steps);
      
 /**
  ****************************************************************************************
@@ -84,6 +102,48 @@ void rtc_clock_set(void);
  */
 rtc_status_code_t rtc_configure(rtc_time_t *time, rtc_calendar_t *cal, rtc_config_t *config);
  
+/**
+ ****************************************************************************************
+ * @brief Reads the RTC as a timestamp
+ * @details Milliseconds since 1970-01-01 00:00 in the time zone of the RTC. Only the
+ *          time register is converted, the date part is cached until the date changes,
+ *          so this is cheap enough to stamp every sample of a sensor.
+ * @return int64_t timestamp in ms, 10 ms resolution
+ ****************************************************************************************
+ */
+int64_t user_rtc_get_ms(void);
+
+/**
+ ****************************************************************************************
+ * @brief Reads the monotonic time
+ * @details Starts at 0 when the RTC is configured and does not jump when the time is
+ *          set through user_rtc_set_time_clndr().
+ * @return uint64_t monotonic time in ms
+ ****************************************************************************************
+ */
+uint64_t user_rtc_get_mono_ms(void);
+
+/**
+ ****************************************************************************************
+ * @brief Sets the time and calendar of the RTC, keeping the monotonic time continuous
+ * @param[in] time the new time
+ * @param[in] cal the new date
+ * @return rtc_status_code_t invalid or valid settings
+ ****************************************************************************************
+ */
+rtc_status_code_t user_rtc_set_time_clndr(rtc_time_t *time, rtc_calendar_t *cal);
+
+/**
+ ****************************************************************************************
+ * @brief Converts a timestamp to time and date, in the hour mode of the RTC
+ * @param[in] ms timestamp as returned by user_rtc_get_ms()
+ * @param[out] time converted time
+ * @param[out] cal converted date
+ * @return void
+ ****************************************************************************************
+ */
+void user_rtc_ms_to_time_clndr(int64_t ms, rtc_time_t *time, rtc_calendar_t *cal);
+
 /**
  ****************************************************************************************
  * @brief Converts time from rtc_time_t format to milliseconds starting from 00:00
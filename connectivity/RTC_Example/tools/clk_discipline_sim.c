@@ -0,0 +1,232 @@
+/**
+ ****************************************************************************************
+ *
+ * @file clk_discipline_sim.c
+ *
+ * @brief Host simulation of the RTC clock discipline.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs user_clk_discipline.c against simulated RTCs:
+ *
+ *     gcc -O2 -Isrc -o clk_discipline_sim tools/clk_discipline_sim.c src/user_clk_discipline.c \
+ *         src/user_rtc_timestamp.c -lm
+ *     ./clk_discipline_sim [-v]
+ *
+ * Every RTC starts 5 s off with a frequency error from -150 to 150 ppm, with or without a
+ * random walk of the frequency, and advances in 10 s steps. The divider correction is
+ * applied in steps of 6667 ppb, dithered on the hour event as in user_ctss.c. References
+ * with 100 ms of jitter arrive 2 to 48 hours apart for 90 days, then stop for 30 days.
+ * The RTC must stay within 0.2 s of the true time once three references have been taken,
+ * and, without the random walk, drift by less than 0.05 s per day after the references
+ * stop. clk_discipline_to_ms()
+ * is compared with a day by day count from 1970 over its whole range. The exit status is
+ * non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "user_clk_discipline.h"
+
+#define STEP_PPB                (6667)
+#define REF_DAYS                (90)
+#define FREE_DAYS               (30)
+#define MAX_ERR_S               (0.2)
+#define MAX_DRIFT_S_PER_DAY     (0.05)
+
+static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+static double urand(void)
+{
+    return rand() / (double)RAND_MAX;
+}
+
+static bool is_leap(int year)
+{
+    return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+}
+
+/// Reference ms since 1970-01-01 by counting days
+static int64_t count_ms(int year, int month, int mday, int hour, int minute, int sec, int msec)
+{
+    int64_t days = 0;
+    int y, m;
+
+    for (y = 1970; y < year; y++)
+    {
+        days += is_leap(y) ? 366 : 365;
+    }
+    for (y = year; y < 1970; y++)
+    {
+        days -= is_leap(y) ? 366 : 365;
+    }
+    for (m = 1; m < month; m++)
+    {
+        days += days_in_month[m - 1] + ((m == 2) && is_leap(year));
+    }
+    days += mday - 1;
+
+    return ((days * 24 + hour) * 60 + minute) * 60000LL + sec * 1000 + msec;
+}
+
+/// Runs one RTC, returns the largest offset with references and the drift after them
+static void run(double ppm, double wander, int seed, bool verbose, double *max_err, double *free_err)
+{
+    struct clk_discipline cd = {0};
+    double y = ppm * 1e-6;
+    double e = 5.0;                 // RTC minus true time, in s
+    double next_ref = 3600, next_hour = 3600, slew_end = -1;
+    int32_t steps = 0;
+    int refs = 0;
+    double t;
+
+    srand(seed);
+    *max_err = 0;
+    *free_err = 0;
+
+    for (t = 0; t < 86400.0 * (REF_DAYS + FREE_DAYS); t += 10)
+    {
+        y += wander * (urand() - 0.5);
+        e += (y - steps * STEP_PPB * 1e-9) * 10;
+
+        if (t >= next_hour)
+        {
+            next_hour += 3600;
+            steps = clk_discipline_steps(&cd, STEP_PPB, true);
+        }
+        if ((slew_end > 0) && (t >= slew_end))
+        {
+            slew_end = -1;
+            clk_discipline_slew_done(&cd);
+            steps = clk_discipline_steps(&cd, STEP_PPB, false);
+        }
+
+        if (t < 86400.0 * REF_DAYS)
+        {
+            if ((refs >= 3) && (fabs(e) > *max_err))
+            {
+                *max_err = fabs(e);
+            }
+        }
+        else if (fabs(e) > *free_err)
+        {
+            *free_err = fabs(e);
+        }
+
+        if ((t >= next_ref) && (t < 86400.0 * REF_DAYS))
+        {
+            // CTS gives 1/256 s, the RTC 10 ms
+            double ref = floor((t + (urand() - 0.5) * 0.1) * 256) / 256;
+            int64_t ref_ms = (int64_t)llround(ref * 1000) + 1000000000LL;
+            int64_t local_ms = (int64_t)floor((t + e) * 100) * 10 + 1000000000LL;
+            enum clk_disc_action action = clk_discipline_update(&cd, ref_ms, local_ms);
+
+            if (action == CLK_DISC_STEP)
+            {
+                e = ref - t + ((t + e) * 100 - floor((t + e) * 100)) / 100;
+                slew_end = -1;
+            }
+            if (action == CLK_DISC_SLEW)
+            {
+                slew_end = t + cd.slew_s;
+            }
+            if (action != CLK_DISC_NONE)
+            {
+                steps = clk_discipline_steps(&cd, STEP_PPB, false);
+            }
+            if (verbose)
+            {
+                printf("  t %7.1f h action %d offset %+.3f s correction %d ppb\n", t / 3600, action, e, cd.freq_ppb);
+            }
+            refs++;
+            next_ref = t + 3600 * (2 + 46 * urand());
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const double ppms[] = {-150, -80, -20, 0, 20, 80, 150};
+    bool verbose = (argc > 1) && (argv[1][0] == '-') && (argv[1][1] == 'v');
+    uint32_t fails = 0, dates = 0;
+    int64_t ms;
+    int year, month, mday;
+    uint32_t i;
+    int w, seed;
+
+    for (i = 0; i < sizeof(ppms) / sizeof(ppms[0]); i++)
+    {
+        for (w = 0; w < 2; w++)
+        {
+            for (seed = 1; seed <= 3; seed++)
+            {
+                double max_err, free_err;
+                bool ok;
+
+                run(ppms[i], w ? 2e-9 : 0, seed, verbose, &max_err, &free_err);
+                // The drift bound holds for a stable frequency, a wandering one moves on its own
+                ok = (max_err < MAX_ERR_S) && (w || (free_err / FREE_DAYS < MAX_DRIFT_S_PER_DAY));
+                printf("%+4.0f ppm wander %g seed %d: max offset %.3f s, %.3f s/day without references%s\n",
+                       ppms[i], w ? 2e-9 : 0, seed, max_err, free_err / FREE_DAYS, ok ? "" : "  FAILED");
+                fails += !ok;
+            }
+        }
+    }
+
+    for (year = 1900; year <= 2999; year++)
+    {
+        for (month = 1; month <= 12; month++)
+        {
+            for (mday = 1; mday <= 31; mday++)
+            {
+                bool valid = (mday <= days_in_month[month - 1] + ((month == 2) && is_leap(year)));
+
+                if (clk_discipline_to_ms(year, month, mday, 23, 59, 59, 999, &ms) != valid)
+                {
+                    printf("%04d-%02d-%02d accepted %d\n", year, month, mday, !valid);
+                    fails++;
+                }
+                else if (valid && (ms != count_ms(year, month, mday, 23, 59, 59, 999)))
+                {
+                    printf("%04d-%02d-%02d converted to %lld\n", year, month, mday, (long long)ms);
+                    fails++;
+                }
+                dates += valid;
+            }
+        }
+    }
+    if (clk_discipline_to_ms(1899, 12, 31, 0, 0, 0, 0, &ms) || clk_discipline_to_ms(3000, 1, 1, 0, 0, 0, 0, &ms) ||
+        clk_discipline_to_ms(2024, 1, 1, 24, 0, 0, 0, &ms) || clk_discipline_to_ms(2024, 1, 1, 0, 60, 0, 0, &ms) ||
+        clk_discipline_to_ms(2024, 1, 1, 0, 0, 60, 0, &ms) || clk_discipline_to_ms(2024, 1, 1, 0, 0, 0, 1000, &ms))
+    {
+        printf("out of range time accepted\n");
+        fails++;
+    }
+    printf("%u dates converted\n", dates);
+
+    printf("%s\n", fails ? "FAILED" : "OK");
+
+    return fails ? 1 : 0;
+}
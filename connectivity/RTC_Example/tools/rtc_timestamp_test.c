@@ -0,0 +1,200 @@
+/**
+ ****************************************************************************************
+ *
+ * @file rtc_timestamp_test.c
+ *
+ * @brief Host test of the RTC timestamps.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs user_rtc_timestamp.c on a host:
+ *
+ *     gcc -O2 -Isrc -o rtc_timestamp_test tools/rtc_timestamp_test.c src/user_rtc_timestamp.c
+ *     ./rtc_timestamp_test
+ *
+ * The RTC registers are built from dates over 1900 to 2999 and times in both hour modes.
+ * The timestamps are compared with a day by day count from 1970, converted back to fields
+ * and to a timestamp again. The monotonic time must not jump when the RTC is set, also
+ * when the new entry switches the hour mode. The time per rtc_timestamp_get() call is
+ * printed. The exit status is non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "user_rtc_timestamp.h"
+
+static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+static bool is_leap(int year)
+{
+    return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+}
+
+static int64_t count_days(int year, int month, int mday)
+{
+    int64_t days = mday - 1;
+    int y, m;
+
+    for (y = 1970; y < year; y++)
+    {
+        days += is_leap(y) ? 366 : 365;
+    }
+    for (y = year; y < 1970; y++)
+    {
+        days -= is_leap(y) ? 366 : 365;
+    }
+    for (m = 1; m < month; m++)
+    {
+        days += days_in_month[m - 1] + ((m == 2) && is_leap(year));
+    }
+    return days;
+}
+
+static uint32_t bcd(uint32_t val)
+{
+    return ((val / 10) << 4) | (val % 10);
+}
+
+/// RTC_TIME_REG for a 24H time, in the given hour mode
+static uint32_t time_reg(int hour, int minute, int sec, int hsec, bool hour_12)
+{
+    uint32_t pm = 0;
+
+    if (hour_12)
+    {
+        pm = (hour >= 12);
+        hour = (hour % 12) ? (hour % 12) : 12;
+    }
+    return (bcd(hour) << RTC_TS_TIME_HR_U) | (pm << RTC_TS_TIME_PM) | (bcd(minute) << RTC_TS_TIME_M_U) |
+           (bcd(sec) << RTC_TS_TIME_S_U) | (bcd(hsec) << RTC_TS_TIME_H_U) | 0x80000000UL;
+}
+
+static uint32_t cal_reg(int year, int month, int mday, int wday)
+{
+    return ((uint32_t)(year / 1000) << RTC_TS_CAL_C_T) | ((uint32_t)((year / 100) % 10) << RTC_TS_CAL_C_U) |
+           (bcd(year % 100) << RTC_TS_CAL_Y_U) | (bcd(mday) << RTC_TS_CAL_D_U) |
+           ((uint32_t)(month / 10) << RTC_TS_CAL_M_T) | ((uint32_t)(month % 10) << RTC_TS_CAL_M_U) |
+           ((uint32_t)wday << RTC_TS_CAL_WD);
+}
+
+#define CHECK(cond) do { if (!(cond)) { printf("check failed, line %d: %s\n", __LINE__, #cond); fails++; } } while (0)
+
+int main(void)
+{
+    struct rtc_timestamp ts;
+    struct rtc_ts_fields fields;
+    uint32_t fails = 0, dates = 0;
+    int64_t ms, back, before;
+    uint64_t mono;
+    int year, month, mday;
+    struct timespec t0, t1;
+    volatile int64_t sink = 0;
+    uint32_t i, cal;
+
+    srand(1);
+    ts.anchor_valid = false;
+
+    for (year = 1900; year <= 2999; year++)
+    {
+        for (month = 1; month <= 12; month++)
+        {
+            for (mday = 1; mday <= days_in_month[month - 1] + ((month == 2) && is_leap(year)); mday++)
+            {
+                int64_t days = count_days(year, month, mday);
+                int hour = rand() % 24, minute = rand() % 60, sec = rand() % 60, hsec = rand() % 100;
+                bool hour_12 = rand() & 1;
+                int64_t expected = (((days * 24 + hour) * 60 + minute) * 60 + sec) * 1000 + hsec * 10;
+
+                // Only a sample of the days runs the full round trip
+                if ((mday != 1) && (mday != 28) && (mday != 29) && (rand() % 16))
+                {
+                    continue;
+                }
+                dates++;
+
+                rtc_timestamp_hour_mode(&ts, hour_12);
+                ms = rtc_timestamp_get(&ts, time_reg(hour, minute, sec, hsec, hour_12), cal_reg(year, month, mday, 1));
+                if (ms != expected)
+                {
+                    printf("%04d-%02d-%02d %02d:%02d:%02d.%02d %s: %lld, expected %lld\n", year, month, mday, hour,
+                           minute, sec, hsec, hour_12 ? "12H" : "24H", (long long)ms, (long long)expected);
+                    fails++;
+                    continue;
+                }
+
+                rtc_timestamp_to_fields(ms, hour_12, &fields);
+                CHECK((fields.year == year) && (fields.month == month) && (fields.mday == mday));
+                // 1970-01-01 was a Thursday
+                CHECK(fields.wday == ((days % 7) + 10) % 7 + 1);
+                CHECK(rtc_timestamp_from_fields(&fields, hour_12, &back) && (back == ms));
+            }
+        }
+    }
+
+    // The 12H hours around noon and midnight
+    rtc_timestamp_init(&ts, true, 0, cal_reg(2024, 3, 31, 7));
+    CHECK(rtc_timestamp_get(&ts, time_reg(0, 30, 0, 0, true), cal_reg(2024, 3, 31, 7)) % 86400000 == 30 * 60000);
+    CHECK(rtc_timestamp_get(&ts, time_reg(12, 30, 0, 0, true), cal_reg(2024, 3, 31, 7)) % 86400000 == 750 * 60000);
+    CHECK(rtc_timestamp_get(&ts, time_reg(23, 59, 59, 99, true), cal_reg(2024, 3, 31, 7)) % 86400000 == 86399990);
+
+    // Setting the RTC back an hour keeps the monotonic time
+    cal = cal_reg(2024, 3, 31, 7);
+    rtc_timestamp_init(&ts, false, time_reg(13, 5, 0, 0, false), cal);
+    ms = rtc_timestamp_get(&ts, time_reg(13, 6, 0, 0, false), cal);
+    CHECK(rtc_timestamp_mono(&ts, ms) == 60000);
+    rtc_timestamp_set(&ts, ms, rtc_timestamp_get(&ts, time_reg(12, 6, 0, 0, false), cal));
+    CHECK(rtc_timestamp_mono(&ts, rtc_timestamp_get(&ts, time_reg(12, 7, 0, 0, false), cal)) == 120000);
+
+    // A time entry in 12H mode, the same time as 01:07 PM
+    before = rtc_timestamp_get(&ts, time_reg(12, 7, 0, 0, false), cal);
+    mono = rtc_timestamp_mono(&ts, before);
+    rtc_timestamp_hour_mode(&ts, true);
+    ms = rtc_timestamp_get(&ts, time_reg(12, 7, 0, 0, true), cal);
+    CHECK(ms == before);
+    rtc_timestamp_set(&ts, before, ms);
+    CHECK(rtc_timestamp_mono(&ts, rtc_timestamp_get(&ts, time_reg(12, 8, 0, 0, true), cal)) == mono + 60000);
+    rtc_timestamp_to_fields(ms, true, &fields);
+    CHECK((fields.hour == 12) && fields.pm && (fields.minute == 7));
+
+    // Read in the stale 24H mode, 12:07 PM would have been taken as 12:07 and 01:07 PM as 01:07
+    rtc_timestamp_hour_mode(&ts, false);
+    CHECK(rtc_timestamp_get(&ts, time_reg(13, 7, 0, 0, true), cal) != before + 3600000);
+    rtc_timestamp_hour_mode(&ts, true);
+    CHECK(rtc_timestamp_get(&ts, time_reg(13, 7, 0, 0, true), cal) == before + 3600000);
+
+    // Cost of a reading on the same day
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < 50000000; i++)
+    {
+        sink += rtc_timestamp_get(&ts, i & RTC_TS_TIME_MASK & 0x5F7F7F99, cal);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    printf("%u dates, %.1f ns per rtc_timestamp_get()\n", dates,
+           ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / i);
+    printf("%s\n", fails ? "FAILED" : "OK");
+
+    return fails ? 1 : 0;
+}
@@ -84,12 +84,21 @@
 /****************************************************************************************************************/
 #define CFG_DEVELOPMENT_DEBUG
 
+/****************************************************************************************************************/
+/* Binary scan report export. If CFG_SCAN_EXPORT_BINARY is defined, advertising reports are framed and          */
+/* streamed over UART2 in batches instead of being decoded with arch_printf. UART2 is owned by the exporter in  */
+/* this mode, so the console print is disabled.                                                                 */
+/****************************************************************************************************************/
+#undef CFG_SCAN_EXPORT_BINARY
+
 /****************************************************************************************************************/
 /* UART Console Print. If CFG_PRINTF is defined, serial interface logging mechanism will be enabled.            */
 /* If CFG_PRINTF_UART2 is defined, then serial interface logging mechanism is implented using UART2, else UART1 */
 /* will be used.                                                                                                */
 /****************************************************************************************************************/
+#ifndef CFG_SCAN_EXPORT_BINARY
 #define CFG_PRINTF
+#endif
 #ifdef CFG_PRINTF
     #define CFG_PRINTF_UART2
 #endif
@@ -116,7 +125,11 @@
 /*     - I2C                                                                                                    */
 /*     - ADC                                                                                                    */
 /****************************************************************************************************************/
+#ifdef CFG_SCAN_EXPORT_BINARY
+#define CFG_UART_DMA_SUPPORT
+#else
 #undef CFG_UART_DMA_SUPPORT
+#endif
 #undef CFG_SPI_DMA_SUPPORT
 #undef CFG_I2C_DMA_SUPPORT
 /****************************************************************************************************************/
@@ -63,7 +63,11 @@
 #endif
 
 // Define UART2 Settings
+#if defined (CFG_SCAN_EXPORT_BINARY)
+#define UART2_BAUDRATE              UART_BAUDRATE_1000000
+#else
 #define UART2_BAUDRATE              UART_BAUDRATE_115200
+#endif
 #define UART2_DATABITS              UART_DATABITS_8
 #define UART2_PARITY                UART_PARITY_NONE
 #define UART2_STOPBITS              UART_STOPBITS_1
@@ -43,6 +43,7 @@
 #include "gpio.h"
 #include "uart.h"
 #include "syscntl.h"
+#include "user_scan_export.h"
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -58,7 +59,7 @@ void GPIO_reservations(void)
     RESERVE_GPIO(DESCRIPTIVE_NAME, GPIO_PORT_0, GPIO_PIN_1, PID_GPIO);
 */
 
-#if defined (CFG_PRINTF_UART2)
+#if defined (CFG_PRINTF_UART2) || defined (CFG_SCAN_EXPORT_BINARY)
     RESERVE_GPIO(UART2_TX, UART2_TX_PORT, UART2_TX_PIN, PID_UART2_TX);
 #endif
 
@@ -84,14 +85,14 @@ void set_pad_functions(void)
     GPIO_ConfigurePin(SPI_EN_PORT, SPI_EN_PIN, OUTPUT, PID_SPI_EN, true);
 #endif
 
-#if defined (CFG_PRINTF_UART2)
+#if defined (CFG_PRINTF_UART2) || defined (CFG_SCAN_EXPORT_BINARY)
     // Configure UART2 TX Pad
     GPIO_ConfigurePin(UART2_TX_PORT, UART2_TX_PIN, OUTPUT, PID_UART2_TX, false);
 #endif
 
 }
 
-#if defined (CFG_PRINTF_UART2)
+#if defined (CFG_PRINTF_UART2) || defined (CFG_SCAN_EXPORT_BINARY)
 // Configuration struct for UART2
 static const uart_cfg_t uart_cfg = {
     .baud_rate = UART2_BAUDRATE,
@@ -103,6 +104,10 @@ static const uart_cfg_t uart_cfg = {
     .tx_fifo_tr_lvl = UART2_TX_FIFO_LEVEL,
     .rx_fifo_tr_lvl = UART2_RX_FIFO_LEVEL,
     .intr_priority = 2,
+#if defined (CFG_UART_DMA_SUPPORT)
+    .uart_dma_channel = UART_DMA_CHANNEL_01,
+    .uart_dma_priority = DMA_PRIO_0,
+#endif
 };
 #endif
 
@@ -122,11 +127,15 @@ void periph_init(void)
     patch_func();
 
     // Initialize peripherals
-#if defined (CFG_PRINTF_UART2)
+#if defined (CFG_PRINTF_UART2) || defined (CFG_SCAN_EXPORT_BINARY)
     // Initialize UART2
     uart_initialize(UART2, &uart_cfg);
 #endif
 
+#if defined (CFG_SCAN_EXPORT_BINARY)
+    uart_register_tx_cb(UART2, user_scan_export_tx_cb);
+#endif
+
     // Set pad functionality
     set_pad_functions();
 
@@ -43,6 +43,7 @@
  */
 
 #include "user_active_scanner.h"
+#include "user_scan_export.h"
 
 /*
  * FUNCTION DEFINITIONS
@@ -92,6 +93,10 @@ void user_app_on_init(void)
 
     // Set sleep mode
     arch_set_sleep_mode(app_default_sleep_mode);
+
+#if defined (CFG_SCAN_EXPORT_BINARY)
+    user_scan_export_init();
+#endif
   
 }
 
@@ -148,16 +153,23 @@ void user_scan_start(void)
  */
 void user_on_scan_complete(const uint8_t param){
     arch_printf( "SCAN COMPLETE\r\n");
+#if defined (CFG_SCAN_EXPORT_BINARY)
+    user_scan_export_flush();
+#endif
 		user_scan_start();
 }
 
 /**
  ****************************************************************************************
- * @brief Advertising report function. Decode and display most popular advertising field
+ * @brief Advertising report function. Decode and display most popular advertising field,
+ *        or hand the raw report to the binary exporter if CFG_SCAN_EXPORT_BINARY is defined
  * @return void
  ****************************************************************************************
  */
 void user_adv_report_ind (struct gapm_adv_report_ind const * param ) {
+#if defined (CFG_SCAN_EXPORT_BINARY)
+	user_scan_export_report(&param->report);
+#else
 	uint8_t ad_len,index=0;
 	
 	// report the bluetooth device address
@@ -215,7 +227,7 @@ void user_adv_report_ind (struct gapm_adv_report_ind const * param ) {
 		arch_printf( "\r\n");
 		index += ad_len + 1;
 	} 
-    
+#endif
 }
 
 
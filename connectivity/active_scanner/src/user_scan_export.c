@@ -0,0 +1,528 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_scan_export.c
+ *
+ * @brief Binary advertising report export over UART source code.
+ *
+ * Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+#include "rwip_config.h"             // SW configuration
+
+#if defined (CFG_SCAN_EXPORT_BINARY)
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "arch.h"
+#include "arch_api.h"
+#include "app_easy_timer.h"
+#include "ea.h"
+#include "uart.h"
+#include "user_scan_export.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// HCI LE Advertising Report event type of a scan response
+#define SCAN_EXPORT_EVT_SCAN_RSP        (0x04)
+
+#if defined (CFG_UART_DMA_SUPPORT)
+    #define SCAN_EXPORT_UART_OP         UART_OP_DMA
+#else
+    #define SCAN_EXPORT_UART_OP         UART_OP_INTR
+#endif
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Scannable advertising report waiting for its scan response
+struct scan_export_pending
+{
+    /// Entry holds a report
+    bool in_use;
+    /// Advertising report event type
+    uint8_t evt_type;
+    /// Advertiser address type
+    uint8_t addr_type;
+    /// Received signal strength
+    int8_t rssi;
+    /// Reception time in half slots
+    uint32_t timestamp;
+    /// Advertiser address
+    struct bd_addr addr;
+    /// Advertising data length
+    uint8_t data_len;
+    /// Advertising data
+    uint8_t data[ADV_DATA_LEN];
+};
+
+/// Rate limiter slot
+struct scan_export_rate_slot
+{
+    /// Slot holds an address
+    bool in_use;
+    /// Tracked address
+    struct bd_addr addr;
+    /// Time of the last exported frame in half slots
+    uint32_t last_time;
+};
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint8_t ring_buf[SCAN_EXPORT_RING_SIZE]                      __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static volatile uint16_t ring_head                                  __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static volatile uint16_t ring_tail                                  __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static volatile uint16_t tx_len                                     __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+
+static struct scan_export_pending pending[SCAN_EXPORT_PENDING_MAX]  __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static struct scan_export_rate_slot rate_slots[SCAN_EXPORT_RATE_SLOTS] __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static struct scan_export_stats export_stats                        __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static timer_hnd flush_timer                                        __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Get the current BLE time.
+ * @return Time in half slots
+ ****************************************************************************************
+ */
+static uint32_t scan_export_time(void)
+{
+    return (ea_time_get_halfslot_rounded() & SCAN_EXPORT_TIMESTAMP_MASK);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Elapsed time between two timestamps, wraparound safe.
+ * @return Elapsed time in half slots
+ ****************************************************************************************
+ */
+static uint32_t scan_export_elapsed(uint32_t from, uint32_t to)
+{
+    return ((to - from) & SCAN_EXPORT_TIMESTAMP_MASK);
+}
+
+static uint16_t ring_used(void)
+{
+    return (uint16_t)((ring_head + SCAN_EXPORT_RING_SIZE - ring_tail) % SCAN_EXPORT_RING_SIZE);
+}
+
+static uint16_t ring_free(void)
+{
+    return (SCAN_EXPORT_RING_SIZE - 1) - ring_used();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Append bytes to the ring buffer. The caller has checked the free space.
+ * @param[in] data      Bytes to append
+ * @param[in] len       Number of bytes
+ * @param[in,out] chk   Running XOR checksum
+ * @return void
+ ****************************************************************************************
+ */
+static void ring_put(const uint8_t *data, uint8_t len, uint8_t *chk)
+{
+    uint16_t head = ring_head;
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        ring_buf[head] = data[i];
+        *chk ^= data[i];
+        head = (head + 1) % SCAN_EXPORT_RING_SIZE;
+    }
+
+    ring_head = head;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start the transfer of the next contiguous chunk of the ring buffer.
+ * @return true if a transfer was started, false if a transfer is ongoing or no data
+ ****************************************************************************************
+ */
+static bool scan_export_start_tx(void)
+{
+    uint16_t len = 0;
+    uint16_t tail;
+
+    GLOBAL_INT_DISABLE();
+    tail = ring_tail;
+    if ((tx_len == 0) && (ring_head != tail))
+    {
+        len = ((ring_head > tail) ? ring_head : SCAN_EXPORT_RING_SIZE) - tail;
+        tx_len = len;
+    }
+    GLOBAL_INT_RESTORE();
+
+    if (len == 0)
+    {
+        return false;
+    }
+
+    export_stats.batches++;
+    uart_send(UART2, &ring_buf[tail], len, SCAN_EXPORT_UART_OP);
+
+    return true;
+}
+
+void user_scan_export_tx_cb(uint16_t length)
+{
+    ring_tail = (ring_tail + tx_len) % SCAN_EXPORT_RING_SIZE;
+    tx_len = 0;
+
+    // Keep streaming while data is queued, otherwise the system may sleep again
+    if (!scan_export_start_tx())
+    {
+        arch_restore_sleep_mode();
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Start a batch transfer if none is ongoing.
+ * @return void
+ ****************************************************************************************
+ */
+static void scan_export_kick(void)
+{
+    if (scan_export_start_tx())
+    {
+        // Keep the UART powered until the transfer completes
+        arch_force_active_mode();
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Write one frame to the ring buffer.
+ * @param[in] entry     Advertising report
+ * @param[in] rsp       Coalesced scan response, NULL if none
+ * @return void
+ ****************************************************************************************
+ */
+static void scan_export_write_frame(struct scan_export_pending const *entry, struct adv_report const *rsp)
+{
+    uint8_t hdr[14];
+    uint8_t len = sizeof(hdr) + entry->data_len + ((rsp != NULL) ? (1 + rsp->data_len) : 0);
+    uint8_t chk = 0;
+    uint8_t sync[2] = {SCAN_EXPORT_SYNC_0, SCAN_EXPORT_SYNC_1};
+
+    // Sync, len and checksum bytes come on top of len
+    if (ring_free() < (uint16_t)(len + 4))
+    {
+        export_stats.overflows++;
+        return;
+    }
+
+    hdr[0] = ((rsp != NULL) ? SCAN_EXPORT_FLAG_SCAN_RSP : 0) |
+             ((entry->addr_type != ADDR_PUBLIC) ? SCAN_EXPORT_FLAG_ADDR_RANDOM : 0);
+    hdr[1] = entry->evt_type;
+    memcpy(&hdr[2], entry->addr.addr, BD_ADDR_LEN);
+    hdr[8] = (uint8_t)entry->rssi;
+    hdr[9] = (uint8_t)(entry->timestamp);
+    hdr[10] = (uint8_t)(entry->timestamp >> 8);
+    hdr[11] = (uint8_t)(entry->timestamp >> 16);
+    hdr[12] = (uint8_t)(entry->timestamp >> 24);
+    hdr[13] = entry->data_len;
+
+    ring_put(sync, sizeof(sync), &chk);
+    chk = 0;
+    ring_put(&len, 1, &chk);
+    ring_put(hdr, sizeof(hdr), &chk);
+    ring_put(entry->data, entry->data_len, &chk);
+    if (rsp != NULL)
+    {
+        ring_put(&rsp->data_len, 1, &chk);
+        ring_put(rsp->data, rsp->data_len, &chk);
+        export_stats.coalesced++;
+    }
+    sync[0] = chk;
+    ring_put(sync, 1, &chk);
+
+    export_stats.frames++;
+
+    if (ring_used() >= SCAN_EXPORT_BATCH_BYTES)
+    {
+        scan_export_kick();
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Copy an advertising report into a pending entry.
+ * @return void
+ ****************************************************************************************
+ */
+static void scan_export_fill(struct scan_export_pending *entry, struct adv_report const *report, uint32_t now)
+{
+    entry->evt_type = report->evt_type;
+    entry->addr_type = report->adv_addr_type;
+    entry->rssi = report->rssi;
+    entry->timestamp = now;
+    entry->addr = report->adv_addr;
+    entry->data_len = (report->data_len > ADV_DATA_LEN) ? ADV_DATA_LEN : report->data_len;
+    memcpy(entry->data, report->data, entry->data_len);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Check the rate limiter and record the export time of an address.
+ * @param[in] addr      Advertiser address
+ * @param[in] now       Current time in half slots
+ * @return true if the report must be dropped
+ ****************************************************************************************
+ */
+static bool scan_export_rate_limited(struct bd_addr const *addr, uint32_t now)
+{
+    struct scan_export_rate_slot *victim = &rate_slots[0];
+    uint32_t victim_age = 0;
+
+    for (uint8_t i = 0; i < SCAN_EXPORT_RATE_SLOTS; i++)
+    {
+        struct scan_export_rate_slot *slot = &rate_slots[i];
+        uint32_t age;
+
+        if (!slot->in_use)
+        {
+            victim = slot;
+            victim_age = SCAN_EXPORT_TIMESTAMP_MASK;
+            continue;
+        }
+
+        age = scan_export_elapsed(slot->last_time, now);
+
+        if (memcmp(slot->addr.addr, addr->addr, BD_ADDR_LEN) == 0)
+        {
+            if (age < SCAN_EXPORT_MIN_INTERVAL)
+            {
+                export_stats.rate_limited++;
+                return true;
+            }
+            slot->last_time = now;
+            return false;
+        }
+
+        // Replace the least recently exported address
+        if (age > victim_age)
+        {
+            victim = slot;
+            victim_age = age;
+        }
+    }
+
+    victim->in_use = true;
+    victim->addr = *addr;
+    victim->last_time = now;
+
+    return false;
+}
+
+static struct scan_export_pending *scan_export_pending_find(struct bd_addr const *addr)
+{
+    for (uint8_t i = 0; i < SCAN_EXPORT_PENDING_MAX; i++)
+    {
+        if (pending[i].in_use && (memcmp(pending[i].addr.addr, addr->addr, BD_ADDR_LEN) == 0))
+        {
+            return &pending[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Get a free pending entry. If all are in use the oldest one is framed without
+ *        scan response and reused.
+ * @return Pending entry
+ ****************************************************************************************
+ */
+static struct scan_export_pending *scan_export_pending_alloc(uint32_t now)
+{
+    struct scan_export_pending *oldest = &pending[0];
+
+    for (uint8_t i = 0; i < SCAN_EXPORT_PENDING_MAX; i++)
+    {
+        if (!pending[i].in_use)
+        {
+            return &pending[i];
+        }
+        if (scan_export_elapsed(pending[i].timestamp, now) > scan_export_elapsed(oldest->timestamp, now))
+        {
+            oldest = &pending[i];
+        }
+    }
+
+    scan_export_write_frame(oldest, NULL);
+    oldest->in_use = false;
+
+    return oldest;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Frame the pending reports whose scan response did not arrive in time.
+ * @param[in] now       Current time in half slots
+ * @param[in] all       Frame every pending report regardless of its age
+ * @return Number of reports still pending
+ ****************************************************************************************
+ */
+static uint8_t scan_export_pending_expire(uint32_t now, bool all)
+{
+    uint8_t remaining = 0;
+
+    for (uint8_t i = 0; i < SCAN_EXPORT_PENDING_MAX; i++)
+    {
+        if (!pending[i].in_use)
+        {
+            continue;
+        }
+
+        if (all || (scan_export_elapsed(pending[i].timestamp, now) >= SCAN_EXPORT_PENDING_TIMEOUT))
+        {
+            scan_export_write_frame(&pending[i], NULL);
+            pending[i].in_use = false;
+        }
+        else
+        {
+            remaining++;
+        }
+    }
+
+    return remaining;
+}
+
+static void scan_export_flush_timer_cb(void)
+{
+    flush_timer = EASY_TIMER_INVALID_TIMER;
+
+    if (scan_export_pending_expire(scan_export_time(), false) != 0)
+    {
+        flush_timer = app_easy_timer(SCAN_EXPORT_FLUSH_TIMEOUT, scan_export_flush_timer_cb);
+    }
+
+    scan_export_kick();
+}
+
+void user_scan_export_init(void)
+{
+    ring_head = 0;
+    ring_tail = 0;
+    tx_len = 0;
+    memset(pending, 0, sizeof(pending));
+    memset(rate_slots, 0, sizeof(rate_slots));
+    memset(&export_stats, 0, sizeof(export_stats));
+    flush_timer = EASY_TIMER_INVALID_TIMER;
+}
+
+void user_scan_export_report(struct adv_report const *report)
+{
+    uint32_t now = scan_export_time();
+    struct scan_export_pending *entry;
+
+    scan_export_pending_expire(now, false);
+
+    if (report->evt_type == SCAN_EXPORT_EVT_SCAN_RSP)
+    {
+        entry = scan_export_pending_find(&report->adv_addr);
+        if (entry != NULL)
+        {
+            // The advertising report already passed the rate limiter
+            scan_export_write_frame(entry, report);
+            entry->in_use = false;
+            return;
+        }
+    }
+
+    if (scan_export_rate_limited(&report->adv_addr, now))
+    {
+        return;
+    }
+
+    if ((report->evt_type == ADV_CONN_UNDIR) || (report->evt_type == ADV_DISC_UNDIR))
+    {
+        // Scannable report, hold it until its scan response arrives
+        entry = scan_export_pending_find(&report->adv_addr);
+        if (entry != NULL)
+        {
+            scan_export_write_frame(entry, NULL);
+        }
+        else
+        {
+            entry = scan_export_pending_alloc(now);
+        }
+        scan_export_fill(entry, report, now);
+        entry->in_use = true;
+    }
+    else
+    {
+        struct scan_export_pending single;
+
+        scan_export_fill(&single, report, now);
+        scan_export_write_frame(&single, NULL);
+    }
+
+    if (flush_timer == EASY_TIMER_INVALID_TIMER)
+    {
+        flush_timer = app_easy_timer(SCAN_EXPORT_FLUSH_TIMEOUT, scan_export_flush_timer_cb);
+    }
+}
+
+void user_scan_export_flush(void)
+{
+    scan_export_pending_expire(scan_export_time(), true);
+    scan_export_kick();
+}
+
+struct scan_export_stats const *user_scan_export_get_stats(void)
+{
+    return &export_stats;
+}
+
+#endif // CFG_SCAN_EXPORT_BINARY
+
+/// @} APP
@@ -0,0 +1,182 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_scan_export.h
+ *
+ * @brief Binary advertising report export over UART header file.
+ *
+ * Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_SCAN_EXPORT_H_
+#define _USER_SCAN_EXPORT_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @ingroup RICOW
+ *
+ * @brief Binary scan report export.
+ *
+ * Advertising reports are framed into a byte ring buffer and flushed over UART2 in
+ * batches (DMA on DA1453x, interrupt driven on DA14585/586). A scan response is merged
+ * into the frame of the advertising report it belongs to, and a per-address rate limiter
+ * drops reports of devices that were exported less than SCAN_EXPORT_MIN_INTERVAL ago.
+ *
+ * Frame layout (multi-byte fields are little endian):
+ *
+ *   | sync (2) | len (1) | flags (1) | evt_type (1) | addr (6) | rssi (1) | timestamp (4) |
+ *   | adv_len (1) | adv_data (adv_len) | [rsp_len (1) | rsp_data (rsp_len)] | checksum (1) |
+ *
+ * len counts the bytes from flags up to the last data byte. The rsp fields are present
+ * only when SCAN_EXPORT_FLAG_SCAN_RSP is set. The timestamp is the BLE time in half slots
+ * (312.5us) and wraps at SCAN_EXPORT_TIMESTAMP_MASK. The checksum is the XOR of the len
+ * byte and all bytes it counts.
+ *
+ * tools/scan_export_to_pcap.py converts the stream to a pcap file for Wireshark.
+ *
+ * @{
+ ****************************************************************************************
+ */
+
+#if defined (CFG_SCAN_EXPORT_BINARY)
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gapm_task.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Frame synchronization word
+#define SCAN_EXPORT_SYNC_0              (0xA5)
+#define SCAN_EXPORT_SYNC_1              (0x5A)
+
+/// Frame flags
+#define SCAN_EXPORT_FLAG_SCAN_RSP       (0x01)  // Frame carries a coalesced scan response
+#define SCAN_EXPORT_FLAG_ADDR_RANDOM    (0x02)  // Advertiser address is random
+
+/// Timestamp wraparound mask (27-bit half slot counter)
+#define SCAN_EXPORT_TIMESTAMP_MASK      (0x07FFFFFF)
+
+/// Size of the transmit ring buffer in bytes
+#define SCAN_EXPORT_RING_SIZE           (1024)
+
+/// Number of buffered bytes that triggers a batch transfer
+#define SCAN_EXPORT_BATCH_BYTES         (256)
+
+/// Maximum time data stays buffered before a partial batch is sent (in 10ms units)
+#define SCAN_EXPORT_FLUSH_TIMEOUT       (5)
+
+/// Number of advertising reports waiting for their scan response
+#define SCAN_EXPORT_PENDING_MAX         (4)
+
+/// Time a scannable report waits for its scan response (in half slots, ~20ms)
+#define SCAN_EXPORT_PENDING_TIMEOUT     (64)
+
+/// Number of addresses tracked by the rate limiter
+#define SCAN_EXPORT_RATE_SLOTS          (16)
+
+/// Minimum time between two exported frames of the same address (in half slots, ~100ms)
+#define SCAN_EXPORT_MIN_INTERVAL        (320)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Export statistics
+struct scan_export_stats
+{
+    /// Frames written to the ring buffer
+    uint32_t frames;
+    /// Frames carrying a coalesced scan response
+    uint32_t coalesced;
+    /// Reports dropped by the rate limiter
+    uint32_t rate_limited;
+    /// Frames dropped because the ring buffer was full
+    uint32_t overflows;
+    /// Batch transfers started
+    uint32_t batches;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Initialize the exporter.
+ * @return void
+ ****************************************************************************************
+ */
+void user_scan_export_init(void);
+
+/**
+ ****************************************************************************************
+ * @brief UART2 transmit complete callback. Registered by periph_init() since the UART
+ *        is re-initialized on every wakeup. Runs in interrupt context.
+ * @param[in] length    Number of bytes sent
+ * @return void
+ ****************************************************************************************
+ */
+void user_scan_export_tx_cb(uint16_t length);
+
+/**
+ ****************************************************************************************
+ * @brief Feed an advertising report to the exporter.
+ * @param[in] report    Advertising report as received in GAPM_ADV_REPORT_IND
+ * @return void
+ ****************************************************************************************
+ */
+void user_scan_export_report(struct adv_report const *report);
+
+/**
+ ****************************************************************************************
+ * @brief Frame all pending reports and start the transfer of the buffered data.
+ * @return void
+ ****************************************************************************************
+ */
+void user_scan_export_flush(void);
+
+/**
+ ****************************************************************************************
+ * @brief Get the export statistics.
+ * @return Pointer to the statistics
+ ****************************************************************************************
+ */
+struct scan_export_stats const *user_scan_export_get_stats(void);
+
+#endif // CFG_SCAN_EXPORT_BINARY
+
+/// @} APP
+
+#endif // _USER_SCAN_EXPORT_H_
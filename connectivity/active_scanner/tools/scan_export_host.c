@@ -0,0 +1,168 @@
+/**
+ ****************************************************************************************
+ *
+ * @file scan_export_host.c
+ *
+ * @brief Host driver of the binary scan report exporter.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Replays synthetic advertising reports through user_scan_export.c and writes the UART
+ * stream it produces to a file. Used by scan_export_test.py, which builds and runs it:
+ *
+ *     gcc -O2 -DCFG_SCAN_EXPORT_BINARY -I../../helpers/host_stub -Isrc -o scan_export_host tools/scan_export_host.c \
+ *         src/user_scan_export.c
+ *     ./scan_export_host <reports> <stream file>
+ *
+ * The advertising data of a report is derived from the advertiser address, so that the
+ * decoder can check every frame. The statistics of the exporter and the time spent in
+ * it are printed as key=value lines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_stub.h"
+#include "user_scan_export.h"
+
+/// Advertisers in the synthetic traffic
+#define DEVICES                         (40)
+
+/// BLE time between two reports, in half slots
+#define REPORT_SPACING                  (50)
+
+static uint32_t ble_time;
+static FILE *out;
+static const uint8_t *tx_data;
+static uint16_t tx_len;
+static bool tx_busy;
+
+uint32_t ea_time_get_halfslot_rounded(void)
+{
+    return ble_time;
+}
+
+void uart_send(int uart, const uint8_t *data, uint16_t len, int op)
+{
+    tx_data = data;
+    tx_len = len;
+    tx_busy = true;
+}
+
+timer_hnd app_easy_timer(uint32_t delay, void (*cb)(void))
+{
+    return 1;
+}
+
+void arch_force_active_mode(void)
+{
+}
+
+void arch_restore_sleep_mode(void)
+{
+}
+
+/// Completes the transfers in progress, as the UART interrupt would
+static void drain(void)
+{
+    while (tx_busy)
+    {
+        tx_busy = false;
+        fwrite(tx_data, 1, tx_len, out);
+        user_scan_export_tx_cb(tx_len);
+    }
+}
+
+/// Data of a report: length and content follow from the address and the event type
+static void fill_data(struct adv_report *r)
+{
+    uint8_t seed = r->adv_addr.addr[0] + ((r->evt_type == 0x04) ? 0x80 : 0);
+    uint8_t k;
+
+    r->data_len = seed % (ADV_DATA_LEN + 1);
+    for (k = 0; k < r->data_len; k++)
+    {
+        r->data[k] = (uint8_t)(seed + k);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const struct scan_export_stats *stats;
+    struct adv_report r;
+    uint32_t reports;
+    uint32_t i;
+    clock_t start;
+    double elapsed;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <reports> <stream file>\n", argv[0]);
+        return 2;
+    }
+    reports = strtoul(argv[1], NULL, 0);
+    out = fopen(argv[2], "wb");
+    if (out == NULL)
+    {
+        perror(argv[2]);
+        return 2;
+    }
+
+    // Start close to the wraparound of the BLE time
+    ble_time = SCAN_EXPORT_TIMESTAMP_MASK - 1000;
+    user_scan_export_init();
+
+    start = clock();
+    for (i = 0; i < reports; i++)
+    {
+        memset(&r, 0, sizeof(r));
+        // Every third report is the scan response of the previous connectable one
+        r.evt_type = (i % 3 == 0) ? 0x00 : ((i % 3 == 1) ? 0x04 : 0x03);
+        r.adv_addr.addr[0] = (uint8_t)((i / 3) % DEVICES);
+        r.adv_addr.addr[5] = 0xC0;
+        r.adv_addr_type = r.adv_addr.addr[0] & 1;
+        r.rssi = (int8_t)(-40 - (int)(i % 50));
+        fill_data(&r);
+
+        ble_time = (ble_time + REPORT_SPACING) & SCAN_EXPORT_TIMESTAMP_MASK;
+        user_scan_export_report(&r);
+        drain();
+    }
+    user_scan_export_flush();
+    drain();
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    fclose(out);
+
+    stats = user_scan_export_get_stats();
+    printf("reports=%u\n", reports);
+    printf("frames=%u\n", stats->frames);
+    printf("coalesced=%u\n", stats->coalesced);
+    printf("rate_limited=%u\n", stats->rate_limited);
+    printf("overflows=%u\n", stats->overflows);
+    printf("batches=%u\n", stats->batches);
+    printf("host_ns_per_report=%.1f\n", elapsed * 1e9 / reports);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: scan_export_test.py
+#
+# @brief    :: Throughput test of the binary scan report export on the host.
+#
+#              Builds scan_export_host.c with user_scan_export.c, replays synthetic
+#              advertising reports through the framer and decodes the stream with
+#              scan_export_to_pcap.py. Every frame is checked against the generated
+#              reports, then the frame size and the report rate the UART can carry are
+#              printed:
+#                  python3 scan_export_test.py
+#                  python3 scan_export_test.py --reports 100000 --baudrate 2000000
+#
+#              Needs gcc. The exit status is non-zero if a check fails.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import io
+import os
+import subprocess
+import sys
+import tempfile
+
+import scan_export_to_pcap as pcap
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+EXAMPLE = os.path.dirname(TOOLS)
+STUB = os.path.join(EXAMPLE, '..', '..', 'helpers', 'host_stub')
+
+ADV_DATA_LEN = 31
+EVT_SCAN_RSP = 0x04
+EVT_NONCONN = 0x03
+
+# Bits per byte on the UART, 8N1
+UART_BITS = 10
+
+
+def expected_data(addr0, scan_rsp):
+    seed = (addr0 + (0x80 if scan_rsp else 0)) & 0xFF
+    return bytes((seed + k) & 0xFF for k in range(seed % (ADV_DATA_LEN + 1)))
+
+
+def build(tmp):
+    exe = os.path.join(tmp, 'scan_export_host')
+    subprocess.check_call(['gcc', '-O2', '-DCFG_SCAN_EXPORT_BINARY', '-I' + STUB, '-I' + os.path.join(EXAMPLE, 'src'),
+                           '-o', exe, os.path.join(TOOLS, 'scan_export_host.c'),
+                           os.path.join(EXAMPLE, 'src', 'user_scan_export.c')])
+    return exe
+
+
+def check(frames, stats):
+    errors = []
+    if len(frames) != stats['frames']:
+        errors.append('%d frames decoded, %d exported' % (len(frames), stats['frames']))
+    if sum(1 for f in frames if f.rsp_data is not None) != stats['coalesced']:
+        errors.append('coalesced frame count differs')
+    if stats['frames'] + stats['rate_limited'] + stats['overflows'] + stats['coalesced'] != stats['reports']:
+        errors.append('reports are not all accounted for')
+    for n, f in enumerate(frames):
+        if f.adv_data != expected_data(f.addr[0], False):
+            errors.append('frame %d: advertising data differs' % n)
+        if f.rsp_data is not None and f.rsp_data != expected_data(f.addr[0], True):
+            errors.append('frame %d: scan response data differs' % n)
+        if f.rsp_data is not None and f.evt_type == EVT_NONCONN:
+            errors.append('frame %d: scan response merged into a non-connectable report' % n)
+        if bool(f.flags & pcap.FLAG_ADDR_RANDOM) != bool(f.addr[0] & 1):
+            errors.append('frame %d: address type differs' % n)
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Replay synthetic scan reports through the exporter.')
+    parser.add_argument('--reports', type=int, default=30000, help='reports to replay')
+    parser.add_argument('--baudrate', type=int, default=1000000, help='UART baud rate of the estimate')
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = build(tmp)
+        stream = os.path.join(tmp, 'stream.bin')
+        out = subprocess.check_output([exe, str(args.reports), stream], universal_newlines=True)
+        stats = {}
+        for line in out.split():
+            key, value = line.split('=')
+            stats[key] = float(value) if '.' in value else int(value)
+        with open(stream, 'rb') as f:
+            data = f.read()
+
+    decoder = pcap.Decoder()
+    frames = []
+    # Feed in odd sized chunks, as a serial port would deliver the data
+    for pos in range(0, len(data), 61):
+        frames += decoder.feed(data[pos:pos + 61])
+
+    errors = check(frames, stats)
+    if decoder.errors:
+        errors.append('%d framing errors' % decoder.errors)
+
+    # The pcap writer must accept every frame, coalesced frames give two packets
+    writer = pcap.PcapWriter(io.BytesIO())
+    for f in frames:
+        writer.write(f)
+
+    frame_bytes = len(data) / max(1, len(frames))
+    frames_per_sec = args.baudrate / UART_BITS / frame_bytes
+    print('%d reports -> %d frames (%d with scan response), %d rate limited, %d overflows, %d batches'
+          % (stats['reports'], stats['frames'], stats['coalesced'], stats['rate_limited'],
+             stats['overflows'], stats['batches']))
+    print('%.1f bytes per frame, %.0f frames/s (%.0f reports/s) at %d baud'
+          % (frame_bytes, frames_per_sec, frames_per_sec * (len(frames) + stats['coalesced']) / len(frames),
+             args.baudrate))
+    print('framer %.0f ns per report on the host' % stats['host_ns_per_report'])
+
+    for e in errors:
+        print('FAIL: ' + e)
+    if errors:
+        sys.exit(1)
+    print('OK')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: scan_export_to_pcap.py
+#
+# @brief    :: Converts the binary scan report stream of the active_scanner example
+#              (CFG_SCAN_EXPORT_BINARY) to a pcap file with link type
+#              LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR, which Wireshark decodes natively.
+#
+#              The input is either a serial port or a file holding a raw capture of it:
+#                  python3 scan_export_to_pcap.py /dev/ttyUSB0 scans.pcap
+#                  python3 scan_export_to_pcap.py capture.bin scans.pcap
+#              Use "-" as output to stream to stdout, e.g. into "wireshark -k -i -".
+#
+#              The frame format is described in src/user_scan_export.h. A frame with a
+#              coalesced scan response produces two packets with the same timestamp.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import os
+import struct
+import sys
+import termios
+import tty
+
+SYNC = b'\xA5\x5A'
+FLAG_SCAN_RSP = 0x01
+FLAG_ADDR_RANDOM = 0x02
+TIMESTAMP_MASK = 0x07FFFFFF
+HALF_SLOT_US = 312.5
+
+LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR = 256
+ADV_ACCESS_ADDRESS = 0x8E89BED6
+
+# PHDR flags: dewhitened, signal power valid, reference access address valid
+PHDR_FLAGS = 0x0001 | 0x0002 | 0x0010
+
+# HCI advertising report event type -> advertising channel PDU type
+PDU_TYPE = {
+    0x00: 0x0,  # ADV_IND
+    0x01: 0x1,  # ADV_DIRECT_IND
+    0x02: 0x6,  # ADV_SCAN_IND
+    0x03: 0x2,  # ADV_NONCONN_IND
+    0x04: 0x4,  # SCAN_RSP
+}
+PDU_SCAN_RSP = 0x4
+
+
+class Frame(object):
+    def __init__(self, flags, evt_type, addr, rssi, timestamp, adv_data, rsp_data):
+        self.flags = flags
+        self.evt_type = evt_type
+        self.addr = addr
+        self.rssi = rssi
+        self.timestamp = timestamp
+        self.adv_data = adv_data
+        self.rsp_data = rsp_data
+
+
+class Decoder(object):
+    '''Incremental decoder, resynchronizes on the sync word after a corrupted frame.'''
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.frames = 0
+        self.errors = 0
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                # Keep a trailing partial sync byte
+                del self.buf[:max(0, len(self.buf) - 1)]
+                return out
+            del self.buf[:start]
+            if len(self.buf) < 3:
+                return out
+            length = self.buf[2]
+            if len(self.buf) < 3 + length + 1:
+                return out
+            body = bytes(self.buf[2:3 + length])
+            chk = 0
+            for b in body:
+                chk ^= b
+            frame = self._parse(body[1:]) if chk == self.buf[3 + length] else None
+            if frame is None:
+                self.errors += 1
+                del self.buf[:1]
+                continue
+            del self.buf[:3 + length + 1]
+            self.frames += 1
+            out.append(frame)
+
+    @staticmethod
+    def _parse(body):
+        if len(body) < 14:
+            return None
+        flags, evt_type = body[0], body[1]
+        addr = body[2:8]
+        rssi = struct.unpack('<b', body[8:9])[0]
+        timestamp = struct.unpack('<I', body[9:13])[0]
+        adv_len = body[13]
+        pos = 14 + adv_len
+        if pos > len(body):
+            return None
+        adv_data = body[14:pos]
+        rsp_data = None
+        if flags & FLAG_SCAN_RSP:
+            if pos >= len(body):
+                return None
+            rsp_len = body[pos]
+            if pos + 1 + rsp_len != len(body):
+                return None
+            rsp_data = body[pos + 1:]
+        elif pos != len(body):
+            return None
+        return Frame(flags, evt_type, addr, rssi, timestamp, adv_data, rsp_data)
+
+
+class PcapWriter(object):
+    def __init__(self, stream):
+        self.stream = stream
+        self.last_ts = None
+        self.time_us = 0
+        self.stream.write(struct.pack('<IHHiIII', 0xA1B2C3D4, 2, 4, 0, 0, 0xFFFF,
+                                      LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR))
+
+    def _unwrap(self, ts):
+        # The target counter wraps every ~11.6 hours
+        if self.last_ts is not None:
+            self.time_us += ((ts - self.last_ts) & TIMESTAMP_MASK) * HALF_SLOT_US
+        self.last_ts = ts
+        return int(self.time_us)
+
+    def _packet(self, time_us, pdu_type, tx_add, addr, rssi, data):
+        header = pdu_type | (tx_add << 6)
+        pdu = struct.pack('<BB', header, 6 + len(data)) + addr + data
+        # The CRC is not exported, the PHDR flags leave it unchecked
+        ll = struct.pack('<I', ADV_ACCESS_ADDRESS) + pdu + b'\x00\x00\x00'
+        phdr = struct.pack('<BbbBIH', 0, rssi, 0, 0, ADV_ACCESS_ADDRESS, PHDR_FLAGS)
+        rec = phdr + ll
+        self.stream.write(struct.pack('<IIII', time_us // 1000000, time_us % 1000000, len(rec), len(rec)))
+        self.stream.write(rec)
+
+    def write(self, frame):
+        time_us = self._unwrap(frame.timestamp)
+        tx_add = 1 if frame.flags & FLAG_ADDR_RANDOM else 0
+        self._packet(time_us, PDU_TYPE.get(frame.evt_type, 0x0), tx_add, frame.addr, frame.rssi, frame.adv_data)
+        if frame.rsp_data is not None:
+            self._packet(time_us, PDU_SCAN_RSP, tx_add, frame.addr, frame.rssi, frame.rsp_data)
+        self.stream.flush()
+
+
+def open_input(path, baudrate):
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        speed = getattr(termios, 'B%d' % baudrate)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert the active_scanner binary export stream to pcap.')
+    parser.add_argument('input', help='serial port or raw capture file')
+    parser.add_argument('output', help='pcap file, "-" for stdout')
+    parser.add_argument('-b', '--baudrate', type=int, default=1000000, help='serial baud rate (default 1000000)')
+    args = parser.parse_args()
+
+    fd = open_input(args.input, args.baudrate)
+    out = sys.stdout.buffer if args.output == '-' else open(args.output, 'wb')
+    decoder = Decoder()
+    writer = PcapWriter(out)
+
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            for frame in decoder.feed(data):
+                writer.write(frame)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+        if out is not sys.stdout.buffer:
+            out.close()
+        sys.stderr.write('%d frames, %d framing errors\n' % (decoder.frames, decoder.errors))
+
+
+if __name__ == '__main__':
+    main()
@@ -62,7 +62,7 @@
 
 #define DEF_SVC1_LONG_VALUE_UUID_128    {0xF3, 0x6B, 0x10, 0x9D, 0x66, 0xF2, 0xA9, 0xA1, 0x12, 0x41, 0x68, 0x38, 0xDB, 0xE5, 0x72, 0x77}
 
-#define DEF_SVC1_LONG_VALUE_CHAR_LEN    20
+#define DEF_SVC1_LONG_VALUE_CHAR_LEN    64
 
 /// Custom1 Service Data Base Characteristic enum
 enum
@@ -36,14 +36,22 @@
 #include "adc.h"
 #include "app.h"
 #include "app_api.h"
+#include "gattc.h"
 #include "gpio.h"
+#include "lld_evt.h"
+#include "reg_blecore.h"
 #include "timer0.h"
 #include "user_midi.h"
+#include "user_midi_packet.h"
 #include "user_custs1_def.h"
 #include "user_custs1_impl.h"
 #include "user_periph_setup.h"
 #include "wkupct_quadec.h"
 
+#if defined (CFG_PRINTF)
+#include "arch_console.h"
+#endif
+
 struct app_proj_env_tag user_app_env __attribute__((section(".bss."))); //@RETENTION MEMORY
 
 
@@ -77,20 +85,8 @@ struct app_proj_env_tag user_app_env __attribute__((section(".bss."))); //@RETEN
 #define		Ai_5 82
 #define		B__5 83
 
-typedef struct
-{
-	uint8_t 	header;
-	uint8_t	timestamp;
-	uint8_t	status;
-	uint8_t	note;
-	uint8_t	velocity;
-}midi_event_packet_t;
-
-typedef union
-{
-	midi_event_packet_t	midi_event;
-	uint8_t payload[5];
-}midi_data_t;
+/* Deadline for queued MIDI events when no connection event flushed them */
+#define MIDI_TX_LATENCY_MAX     (2)     // 2*10ms
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -98,6 +94,10 @@ typedef union
  */
 
 ke_msg_id_t timer_used      __attribute__((section(".bss."))); // @RETENTION MEMORY
+timer_hnd midi_tx_timer     __attribute__((section(".bss."))); // @RETENTION MEMORY
+
+struct midi_packet_tx midi_tx   __attribute__((section(".bss."))); // @RETENTION MEMORY
+struct midi_packet_clock midi_clock __attribute__((section(".bss."))); // @RETENTION MEMORY
 
 /*
  * LOCAL FUNCTIONS DECLARATION
@@ -113,10 +113,11 @@ static void user_app_button_press_cb(void);
  ****************************************************************************************
  */
 
-static uint32_t get_timestamp(void)
+static uint16_t get_timestamp(void)
 {
-    uint32_t timestamp = 0;
-    return timestamp;
+    // BLE time in 625us slots to the 13-bit ms timestamp of BLE-MIDI, continuous across
+    // the wrap of the 27-bit BLE time
+    return midi_packet_clock_update(&midi_clock, lld_evt_time_get(), BLE_BASETIMECNT_MASK);
 }
 
 void send_note(uint8_t *data, uint8_t len)
@@ -128,7 +129,7 @@ void send_note(uint8_t *data, uint8_t len)
                                                           custs1_val_ntf_ind_req,
                                                           len);
 
-    req->conidx = app_env->conidx;
+    req->conidx = app_env[app_connection_idx].conidx;
     req->notification = true;
     req->handle = SVC1_IDX_LONG_VALUE_VAL;
     memcpy(req->value, data, len);
@@ -137,37 +138,90 @@ void send_note(uint8_t *data, uint8_t len)
     ke_msg_send(req);
 }
 
-void midi_note_on(uint8_t note, uint8_t velocity)
+void midi_tx_flush(void)
 {
-	static midi_data_t note_on;
+    uint8_t packet[DEF_SVC1_LONG_VALUE_CHAR_LEN];
+    uint8_t conidx = app_env[app_connection_idx].conidx;
+    uint16_t size;
+    uint8_t len;
+
+    if (midi_tx_timer != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(midi_tx_timer);
+        midi_tx_timer = EASY_TIMER_INVALID_TIMER;
+    }
+
+    if (!midi_tx_pending() || conidx == GAP_INVALID_CONIDX)
+    {
+        return;
+    }
+
+    // ATT_MTU of the connection, less the 3-byte notification header
+    size = gattc_get_mtu(conidx) - 3;
+    if (size > sizeof(packet))
+    {
+        size = sizeof(packet);
+    }
+
+    // As many events per notification as the MTU allows
+    while ((len = midi_packet_pack(&midi_tx, get_timestamp(), packet, size)) > 0)
+    {
+        send_note(packet, len);
+    }
+}
 
-	uint32_t temp = get_timestamp();                              /* Get the timestamp from the CRYOTIMER */
-	temp = temp & 0x00001fff;                                   /* Mask it - only the lower 13 bit needed */
+bool midi_tx_pending(void)
+{
+    return midi_packet_pending(&midi_tx) > 0;
+}
 
-	note_on.midi_event.header 		= 0x80 | (temp >> 7);       /* Header byte = 0b10xxxxxx where xxxxxxx is top 6 bits of timestamp */
-	note_on.midi_event.timestamp 	= 0x80 | (temp & 0x003f);   /* Timestamp byte = 0b1xxxxxxx where xxxxxxx is lower 7 bits of timestamp */
-	note_on.midi_event.status 		= 0x90;                     /* Status byte = 0b1sssnnnn where sss is message type and nnnn is channel */
-	note_on.midi_event.note			= note;                     /* setting the note parameter */
-	note_on.midi_event.velocity		= velocity;                 /* setting the velocity parameter */
+const struct midi_packet_stats *midi_tx_stats(void)
+{
+    return &midi_tx.stats;
+}
 
-	/* sending the assembled midi message */
-	send_note((uint8_t *)&note_on, 5);
+static void midi_tx_timer_cb(void)
+{
+    midi_tx_timer = EASY_TIMER_INVALID_TIMER;
+    midi_tx_flush();
 }
 
-void midi_note_off(uint8_t note, uint8_t velocity)
+/**
+ ****************************************************************************************
+ * @brief Queues a MIDI message. It is sent with the other queued messages at the next
+ *        connection event, or after MIDI_TX_LATENCY_MAX.
+ * @return void
+ ****************************************************************************************
+*/
+static void midi_send(const uint8_t *msg, uint8_t len)
+{
+    uint16_t timestamp = get_timestamp();
+
+    if (!midi_packet_put(&midi_tx, timestamp, msg, len))
+    {
+        // Queue full, make room
+        midi_tx_flush();
+        midi_packet_put(&midi_tx, timestamp, msg, len);
+    }
+
+    if (midi_tx_timer == EASY_TIMER_INVALID_TIMER)
+    {
+        midi_tx_timer = app_easy_timer(MIDI_TX_LATENCY_MAX, midi_tx_timer_cb);
+    }
+}
+
+void midi_note_on(uint8_t note, uint8_t velocity)
 {
-	static midi_data_t note_off;
+    uint8_t msg[3] = {0x90, note, velocity};    /* Status byte = 0b1sssnnnn where sss is message type and nnnn is channel */
 
-	uint32_t temp = get_timestamp();						        /* 1ms timestamp */
-	temp = temp & 0x00001fff;									/* only the lower 13 bit needed */
+    midi_send(msg, sizeof(msg));
+}
 
-	note_off.midi_event.header 		= 0x80 | (temp >> 7); 		/* Header byte = 0b10xxxxxx where xxxxxxx is top 6 bits of timestamp */
-	note_off.midi_event.timestamp 	= 0x80 | (temp & 0x003f);   /* Timestamp byte = 0b1xxxxxxx where xxxxxxx is lower 7 bits of timestamp */
-	note_off.midi_event.status 		= 0x80;						/* Status byte = 0b1sssnnnn where sss is message type and nnnn is channel */
-	note_off.midi_event.note		= note;						/* setting the note parameter */
-	note_off.midi_event.velocity	= velocity;					/* setting the velocity parameter */
+void midi_note_off(uint8_t note, uint8_t velocity)
+{
+    uint8_t msg[3] = {0x80, note, velocity};    /* Status byte = 0b1sssnnnn where sss is message type and nnnn is channel */
 
-	send_note((uint8_t *)&note_off, 5);
+    midi_send(msg, sizeof(msg));
 }
 
 /**
@@ -265,6 +319,9 @@ static void user_app_button_press_cb(void)
 */
 void user_app_enable_periphs(void)
 {
+    midi_tx_timer = EASY_TIMER_INVALID_TIMER;
+    midi_packet_init(&midi_tx);
+
     // Update button state characteristic
     user_app_enable_button();
 }
@@ -278,4 +335,18 @@ void user_app_enable_periphs(void)
 void user_app_disable_periphs(void)
 {
     user_app_disable_button();
+
+    if (midi_tx_timer != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(midi_tx_timer);
+        midi_tx_timer = EASY_TIMER_INVALID_TIMER;
+    }
+
+#if defined (CFG_PRINTF)
+    arch_printf("\r\n MIDI: %u events in %u packets, up to %u per packet, latency up to %u ms",
+                midi_tx.stats.events, midi_tx.stats.packets, midi_tx.stats.max_events, midi_tx.stats.max_latency);
+#endif
+
+    // Events left in the queue have no connection to go to
+    midi_packet_init(&midi_tx);
 }
@@ -50,6 +50,7 @@
 #include "custs1_task.h"
 #include "gapc_task.h"                 // gap functions and messages
 #include "gapm_task.h"                 // gap functions and messages
+#include "user_midi_packet.h"
 
 /*
  * DEFINES
@@ -109,6 +110,32 @@ void user_app_enable_periphs(void);
 */
 void user_app_disable_periphs(void);
 
+/**
+ ****************************************************************************************
+ * @brief Sends the queued MIDI events, packed into as few notifications as the MTU of the
+ *        connection allows. Does nothing when no event is queued or no peer is connected.
+ * @return void
+ ****************************************************************************************
+*/
+void midi_tx_flush(void);
+
+/**
+ ****************************************************************************************
+ * @brief Check for queued MIDI events.
+ * @return true if events are waiting to be sent
+ ****************************************************************************************
+*/
+bool midi_tx_pending(void);
+
+/**
+ ****************************************************************************************
+ * @brief MIDI transmit statistics of the current connection, events per packet and
+ * latency.
+ * @return pointer to the statistics
+ ****************************************************************************************
+*/
+const struct midi_packet_stats *midi_tx_stats(void);
+
 /// @} APP
 
 #endif // _USER_CUSTS1_IMPL_H_
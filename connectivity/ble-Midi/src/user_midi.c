@@ -444,6 +444,17 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
     }
 }
 
+arch_main_loop_callback_ret_t user_app_on_ble_powered(void)
+{
+    // Events queued since the last connection event go out together
+    if (midi_tx_pending())
+    {
+        midi_tx_flush();
+    }
+
+    return GOTO_SLEEP;
+}
+
 void user_app_adv_undirect_complete(const uint8_t status)
 {
     // Disable wakeup for BLE and timer events. Only external (GPIO) wakeup events can wakeup processor.
@@ -77,6 +77,14 @@
 #define APP_SECURITY_OOB_TK_VAL            {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,\
                                             0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f}
 
+/*
+ * GLOBAL VARIABLE DECLARATIONS
+ ****************************************************************************************
+ */
+
+/// Index in app_env[] of the active connection
+extern uint8_t app_connection_idx;
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -142,6 +150,15 @@ void user_app_on_tk_exch(uint8_t conidx,
 */
 void user_app_disconnect(struct gapc_disconnect_ind const *param);
 
+/**
+ ****************************************************************************************
+ * @brief Called in the main loop while BLE is powered, at least once per connection
+ * event. Flushes the queued MIDI events.
+ * @return GOTO_SLEEP
+ ****************************************************************************************
+*/
+arch_main_loop_callback_ret_t user_app_on_ble_powered(void);
+
 /**
  ****************************************************************************************
  * @brief Handles the messages that are not handled by the SDK internal mechanisms.
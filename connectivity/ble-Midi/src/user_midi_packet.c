@@ -0,0 +1,355 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_midi_packet.c
+ *
+ * @brief BLE-MIDI packet encoder and decoder source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "user_midi_packet.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define MIDI_SYSEX_START            (0xF0)
+#define MIDI_SYSEX_END              (0xF7)
+#define MIDI_REAL_TIME              (0xF8)
+
+/// Events of a packet span less than one wrap of the low timestamp bits
+#define MIDI_PACKET_TS_SPAN         (128)
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Number of data bytes that follow a status byte.
+ * @return Data length, -1 for SysEx and undefined status bytes.
+ ****************************************************************************************
+ */
+static int8_t midi_data_len(uint8_t status)
+{
+    if (status < 0xF0)
+    {
+        // Program change and channel pressure have one data byte
+        return ((status & 0xE0) == 0xC0) ? 1 : 2;
+    }
+
+    switch (status)
+    {
+        case 0xF1:
+        case 0xF3:
+            return 1;
+        case 0xF2:
+            return 2;
+        case 0xF6:
+        case 0xF8:
+        case 0xFA:
+        case 0xFB:
+        case 0xFC:
+        case 0xFE:
+        case 0xFF:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+void midi_packet_init(struct midi_packet_tx *tx)
+{
+    memset(tx, 0, sizeof(struct midi_packet_tx));
+}
+
+bool midi_packet_put(struct midi_packet_tx *tx, uint16_t ts, const uint8_t *msg, uint8_t len)
+{
+    struct midi_packet_event *ev;
+    uint8_t i;
+
+    if ((len == 0) || !(msg[0] & 0x80) || (midi_data_len(msg[0]) != len - 1))
+    {
+        return false;
+    }
+
+    for (i = 1; i < len; i++)
+    {
+        if (msg[i] & 0x80)
+        {
+            return false;
+        }
+    }
+
+    if (tx->count == MIDI_PACKET_QUEUE_LEN)
+    {
+        tx->stats.dropped++;
+        return false;
+    }
+
+    ev = &tx->queue[(tx->head + tx->count) % MIDI_PACKET_QUEUE_LEN];
+    ev->ts = ts & MIDI_PACKET_TS_MASK;
+    ev->len = len;
+    memcpy(ev->msg, msg, len);
+    tx->count++;
+
+    return true;
+}
+
+uint8_t midi_packet_pending(const struct midi_packet_tx *tx)
+{
+    return tx->count;
+}
+
+uint8_t midi_packet_pack(struct midi_packet_tx *tx, uint16_t now, uint8_t *buf, uint8_t size)
+{
+    const struct midi_packet_event *ev;
+    uint16_t first_ts, last_ts = 0;
+    uint16_t latency;
+    uint8_t running = 0;
+    uint8_t pos = 1;
+    uint8_t events = 0;
+
+    if (tx->count == 0)
+    {
+        return 0;
+    }
+
+    first_ts = tx->queue[tx->head].ts;
+    buf[0] = 0x80 | (first_ts >> 7);
+
+    while (tx->count > 0)
+    {
+        bool same_status, same_ts;
+        uint8_t need;
+
+        ev = &tx->queue[tx->head];
+        if (((ev->ts - first_ts) & MIDI_PACKET_TS_MASK) >= MIDI_PACKET_TS_SPAN)
+        {
+            break;
+        }
+
+        // Real-time and system messages are always sent with their status
+        same_status = (events > 0) && (ev->msg[0] == running);
+        same_ts = (events > 0) && (ev->ts == last_ts);
+
+        need = ev->len - 1;
+        if (!same_status)
+        {
+            need += 2;
+        }
+        else if (!same_ts)
+        {
+            need += 1;
+        }
+
+        if (pos + need > size)
+        {
+            break;
+        }
+
+        if (!same_status || !same_ts)
+        {
+            buf[pos++] = 0x80 | (ev->ts & 0x7F);
+        }
+        if (!same_status)
+        {
+            buf[pos++] = ev->msg[0];
+        }
+        memcpy(&buf[pos], &ev->msg[1], ev->len - 1);
+        pos += ev->len - 1;
+
+        // Real-time messages leave the running status as it is, the others cancel it
+        if (ev->msg[0] < 0xF0)
+        {
+            running = ev->msg[0];
+        }
+        else if (ev->msg[0] < MIDI_REAL_TIME)
+        {
+            running = 0;
+        }
+        last_ts = ev->ts;
+
+        latency = (now - ev->ts) & MIDI_PACKET_TS_MASK;
+        if (latency > tx->stats.max_latency)
+        {
+            tx->stats.max_latency = latency;
+        }
+
+        tx->head = (tx->head + 1) % MIDI_PACKET_QUEUE_LEN;
+        tx->count--;
+        events++;
+    }
+
+    tx->stats.packets++;
+    tx->stats.events += events;
+    if (events > tx->stats.max_events)
+    {
+        tx->stats.max_events = events;
+    }
+
+    return pos;
+}
+
+uint16_t midi_packet_clock_update(struct midi_packet_clock *clk, uint32_t slots, uint32_t mask)
+{
+    // A slot is 5/8 ms, less than 2^30 eighths for a 27-bit BLE time
+    uint32_t eighths = ((slots - clk->slots) & mask) * 5 + clk->rem;
+
+    clk->slots = slots;
+    clk->ms += eighths >> 3;
+    clk->rem = eighths & 7;
+
+    return clk->ms & MIDI_PACKET_TS_MASK;
+}
+
+int midi_packet_decode(const uint8_t *buf, uint8_t len, midi_packet_msg_cb_t cb, void *ctx)
+{
+    uint8_t msg[3];
+    uint8_t high, low = 0;
+    uint8_t running = 0;
+    uint8_t i = 1;
+    bool have_ts = false;
+    int count = 0;
+
+    // The header carries the top timestamp bits and must be followed by a timestamp
+    if ((len < 3) || ((buf[0] & 0xC0) != 0x80) || !(buf[1] & 0x80))
+    {
+        return -1;
+    }
+    high = buf[0] & 0x3F;
+
+    while (i < len)
+    {
+        int8_t data_len;
+        uint8_t status;
+
+        if (buf[i] & 0x80)
+        {
+            // Timestamp, the top bits are incremented when the low bits wrap
+            if (have_ts && ((buf[i] & 0x7F) < low))
+            {
+                high = (high + 1) & 0x3F;
+            }
+            low = buf[i++] & 0x7F;
+            have_ts = true;
+
+            if (i == len)
+            {
+                return -1;
+            }
+        }
+        else if (!have_ts)
+        {
+            return -1;
+        }
+
+        if (buf[i] & 0x80)
+        {
+            status = buf[i++];
+
+            if (status == MIDI_SYSEX_START)
+            {
+                uint8_t start = i - 1;
+
+                while ((i < len) && !(buf[i] & 0x80))
+                {
+                    i++;
+                }
+                if ((i + 1 >= len) || (buf[i + 1] != MIDI_SYSEX_END))
+                {
+                    return -1;
+                }
+                cb(ctx, (high << 7) | low, &buf[start], i - start);
+                count++;
+
+                // The timestamp of F7 belongs to the packet timeline
+                if ((buf[i] & 0x7F) < low)
+                {
+                    high = (high + 1) & 0x3F;
+                }
+                low = buf[i] & 0x7F;
+                i += 2;
+                running = 0;
+                continue;
+            }
+
+            if (status < 0xF0)
+            {
+                running = status;
+            }
+            else if (status < MIDI_REAL_TIME)
+            {
+                running = 0;
+            }
+        }
+        else
+        {
+            // Running status, with a new timestamp or the previous one
+            if (running == 0)
+            {
+                return -1;
+            }
+            status = running;
+        }
+
+        data_len = midi_data_len(status);
+        if ((data_len < 0) || (i + data_len > len))
+        {
+            return -1;
+        }
+
+        msg[0] = status;
+        for (uint8_t d = 0; d < data_len; d++)
+        {
+            if (buf[i] & 0x80)
+            {
+                return -1;
+            }
+            msg[1 + d] = buf[i++];
+        }
+
+        cb(ctx, (high << 7) | low, msg, 1 + data_len);
+        count++;
+    }
+
+    return count;
+}
+
+/// @} APP
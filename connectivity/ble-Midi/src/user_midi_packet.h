@@ -0,0 +1,210 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_midi_packet.h
+ *
+ * @brief BLE-MIDI packet encoder and decoder header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_MIDI_PACKET_H_
+#define _USER_MIDI_PACKET_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * MIDI events are queued with a 13-bit millisecond timestamp and packed into BLE-MIDI
+ * packets as they fit:
+ *
+ *   packet  = header event [event ...]
+ *   header  = 10hh hhhh                 top 6 bits of the timestamp
+ *   event   = 1lll llll status data     low 7 bits of the timestamp
+ *           | 1lll llll data            running status, new timestamp
+ *           | data                      running status, same timestamp
+ *
+ * The status byte is left out when it repeats the previous channel message of the
+ * packet, and the timestamp byte too when the timestamp is also the same, so a chord
+ * costs two bytes per extra note. Running status does not carry across packets. The
+ * receiver increments the top bits when the low bits wrap, so the events of a packet
+ * span less than 128 ms.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Events waiting to be packed
+#define MIDI_PACKET_QUEUE_LEN       (32)
+
+/// Timestamps are 13 bits of milliseconds
+#define MIDI_PACKET_TS_MASK         (0x1FFF)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct midi_packet_event
+{
+    uint16_t ts;
+    uint8_t len;
+    uint8_t msg[3];
+};
+
+/// Transmit statistics
+struct midi_packet_stats
+{
+    /// Packets built
+    uint32_t packets;
+    /// Events packed
+    uint32_t events;
+    /// Most events in one packet
+    uint8_t max_events;
+    /// Longest time an event waited in the queue, in ms
+    uint16_t max_latency;
+    /// Events dropped because the queue was full
+    uint16_t dropped;
+};
+
+/// Millisecond clock derived from the BLE time
+struct midi_packet_clock
+{
+    /// BLE time of the last update, in 625 us slots
+    uint32_t slots;
+    /// Milliseconds counted since the first update
+    uint32_t ms;
+    /// Eighths of a millisecond not counted in ms yet
+    uint8_t rem;
+};
+
+/// Transmit queue
+struct midi_packet_tx
+{
+    struct midi_packet_event queue[MIDI_PACKET_QUEUE_LEN];
+    uint8_t head;
+    uint8_t count;
+    struct midi_packet_stats stats;
+};
+
+/**
+ ****************************************************************************************
+ * @brief Called by midi_packet_decode() for each MIDI message of a packet.
+ * @param[in] ctx       Context given to midi_packet_decode().
+ * @param[in] ts        13-bit timestamp of the message.
+ * @param[in] msg       Message, with the status byte restored for running status.
+ * @param[in] len       Message length.
+ ****************************************************************************************
+ */
+typedef void (*midi_packet_msg_cb_t)(void *ctx, uint16_t ts, const uint8_t *msg, uint8_t len);
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Empties the queue and clears the statistics.
+ * @param[in] tx        Transmit queue.
+ ****************************************************************************************
+ */
+void midi_packet_init(struct midi_packet_tx *tx);
+
+/**
+ ****************************************************************************************
+ * @brief Queues a MIDI message. SysEx is not supported.
+ * @param[in] tx        Transmit queue.
+ * @param[in] ts        Timestamp in ms, only the low 13 bits are used.
+ * @param[in] msg       Channel, system common or real-time message.
+ * @param[in] len       Message length, 1 to 3 bytes.
+ * @return False if the message is not valid or the queue is full.
+ ****************************************************************************************
+ */
+bool midi_packet_put(struct midi_packet_tx *tx, uint16_t ts, const uint8_t *msg, uint8_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the number of queued events.
+ ****************************************************************************************
+ */
+uint8_t midi_packet_pending(const struct midi_packet_tx *tx);
+
+/**
+ ****************************************************************************************
+ * @brief Packs queued events into a packet, oldest first, as many as fit.
+ * @param[in] tx        Transmit queue.
+ * @param[in] now       Current timestamp in ms, for the latency statistics.
+ * @param[out] buf      Packet.
+ * @param[in] size      Largest packet, at least 5 bytes.
+ * @return Packet length, 0 if the queue is empty.
+ ****************************************************************************************
+ */
+uint8_t midi_packet_pack(struct midi_packet_tx *tx, uint16_t now, uint8_t *buf, uint8_t size);
+
+/**
+ ****************************************************************************************
+ * @brief Advances the millisecond clock to the current BLE time. The BLE time wraps, so
+ *        only the slots elapsed since the previous update are counted: the clock keeps
+ *        running across the wrap if it is updated at least once per wrap period.
+ * @param[in] clk       Clock, all zero before the first update.
+ * @param[in] slots     BLE time in 625 us slots.
+ * @param[in] mask      Mask of the BLE time counter.
+ * @return 13-bit timestamp in ms.
+ ****************************************************************************************
+ */
+uint16_t midi_packet_clock_update(struct midi_packet_clock *clk, uint32_t slots, uint32_t mask);
+
+/**
+ ****************************************************************************************
+ * @brief Decodes a BLE-MIDI packet. A SysEx message that starts and ends in the packet
+ *        is reported from F0 up to, not including, the timestamp of the closing F7.
+ *        SysEx split over packets, or interleaved with real-time messages, is rejected.
+ * @param[in] buf       Packet.
+ * @param[in] len       Packet length.
+ * @param[in] cb        Called for each message.
+ * @param[in] ctx       Passed to cb.
+ * @return Number of messages, -1 if the packet does not follow the grammar.
+ ****************************************************************************************
+ */
+int midi_packet_decode(const uint8_t *buf, uint8_t len, midi_packet_msg_cb_t cb, void *ctx);
+
+/// @} APP
+
+#endif // _USER_MIDI_PACKET_H_
@@ -0,0 +1,322 @@
+/**
+ ****************************************************************************************
+ *
+ * @file midi_packet_test.c
+ *
+ * @brief Host test of the BLE-MIDI packet encoder and decoder.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc -o midi_packet_test tools/midi_packet_test.c src/user_midi_packet.c
+ *   ./midi_packet_test
+ *
+ * Checks that random event streams come back unchanged from midi_packet_decode() for any
+ * packet size, that packets breaking the BLE-MIDI grammar are rejected, that the 13-bit
+ * timestamp wraps, that the millisecond clock runs on across the wrap of the 27-bit BLE
+ * time, and that packing a note stream once per 15 ms connection event keeps
+ * every event within one connection interval.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "user_midi_packet.h"
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+struct rec
+{
+    uint16_t ts;
+    uint8_t len;
+    uint8_t msg[3];
+};
+
+static struct rec got[256];
+static int ngot;
+
+static void on_msg(void *ctx, uint16_t ts, const uint8_t *msg, uint8_t len)
+{
+    (void)ctx;
+    if (ngot < (int)(sizeof(got) / sizeof(got[0])) && len <= sizeof(got[0].msg))
+    {
+        got[ngot].ts = ts;
+        got[ngot].len = len;
+        memcpy(got[ngot].msg, msg, len);
+    }
+    ngot++;
+}
+
+static int rnd(int n)
+{
+    return rand() % n;
+}
+
+static uint8_t data_len(uint8_t status)
+{
+    if (status < 0xF0)
+    {
+        return ((status & 0xE0) == 0xC0) ? 1 : 2;
+    }
+    return (status == 0xF2) ? 2 : (status == 0xF1 || status == 0xF3) ? 1 : 0;
+}
+
+static void test_roundtrip(void)
+{
+    static const uint8_t status[] = {0x90, 0x80, 0xB0, 0xC0, 0xD0, 0xE0, 0xA0,
+                                     0xF8, 0xFE, 0xF2, 0xF3, 0xF6, 0xF1};
+    struct midi_packet_tx tx;
+    long events = 0, bad = 0;
+    int trial;
+
+    srand(1);
+    for (trial = 0; trial < 20000; trial++)
+    {
+        struct rec sent[MIDI_PACKET_QUEUE_LEN];
+        uint16_t ts = rnd(8192);
+        int n = 1 + rnd(40), ns = 0, k;
+        uint8_t buf[256];
+
+        midi_packet_init(&tx);
+        ngot = 0;
+        for (k = 0; k < n; k++)
+        {
+            uint8_t m[3];
+            uint8_t d, dl;
+
+            if (rnd(3))
+            {
+                ts = (ts + rnd(rnd(2) ? 3 : 200)) & 0x1FFF;
+            }
+            m[0] = (ns && rnd(2)) ? sent[ns - 1].msg[0] : status[rnd(sizeof(status))];
+            if (m[0] < 0xF0 && rnd(2))
+            {
+                m[0] |= rnd(16);
+            }
+            dl = data_len(m[0]);
+            for (d = 0; d < dl; d++)
+            {
+                m[1 + d] = rnd(128);
+            }
+            if (midi_packet_put(&tx, ts, m, dl + 1))
+            {
+                sent[ns].ts = ts;
+                sent[ns].len = dl + 1;
+                memcpy(sent[ns].msg, m, dl + 1);
+                ns++;
+            }
+        }
+
+        while (midi_packet_pending(&tx))
+        {
+            uint8_t size = 5 + rnd(rnd(2) ? 20 : 240);
+            uint8_t len = midi_packet_pack(&tx, ts, buf, size);
+
+            if (len < 3 || len > size || midi_packet_decode(buf, len, on_msg, NULL) < 0)
+            {
+                bad++;
+                break;
+            }
+        }
+
+        events += ns;
+        if (ngot != ns)
+        {
+            bad++;
+            continue;
+        }
+        for (k = 0; k < ns; k++)
+        {
+            if (got[k].ts != sent[k].ts || got[k].len != sent[k].len ||
+                memcmp(got[k].msg, sent[k].msg, sent[k].len))
+            {
+                bad++;
+                break;
+            }
+        }
+    }
+    printf("roundtrip: %ld events, %ld bad trials\n", events, bad);
+    CHECK(bad == 0);
+}
+
+static void test_grammar(void)
+{
+    static const uint8_t no_ts[] = {0x80, 0x00, 0x90};
+    static const uint8_t no_running[] = {0x80, 0x81, 0x3C, 0x40};
+    static const uint8_t sysex[] = {0x80, 0x81, 0xF0, 0x01, 0x02, 0x82, 0xF7};
+    static const uint8_t bad_header[] = {0xC0, 0x81, 0xF8};
+    static const uint8_t wrap[] = {0xA0, 0xFF, 0x90, 0x3C, 0x40, 0x85, 0x3E, 0x40};
+
+    CHECK(midi_packet_decode(no_ts, sizeof(no_ts), on_msg, NULL) == -1);
+    CHECK(midi_packet_decode(no_running, sizeof(no_running), on_msg, NULL) == -1);
+    CHECK(midi_packet_decode(bad_header, sizeof(bad_header), on_msg, NULL) == -1);
+    ngot = 0;
+    CHECK(midi_packet_decode(sysex, sizeof(sysex), on_msg, NULL) == 1);
+    ngot = 0;
+    CHECK(midi_packet_decode(wrap, sizeof(wrap), on_msg, NULL) == 2);
+    CHECK(got[0].ts == 0x107F && got[1].ts == 0x1085);
+}
+
+/*
+ * One minute of a four-note chord every 250 ms and a 16th-note arpeggio, with one
+ * notification per 15 ms connection event. size 5 sends one event per notification.
+ */
+static void stream(uint8_t size, long *events, long *packets, double *mean, int *max)
+{
+    struct midi_packet_tx tx;
+    double lat = 0;
+    int t, k;
+
+    midi_packet_init(&tx);
+    *events = *packets = 0;
+    *max = 0;
+    for (t = 0; t < 60000; t++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            uint8_t on[3] = {0x90, 60 + k * 4, 100}, off[3] = {0x80, 60 + k * 4, 0};
+
+            if (t % 250 == 0)
+            {
+                midi_packet_put(&tx, t, on, 3);
+            }
+            if (t % 250 == 200)
+            {
+                midi_packet_put(&tx, t, off, 3);
+            }
+        }
+        if (t % 62 == 0 || t % 62 == 31)
+        {
+            uint8_t m[3] = {(t % 62) ? 0x80 : 0x90, 72 + (t / 62) % 8, (t % 62) ? 0 : 90};
+            midi_packet_put(&tx, t, m, 3);
+        }
+        if (t % 15 == 0 && midi_packet_pending(&tx))
+        {
+            uint8_t buf[64];
+            uint32_t before = tx.stats.events;
+            uint8_t head = tx.head;
+            uint32_t n;
+
+            midi_packet_pack(&tx, t, buf, size);
+            n = tx.stats.events - before;
+            for (k = 0; k < (int)n; k++)
+            {
+                int l = (t - tx.queue[(head + k) % MIDI_PACKET_QUEUE_LEN].ts) & 0x1FFF;
+
+                lat += l;
+                if (l > *max)
+                {
+                    *max = l;
+                }
+            }
+            *events += n;
+            (*packets)++;
+        }
+    }
+    CHECK(tx.stats.dropped == 0);
+    *mean = lat / *events;
+}
+
+// BLE time counter of 625 us slots, BLE_BASETIMECNT_MASK of the SDK
+#define BLE_TIME_MASK (0x07FFFFFF)
+
+static void test_clock(void)
+{
+    struct midi_packet_clock clk = {0};
+    // Start 10 s before the BLE time wraps
+    uint64_t slots = BLE_TIME_MASK - 16000;
+    uint16_t ts, prev;
+    long steps = 0, back = 0;
+
+    prev = midi_packet_clock_update(&clk, (uint32_t)slots, BLE_TIME_MASK);
+    CHECK(prev == ((slots * 5 / 8) & MIDI_PACKET_TS_MASK));
+
+    // Three wraps in steps from one slot to 40 minutes, short steps around every wrap
+    while (slots < 4ULL * (BLE_TIME_MASK + 1))
+    {
+        bool near_wrap = ((slots + 20000) & BLE_TIME_MASK) < 40000;
+        uint64_t step = (near_wrap || rnd(4)) ? (uint64_t)(1 + rnd(100)) : 1 + ((uint64_t)rnd(1 << 16) << 6);
+
+        slots += step;
+        ts = midi_packet_clock_update(&clk, (uint32_t)slots & BLE_TIME_MASK, BLE_TIME_MASK);
+        // The millisecond count of all the slots since the start of the BLE time
+        CHECK(ts == ((slots * 5 / 8) & MIDI_PACKET_TS_MASK));
+        // and never steps back
+        if (step < 1000 && ((ts - prev) & MIDI_PACKET_TS_MASK) > step)
+        {
+            back++;
+        }
+        prev = ts;
+        steps++;
+    }
+    printf("clock: %ld steps over 3 wraps of the BLE time, %ld steps back\n", steps, back);
+    CHECK(back == 0);
+}
+
+static void test_latency(void)
+{
+    static const uint8_t sizes[] = {5, 20, 61};
+    long events, packets;
+    double mean;
+    int max;
+    unsigned i;
+
+    for (i = 0; i < sizeof(sizes); i++)
+    {
+        stream(sizes[i], &events, &packets, &mean, &max);
+        printf("size %2u: %ld events, %.2f per packet, latency mean %.1f ms, max %d ms\n",
+               sizes[i], events, (double)events / packets, mean, max);
+        if (sizes[i] > 5)
+        {
+            CHECK(max < 15);
+            CHECK(events > packets * 3 / 2);
+        }
+        else
+        {
+            CHECK(events == packets);
+        }
+    }
+}
+
+int main(void)
+{
+    test_roundtrip();
+    test_grammar();
+    test_clock();
+    test_latency();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
@@ -35,7 +35,6 @@
 #include "MCP9808.h"
 #if !defined(CFG_USE_INTERNAL_TEMP_SENSOR)
 #include "i2c.h"
-#include "math.h"
 
 /**
  ****************************************************************************************
@@ -91,7 +90,7 @@ temperature_resolution MCP9808_get_resolution_register(void){
 		//insert error handler
 	}
 	
-	return (temperature_resolution)( buffer[0] & ((unsigned)pow(2,RESOLUTION_CONFIG_REGISTER_SIZE)-1) ); 
+	return (temperature_resolution)( buffer[0] & ((1U << RESOLUTION_CONFIG_REGISTER_SIZE)-1) ); 
 }
 
 /**
@@ -106,22 +105,7 @@ uint16_t MCP9808_read_temperature_register(void){
 		return NULL;
 	}
 
-	uint8_t buffer[2];
-	i2c_abort_t abort_code = I2C_ABORT_NONE;
-		
-	buffer[0] = TEMPERATURE_DATA_REGISTER; 
-	
-	i2c_master_transmit_buffer_sync((uint8_t*)buffer,1,&abort_code,I2C_F_WAIT_FOR_STOP);
-	if(abort_code != I2C_ABORT_NONE) {
-		//insert error handler
-	}
-	
-	i2c_master_receive_buffer_sync((uint8_t*)buffer,sizeof(buffer),&abort_code,I2C_F_WAIT_FOR_STOP);
-	if(abort_code != I2C_ABORT_NONE) {
-		//insert error handler
-	}
-	
-	return ( ((buffer[0]<<8) + buffer[1]) &((unsigned)pow(2,TEMPERATURE_REGISTER_SIZE)-1) ); 
+	return ( MCP9808_read_register(TEMPERATURE_DATA_REGISTER) & ((1U << TEMPERATURE_REGISTER_SIZE)-1) ); 
 }
 
 /**
@@ -146,4 +130,53 @@ double MCP9808_get_temperature(void){
 	return MCP9808_calculate_temperature(MCP9808_read_temperature_register());
 }
 
+/**
+ ****************************************************************************************
+ * @brief 		Reads a 16 bits register with a repeated start between the register pointer
+ *				write and the data read
+ * @param[in]	const uint8_t reg
+ * @return 		uint16_t
+ ****************************************************************************************
+ */
+uint16_t MCP9808_read_register(const uint8_t reg){
+	uint8_t buffer[2];
+	i2c_abort_t abort_code = I2C_ABORT_NONE;
+	
+	buffer[0] = reg;
+	
+	i2c_master_transmit_buffer_sync((uint8_t*)buffer,1,&abort_code,I2C_F_NONE);
+	if(abort_code != I2C_ABORT_NONE) {
+		//insert error handler
+	}
+	
+	i2c_master_receive_buffer_sync((uint8_t*)buffer,sizeof(buffer),&abort_code,I2C_F_ADD_STOP | I2C_F_WAIT_FOR_STOP);
+	if(abort_code != I2C_ABORT_NONE) {
+		//insert error handler
+	}
+	
+	return (uint16_t)((buffer[0]<<8) | buffer[1]);
+}
+
+/**
+ ****************************************************************************************
+ * @brief 		Writes a 16 bits register, most significant byte first
+ * @param[in]	const uint8_t reg
+ * @param[in]	const uint16_t value
+ * @return 		void
+ ****************************************************************************************
+ */
+void MCP9808_write_register(const uint8_t reg, const uint16_t value){
+	uint8_t buffer[3];
+	i2c_abort_t abort_code = I2C_ABORT_NONE;
+	
+	buffer[0] = reg;
+	buffer[1] = (uint8_t)(value >> 8);
+	buffer[2] = (uint8_t)value;
+	
+	i2c_master_transmit_buffer_sync((uint8_t*)buffer,sizeof(buffer),&abort_code,I2C_F_WAIT_FOR_STOP);
+	if(abort_code != I2C_ABORT_NONE) {
+		//insert error handler
+	}
+}
+
 #endif
@@ -59,6 +59,21 @@ typedef enum{ 	HALF_RESOLUTION = 0,
 #define RESOLUTION_CONFIG_REGISTER_SIZE			2
 #define USED_TEMPERATURE_RESOLUTION	        SIXTEENTH_RESOLUTION 	//0.0625 degrees Celsius resolution
 
+#define CONFIG_REGISTER						0x01									//16 bits sensor configuration register
+#define TUPPER_REGISTER						0x02									//Alert window upper boundary
+#define TLOWER_REGISTER						0x03									//Alert window lower boundary
+#define TCRIT_REGISTER						0x04									//Critical temperature limit
+
+#define CONFIG_HYST_0C						0x0000								//TUPPER, TLOWER and TCRIT hysteresis
+#define CONFIG_HYST_1_5C					0x0200
+#define CONFIG_HYST_3C						0x0400
+#define CONFIG_HYST_6C						0x0600
+#define CONFIG_SHDN							0x0100								//Shutdown, no conversions
+#define CONFIG_ALERT_CNT					0x0008								//Alert output enabled
+#define CONFIG_ALERT_SEL					0x0004								//Alert on TCRIT only
+#define CONFIG_ALERT_POL					0x0002								//Alert output active-high
+#define CONFIG_ALERT_MOD					0x0001								//Interrupt instead of comparator mode
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -84,6 +99,10 @@ double MCP9808_calculate_temperature(const uint16_t);
 
 double MCP9808_get_temperature(void);
 
+uint16_t MCP9808_read_register(const uint8_t reg);
+
+void MCP9808_write_register(const uint8_t reg, const uint16_t value);
+
 #endif //CFG_USE_INTERNAL_TEMP_SENSOR
 
 #endif // _MCP9808_H_
@@ -71,6 +71,15 @@
 			#define MCP9808_SDA_PORT            GPIO_PORT_0
 			#define MCP9808_SDA_PIN             GPIO_PIN_4
 	#endif 
+
+	// Define the MCP9808 ALERT pin, open-drain and active-low
+	#if defined (__DA14531__)
+			#define MCP9808_ALERT_PORT          GPIO_PORT_0
+			#define MCP9808_ALERT_PIN           GPIO_PIN_9
+	#else
+			#define MCP9808_ALERT_PORT          GPIO_PORT_1
+			#define MCP9808_ALERT_PIN           GPIO_PIN_2
+	#endif
 #endif
 
 /***************************************************************************************/
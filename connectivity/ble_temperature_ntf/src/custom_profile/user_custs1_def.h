@@ -60,7 +60,7 @@
 
 #define USER_IDX_TEMPERATURE_VAL_UUID_128		{0x56, 0x34, 0xE0, 0xD1, 0x81, 0x54, 0x42, 0x10, 0x8E, 0xFF, 0xD2, 0xB3, 0x77, 0xE3, 0x2A, 0x77}
 
-#define USER_IDX_TEMPERATURE_VAL_CHAR_LEN 	9
+#define USER_IDX_TEMPERATURE_VAL_CHAR_LEN 	2                       // int16_t in 1/16 degrees Celsius
 
 #if defined (CFG_USE_INTERNAL_TEMP_SENSOR) && (__DA14531__)
 #define USER_IDX_TEMPERATURE_VAL_USER_DESC	"Internal sensor temperature data"
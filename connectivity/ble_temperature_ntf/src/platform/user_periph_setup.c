@@ -40,7 +40,6 @@
 #include "gpio.h"
 #include "uart.h"
 #include "syscntl.h"
-#include "MCP9808.h"
 /*
  * GLOBAL VARIABLE DEFINITIONS
  ****************************************************************************************
@@ -83,6 +82,7 @@ void GPIO_reservations(void)
 #if !defined(CFG_USE_INTERNAL_TEMP_SENSOR)
 	RESERVE_GPIO(SDA,MCP9808_SDA_PORT, MCP9808_SDA_PIN, PID_I2C_SDA);
 	RESERVE_GPIO(SCL,MCP9808_SCL_PORT, MCP9808_SCL_PIN, PID_I2C_SCL);
+	RESERVE_GPIO(ALERT,MCP9808_ALERT_PORT, MCP9808_ALERT_PIN, PID_GPIO);
 #endif 
 }
 
@@ -99,6 +99,7 @@ void set_pad_functions(void)
 		// Configure I2C pin functionality
     GPIO_ConfigurePin(MCP9808_SCL_PORT, MCP9808_SCL_PIN, INPUT_PULLUP, PID_I2C_SCL, false);
     GPIO_ConfigurePin(MCP9808_SDA_PORT, MCP9808_SDA_PIN, INPUT_PULLUP, PID_I2C_SDA, false);
+    GPIO_ConfigurePin(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN, INPUT_PULLUP, PID_GPIO, false);
 #endif
 }
 
@@ -139,9 +140,4 @@ void periph_init(void)
 
     // Enable the pads
     GPIO_set_pad_latch_en(true);
-		
-#if !defined(CFG_USE_INTERNAL_TEMP_SENSOR)		
-		// Must be done after initializing GPIO because this function communicates with the MCP9808 via I2C
-		MCP9808_init();
-#endif
 }
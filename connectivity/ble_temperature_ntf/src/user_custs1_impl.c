@@ -45,36 +45,51 @@
 #include "user_periph_setup.h"
 #include "MCP9808.h"
 #include "arch_console.h"
+#include "user_temp_report.h"
 
 #if defined (CFG_USE_INTERNAL_TEMP_SENSOR) && (__DA14531__)
 #include "adc.h"
 #endif
 
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+#include "wkupct_quadec.h"
+#endif
+
 /*
  * GLOBAL VARIABLE DEFINITIONS
  ****************************************************************************************
  */
 
-ke_msg_id_t timer_temperature_ntf      		__SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
-char temperature_ntf_string[9] 			    __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+timer_hnd timer_temperature_ntf      		__SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
+timer_hnd timer_temperature_heartbeat 		__SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
+struct temp_report_state temperature_report __SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
+bool temperature_ntf_enabled 				__SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
+bool temperature_alert_pending 				__SECTION_ZERO("retention_mem_area0"); 											//@RETENTION MEMORY
+
+static const struct temp_report_cfg temperature_report_cfg = {
+    .step = TEMPERATURE_REPORT_STEP,
+    .crit = TEMPERATURE_REPORT_CRIT,
+    .hyst = TEMPERATURE_REPORT_HYST,
+};
 
-#if defined (CFG_USE_INTERNAL_TEMP_SENSOR) && (__DA14531__)
-uint8_t previous_temperature                __SECTION_ZERO("retention_mem_area0");
-#else
-double previous_temperature 								__SECTION_ZERO("retention_mem_area0"); 
-#endif
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
  */
- 
-void user_send_temperature_ntf(void)
+
+static void user_temperature_heartbeat_cb(void);
+
+/**
+ ****************************************************************************************
+ * @brief Reads the temperature
+ * @return Temperature in 1/16 degrees Celsius
+ ****************************************************************************************
+ */
+static int16_t user_read_temperature(void)
 {
-    uint8_t length;
-    
 #if defined (CFG_USE_INTERNAL_TEMP_SENSOR) && (__DA14531__)
     
-        adc_config_t temp_config = {
+    adc_config_t temp_config = {
         .input_mode = ADC_INPUT_MODE_SINGLE_ENDED,
         .input = ADC_INPUT_SE_TEMP_SENS,
     };
@@ -84,54 +99,216 @@ void user_send_temperature_ntf(void)
     int8_t temperature = adc_get_temp();
     
     adc_disable();
+
+    return TEMP_REPORT_Q4(temperature);
 #else
-		double temperature = MCP9808_get_temperature();
+    return temp_report_from_ambient(MCP9808_read_register(TEMPERATURE_DATA_REGISTER));
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Notifies the temperature, little endian int16_t in 1/16 degrees Celsius
+ * @return void
+ ****************************************************************************************
+ */
+static void user_temperature_ntf_send(int16_t temperature)
+{
+    //Allocate a new message
+    struct custs1_val_ntf_ind_req* req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
+                                                          prf_get_task_from_id(TASK_ID_CUSTS1),
+                                                          TASK_APP,
+                                                          custs1_val_ntf_ind_req,
+                                                          USER_IDX_TEMPERATURE_VAL_CHAR_LEN);
+
+    req->conidx = 0;                                        //Connection ID to send the data to (this application can only have one connection(0))
+    req->notification = true;                               //Data is sent as a notification and not as indication
+    req->handle = USER_IDX_TEMPERATURE_VAL_VAL;             //The handle of the characteristic we want to write to
+    req->length = USER_IDX_TEMPERATURE_VAL_CHAR_LEN;        //Data length in bytes
+    req->value[0] = (uint8_t)temperature;
+    req->value[1] = (uint8_t)((uint16_t)temperature >> 8);
+
+    ke_msg_send(req);                                       //Send the message to the task
+
+    //Nothing else is sent until the temperature changes or the heartbeat expires
+    if (timer_temperature_heartbeat != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(timer_temperature_heartbeat);
+    }
+    timer_temperature_heartbeat = app_easy_timer(TEMPERATURE_HEARTBEAT_TO, user_temperature_heartbeat_cb);
+}
+
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+/**
+ ****************************************************************************************
+ * @brief Programs the alert window and waits for the next change of the ALERT pin
+ * @param[in] window_changed The window limits have to be written to the sensor
+ * @return void
+ ****************************************************************************************
+ */
+static void user_temperature_alert_arm(bool window_changed)
+{
+    bool asserted;
+
+    if (window_changed)
+    {
+        MCP9808_write_register(TUPPER_REGISTER, temp_report_to_limit(temperature_report.upper));
+        MCP9808_write_register(TLOWER_REGISTER, temp_report_to_limit(temperature_report.lower));
+    }
+
+    asserted = !GPIO_GetPinStatus(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN);
+
+    if (asserted && !temperature_report.critical)
+    {
+        //The sensor compares against the new window at the end of its next conversion
+        if (timer_temperature_ntf != EASY_TIMER_INVALID_TIMER)
+        {
+            app_easy_timer_cancel(timer_temperature_ntf);
+        }
+        timer_temperature_ntf = app_easy_timer(TEMPERATURE_CONVERSION_TO, user_send_temperature_ntf);
+        return;
+    }
+
+    //Above TCRIT the output stays asserted, wait until it is released
+    wkupct_enable_irq(WKUPCT_PIN_SELECT(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN),
+                      WKUPCT_PIN_POLARITY(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN,
+                                          asserted ? WKUPCT_PIN_POLARITY_HIGH : WKUPCT_PIN_POLARITY_LOW),
+                      1,
+                      0);
+}
+#endif
+
+/**
+ ****************************************************************************************
+ * @brief Samples the temperature and notifies it if it changed enough
+ * @param[in] heartbeat Notify even if the temperature did not change
+ * @return void
+ ****************************************************************************************
+ */
+static void user_temperature_sample(bool heartbeat)
+{
+    int16_t temperature;
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+    struct temp_report_state previous = temperature_report;
+#endif
+
+    if (!temperature_ntf_enabled)
+    {
+        return;
+    }
+
+    temperature = user_read_temperature();
+
+    if (temp_report_update(&temperature_report, &temperature_report_cfg, temperature, heartbeat))
+    {
+        user_temperature_ntf_send(temperature);
+    }
+
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+    user_temperature_alert_arm(!previous.valid ||
+                               (previous.upper != temperature_report.upper) ||
+                               (previous.lower != temperature_report.lower));
 #endif
-    
-	if (temperature != previous_temperature){
-	
-		previous_temperature = temperature;
-        length = snprintf(temperature_ntf_string, TEMPERATURE_DATA, SNPRINT_FORMAT, temperature);
-		//Allocate a new message
-		struct custs1_val_ntf_ind_req* req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
-																prf_get_task_from_id(TASK_ID_CUSTS1),
-																TASK_APP,
-																custs1_val_ntf_ind_req,
-																length);
-																
-		req->conidx = 0;                                        //Connection ID to send the data to (this application can only have one connection(0))
-		req->notification = true;                               //Data is sent as a notification and not as indication
-		req->handle = USER_IDX_TEMPERATURE_VAL_VAL;             //The handle of the characteristic we want to write to
-		req->length = length;                          		    	//Data length in bytes
-		memcpy(req->value, temperature_ntf_string, length);			//Copy the string to the message
-		
-		ke_msg_send(req);                                       //Send the message to the task
-	
-	}
-    
-	timer_temperature_ntf = app_easy_timer(NOTIFICATION_DELAY/10, user_send_temperature_ntf); //Set a timer for NOTIFICATION_DELAY ms
-																																
 }
 
- void user_temperature_message_handler(struct custs1_val_write_ind const *param)
+static void user_temperature_heartbeat_cb(void)
 {
+    timer_temperature_heartbeat = EASY_TIMER_INVALID_TIMER;
+    user_temperature_sample(true);
+}
 
+#if defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+void user_send_temperature_ntf(void)
+{
+    timer_temperature_ntf = app_easy_timer(NOTIFICATION_DELAY/10, user_send_temperature_ntf); //Set a timer for NOTIFICATION_DELAY ms
+    user_temperature_sample(false);
+}
+#else
+void user_send_temperature_ntf(void)
+{
+    timer_temperature_ntf = EASY_TIMER_INVALID_TIMER;
+    user_temperature_sample(false);
+}
+
+static void user_temperature_alert_cb(void)
+{
+    temperature_alert_pending = false;
+    user_temperature_sample(false);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Wake-up controller callback. Defers the sampling to the application task, the
+ *        I2C transfers do not run in the interrupt context
+ * @return void
+ ****************************************************************************************
+ */
+static void user_temperature_alert_handler(void)
+{
+    if (!temperature_alert_pending)
+    {
+        temperature_alert_pending = true;
+
+        ke_msg_id_t msg = app_easy_msg_set(user_temperature_alert_cb);
+        ke_msg_send_basic(msg, TASK_APP, 0);
+    }
+}
+#endif
+
+static void user_temperature_start(void)
+{
+    temperature_ntf_enabled = true;
+    temperature_alert_pending = false;
+    temp_report_init(&temperature_report);
+
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+    wkupct_register_callback(user_temperature_alert_handler);
+    MCP9808_write_register(TCRIT_REGISTER, temp_report_to_limit(temp_report_crit_limit(&temperature_report_cfg)));
+    MCP9808_write_register(CONFIG_REGISTER, TEMPERATURE_REPORT_HYST_CFG | CONFIG_ALERT_CNT);
+#endif
+
+    //The first sample is always notified and sets up the alert window
+    user_send_temperature_ntf();
+}
+
+void user_temperature_stop(void)
+{
+    if (!temperature_ntf_enabled)
+    {
+        return;
+    }
+    temperature_ntf_enabled = false;
+
+    if (timer_temperature_ntf != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(timer_temperature_ntf);
+        timer_temperature_ntf = EASY_TIMER_INVALID_TIMER;
+    }
+    if (timer_temperature_heartbeat != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(timer_temperature_heartbeat);
+        timer_temperature_heartbeat = EASY_TIMER_INVALID_TIMER;
+    }
+
+#if !defined (CFG_USE_INTERNAL_TEMP_SENSOR)
+    wkupct_disable_irq();
+    //Release the ALERT output, it would keep drawing current through the pull-up
+    MCP9808_write_register(CONFIG_REGISTER, TEMPERATURE_REPORT_HYST_CFG);
+#endif
+}
+
+void user_temperature_message_handler(struct custs1_val_write_ind const *param)
+{
 	if(param->value[0]){
 		//If the client subscribed to the notification
-		if(timer_temperature_ntf == EASY_TIMER_INVALID_TIMER){ 
-			//Start the timer if it is not running
-			timer_temperature_ntf = app_easy_timer(NOTIFICATION_DELAY/10, user_send_temperature_ntf); //Set a timer for NOTIFICATION_DELAY ms
+		if(!temperature_ntf_enabled){ 
+			user_temperature_start();
 		}
 	}
 	else{
 		//If the client unsubscribed from the notification
-		if(timer_temperature_ntf != EASY_TIMER_INVALID_TIMER){ 
-			//Stop the timer if it is running
-			app_easy_timer_cancel(timer_temperature_ntf);
-			timer_temperature_ntf = EASY_TIMER_INVALID_TIMER;
-		}
+		user_temperature_stop();
 	}
-
 }
 		
 
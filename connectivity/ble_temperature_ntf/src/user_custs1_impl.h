@@ -69,6 +69,14 @@ void user_temperature_message_handler(struct custs1_val_write_ind const *param);
 									
 void user_send_temperature_ntf(void);									
 
+/**
+ ****************************************************************************************
+ * @brief Stops the temperature notifications and the alert wake-ups.
+ * @return void
+ ****************************************************************************************
+*/
+void user_temperature_stop(void);
+
 
 /**
  ****************************************************************************************
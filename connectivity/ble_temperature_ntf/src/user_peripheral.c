@@ -231,6 +231,12 @@ void user_app_init(void)
 {
     app_param_update_request_timer_used = EASY_TIMER_INVALID_TIMER;
 
+#if !defined(CFG_USE_INTERNAL_TEMP_SENSOR)
+    // The MCP9808 keeps its configuration while the system sleeps, it is set once here
+    // instead of in periph_init()
+    MCP9808_init();
+#endif
+
     // Initialize Manufacturer Specific Data
     mnf_data_init();
 
@@ -300,6 +306,9 @@ void user_app_adv_undirect_complete(uint8_t status)
 
 void user_app_disconnect(struct gapc_disconnect_ind const *param)
 {
+    // Stop the temperature notifications of the disconnected client
+    user_temperature_stop();
+
     // Cancel the parameter update request timer
     if (app_param_update_request_timer_used != EASY_TIMER_INVALID_TIMER)
     {
@@ -86,7 +86,15 @@
 #define APP_AD_MSD_DATA_LEN         TEMPERATURE_DATA
 
 #define APP_PERIPHERAL_CTRL_TIMER_DELAY 100
-#define NOTIFICATION_DELAY 					300  								//Time between notifications in ms
+#define NOTIFICATION_DELAY 					300  								//Time between samples of the internal sensor in ms
+
+/* Report-on-change temperature notifications, temperatures in 1/16 degrees Celsius */
+#define TEMPERATURE_REPORT_STEP             (8)                 // 0.5 degrees, smallest change that is notified
+#define TEMPERATURE_REPORT_CRIT             (60 * 16)           // 60 degrees, MCP9808 TCRIT
+#define TEMPERATURE_REPORT_HYST             (0)                 // Must match TEMPERATURE_REPORT_HYST_CFG
+#define TEMPERATURE_REPORT_HYST_CFG         CONFIG_HYST_0C      // MCP9808 THYST
+#define TEMPERATURE_HEARTBEAT_TO            (6000)              // 6000*10ms = 60sec, notification sent if nothing else was
+#define TEMPERATURE_CONVERSION_TO           (30)                // 30*10ms, longer than a MCP9808 conversion at SIXTEENTH_RESOLUTION
 /*
  * TYPE DEFINITIONS
  ****************************************************************************************
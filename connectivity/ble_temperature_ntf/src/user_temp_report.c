@@ -0,0 +1,132 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_temp_report.c
+ *
+ * @brief Report-on-change temperature policy source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "user_temp_report.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static int32_t floor_limit(int32_t temp)
+{
+    return temp - (((temp % TEMP_REPORT_LIMIT_RES) + TEMP_REPORT_LIMIT_RES) % TEMP_REPORT_LIMIT_RES);
+}
+
+static int32_t ceil_limit(int32_t temp)
+{
+    return -floor_limit(-temp);
+}
+
+/// Keeps a limit in the range of the limit registers
+static int16_t clamp(int32_t limit)
+{
+    if (limit > TEMP_REPORT_LIMIT_MAX)
+    {
+        return TEMP_REPORT_LIMIT_MAX;
+    }
+    if (limit < TEMP_REPORT_LIMIT_MIN)
+    {
+        return TEMP_REPORT_LIMIT_MIN;
+    }
+    return (int16_t)limit;
+}
+
+void temp_report_init(struct temp_report_state *st)
+{
+    st->reported = 0;
+    st->lower = 0;
+    st->upper = 0;
+    st->valid = false;
+    st->critical = false;
+}
+
+int16_t temp_report_crit_limit(const struct temp_report_cfg *cfg)
+{
+    return clamp(floor_limit(cfg->crit));
+}
+
+bool temp_report_update(struct temp_report_state *st, const struct temp_report_cfg *cfg,
+                        int16_t temp, bool heartbeat)
+{
+    int32_t crit = temp_report_crit_limit(cfg);
+    int32_t half = cfg->step;
+    bool notify = heartbeat || !st->valid;
+
+    // Critical limit crossings, with the hysteresis of the sensor on the way down
+    if (!st->critical && (temp >= crit))
+    {
+        st->critical = true;
+        notify = true;
+    }
+    else if (st->critical && (temp < crit - cfg->hyst))
+    {
+        st->critical = false;
+        notify = true;
+    }
+
+    if (st->valid && ((temp > st->upper) || (temp < st->lower)))
+    {
+        notify = true;
+    }
+
+    if (!notify)
+    {
+        return false;
+    }
+
+    // The sensor must be able to release the output with the window around temp
+    if (half <= cfg->hyst)
+    {
+        half = cfg->hyst + 1;
+    }
+
+    // Rounded outwards, a change of at least half leaves the window
+    st->reported = temp;
+    st->upper = clamp(ceil_limit((int32_t)temp + half - 1));
+    st->lower = clamp(floor_limit((int32_t)temp - half + 1));
+    st->valid = true;
+
+    return true;
+}
+
+/// @} APP
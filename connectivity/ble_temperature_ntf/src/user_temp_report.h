@@ -0,0 +1,186 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_temp_report.h
+ *
+ * @brief Report-on-change temperature policy header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_TEMP_REPORT_H_
+#define _USER_TEMP_REPORT_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * Decides when a temperature change is worth a notification. Temperatures are int16_t
+ * in 1/16 degrees Celsius, the resolution of the MCP9808 ambient temperature register.
+ *
+ * Every notified value re-centres a window around itself. A sample is notified when it
+ * leaves the window, when it crosses the critical limit, or on a heartbeat. The window
+ * limits are on the 0.25 degrees grid of the MCP9808 TUPPER and TLOWER registers and
+ * the checks mirror the sensor in comparator mode, so the ALERT output is asserted
+ * exactly when temp_report_update() would notify:
+ *
+ *   - asserted while Ta > TUPPER, Ta < TLOWER or Ta >= TCRIT
+ *   - released once Ta <= TUPPER - THYST, Ta >= TLOWER + THYST and Ta < TCRIT - THYST
+ *
+ * The window half-width is more than THYST, which lets the output be released right
+ * after the window is moved. While the temperature stays at or above
+ * TCRIT the output cannot be released, only the crossings of TCRIT are reported by the
+ * sensor then.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Degrees Celsius to 1/16 degrees
+#define TEMP_REPORT_Q4(deg)             ((int16_t)((deg) * 16))
+
+/// Resolution and range of the MCP9808 limit registers, 0.25 degrees steps from -256
+/// to +255.75 degrees
+#define TEMP_REPORT_LIMIT_RES           (4)
+#define TEMP_REPORT_LIMIT_MIN           (-0x1000)
+#define TEMP_REPORT_LIMIT_MAX           (0x0FFC)
+
+/// Flag bits of the MCP9808 ambient temperature register
+#define TEMP_REPORT_AMBIENT_CRIT        (0x8000)
+#define TEMP_REPORT_AMBIENT_UPPER       (0x4000)
+#define TEMP_REPORT_AMBIENT_LOWER       (0x2000)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct temp_report_cfg
+{
+    /// Smallest change that is notified, the window rounding may add up to 3/16 degrees
+    int16_t step;
+    /// Critical limit
+    int16_t crit;
+    /// Hysteresis of the sensor, THYST
+    int16_t hyst;
+};
+
+struct temp_report_state
+{
+    /// Last notified temperature
+    int16_t reported;
+    /// Window around the last notified temperature, on the limit register grid
+    int16_t lower;
+    int16_t upper;
+    /// A temperature has been notified
+    bool valid;
+    /// At or above the critical limit
+    bool critical;
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Converts the MCP9808 ambient temperature register.
+ * @param[in] reg       Register value, the flag bits are ignored.
+ * @return Temperature in 1/16 degrees.
+ ****************************************************************************************
+ */
+static inline int16_t temp_report_from_ambient(uint16_t reg)
+{
+    // 13-bit two's complement
+    int16_t value = (int16_t)(reg & 0x0FFF);
+
+    return (reg & 0x1000) ? (int16_t)(value - 0x1000) : value;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Converts a limit to the MCP9808 TUPPER, TLOWER and TCRIT register format.
+ * @param[in] limit     Limit in 1/16 degrees, multiple of TEMP_REPORT_LIMIT_RES.
+ * @return Register value.
+ ****************************************************************************************
+ */
+static inline uint16_t temp_report_to_limit(int16_t limit)
+{
+    return (uint16_t)limit & 0x1FFC;
+}
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Resets the state, the next sample is notified.
+ * @param[out] st       State.
+ ****************************************************************************************
+ */
+void temp_report_init(struct temp_report_state *st);
+
+/**
+ ****************************************************************************************
+ * @brief Takes a sample. Moves the window around it if it is notified.
+ * @param[in] st        State.
+ * @param[in] cfg       Configuration.
+ * @param[in] temp      Temperature in 1/16 degrees.
+ * @param[in] heartbeat Notify even if the temperature did not change.
+ * @return True if the sample must be notified.
+ ****************************************************************************************
+ */
+bool temp_report_update(struct temp_report_state *st, const struct temp_report_cfg *cfg,
+                        int16_t temp, bool heartbeat);
+
+/**
+ ****************************************************************************************
+ * @brief Critical limit on the limit register grid.
+ * @param[in] cfg       Configuration.
+ * @return Limit in 1/16 degrees.
+ ****************************************************************************************
+ */
+int16_t temp_report_crit_limit(const struct temp_report_cfg *cfg);
+
+/// @} APP
+
+#endif // _USER_TEMP_REPORT_H_
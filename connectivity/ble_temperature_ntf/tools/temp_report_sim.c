@@ -0,0 +1,226 @@
+/**
+ ****************************************************************************************
+ *
+ * @file temp_report_sim.c
+ *
+ * @brief Host simulation of the temperature report policy against the MCP9808 alert output.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc -o temp_report_sim tools/temp_report_sim.c src/user_temp_report.c -lm
+ *   ./temp_report_sim
+ *
+ * A 24 h temperature trace sampled every 100 ms, a daily and a half-hour swing with
+ * correlated noise and a spike over the critical limit, is run through
+ * temp_report_update() the way user_custs1_impl.c uses it: the device wakes up when
+ * the ALERT output of the sensor is asserted, or released while critical, and on the
+ * heartbeat. The output is a model of the MCP9808 comparator mode with THYST.
+ *
+ * Checked, for THYST 0, 1.5 and 6 degrees: the output is released after each window
+ * move, no sample outside the window goes unnotified, every window notification is a
+ * change of at least the step, the wake-ups and notifications against the 300 ms poll
+ * of the previous version, and the register conversions over their full range.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include "user_temp_report.h"
+
+#ifndef M_PI
+#define M_PI                (3.14159265358979323846)
+#endif
+
+/// As in user_peripheral.h
+#define REPORT_STEP         (8)
+#define REPORT_CRIT         (60 * 16)
+#define HEARTBEAT_S         (60.0)
+
+#define TRACE_PERIOD_S      (0.1)
+#define TRACE_LEN_S         (24 * 3600)
+#define POLL_PERIOD_S       (0.3)
+
+/// Comparator output: window and critical parts
+#define PIN_WINDOW          (0x01)
+#define PIN_CRIT            (0x02)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+/// MCP9808 ALERT in comparator mode
+static int comparator(int16_t ta, const struct temp_report_state *st, int16_t crit, int16_t hyst, int pin)
+{
+    if (ta >= crit)
+    {
+        pin |= PIN_CRIT;
+    }
+    else if (ta < crit - hyst)
+    {
+        pin &= ~PIN_CRIT;
+    }
+
+    if ((ta > st->upper) || (ta < st->lower))
+    {
+        pin |= PIN_WINDOW;
+    }
+    else if ((ta <= st->upper - hyst) && (ta >= st->lower + hyst))
+    {
+        pin &= ~PIN_WINDOW;
+    }
+
+    return pin;
+}
+
+static double trace(double t, double *noise)
+{
+    double c = 21 + 2 * sin(2 * M_PI * t / 86400) + 0.8 * sin(2 * M_PI * t / 1800);
+
+    // Ten minutes next to an oven
+    if ((t > 36000) && (t < 36600))
+    {
+        c += 45 * sin(M_PI * (t - 36000) / 600);
+    }
+    *noise = 0.9 * *noise + ((rand() % 1000) / 1000.0 - 0.5) * 0.05;
+
+    return c + *noise;
+}
+
+static void run(int16_t hyst)
+{
+    const struct temp_report_cfg cfg = {REPORT_STEP, REPORT_CRIT, hyst};
+    const long samples = (long)(TRACE_LEN_S / TRACE_PERIOD_S);
+    struct temp_report_state st;
+    int16_t crit = temp_report_crit_limit(&cfg);
+    long poll_wakeups = 0, poll_ntf = 0, wakeups = 0, ntf = 0;
+    long stuck = 0, missed = 0, small = 0, crit_reports = 0;
+    double noise = 0, last_ntf = 0, next_poll = 0;
+    int16_t polled = INT16_MIN;
+    int pin = 0;
+
+    srand(7);
+    temp_report_init(&st);
+    temp_report_update(&st, &cfg, TEMP_REPORT_Q4(21), false);
+    wakeups++;
+    ntf++;
+
+    for (long i = 0; i < samples; i++)
+    {
+        double t = i * TRACE_PERIOD_S;
+        int16_t ta = (int16_t)floor(trace(t, &noise) * 16);
+        bool heartbeat = (t - last_ntf >= HEARTBEAT_S);
+        bool wake;
+
+        // Previous version: poll every 300 ms, notify any change
+        if (t >= next_poll)
+        {
+            next_poll += POLL_PERIOD_S;
+            poll_wakeups++;
+            if (ta != polled)
+            {
+                poll_ntf++;
+                polled = ta;
+            }
+        }
+
+        pin = comparator(ta, &st, crit, hyst, pin);
+        // Armed for the asserting edge, or for the release while critical
+        wake = st.critical ? !(pin & PIN_CRIT) : (pin != 0);
+        if (!wake && !heartbeat)
+        {
+            // Nothing left the window without waking the device
+            if (!st.critical && ((ta > st.upper) || (ta < st.lower)))
+            {
+                missed++;
+            }
+            continue;
+        }
+
+        wakeups++;
+        {
+            int16_t before = st.reported;
+            bool was_critical = st.critical;
+
+            if (temp_report_update(&st, &cfg, ta, heartbeat))
+            {
+                ntf++;
+                last_ntf = t;
+                crit_reports += (st.critical != was_critical);
+                if (!heartbeat && (st.critical == was_critical) && (abs(ta - before) < REPORT_STEP))
+                {
+                    small++;
+                }
+            }
+        }
+
+        // The window was moved around ta, the sensor must release its window output
+        pin = comparator(ta, &st, crit, hyst, pin);
+        if (pin & PIN_WINDOW)
+        {
+            stuck++;
+        }
+    }
+
+    printf("THYST %4.1f C: poll %ld wake-ups %ld notifications, alert %ld wake-ups %ld notifications, "
+           "%ld critical crossings\n", hyst / 16.0, poll_wakeups, poll_ntf, wakeups, ntf, crit_reports);
+
+    CHECK(stuck == 0);
+    CHECK(missed == 0);
+    CHECK(small == 0);
+    // Up and down through the spike
+    CHECK(crit_reports == 2);
+    CHECK(wakeups * 10 < poll_wakeups);
+    CHECK(ntf * 10 < poll_ntf);
+}
+
+int main(void)
+{
+    run(0);
+    run(TEMP_REPORT_Q4(1.5));
+    run(TEMP_REPORT_Q4(6));
+
+    // 13-bit two's complement, the flag bits ignored
+    for (int v = -0x1000; v < 0x1000; v++)
+    {
+        CHECK(temp_report_from_ambient((uint16_t)(v & 0x1FFF) | TEMP_REPORT_AMBIENT_CRIT |
+                                       TEMP_REPORT_AMBIENT_UPPER | TEMP_REPORT_AMBIENT_LOWER) == v);
+    }
+    CHECK(temp_report_to_limit(TEMP_REPORT_Q4(-0.25)) == 0x1FFC);
+    CHECK(temp_report_to_limit(TEMP_REPORT_Q4(25)) == 0x0190);
+    CHECK(temp_report_to_limit(TEMP_REPORT_LIMIT_MIN) == 0x1000);
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
@@ -51,6 +51,7 @@
 #include <stdbool.h>
 #include "user_central_config.h"
 #include "compiler.h"
+#include "user_gatt_cache.h"
  
  #define ATT_UUID_LENGTH (16)
  
@@ -116,24 +117,39 @@ typedef struct{
 #endif
 	 
 }service_disc_t;
+
+typedef enum{
+	
+	/// Cached handles found, reading the Database Hash of the peer
+	DISC_STATE_HASH_CHECK,
+	/// Full service discovery
+	DISC_STATE_DISCOVERY,
+	/// Full discovery done, reading the Database Hash to store with the handles
+	DISC_STATE_HASH_READ,
+	/// Handles from the full discovery
+	DISC_STATE_DONE,
+	/// Handles from the cache
+	DISC_STATE_CACHED,
+	
+}disc_state_t;
  
 typedef struct{
 	 
 	uint8_t 					con_idx;
 	bool 	 						con_valid;
 	struct 						bd_addr addr;
+	uint8_t						addr_type;
 	service_disc_t		serv_disc;
+	disc_state_t			disc_state;
+	/// The database changed while it was discovered
+	bool							disc_stale;
+	/// Characteristics of the peer, discovered or from the cache
+	struct gatt_disc	disc;
+	/// Cache entry of the peer, while its Database Hash is checked
+	struct gatt_cache_entry	cache_entry;
 	 
 }periph_device_t;
 
-typedef struct{
-	
-	 att_uuid_t			svc_uuid;
-	 uint16_t				num_chars;
-	 gattc_chars_t 	items[__ARRAY_EMPTY];
-	
-}service_info_t;
- 
 typedef enum{
 	
 	 BLE_GAP_ERROR_NO_ERROR,
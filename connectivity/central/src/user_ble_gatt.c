@@ -106,35 +106,6 @@ void user_ble_gatt_write(uint8_t op, uint8_t con_idx, uint16_t handle, uint8_t *
 	
 }
 
-/**
- ****************************************************************************************
- * @brief Return number of characteristics in a service
- * @param[in] svc - pointer to the service discovered
- * @return number of characteristics
- ****************************************************************************************
- */
-uint32_t user_ble_get_svc_size(struct gattc_sdp_svc_ind const *svc)
-{
-	
-	uint16_t i;
-	uint16_t num_items = 0;
-	
-	for (i = 0; i < svc->end_hdl - svc->start_hdl; i++) {
-					uint8_t att_type = svc->info[i].att_type;
-
-					/* Value is not a separate item - it's part of the characteristic item */
-					if (att_type == GATTC_SDP_NONE || att_type == GATTC_SDP_ATT_VAL) {
-									continue;
-					}
-
-					if(att_type == GATTC_SDP_ATT_CHAR)
-						num_items++;
-	}
-	
-	return ( sizeof(service_info_t) + num_items*sizeof(gattc_chars_t) );
-}
-
-
 /**
  ****************************************************************************************
  * @brief Perform a simple gatt read - read is returned by GATTC_READ_IND
@@ -160,109 +131,29 @@ void user_gatt_read_simple(uint8_t con_idx, uint16_t handle)
 
 /**
  ****************************************************************************************
- * @brief Parse a service from a service discovered indication
- * @param[in] svc - service to parse
- * @param[in] con_idx - connection id
- * @param[out] svc_ret - parsed service
+ * @brief Read a characteristic by its 16-bit UUID over the whole handle range - read is
+ *        returned by GATTC_READ_IND, an error by the GATTC_READ_BY_UUID completion
+ * @param[in] con_idx - connection identifier
+ * @param[in] uuid - characteristic UUID
  * @return void
  ****************************************************************************************
  */
-void user_gatt_parse_service(struct gattc_sdp_svc_ind const *svc, service_info_t *svc_ret, uint8_t con_idx)
+void user_gatt_read_by_uuid16(uint8_t con_idx, uint16_t uuid)
 {
-	
-	uint8_t i;
-	svc_ret->num_chars = 0;
-	svc_ret->svc_uuid.type = (svc->uuid_len == sizeof(uint16_t) ? ATT_UUID_16 : ATT_UUID_128);
-	uint16_t current_handle;
-	
-	static uint8_t char_index = 0;
-	
-	if(svc_ret->svc_uuid.type == ATT_UUID_16){
-		memcpy(&svc_ret->svc_uuid.uuid.uuid16, svc->uuid, svc->uuid_len);
-		svc_ret->svc_uuid.type = ATT_UUID_16;
-	}else
-	{
-		memcpy(svc_ret->svc_uuid.uuid.uuid128, svc->uuid, svc->uuid_len);
-		svc_ret->svc_uuid.type = ATT_UUID_128;
-	}
-	
-	for(i = 0; i < svc->end_hdl - svc->start_hdl; i++)
-	{
-
-		const union gattc_sdp_att_info *info = &svc->info[i];
-		
-		if (info->att_type == GATTC_SDP_NONE) {
-					continue;
-		}
-		
-		current_handle = svc->start_hdl + i + 1;
-		switch(info->att_type)
-		{
-			case GATTC_SDP_ATT_VAL:
-			{
-				
-				//struct gattc_sdp_att att;
-				memcpy(&svc_ret->items[char_index].uuid.uuid, info->att.uuid, info->att.uuid_len);
-				svc_ret->items[char_index].c.value_handle = current_handle;
-				svc_ret->items[char_index].uuid.type = info->att.uuid_len == sizeof(uint16_t) ? ATT_UUID_16 : ATT_UUID_128;
-				
-				
-			}break;
-			/*Descriptor*/
-			case GATTC_SDP_ATT_DESC:
-			{
-				
-				    //struct gattc_sdp_att att;
-				uint16_t att_ccc = ATT_DESC_CLIENT_CHAR_CFG;
-				if( !memcmp(&att_ccc, info->att.uuid, sizeof(uint16_t))  && info->att.uuid_len == sizeof(uint16_t)  )
-				{
-					if(svc_ret->items[char_index].c.properties & GATT_PROP_NOTIFY)
-					{
-						uint16_t ccc = GATT_CCC_NOTIFICATIONS;
-						
-						user_ble_gatt_write(GATTC_WRITE, con_idx, current_handle, (uint8_t *)&ccc, sizeof(ccc));			
-					}
-					if(svc_ret->items[char_index].c.properties & GATT_PROP_INDICATE)
-					{
-						uint16_t ccc = GATT_CCC_INDICATIONS;
-						
-						user_ble_gatt_write(GATTC_WRITE, con_idx, current_handle, (uint8_t *)&ccc, sizeof(ccc));
-
-					}
-				
-				}
+    struct gattc_read_cmd * req  = KE_MSG_ALLOC(GATTC_READ_CMD, KE_BUILD_ID(TASK_GATTC, con_idx),
+            TASK_APP, gattc_read_cmd);
+    //request type
+    req->operation                       = GATTC_READ_BY_UUID;
+    req->nb                             = 1;
+    req->req.by_uuid.start_hdl          = 0x0001;
+    req->req.by_uuid.end_hdl            = 0xFFFF;
+    req->req.by_uuid.uuid_len           = sizeof(uint16_t);
+    memcpy(req->req.by_uuid.uuid, &uuid, sizeof(uint16_t));
 
-				
-			}break;
-			/*Characteristic Declaration*/
-			case GATTC_SDP_ATT_CHAR:
-			{
-				char_index  = svc_ret->num_chars;
-				svc_ret->num_chars++;
-				
-				//struct gattc_sdp_att_char att_char
-				memcpy(&svc_ret->items[char_index].uuid.uuid, info->att.uuid, info->att.uuid_len);
-				svc_ret->items[char_index].c.properties = info->att_char.prop;
-				svc_ret->items[char_index].handle = info->att_char.handle;
-				
-				
-			
-				
-				break;
-			}
-			/*Included Service*/
-			case GATTC_SDP_INC_SVC:
-			{
-				break;
-			}
-			default:
-				break;
-		}
-			
-		
-	}
-	
+    //send request to GATT
+    ke_msg_send(req);
 }
+
 /// @} APP
 
 
@@ -68,48 +68,39 @@ void user_gatt_discover_all_services(uint8_t con_idx, uint16_t start_handle);
 
 /**
  ****************************************************************************************
- * @brief Perform a gatt write
+ * @brief Perform a simple gatt read - read is returned by GATTC_READ_IND
  * @param[in] con_idx - connection identifier
- * @param[in] handle - attribute handle to write 
- * @param[in] data - data to write
- * @param[in] data_len - data len
+ * @param[in] handle - attribute handle to read
  * @return void
  ****************************************************************************************
  */
-void user_gatt_parse_service(struct gattc_sdp_svc_ind const *svc, service_info_t *svc_ret, uint8_t con_idx);
-
+void user_gatt_read_simple(uint8_t con_idx, uint16_t handle);
 
 /**
  ****************************************************************************************
- * @brief Perform a simple gatt read - read is returned by GATTC_READ_IND
+ * @brief Read a characteristic by its 16-bit UUID over the whole handle range - read is
+ *        returned by GATTC_READ_IND, an error by the GATTC_READ_BY_UUID completion
  * @param[in] con_idx - connection identifier
- * @param[in] handle - attribute handle to read
+ * @param[in] uuid - characteristic UUID
  * @return void
  ****************************************************************************************
  */
-void user_gatt_read_simple(uint8_t con_idx, uint16_t handle);
+void user_gatt_read_by_uuid16(uint8_t con_idx, uint16_t uuid);
 
 /**
  ****************************************************************************************
- * @brief Parse a service from a service discovered indication
- * @param[in] svc - service to parse
- * @param[in] con_idx - connection id
- * @param[out] svc_ret - parsed service
+ * @brief Perform a gatt write
+ * @param[in] op - write operation
+ * @param[in] con_idx - connection identifier
+ * @param[in] handle - attribute handle to write 
+ * @param[in] data - data to write
+ * @param[in] data_len - data len
  * @return void
  ****************************************************************************************
  */
 void user_ble_gatt_write(uint8_t op, uint8_t con_idx, uint16_t handle, uint8_t *data, uint16_t data_len);
 
 
-/**
- ****************************************************************************************
- * @brief Return number of characteristics in a service
- * @param[in] svc - pointer to the service discovered
- * @return number of characteristics
- ****************************************************************************************
- */
-uint32_t user_ble_get_svc_size(struct gattc_sdp_svc_ind const *svc);
-
 /// @} APP
 
 #endif // _USER_BLE_GATT_H_
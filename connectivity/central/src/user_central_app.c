@@ -49,8 +49,11 @@
 #include "user_ble_gatt.h"
 #include "user_config.h"
 #include "user_central_config.h"
+#include "user_gatt_disc.h"
+#include "user_gatt_cache.h"
 #include "gap.h"
 #include "ke_task.h"
+#include "ke_msg.h"
 #include "wkupct_quadec.h"
 #include "user_periph_setup.h"
 
@@ -58,6 +61,10 @@
 #define SCAN_INTVL_MS		(50)
 #define SCAN_WINDOW_MS	(50)
 
+#ifndef ATT_CHAR_DB_HASH
+#define ATT_CHAR_DB_HASH	(0x2B2A)
+#endif
+
 
 
 typedef struct
@@ -81,6 +88,27 @@ typedef struct
 
 central_app_env_t central_app_env;
 
+/// Characteristics used by the application, in the order of the filter table
+enum
+{
+	DISC_SVC_CHANGED,
+	DISC_DB_HASH,
+	DISC_BAS_LEVEL,
+	DISC_IAS_ALERT,
+	DISC_CHAR_COUNT,
+};
+
+static const struct gatt_disc_filter disc_filter[DISC_CHAR_COUNT] =
+{
+	{GATT_DISC_UUID16(ATT_SVC_GENERIC_ATTRIBUTE), GATT_DISC_UUID16(ATT_CHAR_SERVICE_CHANGED), GATT_DISC_SUBSCRIBE},
+	{GATT_DISC_UUID16(ATT_SVC_GENERIC_ATTRIBUTE), GATT_DISC_UUID16(ATT_CHAR_DB_HASH), 0},
+	{GATT_DISC_UUID16(ATT_SVC_BATTERY_SERVICE), GATT_DISC_UUID16(ATT_CHAR_BATTERY_LEVEL), GATT_DISC_SUBSCRIBE},
+	{GATT_DISC_UUID16(ATT_SVC_IMMEDIATE_ALERT), GATT_DISC_UUID16(ATT_CHAR_ALERT_LEVEL), 0},
+};
+
+/// Handles of the peers. Retention RAM keeps them through sleep, not through a reset or power loss
+struct gatt_cache gatt_sleep_cache __SECTION_ZERO("retention_mem_area0"); //@ RETENTION MEMORY
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
@@ -98,10 +126,19 @@ static inline void format_adv_string(uint8_t * data, uint8_t len, char *out_stri
 	
 }
 #endif
-/* return true if UUIDs match */
-static bool match_uuid(uint8_t * uuid1, uint8_t *uuid2, uint8_t len)
+/* fill a UUID from a discovered attribute */
+static void set_att_uuid(att_uuid_t *uuid, const uint8_t *data, uint8_t len)
 {
-	return !memcmp(uuid1, uuid2, len);
+	if(len == sizeof(uint16_t))
+	{
+		uuid->type = ATT_UUID_16;
+		memcpy(&uuid->uuid.uuid16, data, sizeof(uint16_t));
+	}
+	else
+	{
+		uuid->type = ATT_UUID_128;
+		memcpy(uuid->uuid.uuid128, data, ATT_UUID_LENGTH);
+	}
 }
 
 #if (SCAN_FILTER == SCAN_FILTER_NONE || SCAN_FILTER == SCAN_FILTER_16_BIT_SVC_DATA || SCAN_FILTER == SCAN_FILTER_MFG_DATA)
@@ -186,6 +223,35 @@ static const char *format_properties(uint8_t properties)
 }
 
 #ifdef ENABLE_IAS
+/**
+ ****************************************************************************************
+ * @brief Select the write operation for the alert level characteristic
+ * @param[in] properties - characteristic properties
+ * @param[out] op - write operation
+ * @return false if the characteristic is not writable
+ ****************************************************************************************
+ */
+static bool ias_write_op_get(uint8_t properties, uint8_t *op)
+{
+	if(properties & GATT_PROP_WRITE)
+	{
+		*op = GATTC_WRITE;
+	}
+	else if(properties & GATT_PROP_WRITE_NO_RESP)
+	{
+		*op = GATTC_WRITE_NO_RESPONSE;	
+	}
+	else if(properties & GATT_PROP_WRITE_SIGNED)
+	{
+		*op = GATTC_WRITE_SIGNED;	
+	}else
+	{
+		return false;
+	}
+	
+	return true;
+}
+
 /**
  ****************************************************************************************
  * @brief callback from alert button
@@ -244,28 +310,176 @@ static void configure_alert_button()
 
 /**
  ****************************************************************************************
- * @brief After full discovery finished
+ * @brief After full discovery finished, or the handles were found in the cache
  * @param[in] con_idx - connection identifier
  * @return void
  ****************************************************************************************
  */
 static void handle_service_disc_finished(uint8_t con_idx)
 {
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	uint16_t ccc;
+	uint8_t i;
+	
+	// The peer is not bonded, so subscriptions are written on every connection
+	for(i = 0; i < DISC_CHAR_COUNT; i++)
+	{
+		ccc = gatt_disc_ccc_value(&periph->disc, i);
+		if(ccc != 0)
+		{
+			user_ble_gatt_write(GATTC_WRITE, con_idx, periph->disc.chars[i].ccc_handle, (uint8_t *)&ccc, sizeof(ccc));
+		}
+	}
+	
 #ifdef ENABLE_BAS
-	if(central_app_env.periph_devices[con_idx].serv_disc.bas_handle_valid){
-		user_gatt_read_simple(con_idx, 
-						central_app_env.periph_devices[con_idx].serv_disc.bas_char.c.value_handle);
+	periph->serv_disc.bas_char.c.value_handle = periph->disc.chars[DISC_BAS_LEVEL].value_handle;
+	periph->serv_disc.bas_char.c.properties = periph->disc.chars[DISC_BAS_LEVEL].properties;
+	periph->serv_disc.bas_handle_valid = (periph->disc.chars[DISC_BAS_LEVEL].value_handle != 0);
+	
+	if(periph->serv_disc.bas_handle_valid){
+		dbg_block_printf("\tBattery Level Char: %04x\r\n", periph->serv_disc.bas_char.c.value_handle);
+		user_gatt_read_simple(con_idx, periph->serv_disc.bas_char.c.value_handle);
 	}
 #endif 
 
 #ifdef ENABLE_IAS
-	if(central_app_env.periph_devices[con_idx].serv_disc.ias_handle_valid){
+	periph->serv_disc.ias_char.c.value_handle = periph->disc.chars[DISC_IAS_ALERT].value_handle;
+	periph->serv_disc.ias_char.c.properties = periph->disc.chars[DISC_IAS_ALERT].properties;
+	periph->serv_disc.ias_handle_valid = (periph->disc.chars[DISC_IAS_ALERT].value_handle != 0) &&
+					ias_write_op_get(periph->disc.chars[DISC_IAS_ALERT].properties, &periph->serv_disc.ias_write_op);
+	
+	if(periph->serv_disc.ias_handle_valid){
+			dbg_block_printf("\tAlert Level Char: %04x\r\n", periph->serv_disc.ias_char.c.value_handle);
 			configure_alert_button();
 	}
 #endif 
 	
 }
 
+/**
+ ****************************************************************************************
+ * @brief Start a full service discovery, recorded for the discovery cache
+ * @param[in] con_idx - connection identifier
+ * @return void
+ ****************************************************************************************
+ */
+static void start_full_discovery(uint8_t con_idx)
+{
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	
+	gatt_disc_start(&periph->disc, disc_filter, DISC_CHAR_COUNT);
+	periph->disc_state = DISC_STATE_DISCOVERY;
+	periph->disc_stale = false;
+	
+#ifdef ENABLE_IAS		
+	periph->serv_disc.ias_handle_valid = false;
+#endif
+#ifdef ENABLE_BAS
+	periph->serv_disc.bas_handle_valid = false;
+#endif
+	periph->serv_disc.last_handle = 1;
+	
+	user_gatt_discover_all_services(con_idx, 1);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Store the handles of a full discovery in the discovery cache
+ * @param[in] con_idx - connection identifier
+ * @param[in] hash - Database Hash of the peer, NULL if it has none
+ * @return void
+ ****************************************************************************************
+ */
+static void store_discovered_handles(uint8_t con_idx, const uint8_t *hash)
+{
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	
+	periph->disc_state = DISC_STATE_DONE;
+	if(!gatt_cache_store(&gatt_sleep_cache, periph->addr.addr, periph->addr_type, &periph->disc, hash))
+	{
+		dbg_printf("Discovery cache: truncated services, peer not cached\r\n", NULL);
+	}
+	
+	handle_service_disc_finished(con_idx);
+}
+
+/**
+ ****************************************************************************************
+ * @brief After the full discovery, read the Database Hash to store with the handles
+ * @param[in] con_idx - connection identifier
+ * @return void
+ ****************************************************************************************
+ */
+static void handle_full_discovery_finished(uint8_t con_idx)
+{
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	
+	if(periph->disc_stale)
+	{
+		start_full_discovery(con_idx);
+	}
+	else if(periph->disc.chars[DISC_DB_HASH].value_handle != 0)
+	{
+		periph->disc_state = DISC_STATE_HASH_READ;
+		user_gatt_read_simple(con_idx, periph->disc.chars[DISC_DB_HASH].value_handle);
+	}
+	else
+	{
+		store_discovered_handles(con_idx, NULL);
+	}
+}
+
+/**
+ ****************************************************************************************
+ * @brief Database Hash read on reconnection, use the cached handles if it did not change
+ * @param[in] con_idx - connection identifier
+ * @param[in] hash - Database Hash of the peer, NULL if it has none
+ * @return void
+ ****************************************************************************************
+ */
+static void handle_hash_check(uint8_t con_idx, const uint8_t *hash)
+{
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	
+	if(!periph->disc_stale && gatt_cache_hash_match(&periph->cache_entry, hash))
+	{
+		dbg_printf("Discovery cache hit: %s\r\n", format_bd_address(&periph->addr));
+		periph->disc_state = DISC_STATE_CACHED;
+		handle_service_disc_finished(con_idx);
+	}
+	else
+	{
+		dbg_printf("Discovery cache: database changed\r\n", NULL);
+		gatt_cache_remove(&gatt_sleep_cache, periph->addr.addr, periph->addr_type);
+		start_full_discovery(con_idx);
+	}
+}
+
+/**
+ ****************************************************************************************
+ * @brief Service Changed indicated by the peer, the handles are rediscovered
+ * @param[in] con_idx - connection identifier
+ * @return void
+ ****************************************************************************************
+ */
+static void handle_service_changed(uint8_t con_idx)
+{
+	periph_device_t *periph = &central_app_env.periph_devices[con_idx];
+	
+	dbg_printf("Service Changed\r\n", NULL);
+	gatt_cache_remove(&gatt_sleep_cache, periph->addr.addr, periph->addr_type);
+	
+	if(periph->disc_state == DISC_STATE_DONE || periph->disc_state == DISC_STATE_CACHED)
+	{
+		start_full_discovery(con_idx);
+	}
+	else
+	{
+		// A GATT operation is ongoing, discover again when it completes
+		periph->disc_stale = true;
+	}
+}
+
 /**
  ****************************************************************************************
  * @brief Scan for devices
@@ -435,6 +649,7 @@ void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind c
 		dbg_printf("%s\r\n", __func__);
 		
 		central_app_env.periph_devices[connection_idx].addr = param->peer_addr;
+		central_app_env.periph_devices[connection_idx].addr_type = param->peer_addr_type;
 		central_app_env.periph_devices[connection_idx].con_idx = connection_idx;
 		central_app_env.periph_devices[connection_idx].con_valid = true;
 		central_app_env.num_connections++;
@@ -444,14 +659,22 @@ void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind c
 			ble_scan_for_devices();
 		}
 
-#ifdef ENABLE_IAS		
-		central_app_env.periph_devices[connection_idx].serv_disc.ias_handle_valid = false;
-#endif
-#ifdef ENABLE_BAS
-		central_app_env.periph_devices[connection_idx].serv_disc.bas_handle_valid = false;
-#endif
+		central_app_env.periph_devices[connection_idx].disc_stale = false;
 		
-		user_gatt_discover_all_services(connection_idx, 1);
+		if(gatt_cache_lookup(&gatt_sleep_cache, param->peer_addr.addr, param->peer_addr_type, 
+																	&central_app_env.periph_devices[connection_idx].cache_entry))
+		{
+			// Handles are used from the cache if the Database Hash did not change
+			gatt_disc_start(&central_app_env.periph_devices[connection_idx].disc, disc_filter, DISC_CHAR_COUNT);
+			memcpy(central_app_env.periph_devices[connection_idx].disc.chars, 
+							central_app_env.periph_devices[connection_idx].cache_entry.chars, sizeof(struct gatt_disc_char[GATT_DISC_CHAR_MAX]));
+			central_app_env.periph_devices[connection_idx].disc_state = DISC_STATE_HASH_CHECK;
+			user_gatt_read_by_uuid16(connection_idx, ATT_CHAR_DB_HASH);
+		}
+		else
+		{
+			start_full_discovery(connection_idx);
+		}
 }
 
 /**
@@ -536,101 +759,55 @@ void user_app_on_set_dev_config_complete(void)
 		*/
 		default_app_on_set_dev_config_complete();
 	
+		gatt_cache_init(&gatt_sleep_cache);
 		ble_scan_for_devices();
 }
 
 
-static void handle_svc_ind(uint8_t con_idx, struct gattc_sdp_svc_ind const *disc_svc)
+/**
+ ****************************************************************************************
+ * @brief Service found by the discovery. The filtered characteristics are kept by
+ *        gatt_disc_svc, the others are only printed.
+ * @param[in] con_idx - connection identifier
+ * @param[in] disc_svc - service discovery indication
+ * @param[in] len - length of the indication
+ * @return void
+ ****************************************************************************************
+ */
+static void handle_svc_ind(uint8_t con_idx, struct gattc_sdp_svc_ind const *disc_svc, uint16_t len)
 {
-	service_info_t *svc = ke_malloc(user_ble_get_svc_size(disc_svc), KE_MEM_NON_RETENTION);
+	att_uuid_t uuid;
+	uint8_t properties = 0;
+	uint16_t count;
+	uint16_t i;
+	
 	dbg_block_printf("%s: conn_idx=%04x start_h=%04x end_h=%04x\r\n", __func__, con_idx,
                                                                         disc_svc->start_hdl, disc_svc->end_hdl);
 
-	user_gatt_parse_service(disc_svc, svc, con_idx);
-	
-	uint16_t i;
+	gatt_disc_svc(&central_app_env.periph_devices[con_idx].disc, disc_svc, len);
 	
-#ifdef ENABLE_IAS
-	bool ias_uuid_match;
-	uint16_t ias_uuid = ATT_SVC_IMMEDIATE_ALERT;
-	uint16_t ias_alert_uuid = ATT_CHAR_ALERT_LEVEL;
-	if(svc->svc_uuid.type == ATT_UUID_16){
-		ias_uuid_match = match_uuid((uint8_t *)&ias_uuid, (uint8_t *)&svc->svc_uuid.uuid.uuid16, sizeof(uint16_t));
-	}
+	set_att_uuid(&uuid, disc_svc->uuid, disc_svc->uuid_len);
+	dbg_block_printf("%s: \r\n", format_uuid(&uuid) );
 	
-	if(ias_uuid_match){
-		dbg_block_printf("Immediate Alert Service: ", NULL);
-	}
-#endif 
-	
-#ifdef ENABLE_BAS
-	bool bas_uuid_match;
-	uint16_t bas_uuid = ATT_SVC_BATTERY_SERVICE;
-	uint16_t bas_level_uuid= ATT_CHAR_BATTERY_LEVEL;
-	
-	if(svc->svc_uuid.type == ATT_UUID_16){
-		bas_uuid_match = match_uuid((uint8_t *)&bas_uuid, (uint8_t *)&svc->svc_uuid.uuid.uuid16, sizeof(uint16_t));
-	}
-	if(bas_uuid_match){
-		dbg_block_printf("Battery Service: ", NULL);
-	}
-#endif
-	dbg_block_printf("%s: \r\n", format_uuid(&svc->svc_uuid) );
-	for(i = 0 ; i<svc->num_chars; i++)
+	count = gatt_disc_att_count(disc_svc, len);
+	for(i = 0 ; i < count; i++)
 	{
-		gattc_chars_t *gatt_char = &svc->items[i];
-#ifdef ENABLE_IAS
-		if(ias_uuid_match)
+		const union gattc_sdp_att_info *info = &disc_svc->info[i];
+		
+		if(info->att_type == GATTC_SDP_ATT_CHAR)
 		{
-			if( match_uuid( (uint8_t *)&ias_alert_uuid , (uint8_t *)&gatt_char->uuid.uuid, 2) )
-			{
-				memcpy(&central_app_env.periph_devices[con_idx].serv_disc.ias_char, 
-																									gatt_char, sizeof(gattc_chars_t) );
-				
-				central_app_env.periph_devices[con_idx].serv_disc.ias_handle_valid = true;
-				dbg_block_printf("\tAlert Level Char\r\n", NULL);
-				
-				if(gatt_char->c.properties & GATT_PROP_WRITE)
-				{
-					central_app_env.periph_devices[con_idx].serv_disc.ias_write_op = GATTC_WRITE;
-				}
-				else if(gatt_char->c.properties & GATT_PROP_WRITE_NO_RESP)
-				{
-					central_app_env.periph_devices[con_idx].serv_disc.ias_write_op = GATTC_WRITE_NO_RESPONSE;	
-				}
-				else if(gatt_char->c.properties & GATT_PROP_WRITE_SIGNED)
-				{
-					central_app_env.periph_devices[con_idx].serv_disc.ias_write_op = GATTC_WRITE_SIGNED;	
-				}else
-				{		
-					central_app_env.periph_devices[con_idx].serv_disc.ias_handle_valid = false;
-				}
-			}
+			properties = info->att_char.prop;
 		}
-#endif 
-#ifdef ENABLE_BAS
-		if(bas_uuid_match)
+		else if(info->att_type == GATTC_SDP_ATT_VAL)
 		{
-			if( match_uuid( (uint8_t *)&bas_level_uuid , (uint8_t *)&gatt_char->uuid.uuid, 2) )
-			{
-				memcpy(&central_app_env.periph_devices[con_idx].serv_disc.bas_char, 
-																										gatt_char, sizeof(gattc_chars_t));
-				
-				central_app_env.periph_devices[con_idx].serv_disc.bas_handle_valid = true;
-				dbg_block_printf("\tBattery Level Char\r\n", NULL);
-			}
+			set_att_uuid(&uuid, info->att.uuid, info->att.uuid_len);
+			dbg_block_printf("\t%04x char %s prop=%02x (%s)\r\n", disc_svc->start_hdl + i + 1,
+                                                format_uuid(&uuid), properties,
+                                                format_properties(properties));	
 		}
-#endif 
-		dbg_block_printf("\t%04x char %s prop=%02x (%s)\r\n", gatt_char->handle,
-                                                format_uuid(&gatt_char->uuid), gatt_char->c.properties,
-                                                format_properties(gatt_char->c.properties));	
 	}
 	
-	ke_free(svc);
-	
 	central_app_env.periph_devices[con_idx].serv_disc.last_handle = disc_svc->end_hdl;
-	
-	
 }
 
 /**
@@ -668,7 +845,7 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 							user_gatt_discover_all_services(conn_idx, central_app_env.periph_devices[conn_idx].serv_disc.last_handle);
 					}else
 					{
-							handle_service_disc_finished(conn_idx);
+							handle_full_discovery_finished(conn_idx);
 					}
 					
 					
@@ -676,10 +853,34 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 				case GATTC_WRITE:
 				{
 					dbg_printf("Completion Event: GATTC_WRITE\r\n", evt->operation);
+					
+					// A cached handle the peer rejects means its database changed
+					if(evt->status != CO_ERROR_NO_ERROR && 
+								central_app_env.periph_devices[conn_idx].disc_state == DISC_STATE_CACHED)
+					{
+						handle_service_changed(conn_idx);
+					}
 					break;
 				}
 				case GATTC_READ:
 					dbg_printf("GATTC_READ: status: %04x\r\n", evt->status);
+					
+					// Database Hash not read, the handles are used but not cached
+					if(evt->status != CO_ERROR_NO_ERROR && 
+								central_app_env.periph_devices[conn_idx].disc_state == DISC_STATE_HASH_READ)
+					{
+						central_app_env.periph_devices[conn_idx].disc_state = DISC_STATE_DONE;
+						handle_service_disc_finished(conn_idx);
+					}
+					break;
+				case GATTC_READ_BY_UUID:
+					dbg_printf("GATTC_READ_BY_UUID: status: %04x\r\n", evt->status);
+					
+					// No Database Hash read, the peer does not have one
+					if(central_app_env.periph_devices[conn_idx].disc_state == DISC_STATE_HASH_CHECK)
+					{
+						handle_hash_check(conn_idx, NULL);
+					}
 					break;
 				
 				default:
@@ -699,6 +900,20 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 #endif		
 		}break;
 		
+		case GATTC_EVENT_REQ_IND:
+		{
+			struct gattc_event_ind const *ind = (struct gattc_event_ind const *)param;
+			struct gattc_event_cfm *cfm = KE_MSG_ALLOC(GATTC_EVENT_CFM, src_id, dest_id, gattc_event_cfm);
+			cfm->handle = ind->handle;
+			KE_MSG_SEND(cfm);
+			
+			if(ind->handle != 0 && 
+						ind->handle == central_app_env.periph_devices[conn_idx].disc.chars[DISC_SVC_CHANGED].value_handle)
+			{
+				handle_service_changed(conn_idx);
+			}
+		}break;
+		
 		case GAPM_CMP_EVT:
 		{
 			struct gapm_cmp_evt const* evt = (struct gapm_cmp_evt const *)(param);
@@ -716,12 +931,34 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 			struct gattc_sdp_svc_ind const *disc_svc = (struct gattc_sdp_svc_ind const *)(param);
 			
 			uint8_t con_idx = KE_IDX_GET(src_id);
-			handle_svc_ind(con_idx, disc_svc);
+			handle_svc_ind(con_idx, disc_svc, ke_param2msg(param)->param_len);
 		}break;
 		
 		case GATTC_READ_IND:
 		{
 			struct gattc_read_ind const *ind = (struct gattc_read_ind const*)param;
+			periph_device_t *periph = &central_app_env.periph_devices[conn_idx];
+			
+			if(periph->disc_state == DISC_STATE_HASH_CHECK)
+			{
+				handle_hash_check(conn_idx, ind->length == GATT_CACHE_HASH_LEN ? ind->value : NULL);
+			}
+			else if(periph->disc_state == DISC_STATE_HASH_READ && ind->handle == periph->disc.chars[DISC_DB_HASH].value_handle)
+			{
+				if(periph->disc_stale)
+				{
+					start_full_discovery(conn_idx);
+				}
+				else if(ind->length == GATT_CACHE_HASH_LEN)
+				{
+					store_discovered_handles(conn_idx, ind->value);
+				}
+				else
+				{
+					periph->disc_state = DISC_STATE_DONE;
+					handle_service_disc_finished(conn_idx);
+				}
+			}else
 #ifdef ENABLE_BAS
 			if(ind->handle == central_app_env.periph_devices[conn_idx].serv_disc.bas_char.c.value_handle)
 			{
@@ -0,0 +1,166 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_gatt_cache.c
+ *
+ * @brief GATT discovery cache source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "user_gatt_cache.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static bool gatt_cache_same_peer(const struct gatt_cache_entry *entry, const uint8_t *addr, uint8_t addr_type)
+{
+    return (entry->addr_type == addr_type) && (memcmp(entry->addr, addr, sizeof(entry->addr)) == 0);
+}
+
+static struct gatt_cache_entry *gatt_cache_find(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type)
+{
+    uint8_t i;
+
+    for (i = 0; i < GATT_CACHE_SIZE; i++)
+    {
+        if ((cache->entries[i].flags & GATT_CACHE_VALID) &&
+            gatt_cache_same_peer(&cache->entries[i], addr, addr_type))
+        {
+            return &cache->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+void gatt_cache_init(struct gatt_cache *cache)
+{
+    memset(cache, 0, sizeof(struct gatt_cache));
+}
+
+bool gatt_cache_lookup(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                       struct gatt_cache_entry *entry)
+{
+    struct gatt_cache_entry *found = gatt_cache_find(cache, addr, addr_type);
+
+    if (found == NULL)
+    {
+        cache->stats.misses++;
+        return false;
+    }
+
+    cache->stats.hits++;
+    found->last_used = ++cache->clock;
+    memcpy(entry, found, sizeof(struct gatt_cache_entry));
+
+    return true;
+}
+
+bool gatt_cache_hash_match(const struct gatt_cache_entry *entry, const uint8_t *hash)
+{
+    if (hash == NULL)
+    {
+        return !(entry->flags & GATT_CACHE_HAS_HASH);
+    }
+
+    return (entry->flags & GATT_CACHE_HAS_HASH) && (memcmp(entry->db_hash, hash, GATT_CACHE_HASH_LEN) == 0);
+}
+
+bool gatt_cache_store(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                      const struct gatt_disc *disc, const uint8_t *hash)
+{
+    struct gatt_cache_entry *slot;
+    uint8_t i;
+
+    if (disc->truncated)
+    {
+        return false;
+    }
+
+    slot = gatt_cache_find(cache, addr, addr_type);
+    if (slot == NULL)
+    {
+        slot = &cache->entries[0];
+        for (i = 0; i < GATT_CACHE_SIZE; i++)
+        {
+            if (!(cache->entries[i].flags & GATT_CACHE_VALID))
+            {
+                slot = &cache->entries[i];
+                break;
+            }
+            if (cache->entries[i].last_used < slot->last_used)
+            {
+                slot = &cache->entries[i];
+            }
+        }
+
+        if (slot->flags & GATT_CACHE_VALID)
+        {
+            cache->stats.evictions++;
+        }
+    }
+
+    memset(slot, 0, sizeof(struct gatt_cache_entry));
+    memcpy(slot->addr, addr, sizeof(slot->addr));
+    slot->addr_type = addr_type;
+    slot->flags = GATT_CACHE_VALID;
+    memcpy(slot->chars, disc->chars, sizeof(slot->chars));
+    if (hash != NULL)
+    {
+        memcpy(slot->db_hash, hash, GATT_CACHE_HASH_LEN);
+        slot->flags |= GATT_CACHE_HAS_HASH;
+    }
+    slot->last_used = ++cache->clock;
+
+    return true;
+}
+
+void gatt_cache_remove(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type)
+{
+    struct gatt_cache_entry *found = gatt_cache_find(cache, addr, addr_type);
+
+    if (found != NULL)
+    {
+        memset(found, 0, sizeof(struct gatt_cache_entry));
+        cache->stats.removals++;
+    }
+}
+
+/// @} APP
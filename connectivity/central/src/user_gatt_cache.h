@@ -0,0 +1,181 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_gatt_cache.h
+ *
+ * @brief GATT discovery cache header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_GATT_CACHE_H_
+#define _USER_GATT_CACHE_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The characteristics a full discovery found (see user_gatt_disc.h) are stored by peer
+ * address, together with the Database Hash of the peer if it has one.
+ *
+ * On reconnection the Database Hash of the peer is read and compared with the stored
+ * one. The entry is used if they are equal, or if the peer has no Database Hash and
+ * had none before. Otherwise, and whenever the peer indicates a Service Changed, the
+ * entry is removed and the peer discovered again. A discovery with truncated services
+ * is not stored. The least recently used entry is replaced when the cache is full.
+ *
+ * The cache is not persistent: the application keeps it in retention RAM, so it
+ * survives sleep but is emptied by a reset or a power loss. Keeping it across resets
+ * would take a copy in flash, written after gatt_cache_store() and gatt_cache_remove().
+ *
+ * Besides the gattc_sdp_svc_ind layout of gattc_task.h this file has no SDK
+ * dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "user_gatt_disc.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Peers kept in the cache
+#ifndef GATT_CACHE_SIZE
+#define GATT_CACHE_SIZE             (8)
+#endif
+
+/// Database Hash length
+#define GATT_CACHE_HASH_LEN         (16)
+
+/// Entry flags
+#define GATT_CACHE_VALID            (0x01)
+#define GATT_CACHE_HAS_HASH         (0x02)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct gatt_cache_entry
+{
+    uint8_t addr[6];
+    uint8_t addr_type;
+    uint8_t flags;
+    uint8_t db_hash[GATT_CACHE_HASH_LEN];
+    /// Characteristics found, in the order of the discovery filter table
+    struct gatt_disc_char chars[GATT_DISC_CHAR_MAX];
+    /// Value of the cache clock when the entry was last stored or found
+    uint32_t last_used;
+};
+
+struct gatt_cache_stats
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t removals;
+};
+
+struct gatt_cache
+{
+    struct gatt_cache_entry entries[GATT_CACHE_SIZE];
+    uint32_t clock;
+    struct gatt_cache_stats stats;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Empties the cache.
+ * @param[in] cache     Cache.
+ ****************************************************************************************
+ */
+void gatt_cache_init(struct gatt_cache *cache);
+
+/**
+ ****************************************************************************************
+ * @brief Looks up a peer.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Peer address.
+ * @param[in] addr_type Peer address type.
+ * @param[out] entry    Copy of the entry, kept by the connection while the Database
+ *                      Hash is checked.
+ * @return True if the peer was found.
+ ****************************************************************************************
+ */
+bool gatt_cache_lookup(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                       struct gatt_cache_entry *entry);
+
+/**
+ ****************************************************************************************
+ * @brief Compares the Database Hash read from a peer with the one of its entry.
+ * @param[in] entry     Entry.
+ * @param[in] hash      Database Hash read, NULL if the peer has none.
+ * @return True if the entry can be used.
+ ****************************************************************************************
+ */
+bool gatt_cache_hash_match(const struct gatt_cache_entry *entry, const uint8_t *hash);
+
+/**
+ ****************************************************************************************
+ * @brief Stores the result of a full discovery, replacing the entry of the same peer
+ *        or the least recently used one.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Peer address.
+ * @param[in] addr_type Peer address type.
+ * @param[in] disc      Discovery of the connection.
+ * @param[in] hash      Database Hash of the peer, NULL if it has none.
+ * @return False if the discovery was truncated and is not stored.
+ ****************************************************************************************
+ */
+bool gatt_cache_store(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                      const struct gatt_disc *disc, const uint8_t *hash);
+
+/**
+ ****************************************************************************************
+ * @brief Removes a peer, after its database changed.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Peer address.
+ * @param[in] addr_type Peer address type.
+ ****************************************************************************************
+ */
+void gatt_cache_remove(struct gatt_cache *cache, const uint8_t *addr, uint8_t addr_type);
+
+/// @} APP
+
+#endif // _USER_GATT_CACHE_H_
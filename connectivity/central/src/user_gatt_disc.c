@@ -0,0 +1,265 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_gatt_disc.c
+ *
+ * @brief Service discovery engine source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "user_gatt_disc.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define GATT_DISC_UUID_CCC          (0x2902)
+
+#define GATT_DISC_PROP_NOTIFY       (0x10)
+#define GATT_DISC_PROP_INDICATE     (0x20)
+
+#define GATT_DISC_NONE              (0xFF)
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+// Bluetooth Base UUID, little endian, the 16-bit UUID goes in bytes 12 and 13
+static const uint8_t gatt_disc_base_uuid[16] =
+{
+    0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static bool gatt_disc_uuid_match(const struct gatt_disc_uuid *uuid, const uint8_t *att_uuid, uint8_t att_uuid_len)
+{
+    const uint8_t *uuid128;
+    const uint8_t *uuid16;
+
+    if (uuid->len == att_uuid_len)
+    {
+        return memcmp(uuid->uuid, att_uuid, att_uuid_len) == 0;
+    }
+
+    if ((uuid->len == 2) && (att_uuid_len == 16))
+    {
+        uuid16 = uuid->uuid;
+        uuid128 = att_uuid;
+    }
+    else if ((uuid->len == 16) && (att_uuid_len == 2))
+    {
+        uuid16 = att_uuid;
+        uuid128 = uuid->uuid;
+    }
+    else
+    {
+        return false;
+    }
+
+    return (uuid128[12] == uuid16[0]) && (uuid128[13] == uuid16[1]) &&
+           (memcmp(uuid128, gatt_disc_base_uuid, 12) == 0) && (uuid128[14] == 0) && (uuid128[15] == 0);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Finds the filter a characteristic value belongs to.
+ * @param[in] disc          State of the connection.
+ * @param[in] candidates    Filters of the service, one bit per filter.
+ * @param[in] att           Characteristic value attribute.
+ * @param[in] handle        Handle of the attribute.
+ * @return Index of the filter, GATT_DISC_NONE if it is not filtered or already found.
+ ****************************************************************************************
+ */
+static uint8_t gatt_disc_char_match(const struct gatt_disc *disc, uint8_t candidates,
+                                    const struct gattc_sdp_att *att, uint16_t handle)
+{
+    uint8_t id;
+    uint8_t i;
+
+    for (id = 0; id < disc->filter_len; id++)
+    {
+        if (!(candidates & (1 << id)) || (disc->chars[id].value_handle != 0) ||
+            !gatt_disc_uuid_match(&disc->filter[id].chr, att->uuid, att->uuid_len))
+        {
+            continue;
+        }
+
+        // A service reported again, when the discovery is resumed, is not added twice
+        for (i = 0; i < disc->filter_len; i++)
+        {
+            if (disc->chars[i].value_handle == handle)
+            {
+                return GATT_DISC_NONE;
+            }
+        }
+
+        return id;
+    }
+
+    return GATT_DISC_NONE;
+}
+
+void gatt_disc_start(struct gatt_disc *disc, const struct gatt_disc_filter *filter, uint8_t filter_len)
+{
+    memset(disc, 0, sizeof(struct gatt_disc));
+    disc->filter = filter;
+    disc->filter_len = (filter_len < GATT_DISC_CHAR_MAX) ? filter_len : GATT_DISC_CHAR_MAX;
+}
+
+uint16_t gatt_disc_att_count(struct gattc_sdp_svc_ind const *svc, uint16_t len)
+{
+    uint16_t count;
+    uint16_t max;
+
+    if (len < offsetof(struct gattc_sdp_svc_ind, info))
+    {
+        return 0;
+    }
+
+    count = (svc->end_hdl > svc->start_hdl) ? (svc->end_hdl - svc->start_hdl) : 0;
+    max = (len - offsetof(struct gattc_sdp_svc_ind, info)) / sizeof(union gattc_sdp_att_info);
+
+    return (count < max) ? count : max;
+}
+
+uint8_t gatt_disc_svc(struct gatt_disc *disc, struct gattc_sdp_svc_ind const *svc, uint16_t len)
+{
+    uint8_t candidates = 0;
+    uint8_t current = GATT_DISC_NONE;
+    uint8_t properties = 0;
+    uint8_t found = 0;
+    uint16_t count;
+    uint16_t i;
+
+    if (len < offsetof(struct gattc_sdp_svc_ind, info))
+    {
+        disc->truncated++;
+        return 0;
+    }
+
+    for (i = 0; i < disc->filter_len; i++)
+    {
+        if (gatt_disc_uuid_match(&disc->filter[i].svc, svc->uuid, svc->uuid_len))
+        {
+            candidates |= 1 << i;
+        }
+    }
+
+    if (candidates == 0)
+    {
+        return 0;
+    }
+
+    // Entry i describes the attribute at handle start_hdl + i + 1
+    count = gatt_disc_att_count(svc, len);
+    if ((svc->end_hdl > svc->start_hdl) && (count < svc->end_hdl - svc->start_hdl))
+    {
+        // Filtered characteristics may be missing
+        disc->truncated++;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        const union gattc_sdp_att_info *info = &svc->info[i];
+        uint16_t handle = svc->start_hdl + i + 1;
+
+        switch (info->att_type)
+        {
+            case GATTC_SDP_ATT_CHAR:
+            {
+                properties = info->att_char.prop;
+                current = GATT_DISC_NONE;
+            } break;
+
+            case GATTC_SDP_ATT_VAL:
+            {
+                current = gatt_disc_char_match(disc, candidates, &info->att, handle);
+                if (current != GATT_DISC_NONE)
+                {
+                    disc->chars[current].value_handle = handle;
+                    disc->chars[current].properties = properties;
+                    found++;
+                }
+            } break;
+
+            case GATTC_SDP_ATT_DESC:
+            {
+                if ((current != GATT_DISC_NONE) && (disc->chars[current].ccc_handle == 0) &&
+                    (info->att.uuid_len == 2) &&
+                    ((info->att.uuid[0] | (info->att.uuid[1] << 8)) == GATT_DISC_UUID_CCC))
+                {
+                    disc->chars[current].ccc_handle = handle;
+                }
+            } break;
+
+            case GATTC_SDP_INC_SVC:
+            {
+                current = GATT_DISC_NONE;
+            } break;
+
+            default:
+                break;
+        }
+    }
+
+    return found;
+}
+
+uint16_t gatt_disc_ccc_value(const struct gatt_disc *disc, uint8_t id)
+{
+    if ((id >= disc->filter_len) || !(disc->filter[id].flags & GATT_DISC_SUBSCRIBE) ||
+        (disc->chars[id].ccc_handle == 0))
+    {
+        return 0;
+    }
+
+    if (disc->chars[id].properties & GATT_DISC_PROP_INDICATE)
+    {
+        return 0x0002;
+    }
+
+    return (disc->chars[id].properties & GATT_DISC_PROP_NOTIFY) ? 0x0001 : 0;
+}
+
+/// @} APP
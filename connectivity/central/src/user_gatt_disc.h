@@ -0,0 +1,170 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_gatt_disc.h
+ *
+ * @brief Service discovery engine header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_GATT_DISC_H_
+#define _USER_GATT_DISC_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The application lists the characteristics it uses in a filter table, by service and
+ * characteristic UUID. Each service discovery indication is walked once: services
+ * without a filter are skipped, and for the others the value handle, the properties
+ * and the Client Characteristic Configuration descriptor of the filtered
+ * characteristics are kept, in the slot of the filter. A 16-bit UUID matches the same
+ * UUID written as a 128-bit one on the Bluetooth Base UUID. When a characteristic
+ * appears more than once, the first instance is kept; listing the same filter twice
+ * keeps the first two.
+ *
+ * The state is kept per connection and nothing is allocated, so several links can
+ * discover at the same time. The number of attributes walked is bounded by the
+ * message length, so a truncated indication is not read past its end. Truncated
+ * services with filters are counted.
+ *
+ * Besides the gattc_sdp_svc_ind layout of gattc_task.h this file has no SDK
+ * dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gattc_task.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Filters, and characteristics found, per connection
+#define GATT_DISC_CHAR_MAX          (6)
+
+/// Filter flags: enable notifications or indications of the characteristic
+#define GATT_DISC_SUBSCRIBE         (0x01)
+
+/// 16-bit UUID initializer
+#define GATT_DISC_UUID16(uuid)      {2, {(uuid) & 0xFF, (uuid) >> 8}}
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct gatt_disc_uuid
+{
+    uint8_t len;
+    uint8_t uuid[16];
+};
+
+struct gatt_disc_filter
+{
+    struct gatt_disc_uuid svc;
+    struct gatt_disc_uuid chr;
+    uint8_t flags;
+};
+
+struct gatt_disc_char
+{
+    /// Value handle, 0 if the characteristic was not found
+    uint16_t value_handle;
+    /// Client Characteristic Configuration descriptor, 0 if it has none
+    uint16_t ccc_handle;
+    uint8_t properties;
+};
+
+struct gatt_disc
+{
+    const struct gatt_disc_filter *filter;
+    uint8_t filter_len;
+    /// Indications cut short by their length
+    uint8_t truncated;
+    /// Characteristics found, in the order of the filter table
+    struct gatt_disc_char chars[GATT_DISC_CHAR_MAX];
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Starts a discovery.
+ * @param[out] disc         State of the connection.
+ * @param[in] filter        Filter table, kept until the discovery ends.
+ * @param[in] filter_len    Filters in the table, at most GATT_DISC_CHAR_MAX.
+ ****************************************************************************************
+ */
+void gatt_disc_start(struct gatt_disc *disc, const struct gatt_disc_filter *filter, uint8_t filter_len);
+
+/**
+ ****************************************************************************************
+ * @brief Walks a service discovery indication.
+ * @param[in,out] disc      State of the connection.
+ * @param[in] svc           Service discovery indication.
+ * @param[in] len           Length of the indication.
+ * @return Characteristics found in the service.
+ ****************************************************************************************
+ */
+uint8_t gatt_disc_svc(struct gatt_disc *disc, struct gattc_sdp_svc_ind const *svc, uint16_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the number of attributes of a service discovery indication, bounded by
+ *        its length.
+ * @param[in] svc           Service discovery indication.
+ * @param[in] len           Length of the indication.
+ * @return Attributes, the first one at handle start_hdl + 1.
+ ****************************************************************************************
+ */
+uint16_t gatt_disc_att_count(struct gattc_sdp_svc_ind const *svc, uint16_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the value to write to the CCC descriptor of a characteristic.
+ * @param[in] disc          State of the connection.
+ * @param[in] id            Index of the filter.
+ * @return 0x0002 for indications, 0x0001 for notifications, 0 if the filter does not
+ *         subscribe or the characteristic was not found or cannot notify.
+ ****************************************************************************************
+ */
+uint16_t gatt_disc_ccc_value(const struct gatt_disc *disc, uint8_t id);
+
+/// @} APP
+
+#endif // _USER_GATT_DISC_H_
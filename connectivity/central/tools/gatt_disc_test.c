@@ -0,0 +1,438 @@
+/**
+ ****************************************************************************************
+ *
+ * @file gatt_disc_test.c
+ *
+ * @brief Host test of the GATT discovery engine and of the discovery cache.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -I../../helpers/host_stub -Isrc -o gatt_disc_test tools/gatt_disc_test.c src/user_gatt_disc.c src/user_gatt_cache.c
+ *   ./gatt_disc_test
+ *
+ * Feeds synthetic service discovery indications to the engine: 16- and 128-bit UUIDs,
+ * a characteristic found twice, a resumed service, truncated indications and two links
+ * discovered at the same time. The results are then stored in the cache, which is
+ * checked for Database Hash matching, truncated discoveries, removal and LRU eviction.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "user_gatt_disc.h"
+#include "user_gatt_cache.h"
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+#define ATT_MAX         (128)
+#define SVC_MAX         (16)
+
+struct svc_rec
+{
+    struct gattc_sdp_svc_ind *svc;
+    uint16_t len;
+};
+
+static struct gattc_sdp_svc_ind *svc;
+static int att;
+
+static const uint8_t base_uuid[16] = {0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80,
+                                      0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t vendor_svc[16] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80,
+                                       0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0xE0, 0xF0, 0x01};
+static const uint8_t vendor_chr[16] = {0x11, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80,
+                                       0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0xE0, 0xF0, 0x01};
+
+enum
+{
+    F_SC,
+    F_HASH,
+    F_BAS,
+    F_IAS,
+    F_VND,
+    F_VND2,
+    F_NB
+};
+
+static struct gatt_disc_filter filter[F_NB] =
+{
+    {GATT_DISC_UUID16(0x1801), GATT_DISC_UUID16(0x2A05), GATT_DISC_SUBSCRIBE},
+    {GATT_DISC_UUID16(0x1801), GATT_DISC_UUID16(0x2B2A), 0},
+    {GATT_DISC_UUID16(0x180F), GATT_DISC_UUID16(0x2A19), GATT_DISC_SUBSCRIBE},
+    {GATT_DISC_UUID16(0x1802), GATT_DISC_UUID16(0x2A06), 0},
+};
+
+static void as128(uint16_t uuid, uint8_t *out)
+{
+    memcpy(out, base_uuid, 16);
+    out[12] = uuid & 0xFF;
+    out[13] = uuid >> 8;
+}
+
+static void svc_begin(const uint8_t *uuid, uint8_t len, uint16_t start)
+{
+    svc = calloc(1, sizeof(*svc) + ATT_MAX * sizeof(union gattc_sdp_att_info));
+    svc->uuid_len = len;
+    memcpy(svc->uuid, uuid, len);
+    svc->start_hdl = start;
+    att = 0;
+}
+
+static void svc16(uint16_t uuid, uint16_t start)
+{
+    uint8_t b[2] = {uuid & 0xFF, uuid >> 8};
+
+    svc_begin(b, 2, start);
+}
+
+static void desc16(uint16_t uuid)
+{
+    svc->info[att].att.att_type = GATTC_SDP_ATT_DESC;
+    svc->info[att].att.uuid_len = 2;
+    svc->info[att].att.uuid[0] = uuid & 0xFF;
+    svc->info[att].att.uuid[1] = uuid >> 8;
+    att++;
+}
+
+static void chr(const uint8_t *uuid, uint8_t len, uint8_t prop, int ccc, int other_desc)
+{
+    svc->info[att].att_char.att_type = GATTC_SDP_ATT_CHAR;
+    svc->info[att].att_char.prop = prop;
+    svc->info[att].att_char.handle = svc->start_hdl + att + 2;
+    att++;
+    svc->info[att].att.att_type = GATTC_SDP_ATT_VAL;
+    svc->info[att].att.uuid_len = len;
+    memcpy(svc->info[att].att.uuid, uuid, len);
+    att++;
+    if (other_desc)
+    {
+        desc16(0x2901);
+    }
+    if (ccc)
+    {
+        desc16(0x2902);
+    }
+}
+
+static void chr16(uint16_t uuid, uint8_t prop, int ccc)
+{
+    uint8_t b[2] = {uuid & 0xFF, uuid >> 8};
+
+    chr(b, 2, prop, ccc, 0);
+}
+
+static uint16_t svc_end(struct svc_rec *rec)
+{
+    svc->end_hdl = svc->start_hdl + att;
+    rec->svc = svc;
+    rec->len = offsetof(struct gattc_sdp_svc_ind, info) + att * sizeof(union gattc_sdp_att_info);
+
+    return svc->end_hdl + 1;
+}
+
+/*
+ * GATT (Service Changed, Database Hash), GAP, Battery (16- or 128-bit UUIDs), Immediate
+ * Alert, a vendor service with its characteristic twice, then unfiltered services.
+ */
+static int layout(struct svc_rec *rec, int bas128, int noise)
+{
+    uint8_t uuid[16];
+    uint16_t h = 1;
+    int k = 0, j, c;
+
+    svc16(0x1801, h);
+    chr16(0x2A05, 0x20, 1);
+    chr16(0x2B2A, 0x02, 0);
+    h = svc_end(&rec[k++]);
+
+    svc16(0x1800, h);
+    chr16(0x2A00, 0x02, 0);
+    chr16(0x2A01, 0x02, 0);
+    h = svc_end(&rec[k++]);
+
+    if (bas128)
+    {
+        as128(0x180F, uuid);
+        svc_begin(uuid, 16, h);
+        as128(0x2A19, uuid);
+        chr(uuid, 16, 0x12, 1, 1);
+    }
+    else
+    {
+        svc16(0x180F, h);
+        chr16(0x2A19, 0x12, 1);
+    }
+    h = svc_end(&rec[k++]);
+
+    svc16(0x1802, h);
+    chr16(0x2A06, 0x04, 0);
+    h = svc_end(&rec[k++]);
+
+    svc_begin(vendor_svc, 16, h);
+    chr(vendor_chr, 16, 0x10, 1, 1);
+    chr(vendor_chr, 16, 0x30, 1, 0);
+    h = svc_end(&rec[k++]);
+
+    for (j = 0; j < noise; j++)
+    {
+        svc16(0xFE00 + j, h);
+        for (c = 0; c < 12; c++)
+        {
+            chr16(0x3000 + c, 0x12, 1);
+        }
+        h = svc_end(&rec[k++]);
+    }
+
+    return k;
+}
+
+static void discover(struct gatt_disc *disc, const struct svc_rec *rec, int k)
+{
+    int i;
+
+    gatt_disc_start(disc, filter, F_NB);
+    for (i = 0; i < k; i++)
+    {
+        gatt_disc_svc(disc, rec[i].svc, rec[i].len);
+    }
+}
+
+static void test_layouts(void)
+{
+    struct svc_rec rec[SVC_MAX];
+    struct gatt_disc disc;
+    int bas128, k;
+
+    for (bas128 = 0; bas128 < 2; bas128++)
+    {
+        k = layout(rec, bas128, 2);
+        discover(&disc, rec, k);
+        // A resumed discovery reports the vendor service again
+        gatt_disc_svc(&disc, rec[4].svc, rec[4].len);
+
+        CHECK(disc.chars[F_SC].value_handle == 3 && disc.chars[F_SC].ccc_handle == 4);
+        CHECK(gatt_disc_ccc_value(&disc, F_SC) == 0x0002);
+        CHECK(disc.chars[F_HASH].value_handle == 6 && disc.chars[F_HASH].ccc_handle == 0);
+        CHECK(gatt_disc_ccc_value(&disc, F_HASH) == 0);
+        CHECK(disc.chars[F_BAS].value_handle != 0);
+        CHECK(disc.chars[F_BAS].ccc_handle == disc.chars[F_BAS].value_handle + 1 + bas128);
+        CHECK(gatt_disc_ccc_value(&disc, F_BAS) == 0x0001);
+        CHECK(disc.chars[F_IAS].value_handle != 0 && disc.chars[F_IAS].ccc_handle == 0);
+        CHECK(disc.chars[F_VND].value_handle != 0);
+        CHECK(disc.chars[F_VND2].value_handle > disc.chars[F_VND].value_handle);
+        CHECK(gatt_disc_ccc_value(&disc, F_VND2) == 0x0002);
+        CHECK(disc.truncated == 0);
+    }
+
+    // A 128-bit UUID that is not on the Base UUID does not match a 16-bit filter
+    {
+        uint8_t uuid[16];
+
+        as128(0x180F, uuid);
+        uuid[0] ^= 1;
+        svc_begin(uuid, 16, 1);
+        as128(0x2A19, uuid);
+        chr(uuid, 16, 0x12, 1, 0);
+        svc_end(&rec[0]);
+        gatt_disc_start(&disc, filter, F_NB);
+        CHECK(gatt_disc_svc(&disc, rec[0].svc, rec[0].len) == 0);
+    }
+}
+
+static void test_truncated(void)
+{
+    struct svc_rec rec[SVC_MAX];
+    struct gatt_disc disc;
+    uint16_t end;
+    int i, k;
+
+    // Battery service cut after its value, then a cut header
+    k = layout(rec, 0, 0);
+    gatt_disc_start(&disc, filter, F_NB);
+    for (i = 0; i < k; i++)
+    {
+        gatt_disc_svc(&disc, rec[i].svc,
+                      (i == 2) ? rec[i].len - sizeof(union gattc_sdp_att_info) : rec[i].len);
+    }
+    CHECK(disc.truncated == 1);
+    CHECK(disc.chars[F_BAS].value_handle != 0 && disc.chars[F_BAS].ccc_handle == 0);
+    CHECK(gatt_disc_svc(&disc, rec[0].svc, 3) == 0 && disc.truncated == 2);
+
+    // An unfiltered service cut short is not counted
+    gatt_disc_start(&disc, filter, F_NB);
+    gatt_disc_svc(&disc, rec[1].svc, rec[1].len - 10);
+    CHECK(disc.truncated == 0);
+
+    // End handle below the start handle
+    end = rec[0].svc->end_hdl;
+    rec[0].svc->end_hdl = 0;
+    gatt_disc_start(&disc, filter, F_NB);
+    CHECK(gatt_disc_svc(&disc, rec[0].svc, rec[0].len) == 0);
+    rec[0].svc->end_hdl = end;
+}
+
+static void test_two_links(void)
+{
+    struct svc_rec rec1[SVC_MAX], rec2[SVC_MAX];
+    struct gatt_disc disc1, disc2, alone1, alone2;
+    int k1 = layout(rec1, 0, 3);
+    int k2 = layout(rec2, 1, 1);
+    int i;
+
+    gatt_disc_start(&disc1, filter, F_NB);
+    gatt_disc_start(&disc2, filter, F_NB);
+    for (i = 0; i < k1 || i < k2; i++)
+    {
+        if (i < k1)
+        {
+            gatt_disc_svc(&disc1, rec1[i].svc, rec1[i].len);
+        }
+        if (i < k2)
+        {
+            gatt_disc_svc(&disc2, rec2[i].svc, rec2[i].len);
+        }
+    }
+    discover(&alone1, rec1, k1);
+    discover(&alone2, rec2, k2);
+
+    CHECK(memcmp(disc1.chars, alone1.chars, sizeof(alone1.chars)) == 0);
+    CHECK(memcmp(disc2.chars, alone2.chars, sizeof(alone2.chars)) == 0);
+}
+
+static void test_cache(void)
+{
+    static struct gatt_cache cache;
+    struct svc_rec rec[SVC_MAX];
+    struct gatt_cache_entry entry;
+    struct gatt_disc disc, moved;
+    uint8_t addr[6] = {1, 2, 3, 4, 5, 6};
+    uint8_t no_hash_addr[6] = {9, 9, 9, 9, 9, 9};
+    uint8_t hash[GATT_CACHE_HASH_LEN], hash2[GATT_CACHE_HASH_LEN];
+    int p;
+
+    memset(hash, 0xAB, sizeof(hash));
+    memset(hash2, 0xCD, sizeof(hash2));
+    discover(&disc, rec, layout(rec, 0, 1));
+    discover(&moved, rec, layout(rec, 1, 2));
+
+    gatt_cache_init(&cache);
+    CHECK(!gatt_cache_lookup(&cache, addr, 0, &entry));
+    CHECK(gatt_cache_store(&cache, addr, 0, &disc, hash));
+    CHECK(gatt_cache_lookup(&cache, addr, 0, &entry));
+    CHECK(memcmp(entry.chars, disc.chars, sizeof(disc.chars)) == 0);
+    CHECK(gatt_cache_hash_match(&entry, hash));
+    CHECK(!gatt_cache_hash_match(&entry, hash2) && !gatt_cache_hash_match(&entry, NULL));
+    CHECK(!gatt_cache_lookup(&cache, addr, 1, &entry));
+
+    // A peer without Database Hash matches only without hash
+    CHECK(gatt_cache_store(&cache, no_hash_addr, 0, &disc, NULL));
+    CHECK(gatt_cache_lookup(&cache, no_hash_addr, 0, &entry));
+    CHECK(gatt_cache_hash_match(&entry, NULL) && !gatt_cache_hash_match(&entry, hash));
+
+    // The database changed: the entry is removed, the new discovery replaces it
+    gatt_cache_remove(&cache, addr, 0);
+    CHECK(!gatt_cache_lookup(&cache, addr, 0, &entry));
+    CHECK(gatt_cache_store(&cache, addr, 0, &moved, hash2));
+    CHECK(gatt_cache_lookup(&cache, addr, 0, &entry));
+    CHECK(memcmp(entry.chars, moved.chars, sizeof(moved.chars)) == 0);
+
+    // A truncated discovery is not stored
+    moved.truncated = 1;
+    gatt_cache_remove(&cache, addr, 0);
+    CHECK(!gatt_cache_store(&cache, addr, 0, &moved, hash));
+    CHECK(!gatt_cache_lookup(&cache, addr, 0, &entry));
+
+    // Least recently used eviction, peer 0 kept in use
+    gatt_cache_init(&cache);
+    for (p = 0; p < GATT_CACHE_SIZE + 3; p++)
+    {
+        uint8_t peer[6] = {p};
+        uint8_t hot[6] = {0};
+
+        gatt_cache_store(&cache, peer, 0, &disc, NULL);
+        CHECK(gatt_cache_lookup(&cache, hot, 0, &entry));
+    }
+    {
+        uint8_t first[6] = {1};
+        uint8_t last[6] = {GATT_CACHE_SIZE + 2};
+
+        CHECK(!gatt_cache_lookup(&cache, first, 0, &entry));
+        CHECK(gatt_cache_lookup(&cache, last, 0, &entry));
+    }
+    CHECK(cache.stats.evictions == 3);
+    printf("cache: entry %u bytes, %u peers in %u bytes of retention RAM\n",
+           (unsigned)sizeof(struct gatt_cache_entry), GATT_CACHE_SIZE, (unsigned)sizeof(struct gatt_cache));
+}
+
+static void time_engine(void)
+{
+    struct svc_rec rec[SVC_MAX];
+    struct gatt_disc disc;
+    struct timespec t0, t1;
+    int k = layout(rec, 0, 6);
+    int n = 200000, it;
+    double ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (it = 0; it < n; it++)
+    {
+        discover(&disc, rec, k);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;
+    printf("engine: %.0f ns per %d-service discovery\n", ns, k);
+}
+
+int main(void)
+{
+    memcpy(filter[F_VND].svc.uuid, vendor_svc, 16);
+    filter[F_VND].svc.len = 16;
+    memcpy(filter[F_VND].chr.uuid, vendor_chr, 16);
+    filter[F_VND].chr.len = 16;
+    filter[F_VND].flags = GATT_DISC_SUBSCRIBE;
+    filter[F_VND2] = filter[F_VND];
+
+    test_layouts();
+    test_truncated();
+    test_two_links();
+    test_cache();
+    time_engine();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
@@ -131,12 +131,12 @@ static const struct app_callbacks user_app_callbacks = {
     .app_on_irk_exch                    = NULL,
     .app_on_csrk_exch                   = NULL,
     .app_on_ltk_exch                    = default_app_on_ltk_exch,
-    .app_on_pairing_succeeded           = NULL,
-    .app_on_encrypt_ind                 = NULL,
+    .app_on_pairing_succeeded           = user_on_pairing_succeeded,
+    .app_on_encrypt_ind                 = user_on_encrypt_ind,
     .app_on_encrypt_req_ind             = NULL,
     .app_on_security_req_ind            = NULL,
-    .app_on_addr_solved_ind             = NULL,
-    .app_on_addr_resolve_failed         = NULL,
+    .app_on_addr_solved_ind             = user_on_addr_solved_ind,
+    .app_on_addr_resolve_failed         = user_on_addr_resolve_failed,
 #if !defined (__DA14531_01__) && !defined (__DA14535__)
     .app_on_ral_cmp_evt                 = NULL,
     .app_on_ral_size_ind                = NULL,
@@ -165,7 +165,7 @@ static const struct default_app_operations user_default_app_operations = {
 };
 
 static const struct arch_main_loop_callbacks user_app_main_loop_callbacks = {
-    .app_on_init            = default_app_on_init,
+    .app_on_init            = user_app_on_init,
 
     // By default the watchdog timer is reloaded and resumed when the system wakes up.
     // The user has to take into account the watchdog timer handling (keep it running,
@@ -0,0 +1,412 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_bond_cache.c
+ *
+ * @brief Bonded peer cache source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "user_bond_cache.h"
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+// CRC-16/CCITT (polynomial 0x1021), one nibble at a time
+static const uint16_t bond_cache_crc_table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint16_t bond_cache_crc(const uint8_t *data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--)
+    {
+        crc = (crc << 4) ^ bond_cache_crc_table[(crc >> 12) ^ (*data >> 4)];
+        crc = (crc << 4) ^ bond_cache_crc_table[(crc >> 12) ^ (*data & 0x0F)];
+        data++;
+    }
+
+    return crc;
+}
+
+static void bond_cache_seal(struct bond_cache_entry *entry)
+{
+    entry->crc = bond_cache_crc((const uint8_t *)entry, offsetof(struct bond_cache_entry, crc));
+}
+
+/**
+ ****************************************************************************************
+ * @brief Forgets the addresses resolved to an entry, or to no entry.
+ ****************************************************************************************
+ */
+static void bond_cache_forget_rpa(struct bond_cache *cache, uint8_t entry)
+{
+    uint8_t i;
+
+    for (i = 0; i < BOND_CACHE_RPA_SIZE; i++)
+    {
+        if (cache->rpa[i].entry == entry)
+        {
+            memset(&cache->rpa[i], 0, sizeof(struct bond_cache_rpa));
+        }
+    }
+}
+
+static void bond_cache_drop(struct bond_cache *cache, uint8_t idx)
+{
+    memset(&cache->entries[idx], 0, sizeof(struct bond_cache_entry));
+    bond_cache_forget_rpa(cache, idx);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Checks the CRC of an entry about to be used, a corrupted entry is dropped.
+ ****************************************************************************************
+ */
+static bool bond_cache_check(struct bond_cache *cache, uint8_t idx)
+{
+    struct bond_cache_entry *entry = &cache->entries[idx];
+
+    if (entry->crc == bond_cache_crc((const uint8_t *)entry, offsetof(struct bond_cache_entry, crc)))
+    {
+        return true;
+    }
+
+    cache->stats.crc_errors++;
+    bond_cache_drop(cache, idx);
+
+    return false;
+}
+
+static const struct bond_cache_entry *bond_cache_hit(struct bond_cache *cache, uint8_t idx, uint32_t *counter)
+{
+    (*counter)++;
+    cache->entries[idx].last_used = ++cache->clock;
+
+    return &cache->entries[idx];
+}
+
+static bool bond_cache_has_irk(const struct bond_cache *cache, uint8_t idx)
+{
+    return (cache->entries[idx].flags & (BOND_CACHE_VALID | BOND_CACHE_HAS_IRK)) ==
+           (BOND_CACHE_VALID | BOND_CACHE_HAS_IRK);
+}
+
+static struct bond_cache_rpa *bond_cache_rpa_lookup(struct bond_cache *cache, const uint8_t *addr)
+{
+    uint8_t i;
+
+    // An empty slot never matches, a private address is never all zero
+    for (i = 0; i < BOND_CACHE_RPA_SIZE; i++)
+    {
+        if (memcmp(cache->rpa[i].addr, addr, BOND_CACHE_ADDR_LEN) == 0)
+        {
+            return &cache->rpa[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void bond_cache_rpa_record(struct bond_cache *cache, const uint8_t *addr, uint8_t entry)
+{
+    struct bond_cache_rpa *rpa = &cache->rpa[cache->rpa_next];
+
+    memcpy(rpa->addr, addr, BOND_CACHE_ADDR_LEN);
+    rpa->entry = entry;
+    cache->rpa_next = (cache->rpa_next + 1) % BOND_CACHE_RPA_SIZE;
+}
+
+void bond_cache_init(struct bond_cache *cache)
+{
+    memset(cache, 0, sizeof(struct bond_cache));
+}
+
+bool bond_cache_is_rpa(const uint8_t *addr, uint8_t addr_type)
+{
+    return (addr_type == BOND_CACHE_ADDR_RAND) && ((addr[5] & 0xC0) == 0x40);
+}
+
+void bond_cache_store(struct bond_cache *cache, const struct bond_cache_entry *keys)
+{
+    struct bond_cache_entry *slot = NULL;
+    uint8_t i, idx = 0;
+
+    for (i = 0; i < BOND_CACHE_SIZE; i++)
+    {
+        const struct bond_cache_entry *entry = &cache->entries[i];
+
+        if ((entry->flags & BOND_CACHE_VALID) && (entry->addr_type == keys->addr_type) &&
+            (memcmp(entry->addr, keys->addr, BOND_CACHE_ADDR_LEN) == 0))
+        {
+            idx = i;
+            slot = &cache->entries[i];
+            break;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        for (i = 0; i < BOND_CACHE_SIZE; i++)
+        {
+            if (!(cache->entries[i].flags & BOND_CACHE_VALID))
+            {
+                idx = i;
+                break;
+            }
+            if (cache->entries[i].last_used < cache->entries[idx].last_used)
+            {
+                idx = i;
+            }
+        }
+        slot = &cache->entries[idx];
+
+        if (slot->flags & BOND_CACHE_VALID)
+        {
+            cache->stats.evictions++;
+        }
+    }
+
+    bond_cache_forget_rpa(cache, idx);
+    bond_cache_forget_rpa(cache, BOND_CACHE_NONE);
+    cache->restart = cache->in_flight;
+
+    memcpy(slot, keys, offsetof(struct bond_cache_entry, crc));
+    slot->flags = (keys->flags & BOND_CACHE_HAS_IRK) | BOND_CACHE_VALID;
+    bond_cache_seal(slot);
+    slot->last_used = ++cache->clock;
+}
+
+const struct bond_cache_entry *bond_cache_find(struct bond_cache *cache, const uint8_t *addr,
+                                               uint8_t addr_type)
+{
+    struct bond_cache_rpa *rpa;
+    uint8_t i;
+
+    for (i = 0; i < BOND_CACHE_SIZE; i++)
+    {
+        const struct bond_cache_entry *entry = &cache->entries[i];
+
+        if ((entry->flags & BOND_CACHE_VALID) && (entry->addr_type == addr_type) &&
+            (memcmp(entry->addr, addr, BOND_CACHE_ADDR_LEN) == 0) && bond_cache_check(cache, i))
+        {
+            return bond_cache_hit(cache, i, &cache->stats.id_hits);
+        }
+    }
+
+    if (!bond_cache_is_rpa(addr, addr_type))
+    {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    // A corrupted entry is dropped together with its addresses
+    rpa = bond_cache_rpa_lookup(cache, addr);
+    if ((rpa != NULL) && (rpa->entry != BOND_CACHE_NONE) && bond_cache_check(cache, rpa->entry))
+    {
+        return bond_cache_hit(cache, rpa->entry, &cache->stats.rpa_hits);
+    }
+
+    cache->stats.misses++;
+
+    return NULL;
+}
+
+void bond_cache_set_sec_lvl(struct bond_cache *cache, const struct bond_cache_entry *entry,
+                            uint8_t sec_lvl)
+{
+    struct bond_cache_entry *slot = &cache->entries[entry - cache->entries];
+
+    if ((slot->flags & BOND_CACHE_VALID) && (slot->sec_lvl != sec_lvl))
+    {
+        slot->sec_lvl = sec_lvl;
+        bond_cache_seal(slot);
+    }
+}
+
+void bond_cache_remove(struct bond_cache *cache, const struct bond_cache_entry *entry)
+{
+    bond_cache_drop(cache, entry - cache->entries);
+}
+
+bool bond_cache_rpa_known(struct bond_cache *cache, const uint8_t *addr)
+{
+    return bond_cache_rpa_lookup(cache, addr) != NULL;
+}
+
+void bond_cache_rpa_seen(struct bond_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                         bool urgent)
+{
+    uint8_t pos = cache->pending_count;
+    uint8_t i;
+
+    if (!bond_cache_is_rpa(addr, addr_type) || (bond_cache_rpa_lookup(cache, addr) != NULL))
+    {
+        return;
+    }
+
+    for (i = 0; i < cache->pending_count; i++)
+    {
+        if (memcmp(cache->pending[i], addr, BOND_CACHE_ADDR_LEN) == 0)
+        {
+            if (!urgent || (i == 0))
+            {
+                return;
+            }
+            // Moved to the front
+            cache->pending_count--;
+            memmove(cache->pending[i], cache->pending[i + 1], (cache->pending_count - i) * BOND_CACHE_ADDR_LEN);
+            break;
+        }
+    }
+
+    if (cache->pending_count == BOND_CACHE_PENDING_SIZE)
+    {
+        cache->stats.dropped++;
+        if (!urgent)
+        {
+            return;
+        }
+        cache->pending_count--;
+    }
+
+    if (urgent)
+    {
+        // Behind the address being resolved
+        pos = cache->in_flight ? 1 : 0;
+        memmove(cache->pending[pos + 1], cache->pending[pos], (cache->pending_count - pos) * BOND_CACHE_ADDR_LEN);
+    }
+
+    memcpy(cache->pending[pos], addr, BOND_CACHE_ADDR_LEN);
+    cache->pending_count++;
+}
+
+static void bond_cache_rpa_pop(struct bond_cache *cache)
+{
+    cache->pending_count--;
+    memmove(cache->pending[0], cache->pending[1], cache->pending_count * BOND_CACHE_ADDR_LEN);
+}
+
+uint8_t bond_cache_rpa_request(struct bond_cache *cache, uint8_t *addr,
+                               uint8_t (*irk)[BOND_CACHE_KEY_LEN])
+{
+    uint8_t nb_key = 0;
+    uint8_t i;
+
+    if (cache->in_flight)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < BOND_CACHE_SIZE; i++)
+    {
+        if (bond_cache_has_irk(cache, i))
+        {
+            memcpy(irk[nb_key++], cache->entries[i].irk, BOND_CACHE_KEY_LEN);
+        }
+    }
+
+    while (cache->pending_count > 0)
+    {
+        // The address may have been resolved since it was queued
+        if (bond_cache_rpa_lookup(cache, cache->pending[0]) == NULL)
+        {
+            if (nb_key > 0)
+            {
+                memcpy(addr, cache->pending[0], BOND_CACHE_ADDR_LEN);
+                cache->in_flight = true;
+                cache->restart = false;
+                cache->stats.requests++;
+                return nb_key;
+            }
+            bond_cache_rpa_record(cache, cache->pending[0], BOND_CACHE_NONE);
+        }
+        bond_cache_rpa_pop(cache);
+    }
+
+    return 0;
+}
+
+void bond_cache_rpa_result(struct bond_cache *cache, const uint8_t *irk)
+{
+    uint8_t i;
+
+    if (!cache->in_flight || (cache->pending_count == 0))
+    {
+        return;
+    }
+
+    cache->in_flight = false;
+
+    if (irk != NULL)
+    {
+        for (i = 0; i < BOND_CACHE_SIZE; i++)
+        {
+            if (bond_cache_has_irk(cache, i) &&
+                (memcmp(cache->entries[i].irk, irk, BOND_CACHE_KEY_LEN) == 0) &&
+                bond_cache_check(cache, i))
+            {
+                bond_cache_rpa_record(cache, cache->pending[0], i);
+                break;
+            }
+        }
+        // Otherwise the peer was removed during the request, the address is resolved again
+    }
+    else if (!cache->restart)
+    {
+        bond_cache_rpa_record(cache, cache->pending[0], BOND_CACHE_NONE);
+    }
+
+    if (bond_cache_rpa_lookup(cache, cache->pending[0]) != NULL)
+    {
+        bond_cache_rpa_pop(cache);
+    }
+}
+
+/// @} APP
@@ -0,0 +1,282 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_bond_cache.h
+ *
+ * @brief Bonded peer cache header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_BOND_CACHE_H_
+#define _USER_BOND_CACHE_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * Bonded peers are kept in a small store indexed by identity address. An entry holds
+ * the LTK, EDIV and Rand distributed by the peer, the authentication level of the last
+ * encrypted link and the IRK of the peer if it distributed one. The key material is
+ * protected by a CRC-16, an entry that does not check is dropped instead of being used.
+ * The least recently used entry is replaced when the store is full.
+ *
+ * A peer using a Resolvable Private Address is found through its IRK. Addresses seen in
+ * advertising reports are queued, and the application has them resolved one at a time
+ * by the stack (GAPM_RESOLV_ADDR_CMD) against the IRKs given by bond_cache_rpa_request().
+ * The result, bonded or not, is remembered so that the connection to the peer finds its
+ * keys without waiting for a resolution and the encryption can be requested right away.
+ *
+ * This file does no cryptography and has no SDK dependency, it can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Bonded peers kept in the cache
+#ifndef BOND_CACHE_SIZE
+#define BOND_CACHE_SIZE             (8)
+#endif
+
+/// Resolved private addresses remembered
+#ifndef BOND_CACHE_RPA_SIZE
+#define BOND_CACHE_RPA_SIZE         (8)
+#endif
+
+/// Private addresses waiting for resolution
+#ifndef BOND_CACHE_PENDING_SIZE
+#define BOND_CACHE_PENDING_SIZE     (4)
+#endif
+
+#define BOND_CACHE_ADDR_LEN         (6)
+#define BOND_CACHE_KEY_LEN          (16)
+#define BOND_CACHE_RAND_LEN         (8)
+
+/// Random address type, as in the advertising reports and connection indications
+#define BOND_CACHE_ADDR_RAND        (1)
+
+/// Entry flags
+#define BOND_CACHE_VALID            (0x01)
+#define BOND_CACHE_HAS_IRK          (0x02)
+
+/// Resolved address that belongs to no bonded peer
+#define BOND_CACHE_NONE             (0xFF)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Bonded peer. Addresses and keys are stored least significant byte first, as on air.
+struct bond_cache_entry
+{
+    /// Identity address
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    uint8_t addr_type;
+    uint8_t flags;
+    /// LTK, EDIV and Rand distributed by the peer
+    uint8_t ltk[BOND_CACHE_KEY_LEN];
+    uint8_t rand[BOND_CACHE_RAND_LEN];
+    uint16_t ediv;
+    uint8_t key_size;
+    /// Authentication level of the last encrypted link (enum gap_auth)
+    uint8_t sec_lvl;
+    uint8_t irk[BOND_CACHE_KEY_LEN];
+    /// CRC-16/CCITT of all the fields above
+    uint16_t crc;
+    /// Value of the cache clock when the entry was last stored or found
+    uint32_t last_used;
+};
+
+/// Private address resolved by the cache
+struct bond_cache_rpa
+{
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    /// Entry of the peer, BOND_CACHE_NONE if no bonded peer uses the address
+    uint8_t entry;
+};
+
+struct bond_cache_stats
+{
+    /// Peer found by identity address
+    uint32_t id_hits;
+    /// Peer found by a resolved private address
+    uint32_t rpa_hits;
+    uint32_t misses;
+    /// Resolutions requested from the stack
+    uint32_t requests;
+    uint32_t crc_errors;
+    uint32_t evictions;
+    /// Private addresses not queued because the queue was full
+    uint32_t dropped;
+};
+
+struct bond_cache
+{
+    struct bond_cache_entry entries[BOND_CACHE_SIZE];
+    /// Resolved addresses, the oldest one is replaced
+    struct bond_cache_rpa rpa[BOND_CACHE_RPA_SIZE];
+    uint8_t rpa_next;
+    /// Addresses waiting for resolution, the first one is being resolved if in_flight
+    uint8_t pending[BOND_CACHE_PENDING_SIZE][BOND_CACHE_ADDR_LEN];
+    uint8_t pending_count;
+    /// The first pending address was given to bond_cache_rpa_request()
+    bool in_flight;
+    /// An IRK was stored after the request, a failed resolution is requested again
+    bool restart;
+    uint32_t clock;
+    struct bond_cache_stats stats;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Empties the cache.
+ * @param[in] cache     Cache.
+ ****************************************************************************************
+ */
+void bond_cache_init(struct bond_cache *cache);
+
+/**
+ ****************************************************************************************
+ * @brief Tells whether an address is a Resolvable Private Address.
+ * @param[in] addr      Address.
+ * @param[in] addr_type Address type.
+ * @return True if the two most significant bits of a random address are 01.
+ ****************************************************************************************
+ */
+bool bond_cache_is_rpa(const uint8_t *addr, uint8_t addr_type);
+
+/**
+ ****************************************************************************************
+ * @brief Stores the keys of a peer, replacing the entry of the same identity address or
+ *        the least recently used one. Private addresses resolved to no peer are resolved
+ *        again, against the new IRK.
+ * @param[in] cache     Cache.
+ * @param[in] keys      Keys of the peer. The flags tell whether the IRK is valid, the
+ *                      CRC and the clock are ignored.
+ ****************************************************************************************
+ */
+void bond_cache_store(struct bond_cache *cache, const struct bond_cache_entry *keys);
+
+/**
+ ****************************************************************************************
+ * @brief Looks up the peer of a connection, by identity address or by a resolved
+ *        private address. See bond_cache_rpa_known() for a private address not resolved
+ *        yet.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Peer address.
+ * @param[in] addr_type Peer address type.
+ * @return Entry of the peer, NULL if it is not bonded. Valid until the cache is changed.
+ ****************************************************************************************
+ */
+const struct bond_cache_entry *bond_cache_find(struct bond_cache *cache, const uint8_t *addr,
+                                               uint8_t addr_type);
+
+/**
+ ****************************************************************************************
+ * @brief Records the authentication level of an encrypted link.
+ * @param[in] cache     Cache.
+ * @param[in] entry     Entry returned by bond_cache_find().
+ * @param[in] sec_lvl   Authentication level.
+ ****************************************************************************************
+ */
+void bond_cache_set_sec_lvl(struct bond_cache *cache, const struct bond_cache_entry *entry,
+                            uint8_t sec_lvl);
+
+/**
+ ****************************************************************************************
+ * @brief Removes a peer, after it lost the keys.
+ * @param[in] cache     Cache.
+ * @param[in] entry     Entry returned by bond_cache_find().
+ ****************************************************************************************
+ */
+void bond_cache_remove(struct bond_cache *cache, const struct bond_cache_entry *entry);
+
+/**
+ ****************************************************************************************
+ * @brief Tells whether the result of the resolution of a private address is known.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Private address.
+ * @return True if bond_cache_find() can tell whether the address is bonded.
+ ****************************************************************************************
+ */
+bool bond_cache_rpa_known(struct bond_cache *cache, const uint8_t *addr);
+
+/**
+ ****************************************************************************************
+ * @brief Queues an address for resolution. Does nothing if it is not a Resolvable Private
+ *        Address, or if it is already resolved or queued.
+ * @param[in] cache     Cache.
+ * @param[in] addr      Address.
+ * @param[in] addr_type Address type.
+ * @param[in] urgent    Resolve it before the other queued addresses, for a connection.
+ *                      The last queued address is dropped if the queue is full.
+ ****************************************************************************************
+ */
+void bond_cache_rpa_seen(struct bond_cache *cache, const uint8_t *addr, uint8_t addr_type,
+                         bool urgent);
+
+/**
+ ****************************************************************************************
+ * @brief Gives the next address to resolve and the IRKs to resolve it against. Queued
+ *        addresses are recorded as not bonded without request while no IRK is known.
+ * @param[in] cache     Cache.
+ * @param[out] addr     Address to resolve.
+ * @param[out] irk      IRKs, BOND_CACHE_SIZE entries.
+ * @return Number of IRKs, 0 if there is nothing to resolve or a request is in flight.
+ ****************************************************************************************
+ */
+uint8_t bond_cache_rpa_request(struct bond_cache *cache, uint8_t *addr,
+                               uint8_t (*irk)[BOND_CACHE_KEY_LEN]);
+
+/**
+ ****************************************************************************************
+ * @brief Records the result of the request of bond_cache_rpa_request().
+ * @param[in] cache     Cache.
+ * @param[in] irk       IRK that resolved the address, NULL if none did.
+ ****************************************************************************************
+ */
+void bond_cache_rpa_result(struct bond_cache *cache, const uint8_t *irk);
+
+/// @} APP
+
+#endif // _USER_BOND_CACHE_H_
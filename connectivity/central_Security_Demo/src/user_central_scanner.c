@@ -328,9 +328,22 @@ void user_scan_complete_cb(uint8_t status)
  */
 void user_scan_report_ind_cb(struct gapm_adv_report_ind const *param)
 {
+	user_security_rpa_seen(&param->report);
 	device_check(param->report);
 }
 
+/**
+ ****************************************************************************************
+ * @brief System initialization callback, also empties the bonded peer cache.
+ *
+ ****************************************************************************************
+ */
+void user_app_on_init(void)
+{
+	default_app_on_init();
+	user_security_init();
+}
+
 
 void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind const *param)
 {
@@ -106,6 +106,8 @@ void user_scan_complete_cb(uint8_t status);
 
 void user_scan_report_ind_cb(struct gapm_adv_report_ind const *param);
 
+void user_app_on_init(void);
+
 void user_catch_rest_hndl(ke_msg_id_t const msgid,
                           void const *param,
                           ke_task_id_t const dest_id,
@@ -39,6 +39,7 @@
 #include "app_task.h"
 #include "app_utils.h"
 #include "app_bond_db.h"
+#include "user_bond_cache.h"
 #include "user_security.h"
 
 #if defined (CFG_PRINTF)
@@ -47,6 +48,12 @@
 
 uint8_t ret_conidx __attribute__((section(".bss."))); //@RETENTION MEMORY
 
+struct bond_cache bond_cache __attribute__((section(".bss."))); //@RETENTION MEMORY
+//Cache entry the encryption was requested with
+static const struct bond_cache_entry *enc_entry __attribute__((section(".bss."))); //@RETENTION MEMORY
+//Connection waiting for the resolution of the peer address
+static uint8_t rpa_conidx __attribute__((section(".bss."))); //@RETENTION MEMORY
+
 
 static struct gapc_bond_cmd *gapc_bond_req[APP_EASY_MAX_ACTIVE_CONNECTION] __attribute__((section(".bss.")));
 
@@ -72,27 +79,164 @@ void user_security_send_bond_req(uint8_t conidx, struct security_configuration s
 		ke_msg_send(cmd);
 }
 
+/**
+ ****************************************************************************************
+ * @brief Copy the keys of a bonded peer to the cache, by identity address if the peer
+ * distributed its IRK, by connection address otherwise
+ ****************************************************************************************
+ */
+static void user_bond_cache_store(const struct app_sec_bond_data_env_tag *pbd, uint8_t conidx){
+	static const uint8_t no_irk[KEY_LEN] = {0};
+	struct bond_cache_entry keys = {0};
+
+	if(memcmp(pbd->irk.irk.key, no_irk, KEY_LEN) != 0){
+		memcpy(keys.addr, pbd->irk.addr.addr.addr, BD_ADDR_LEN);
+		keys.addr_type = pbd->irk.addr.addr_type;
+		memcpy(keys.irk, pbd->irk.irk.key, KEY_LEN);
+		keys.flags = BOND_CACHE_HAS_IRK;
+	}
+	else{
+		memcpy(keys.addr, app_env[conidx].peer_addr.addr, BD_ADDR_LEN);
+		keys.addr_type = app_env[conidx].peer_addr_type;
+	}
+	memcpy(keys.ltk, pbd->ltk.ltk.key, KEY_LEN);
+	memcpy(keys.rand, pbd->ltk.randnb.nb, RAND_NB_LEN);
+	keys.ediv = pbd->ltk.ediv;
+	keys.key_size = pbd->ltk.key_size;
+	keys.sec_lvl = pbd->auth;
+	bond_cache_store(&bond_cache, &keys);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Empty the bonded peer cache, called once on system initialization
+ *
+ ****************************************************************************************
+ */
+void user_security_init(void){
+	bond_cache_init(&bond_cache);
+	enc_entry = NULL;
+	rpa_conidx = GAP_INVALID_CONIDX;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Have the stack resolve the next queued address against the IRKs of the cache,
+ * unless a resolution is already running
+ ****************************************************************************************
+ */
+static void user_security_rpa_resolve(void){
+	uint8_t addr[BD_ADDR_LEN];
+	uint8_t irk[BOND_CACHE_SIZE][KEY_LEN];
+	uint8_t nb_key = bond_cache_rpa_request(&bond_cache, addr, irk);
+
+	if(nb_key){
+		struct gapm_resolv_addr_cmd *cmd = KE_MSG_ALLOC_DYN(GAPM_RESOLV_ADDR_CMD,
+								TASK_GAPM, TASK_APP, gapm_resolv_addr_cmd, nb_key * sizeof(struct gap_sec_key));
+		cmd->operation = GAPM_RESOLV_ADDR;
+		cmd->nb_key = nb_key;
+		memcpy(cmd->addr.addr, addr, BD_ADDR_LEN);
+		memcpy(cmd->irk, irk, nb_key * sizeof(struct gap_sec_key));
+		ke_msg_send(cmd);
+	}
+}
+
+/**
+ ****************************************************************************************
+ * @brief Record the result of a resolution, then go on with the connection waiting
+ * for it and with the next queued address
+ ****************************************************************************************
+ */
+static void user_security_rpa_done(const uint8_t *irk){
+	uint8_t conidx = rpa_conidx;
+
+	bond_cache_rpa_result(&bond_cache, irk);
+	if((conidx != GAP_INVALID_CONIDX) && (app_env[conidx].conidx != GAP_INVALID_CONIDX) &&
+		bond_cache_rpa_known(&bond_cache, app_env[conidx].peer_addr.addr)){
+		rpa_conidx = GAP_INVALID_CONIDX;
+		user_security_send_encrypt_cmd(conidx);
+	}
+	user_security_rpa_resolve();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Queue the address of an advertising report, so that a bonded peer using a
+ * private address is already resolved when connecting to it
+ ****************************************************************************************
+ */
+void user_security_rpa_seen(struct adv_report const *report){
+	bond_cache_rpa_seen(&bond_cache, report->adv_addr.addr, report->adv_addr_type, false);
+	user_security_rpa_resolve();
+}
+
+/**
+ ****************************************************************************************
+ * @brief Call back when the stack resolved an address (GAPM_RESOLV_ADDR_CMD)
+ *
+ ****************************************************************************************
+ */
+void user_on_addr_solved_ind(const uint8_t conidx, struct gapm_addr_solved_ind const *param){
+	user_security_rpa_done(param->irk.key);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Call back when no IRK resolved the address (GAPM_RESOLV_ADDR_CMD)
+ *
+ ****************************************************************************************
+ */
+void user_on_addr_resolve_failed(const uint8_t conidx){
+	user_security_rpa_done(NULL);
+}
+
 /**
  ****************************************************************************************
  * @brief Initial security encryption to the connection
  * if the connected device is not paired, go to the pairing process.
+ * The bonded peer cache is checked first, the bond database is only searched on a miss.
  ****************************************************************************************
  */
 void user_security_send_encrypt_cmd(uint8_t conidx){
 	//Check if the device is already bonded
-	const struct app_sec_bond_data_env_tag *pbd = NULL;
-	pbd = app_easy_security_bdb_search_entry(SEARCH_BY_BDA_TYPE, (void *)app_env[conidx].peer_addr.addr, BD_ADDR_LEN);
-	if(pbd){
+	const struct bond_cache_entry *entry;
+	if(bond_cache_is_rpa(app_env[conidx].peer_addr.addr, app_env[conidx].peer_addr_type) &&
+		!bond_cache_rpa_known(&bond_cache, app_env[conidx].peer_addr.addr)){
+		//Private address not resolved while scanning, wait for the stack to resolve it
+		rpa_conidx = conidx;
+		bond_cache_rpa_seen(&bond_cache, app_env[conidx].peer_addr.addr, app_env[conidx].peer_addr_type, true);
+		user_security_rpa_resolve();
+		return;
+	}
+	entry = bond_cache_find(&bond_cache, app_env[conidx].peer_addr.addr, app_env[conidx].peer_addr_type);
+	if(entry){
+		arch_printf("Found bond info in cache.\n\r");
+	}
+	else{
+		const struct app_sec_bond_data_env_tag *pbd = NULL;
+		pbd = app_easy_security_bdb_search_entry(SEARCH_BY_BDA_TYPE, (void *)app_env[conidx].peer_addr.addr, BD_ADDR_LEN);
+		if(pbd){
+			arch_printf("Found bond info in db.\n\r");
+			user_bond_cache_store(pbd, conidx);
+			entry = bond_cache_find(&bond_cache, app_env[conidx].peer_addr.addr, app_env[conidx].peer_addr_type);
+		}
+	}
+	//A key without MITM protection does not satisfy a configuration that requires it
+	if(entry && (!(user_security_conf.auth & GAP_AUTH_MITM) || (entry->sec_lvl & GAP_AUTH_MITM))){
 		ret_conidx = conidx;
-		arch_printf("Found bond info in db.\n\r");
+		enc_entry = entry;
 		struct gapc_encrypt_cmd * cmd = KE_MSG_ALLOC(GAPC_ENCRYPT_CMD,
 								KE_BUILD_ID(TASK_GAPC, conidx), TASK_APP, gapc_encrypt_cmd);
 		cmd->operation = GAPC_ENCRYPT;
-		cmd->ltk = pbd->ltk;
+		memcpy(cmd->ltk.ltk.key, entry->ltk, KEY_LEN);
+		memcpy(cmd->ltk.randnb.nb, entry->rand, RAND_NB_LEN);
+		cmd->ltk.ediv = entry->ediv;
+		cmd->ltk.key_size = entry->key_size;
 		ke_msg_send(cmd);
 		arch_printf("Send GAPC_ENCRYPT_CMD\n\r");	
 	}
 	else{ //Device not bonded, run pairing procedule
+		enc_entry = NULL;
 		user_security_send_bond_req(conidx, user_security_conf);
 	}
 }
@@ -105,6 +249,10 @@ void user_security_send_encrypt_cmd(uint8_t conidx){
  */
 void user_on_enc_key_missing(void){
 	arch_printf("Encryption key missing on periph side.\n\r");
+	if(enc_entry){
+		bond_cache_remove(&bond_cache, enc_entry);
+		enc_entry = NULL;
+	}
 	default_app_bdb_remove_entry(SEARCH_BY_BDA_TYPE,
                                  REMOVE_THIS_ENTRY,
                                  (void *)app_env[ret_conidx].peer_addr.addr, BD_ADDR_LEN);
@@ -120,6 +268,10 @@ void user_on_enc_key_missing(void){
  */
 void user_on_encrypt_ind(const uint8_t conidx, const uint8_t auth){
 	arch_printf("\n\rEncrypted link established.\n\r");
+	if(enc_entry){
+		bond_cache_set_sec_lvl(&bond_cache, enc_entry, auth);
+		enc_entry = NULL;
+	}
 }
 
 /**
@@ -203,4 +355,5 @@ void user_app_on_tk_exch(uint8_t conidx,
 void user_on_pairing_succeeded(uint8_t conidx){
 	arch_printf("\r\nPairing succeeded.");
 	default_app_on_pairing_succeeded(conidx);
+	user_bond_cache_store(&app_sec_env[conidx], conidx);
 }
@@ -67,6 +67,14 @@ struct extra_app_callbacks
                                           0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f}
 
 
+void user_security_init(void);
+
+void user_security_rpa_seen(struct adv_report const *report);
+
+void user_on_addr_solved_ind(const uint8_t conidx, struct gapm_addr_solved_ind const *param);
+
+void user_on_addr_resolve_failed(const uint8_t conidx);
+
 void user_security_send_bond_req(uint8_t conidx, struct security_configuration sec_conf);
 
 void user_app_on_tk_exch(uint8_t conidx,
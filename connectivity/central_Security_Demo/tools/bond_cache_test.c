@@ -0,0 +1,382 @@
+/**
+ ****************************************************************************************
+ *
+ * @file bond_cache_test.c
+ *
+ * @brief Host test of the bonded peer cache.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc -o bond_cache_test tools/bond_cache_test.c src/user_bond_cache.c
+ *   ./bond_cache_test
+ *
+ * The stack resolution (GAPM_RESOLV_ADDR_CMD) is simulated: the test remembers which IRK
+ * each private address was made with, and a request resolves if that IRK is one of the
+ * IRKs given by bond_cache_rpa_request().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "user_bond_cache.h"
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);               \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+#define IRK_NB          (12)
+#define RPA_MAX         (64)
+
+static uint8_t irks[IRK_NB][BOND_CACHE_KEY_LEN];
+
+// Private addresses made by the test, and the IRK of each
+static struct
+{
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    uint8_t irk;
+} made[RPA_MAX];
+static int made_nb;
+
+static struct bond_cache cache;
+
+static void make_rpa(uint8_t irk, uint8_t *addr)
+{
+    int i;
+
+    for (i = 0; i < BOND_CACHE_ADDR_LEN; i++)
+    {
+        addr[i] = rand();
+    }
+    addr[5] = (addr[5] & 0x3F) | 0x40;
+    memcpy(made[made_nb].addr, addr, BOND_CACHE_ADDR_LEN);
+    made[made_nb++].irk = irk;
+}
+
+static void store(uint8_t id, int irk)
+{
+    struct bond_cache_entry keys;
+
+    memset(&keys, 0, sizeof(keys));
+    keys.addr[0] = id;
+    keys.addr[5] = 0xC0;
+    keys.addr_type = BOND_CACHE_ADDR_RAND;
+    keys.ediv = 100 + id;
+    keys.key_size = 16;
+    keys.ltk[0] = id;
+    if (irk >= 0)
+    {
+        memcpy(keys.irk, irks[irk], BOND_CACHE_KEY_LEN);
+        keys.flags = BOND_CACHE_HAS_IRK;
+    }
+    bond_cache_store(&cache, &keys);
+}
+
+/**
+ * Takes the next request, if any, and answers it. Returns the number of IRKs of the
+ * request, 0 if none was made.
+ */
+static uint8_t stack_resolve(void)
+{
+    uint8_t irk[BOND_CACHE_SIZE][BOND_CACHE_KEY_LEN];
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    uint8_t nb_key = bond_cache_rpa_request(&cache, addr, irk);
+    const uint8_t *found = NULL;
+    int i, k;
+
+    for (i = 0; (nb_key > 0) && (i < made_nb); i++)
+    {
+        if (memcmp(made[i].addr, addr, BOND_CACHE_ADDR_LEN) == 0)
+        {
+            for (k = 0; k < nb_key; k++)
+            {
+                if (memcmp(irk[k], irks[made[i].irk], BOND_CACHE_KEY_LEN) == 0)
+                {
+                    found = irk[k];
+                }
+            }
+        }
+    }
+
+    if (nb_key > 0)
+    {
+        bond_cache_rpa_result(&cache, found);
+    }
+
+    return nb_key;
+}
+
+static void resolve_all(void)
+{
+    while (stack_resolve() > 0)
+    {
+    }
+}
+
+static void test_lookup(void)
+{
+    const struct bond_cache_entry *entry;
+    uint8_t id[BOND_CACHE_ADDR_LEN] = {3, 0, 0, 0, 0, 0xC0};
+    uint8_t a[BOND_CACHE_ADDR_LEN], b[BOND_CACHE_ADDR_LEN];
+    int i;
+
+    bond_cache_init(&cache);
+
+    // Without IRK no request is made, the address is known as not bonded
+    make_rpa(0, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    CHECK(stack_resolve() == 0);
+    CHECK(bond_cache_rpa_known(&cache, a) && bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND) == NULL);
+
+    for (i = 0; i < BOND_CACHE_SIZE; i++)
+    {
+        store(i, i);
+    }
+
+    entry = bond_cache_find(&cache, id, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 103 && cache.stats.id_hits == 1);
+
+    // Queued once, resolved by one request with all the IRKs
+    make_rpa(5, a);
+    CHECK(bond_cache_is_rpa(a, BOND_CACHE_ADDR_RAND) && !bond_cache_is_rpa(a, 0));
+    CHECK(!bond_cache_rpa_known(&cache, a));
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    CHECK(cache.pending_count == 1);
+    CHECK(stack_resolve() == BOND_CACHE_SIZE);
+    CHECK(stack_resolve() == 0 && cache.pending_count == 0);
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 105 && cache.stats.rpa_hits == 1);
+
+    // No request while one is in flight
+    make_rpa(2, a);
+    make_rpa(10, b);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    bond_cache_rpa_seen(&cache, b, BOND_CACHE_ADDR_RAND, false);
+    {
+        uint8_t irk[BOND_CACHE_SIZE][BOND_CACHE_KEY_LEN];
+        uint8_t addr[BOND_CACHE_ADDR_LEN];
+
+        CHECK(bond_cache_rpa_request(&cache, addr, irk) == BOND_CACHE_SIZE);
+        CHECK(memcmp(addr, a, sizeof(addr)) == 0);
+        CHECK(bond_cache_rpa_request(&cache, addr, irk) == 0);
+        bond_cache_rpa_result(&cache, irks[2]);
+    }
+    resolve_all();
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 102);
+
+    // Not bonded, remembered: not queued again
+    CHECK(bond_cache_rpa_known(&cache, b) && bond_cache_find(&cache, b, BOND_CACHE_ADDR_RAND) == NULL);
+    bond_cache_rpa_seen(&cache, b, BOND_CACHE_ADDR_RAND, false);
+    CHECK(cache.pending_count == 0);
+    CHECK(cache.stats.requests == 3);
+}
+
+static void test_urgent(void)
+{
+    uint8_t q[BOND_CACHE_PENDING_SIZE + 1][BOND_CACHE_ADDR_LEN];
+    uint8_t conn[BOND_CACHE_ADDR_LEN];
+    uint8_t irk[BOND_CACHE_SIZE][BOND_CACHE_KEY_LEN];
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    uint32_t dropped;
+    int i;
+
+    bond_cache_init(&cache);
+    store(1, 1);
+
+    // The queue is full, a scan report is dropped
+    for (i = 0; i < BOND_CACHE_PENDING_SIZE + 1; i++)
+    {
+        make_rpa(11, q[i]);
+        bond_cache_rpa_seen(&cache, q[i], BOND_CACHE_ADDR_RAND, false);
+    }
+    CHECK(cache.pending_count == BOND_CACHE_PENDING_SIZE && cache.stats.dropped == 1);
+
+    // The first address is in flight, the connection goes right behind it
+    CHECK(bond_cache_rpa_request(&cache, addr, irk) == 1 && memcmp(addr, q[0], sizeof(addr)) == 0);
+    make_rpa(1, conn);
+    dropped = cache.stats.dropped;
+    bond_cache_rpa_seen(&cache, conn, BOND_CACHE_ADDR_RAND, true);
+    CHECK(cache.stats.dropped == dropped + 1 && cache.pending_count == BOND_CACHE_PENDING_SIZE);
+    bond_cache_rpa_result(&cache, NULL);
+    CHECK(bond_cache_rpa_request(&cache, addr, irk) == 1 && memcmp(addr, conn, sizeof(addr)) == 0);
+    bond_cache_rpa_result(&cache, irks[1]);
+    CHECK(bond_cache_find(&cache, conn, BOND_CACHE_ADDR_RAND) != NULL);
+
+    // A queued address asked for by a connection moves to the front
+    CHECK(cache.pending_count == 2 && memcmp(cache.pending[1], q[2], BOND_CACHE_ADDR_LEN) == 0);
+    bond_cache_rpa_seen(&cache, q[2], BOND_CACHE_ADDR_RAND, true);
+    CHECK(cache.pending_count == 2 && memcmp(cache.pending[0], q[2], BOND_CACHE_ADDR_LEN) == 0);
+    resolve_all();
+    CHECK(cache.pending_count == 0);
+    for (i = 1; i < 3; i++)
+    {
+        CHECK(bond_cache_rpa_known(&cache, q[i]) && !bond_cache_find(&cache, q[i], BOND_CACHE_ADDR_RAND));
+    }
+    // Dropped for the connection
+    CHECK(!bond_cache_rpa_known(&cache, q[3]));
+}
+
+static void test_store_during_request(void)
+{
+    uint8_t irk[BOND_CACHE_SIZE][BOND_CACHE_KEY_LEN];
+    uint8_t addr[BOND_CACHE_ADDR_LEN];
+    uint8_t a[BOND_CACHE_ADDR_LEN];
+    const struct bond_cache_entry *entry;
+
+    bond_cache_init(&cache);
+    store(1, 1);
+
+    // The peer pairs while its address is resolved against the older IRKs
+    make_rpa(4, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    CHECK(bond_cache_rpa_request(&cache, addr, irk) == 1);
+    store(4, 4);
+    bond_cache_rpa_result(&cache, NULL);
+    CHECK(!bond_cache_rpa_known(&cache, a) && cache.pending_count == 1);
+    CHECK(stack_resolve() == 2);
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 104);
+
+    // An address known as not bonded is resolved again after a new IRK
+    make_rpa(6, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    resolve_all();
+    CHECK(bond_cache_rpa_known(&cache, a) && !bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND));
+    store(6, 6);
+    CHECK(!bond_cache_rpa_known(&cache, a));
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, true);
+    resolve_all();
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 106);
+
+    // The peer is removed during a request: the IRK no longer resolves to an entry
+    make_rpa(4, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    CHECK(bond_cache_rpa_request(&cache, addr, irk) == 3);
+    {
+        uint8_t id[BOND_CACHE_ADDR_LEN] = {4, 0, 0, 0, 0, 0xC0};
+
+        bond_cache_remove(&cache, bond_cache_find(&cache, id, BOND_CACHE_ADDR_RAND));
+    }
+    bond_cache_rpa_result(&cache, irks[4]);
+    CHECK(!bond_cache_rpa_known(&cache, a));
+    CHECK(stack_resolve() == 2);
+    CHECK(bond_cache_rpa_known(&cache, a) && !bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND));
+}
+
+static void test_entries(void)
+{
+    const struct bond_cache_entry *entry;
+    struct bond_cache_entry *corrupt;
+    uint8_t id0[BOND_CACHE_ADDR_LEN] = {0, 0, 0, 0, 0, 0xC0};
+    uint8_t pub[BOND_CACHE_ADDR_LEN] = {0x77};
+    uint8_t a[BOND_CACHE_ADDR_LEN];
+    struct bond_cache_entry keys;
+    uint32_t crc_errors;
+    int i;
+
+    bond_cache_init(&cache);
+    for (i = 0; i < BOND_CACHE_SIZE; i++)
+    {
+        store(i, i);
+    }
+    for (i = 1; i < BOND_CACHE_SIZE; i++)
+    {
+        uint8_t id[BOND_CACHE_ADDR_LEN] = {i, 0, 0, 0, 0, 0xC0};
+
+        bond_cache_find(&cache, id, BOND_CACHE_ADDR_RAND);
+    }
+
+    // The least recently used peer is replaced
+    store(8, 9);
+    CHECK(cache.stats.evictions == 1 && !bond_cache_find(&cache, id0, BOND_CACHE_ADDR_RAND));
+    make_rpa(9, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    resolve_all();
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->ediv == 108);
+
+    // The security level is recorded without breaking the CRC
+    bond_cache_set_sec_lvl(&cache, entry, 5);
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL && entry->sec_lvl == 5);
+
+    // A corrupted entry is dropped with its addresses
+    corrupt = (struct bond_cache_entry *)entry;
+    corrupt->ltk[3] ^= 1;
+    crc_errors = cache.stats.crc_errors;
+    CHECK(bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND) == NULL);
+    CHECK(cache.stats.crc_errors == crc_errors + 1 && !bond_cache_rpa_known(&cache, a));
+
+    // Removal
+    make_rpa(5, a);
+    bond_cache_rpa_seen(&cache, a, BOND_CACHE_ADDR_RAND, false);
+    resolve_all();
+    entry = bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND);
+    CHECK(entry != NULL);
+    bond_cache_remove(&cache, entry);
+    CHECK(bond_cache_find(&cache, a, BOND_CACHE_ADDR_RAND) == NULL);
+
+    // A peer without IRK is found by its public address
+    memset(&keys, 0, sizeof(keys));
+    keys.addr[0] = 0x77;
+    bond_cache_store(&cache, &keys);
+    CHECK(bond_cache_find(&cache, pub, 0) != NULL);
+
+    printf("entry %u bytes, cache %u bytes\n",
+           (unsigned)sizeof(struct bond_cache_entry), (unsigned)sizeof(struct bond_cache));
+}
+
+int main(void)
+{
+    int i, k;
+
+    srand(1);
+    for (i = 0; i < IRK_NB; i++)
+    {
+        for (k = 0; k < BOND_CACHE_KEY_LEN; k++)
+        {
+            irks[i][k] = rand();
+        }
+    }
+
+    test_lookup();
+    test_urgent();
+    test_store_during_request();
+    test_entries();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
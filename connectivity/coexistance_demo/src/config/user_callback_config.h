@@ -157,7 +157,7 @@ static const struct app_bond_db_callbacks user_app_bond_db_callbacks = {
 };
 #endif // (BLE_APP_SEC)
 
-static const catch_rest_event_func_t app_process_catch_rest_cb = NULL;
+static const catch_rest_event_func_t app_process_catch_rest_cb = (catch_rest_event_func_t)user_catch_rest_hndl;
 
 static const struct default_app_operations user_default_app_operations = {
     .default_operation_adv = default_advertise_operation,
@@ -170,7 +170,7 @@ static const struct arch_main_loop_callbacks user_app_main_loop_callbacks = {
     // The user has to take into account the watchdog timer handling (keep it running,
     // freeze it, reload it, resume it, etc), when the app_on_ble_powered() is being
     // called and may potentially affect the main loop.
-    .app_on_ble_powered     = NULL,
+    .app_on_ble_powered     = user_on_ble_powered,
 
     // By default the watchdog timer is reloaded and resumed when the system wakes up.
     // The user has to take into account the watchdog timer handling (keep it running,
@@ -63,6 +63,7 @@
 #define DEF_SVC1_BUTTON_STATE_UUID_128   {0x9E, 0xE7, 0xBA, 0x08, 0xB9, 0xA9, 0x48, 0xAB, 0xA1, 0xAC, 0x03, 0x1C, 0x2E, 0x0D, 0x29, 0x6C}
 #define DEF_SVC1_INDICATEABLE_UUID_128   {0x28, 0xD5, 0xE1, 0xC1, 0xE1, 0xC5, 0x47, 0x29, 0xB5, 0x57, 0x65, 0xC3, 0xBA, 0x47, 0x15, 0x9E}
 #define DEF_SVC1_LONG_VALUE_UUID_128     {0x8C, 0x09, 0xE0, 0xD1, 0x81, 0x54, 0x42, 0x40, 0x8E, 0x4F, 0xD2, 0xB3, 0x77, 0xE3, 0x2A, 0x77}
+#define DEF_SVC1_COEX_STATS_UUID_128     {0x6E, 0x3B, 0x5A, 0x92, 0x0D, 0x47, 0x4C, 0x1E, 0xB8, 0x21, 0x3F, 0x90, 0xC4, 0x7A, 0x15, 0x0B}
 
 #define DEF_SVC1_CTRL_POINT_CHAR_LEN     1
 #define DEF_SVC1_LED_STATE_CHAR_LEN      1
@@ -71,6 +72,7 @@
 #define DEF_SVC1_BUTTON_STATE_CHAR_LEN   1
 #define DEF_SVC1_INDICATEABLE_CHAR_LEN   20
 #define DEF_SVC1_LONG_VALUE_CHAR_LEN     50
+#define DEF_SVC1_COEX_STATS_CHAR_LEN     21
 
 #define DEF_SVC1_CONTROL_POINT_USER_DESC     "Control Point"
 #define DEF_SVC1_LED_STATE_USER_DESC         "LED State"
@@ -79,6 +81,7 @@
 #define DEF_SVC1_BUTTON_STATE_USER_DESC      "Button State"
 #define DEF_SVC1_INDICATEABLE_USER_DESC      "Indicateable"
 #define DEF_SVC1_LONG_VALUE_CHAR_USER_DESC   "Long Value"
+#define DEF_SVC1_COEX_STATS_USER_DESC        "Coex Stats"
 
 // Service 2 of the custom server 1
 #define DEF_SVC2_UUID_128                {0x59, 0x5a, 0x08, 0xe4, 0x86, 0x2a, 0x9e, 0x8f, 0xe9, 0x11, 0xbc, 0x7c, 0x7c, 0x46, 0x42, 0x18}
@@ -144,6 +147,10 @@ enum
     SVC1_IDX_LONG_VALUE_VAL,
     SVC1_IDX_LONG_VALUE_NTF_CFG,
     SVC1_IDX_LONG_VALUE_USER_DESC,
+
+    SVC1_IDX_COEX_STATS_CHAR,
+    SVC1_IDX_COEX_STATS_VAL,
+    SVC1_IDX_COEX_STATS_USER_DESC,
     
     // Custom Service 2
     SVC2_IDX_SVC,
@@ -0,0 +1,229 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_coex_ctrl.c
+ *
+ * @brief Adaptive WLAN coexistence priority controller source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stddef.h>
+#include "user_coex_ctrl.h"
+
+/*
+ * LOCAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Priority ladder, from WLAN always first to BLE data always first
+static const coex_ctrl_step_t coex_ctrl_ladder[] =
+{
+    {COEX_CTRL_NO_MISSED, false},
+    {5,                   false},
+    {2,                   false},
+    {1,                   true},
+};
+
+#define COEX_CTRL_STEPS     (uint8_t)(sizeof(coex_ctrl_ladder) / sizeof(coex_ctrl_ladder[0]))
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+*/
+
+static uint8_t *coex_ctrl_put(uint8_t *buf, uint32_t value, uint8_t len)
+{
+    while (len--)
+    {
+        *buf++ = (uint8_t)value;
+        value >>= 8;
+    }
+    return buf;
+}
+
+static uint16_t coex_ctrl_us_to_ms(uint32_t us)
+{
+    return (uint16_t)((us / 1000 < 0xFFFF) ? us / 1000 : 0xFFFF);
+}
+
+void user_coex_ctrl_init(coex_ctrl_t *ctrl)
+{
+    ctrl->stats.events = 0;
+    ctrl->stats.missed = 0;
+    ctrl->stats.retx = 0;
+    ctrl->stats.raises = 0;
+    ctrl->stats.lowers = 0;
+    ctrl->stats.latency_ms = 0;
+    ctrl->stats.max_latency_ms = 0;
+    ctrl->stats.step = 0;
+    ctrl->peak_us = 0;
+    ctrl->streak = 0;
+    ctrl->dwell = 0;
+    ctrl->lower_dwell = COEX_CTRL_LOWER_DWELL;
+    ctrl->lowered = false;
+}
+
+bool user_coex_ctrl_sample(coex_ctrl_t *ctrl, uint16_t events, uint16_t missed, uint16_t retx, uint32_t intv_us)
+{
+    uint32_t impaired;
+    uint32_t latency_us;
+    uint32_t pending_us;
+    uint16_t i;
+
+    if (events == 0)
+    {
+        return false;
+    }
+
+    ctrl->stats.events += events;
+    ctrl->stats.missed += missed;
+    ctrl->stats.retx += retx;
+
+    // An event that was missed cannot also be retransmitted
+    impaired = (uint32_t)missed + retx;
+    if (impaired > events)
+    {
+        impaired = events;
+    }
+
+    if (impaired < events)
+    {
+        // A packet got through after the streak, it waited one interval per impaired event
+        latency_us = (ctrl->streak + 1) * intv_us;
+        if (coex_ctrl_us_to_ms(latency_us) > ctrl->stats.max_latency_ms)
+        {
+            ctrl->stats.max_latency_ms = coex_ctrl_us_to_ms(latency_us);
+        }
+
+        ctrl->streak = impaired;
+    }
+    else
+    {
+        ctrl->streak += impaired;
+        latency_us = 0;
+    }
+
+    for (i = 0; i < events; i++)
+    {
+        ctrl->peak_us -= ctrl->peak_us >> COEX_CTRL_DECAY_SHIFT;
+    }
+
+    if (latency_us > ctrl->peak_us)
+    {
+        ctrl->peak_us = latency_us;
+    }
+
+    // A streak in progress counts as soon as it is longer than the peak
+    latency_us = ctrl->peak_us;
+    pending_us = (ctrl->streak + 1) * intv_us;
+    if (pending_us > latency_us)
+    {
+        latency_us = pending_us;
+    }
+    ctrl->stats.latency_ms = coex_ctrl_us_to_ms(latency_us);
+
+    ctrl->dwell += events;
+
+    if (ctrl->stats.latency_ms > COEX_CTRL_TARGET_LATENCY_MS)
+    {
+        if (ctrl->stats.step + 1 < COEX_CTRL_STEPS && ctrl->dwell >= COEX_CTRL_RAISE_DWELL)
+        {
+            // The reduction did not hold, wait longer before the next one
+            if (ctrl->lowered && ctrl->lower_dwell < COEX_CTRL_LOWER_DWELL_MAX)
+            {
+                ctrl->lower_dwell <<= 1;
+            }
+            ctrl->lowered = false;
+            ctrl->stats.step++;
+            ctrl->stats.raises++;
+            ctrl->dwell = 0;
+            // Measure the new step from scratch
+            ctrl->peak_us = 0;
+            ctrl->streak = 0;
+            return true;
+        }
+    }
+    else if (ctrl->stats.latency_ms < (COEX_CTRL_TARGET_LATENCY_MS * COEX_CTRL_LOWER_PERCENT) / 100)
+    {
+        if (ctrl->stats.step > 0 && ctrl->dwell >= ctrl->lower_dwell)
+        {
+            ctrl->lowered = true;
+            ctrl->stats.step--;
+            ctrl->stats.lowers++;
+            ctrl->dwell = 0;
+            ctrl->peak_us = 0;
+            ctrl->streak = 0;
+            return true;
+        }
+
+        if (ctrl->stats.step == 0 && ctrl->dwell >= ctrl->lower_dwell)
+        {
+            // The load is gone, the next reduction may come early again
+            ctrl->lower_dwell = COEX_CTRL_LOWER_DWELL;
+        }
+    }
+    else
+    {
+        // Inside the hysteresis band the link is where it should be
+        ctrl->dwell = 0;
+    }
+
+    return false;
+}
+
+coex_ctrl_step_t const *user_coex_ctrl_get_step(uint8_t step)
+{
+    if (step >= COEX_CTRL_STEPS)
+    {
+        return NULL;
+    }
+
+    return &coex_ctrl_ladder[step];
+}
+
+void user_coex_ctrl_pack_stats(coex_ctrl_stats_t const *stats, uint8_t *buf)
+{
+    buf = coex_ctrl_put(buf, stats->events, 4);
+    buf = coex_ctrl_put(buf, stats->missed, 4);
+    buf = coex_ctrl_put(buf, stats->retx, 4);
+    buf = coex_ctrl_put(buf, stats->raises, 2);
+    buf = coex_ctrl_put(buf, stats->lowers, 2);
+    buf = coex_ctrl_put(buf, stats->latency_ms, 2);
+    buf = coex_ctrl_put(buf, stats->max_latency_ms, 2);
+    coex_ctrl_put(buf, stats->step, 1);
+}
+
+/// @} APP
@@ -0,0 +1,204 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_coex_ctrl.h
+ *
+ * @brief Adaptive WLAN coexistence priority controller header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_COEX_CTRL_H_
+#define _USER_COEX_CTRL_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @ingroup RICOW
+ *
+ * @brief Adaptive WLAN coexistence priority controller.
+ *
+ * The controller regulates the BLE latency of a link, the time from the first connection
+ * event at which a packet could be exchanged until the event at which it got through.
+ * Every missed or retransmitted event delays the packet by one connection interval, so
+ * the controller counts the impaired events in a row. The measured latency is the peak
+ * latency of the delivered packets, decaying with every connection event, or the latency
+ * of the streak in progress if it is already longer. A peak rather than a mean is held
+ * against the setpoint because a few long WLAN bursts are what starves a link, while the
+ * mean stays low on the many packets in between.
+ *
+ * When the measured latency stays above COEX_CTRL_TARGET_LATENCY_MS the BLE priority is
+ * raised one step on the priority ladder, when it stays below COEX_CTRL_LOWER_PERCENT of
+ * the target it is given back to the WLAN device one step at a time. The gap between the
+ * two thresholds and the minimum dwell time on a step keep the priority from oscillating.
+ * The latency of a step is measured from scratch after every change. If the priority has
+ * to be raised again after it was lowered, the dwell before the next reduction is doubled,
+ * up to COEX_CTRL_LOWER_DWELL_MAX.
+ * Without interference the latency is one connection interval, so the target must leave
+ * room above the interval of the link.
+ *
+ * The module does not depend on the SDK, the application maps the ladder steps to
+ * wlan_coex_prio_criteria_add()/wlan_coex_prio_criteria_del() calls.
+ *
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// BLE latency setpoint in ms, the BLE priority is raised above it
+#define COEX_CTRL_TARGET_LATENCY_MS     (600)
+
+/// Percentage of the setpoint below which the BLE priority is lowered
+#define COEX_CTRL_LOWER_PERCENT         (50)
+
+/// The peak latency decays by 1/2^COEX_CTRL_DECAY_SHIFT per connection event
+#define COEX_CTRL_DECAY_SHIFT           (6)
+
+/// Minimum number of connection events between two priority raises
+#define COEX_CTRL_RAISE_DWELL           (16)
+
+/// Minimum number of connection events between two priority reductions
+#define COEX_CTRL_LOWER_DWELL           (128)
+
+/// Limit of the reduction dwell after repeated raises
+#define COEX_CTRL_LOWER_DWELL_MAX       (2048)
+
+/// Ladder step without a missed event criterion
+#define COEX_CTRL_NO_MISSED             (0xFFFF)
+
+/// Size of the packed statistics in bytes
+#define COEX_CTRL_STATS_LEN             (21)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Priority criteria of a ladder step
+typedef struct
+{
+    /// Missed events after which the next event gets priority, COEX_CTRL_NO_MISSED for none
+    uint16_t missed;
+    /// Every data event gets priority
+    bool data;
+} coex_ctrl_step_t;
+
+/// Link statistics
+typedef struct
+{
+    /// Connection events elapsed
+    uint32_t events;
+    /// Connection events missed
+    uint32_t missed;
+    /// Connection events that ended with an unacknowledged packet
+    uint32_t retx;
+    /// Number of priority raises
+    uint16_t raises;
+    /// Number of priority reductions
+    uint16_t lowers;
+    /// Measured latency in ms, the value compared with the setpoint
+    uint16_t latency_ms;
+    /// Longest latency of a delivered packet in ms
+    uint16_t max_latency_ms;
+    /// Current ladder step
+    uint8_t step;
+} coex_ctrl_stats_t;
+
+/// Controller state of a link
+typedef struct
+{
+    coex_ctrl_stats_t stats;
+    /// Decaying peak of the delivered latency in us
+    uint32_t peak_us;
+    /// Impaired connection events in a row since the last delivery
+    uint32_t streak;
+    /// Connection events spent outside the hysteresis band since the last step change
+    uint32_t dwell;
+    /// Connection events to spend below the band before the next reduction
+    uint32_t lower_dwell;
+    /// The last step change was a reduction
+    bool lowered;
+} coex_ctrl_t;
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Reset the controller of a link to the lowest priority step.
+ * @param[in] ctrl      Controller state
+ * @return void
+ ****************************************************************************************
+ */
+void user_coex_ctrl_init(coex_ctrl_t *ctrl);
+
+/**
+ ****************************************************************************************
+ * @brief Feed a sample of the link to the controller. The missed and retransmitted
+ *        events are taken to be the last ones of the sample.
+ * @param[in] ctrl      Controller state
+ * @param[in] events    Connection events elapsed since the previous sample
+ * @param[in] missed    Events of them that were missed
+ * @param[in] retx      Events of them that ended with an unacknowledged packet
+ * @param[in] intv_us   Connection interval of the link in us
+ * @return true if the ladder step changed
+ ****************************************************************************************
+ */
+bool user_coex_ctrl_sample(coex_ctrl_t *ctrl, uint16_t events, uint16_t missed, uint16_t retx, uint32_t intv_us);
+
+/**
+ ****************************************************************************************
+ * @brief Get the priority criteria of a ladder step.
+ * @param[in] step      Ladder step
+ * @return Priority criteria, NULL if the step does not exist
+ ****************************************************************************************
+ */
+coex_ctrl_step_t const *user_coex_ctrl_get_step(uint8_t step);
+
+/**
+ ****************************************************************************************
+ * @brief Serialize the link statistics, little endian in the order of coex_ctrl_stats_t.
+ * @param[in] stats     Link statistics
+ * @param[out] buf      Buffer of COEX_CTRL_STATS_LEN bytes
+ * @return void
+ ****************************************************************************************
+ */
+void user_coex_ctrl_pack_stats(coex_ctrl_stats_t const *stats, uint8_t *buf);
+
+/// @} APP
+
+#endif // _USER_COEX_CTRL_H_
@@ -43,11 +43,44 @@
  */
 
 #include "app_api.h"
+#include "custs1_task.h"
+#include "user_custs1_def.h"
 #include "user_coex_demo.h"
 
 #if (WLAN_COEX_ENABLED)
 #include "wlan_coex.h"
 #include "lld.h"
+#include "lld_evt.h"
+#include "llc.h"
+#include "gapc.h"
+#include "co_list.h"
+#include "user_coex_ctrl.h"
+#endif
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#if (WLAN_COEX_ENABLED)
+/// Adaptive priority state of a connection
+typedef struct
+{
+    coex_ctrl_t ctrl;
+    uint16_t conhdl;
+    /// Connection event counter at the previous sample
+    uint16_t last_counter;
+    bool active;
+} coex_link_t;
+#endif
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+#if (WLAN_COEX_ENABLED)
+static coex_link_t coex_links[APP_EASY_MAX_ACTIVE_CONNECTION] __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 #endif
 
 /*
@@ -55,17 +88,203 @@
  ****************************************************************************************
 */
 
+#if (WLAN_COEX_ENABLED)
+/**
+ ****************************************************************************************
+ * @brief Install or remove the WLAN COEX criteria of a ladder step.
+ * @param[in] conhdl        Connection handle
+ * @param[in] step          Ladder step
+ * @param[in] add           true to install the criteria, false to remove them
+ ****************************************************************************************
+ */
+static void coex_apply_step(uint16_t conhdl, uint8_t step, bool add)
+{
+    coex_ctrl_step_t const *criteria = user_coex_ctrl_get_step(step);
+
+    if (criteria->missed != COEX_CTRL_NO_MISSED)
+    {
+        if (add)
+        {
+            wlan_coex_prio_criteria_add(WLAN_COEX_BLE_PRIO_MISSED, conhdl, criteria->missed);
+        }
+        else
+        {
+            wlan_coex_prio_criteria_del(WLAN_COEX_BLE_PRIO_MISSED, conhdl, criteria->missed);
+        }
+    }
+
+    if (criteria->data)
+    {
+        if (add)
+        {
+            wlan_coex_prio_criteria_add(WLAN_COEX_BLE_PRIO_DATA, conhdl, 0);
+        }
+        else
+        {
+            wlan_coex_prio_criteria_del(WLAN_COEX_BLE_PRIO_DATA, conhdl, 0);
+        }
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sample the link layer counters of a connection and update its priority.
+ *        Called from the main loop, so normally once per connection event. When more
+ *        events elapsed between two samples (slave latency or a long ISR) only the
+ *        latest missed streak is seen.
+ * @param[in] link          Connection state
+ ****************************************************************************************
+ */
+static void coex_sample_link(coex_link_t *link)
+{
+    struct lld_evt_tag *evt;
+    uint16_t events;
+    uint16_t missed = 0;
+    uint16_t retx = 0;
+    uint8_t prev_step;
+
+    if (llc_env[link->conhdl] == NULL || llc_env[link->conhdl]->elt == NULL)
+    {
+        return;
+    }
+
+    evt = LLD_EVT_ENV_ADDR_GET(llc_env[link->conhdl]->elt);
+    events = evt->counter - link->last_counter;
+
+    if (events == 0)
+    {
+        return;
+    }
+
+    link->last_counter = evt->counter;
+
+    // missed_cnt holds the current streak of events without a packet from the peer
+    if (evt->missed_cnt > 0)
+    {
+        missed = (evt->missed_cnt < events) ? evt->missed_cnt : events;
+    }
+    // A packet still in flight after the event was not acknowledged and is sent again
+    else if (!co_list_is_empty(&evt->tx_prog))
+    {
+        retx = 1;
+    }
+
+    prev_step = link->ctrl.stats.step;
+
+    // The event interval is counted in 625us slots
+    if (user_coex_ctrl_sample(&link->ctrl, events, missed, retx, (uint32_t)evt->interval * 625))
+    {
+        coex_apply_step(link->conhdl, prev_step, false);
+        coex_apply_step(link->conhdl, link->ctrl.stats.step, true);
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Send the statistics of the requesting connection as read response.
+ * @param[in] param         Value request of the Coex Stats characteristic
+ * @param[in] dest_id       ID of the receiving task instance
+ * @param[in] src_id        ID of the sending task instance
+ ****************************************************************************************
+ */
+static void coex_stats_read_ind_handler(struct custs1_value_req_ind const *param,
+                                        ke_task_id_t const dest_id,
+                                        ke_task_id_t const src_id)
+{
+    struct custs1_value_req_rsp *rsp = KE_MSG_ALLOC_DYN(CUSTS1_VALUE_REQ_RSP,
+                                                        src_id,
+                                                        dest_id,
+                                                        custs1_value_req_rsp,
+                                                        DEF_SVC1_COEX_STATS_CHAR_LEN);
+
+    rsp->conidx  = app_env[param->conidx].conidx;
+    rsp->att_idx = param->att_idx;
+    rsp->length  = DEF_SVC1_COEX_STATS_CHAR_LEN;
+    rsp->status  = ATT_ERR_NO_ERROR;
+    user_coex_ctrl_pack_stats(&coex_links[param->conidx].ctrl.stats, rsp->value);
+    ke_msg_send(rsp);
+}
+#endif
+
 
 void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind const *param)
 {
     default_app_on_connection(connection_idx, param);
+
+#if (WLAN_COEX_ENABLED)
+    if (app_env[connection_idx].conidx != GAP_INVALID_CONIDX)
+    {
+        coex_link_t *link = &coex_links[connection_idx];
+
+        user_coex_ctrl_init(&link->ctrl);
+        link->conhdl = param->conhdl;
+        link->last_counter = 0;
+        link->active = true;
+        coex_apply_step(link->conhdl, link->ctrl.stats.step, true);
+    }
+#endif
 }
 
 void user_on_disconnect( struct gapc_disconnect_ind const *param )
 {
+#if (WLAN_COEX_ENABLED)
+    uint8_t conidx = gapc_get_conidx(param->conhdl);
+
+    if (conidx < APP_EASY_MAX_ACTIVE_CONNECTION && coex_links[conidx].active)
+    {
+        coex_apply_step(coex_links[conidx].conhdl, coex_links[conidx].ctrl.stats.step, false);
+        coex_links[conidx].active = false;
+    }
+#endif
+
     default_app_on_disconnect(param);
 }
 
+void user_catch_rest_hndl(ke_msg_id_t const msgid,
+                          void const *param,
+                          ke_task_id_t const dest_id,
+                          ke_task_id_t const src_id)
+{
+    switch(msgid)
+    {
+        case CUSTS1_VALUE_REQ_IND:
+        {
+            struct custs1_value_req_ind const *msg_param = (struct custs1_value_req_ind const *)param;
+
+            switch (msg_param->att_idx)
+            {
+#if (WLAN_COEX_ENABLED)
+                case SVC1_IDX_COEX_STATS_VAL:
+                    coex_stats_read_ind_handler(msg_param, dest_id, src_id);
+                    break;
+#endif
+
+                default:
+                {
+                    struct custs1_value_req_rsp *rsp = KE_MSG_ALLOC(CUSTS1_VALUE_REQ_RSP,
+                                                                    src_id,
+                                                                    dest_id,
+                                                                    custs1_value_req_rsp);
+
+                    // Provide the connection index.
+                    rsp->conidx  = app_env[msg_param->conidx].conidx;
+                    // Provide the attribute index.
+                    rsp->att_idx = msg_param->att_idx;
+                    // Force current length to zero.
+                    rsp->length = 0;
+                    // Set Error status
+                    rsp->status  = ATT_ERR_APP_ERROR;
+                    // Send message
+                    ke_msg_send(rsp);
+                } break;
+            }
+        } break;
+
+        default:
+            break;
+    }
+}
+
 void user_app_on_init(void)
 {
     default_app_on_init();
@@ -76,12 +295,25 @@ void user_app_on_init(void)
     // Adds priority for the advertising events only
     wlan_coex_prio_criteria_add(WLAN_COEX_BLE_PRIO_ADV, LLD_ADV_HDL, 0);
     
-    // Uncomment for assigning priority on every data packets 
-    //wlan_coex_prio_criteria_add(WLAN_COEX_BLE_PRIO_DATA, app_env[0].conhdl, 0);
-    
-    // Uncomment for assigning priority on every 6th missed event
-    //wlan_coex_prio_criteria_add(WLAN_COEX_BLE_PRIO_MISSED, app_env[0].conhdl, 5);
+    // The data and missed event criteria of every connection are managed by the
+    // adaptive controller, see user_on_ble_powered()
+#endif
+}
+
+arch_main_loop_callback_ret_t user_on_ble_powered(void)
+{
+#if (WLAN_COEX_ENABLED)
+    uint8_t i;
+
+    for (i = 0; i < APP_EASY_MAX_ACTIVE_CONNECTION; i++)
+    {
+        if (coex_links[i].active)
+        {
+            coex_sample_link(&coex_links[i]);
+        }
+    }
 #endif
+    return GOTO_SLEEP;
 }
  
 sleep_mode_t user_app_on_validate_sleep(sleep_mode_t sleep_mode)
@@ -53,6 +53,7 @@
 #include "gapm_task.h"                 // gap functions and messages
 #include "app.h"                       // application definitions
 #include "co_error.h"                  // error code definitions
+#include "arch_api.h"
  
 
 /****************************************************************************
@@ -96,6 +97,20 @@ void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind c
 */
 void user_on_disconnect( struct gapc_disconnect_ind const *param );
 
+/**
+ ****************************************************************************************
+ * @brief Handles the messages that are not handled by the SDK internal mechanisms.
+ * @param[in] msgid         Id of the message received
+ * @param[in] param         Pointer to the parameters of the message
+ * @param[in] dest_id       ID of the receiving task instance
+ * @param[in] src_id        ID of the sending task instance
+ ****************************************************************************************
+*/
+void user_catch_rest_hndl(ke_msg_id_t const msgid,
+                          void const *param,
+                          ke_task_id_t const dest_id,
+                          ke_task_id_t const src_id);
+
 /**
  ****************************************************************************************
  * @brief Application initialization function.
@@ -103,6 +118,14 @@ void user_on_disconnect( struct gapc_disconnect_ind const *param );
 */
 void user_app_on_init(void);
 
+/**
+ ****************************************************************************************
+ * @brief Samples the connection counters for the adaptive WLAN COEX priority.
+ * @return GOTO_SLEEP
+ ****************************************************************************************
+*/
+arch_main_loop_callback_ret_t user_on_ble_powered(void);
+
 /**
  ****************************************************************************************
  * @brief User validate going to sleep hook function.
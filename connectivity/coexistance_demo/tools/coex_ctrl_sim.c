@@ -0,0 +1,208 @@
+/**
+ ****************************************************************************************
+ *
+ * @file coex_ctrl_sim.c
+ *
+ * @brief Host simulation of the adaptive WLAN coexistence controller.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Feeds user_coex_ctrl.c with a synthetic WLAN interference trace, one sample per
+ * connection event, the way user_on_ble_powered() does:
+ *
+ *     gcc -O2 -Isrc -o coex_ctrl_sim tools/coex_ctrl_sim.c src/user_coex_ctrl.c
+ *     ./coex_ctrl_sim [connection interval in ms] [seed]
+ *
+ * WLAN traffic comes in bursts that block every BLE event without priority. The ladder
+ * step of the link is applied literally: with a missed event criterion of N the event
+ * after N missed ones gets through, with the data criterion every event does. The trace
+ * has an idle, a light, a heavy and again an idle phase. The latency the link actually
+ * sees is measured by the simulation and checked against the setpoint, the exit status
+ * is non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "user_coex_ctrl.h"
+
+/// Connection events per phase of the trace
+#define PHASE_EVENTS                    (12000)
+
+/// Retransmissions outside the WLAN bursts, in 1/1000
+#define RETX_PERMILLE                   (20)
+
+typedef struct
+{
+    const char *name;
+    /// Probability that a WLAN burst starts at an event, in 1/1000
+    uint16_t burst_permille;
+    uint16_t burst_min;
+    uint16_t burst_max;
+} phase_t;
+
+static const phase_t phases[] =
+{
+    {"idle",  0,   0,  0},
+    {"light", 50,  1,  2},
+    {"heavy", 100, 10, 30},
+    {"idle",  0,   0,  0},
+};
+
+#define PHASES                          (sizeof(phases) / sizeof(phases[0]))
+
+static uint32_t errors;
+
+static void fail(const char *phase, const char *what)
+{
+    errors++;
+    printf("error in %s phase: %s\n", phase, what);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t intv_ms = (argc > 1) ? strtoul(argv[1], NULL, 0) : 125;
+    coex_ctrl_t ctrl;
+    uint32_t burst = 0;
+    uint32_t waiting = 0;
+    uint8_t buf[COEX_CTRL_STATS_LEN + 1];
+    uint32_t p, i;
+
+    srand((argc > 2) ? strtoul(argv[2], NULL, 0) : 1);
+    user_coex_ctrl_init(&ctrl);
+
+    for (p = 0; p < PHASES; p++)
+    {
+        const phase_t *phase = &phases[p];
+        uint32_t changes = 0;
+        uint32_t delivered = 0;
+        uint64_t latency_sum = 0;
+        uint32_t latency_max = 0;
+        uint32_t late = 0;
+        uint16_t raises = ctrl.stats.raises;
+
+        for (i = 0; i < PHASE_EVENTS; i++)
+        {
+            coex_ctrl_step_t const *step = user_coex_ctrl_get_step(ctrl.stats.step);
+            bool blocked;
+            uint16_t missed = 0;
+            uint16_t retx = 0;
+
+            if (burst == 0 && phase->burst_permille != 0 && (uint32_t)(rand() % 1000) < phase->burst_permille)
+            {
+                burst = phase->burst_min + rand() % (phase->burst_max - phase->burst_min + 1);
+            }
+
+            blocked = (burst > 0);
+            if (burst > 0)
+            {
+                burst--;
+            }
+
+            // The priority criteria of the step let the event through the WLAN burst
+            if (blocked && (step->data || (step->missed != COEX_CTRL_NO_MISSED && waiting >= step->missed)))
+            {
+                blocked = false;
+            }
+
+            if (blocked)
+            {
+                missed = 1;
+            }
+            else if ((uint32_t)(rand() % 1000) < RETX_PERMILLE)
+            {
+                retx = 1;
+            }
+
+            if (missed || retx)
+            {
+                waiting++;
+            }
+            else
+            {
+                // Measured from the first event the packet could have been sent in
+                if (i >= PHASE_EVENTS / 2)
+                {
+                    latency_sum += (waiting + 1) * intv_ms;
+                    delivered++;
+                    if ((waiting + 1) * intv_ms > latency_max)
+                    {
+                        latency_max = (waiting + 1) * intv_ms;
+                    }
+                    if ((waiting + 1) * intv_ms > COEX_CTRL_TARGET_LATENCY_MS)
+                    {
+                        late++;
+                    }
+                }
+                waiting = 0;
+            }
+
+            if (user_coex_ctrl_sample(&ctrl, 1, missed, retx, intv_ms * 1000) && i >= PHASE_EVENTS / 2)
+            {
+                changes++;
+            }
+        }
+
+        raises = ctrl.stats.raises - raises;
+
+        printf("%s: step %u, measured %u ms, delivered mean %u ms max %u ms late %u/%u, raises %u, "
+               "step changes in 2nd half %u\n",
+               phase->name, ctrl.stats.step, ctrl.stats.latency_ms,
+               delivered ? (uint32_t)(latency_sum / delivered) : 0, latency_max, late, delivered,
+               raises, changes);
+
+        // Once settled the link holds the setpoint without hopping between steps
+        if (delivered == 0 || late * 100 > delivered)
+        {
+            fail(phase->name, "more than 1% of the packets later than the setpoint");
+        }
+        // Once the backoff is saturated a reduction is tried every COEX_CTRL_LOWER_DWELL_MAX events
+        if (changes > 2 * (PHASE_EVENTS / 2 / COEX_CTRL_LOWER_DWELL_MAX + 1))
+        {
+            fail(phase->name, "priority oscillates");
+        }
+        if (phase->burst_permille == 0 && ctrl.stats.step != 0)
+        {
+            fail(phase->name, "priority not given back to the WLAN device");
+        }
+        if (phase->burst_min * intv_ms > COEX_CTRL_TARGET_LATENCY_MS && raises == 0)
+        {
+            fail(phase->name, "priority not raised under load");
+        }
+        if (phase->burst_permille == 0 && raises != 0)
+        {
+            fail(phase->name, "priority raised without interference");
+        }
+    }
+
+    buf[COEX_CTRL_STATS_LEN] = 0xEE;
+    user_coex_ctrl_pack_stats(&ctrl.stats, buf);
+    if (buf[COEX_CTRL_STATS_LEN] != 0xEE || buf[COEX_CTRL_STATS_LEN - 1] != ctrl.stats.step)
+    {
+        fail("final", "packed statistics out of bounds");
+    }
+
+    printf("%s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
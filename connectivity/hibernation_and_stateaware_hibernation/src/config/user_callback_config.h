@@ -48,6 +48,7 @@
 #include "app_bond_db.h"
 #endif // (BLE_APP_SEC)
 #include "user_hibernation.h"
+#include "user_adv_snapshot.h"
 /*
  * LOCAL VARIABLE DEFINITIONS
  ****************************************************************************************
@@ -60,7 +61,7 @@ static const struct app_proxr_cb user_app_proxr_cb = {
 #endif // BLE_PROX_REPORTER
 
 static const struct app_callbacks user_app_callbacks = {
-    .app_on_connection                  = default_app_on_connection,
+    .app_on_connection                  = user_app_on_connection,
     .app_on_disconnect                  = user_app_on_disconnect,
     .app_on_update_params_rejected      = NULL,
     .app_on_update_params_complete      = NULL,
@@ -150,7 +151,11 @@ static const struct arch_main_loop_callbacks user_app_main_loop_callbacks = {
 
 
 static const struct default_app_operations user_default_app_operations = {
+#if defined (CFG_ADV_SNAPSHOT)
+    .default_operation_adv = user_adv_snapshot_advertise,
+#else
     .default_operation_adv = default_advertise_operation,
+#endif
 };
 
 // Place in this structure the app_<profile>_db_create and app_<profile>_enable functions
@@ -189,6 +189,12 @@
     #define GPIO_BAT_LED_PIN        GPIO_PIN_2
 #endif
 
+/****************************************************************************************/
+/* Wake latency measurement pin, used with CFG_ADV_SNAPSHOT_LATENCY                     */
+/****************************************************************************************/
+#define ADV_SNAPSHOT_LATENCY_PORT   GPIO_PORT_0
+#define ADV_SNAPSHOT_LATENCY_PIN    GPIO_PIN_7
+
 /***************************************************************************************/
 /* Production debug output configuration                                               */
 /***************************************************************************************/
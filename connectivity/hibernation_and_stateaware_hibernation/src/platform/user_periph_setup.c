@@ -80,6 +80,11 @@ void GPIO_reservations(void)
     RESERVE_GPIO(GREEN_LED, GPIO_ALERT_LED_PORT, GPIO_ALERT_LED_PIN, PID_GPIO);
 #endif
 
+#if defined (CFG_ADV_SNAPSHOT_LATENCY)
+    // Wake latency measurement
+    RESERVE_GPIO(LATENCY, ADV_SNAPSHOT_LATENCY_PORT, ADV_SNAPSHOT_LATENCY_PIN, PID_GPIO);
+#endif
+
 #if defined (CFG_SPI_FLASH_ENABLE) && !defined (__DA14586__)
     // SPI Flash
     RESERVE_GPIO(SPI_EN, SPI_EN_PORT, SPI_EN_PIN, PID_SPI_EN);
@@ -116,6 +121,11 @@ void set_pad_functions(void)        // set gpio port function mode
     GPIO_ConfigurePin(GPIO_ALERT_LED_PORT, GPIO_ALERT_LED_PIN, OUTPUT, PID_GPIO, false);
 #endif
 
+#if defined (CFG_ADV_SNAPSHOT_LATENCY)
+    // Wake latency measurement
+    GPIO_ConfigurePin(ADV_SNAPSHOT_LATENCY_PORT, ADV_SNAPSHOT_LATENCY_PIN, OUTPUT, PID_GPIO, false);
+#endif
+
 #if defined (CFG_SPI_FLASH_ENABLE)
     // SPI Flash
     GPIO_ConfigurePin(SPI_EN_PORT, SPI_EN_PIN, OUTPUT, PID_SPI_EN, true);
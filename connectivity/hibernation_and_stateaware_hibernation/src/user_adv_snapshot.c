@@ -0,0 +1,247 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_adv_snapshot.c
+ *
+ * @brief Retained advertising snapshot source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "rwip_config.h"
+#include "arch.h"
+#include "gapm_task.h"
+#include "gpio.h"
+#include "app.h"
+#include "app_task.h"
+#include "app_easy_gap.h"
+#include "app_easy_timer.h"
+#include "user_config.h"
+#include "user_periph_setup.h"
+#include "user_hibernation.h"
+#include "user_adv_snapshot.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define ADV_SNAPSHOT_MAGIC          (0x53564441)    // "ADVS"
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct adv_snapshot
+{
+    uint32_t magic;
+    /// Checksum of the advertising configuration the command was built from
+    uint32_t config_id;
+    /// Ready to send advertise command
+    struct gapm_start_advertise_cmd cmd;
+    struct adv_snapshot_counters counters;
+    /// Checksum of all the fields above
+    uint32_t checksum;
+};
+
+// The build fails here if the snapshot does not fit in CFG_RET_DATA_UNINIT_SIZE
+typedef char adv_snapshot_fits_uninit_area[(sizeof(struct adv_snapshot) <= CFG_RET_DATA_UNINIT_SIZE) ? 1 : -1];
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+// Survives hibernation with the RAM retained
+struct adv_snapshot adv_snapshot                    __SECTION_ZERO("retention_mem_area_uninit");
+
+timer_hnd adv_snapshot_timer                        __SECTION_ZERO("retention_mem_area0"); //@ RETENTION MEMORY
+bool adv_snapshot_warm                              __SECTION_ZERO("retention_mem_area0"); //@ RETENTION MEMORY
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Fletcher-32 style checksum, one addition per byte. The sums are reduced once at
+ *        the end, which is safe for buffers of a few kilobytes.
+ * @param[in] data      Data to check.
+ * @param[in] len       Data length.
+ * @param[in] seed      Checksum of the preceding data, 0 for the first buffer.
+ * @return Checksum.
+ ****************************************************************************************
+ */
+static uint32_t adv_snapshot_checksum(const void *data, uint16_t len, uint32_t seed)
+{
+    const uint8_t *p = data;
+    uint32_t a = seed & 0xFFFF;
+    uint32_t b = seed >> 16;
+
+    while (len--)
+    {
+        a += *p++;
+        b += a;
+    }
+
+    return ((b % 0xFFFF) << 16) | (a % 0xFFFF);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Identifies the advertising configuration, so that a snapshot left by another
+ *        firmware build is not used.
+ ****************************************************************************************
+ */
+static uint32_t adv_snapshot_config_id(void)
+{
+    uint32_t id;
+
+    id = adv_snapshot_checksum(&user_adv_conf, sizeof(user_adv_conf), 0);
+    id = adv_snapshot_checksum(USER_ADVERTISE_DATA, USER_ADVERTISE_DATA_LEN, id);
+    id = adv_snapshot_checksum(USER_ADVERTISE_SCAN_RESPONSE_DATA, USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN, id);
+    id = adv_snapshot_checksum(USER_DEVICE_NAME, USER_DEVICE_NAME_LEN, id);
+
+    return id;
+}
+
+static void adv_snapshot_seal(void)
+{
+    adv_snapshot.checksum = adv_snapshot_checksum(&adv_snapshot, offsetof(struct adv_snapshot, checksum), 0);
+}
+
+static bool adv_snapshot_valid(void)
+{
+    return (adv_snapshot.magic == ADV_SNAPSHOT_MAGIC) &&
+           (adv_snapshot.checksum == adv_snapshot_checksum(&adv_snapshot, offsetof(struct adv_snapshot, checksum), 0)) &&
+           (adv_snapshot.config_id == adv_snapshot_config_id());
+}
+
+static void adv_snapshot_latency_end(void)
+{
+#if defined (CFG_ADV_SNAPSHOT_LATENCY)
+    GPIO_SetInactive(ADV_SNAPSHOT_LATENCY_PORT, ADV_SNAPSHOT_LATENCY_PIN);
+#endif
+}
+
+/**
+ ****************************************************************************************
+ * @brief Advertise period timer callback. Stops advertising, the completion event puts
+ *        the device back into hibernation.
+ ****************************************************************************************
+ */
+static void adv_snapshot_timeout_cb(void)
+{
+    adv_snapshot_timer = EASY_TIMER_INVALID_TIMER;
+
+    if (ke_state_get(TASK_APP) == APP_CONNECTABLE)
+    {
+        app_easy_gap_advertise_stop();
+    }
+}
+
+void user_adv_snapshot_advertise(void)
+{
+    struct gapm_start_advertise_cmd *cmd;
+
+    if (adv_snapshot_valid())
+    {
+        // Warm start, the command is sent as it was built on the cold boot
+        cmd = KE_MSG_ALLOC(GAPM_START_ADVERTISE_CMD, TASK_GAPM, TASK_APP, gapm_start_advertise_cmd);
+        memcpy(cmd, &adv_snapshot.cmd, sizeof(struct gapm_start_advertise_cmd));
+        ke_msg_send(cmd);
+        ke_state_set(TASK_APP, APP_CONNECTABLE);
+
+        adv_snapshot_warm = true;
+        adv_snapshot.counters.warm_starts++;
+    }
+    else
+    {
+        // Cold start, build the command from the user configuration and keep a copy
+        cmd = app_easy_gap_undirected_advertise_get_active();
+
+        memset(&adv_snapshot, 0, sizeof(struct adv_snapshot));
+        adv_snapshot.magic = ADV_SNAPSHOT_MAGIC;
+        adv_snapshot.config_id = adv_snapshot_config_id();
+        memcpy(&adv_snapshot.cmd, cmd, sizeof(struct gapm_start_advertise_cmd));
+
+        app_easy_gap_undirected_advertise_start();
+
+        adv_snapshot_warm = false;
+    }
+
+    adv_snapshot_latency_end();
+
+    adv_snapshot.counters.adv_starts++;
+    adv_snapshot_seal();
+
+    if (user_default_hnd_conf.adv_scenario == DEF_ADV_WITH_TIMEOUT)
+    {
+        user_adv_snapshot_cancel_timeout();
+        adv_snapshot_timer = app_easy_timer(user_default_hnd_conf.advertise_period, adv_snapshot_timeout_cb);
+    }
+}
+
+void user_adv_snapshot_cancel_timeout(void)
+{
+    if (adv_snapshot_timer != EASY_TIMER_INVALID_TIMER)
+    {
+        app_easy_timer_cancel(adv_snapshot_timer);
+        adv_snapshot_timer = EASY_TIMER_INVALID_TIMER;
+    }
+}
+
+bool user_adv_snapshot_warm(void)
+{
+    return adv_snapshot_warm;
+}
+
+const struct adv_snapshot_counters *user_adv_snapshot_counters(void)
+{
+    return &adv_snapshot.counters;
+}
+
+void user_adv_snapshot_latency_start(void)
+{
+#if defined (CFG_ADV_SNAPSHOT_LATENCY)
+    GPIO_SetActive(ADV_SNAPSHOT_LATENCY_PORT, ADV_SNAPSHOT_LATENCY_PIN);
+#endif
+}
+
+/// @} APP
@@ -0,0 +1,120 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_adv_snapshot.h
+ *
+ * @brief Retained advertising snapshot header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_ADV_SNAPSHOT_H_
+#define _USER_ADV_SNAPSHOT_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The first advertise command is built from the user configuration and kept, together
+ * with the wake-up counters, in the uninitialized retention area. It is protected by a
+ * magic word, a checksum and an identifier of the advertising configuration. When the
+ * device wakes up from hibernation with the RAM retained, or from stateful hibernation,
+ * a valid snapshot is sent to GAPM as it is, without rebuilding the advertising and
+ * scan response data. If the RAM was not retained or the firmware was changed, the
+ * snapshot does not validate and is rebuilt from the configuration.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Wake-up counters kept in the snapshot
+struct adv_snapshot_counters
+{
+    /// Advertising started from a valid snapshot
+    uint32_t warm_starts;
+    /// Advertising started since the snapshot was built
+    uint32_t adv_starts;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Starts undirected advertising from the snapshot, or builds the snapshot from the
+ *        user configuration if it is not valid. Registered as the default advertise
+ *        operation. Honors the advertise scenario of user_default_hnd_conf.
+ ****************************************************************************************
+ */
+void user_adv_snapshot_advertise(void);
+
+/**
+ ****************************************************************************************
+ * @brief Cancels the advertise period timer. Must be called on connection.
+ ****************************************************************************************
+ */
+void user_adv_snapshot_cancel_timeout(void);
+
+/**
+ ****************************************************************************************
+ * @brief Tells whether the current boot found a valid snapshot.
+ * @return True if advertising was started from a retained snapshot.
+ ****************************************************************************************
+ */
+bool user_adv_snapshot_warm(void);
+
+/**
+ ****************************************************************************************
+ * @brief Returns the wake-up counters of the snapshot.
+ * @return Pointer to the counters.
+ ****************************************************************************************
+ */
+const struct adv_snapshot_counters *user_adv_snapshot_counters(void);
+
+/**
+ ****************************************************************************************
+ * @brief Raises the wake latency pin, lowered when the advertise command is sent.
+ *        Does nothing unless CFG_ADV_SNAPSHOT_LATENCY is defined.
+ ****************************************************************************************
+ */
+void user_adv_snapshot_latency_start(void);
+
+/// @} APP
+
+#endif // _USER_ADV_SNAPSHOT_H_
@@ -52,6 +52,7 @@
 #include "arch_hibernation.h"
 #include "app_task.h"
 #include "app_proxr.h"
+#include "user_adv_snapshot.h"
 
 
 #if defined (CFG_SPI_FLASH_ENABLE)
@@ -107,6 +108,8 @@ static void app_resume_system_from_sleep(void)
  */
 static void app_button_press_cb(void)
 {
+    user_adv_snapshot_latency_start();
+
 #if (BLE_PROX_REPORTER)
     if (alert_state.lvl != PROXR_ALERT_NONE)
     {
@@ -132,6 +135,14 @@ void app_button_enable(void)
     }
 }
 
+void user_app_on_connection(uint8_t conidx, struct gapc_connection_req_ind const *param)
+{
+    // The advertise period timer is owned by the snapshot module
+    user_adv_snapshot_cancel_timeout();
+
+    default_app_on_connection(conidx, param);
+}
+
 void user_app_on_disconnect(struct gapc_disconnect_ind const *param)
 {
     default_app_on_disconnect(NULL);
@@ -147,6 +158,8 @@ void user_app_on_disconnect(struct gapc_disconnect_ind const *param)
 
 void user_app_on_init(void)
 {
+	user_adv_snapshot_latency_start();
+
 	spi_flash_power_down();
 	
 	default_app_on_init();
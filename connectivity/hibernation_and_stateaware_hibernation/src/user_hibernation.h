@@ -114,6 +114,18 @@
 
 #endif // __DA14531__
 
+/****************************************************************************************
+* Warm boot advertising                                                                 *
+*                                                                                       *
+*  - CFG_ADV_SNAPSHOT           Keep the advertise command in retained memory and send  *
+*                               it without rebuilding it after a wake-up                *
+*  - CFG_ADV_SNAPSHOT_LATENCY   Drive ADV_SNAPSHOT_LATENCY_PIN high from the start of   *
+*                               the application (or the wake-up button) until the       *
+*                               advertise command is sent                               *
+****************************************************************************************/
+#define CFG_ADV_SNAPSHOT
+#undef CFG_ADV_SNAPSHOT_LATENCY
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
@@ -143,6 +155,15 @@ void app_advertise_complete(const uint8_t status);
 */
 void user_app_on_disconnect(struct gapc_disconnect_ind const *param);
 
+/**
+ ****************************************************************************************
+ * @brief Connection function.
+ * @param[in] conidx        Connection Id index
+ * @param[in] param         Pointer to GAPC_CONNECTION_REQ_IND message
+ ****************************************************************************************
+*/
+void user_app_on_connection(uint8_t conidx, struct gapc_connection_req_ind const *param);
+
 void user_app_on_init(void);
 
 /// @} APP
@@ -0,0 +1,253 @@
+/**
+ ****************************************************************************************
+ *
+ * @file adv_snapshot_test.c
+ *
+ * @brief Host test of the retained advertising snapshot.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Builds user_adv_snapshot.c into the test, against the SDK stand-ins of helpers/host_stub and the
+ * CFG_RET_DATA_UNINIT_SIZE of the DA14531 configuration:
+ *
+ *     gcc -O2 -I../../helpers/host_stub -include src/config/da14531_config_advanced.h \
+ *         -o adv_snapshot_test tools/adv_snapshot_test.c
+ *     ./adv_snapshot_test
+ *
+ * A boot is modelled as a call of user_adv_snapshot_advertise() with the retention area
+ * either kept or filled with random data. The checks cover the cold and warm paths, every
+ * single bit error of the retained snapshot, a change of the advertising data, random RAM
+ * contents and the advertise period timer. The exit status is non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "host_stub.h"
+
+// The configuration of user_config.h, defined below
+extern const struct advertise_configuration user_adv_conf;
+extern const struct default_handlers_configuration user_default_hnd_conf;
+extern uint8_t host_adv_data[];
+
+#define USER_ADVERTISE_DATA                     (host_adv_data)
+#define USER_ADVERTISE_DATA_LEN                 (8)
+#define USER_ADVERTISE_SCAN_RESPONSE_DATA       ""
+#define USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN   (0)
+#define USER_DEVICE_NAME                        "HIBERNATION"
+#define USER_DEVICE_NAME_LEN                    (sizeof(USER_DEVICE_NAME) - 1)
+
+#include "../src/user_adv_snapshot.c"
+
+const struct advertise_configuration user_adv_conf = {0, 160, 160, 7, 0, 0, {{{0}}, 0}};
+const struct default_handlers_configuration user_default_hnd_conf = {DEF_ADV_WITH_TIMEOUT, 1000, 0};
+uint8_t host_adv_data[USER_ADVERTISE_DATA_LEN] = {0x07, 0x09, 'H', 'I', 'B', 'E', 'R', 'N'};
+
+static struct gapm_start_advertise_cmd built_cmd;
+static struct gapm_start_advertise_cmd sent_cmd;
+static uint32_t cold, warm, sent;
+static timer_hnd timers_running;
+static timer_hnd next_timer = 1;
+static ke_state_t app_state;
+
+void *host_msg_alloc(ke_msg_id_t id, ke_task_id_t dest, ke_task_id_t src, uint16_t len)
+{
+    (void)dest;
+    (void)src;
+    if ((id != GAPM_START_ADVERTISE_CMD) || (len != sizeof(sent_cmd)))
+    {
+        printf("unexpected message 0x%04X\n", id);
+        exit(1);
+    }
+    return &sent_cmd;
+}
+
+void ke_msg_send(void const *param_ptr)
+{
+    (void)param_ptr;
+    warm++;
+    sent++;
+}
+
+ke_state_t ke_state_get(ke_task_id_t id)
+{
+    (void)id;
+    return app_state;
+}
+
+void ke_state_set(ke_task_id_t id, ke_state_t state)
+{
+    (void)id;
+    app_state = state;
+}
+
+timer_hnd app_easy_timer(const uint32_t delay, void (*fn)(void))
+{
+    (void)delay;
+    (void)fn;
+    timers_running++;
+    return next_timer++;
+}
+
+void app_easy_timer_cancel(const timer_hnd timer_id)
+{
+    (void)timer_id;
+    timers_running--;
+}
+
+struct gapm_start_advertise_cmd *app_easy_gap_undirected_advertise_get_active(void)
+{
+    uint8_t i;
+
+    // The command the SDK builds from user_config.h
+    memset(&built_cmd, 0, sizeof(built_cmd));
+    built_cmd.intv_min = user_adv_conf.intv_min;
+    built_cmd.intv_max = user_adv_conf.intv_max;
+    built_cmd.channel_map = user_adv_conf.channel_map;
+    built_cmd.info.host.adv_data_len = USER_ADVERTISE_DATA_LEN;
+    for (i = 0; i < USER_ADVERTISE_DATA_LEN; i++)
+    {
+        built_cmd.info.host.adv_data[i] = host_adv_data[i];
+    }
+    return &built_cmd;
+}
+
+void app_easy_gap_undirected_advertise_start(void)
+{
+    cold++;
+    sent++;
+    app_state = APP_CONNECTABLE;
+}
+
+void app_easy_gap_advertise_stop(void)
+{
+}
+
+/// RAM contents after a power cycle
+static void scramble(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(adv_snapshot); i++)
+    {
+        ((uint8_t *)&adv_snapshot)[i] = (uint8_t)rand();
+    }
+}
+
+/// Boot with the retention area kept or lost, returns true for a warm start
+static bool boot(bool retained)
+{
+    uint32_t w = warm;
+
+    if (!retained)
+    {
+        scramble();
+    }
+    // Cleared at boot, unlike the snapshot
+    adv_snapshot_timer = EASY_TIMER_INVALID_TIMER;
+    adv_snapshot_warm = false;
+    timers_running = 0;
+    app_state = 0;
+
+    user_adv_snapshot_advertise();
+
+    return (warm != w);
+}
+
+#define CHECK(cond) do { if (!(cond)) { printf("check failed, line %d: %s\n", __LINE__, #cond); fails++; } } while (0)
+
+int main(void)
+{
+    uint32_t fails = 0;
+    uint32_t accepted = 0, missed = 0;
+    uint32_t i;
+
+    srand(1);
+
+    printf("snapshot %u bytes, CFG_RET_DATA_UNINIT_SIZE %u\n", (unsigned)sizeof(struct adv_snapshot),
+           (unsigned)CFG_RET_DATA_UNINIT_SIZE);
+    CHECK(sizeof(struct adv_snapshot) <= CFG_RET_DATA_UNINIT_SIZE);
+
+    // Power-on, then wake-ups with the RAM retained
+    CHECK(!boot(false));
+    CHECK(!user_adv_snapshot_warm());
+    CHECK((adv_snapshot.counters.warm_starts == 0) && (adv_snapshot.counters.adv_starts == 1));
+    for (i = 0; i < 5; i++)
+    {
+        CHECK(boot(true));
+        CHECK(user_adv_snapshot_warm());
+        CHECK(memcmp(&sent_cmd, &built_cmd, sizeof(sent_cmd)) == 0);
+        CHECK(app_state == APP_CONNECTABLE);
+    }
+    CHECK((user_adv_snapshot_counters()->warm_starts == 5) && (user_adv_snapshot_counters()->adv_starts == 6));
+
+    // Advertise period timer, restarted without leaking the previous one
+    CHECK(timers_running == 1);
+    user_adv_snapshot_advertise();
+    CHECK(timers_running == 1);
+    user_adv_snapshot_cancel_timeout();
+    CHECK(timers_running == 0);
+    adv_snapshot_timeout_cb();
+    CHECK(adv_snapshot_timer == EASY_TIMER_INVALID_TIMER);
+
+    // Every single bit error falls back to the cold path and rebuilds the snapshot
+    for (i = 0; i < 8 * sizeof(adv_snapshot); i++)
+    {
+        ((uint8_t *)&adv_snapshot)[i / 8] ^= (uint8_t)(1 << (i % 8));
+        if (boot(true))
+        {
+            missed++;
+        }
+        CHECK(boot(true));
+    }
+    CHECK(missed == 0);
+
+    // Another advertising configuration does not use the snapshot
+    host_adv_data[7] = 'X';
+    CHECK(!boot(true));
+    CHECK(sent_cmd.info.host.adv_data[7] != 'X');
+    CHECK(built_cmd.info.host.adv_data[7] == 'X');
+    CHECK(boot(true));
+
+    // Random RAM contents, magic included half of the time, are never taken as a snapshot
+    for (i = 0; i < 1000000; i++)
+    {
+        scramble();
+        if (i & 1)
+        {
+            adv_snapshot.magic = ADV_SNAPSHOT_MAGIC;
+            adv_snapshot.config_id = adv_snapshot_config_id();
+        }
+        if (boot(true) && (i & 1))
+        {
+            // Only a checksum collision gets here
+            accepted++;
+        }
+    }
+    CHECK(accepted <= 1);
+
+    printf("cold %u, warm %u, random snapshots accepted %u\n", cold, warm, accepted);
+    printf("%s\n", fails ? "FAILED" : "OK");
+
+    return fails ? 1 : 0;
+}
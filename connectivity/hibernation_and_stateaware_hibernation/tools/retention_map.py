@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: retention_map.py
+#
+# @brief    :: Attributes the SysRAM contents of a gcc build to RAM blocks and checks
+#              them against the RAM retention configuration of the example.
+#
+#              The input is the linker map file (input sections, so retention_mem_area0
+#              and retention_mem_area_uninit are exact) or the ELF file (output sections
+#              RET_DATA and RET_DATA_UNINIT, and the symbol table), or both. Static
+#              symbols are only known from the ELF.
+#              Every byte is classified as:
+#                  image     code, read-only data and initialized data
+#                  zero      .bss, COMMON, heaps and stack, cleared at boot
+#                  ret       retention_mem_area0, cleared at boot, kept in extended sleep
+#                  uninit    retention_mem_area_uninit, kept across hibernation
+#
+#              What has to survive depends on the sleep mode:
+#                  hibernation, boot from ROM (SPI flash, OTP):  nothing
+#                  hibernation, address 0 remapped to RAM:       image + uninit
+#                  stateful hibernation, extended sleep:         everything
+#              A boot from ROM loads the image again and rebuilds the uninit data
+#              whose check fails, so keeping the uninit data is optional there.
+#
+#                  python3 retention_map.py build/hibernation_531.map
+#                  python3 retention_map.py build/hibernation_531.elf --symbols
+#                  python3 retention_map.py build/hibernation_531.map -e build/hibernation_531.elf
+#                  python3 retention_map.py build/hibernation_531.map \
+#                      --config src/user_hibernation.h -D __DA14531__
+#
+#              With --config the active mode and the RAM1..3 settings are read from the
+#              header and the exit code is 1 if a required block is configured off, so
+#              the tool can run as a post-build step.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import re
+import struct
+import sys
+
+# chip: [(block, start, size)]
+LAYOUTS = {
+    '531': [('RAM1', 0x07FC0000, 0x4000), ('RAM2', 0x07FC4000, 0x3000), ('RAM3', 0x07FC7000, 0x5000)],
+    '585': [('RAM1', 0x07FC0000, 0x8000), ('RAM2', 0x07FC8000, 0x4000), ('RAM3', 0x07FCC000, 0x4000),
+            ('RAM4', 0x07FD0000, 0x8000)],
+}
+
+CATEGORIES = ('image', 'zero', 'ret', 'uninit')
+
+MODES = {
+    'hibernation-rom': (),
+    'hibernation-ram': ('image', 'uninit'),
+    'stateful': CATEGORIES,
+}
+
+
+# Output sections of the SDK linker scripts, NOLOAD, that hold the retained input sections
+OUTPUT_SECTIONS = {'RET_DATA_UNINIT': 'uninit', 'RET_DATA': 'ret'}
+
+
+class MapError(Exception):
+    pass
+
+
+def classify(section, nobits=False):
+    if section in OUTPUT_SECTIONS:
+        return OUTPUT_SECTIONS[section]
+    if 'retention_mem_area_uninit' in section:
+        return 'uninit'
+    if 'retention_mem_area' in section:
+        return 'ret'
+    if nobits or section.startswith(('.bss', 'COMMON', '.heap', '.stack', '.noinit')):
+        return 'zero'
+    return 'image'
+
+
+def parse_map(text):
+    '''Returns the input sections [(label, address, size, category)] and the global symbols
+    [(address, None, name)] of a GNU ld map file.'''
+    start = text.find('Linker script and memory map')
+    if start < 0:
+        raise MapError('not a GNU ld map file')
+    sections = []
+    symbols = []
+    pending = None          # input section name on its own line
+    in_section = False
+
+    for line in text[start:].splitlines():
+        if not line.strip() or line.startswith(('LOAD ', 'OUTPUT(')):
+            continue
+        m = re.match(r'^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$', line)
+        if m is not None:
+            m = m.groups()
+        elif pending is not None:
+            m2 = re.match(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$', line)
+            if m2:
+                m = (pending,) + m2.groups()
+        pending = None
+        if m is not None:
+            name, addr, size = m[0], int(m[1], 16), int(m[2], 16)
+            obj = re.split(r'[/\\]', m[3])[-1]
+            if size:
+                sections.append(('<%s %s>' % (obj, name), addr, size, classify(name)))
+            in_section = True
+            continue
+        m = re.match(r'^ (\S+)$', line)
+        if m and not m.group(1).startswith('*'):
+            pending = m.group(1)
+            continue
+        m = re.match(r'^\s{16,}0x([0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)$', line)
+        if m and in_section:
+            symbols.append((int(m.group(1), 16), None, m.group(2)))
+            continue
+        if not line.startswith(' '):
+            # Output section or linker statement
+            in_section = False
+    return sections, symbols
+
+
+def parse_elf(data):
+    '''Returns the allocated output sections [(label, address, size, category)] and the
+    symbols [(address, size, name)] of an ELF32 little endian file.'''
+    if data[:4] != b'\x7fELF' or data[4] != 1 or data[5] != 1:
+        raise MapError('not an ELF32 little endian file')
+    shoff, = struct.unpack_from('<I', data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x2E)
+    headers = [struct.unpack_from('<IIIIIIIIII', data, shoff + i * shentsize) for i in range(shnum)]
+
+    def string(table, offset):
+        base = table[4] + offset
+        return data[base:data.index(b'\0', base)].decode(errors='replace')
+
+    SHF_ALLOC, SHT_NOBITS, SHT_SYMTAB = 0x2, 8, 2
+    STT_OBJECT, STT_FUNC = 1, 2
+
+    sections = []
+    for sec in headers:
+        if sec[2] & SHF_ALLOC and sec[5]:
+            name = string(headers[shstrndx], sec[0])
+            sections.append(('<%s>' % name, sec[3], sec[5], classify(name, sec[1] == SHT_NOBITS)))
+
+    symbols = []
+    for sec in headers:
+        if sec[1] != SHT_SYMTAB:
+            continue
+        for off in range(sec[4], sec[4] + sec[5], 16):
+            st_name, value, size, info, _, shndx = struct.unpack_from('<IIIBBH', data, off)
+            kind = info & 0xF
+            if size and kind in (STT_OBJECT, STT_FUNC) and 0 < shndx < shnum:
+                # Thumb functions have bit 0 set
+                symbols.append((value & ~1 if kind == STT_FUNC else value, size, string(headers[sec[6]], st_name)))
+    return sections, symbols
+
+
+def attribute(sections, symbols):
+    '''Splits the sections in symbols. A symbol without size extends to the next symbol or
+    to the section end. Returns [(name, address, size, category)].'''
+    symbols = sorted(set(symbols))
+    items = []
+    for label, addr, size, category in sections:
+        end = addr + size
+        inside = [s for s in symbols if addr <= s[0] < end]
+        cursor = addr
+        for i, (saddr, ssize, name) in enumerate(inside):
+            if saddr < cursor:
+                continue
+            if saddr > cursor:
+                items.append((label, cursor, saddr - cursor, category))
+            stop = inside[i + 1][0] if i + 1 < len(inside) else end
+            if ssize is not None:
+                stop = saddr + ssize
+            stop = min(max(stop, saddr), end)
+            if stop > saddr:
+                items.append((name, saddr, stop - saddr, category))
+            cursor = max(cursor, stop)
+        if cursor < end:
+            items.append((label, cursor, end - cursor, category))
+    return items
+
+
+def split_blocks(items, layout):
+    '''Cuts the items at the block borders. Returns {block: [(name, address, size, category)]}.'''
+    blocks = {b[0]: [] for b in layout}
+    for name, addr, size, category in items:
+        for block, start, length in layout:
+            lo, hi = max(addr, start), min(addr + size, start + length)
+            if lo < hi:
+                blocks[block].append((name, lo, hi - lo, category))
+    return blocks
+
+
+def preprocess(text, defines):
+    '''Evaluates the #define/#undef/#if defined() structure of a configuration header.'''
+    macros = dict(defines)
+    stack = []              # (active, taken)
+
+    def active():
+        return all(s[0] for s in stack)
+
+    def evaluate(expr):
+        expr = re.sub(r'defined\s*\(\s*(\w+)\s*\)', lambda m: ' 1 ' if m.group(1) in macros else ' 0 ', expr)
+        expr = re.sub(r'defined\s+(\w+)', lambda m: ' 1 ' if m.group(1) in macros else ' 0 ', expr)
+        expr = re.sub(r'\b[A-Za-z_]\w*\b', lambda m: str(macros.get(m.group(0)) or 0), expr)
+        expr = re.sub(r'!(?!=)', ' not ', expr.replace('&&', ' and ').replace('||', ' or '))
+        try:
+            return bool(eval(expr, {'__builtins__': {}}))
+        except Exception:
+            raise MapError('cannot evaluate "%s"' % expr.strip())
+
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    for line in text.splitlines():
+        line = line.split('//', 1)[0].strip()
+        m = re.match(r'#\s*(\w+)\s*(.*)$', line)
+        if not m:
+            continue
+        directive, rest = m.groups()
+        if directive in ('if', 'ifdef', 'ifndef'):
+            if directive == 'ifdef':
+                cond = rest.split()[0] in macros
+            elif directive == 'ifndef':
+                cond = rest.split()[0] not in macros
+            else:
+                cond = active() and evaluate(rest)
+            stack.append((cond, cond))
+        elif directive == 'elif':
+            taken = stack[-1][1]
+            cond = not taken and all(s[0] for s in stack[:-1]) and evaluate(rest)
+            stack[-1] = (cond, taken or cond)
+        elif directive == 'else':
+            stack[-1] = (not stack[-1][1], True)
+        elif directive == 'endif':
+            stack.pop()
+        elif active() and directive == 'define':
+            parts = rest.split(None, 1)
+            macros[parts[0]] = parts[1].strip() if len(parts) > 1 else '1'
+        elif active() and directive == 'undef':
+            macros.pop(rest.split()[0], None)
+    return macros
+
+
+def read_config(path, defines, layout):
+    '''Returns (mode, {block: retained}) from user_hibernation.h.'''
+    with open(path) as f:
+        macros = preprocess(f.read(), defines)
+    if 'CFG_APP_GOTO_STATEFUL_HIBERNATION' in macros:
+        mode, prefix = 'stateful', 'CFG_STATEFUL_HIBERNATION_'
+    elif 'CFG_APP_GOTO_HIBERNATION' in macros:
+        prefix = 'CFG_HIBERNATION_'
+        remap = macros.get(prefix + 'REMAP')
+        if remap is None:
+            raise MapError('%sREMAP is not defined in %s' % (prefix, path))
+        # REMAP_ADDR0_TO_ROM and REMAP_ADDR0_TO_OTP boot without any RAM contents
+        mode = 'hibernation-ram' if 'RAM' in remap else 'hibernation-rom'
+    else:
+        raise MapError('%s selects no hibernation mode' % path)
+    retained = {}
+    for block, _, _ in layout:
+        value = macros.get(prefix + block)
+        if value is None and block == layout[-1][0] and len(layout) > 3:
+            # DA14585/586 RAM4 is always retained
+            value = '_ON'
+        if value is None:
+            raise MapError('%s%s is not defined in %s' % (prefix, block, path))
+        retained[block] = value.endswith('_ON')
+    return mode, retained
+
+
+def report(blocks, layout, mode, retained, show_symbols):
+    need = MODES[mode]
+    required = {}
+    print('%-5s %-23s %7s %7s %7s %7s %7s  %s' % ('block', 'range', 'image', 'zero', 'ret', 'uninit', 'free',
+                                                   'retention'))
+    for block, start, length in layout:
+        used = {c: sum(i[2] for i in blocks[block] if i[3] == c) for c in CATEGORIES}
+        required[block] = any(used[c] for c in need)
+        state = 'required' if required[block] else 'not needed'
+        if retained is not None:
+            state += ', configured %s' % ('ON' if retained[block] else 'OFF')
+        print('%-5s 0x%08X-0x%08X %7d %7d %7d %7d %7d  %s' % (
+            block, start, start + length - 1, used['image'], used['zero'], used['ret'], used['uninit'],
+            length - sum(used.values()), state))
+
+    print('\nmode %s retains: %s' % (mode, ', '.join(need) or 'nothing'))
+    print('minimal retention: %s' % (', '.join(b for b in required if required[b]) or 'none'))
+
+    for block, _, _ in layout:
+        kept = [i for i in blocks[block] if i[3] in need]
+        if show_symbols or (retained is not None and required[block] and not retained[block]):
+            for name, addr, size, category in sorted(kept, key=lambda i: i[1]):
+                print('  %s 0x%08X %6d %-6s %s' % (block, addr, size, category, name))
+
+    failed = [b for b in required if retained is not None and required[b] and not retained[b]]
+    for block in failed:
+        print('error: %s holds data that must be retained in %s mode but is configured off' % (block, mode),
+              file=sys.stderr)
+    return not failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SysRAM retention analyzer for gcc builds.')
+    parser.add_argument('input', help='linker map file or ELF file')
+    parser.add_argument('-e', '--elf', help='ELF file of a map input, for static symbols and symbol sizes')
+    parser.add_argument('-c', '--chip', choices=sorted(LAYOUTS), default='531', help='RAM layout (default 531)')
+    parser.add_argument('-m', '--mode', choices=sorted(MODES), help='sleep mode, read from --config if given')
+    parser.add_argument('--config', help='user_hibernation.h, checks the configured RAM retention')
+    parser.add_argument('-D', dest='defines', action='append', default=[], metavar='MACRO',
+                        help='macro defined before --config is read, e.g. __DA14531__')
+    parser.add_argument('-s', '--symbols', action='store_true', help='list the retained symbols per block')
+    args = parser.parse_args()
+
+    layout = LAYOUTS[args.chip]
+    try:
+        with open(args.input, 'rb') as f:
+            data = f.read()
+        if data[:4] == b'\x7fELF':
+            sections, symbols = parse_elf(data)
+        else:
+            sections, symbols = parse_map(data.decode(errors='replace'))
+            if args.elf:
+                # Sized symbols, static ones included
+                with open(args.elf, 'rb') as f:
+                    symbols = parse_elf(f.read())[1]
+        items = attribute(sections, symbols)
+        mode, retained = args.mode, None
+        if args.config:
+            defines = dict((d.split('=', 1) + ['1'])[:2] for d in args.defines)
+            config_mode, retained = read_config(args.config, defines, layout)
+            mode = mode or config_mode
+        if mode is None:
+            mode = 'stateful'
+        ok = report(split_blocks(items, layout), layout, mode, retained, args.symbols)
+    except (MapError, OSError) as e:
+        sys.stderr.write('error: %s\n' % e)
+        sys.exit(2)
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: retention_map_test.py
+#
+# @brief    :: Tests of retention_map.py against the sample build of tools/samples, whose
+#              linker script places the retained data in the RET_DATA_UNINIT and RET_DATA
+#              output sections like the SDK does.
+#
+#                  python3 tools/retention_map_test.py
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+SAMPLES = os.path.join(TOOLS, 'samples')
+sys.path.insert(0, TOOLS)
+
+import retention_map  # noqa: E402
+
+LAYOUT = retention_map.LAYOUTS['531']
+
+# Section sizes of sample.map: ret_var[4], and snapshot[27] and the static crash[35] with
+# the 32-byte alignment of the arrays
+RET = 4 * 4
+UNINIT = 0x10C
+
+
+def load(name):
+    with open(os.path.join(SAMPLES, name), 'rb') as f:
+        return f.read()
+
+
+def totals(sections, symbols):
+    items = retention_map.attribute(sections, symbols)
+    return {c: sum(i[2] for i in items if i[3] == c) for c in retention_map.CATEGORIES}, items
+
+
+def run_tool(*args):
+    return subprocess.run([sys.executable, os.path.join(TOOLS, 'retention_map.py')] + list(args),
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+
+
+class RetentionMapTest(unittest.TestCase):
+    def test_elf_output_sections(self):
+        # NOLOAD output sections are NOBITS, the retained ones must not count as zero
+        used, _ = totals(*retention_map.parse_elf(load('sample.elf')))
+        self.assertEqual(used['uninit'], UNINIT)
+        self.assertEqual(used['ret'], RET)
+
+    def test_map_input_sections(self):
+        used, _ = totals(*retention_map.parse_map(load('sample.map').decode()))
+        self.assertEqual(used['uninit'], UNINIT)
+        self.assertEqual(used['ret'], RET)
+
+    def test_map_and_elf_agree(self):
+        elf_used, _ = totals(*retention_map.parse_elf(load('sample.elf')))
+        sections, _ = retention_map.parse_map(load('sample.map').decode())
+        map_used, items = totals(sections, retention_map.parse_elf(load('sample.elf'))[1])
+        for category in ('image', 'ret', 'uninit'):
+            self.assertEqual(map_used[category], elf_used[category], category)
+        # The static array is only known from the ELF symbol table
+        names = {i[0]: i for i in items}
+        self.assertEqual(names['crash'][2:], (35 * 4, 'uninit'))
+        self.assertEqual(names['snapshot'][2:], (27 * 4, 'uninit'))
+
+    def test_blocks(self):
+        items = retention_map.attribute(*retention_map.parse_elf(load('sample.elf')))
+        blocks = retention_map.split_blocks(items, LAYOUT)
+        self.assertEqual(sum(i[2] for i in blocks['RAM3'] if i[3] == 'uninit'), UNINIT)
+        self.assertFalse(blocks['RAM2'])
+
+    def test_config(self):
+        header = ('#define CFG_APP_GOTO_HIBERNATION\n'
+                  '#define CFG_HIBERNATION_RAM1 PD_SYS_DOWN_RAM_ON\n'
+                  '#define CFG_HIBERNATION_RAM2 PD_SYS_DOWN_RAM_OFF\n'
+                  '#define CFG_HIBERNATION_RAM3 PD_SYS_DOWN_RAM_%s\n'
+                  '#define CFG_HIBERNATION_REMAP REMAP_ADDR0_TO_%s\n')
+        elf = os.path.join(SAMPLES, 'sample.elf')
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'config.h')
+            # A boot from ROM or OTP needs no RAM, the uninit data of RAM3 is rebuilt
+            for remap in ('ROM', 'OTP'):
+                for ram3 in ('ON', 'OFF'):
+                    with open(path, 'w') as f:
+                        f.write(header % (ram3, remap))
+                    result = run_tool(elf, '--config', path)
+                    self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+                    self.assertIn('mode hibernation-rom retains: nothing', result.stdout)
+                    self.assertIn('minimal retention: none', result.stdout)
+            # Booting from RAM1 keeps the image of RAM1 and the uninit data of RAM3
+            for ram3, code in (('ON', 0), ('OFF', 1)):
+                with open(path, 'w') as f:
+                    f.write(header % (ram3, 'RAM1'))
+                result = run_tool(elf, '--config', path)
+                self.assertEqual(result.returncode, code, result.stdout + result.stderr)
+                self.assertIn('minimal retention: RAM1, RAM3', result.stdout)
+            self.assertIn('error: RAM3', result.stderr)
+
+    def test_example_config(self):
+        # The SysRAM use-case of the example retains every block
+        result = run_tool(os.path.join(SAMPLES, 'sample.map'), '-e', os.path.join(SAMPLES, 'sample.elf'),
+                          '--config', os.path.join(TOOLS, '..', 'src', 'user_hibernation.h'), '-D', '__DA14531__')
+        self.assertEqual(result.returncode, 0, result.stderr)
+        self.assertIn('mode hibernation-ram', result.stdout)
+
+
+if __name__ == '__main__':
+    unittest.main()
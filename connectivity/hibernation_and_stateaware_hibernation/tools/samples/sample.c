@@ -0,0 +1,21 @@
+/* Sample input of tools/retention_map_test.py, see sample.lds */
+
+int counter;
+static int scounter;
+int table[3000] = {1};
+const char banner[] = "retention_map sample";
+
+__attribute__((section("retention_mem_area0"))) int ret_var[4];
+__attribute__((section("retention_mem_area_uninit"))) int snapshot[27];
+__attribute__((section("retention_mem_area_uninit"))) static int crash[35];
+
+int sample(void)
+{
+    return counter + scounter++ + table[1] + banner[0] + ret_var[0] + snapshot[0] + crash[1];
+}
+
+void _start(void)
+{
+    sample();
+    for (;;);
+}
@@ -64,6 +64,7 @@ static const uint8_t SVC1_ADC_VAL_2_UUID_128[ATT_UUID_128_LEN]        = DEF_SVC1
 static const uint8_t SVC1_BUTTON_STATE_UUID_128[ATT_UUID_128_LEN]     = DEF_SVC1_BUTTON_STATE_UUID_128;
 static const uint8_t SVC1_INDICATEABLE_UUID_128[ATT_UUID_128_LEN]     = DEF_SVC1_INDICATEABLE_UUID_128;
 static const uint8_t SVC1_LONG_VALUE_UUID_128[ATT_UUID_128_LEN]       = DEF_SVC1_LONG_VALUE_UUID_128;
+static const uint8_t SVC1_SCAN_STATS_UUID_128[ATT_UUID_128_LEN]       = DEF_SVC1_SCAN_STATS_UUID_128;
 
 // Service 2 of the custom server 1
 static const att_svc_desc128_t custs1_svc2                      = DEF_SVC2_UUID_128;
@@ -212,6 +213,23 @@ const struct attm_desc_128 custs1_att_db[CUSTS1_IDX_NB] =
                                             sizeof(DEF_SVC1_LONG_VALUE_CHAR_USER_DESC) - 1, sizeof(DEF_SVC1_LONG_VALUE_CHAR_USER_DESC) - 1,
                                             (uint8_t *) DEF_SVC1_LONG_VALUE_CHAR_USER_DESC},
 
+    // Scan Statistics Characteristic Declaration
+    [SVC1_IDX_SCAN_STATS_CHAR]         = {(uint8_t*)&att_decl_char, ATT_UUID_16_LEN, PERM(RD, ENABLE),
+                                            0, 0, NULL},
+
+    // Scan Statistics Characteristic Value
+    [SVC1_IDX_SCAN_STATS_VAL]          = {SVC1_SCAN_STATS_UUID_128, ATT_UUID_128_LEN, PERM(NTF, ENABLE),
+                                            DEF_SVC1_SCAN_STATS_CHAR_LEN, 0, NULL},
+
+    // Scan Statistics Client Characteristic Configuration Descriptor
+    [SVC1_IDX_SCAN_STATS_NTF_CFG]      = {(uint8_t*)&att_desc_cfg, ATT_UUID_16_LEN, PERM(RD, ENABLE) | PERM(WR, ENABLE) | PERM(WRITE_REQ, ENABLE),
+                                            sizeof(uint16_t), 0, NULL},
+
+    // Scan Statistics Characteristic User Description
+    [SVC1_IDX_SCAN_STATS_USER_DESC]    = {(uint8_t*)&att_desc_user_desc, ATT_UUID_16_LEN, PERM(RD, ENABLE),
+                                            sizeof(DEF_SVC1_SCAN_STATS_USER_DESC) - 1, sizeof(DEF_SVC1_SCAN_STATS_USER_DESC) - 1,
+                                            (uint8_t *) DEF_SVC1_SCAN_STATS_USER_DESC},
+
     /*************************
      * Service 2 configuration
      *************************
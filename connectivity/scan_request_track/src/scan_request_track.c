@@ -37,16 +37,32 @@
 #include "rwip_config.h"             // SW configuration
 #include "co_buf.h"
 #include "llc_util.h"
+#include "lld_evt.h"
+#include "reg_blecore.h"
 
 /*
  * INCLUDE FILES
  ****************************************************************************************
  */
 
+#include <string.h>
 #include "app_api.h"
 #include "arch_console.h"
+#include "prf_utils.h"
+#include "custs1.h"
+#include "custs1_task.h"
+#include "user_custs1_def.h"
 #include "scan_request_track.h"
 #include "user_periph_setup.h"
+#include "user_scan_stats.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// BLE slots per statistics tick
+#define SLOTS_PER_TICK                  (16)
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -55,12 +71,112 @@
 
 scn_response_callback *scn_rsp_cb               __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 
+struct scan_stats scan_stats                    __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+timer_hnd scan_stats_timer                      __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+bool scan_stats_ntf_enabled                     __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+uint8_t scan_stats_seq                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+
+// Statistics clock, extended from the BLE base time
+uint32_t scan_stats_ticks                       __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+uint32_t scan_stats_slots                       __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+uint32_t scan_stats_last_time                   __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+
 /*
  * FUNCTION DEFINITIONS
  ****************************************************************************************
 */
 static void user_scan_request_cb(struct scan_req_data_msg const * param);
 
+/**
+ ****************************************************************************************
+ * @brief Current time of the statistics in 10 ms ticks. The BLE base time wraps after
+ *        about 23 hours, the report timer calls this often enough to follow it.
+ * @return Ticks since the application started
+ ****************************************************************************************
+ */
+static uint32_t user_scan_stats_now(void)
+{
+    uint32_t time = lld_evt_time_get();
+
+    // The base time counter of the BLE core has 27 bits
+    scan_stats_slots += (time - scan_stats_last_time) & BLE_BASETIMECNT_MASK;
+    scan_stats_last_time = time;
+
+    scan_stats_ticks += scan_stats_slots / SLOTS_PER_TICK;
+    scan_stats_slots %= SLOTS_PER_TICK;
+
+    return scan_stats_ticks;
+}
+
+static void user_scan_stats_ntf_send(uint8_t const *frame)
+{
+    struct custs1_val_ntf_ind_req *req = KE_MSG_ALLOC_DYN(CUSTS1_VAL_NTF_REQ,
+                                                          prf_get_task_from_id(TASK_ID_CUSTS1),
+                                                          TASK_APP,
+                                                          custs1_val_ntf_ind_req,
+                                                          SCAN_STATS_FRAME_LEN);
+
+    req->conidx = 0;                                        //This application can only have one connection(0)
+    req->notification = true;
+    req->handle = SVC1_IDX_SCAN_STATS_VAL;
+    req->length = SCAN_STATS_FRAME_LEN;
+    memcpy(req->value, frame, SCAN_STATS_FRAME_LEN);
+
+    ke_msg_send(req);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Sends a summary of the busiest scanners: a header frame followed by one frame
+ *        per scanner, highest count first. See user_scan_stats.h for the format.
+ * @return void
+ ****************************************************************************************
+ */
+static void user_scan_stats_report(void)
+{
+    uint8_t frame[SCAN_STATS_FRAME_LEN];
+    uint32_t now = user_scan_stats_now();
+    uint8_t top = (scan_stats.used < SCAN_STATS_REPORT_TOP) ? scan_stats.used : SCAN_STATS_REPORT_TOP;
+    uint8_t rank;
+
+    scan_stats_seq++;
+
+    if (scan_stats_ntf_enabled)
+    {
+        scan_stats_encode_header(&scan_stats, scan_stats_seq, top, now, frame);
+        user_scan_stats_ntf_send(frame);
+
+        for (rank = 0; rank < top; rank++)
+        {
+            scan_stats_encode_entry(&scan_stats, rank, scan_stats_seq, now, frame);
+            user_scan_stats_ntf_send(frame);
+        }
+    }
+
+#if defined (CFG_PRINTF)
+    arch_printf("Scan requests: %lu, scanners tracked: %d, untracked at most %lu each\n\r",
+                (unsigned long)scan_stats.total, scan_stats.used,
+                (unsigned long)scan_stats_floor(&scan_stats));
+    for (rank = 0; rank < top; rank++)
+    {
+        struct scan_stats_entry const *entry = &scan_stats.entries[rank];
+
+        arch_printf("%02x:%02x:%02x:%02x:%02x:%02x %lu (-%lu) every %lu ms\n\r",
+                    entry->addr[5], entry->addr[4], entry->addr[3],
+                    entry->addr[2], entry->addr[1], entry->addr[0],
+                    (unsigned long)entry->count, (unsigned long)entry->error,
+                    (unsigned long)scan_stats_interval(entry, now) * 10);
+    }
+#endif
+}
+
+static void user_scan_stats_timer_cb(void)
+{
+    scan_stats_timer = app_easy_timer(SCAN_STATS_REPORT_PERIOD, user_scan_stats_timer_cb);
+
+    user_scan_stats_report();
+}
+
 void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind const *param)
 {
 	default_app_on_connection(connection_idx, param);
@@ -68,11 +184,16 @@ void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind c
 
 void user_on_disconnect( struct gapc_disconnect_ind const *param )
 {
+    scan_stats_ntf_enabled = false;
     default_app_on_disconnect(param);
 }
 
 void user_app_init(void)
 {
+    scan_stats_init(&scan_stats);
+    scan_stats_last_time = lld_evt_time_get();
+    scan_stats_timer = app_easy_timer(SCAN_STATS_REPORT_PERIOD, user_scan_stats_timer_cb);
+
     scan_request_callback_register(user_scan_request_cb);
     default_app_on_init();
 }
@@ -90,6 +211,22 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
                 scn_rsp_cb(param);
         }break;
 
+        case CUSTS1_VAL_WRITE_IND:
+        {
+            struct custs1_val_write_ind const *msg_param = (struct custs1_val_write_ind const *)(param);
+
+            if (msg_param->handle == SVC1_IDX_SCAN_STATS_NTF_CFG)
+            {
+                scan_stats_ntf_enabled = (msg_param->value[0] & PRF_CLI_START_NTF) != 0;
+
+                // A new subscriber gets the current summary right away
+                if (scan_stats_ntf_enabled)
+                {
+                    user_scan_stats_report();
+                }
+            }
+        }break;
+
         default:
             break;
     }
@@ -99,6 +236,9 @@ void user_catch_rest_hndl(ke_msg_id_t const msgid,
 
 static void user_scan_request_cb(struct scan_req_data_msg const * param)
 {
+    scan_stats_update(&scan_stats, param->scn_bd_address, user_scan_stats_now());
+
+#if SCAN_STATS_PRINT_REQUESTS
   arch_printf("Scan request from ");
 	arch_printf("%02x:%02x:%02x:%02x:%02x:%02x \n\r", 
                 param->scn_bd_address[5],
@@ -107,6 +247,7 @@ static void user_scan_request_cb(struct scan_req_data_msg const * param)
                 param->scn_bd_address[2],
                 param->scn_bd_address[1],
                 param->scn_bd_address[0]);
+#endif
 #if defined (__DA14531__)
     arch_set_pxact_gpio(GPIO_CURSOR_PORT, GPIO_CURSOR_PIN);
 #else
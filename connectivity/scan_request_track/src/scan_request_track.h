@@ -75,6 +75,16 @@ i.e.
  ****************************************************************************************
  */
 
+/// Period of the scan statistics summary, in 10 ms ticks
+#define SCAN_STATS_REPORT_PERIOD        (6000)
+
+/// Scanners in each summary, highest count first
+#define SCAN_STATS_REPORT_TOP           (8)
+
+/// Prints every scan request on the UART. Under heavy scanning the UART falls behind,
+/// the periodic summary is printed in any case
+#define SCAN_STATS_PRINT_REQUESTS       (0)
+
 /*
  * FUNCTION DECLARATIONS
  ****************************************************************************************
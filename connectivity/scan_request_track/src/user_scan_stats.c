@@ -0,0 +1,314 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_scan_stats.c
+ *
+ * @brief Scan request statistics source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "user_scan_stats.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define INDEX_MASK                      (SCAN_STATS_INDEX_LEN - 1)
+
+/// Longest interval averaged, keeps the fixed point value in 32 bits
+#define INTERVAL_MAX                    (0xFFFFFFFFUL >> (SCAN_STATS_INTERVAL_FRAC + 1))
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint8_t scan_stats_hash(const uint8_t *addr)
+{
+    uint32_t h = (uint32_t)addr[0] | ((uint32_t)addr[1] << 8) | ((uint32_t)addr[2] << 16) |
+                 ((uint32_t)addr[3] << 24);
+
+    h ^= ((uint32_t)addr[4] << 5) | ((uint32_t)addr[5] << 13);
+    h *= 0x9E3779B1UL;
+
+    return (uint8_t)((h >> 24) & INDEX_MASK);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Finds the slot of an address, or the free slot where it would be inserted. The
+ *        index always has free slots, so the probe ends.
+ ****************************************************************************************
+ */
+static uint8_t scan_stats_probe(const struct scan_stats *st, const uint8_t *addr)
+{
+    uint8_t slot = scan_stats_hash(addr);
+
+    while ((st->index[slot] != SCAN_STATS_INDEX_EMPTY) &&
+           (memcmp(st->entries[st->index[slot]].addr, addr, SCAN_STATS_ADDR_LEN) != 0))
+    {
+        slot = (slot + 1) & INDEX_MASK;
+    }
+
+    return slot;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Frees a slot of the index. The slots that follow in the same run are shifted
+ *        back, so that no probe stops early at the freed slot.
+ ****************************************************************************************
+ */
+static void scan_stats_unlink(struct scan_stats *st, uint8_t slot)
+{
+    uint8_t next = slot;
+    uint8_t home;
+
+    for (;;)
+    {
+        next = (next + 1) & INDEX_MASK;
+        if (st->index[next] == SCAN_STATS_INDEX_EMPTY)
+        {
+            break;
+        }
+
+        // The entry can move back unless its home slot lies between the hole and it
+        home = scan_stats_hash(st->entries[st->index[next]].addr);
+        if (((next - home) & INDEX_MASK) >= ((next - slot) & INDEX_MASK))
+        {
+            st->index[slot] = st->index[next];
+            st->entries[st->index[slot]].slot = slot;
+            slot = next;
+        }
+    }
+
+    st->index[slot] = SCAN_STATS_INDEX_EMPTY;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Restores the order after the count of an entry has been incremented. The entries
+ *        above it have at least its previous count, it swaps with the first of those that
+ *        had the same one.
+ ****************************************************************************************
+ */
+static const struct scan_stats_entry *scan_stats_promote(struct scan_stats *st, uint8_t pos)
+{
+    struct scan_stats_entry tmp;
+    uint32_t count = st->entries[pos].count;
+    uint8_t lo = 0;
+    uint8_t hi = pos;
+    uint8_t mid;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if (st->entries[mid].count < count)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    if (lo != pos)
+    {
+        tmp = st->entries[lo];
+        st->entries[lo] = st->entries[pos];
+        st->entries[pos] = tmp;
+        st->index[st->entries[lo].slot] = lo;
+        st->index[st->entries[pos].slot] = pos;
+    }
+
+    return &st->entries[lo];
+}
+
+static void scan_stats_average(struct scan_stats_entry *entry, uint32_t now)
+{
+    uint32_t delta = now - entry->last_seen;
+
+    if (delta > INTERVAL_MAX)
+    {
+        delta = INTERVAL_MAX;
+    }
+    delta <<= SCAN_STATS_INTERVAL_FRAC;
+
+    if (entry->count - entry->error == 1)
+    {
+        entry->interval = delta;
+    }
+    else if (delta >= entry->interval)
+    {
+        entry->interval += (delta - entry->interval) >> SCAN_STATS_INTERVAL_WEIGHT;
+    }
+    else
+    {
+        entry->interval -= (entry->interval - delta) >> SCAN_STATS_INTERVAL_WEIGHT;
+    }
+}
+
+static void put_le16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void put_le32(uint8_t *buf, uint32_t value)
+{
+    put_le16(buf, (uint16_t)value);
+    put_le16(buf + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t saturate16(uint32_t value)
+{
+    return (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
+}
+
+void scan_stats_init(struct scan_stats *st)
+{
+    memset(st, 0, sizeof(*st));
+    memset(st->index, SCAN_STATS_INDEX_EMPTY, sizeof(st->index));
+}
+
+const struct scan_stats_entry *scan_stats_update(struct scan_stats *st, const uint8_t *addr,
+                                                 uint32_t now)
+{
+    uint8_t slot = scan_stats_probe(st, addr);
+    uint8_t pos = st->index[slot];
+    struct scan_stats_entry *entry;
+
+    st->total++;
+
+    if (pos != SCAN_STATS_INDEX_EMPTY)
+    {
+        entry = &st->entries[pos];
+        scan_stats_average(entry, now);
+        entry->last_seen = now;
+        entry->count++;
+
+        return scan_stats_promote(st, pos);
+    }
+
+    if (st->used < SCAN_STATS_CAPACITY)
+    {
+        pos = st->used++;
+        entry = &st->entries[pos];
+        entry->count = 0;
+        entry->error = 0;
+    }
+    else
+    {
+        // The new scanner takes over the lowest count, which bounds its own requests
+        pos = SCAN_STATS_CAPACITY - 1;
+        entry = &st->entries[pos];
+        entry->error = entry->count;
+        st->evictions++;
+
+        scan_stats_unlink(st, entry->slot);
+        slot = scan_stats_probe(st, addr);
+    }
+
+    memcpy(entry->addr, addr, SCAN_STATS_ADDR_LEN);
+    entry->count++;
+    entry->first_seen = now;
+    entry->last_seen = now;
+    entry->interval = 0;
+    entry->slot = slot;
+    st->index[slot] = pos;
+
+    return scan_stats_promote(st, pos);
+}
+
+const struct scan_stats_entry *scan_stats_find(const struct scan_stats *st, const uint8_t *addr)
+{
+    uint8_t pos = st->index[scan_stats_probe(st, addr)];
+
+    return (pos != SCAN_STATS_INDEX_EMPTY) ? &st->entries[pos] : NULL;
+}
+
+uint32_t scan_stats_floor(const struct scan_stats *st)
+{
+    return (st->used == SCAN_STATS_CAPACITY) ? st->entries[SCAN_STATS_CAPACITY - 1].count : 0;
+}
+
+uint32_t scan_stats_interval(const struct scan_stats_entry *entry, uint32_t now)
+{
+    uint32_t average;
+    uint32_t silence;
+
+    if (entry->count - entry->error < 2)
+    {
+        return 0;
+    }
+
+    average = (entry->interval + (1UL << (SCAN_STATS_INTERVAL_FRAC - 1))) >> SCAN_STATS_INTERVAL_FRAC;
+    silence = now - entry->last_seen;
+
+    return (silence > average) ? silence : average;
+}
+
+void scan_stats_encode_header(const struct scan_stats *st, uint8_t seq, uint8_t top,
+                              uint32_t now, uint8_t *buf)
+{
+    buf[0] = 0;
+    buf[1] = seq;
+    buf[2] = st->used;
+    buf[3] = top;
+    put_le32(&buf[4], st->total);
+    put_le32(&buf[8], scan_stats_floor(st));
+    put_le32(&buf[12], st->evictions);
+    put_le32(&buf[16], now);
+}
+
+void scan_stats_encode_entry(const struct scan_stats *st, uint8_t rank, uint8_t seq,
+                             uint32_t now, uint8_t *buf)
+{
+    const struct scan_stats_entry *entry = &st->entries[rank];
+
+    buf[0] = rank + 1;
+    buf[1] = seq;
+    memcpy(&buf[2], entry->addr, SCAN_STATS_ADDR_LEN);
+    put_le32(&buf[8], entry->count);
+    put_le16(&buf[12], saturate16(entry->error));
+    put_le16(&buf[14], saturate16((now - entry->first_seen) / SCAN_STATS_TICKS_PER_SEC));
+    put_le16(&buf[16], saturate16((now - entry->last_seen) / SCAN_STATS_TICKS_PER_SEC));
+    put_le16(&buf[18], saturate16(scan_stats_interval(entry, now)));
+}
+
+/// @} APP
@@ -0,0 +1,244 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_scan_stats.h
+ *
+ * @brief Scan request statistics header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_SCAN_STATS_H_
+#define _USER_SCAN_STATS_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * Per-scanner statistics of the scan requests in a fixed amount of memory, with the
+ * Space-Saving heavy hitter algorithm. Up to SCAN_STATS_CAPACITY scanners are tracked.
+ * A request from an untracked scanner, when the table is full, takes over the entry with
+ * the lowest count: the count is incremented and the previous count is kept as the error
+ * of the new scanner. With N the total of requests and min the lowest count in the table:
+ *
+ *   - a tracked scanner made between count - error and count requests;
+ *   - an untracked scanner made at most min requests, and min <= N / SCAN_STATS_CAPACITY;
+ *   - every scanner with more than N / SCAN_STATS_CAPACITY requests is tracked.
+ *
+ * A busy scanner keeps its entry once it has one, from then on its requests are counted
+ * exactly, the error only covers the requests before it came in. The long tail shares the
+ * entries at the bottom of the table.
+ *
+ * The entries are kept sorted by count, highest first, so that the summary is read from
+ * the top of the table. A request costs one lookup in an open addressing index, a binary
+ * search for the place of the incremented entry and at most one swap, whatever the
+ * number of scanners seen.
+ *
+ * Times are in 10 ms ticks. The request interval of a scanner is a moving average over
+ * about SCAN_STATS_INTERVAL_WEIGHT requests.
+ *
+ * Summary frames, SCAN_STATS_FRAME_LEN bytes, multi-byte fields are little endian:
+ *
+ *   header      byte 0      0
+ *               byte 1      summary sequence number
+ *               byte 2      scanners tracked
+ *               byte 3      entry frames that follow
+ *               byte 4-7    total of requests
+ *               byte 8-11   lowest count when the table is full, else 0
+ *               byte 12-15  entries taken over
+ *               byte 16-19  current time in ticks
+ *
+ *   entry       byte 0      rank, starting from 1
+ *               byte 1      summary sequence number
+ *               byte 2-7    scanner address, as received over the air
+ *               byte 8-11   count
+ *               byte 12-13  error, saturated
+ *               byte 14-15  seconds since first seen, saturated
+ *               byte 16-17  seconds since last seen, saturated
+ *               byte 18-19  request interval in ticks, saturated, 0 if unknown
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Scanners tracked, at most 254
+#define SCAN_STATS_CAPACITY             (24)
+
+/// Slots of the address index, a power of two above twice the capacity
+#define SCAN_STATS_INDEX_LEN            (64)
+
+/// Free slot of the address index
+#define SCAN_STATS_INDEX_EMPTY          (0xFF)
+
+/// Weight of the request interval average, as a power of two
+#define SCAN_STATS_INTERVAL_WEIGHT      (3)
+
+/// Fractional bits of the request interval average
+#define SCAN_STATS_INTERVAL_FRAC        (4)
+
+/// Ticks per second
+#define SCAN_STATS_TICKS_PER_SEC        (100)
+
+/// Length of a summary frame, fits a notification at the default MTU
+#define SCAN_STATS_FRAME_LEN            (20)
+
+/// Length of a Bluetooth device address
+#define SCAN_STATS_ADDR_LEN             (6)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct scan_stats_entry
+{
+    /// Requests counted, including the error
+    uint32_t count;
+    /// Requests counted for the previous scanners of the entry
+    uint32_t error;
+    /// Time of the first request
+    uint32_t first_seen;
+    /// Time of the last request
+    uint32_t last_seen;
+    /// Average request interval in ticks, SCAN_STATS_INTERVAL_FRAC fractional bits
+    uint32_t interval;
+    uint8_t addr[SCAN_STATS_ADDR_LEN];
+    /// Index slot pointing to the entry
+    uint8_t slot;
+};
+
+struct scan_stats
+{
+    /// Entries in use, highest count first
+    struct scan_stats_entry entries[SCAN_STATS_CAPACITY];
+    /// Position of the entry of each slot, SCAN_STATS_INDEX_EMPTY if free
+    uint8_t index[SCAN_STATS_INDEX_LEN];
+    /// Entries in use
+    uint8_t used;
+    /// Total of requests
+    uint32_t total;
+    /// Entries taken over by a new scanner
+    uint32_t evictions;
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Clears the statistics.
+ * @param[in] st        Statistics.
+ ****************************************************************************************
+ */
+void scan_stats_init(struct scan_stats *st);
+
+/**
+ ****************************************************************************************
+ * @brief Counts a scan request.
+ * @param[in] st        Statistics.
+ * @param[in] addr      Address of the scanner.
+ * @param[in] now       Current time in ticks.
+ * @return The entry of the scanner.
+ ****************************************************************************************
+ */
+const struct scan_stats_entry *scan_stats_update(struct scan_stats *st, const uint8_t *addr,
+                                                 uint32_t now);
+
+/**
+ ****************************************************************************************
+ * @brief Looks up a scanner.
+ * @param[in] st        Statistics.
+ * @param[in] addr      Address of the scanner.
+ * @return The entry of the scanner, NULL if it is not tracked.
+ ****************************************************************************************
+ */
+const struct scan_stats_entry *scan_stats_find(const struct scan_stats *st, const uint8_t *addr);
+
+/**
+ ****************************************************************************************
+ * @brief Upper bound of the requests of a scanner that is not tracked.
+ * @param[in] st        Statistics.
+ * @return The lowest count when the table is full, else 0.
+ ****************************************************************************************
+ */
+uint32_t scan_stats_floor(const struct scan_stats *st);
+
+/**
+ ****************************************************************************************
+ * @brief Request interval of a scanner. Once the scanner has been silent for longer than
+ *        its average interval, the silence is returned instead.
+ * @param[in] entry     Entry of the scanner.
+ * @param[in] now       Current time in ticks.
+ * @return Interval in ticks, 0 if the scanner has made a single request since it took
+ *         the entry.
+ ****************************************************************************************
+ */
+uint32_t scan_stats_interval(const struct scan_stats_entry *entry, uint32_t now);
+
+/**
+ ****************************************************************************************
+ * @brief Encodes the header frame of a summary.
+ * @param[in] st        Statistics.
+ * @param[in] seq       Summary sequence number.
+ * @param[in] top       Entry frames that follow.
+ * @param[in] now       Current time in ticks.
+ * @param[out] buf      Frame, SCAN_STATS_FRAME_LEN bytes.
+ ****************************************************************************************
+ */
+void scan_stats_encode_header(const struct scan_stats *st, uint8_t seq, uint8_t top,
+                              uint32_t now, uint8_t *buf);
+
+/**
+ ****************************************************************************************
+ * @brief Encodes the entry frame of a summary.
+ * @param[in] st        Statistics.
+ * @param[in] rank      Entry, 0 for the highest count, below st->used.
+ * @param[in] seq       Summary sequence number.
+ * @param[in] now       Current time in ticks.
+ * @param[out] buf      Frame, SCAN_STATS_FRAME_LEN bytes.
+ ****************************************************************************************
+ */
+void scan_stats_encode_entry(const struct scan_stats *st, uint8_t rank, uint8_t seq,
+                             uint32_t now, uint8_t *buf);
+
+/// @} APP
+
+#endif // _USER_SCAN_STATS_H_
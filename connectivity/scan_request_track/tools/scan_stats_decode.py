@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: scan_stats_decode.py
+#
+# @brief    :: Decodes the summaries notified on the Scan Statistics characteristic of the
+#              scan_request_track example.
+#
+#              Each input is the hex dump of one notification, one per argument or one
+#              per line on stdin, in the order they were received:
+#                  python3 scan_stats_decode.py 0003180880d3...
+#                  python3 scan_stats_decode.py < notifications.txt
+#
+#              A summary is printed once its header and all its entry frames are in.
+#              Counts are given with the range of the true number of requests, the
+#              rate is derived from the average request interval.
+#
+#              The frame format is described in src/user_scan_stats.h.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import struct
+import sys
+
+FRAME_LEN = 20
+TICKS_PER_SEC = 100
+
+
+class Summary:
+    def __init__(self, frame):
+        (_, self.seq, self.tracked, self.top, self.total, self.floor, self.evictions,
+         self.now) = struct.unpack('<BBBBIIII', frame)
+        self.entries = {}
+
+    def complete(self):
+        return len(self.entries) == self.top
+
+    def add(self, frame):
+        rank, _, addr, count, error, first, last, interval = struct.unpack('<BB6sIHHHH', frame)
+        self.entries[rank] = dict(addr=':'.join('%02x' % b for b in reversed(addr)),
+                                  count=count, error=error, first=first, last=last,
+                                  interval=interval)
+
+    def print(self):
+        print('Summary %d at %.2f s: %d requests, %d scanners tracked, %d taken over'
+              % (self.seq, self.now / TICKS_PER_SEC, self.total, self.tracked, self.evictions))
+        if self.floor:
+            print('  untracked scanners made at most %d requests each' % self.floor)
+        print('  %-4s %-17s %-17s %10s %10s %9s' % ('rank', 'address', 'requests', 'first (s)',
+                                                   'last (s)', 'per min'))
+        for rank in sorted(self.entries):
+            e = self.entries[rank]
+            count = str(e['count']) if e['error'] == 0 else '%d-%d' % (e['count'] - e['error'], e['count'])
+            rate = '%.1f' % (60 * TICKS_PER_SEC / e['interval']) if e['interval'] else '-'
+            print('  %-4d %-17s %-17s %10d %10d %9s' % (rank, e['addr'], count, e['first'], e['last'], rate))
+
+
+def decode(lines):
+    summary = None
+    for line in lines:
+        frame = bytes.fromhex(''.join(line.split()))
+        if not frame:
+            continue
+        if len(frame) != FRAME_LEN:
+            print('skipped frame of %d bytes' % len(frame), file=sys.stderr)
+            continue
+        if frame[0] == 0:
+            summary = Summary(frame)
+        elif summary is not None and frame[1] == summary.seq:
+            summary.add(frame)
+        else:
+            continue
+        if summary.complete():
+            summary.print()
+            summary = None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the scan request statistics summaries.')
+    parser.add_argument('frames', nargs='*', help='notifications in hex, read from stdin if none')
+    args = parser.parse_args()
+
+    decode(args.frames if args.frames else sys.stdin)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,287 @@
+/**
+ ****************************************************************************************
+ *
+ * @file scan_stats_storm.c
+ *
+ * @brief Host check of the scan request statistics under request storms.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc -o scan_stats_storm tools/scan_stats_storm.c src/user_scan_stats.c -lm
+ *   ./scan_stats_storm
+ *
+ * Storms of scan requests from up to 20000 scanners are run through user_scan_stats.c:
+ * Zipf distributions mixed with a uniform share, and a set of regular scanners among
+ * many passers-by. The scanner addresses share their high bytes, which loads the index
+ * hash. Every 5000 requests the table is compared with the true counts.
+ *
+ * Checked: the entries stay sorted by count and the index points at them; every count
+ * is within its Space-Saving bound (count - error <= true count <= count); a scanner
+ * that is not tracked made no more requests than the floor, and every scanner above
+ * total / SCAN_STATS_CAPACITY is tracked; the regular scanners are all tracked; the
+ * request interval estimate. The time per request for 10 to 10000 distinct scanners is
+ * printed, it does not depend on their number.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "user_scan_stats.h"
+
+#define SCANNERS            (20000)
+#define CHECK_PERIOD        (5000)
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+static struct scan_stats stats;
+static uint32_t truth[SCANNERS];
+static uint8_t addrs[SCANNERS][SCAN_STATS_ADDR_LEN];
+static double zipf_cdf[SCANNERS];
+
+static uint64_t rng = 88172645463325252ULL;
+
+static uint32_t rand32(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (uint32_t)(rng >> 32);
+}
+
+static double rand_unit(void)
+{
+    return rand32() / 4294967296.0;
+}
+
+/// Compares the table with the true counts after total requests
+static void check_table(uint32_t total)
+{
+    uint32_t floor = scan_stats_floor(&stats);
+    int occupied = 0;
+
+    CHECK(stats.total == total);
+    for (int i = 1; i < stats.used; i++)
+    {
+        CHECK(stats.entries[i - 1].count >= stats.entries[i].count);
+    }
+    for (int s = 0; s < SCAN_STATS_INDEX_LEN; s++)
+    {
+        if (stats.index[s] != SCAN_STATS_INDEX_EMPTY)
+        {
+            occupied++;
+            CHECK(stats.entries[stats.index[s]].slot == s);
+        }
+    }
+    CHECK(occupied == stats.used);
+    CHECK(floor <= total / SCAN_STATS_CAPACITY);
+
+    for (int k = 0; k < SCANNERS; k++)
+    {
+        const struct scan_stats_entry *e;
+
+        if (truth[k] == 0)
+        {
+            continue;
+        }
+        e = scan_stats_find(&stats, addrs[k]);
+        if (e)
+        {
+            CHECK(e->count - e->error <= truth[k] && truth[k] <= e->count);
+        }
+        else
+        {
+            CHECK(truth[k] <= floor);
+        }
+    }
+}
+
+/// Requests from a Zipf distribution of exponent s, tail % of them uniform
+static void run_zipf(double s, unsigned tail, uint32_t requests)
+{
+    double z = 0;
+    uint32_t now = 0;
+    int exact = 0;
+
+    memset(truth, 0, sizeof(truth));
+    scan_stats_init(&stats);
+    for (int k = 0; k < SCANNERS; k++)
+    {
+        z += 1.0 / pow(k + 1, s);
+        zipf_cdf[k] = z;
+    }
+
+    for (uint32_t i = 1; i <= requests; i++)
+    {
+        int k;
+
+        if ((rand32() % 100) < tail)
+        {
+            k = rand32() % SCANNERS;
+        }
+        else
+        {
+            double u = rand_unit() * z;
+            int lo = 0, hi = SCANNERS - 1;
+
+            while (lo < hi)
+            {
+                int mid = (lo + hi) / 2;
+
+                if (zipf_cdf[mid] < u)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            k = lo;
+        }
+        truth[k]++;
+        now += rand32() % 20;
+        scan_stats_update(&stats, addrs[k], now);
+        if (i % CHECK_PERIOD == 0)
+        {
+            check_table(i);
+        }
+    }
+    check_table(requests);
+
+    for (int r = 0; r < 8; r++)
+    {
+        exact += (stats.entries[r].error == 0);
+    }
+    printf("zipf %.1f, %3u%% uniform: %u requests, floor %u, %u evictions, %d of the top 8 exact\n",
+           s, tail, requests, scan_stats_floor(&stats), stats.evictions, exact);
+}
+
+/// 8 regular scanners make 40 % of the requests, the others come from passers-by
+static void run_regulars(int passers)
+{
+    uint32_t requests = 100000;
+    double overcount = 0;
+
+    memset(truth, 0, sizeof(truth));
+    scan_stats_init(&stats);
+    for (uint32_t i = 1; i <= requests; i++)
+    {
+        int k = (rand32() % 100 < 40) ? (int)(rand32() % 8) : 8 + (int)(rand32() % passers);
+
+        truth[k]++;
+        scan_stats_update(&stats, addrs[k], i);
+    }
+    check_table(requests);
+
+    for (int k = 0; k < 8; k++)
+    {
+        const struct scan_stats_entry *e = scan_stats_find(&stats, addrs[k]);
+
+        CHECK(e != NULL);
+        if (e)
+        {
+            double r = (double)(e->count - truth[k]) / truth[k];
+
+            overcount = (r > overcount) ? r : overcount;
+        }
+    }
+    printf("%5d passers-by: regular scanners overcounted by %.2f%% at most\n", passers, overcount * 100);
+}
+
+static void run_cost(void)
+{
+    for (int distinct = 10; distinct <= 10000; distinct *= 10)
+    {
+        uint32_t requests = 2000000;
+        struct timespec start, end;
+
+        scan_stats_init(&stats);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint32_t i = 0; i < requests; i++)
+        {
+            scan_stats_update(&stats, addrs[rand32() % distinct], i);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        printf("%5d distinct scanners: %.1f ns per request\n", distinct,
+               ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / requests);
+    }
+}
+
+int main(void)
+{
+    const uint8_t addr[SCAN_STATS_ADDR_LEN] = {1, 2, 3, 4, 5, 6};
+    uint32_t last = 0;
+
+    // Only the two low bytes and the low bits of byte 4 differ
+    for (int k = 0; k < SCANNERS; k++)
+    {
+        addrs[k][0] = (uint8_t)k;
+        addrs[k][1] = (uint8_t)(k >> 8);
+        addrs[k][2] = 0x5A;
+        addrs[k][3] = 0xC3;
+        addrs[k][4] = (uint8_t)(k & 3);
+        addrs[k][5] = 0;
+    }
+
+    run_zipf(1.2, 0, 200000);
+    run_zipf(1.0, 30, 200000);
+    run_zipf(0.8, 60, 200000);
+    run_zipf(1.5, 90, 200000);
+    run_zipf(0.0, 100, 100000);
+
+    run_regulars(100);
+    run_regulars(500);
+    run_regulars(2000);
+
+    // A scanner every 155 or 135 ticks, 145 on average
+    scan_stats_init(&stats);
+    for (int i = 0; i < 50; i++)
+    {
+        last = 1000 + i * 145 + (i & 1) * 10;
+        scan_stats_update(&stats, addr, last);
+    }
+    printf("interval %u ticks\n", scan_stats_interval(&stats.entries[0], last));
+    CHECK(abs((int)scan_stats_interval(&stats.entries[0], last) - 145) <= 10);
+    // Silent for long, the estimate grows
+    CHECK(scan_stats_interval(&stats.entries[0], last + 20000) > 1000);
+
+    run_cost();
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
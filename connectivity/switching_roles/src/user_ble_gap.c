@@ -75,20 +75,7 @@ const char *format_bd_address(const struct bd_addr *addr){
 	return buf;
 }
 
-timer_hnd set_routine_timer(void){
-	//static uint8_t timerID = EASY_TIMER_INVALID_TIMER;
-
-	//if (timerID != EASY_TIMER_INVALID_TIMER) {
-	//	app_easy_timer_cancel(timerID);
-	//}
-	timer_hnd handle;
-	
-	handle = app_easy_timer(ROUTINE_CYCLE_TIME, app_easy_gap_advertise_stop);
-	
-	return handle;
-}
-
-ble_gap_error_t user_ble_gap_start_scan(bool scan_active, uint16_t interval_ms, uint16_t window_ms, bool filter_dupl){
+struct gapm_start_scan_cmd *user_ble_gap_prepare_scan(bool scan_active, uint16_t interval_ms, uint16_t window_ms, bool filter_dupl){
 	
 	uint16_t interval, window;
 	enum scan_dup_filter_policy filter_policy = filter_dupl ? SCAN_FILT_DUPLIC_EN:SCAN_FILT_DUPLIC_DIS; 
@@ -96,19 +83,19 @@ ble_gap_error_t user_ble_gap_start_scan(bool scan_active, uint16_t interval_ms,
 	
 	
 
-	//Window must be >= interval
-	if(window_ms < interval_ms)
+	//Window must be <= interval
+	if(window_ms > interval_ms)
 	{
-		return BLE_GAP_ERROR_INVALID_PARAMS;
+		return NULL;
 	}
 	
 	if(interval_ms < BLE_MIN_SCAN_INTVL_MS){
-		return BLE_GAP_ERROR_INVALID_PARAMS;
+		return NULL;
 	}
 	
 	if(interval_ms > BLE_MAX_SCAN_INTVL_MS)
 	{
-		return BLE_GAP_ERROR_INVALID_PARAMS;
+		return NULL;
 	}
 	
 	interval	= MS_TO_BLESLOTS(interval_ms);
@@ -145,8 +132,60 @@ ble_gap_error_t user_ble_gap_start_scan(bool scan_active, uint16_t interval_ms,
 	// - SCAN_FILT_DUPLIC_EN: Enable filtering of duplicate packets
 	cmd->filter_duplic = filter_policy;
 
+	return cmd;
+}
+
+ble_gap_error_t user_ble_gap_start_scan(bool scan_active, uint16_t interval_ms, uint16_t window_ms, bool filter_dupl){
+	struct gapm_start_scan_cmd *cmd = user_ble_gap_prepare_scan(scan_active, interval_ms, window_ms, filter_dupl);
+
+	if(cmd == NULL){
+		return BLE_GAP_ERROR_INVALID_PARAMS;
+	}
+
 	ke_msg_send(cmd);
 			
 	return BLE_GAP_ERROR_NO_ERROR;
 	
 }
+
+struct gapm_start_advertise_cmd *user_ble_gap_prepare_advertise(uint8_t op_code, uint16_t intv_min, uint16_t intv_max){
+	struct gapm_start_advertise_cmd *cmd;
+	uint8_t len;
+
+	if(op_code != GAPM_ADV_NON_CONN && op_code != GAPM_ADV_UNDIRECT){
+		return NULL;
+	}
+
+	cmd = KE_MSG_ALLOC(GAPM_START_ADVERTISE_CMD,
+										 TASK_GAPM,
+										 TASK_APP,
+										 gapm_start_advertise_cmd);
+
+	cmd->op.code = op_code;
+	cmd->op.addr_src = user_adv_conf.addr_src;
+	cmd->op.state = 0;
+	cmd->intv_min = intv_min;
+	cmd->intv_max = intv_max;
+	cmd->channel_map = user_adv_conf.channel_map;
+
+	// Non connectable advertising carries no flags, the full payload is available
+	cmd->info.host.mode = (op_code == GAPM_ADV_NON_CONN) ? GAP_BROADCASTER_MODE : user_adv_conf.mode;
+	cmd->info.host.adv_filt_policy = user_adv_conf.adv_filt_policy;
+
+	memcpy(cmd->info.host.adv_data, USER_ADVERTISE_DATA, USER_ADVERTISE_DATA_LEN);
+	len = USER_ADVERTISE_DATA_LEN;
+
+	// Append the device name if it fits, the flags take 3 bytes in discoverable modes
+	if((len + 2 + USER_DEVICE_NAME_LEN) <= (ADV_DATA_LEN - 3)){
+		cmd->info.host.adv_data[len++] = USER_DEVICE_NAME_LEN + 1;
+		cmd->info.host.adv_data[len++] = GAP_AD_TYPE_COMPLETE_NAME;
+		memcpy(&cmd->info.host.adv_data[len], USER_DEVICE_NAME, USER_DEVICE_NAME_LEN);
+		len += USER_DEVICE_NAME_LEN;
+	}
+	cmd->info.host.adv_data_len = len;
+
+	memcpy(cmd->info.host.scan_rsp_data, USER_ADVERTISE_SCAN_RESPONSE_DATA, USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN);
+	cmd->info.host.scan_rsp_data_len = USER_ADVERTISE_SCAN_RESPONSE_DATA_LEN;
+
+	return cmd;
+}
@@ -32,6 +32,7 @@
 #define _USER_BLE_GAP_H_
 
 #include "app_easy_timer.h"
+#include "gapm_task.h"
 
 /*
  * TYPE DEFINITIONS
@@ -67,7 +68,26 @@ typedef enum{
  */
 const char *format_local_name(const uint8_t *, const uint8_t);
 const char *format_bd_address(const struct bd_addr *);
-timer_hnd set_routine_timer(void);
 ble_gap_error_t user_ble_gap_start_scan(bool, uint16_t, uint16_t, bool);
 
+/**
+ ****************************************************************************************
+ * @brief Allocate and fill a GAPM_START_SCAN_CMD without sending it.
+ * @return The message, or NULL if the parameters are out of range
+ ****************************************************************************************
+ */
+struct gapm_start_scan_cmd *user_ble_gap_prepare_scan(bool, uint16_t, uint16_t, bool);
+
+/**
+ ****************************************************************************************
+ * @brief Allocate and fill a GAPM_START_ADVERTISE_CMD without sending it. The advertising
+ *        data is taken from user_config.h.
+ * @param[in] op_code   GAPM_ADV_NON_CONN or GAPM_ADV_UNDIRECT
+ * @param[in] intv_min  Minimum advertising interval in BLE slots
+ * @param[in] intv_max  Maximum advertising interval in BLE slots
+ * @return The message, or NULL if the operation is not supported
+ ****************************************************************************************
+ */
+struct gapm_start_advertise_cmd *user_ble_gap_prepare_advertise(uint8_t, uint16_t, uint16_t);
+
 #endif // _USER_BLE_GAP_H_
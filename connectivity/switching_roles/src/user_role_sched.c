@@ -0,0 +1,348 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_role_sched.c
+ *
+ * @brief Time-sliced BLE role scheduler source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+#include "rwip_config.h"             // SW configuration
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "app_api.h"
+#include "arch_console.h"
+#include "ea.h"
+#include "ke_msg.h"
+#include "user_ble_gap.h"
+#include "user_role_sched.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// BLE time wraps at 27 bits
+#define ROLE_SCHED_TIME_MASK		(uint32_t)(0x07FFFFFF)
+
+/// One app_easy_timer tick (10ms) in half slots
+#define ROLE_SCHED_HS_PER_TICK		(uint32_t)(32)
+
+#define ROLE_SCHED_MS_TO_HS(ms)		(uint32_t)(((ms) * 16) / 5)
+#define ROLE_SCHED_HS_TO_US(hs)		(uint32_t)(((hs) * 625) / 2)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+typedef enum{
+		ROLE_SCHED_STOPPED,
+		ROLE_SCHED_RUNNING,
+		ROLE_SCHED_SUSPENDED,
+}role_sched_state_t;
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+static const role_sched_role_t *sched_roles;
+static uint8_t sched_count;
+static role_sched_start_cb_t sched_start_cb;
+
+/// Timetable: role index and slot end offset from the cycle start, in execution order
+static uint8_t sched_order[ROLE_SCHED_MAX_ROLES];
+static uint32_t sched_slot_end[ROLE_SCHED_MAX_ROLES];
+static uint32_t sched_cycle_len;
+
+/// Pre-built GAPM start command of every role, NULL for the idle role
+static void *sched_cmd[ROLE_SCHED_MAX_ROLES];
+
+static role_sched_stats_t sched_stats[ROLE_SCHED_MAX_ROLES];
+static uint32_t sched_actual[ROLE_SCHED_MAX_ROLES];
+
+static role_sched_state_t sched_state = ROLE_SCHED_STOPPED;
+static uint8_t sched_slot;
+static uint32_t sched_cycle_start;
+static uint32_t sched_role_start;
+static uint32_t sched_stop_time;
+static bool sched_air_active;
+static bool sched_stop_requested;
+static timer_hnd sched_timer = EASY_TIMER_INVALID_TIMER;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+*/
+
+static uint32_t role_sched_now(void){
+	return ea_time_get_halfslot_rounded() & ROLE_SCHED_TIME_MASK;
+}
+
+static uint32_t role_sched_elapsed(uint32_t from, uint32_t to){
+	return (to - from) & ROLE_SCHED_TIME_MASK;
+}
+
+static void *role_sched_build_cmd(const role_sched_role_t *role){
+	switch(role->type){
+		case ROLE_SCHED_ADV_NONCONN:
+			return user_ble_gap_prepare_advertise(GAPM_ADV_NON_CONN, role->params.adv.intv_min, role->params.adv.intv_max);
+		case ROLE_SCHED_ADV_UNDIRECT:
+			return user_ble_gap_prepare_advertise(GAPM_ADV_UNDIRECT, role->params.adv.intv_min, role->params.adv.intv_max);
+		case ROLE_SCHED_SCAN:
+			return user_ble_gap_prepare_scan(role->params.scan.active, role->params.scan.interval_ms,
+																			 role->params.scan.window_ms, role->params.scan.filter_dupl);
+		default:
+			return NULL;
+	}
+}
+
+static void role_sched_timer_cb(void);
+
+static void role_sched_arm_timer(void){
+	uint32_t deadline = (sched_cycle_start + sched_slot_end[sched_slot]) & ROLE_SCHED_TIME_MASK;
+	uint32_t remaining = role_sched_elapsed(role_sched_now(), deadline);
+	uint32_t ticks;
+
+	// Deadline already passed
+	if(remaining > (ROLE_SCHED_TIME_MASK >> 1)){
+		remaining = 0;
+	}
+
+	ticks = (remaining + ROLE_SCHED_HS_PER_TICK - 1) / ROLE_SCHED_HS_PER_TICK;
+	sched_timer = app_easy_timer(ticks > 0 ? ticks : 1, role_sched_timer_cb);
+}
+
+static void role_sched_end_cycle(void){
+	uint8_t i;
+
+	for(i = 0; i < sched_count; i++){
+		sched_stats[i].actual = sched_actual[i];
+		sched_actual[i] = 0;
+#if defined(CFG_PRINTF)
+		arch_printf("Role %d: plan %d ms, actual %d ms, max switch %d us\n\r", i,
+								ROLE_SCHED_HS_TO_US(sched_stats[i].planned) / 1000,
+								ROLE_SCHED_HS_TO_US(sched_stats[i].actual) / 1000,
+								ROLE_SCHED_HS_TO_US(sched_stats[i].max_switch));
+#endif
+	}
+
+	sched_cycle_start = (sched_cycle_start + sched_cycle_len) & ROLE_SCHED_TIME_MASK;
+
+	// Resynchronize if the schedule fell behind by more than a cycle
+	if(role_sched_elapsed(sched_cycle_start, role_sched_now()) >= sched_cycle_len){
+		sched_cycle_start = role_sched_now();
+	}
+}
+
+static void role_sched_enter_slot(uint8_t slot){
+	uint8_t idx = sched_order[slot];
+	const role_sched_role_t *role = &sched_roles[idx];
+	uint32_t now = role_sched_now();
+
+	sched_slot = slot;
+
+	if(sched_cmd[idx] != NULL){
+		// Single send, the command was built during the previous cycle
+		ke_msg_send(sched_cmd[idx]);
+		sched_cmd[idx] = NULL;
+		sched_air_active = true;
+
+		if(role->type == ROLE_SCHED_ADV_UNDIRECT){
+			// The application task accepts connections only in this state
+			ke_state_set(TASK_APP, APP_CONNECTABLE);
+		}
+	}
+
+	if(sched_stop_requested){
+		uint32_t latency = role_sched_elapsed(sched_stop_time, now);
+
+		if(latency > sched_stats[idx].max_switch){
+			sched_stats[idx].max_switch = latency;
+		}
+		sched_stop_requested = false;
+	}
+
+	sched_role_start = now;
+
+	// Prepare the command for the next cycle while the air operation runs
+	if(role->type != ROLE_SCHED_IDLE){
+		sched_cmd[idx] = role_sched_build_cmd(role);
+	}
+
+	if(sched_start_cb != NULL){
+		sched_start_cb(role);
+	}
+
+	role_sched_arm_timer();
+}
+
+static void role_sched_advance(void){
+	uint8_t idx = sched_order[sched_slot];
+
+	sched_actual[idx] += role_sched_elapsed(sched_role_start, role_sched_now());
+
+	if(sched_slot + 1 >= sched_count){
+		role_sched_end_cycle();
+		role_sched_enter_slot(0);
+	}else{
+		role_sched_enter_slot(sched_slot + 1);
+	}
+}
+
+static void role_sched_timer_cb(void){
+	sched_timer = EASY_TIMER_INVALID_TIMER;
+
+	if(sched_state != ROLE_SCHED_RUNNING){
+		return;
+	}
+
+	if(sched_air_active){
+		// The completion event advances the schedule
+		sched_stop_requested = true;
+		sched_stop_time = role_sched_now();
+		app_easy_gap_advertise_stop();
+	}else{
+		role_sched_advance();
+	}
+}
+
+bool role_sched_init(const role_sched_role_t *roles, uint8_t count, role_sched_start_cb_t start_cb){
+	uint8_t i, j;
+	uint32_t offset = 0;
+
+	if(roles == NULL || count == 0 || count > ROLE_SCHED_MAX_ROLES){
+		return false;
+	}
+
+	sched_roles = roles;
+	sched_count = count;
+	sched_start_cb = start_cb;
+
+	// Stable insertion sort on descending priority
+	for(i = 0; i < count; i++){
+		for(j = i; j > 0 && roles[sched_order[j - 1]].priority < roles[i].priority; j--){
+			sched_order[j] = sched_order[j - 1];
+		}
+		sched_order[j] = i;
+	}
+
+	for(i = 0; i < count; i++){
+		const role_sched_role_t *role = &roles[sched_order[i]];
+
+		offset += ROLE_SCHED_MS_TO_HS(role->budget_ms);
+		sched_slot_end[i] = offset;
+
+		sched_stats[sched_order[i]].planned = ROLE_SCHED_MS_TO_HS(role->budget_ms);
+		sched_stats[sched_order[i]].actual = 0;
+		sched_stats[sched_order[i]].max_switch = 0;
+		sched_actual[sched_order[i]] = 0;
+
+		if(role->type != ROLE_SCHED_IDLE && sched_cmd[sched_order[i]] == NULL){
+			sched_cmd[sched_order[i]] = role_sched_build_cmd(role);
+			if(sched_cmd[sched_order[i]] == NULL){
+				return false;
+			}
+		}
+	}
+
+	sched_cycle_len = offset;
+
+	return (sched_cycle_len != 0);
+}
+
+void role_sched_start(void){
+	uint8_t i;
+
+	if(sched_count == 0 || sched_state == ROLE_SCHED_RUNNING){
+		return;
+	}
+
+	sched_state = ROLE_SCHED_RUNNING;
+	sched_air_active = false;
+	sched_stop_requested = false;
+	sched_cycle_start = role_sched_now();
+
+	for(i = 0; i < sched_count; i++){
+		sched_actual[i] = 0;
+	}
+
+	role_sched_enter_slot(0);
+}
+
+void role_sched_suspend(void){
+	if(sched_state != ROLE_SCHED_RUNNING){
+		return;
+	}
+
+	sched_state = ROLE_SCHED_SUSPENDED;
+
+	if(sched_timer != EASY_TIMER_INVALID_TIMER){
+		app_easy_timer_cancel(sched_timer);
+		sched_timer = EASY_TIMER_INVALID_TIMER;
+	}
+}
+
+void role_sched_on_air_complete(uint8_t status){
+	if(!sched_air_active){
+		return;
+	}
+
+	sched_air_active = false;
+
+	if(sched_state != ROLE_SCHED_RUNNING){
+		return;
+	}
+
+	if(sched_stop_requested){
+		role_sched_advance();
+	}
+#if defined(CFG_PRINTF)
+	else{
+		// Ended on its own (error or connection), the slot timer moves on
+		arch_printf("Role ended early: %02x\n\r", status);
+	}
+#endif
+}
+
+const role_sched_stats_t *role_sched_get_stats(uint8_t role_idx){
+	if(role_idx >= sched_count){
+		return NULL;
+	}
+
+	return &sched_stats[role_idx];
+}
+
+/// @} APP
@@ -0,0 +1,157 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_role_sched.h
+ *
+ * @brief Time-sliced BLE role scheduler header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_ROLE_SCHED_H_
+#define _USER_ROLE_SCHED_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @ingroup RICOW
+ *
+ * @brief Declarative role scheduler.
+ *
+ * The application describes every role with a duty budget, a priority and its air
+ * parameters. The scheduler orders the roles by priority into a cyclic timetable and
+ * keeps the GAPM start command of every role allocated and filled in advance, so a role
+ * switch is a single ke_msg_send() as soon as the previous air operation completes.
+ * Slot deadlines are computed from the cycle start, so switch latency does not add up
+ * over the cycle. The time actually spent per role is measured against the plan.
+ *
+ * @{
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+typedef enum{
+		ROLE_SCHED_ADV_NONCONN,		// Broadcaster, non connectable advertising
+		ROLE_SCHED_ADV_UNDIRECT,	// Peripheral, connectable undirected advertising
+		ROLE_SCHED_SCAN,			// Observer
+		ROLE_SCHED_IDLE,			// No role, the system may sleep
+}role_sched_type_t;
+
+typedef struct{
+	role_sched_type_t	type;
+	/// Higher priority roles run earlier in the cycle
+	uint8_t				priority;
+	/// Time the role gets in every cycle
+	uint32_t			budget_ms;
+	union{
+		struct{
+			/// Advertising interval in BLE slots (0.625ms)
+			uint16_t	intv_min;
+			uint16_t	intv_max;
+		}adv;
+		struct{
+			uint16_t	interval_ms;
+			uint16_t	window_ms;
+			bool		active;
+			bool		filter_dupl;
+		}scan;
+	}params;
+}role_sched_role_t;
+
+typedef struct{
+	/// Planned time per cycle in half slots (312.5us)
+	uint32_t	planned;
+	/// Time spent in the role during the last completed cycle in half slots
+	uint32_t	actual;
+	/// Longest switch into the role (stop request to next start) in half slots
+	uint32_t	max_switch;
+}role_sched_stats_t;
+
+/// Called when a role has been started
+typedef void (*role_sched_start_cb_t)(const role_sched_role_t *role);
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define ROLE_SCHED_MAX_ROLES		(uint8_t)(6)
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Build the timetable and pre-build the start commands of all roles.
+ * @param[in] roles     Role table, must stay valid while the scheduler runs
+ * @param[in] count     Number of roles, at most ROLE_SCHED_MAX_ROLES
+ * @param[in] start_cb  Called on every role start, may be NULL
+ * @return false if the table is invalid
+ ****************************************************************************************
+ */
+bool role_sched_init(const role_sched_role_t *roles, uint8_t count, role_sched_start_cb_t start_cb);
+
+/**
+ ****************************************************************************************
+ * @brief Start a new cycle with the highest priority role.
+ ****************************************************************************************
+ */
+void role_sched_start(void);
+
+/**
+ ****************************************************************************************
+ * @brief Stop switching roles, i.e. when a connection is established. The ongoing air
+ *        operation is not cancelled. role_sched_start() resumes the schedule.
+ ****************************************************************************************
+ */
+void role_sched_suspend(void);
+
+/**
+ ****************************************************************************************
+ * @brief Report the completion of an advertising or scanning operation.
+ * @param[in] status    Completion status of the GAPM operation
+ ****************************************************************************************
+ */
+void role_sched_on_air_complete(uint8_t status);
+
+/**
+ ****************************************************************************************
+ * @brief Get the planned versus measured time of a role.
+ * @param[in] role_idx  Index of the role in the role table
+ * @return Role statistics, NULL if the index is invalid
+ ****************************************************************************************
+ */
+const role_sched_stats_t *role_sched_get_stats(uint8_t role_idx);
+
+/// @} APP
+
+#endif // _USER_ROLE_SCHED_H_
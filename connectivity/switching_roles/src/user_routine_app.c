@@ -46,8 +46,10 @@
 #include "app_api.h"
 #include "arch_console.h"
 #include "user_ble_gap.h"
+#include "user_config.h"
 #include "user_routine_app.h"
 #include "user_routine_config.h"
+#include "user_role_sched.h"
 #include "gpio.h"
 #include "user_periph_setup.h"
 
@@ -64,6 +66,37 @@ static led_cb_params_t led_cb_params = {
 	.amountOfPulses = 0
 };
 
+/*Routine timetable, the roles run in order of descending priority. The advertising intervals are
+  copied from user_adv_conf by routine_roles_configure()*/
+static role_sched_role_t routine_roles[] = {
+	{
+		.type = ROLE_SCHED_ADV_NONCONN,
+		.priority = ROUTINE_NONCONN_PRIORITY,
+		.budget_ms = ROUTINE_CYCLE_TIME_MS,
+	},
+	{
+		.type = ROLE_SCHED_ADV_UNDIRECT,
+		.priority = ROUTINE_CONN_PRIORITY,
+		.budget_ms = ROUTINE_CYCLE_TIME_MS,
+	},
+	{
+		.type = ROLE_SCHED_SCAN,
+		.priority = ROUTINE_SCAN_PRIORITY,
+		.budget_ms = ROUTINE_CYCLE_TIME_MS,
+		.params.scan = {
+			.interval_ms = ROUTINE_SCAN_INTERVAL_MS,
+			.window_ms = ROUTINE_SCAN_WINDOW_MS,
+			.active = false,
+			.filter_dupl = true,
+		},
+	},
+	{
+		.type = ROLE_SCHED_IDLE,
+		.priority = ROUTINE_PAUSE_PRIORITY,
+		.budget_ms = ROUTINE_PAUSE_TIME_MS,
+	},
+};
+
 /*
  * FUNCTION PROTOTYPES
  ****************************************************************************************
@@ -82,38 +115,80 @@ void start_bluetooth_routine(void);
  ****************************************************************************************
 */
 
-void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind const *param){
-    default_app_on_connection(connection_idx, param);
-}
+static void routine_roles_configure(void){
+	uint8_t i;
 
-void user_on_disconnect( struct gapc_disconnect_ind const *param ){
-    default_app_on_disconnect(param);
+	for(i = 0; i < sizeof(routine_roles) / sizeof(routine_roles[0]); i++){
+		if(routine_roles[i].type == ROLE_SCHED_ADV_NONCONN || routine_roles[i].type == ROLE_SCHED_ADV_UNDIRECT){
+			routine_roles[i].params.adv.intv_min = user_adv_conf.intv_min;
+			routine_roles[i].params.adv.intv_max = user_adv_conf.intv_max;
+		}
+	}
 }
 
-void start_bluetooth_routine(void){
-	#if defined(CFG_PRINTF)
-	arch_puts("\n\rStart bluetooth routine\n\r");
-	arch_puts("Nonconnectable mode\n\r");
+static void routine_role_started(const role_sched_role_t *role){
+	switch(role->type){
+		case ROLE_SCHED_ADV_NONCONN:
+#if defined(CFG_PRINTF)
+			arch_puts("\n\rStart bluetooth routine\n\r");
+			arch_puts("Nonconnectable mode\n\r");
 #endif
-
 #if defined(CFG_ENABLE_LED)
-	led_cycle_start(LED_NONCONN_PULSES, LED_NONCONN_TIMER_TIME);
+			led_cycle_start(LED_NONCONN_PULSES, LED_NONCONN_TIMER_TIME);
 #endif
-	app_easy_gap_non_connectable_advertise_start();
-	set_routine_timer();
-}
-
-void user_on_adv_nonconn_complete(const uint8_t error){
+			break;
+		case ROLE_SCHED_ADV_UNDIRECT:
 #if defined(CFG_PRINTF)
-	arch_puts("Connectable mode\n\r");
+			arch_puts("Connectable mode\n\r");
+#endif
+#if defined(CFG_ENABLE_LED)
+			led_cycle_start(LED_CONN_PULSES, LED_CONN_TIMER_TIME);
+#endif
+			break;
+		case ROLE_SCHED_SCAN:
+#if defined(CFG_PRINTF)
+			arch_puts("Scanning mode\n\rFound Devices:\n\r");
 #endif
-	
-	
 #if defined(CFG_ENABLE_LED)
-	led_cycle_start(LED_CONN_PULSES, LED_CONN_TIMER_TIME);
+			led_cycle_start(LED_SCAN_PULSES, LED_SCAN_TIMER_TIME);
+#endif
+			break;
+		default:
+#if defined(CFG_PRINTF)
+			arch_puts("Pause...\n\r");
+#endif
+			break;
+	}
+}
+
+void start_bluetooth_routine(void){
+	static bool is_initialized = false;
+
+	if(!is_initialized){
+		routine_roles_configure();
+		is_initialized = role_sched_init(routine_roles, sizeof(routine_roles) / sizeof(routine_roles[0]), routine_role_started);
+		if(!is_initialized){
+#if defined(CFG_PRINTF)
+			arch_puts("Invalid routine timetable\n\r");
 #endif
-	app_easy_gap_undirected_advertise_start();
-	set_routine_timer();
+			return;
+		}
+	}
+
+	role_sched_start();
+}
+
+void user_on_connection(uint8_t connection_idx, struct gapc_connection_req_ind const *param){
+	role_sched_suspend();
+	default_app_on_connection(connection_idx, param);
+}
+
+void user_on_disconnect( struct gapc_disconnect_ind const *param ){
+	default_app_on_disconnect(param);
+}
+
+void user_on_adv_nonconn_complete(const uint8_t error){
+	role_sched_on_air_complete(error);
 }
 
 void user_advertise_operation(void){
@@ -121,29 +196,16 @@ void user_advertise_operation(void){
 }
 
 void user_on_adv_undirect_complete(const uint8_t error){
-#if defined(CFG_PRINTF)
-	arch_puts("Scanning mode\n\rFound Devices:\n\r");
-#endif
-	
-#if defined(CFG_ENABLE_LED)
-	led_cycle_start(LED_SCAN_PULSES, LED_SCAN_TIMER_TIME);
-#endif
-
-	user_ble_gap_start_scan(false, 50, 50, true); //TODO: remove these magic numbers
-	set_routine_timer();
+	role_sched_on_air_complete(error);
 }
 
 void user_on_scanning_completed(const uint8_t error){
-	if (error == GAP_ERR_CANCELED){
-#if defined(CFG_PRINTF)
-		arch_puts("Pause...\n\r");
-#endif 	
-		app_easy_timer(ROUTINE_PAUSE_TIME, start_bluetooth_routine);
-	}else{
+	if (error != GAP_ERR_CANCELED){
 #if defined(CFG_PRINTF)
 		arch_printf("Error code : %02x\n\r", error);
 #endif
 	}
+	role_sched_on_air_complete(error);
 }
 
 void user_on_adv_report_ind(struct gapm_adv_report_ind const * report){
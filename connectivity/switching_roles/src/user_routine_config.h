@@ -18,6 +18,20 @@
 #define ROUTINE_PAUSE_TIME_MS		(uint32_t)(5000)
 #define ROUTINE_PAUSE_TIME			(uint32_t)(ROUTINE_PAUSE_TIME_MS/10)
 
+/****************************************************************************************************************/
+/*Priority of each phase of the routine. The role scheduler runs the phases in order of descending priority	*/
+/****************************************************************************************************************/
+#define ROUTINE_NONCONN_PRIORITY	(uint8_t)(3)
+#define ROUTINE_CONN_PRIORITY		(uint8_t)(2)
+#define ROUTINE_SCAN_PRIORITY		(uint8_t)(1)
+#define ROUTINE_PAUSE_PRIORITY		(uint8_t)(0)
+
+/****************************************************************************************************************/
+/*Air parameters of the scanning phase in milliseconds, the advertising phases use the interval of user_adv_conf	*/
+/****************************************************************************************************************/
+#define ROUTINE_SCAN_INTERVAL_MS	(uint16_t)(50)
+#define ROUTINE_SCAN_WINDOW_MS		(uint16_t)(50)
+
 /****************************************************************************************************************/
 /*Settings for the time it take for one phase of the routine in milliseconds									*/
 /****************************************************************************************************************/
@@ -0,0 +1,258 @@
+/**
+ ****************************************************************************************
+ *
+ * @file role_sched_sim.c
+ *
+ * @brief Host simulation of the role scheduler.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs user_role_sched.c with the routine timetable of user_routine_config.h against a
+ * simulated BLE time base, easy timer and GAPM. Every stop request completes after a
+ * random delay, the way an advertising or scanning operation ends at the next air event.
+ *
+ *     gcc -O2 -I../../helpers/host_stub -Isrc -o role_sched_sim tools/role_sched_sim.c \
+ *         src/user_role_sched.c
+ *     ./role_sched_sim [cycles] [max stop latency in half slots] [seed]
+ *
+ * The time spent in every role is checked against its budget, the switch latency
+ * against the simulated stop latency, and only one air operation may run at a time.
+ * The exit status is non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "host_stub.h"
+#include "user_ble_gap.h"
+#include "user_role_sched.h"
+#include "user_routine_config.h"
+
+/// Stand-in for the interval of user_adv_conf, 687.5ms in BLE slots
+#define ADV_INTV                        (1100)
+
+/// BLE time wraps at 27 bits
+#define TIME_MASK                       (0x07FFFFFFUL)
+
+/// One easy timer tick in half slots
+#define HS_PER_TICK                     (32)
+
+#define MS_TO_HS(ms)                    (((uint64_t)(ms) * 16) / 5)
+
+#define NO_EVENT                        (UINT64_MAX)
+
+static role_sched_role_t roles[] = {
+    {
+        .type = ROLE_SCHED_ADV_NONCONN,
+        .priority = ROUTINE_NONCONN_PRIORITY,
+        .budget_ms = ROUTINE_CYCLE_TIME_MS,
+        .params.adv = { ADV_INTV, ADV_INTV },
+    },
+    {
+        .type = ROLE_SCHED_ADV_UNDIRECT,
+        .priority = ROUTINE_CONN_PRIORITY,
+        .budget_ms = ROUTINE_CYCLE_TIME_MS,
+        .params.adv = { ADV_INTV, ADV_INTV },
+    },
+    {
+        .type = ROLE_SCHED_SCAN,
+        .priority = ROUTINE_SCAN_PRIORITY,
+        .budget_ms = ROUTINE_CYCLE_TIME_MS,
+        .params.scan = { ROUTINE_SCAN_INTERVAL_MS, ROUTINE_SCAN_WINDOW_MS, false, true },
+    },
+    {
+        .type = ROLE_SCHED_IDLE,
+        .priority = ROUTINE_PAUSE_PRIORITY,
+        .budget_ms = ROUTINE_PAUSE_TIME_MS,
+    },
+};
+
+#define ROLES                           (sizeof(roles) / sizeof(roles[0]))
+
+/// Simulated time in half slots, the BLE time is its low 27 bits plus an offset
+static uint64_t now;
+static uint32_t time_offset;
+
+static uint64_t timer_due = NO_EVENT;
+static void (*timer_cb)(void);
+static timer_hnd timer_id;
+
+static uint64_t complete_due = NO_EVENT;
+static bool air_active;
+static uint32_t max_stop_latency;
+
+static const role_sched_role_t *current;
+static uint32_t starts[ROLES];
+static uint32_t outstanding;
+static uint32_t errors;
+
+static void fail(const char *what){
+    if(errors++ < 10){
+        printf("error at %llu: %s\n", (unsigned long long)now, what);
+    }
+}
+
+uint32_t ea_time_get_halfslot_rounded(void){
+    return (uint32_t)(now + time_offset) & TIME_MASK;
+}
+
+timer_hnd app_easy_timer(const uint32_t delay, void (*cb)(void)){
+    if(timer_due != NO_EVENT){
+        fail("second timer armed");
+    }
+    // Easy timer ticks are not aligned to the BLE time base
+    timer_due = now + (uint64_t)delay * HS_PER_TICK - (rand() % HS_PER_TICK);
+    timer_cb = cb;
+    timer_id = (timer_id % 0xFE) + 1;
+    return timer_id;
+}
+
+void app_easy_timer_cancel(const timer_hnd id){
+    if(id != timer_id || timer_due == NO_EVENT){
+        fail("cancel of an unknown timer");
+    }
+    timer_due = NO_EVENT;
+}
+
+void app_easy_gap_advertise_stop(void){
+    if(!air_active || complete_due != NO_EVENT){
+        fail("stop without an air operation");
+        return;
+    }
+    complete_due = now + 1 + (rand() % max_stop_latency);
+}
+
+void ke_state_set(ke_task_id_t id, ke_state_t state){
+    (void)id;
+    (void)state;
+}
+
+void ke_msg_send(void const *param_ptr){
+    if(air_active){
+        fail("air operation started while another one runs");
+    }
+    air_active = true;
+    free((void *)param_ptr);
+    outstanding--;
+}
+
+struct gapm_start_advertise_cmd *user_ble_gap_prepare_advertise(uint8_t code, uint16_t intv_min, uint16_t intv_max){
+    struct gapm_start_advertise_cmd *cmd = malloc(sizeof(*cmd));
+
+    if(intv_min != ADV_INTV || intv_max != ADV_INTV){
+        fail("advertising interval differs from the role");
+    }
+    cmd->op.code = code;
+    cmd->intv_min = intv_min;
+    cmd->intv_max = intv_max;
+    outstanding++;
+    return cmd;
+}
+
+struct gapm_start_scan_cmd *user_ble_gap_prepare_scan(bool active, uint16_t interval, uint16_t window, bool filter_dupl){
+    struct gapm_start_scan_cmd *cmd = malloc(sizeof(*cmd));
+
+    (void)filter_dupl;
+    cmd->op.code = active ? GAPM_SCAN_ACTIVE : GAPM_SCAN_PASSIVE;
+    cmd->interval = interval;
+    cmd->window = window;
+    outstanding++;
+    return cmd;
+}
+
+static void role_started(const role_sched_role_t *role){
+    if(role->type != ROLE_SCHED_IDLE && !air_active){
+        fail("role started without an air operation");
+    }
+    current = role;
+    starts[role - roles]++;
+}
+
+int main(int argc, char **argv){
+    uint32_t cycles = argc > 1 ? strtoul(argv[1], NULL, 0) : 200;
+    uint64_t cycle_len = 0, end;
+    uint32_t i;
+
+    max_stop_latency = argc > 2 ? strtoul(argv[2], NULL, 0) : 2 * ADV_INTV;
+    srand(argc > 3 ? strtoul(argv[3], NULL, 0) : 1);
+
+    // Start close to the wrap of the BLE time
+    time_offset = TIME_MASK - MS_TO_HS(ROUTINE_CYCLE_TIME_MS);
+
+    for(i = 0; i < ROLES; i++){
+        cycle_len += MS_TO_HS(roles[i].budget_ms);
+    }
+
+    if(!role_sched_init(roles, ROLES, role_started)){
+        printf("role_sched_init failed\n");
+        return 1;
+    }
+    role_sched_start();
+
+    end = cycles * cycle_len;
+    while(now < end){
+        if(timer_due != NO_EVENT && timer_due <= complete_due){
+            void (*cb)(void) = timer_cb;
+
+            now = timer_due;
+            timer_due = NO_EVENT;
+            cb();
+        }else if(complete_due != NO_EVENT){
+            now = complete_due;
+            complete_due = NO_EVENT;
+            air_active = false;
+            role_sched_on_air_complete(0);
+        }else{
+            fail("no pending event");
+            break;
+        }
+    }
+
+    for(i = 0; i < ROLES; i++){
+        const role_sched_stats_t *stats = role_sched_get_stats(i);
+        int32_t error = (int32_t)stats->actual - (int32_t)stats->planned;
+
+        printf("role%u_planned_hs=%u\nrole%u_actual_hs=%u\nrole%u_max_switch_hs=%u\nrole%u_starts=%u\n",
+               i, stats->planned, i, stats->actual, i, stats->max_switch, i, starts[i]);
+
+        // The slot boundary is late by the rounding to timer ticks and the stop latency
+        if(abs(error) > (int32_t)(2 * HS_PER_TICK + max_stop_latency)){
+            fail("time in role differs from the budget");
+        }
+        if(stats->max_switch > max_stop_latency){
+            fail("switch latency exceeds the stop latency");
+        }
+        if(starts[i] + 1 < cycles){
+            fail("role skipped");
+        }
+    }
+
+    if(outstanding != ROLES - 1){
+        fail("start commands leaked");
+    }
+
+    printf("cycles=%u\nerrors=%u\n", cycles, errors);
+    printf("%s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -58,11 +58,18 @@
 *****************************************************************************************/
 #define ENABLE_PULSE_MEASURING          (0)                  
 
+/*****************************************************************************************
+* Free running capture of the rising and falling edges of the signal into a timestamp ring
+* buffer. Period and duty statistics are kept per edge, the application is woken up when
+* CAPTURE_BATCH_EDGES edges are buffered or a period leaves the CAPTURE_PERIOD_MIN/MAX window.
+*****************************************************************************************/
+#define ENABLE_CAPTURE_STREAM           (0)
+
 /*
  * SW EXAMPLE TIMER 1 SETTINGS
  ****************************************************************************************
  */
-#if ( ENABLE_FREQ_COUNTING + ENABLE_PULSE_MEASURING + ENABLE_TMR_COUNTING ) > 1
+#if ( ENABLE_FREQ_COUNTING + ENABLE_PULSE_MEASURING + ENABLE_TMR_COUNTING + ENABLE_CAPTURE_STREAM ) > 1
 #error "Select only 1 timer configuration for running the demo"
 #endif
 
@@ -131,6 +138,16 @@
     #define INTERRUPT_MASK_EVT      TIM1_EVENT_IRQ_MASK_OFF
     #define EVENT_TYPE              TIM1_EVENT_TYPE_CAP
     #define EDGE_TYPE               TIM1_EVENT_EDGE_FALLING
+#elif ENABLE_CAPTURE_STREAM
+    #define INPUT_CLK               TIMER1_ON_LPCLK
+    #define PERIOD_COUNT            TIM1_PERIOD_MAX
+    #define INTERRUPT_MASK_TMR      TIM1_IRQ_MASK_ON
+    #define INTERRUPT_MASK_EVT      TIM1_EVENT_IRQ_MASK_OFF
+    #define EVENT_TYPE              TIM1_EVENT_TYPE_CAP
+    #define EDGE_TYPE               TIM1_EVENT_EDGE_FALLING
+    #define CAPTURE_BATCH_EDGES     32
+    #define CAPTURE_PERIOD_MIN      10                  // In timer ticks
+    #define CAPTURE_PERIOD_MAX      30000               // In timer ticks, ~2 sec with the LP clock
 #else
     #define INPUT_CLK               TIMER1_ON_LPCLK
     #define INTERRUPT_MASK_TMR      TIM1_IRQ_MASK_OFF
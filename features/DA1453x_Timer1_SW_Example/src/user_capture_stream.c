@@ -0,0 +1,177 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_capture_stream.c
+ *
+ * @brief Timer1 edge capture ring buffer and statistics source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "user_capture_stream.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+*/
+
+/**
+ ****************************************************************************************
+ * @brief Histogram bin of a period change, the bit length of the difference.
+ ****************************************************************************************
+ */
+static uint8_t capture_jitter_bin(uint32_t diff)
+{
+    uint8_t bin = 0;
+
+    while (diff != 0 && bin < CAPTURE_JITTER_BINS - 1)
+    {
+        diff >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+static void capture_stats_reset(capture_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->period_min = UINT32_MAX;
+}
+
+void capture_stream_init(capture_stream_t *cs, uint16_t batch, uint32_t period_lo, uint32_t period_hi)
+{
+    cs->head = 0;
+    cs->tail = 0;
+    capture_stats_reset(&cs->stats);
+    cs->have_rise = false;
+    cs->have_period = false;
+    cs->high_open = false;
+    cs->batch = (batch < CAPTURE_RING_SIZE) ? batch : CAPTURE_RING_SIZE - 1;
+    cs->period_lo = period_lo;
+    cs->period_hi = period_hi;
+}
+
+uint8_t capture_stream_edge(capture_stream_t *cs, uint8_t channel, uint32_t ts)
+{
+    uint16_t head = cs->head;
+    uint16_t next = (head + 1) & (CAPTURE_RING_SIZE - 1);
+    uint8_t wake = 0;
+
+    if (next == cs->tail)
+    {
+        cs->stats.overruns++;
+    }
+    else
+    {
+        cs->ring_ts[head] = ts;
+        cs->ring_ch[head] = channel;
+        cs->head = next;
+
+        if (((next - cs->tail) & (CAPTURE_RING_SIZE - 1)) == cs->batch)
+        {
+            wake |= CAPTURE_WAKE_BATCH;
+        }
+    }
+
+    if (channel == CAPTURE_CH_RISING)
+    {
+        if (cs->have_rise)
+        {
+            // Unsigned subtraction handles the wraparound of the extended timestamp
+            uint32_t period = ts - cs->last_rise;
+
+            cs->stats.periods++;
+            cs->stats.period_sum += period;
+            if (period < cs->stats.period_min)
+            {
+                cs->stats.period_min = period;
+            }
+            if (period > cs->stats.period_max)
+            {
+                cs->stats.period_max = period;
+            }
+
+            if (cs->have_period)
+            {
+                uint32_t diff = (period > cs->last_period) ? period - cs->last_period : cs->last_period - period;
+                cs->stats.jitter[capture_jitter_bin(diff)]++;
+            }
+
+            if (period < cs->period_lo || period > cs->period_hi)
+            {
+                wake |= CAPTURE_WAKE_THRESHOLD;
+            }
+
+            cs->last_period = period;
+            cs->have_period = true;
+        }
+        cs->last_rise = ts;
+        cs->have_rise = true;
+        cs->high_open = true;
+    }
+    else if (cs->high_open)
+    {
+        cs->stats.highs++;
+        cs->stats.high_sum += ts - cs->last_rise;
+        cs->high_open = false;
+    }
+
+    return wake;
+}
+
+bool capture_stream_pop(capture_stream_t *cs, uint8_t *channel, uint32_t *ts)
+{
+    uint16_t tail = cs->tail;
+
+    if (tail == cs->head)
+    {
+        return false;
+    }
+
+    *ts = cs->ring_ts[tail];
+    *channel = cs->ring_ch[tail];
+    cs->tail = (tail + 1) & (CAPTURE_RING_SIZE - 1);
+
+    return true;
+}
+
+void capture_stream_stats_take(capture_stream_t *cs, capture_stats_t *stats)
+{
+    *stats = cs->stats;
+    capture_stats_reset(&cs->stats);
+}
+
+/// @} APP
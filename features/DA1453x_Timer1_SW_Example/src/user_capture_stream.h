@@ -0,0 +1,200 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_capture_stream.h
+ *
+ * @brief Timer1 edge capture ring buffer and statistics header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_CAPTURE_STREAM_H_
+#define _USER_CAPTURE_STREAM_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @ingroup RICOW
+ *
+ * @brief Free running edge capture.
+ *
+ * The edge timestamps of both capture channels are extended with the number of timer
+ * reloads to 32 bits and stored in a ring buffer. Every edge also updates the period and
+ * high time statistics with additions and compares only, the divisions needed for the
+ * mean and duty values are left to the reader of the statistics. The module has no
+ * hardware dependencies, the timer interrupt callbacks feed it with raw capture values.
+ *
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Width of the Timer1 counter
+#define CAPTURE_COUNTER_BITS            (11)
+#define CAPTURE_COUNTER_MASK            ((1UL << CAPTURE_COUNTER_BITS) - 1)
+
+/// Number of timestamps in the ring buffer, must be a power of 2
+#define CAPTURE_RING_SIZE               (64)
+
+/// Number of jitter histogram bins. Bin 0 counts unchanged periods, bin n period changes
+/// of [2^(n-1), 2^n) ticks, the last bin all larger changes
+#define CAPTURE_JITTER_BINS             (8)
+
+/// Capture channels
+#define CAPTURE_CH_FALLING              (0)
+#define CAPTURE_CH_RISING               (1)
+
+/// Reasons to wake up the application, returned by capture_stream_edge()
+#define CAPTURE_WAKE_BATCH              (0x01)  // The ring buffer holds a full batch
+#define CAPTURE_WAKE_THRESHOLD          (0x02)  // A period outside the configured window
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Statistics of the edges since the last capture_stream_stats_take()
+typedef struct
+{
+    /// Number of periods (rising to rising edge)
+    uint32_t periods;
+    uint32_t period_min;
+    uint32_t period_max;
+    uint64_t period_sum;
+    /// Number of high times (rising to falling edge)
+    uint32_t highs;
+    uint64_t high_sum;
+    /// Histogram of the absolute difference between consecutive periods
+    uint32_t jitter[CAPTURE_JITTER_BINS];
+    /// Edges lost because the ring buffer was full
+    uint32_t overruns;
+} capture_stats_t;
+
+/// Capture stream state
+typedef struct
+{
+    /// Edge timestamps in timer ticks and their channels
+    uint32_t ring_ts[CAPTURE_RING_SIZE];
+    uint8_t ring_ch[CAPTURE_RING_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+
+    capture_stats_t stats;
+
+    uint32_t last_rise;
+    uint32_t last_period;
+    bool have_rise;
+    bool have_period;
+    /// A rising edge waits for its falling edge
+    bool high_open;
+
+    /// Wake-up configuration
+    uint16_t batch;
+    uint32_t period_lo;
+    uint32_t period_hi;
+} capture_stream_t;
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Extend a capture value to a 32-bit timestamp.
+ * @param[in] reloads   Timer reloads counted up to the moment now was read
+ * @param[in] cap       Captured counter value
+ * @param[in] now       Counter value read after the capture
+ * @return Timestamp in timer ticks
+ * @note The capture must be less than one timer period old.
+ ****************************************************************************************
+ */
+static inline uint32_t capture_stream_extend(uint32_t reloads, uint16_t cap, uint16_t now)
+{
+    // The counter wrapped between the capture and now, the capture belongs to the reload before
+    if (cap > now)
+    {
+        reloads--;
+    }
+    return (reloads << CAPTURE_COUNTER_BITS) | (cap & CAPTURE_COUNTER_MASK);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Reset the capture stream.
+ * @param[in] cs        Capture stream
+ * @param[in] batch     Buffered edges that wake up the application, at most CAPTURE_RING_SIZE - 1
+ * @param[in] period_lo Shortest period in ticks that does not wake up the application
+ * @param[in] period_hi Longest period in ticks that does not wake up the application
+ * @return void
+ ****************************************************************************************
+ */
+void capture_stream_init(capture_stream_t *cs, uint16_t batch, uint32_t period_lo, uint32_t period_hi);
+
+/**
+ ****************************************************************************************
+ * @brief Record an edge. Called from the capture interrupt.
+ * @param[in] cs        Capture stream
+ * @param[in] channel   CAPTURE_CH_FALLING or CAPTURE_CH_RISING
+ * @param[in] ts        Edge timestamp from capture_stream_extend()
+ * @return CAPTURE_WAKE_ flags, 0 if the application does not need to run
+ ****************************************************************************************
+ */
+uint8_t capture_stream_edge(capture_stream_t *cs, uint8_t channel, uint32_t ts);
+
+/**
+ ****************************************************************************************
+ * @brief Take the oldest buffered edge.
+ * @param[in] cs        Capture stream
+ * @param[out] channel  Channel of the edge
+ * @param[out] ts       Timestamp of the edge
+ * @return false if the ring buffer is empty
+ ****************************************************************************************
+ */
+bool capture_stream_pop(capture_stream_t *cs, uint8_t *channel, uint32_t *ts);
+
+/**
+ ****************************************************************************************
+ * @brief Copy and reset the statistics. Must not be interrupted by capture_stream_edge().
+ * @param[in] cs        Capture stream
+ * @param[out] stats    Statistics since the previous call
+ * @return void
+ ****************************************************************************************
+ */
+void capture_stream_stats_take(capture_stream_t *cs, capture_stats_t *stats);
+
+/// @} APP
+
+#endif // _USER_CAPTURE_STREAM_H_
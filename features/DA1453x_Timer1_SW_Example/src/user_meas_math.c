@@ -0,0 +1,65 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_meas_math.c
+ *
+ * @brief Divide-free measurement unit conversion source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "user_meas_math.h"
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+*/
+
+void meas_recip_init(meas_recip_t *recip, uint32_t scale, uint32_t ref_hz)
+{
+    uint32_t rem = scale % ref_hz;
+
+    recip->ref_hz = ref_hz;
+    recip->scale = scale;
+    recip->whole = scale / ref_hz;
+
+    /*
+     * Rounding up keeps the error of cycles * frac / 2^32 in [0, 1) for any 32-bit cycles
+     * value. rem < ref_hz, so the fraction never reaches 2^32.
+     */
+    recip->frac = (uint32_t)((((uint64_t)rem << 32) + ref_hz - 1) / ref_hz);
+}
+
+/// @} APP
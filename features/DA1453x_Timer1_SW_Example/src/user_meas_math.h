@@ -0,0 +1,142 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_meas_math.h
+ *
+ * @brief Divide-free measurement unit conversion header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_MEAS_MATH_H_
+#define _USER_MEAS_MATH_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @ingroup RICOW
+ *
+ * @brief Reciprocal based conversion of clock cycles to time units.
+ *
+ * Converting cycles of a reference clock to i.e. microseconds is cycles * scale / ref_hz.
+ * The Cortex-M0+ has no hardware divider, so the reciprocal of the reference clock is
+ * computed once per calibration and split into the integer part scale / ref_hz and a
+ * 32-bit fraction rounded up. Every conversion is then one 32-bit and one 32x32->64-bit
+ * multiplication and a shift.
+ *
+ * For every cycles value the result is either the floor or the ceiling of the exact value,
+ * i.e. the error is below one output unit, provided the exact value fits in 32 bits.
+ * meas_recip_apply_floor() corrects the ceiling down with two more multiplications and
+ * returns the exact value rounded down, as a division does.
+ *
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Scale for conversions to microseconds
+#define MEAS_SCALE_US                   (1000000UL)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Reciprocal of a reference clock
+typedef struct
+{
+    /// Reference clock the reciprocal was computed for, 0 if not computed yet
+    uint32_t ref_hz;
+    /// Output units per second
+    uint32_t scale;
+    /// scale / ref_hz
+    uint32_t whole;
+    /// (scale % ref_hz) / ref_hz in 0.32 fixed point, rounded up
+    uint32_t frac;
+} meas_recip_t;
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Compute the reciprocal of a reference clock. Divides, call it only when the
+ *        reference clock changes, i.e. after a calibration.
+ * @param[out] recip    Reciprocal
+ * @param[in] scale     Output units per second, i.e. MEAS_SCALE_US
+ * @param[in] ref_hz    Reference clock frequency in Hz, not 0
+ * @return void
+ ****************************************************************************************
+ */
+void meas_recip_init(meas_recip_t *recip, uint32_t scale, uint32_t ref_hz);
+
+/**
+ ****************************************************************************************
+ * @brief Convert reference clock cycles to output units.
+ * @param[in] recip     Reciprocal from meas_recip_init()
+ * @param[in] cycles    Number of reference clock cycles
+ * @return cycles * scale / ref_hz, rounded down or up
+ ****************************************************************************************
+ */
+static inline uint32_t meas_recip_apply(meas_recip_t const *recip, uint32_t cycles)
+{
+    return cycles * recip->whole + (uint32_t)(((uint64_t)cycles * recip->frac) >> 32);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Convert reference clock cycles to output units, rounded down.
+ * @param[in] recip     Reciprocal from meas_recip_init()
+ * @param[in] cycles    Number of reference clock cycles
+ * @return cycles * scale / ref_hz, rounded down
+ ****************************************************************************************
+ */
+static inline uint32_t meas_recip_apply_floor(meas_recip_t const *recip, uint32_t cycles)
+{
+    uint32_t value = meas_recip_apply(recip, cycles);
+
+    // The ceiling of a value that is not exact is above cycles * scale / ref_hz
+    if ((uint64_t)value * recip->ref_hz > (uint64_t)cycles * recip->scale)
+    {
+        value--;
+    }
+
+    return value;
+}
+
+/// @} APP
+
+#endif // _USER_MEAS_MATH_H_
@@ -51,6 +51,14 @@
 #include "arch_console.h"
 #include "demo_config.h"
 
+#if (ENABLE_CAPTURE_STREAM)
+#include "user_capture_stream.h"
+#endif
+
+#if (ENABLE_PULSE_MEASURING || ENABLE_CAPTURE_STREAM)
+#include "user_meas_math.h"
+#endif
+
 #if ( ENABLE_FREQ_COUNTING && PWM_TIMER0_ENABLE )
 #include "timer0_2.h"
 #include "timer0.h"
@@ -80,7 +88,7 @@ static timer1_count_options_t timer1_config =
 	.reload_val	= 	RELOAD_VALUE
 };
 
-#if ( ENABLE_PULSE_MEASURING || ENABLE_FREQ_COUNTING)
+#if ( ENABLE_PULSE_MEASURING || ENABLE_FREQ_COUNTING || ENABLE_CAPTURE_STREAM )
 //Timer1 capture / period count configuration structure
 static timer1_event_options_t timer1_event_config_ch1 = 
 {	
@@ -104,7 +112,7 @@ static timer1_event_options_t timer1_event_config_ch1 =
 };
 #endif
 
-#if ENABLE_PULSE_MEASURING
+#if ( ENABLE_PULSE_MEASURING || ENABLE_CAPTURE_STREAM )
 static timer1_event_options_t timer1_event_config_ch2 = 
 {
     /*Timestamp type to be stored upon each event*/
@@ -158,6 +166,16 @@ enum pulse_meas_sm_state idle_state             __SECTION_ZERO("retention_mem_ar
 bool first_measurement                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 #endif
 
+#if (ENABLE_PULSE_MEASURING || ENABLE_CAPTURE_STREAM)
+static meas_recip_t cycles_to_us                __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+#endif
+
+#if (ENABLE_CAPTURE_STREAM)
+static capture_stream_t capture_stream          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static uint32_t capture_reloads                 __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+static bool capture_wakeup_pending              __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
+#endif
+
 #if (ENABLE_TMR_COUNTING)
 uint8_t timer1_cnt_ovf                          __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
 bool led_state                                  __SECTION_ZERO("retention_mem_area0"); //@RETENTION MEMORY
@@ -172,10 +190,30 @@ extern rcx_time_data_t rcx_time_data;
 static void perform_freq_measurement(void);
 #endif
 
-#if (ENABLE_PULSE_MEASURING || ENABLE_TMR_COUNTING )
+#if (ENABLE_PULSE_MEASURING || ENABLE_TMR_COUNTING || ENABLE_CAPTURE_STREAM )
 static void timer1_overflow(void);
 #endif
 
+#if (ENABLE_PULSE_MEASURING || ENABLE_CAPTURE_STREAM)
+/**
+ ****************************************************************************************
+ * @brief Convert timer 1 cycles to microseconds
+ * @param[in] cycles Number of timer 1 cycles
+ * @return the time in us
+ ****************************************************************************************
+ */
+static uint32_t timer1_cycles_to_us(uint32_t cycles)
+{
+    uint32_t clk_hz = (timer1_config.input_clk == TIM1_CLK_SRC_SYS) ? 16000000UL : rcx_time_data.rcx_freq;
+    
+    // The reciprocal is recomputed only after a new RCX calibration
+    if (cycles_to_us.ref_hz != clk_hz)
+        meas_recip_init(&cycles_to_us, MEAS_SCALE_US, clk_hz);
+    
+    return meas_recip_apply_floor(&cycles_to_us, cycles);
+}
+#endif
+
 #if (PWM_TIMER0_ENABLE && ENABLE_FREQ_COUNTING)
 /**
  ****************************************************************************************
@@ -236,6 +274,10 @@ void user_app_init(void)
 #if (ENABLE_PULSE_MEASURING)
     initialize_pulse_length_measure();
 #endif
+
+#if (ENABLE_CAPTURE_STREAM)
+    initialize_capture_stream();
+#endif
 }
 
 void user_app_adv_start(void)
@@ -252,7 +294,7 @@ void timer1_initialize(void)
 {
     /*Enable PD_TIM power domain*/
 	SetBits16(PMU_CTRL_REG, TIM_SLEEP, 0);                  // Enable the PD_TIM
-#if (ENABLE_PULSE_MEASURING | ENABLE_TMR_COUNTING)
+#if (ENABLE_PULSE_MEASURING | ENABLE_TMR_COUNTING | ENABLE_CAPTURE_STREAM)
     timer1_count_config(&timer1_config, timer1_overflow);   // Set the capture counting configurations for the timer
 #elif (ENABLE_FREQ_COUNTING)
     timer1_count_config(&timer1_config, NULL);              // Set the frequency counting configurations for the timer
@@ -440,16 +482,11 @@ static void report_measurement_result(void)
 {
     TOGGLE_CURSOR(REPORT_TIME)
     
-    uint64_t time;
-    
-    if(timer1_config.input_clk == TIM1_CLK_SRC_SYS)
-        time = ((uint64_t)event_in_cycles * 625)/10000;
-    else if (timer1_config.input_clk == TIM1_CLK_SRC_LP)
-        time = ((uint64_t)event_in_cycles * 1000000)/rcx_time_data.rcx_freq;
+    uint32_t time = timer1_cycles_to_us(event_in_cycles);
     
 #ifdef CFG_PRINTF
     arch_printf("Pin asserted for %d cycles \n\r", event_in_cycles);
-    arch_printf("Time in asserted state %d us \n\r", (uint32_t)time);
+    arch_printf("Time in asserted state %d us \n\r", time);
 #endif //CFG_PRINTF
     
     // Set the message to be send when the measurement ends
@@ -568,4 +605,135 @@ static void pulse_measure_sm(enum pulse_meas_sm_events event)
 
 #endif
 
+#if (ENABLE_CAPTURE_STREAM)
+
+/**
+ ****************************************************************************************
+ * @brief Timer 1 overflow callback, extends the 11-bit capture values
+ ****************************************************************************************
+*/
+static void timer1_overflow(void)
+{
+    TOGGLE_CURSOR(TIMER_OVFL)
+    capture_reloads++;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Executes as soon as the device is awake and a batch of edges is ready
+ ****************************************************************************************
+*/
+static void capture_stream_report(void)
+{
+    TOGGLE_CURSOR(REPORT_TIME)
+    
+    capture_stats_t stats;
+    uint32_t edges = 0;
+    uint32_t ts;
+    uint8_t channel;
+    
+    GLOBAL_INT_DISABLE();
+    capture_stream_stats_take(&capture_stream, &stats);
+    capture_wakeup_pending = false;
+    GLOBAL_INT_RESTORE();
+    
+    // Drain the timestamps, this is where they would be forwarded to the application
+    while (capture_stream_pop(&capture_stream, &channel, &ts))
+    {
+        edges++;
+    }
+    
+#ifdef CFG_PRINTF
+    arch_printf("Edges %d, periods %d, overruns %d \n\r", edges, stats.periods, stats.overruns);
+    if (stats.periods != 0)
+    {
+        uint32_t mean = (uint32_t)(stats.period_sum / stats.periods);
+        uint8_t i;
+        
+        arch_printf("Period min %d us, max %d us, mean %d us \n\r", timer1_cycles_to_us(stats.period_min),
+                    timer1_cycles_to_us(stats.period_max), timer1_cycles_to_us(mean));
+        arch_printf("Duty cycle %d permille \n\r", (uint32_t)((stats.high_sum * 1000) / stats.period_sum));
+        arch_printf("Jitter histogram:");
+        for (i = 0; i < CAPTURE_JITTER_BINS; i++)
+        {
+            arch_printf(" %d", stats.jitter[i]);
+        }
+        arch_printf("\n\r");
+    }
+#endif //CFG_PRINTF
+    
+    // Set the message to be send on the next batch
+    app_easy_wakeup_set(capture_stream_report);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Records an edge and wakes up the application if needed
+ * @param[in] channel CAPTURE_CH_FALLING or CAPTURE_CH_RISING
+ * @param[in] cap     Captured timer value
+ ****************************************************************************************
+*/
+static void capture_stream_edge_cb(uint8_t channel, uint16_t cap)
+{
+    /*
+     * The overflow interrupt is served first in the ISR, so the reloads up to the entry
+     * of the ISR are counted. With the LP clock the ISR runs well within one timer tick.
+     */
+    uint32_t ts = capture_stream_extend(capture_reloads, cap, user_current_timer1_value());
+    
+    if (capture_stream_edge(&capture_stream, channel, ts) && !capture_wakeup_pending)
+    {
+        capture_wakeup_pending = true;
+        /* Wake up the device to report the batch */
+        arch_ble_force_wakeup();    // Force the BLE to wake up
+        app_easy_wakeup();          // Send the message to report
+    }
+}
+
+/**
+ ****************************************************************************************
+ * @brief Event 1 callback, falling edge
+ ****************************************************************************************
+*/
+static void timer1_capture_falling_cb(void)
+{
+    TOGGLE_CURSOR(FALLING_EDGE)
+    capture_stream_edge_cb(CAPTURE_CH_FALLING, timer1_get_event_ch1_capture_value());
+}
+
+/**
+ ****************************************************************************************
+ * @brief Event 2 callback, rising edge
+ ****************************************************************************************
+*/
+static void timer1_capture_rising_cb(void)
+{
+    TOGGLE_CURSOR(RISING_EDGE)
+    capture_stream_edge_cb(CAPTURE_CH_RISING, timer1_get_event_ch2_capture_value());
+}
+
+void initialize_capture_stream(void)
+{
+    capture_stream_init(&capture_stream, CAPTURE_BATCH_EDGES, CAPTURE_PERIOD_MIN, CAPTURE_PERIOD_MAX);
+    capture_reloads = 0;
+    capture_wakeup_pending = false;
+    // Set the message to be send when a batch is ready
+    app_easy_wakeup_set(capture_stream_report);
+    // Start the timer before setting the events
+    timer1_start();
+    // Both channels capture continuously, they are never re-armed
+    timer1_event1_config(&timer1_event_config_ch1, timer1_capture_falling_cb);
+    timer1_event2_config(&timer1_event_config_ch2, timer1_capture_rising_cb);
+    // Clear any pending interrupts in timer 
+    timer1_clear_all_events();
+    // Clear any pending interrupt in the NVIC
+    NVIC_ClearPendingIRQ(SWTIM1_IRQn);
+    // The overflow interrupt extends the timestamps
+    timer1_enable_overflow_intr(true);
+    // enable SWTIM_IRQn irq
+    timer1_enable_irq();
+}
+
+#endif // ENABLE_CAPTURE_STREAM
+
 /// @} APP
@@ -234,6 +234,17 @@ void timer1_initialize(void);
 void initialize_pulse_length_measure(void);
 #endif
 
+/**
+ ****************************************************************************************
+ * @brief Initializes the free running edge capture
+ * @details It starts the timer 1 and sets both channels to capture every falling and
+ *          rising edge into the timestamp ring buffer.
+ ****************************************************************************************
+*/
+#if (ENABLE_CAPTURE_STREAM)
+void initialize_capture_stream(void);
+#endif
+
 /**
  ****************************************************************************************
  * @brief Initializes the frequency counting functionality
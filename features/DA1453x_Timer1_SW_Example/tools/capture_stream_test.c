@@ -0,0 +1,202 @@
+/**
+ ****************************************************************************************
+ *
+ * @file capture_stream_test.c
+ *
+ * @brief Host test of the Timer1 capture stream.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Feeds user_capture_stream.c with a synthetic PWM signal the way the capture interrupt
+ * does: every edge is captured by the 11-bit counter and extended with the reload count
+ * read some interrupt latency later.
+ *
+ *     gcc -O2 -Isrc -o capture_stream_test tools/capture_stream_test.c src/user_capture_stream.c
+ *     ./capture_stream_test [periods]
+ *
+ * The period is 3000 ticks with a few ticks of jitter, the duty cycle 30% and one period
+ * is stretched to 4000 ticks. The extended timestamps, the statistics, the threshold
+ * wake-ups, the order of the buffered edges and the overrun count are checked against
+ * the generated signal, then the time per edge is measured. The exit status is non-zero
+ * if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "user_capture_stream.h"
+
+#define PERIOD                          (3000)
+#define PERIOD_LO                       (2900)
+#define PERIOD_HI                       (3100)
+#define OUTLIER                         (4000)
+#define BATCH                           (32)
+
+static capture_stream_t cs;
+static uint32_t errors;
+
+static void fail(uint32_t i, const char *what)
+{
+    if (errors++ < 10)
+    {
+        printf("error at period %u: %s\n", i, what);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t count = (argc > 1) ? strtoul(argv[1], NULL, 0) : 100000;
+    // Start shortly before the 32-bit timestamp wraps
+    uint64_t t = 0xFFFFFFFFULL - 100 * PERIOD;
+    uint32_t exp_min = UINT32_MAX, exp_max = 0, exp_wakes = 0, wakes = 0;
+    uint64_t exp_sum = 0, exp_high = 0;
+    uint32_t fifo_ts[2 * CAPTURE_RING_SIZE];
+    uint8_t fifo_ch[2 * CAPTURE_RING_SIZE];
+    uint32_t fifo_len = 0;
+    capture_stats_t st;
+    struct timespec t0, t1;
+    uint32_t i, k, ts;
+    uint8_t ch;
+
+    capture_stream_init(&cs, BATCH, PERIOD_LO, PERIOD_HI);
+
+    for (i = 0; i < count; i++)
+    {
+        uint32_t period = (i == count / 2) ? OUTLIER : PERIOD + (i % 7) - 3;
+        uint64_t edge[2] = {t, t + (period * 3) / 10};
+
+        for (k = 0; k < 2; k++)
+        {
+            uint8_t channel = (k == 0) ? CAPTURE_CH_RISING : CAPTURE_CH_FALLING;
+            // Interrupt latency, every third edge almost a full counter period
+            uint64_t now = edge[k] + ((i % 3 == 0) ? CAPTURE_COUNTER_MASK : 5);
+            uint8_t wake;
+
+            ts = capture_stream_extend((uint32_t)(now >> CAPTURE_COUNTER_BITS),
+                                       edge[k] & CAPTURE_COUNTER_MASK, now & CAPTURE_COUNTER_MASK);
+            if (ts != (uint32_t)edge[k])
+            {
+                fail(i, "extended timestamp differs");
+            }
+
+            fifo_ts[fifo_len] = ts;
+            fifo_ch[fifo_len++] = channel;
+
+            wake = capture_stream_edge(&cs, channel, ts);
+            if (wake & CAPTURE_WAKE_THRESHOLD)
+            {
+                wakes++;
+            }
+            if (wake)
+            {
+                // Drain the ring buffer like the application, in edge order
+                for (fifo_len = 0; capture_stream_pop(&cs, &ch, &ts); fifo_len++)
+                {
+                    if (ts != fifo_ts[fifo_len] || ch != fifo_ch[fifo_len])
+                    {
+                        fail(i, "buffered edge differs");
+                    }
+                }
+                fifo_len = 0;
+            }
+            else if (fifo_len >= CAPTURE_RING_SIZE)
+            {
+                fail(i, "no wake-up before the ring buffer is full");
+                fifo_len = 0;
+            }
+        }
+
+        if (i > 0)
+        {
+            uint32_t prev = (i - 1 == count / 2) ? OUTLIER : PERIOD + ((i - 1) % 7) - 3;
+
+            exp_sum += prev;
+            exp_min = (prev < exp_min) ? prev : exp_min;
+            exp_max = (prev > exp_max) ? prev : exp_max;
+            exp_wakes += (prev < PERIOD_LO || prev > PERIOD_HI);
+        }
+        exp_high += (period * 3) / 10;
+        t += period;
+    }
+
+    capture_stream_stats_take(&cs, &st);
+
+    printf("periods %u min %u max %u mean %llu duty %llu/1000 threshold wake-ups %u overruns %u\n",
+           st.periods, st.period_min, st.period_max, (unsigned long long)(st.period_sum / st.periods),
+           (unsigned long long)(st.high_sum * 1000 / st.period_sum), wakes, st.overruns);
+    printf("jitter");
+    for (k = 0, ts = 0; k < CAPTURE_JITTER_BINS; k++)
+    {
+        printf(" %u", st.jitter[k]);
+        ts += st.jitter[k];
+    }
+    printf("\n");
+
+    if (st.periods != count - 1 || st.period_min != exp_min || st.period_max != exp_max || st.period_sum != exp_sum)
+    {
+        fail(count, "period statistics differ");
+    }
+    if (st.highs != count || st.high_sum != exp_high)
+    {
+        fail(count, "high time statistics differ");
+    }
+    if (ts != count - 2)
+    {
+        fail(count, "jitter histogram does not count every period change");
+    }
+    if (wakes != exp_wakes || st.overruns != 0)
+    {
+        fail(count, "threshold wake-ups or overruns differ");
+    }
+
+    // Without draining, every edge beyond the ring buffer is an overrun
+    capture_stream_init(&cs, BATCH, PERIOD_LO, PERIOD_HI);
+    for (i = 0; i < 1000; i++)
+    {
+        capture_stream_edge(&cs, i & 1, i * PERIOD);
+    }
+    capture_stream_stats_take(&cs, &st);
+    if (st.overruns != 1000 - (CAPTURE_RING_SIZE - 1))
+    {
+        fail(1000, "overrun count differs");
+    }
+
+    capture_stream_init(&cs, BATCH, PERIOD_LO, PERIOD_HI);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0, ts = 0; i < 10000000; i++)
+    {
+        ts += PERIOD / 2;
+        if (capture_stream_edge(&cs, i & 1, ts))
+        {
+            while (capture_stream_pop(&cs, &ch, &k));
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("%.1f ns per edge on the host\n",
+           ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / 1e7);
+
+    printf("%s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/**
+ ****************************************************************************************
+ *
+ * @file meas_math_test.c
+ *
+ * @brief Host test of the measurement unit conversion.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Checks user_meas_math.c against a double-precision reference over the whole range of
+ * cycles values whose result fits in 32 bits:
+ *
+ *     gcc -O2 -Isrc -o meas_math_test tools/meas_math_test.c src/user_meas_math.c -lm
+ *     ./meas_math_test [max cycles]
+ *
+ * The clocks are the 16MHz system clock, for which every 32-bit cycles value is converted,
+ * and RCX frequencies around 15kHz, for which the cycles range ends where the result
+ * leaves 32 bits. For every value meas_recip_apply() must be within one microsecond of the
+ * reference and be the floor or the ceiling of the exact quotient, which is kept as an
+ * integer quotient and remainder next to the loop. meas_recip_apply_floor() must return
+ * the floor. Random clocks and cycles values check the other scales. The exit status is
+ * non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "user_meas_math.h"
+
+static const uint32_t clocks[] = {16000000, 10000, 14999, 15000, 15001, 15536};
+
+static uint32_t errors;
+
+static void fail(uint32_t ref_hz, uint32_t cycles, const char *what)
+{
+    if (errors++ < 10)
+    {
+        printf("error at %u Hz, %u cycles: %s\n", ref_hz, cycles, what);
+    }
+}
+
+static void check(meas_recip_t const *recip, uint32_t cycles, uint32_t quot, uint32_t rem, double *max_err)
+{
+    uint32_t value = meas_recip_apply(recip, cycles);
+    double exact = (double)cycles * recip->scale / recip->ref_hz;
+    double err = fabs((double)value - exact);
+
+    if (err >= 1.0)
+    {
+        fail(recip->ref_hz, cycles, "error of one unit or more");
+    }
+    if ((value != quot) && ((rem == 0) || (value != quot + 1)))
+    {
+        fail(recip->ref_hz, cycles, "neither floor nor ceiling");
+    }
+    if (meas_recip_apply_floor(recip, cycles) != quot)
+    {
+        fail(recip->ref_hz, cycles, "not the floor");
+    }
+    if (err > *max_err)
+    {
+        *max_err = err;
+    }
+}
+
+static void check_init(meas_recip_t const *recip, uint32_t scale, uint32_t ref_hz)
+{
+    uint64_t rem = scale % ref_hz;
+
+    // frac is the smallest 0.32 fraction not below rem / ref_hz
+    if ((recip->whole != scale / ref_hz) || (recip->ref_hz != ref_hz) ||
+        ((uint64_t)recip->frac * ref_hz < (rem << 32)) ||
+        ((recip->frac > 0) && ((uint64_t)(recip->frac - 1) * ref_hz >= (rem << 32))))
+    {
+        fail(ref_hz, 0, "wrong reciprocal");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t limit = (argc > 1) ? strtoull(argv[1], NULL, 0) : UINT32_MAX;
+    meas_recip_t recip;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++)
+    {
+        uint32_t ref_hz = clocks[i];
+        // Largest cycles value whose result fits in 32 bits
+        uint64_t last = ((uint64_t)UINT32_MAX * ref_hz + ref_hz - 1) / MEAS_SCALE_US;
+        uint32_t step_quot = MEAS_SCALE_US / ref_hz, step_rem = MEAS_SCALE_US % ref_hz;
+        uint32_t quot = 0, rem = 0;
+        double max_err = 0;
+        uint64_t cycles;
+
+        meas_recip_init(&recip, MEAS_SCALE_US, ref_hz);
+        check_init(&recip, MEAS_SCALE_US, ref_hz);
+
+        last = (last > UINT32_MAX) ? UINT32_MAX : last;
+        last = (last > limit) ? limit : last;
+
+        // cycles * scale = quot * ref_hz + rem
+        for (cycles = 0; cycles <= last; cycles++)
+        {
+            check(&recip, (uint32_t)cycles, quot, rem, &max_err);
+
+            quot += step_quot;
+            rem += step_rem;
+            if (rem >= ref_hz)
+            {
+                rem -= ref_hz;
+                quot++;
+            }
+        }
+
+        printf("clock_hz=%u cycles=0..%llu max_error_us=%.6f\n", ref_hz, (unsigned long long)last, max_err);
+    }
+
+    srand(1);
+    for (i = 0; i < 1000000; i++)
+    {
+        uint32_t scale = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        uint32_t ref_hz = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) % 100000000 + 1;
+        uint32_t cycles = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        uint64_t exact = (uint64_t)cycles * scale / ref_hz;
+        double max_err = 0;
+
+        if (exact > UINT32_MAX)
+        {
+            continue;
+        }
+        meas_recip_init(&recip, scale, ref_hz);
+        check_init(&recip, scale, ref_hz);
+        check(&recip, cycles, (uint32_t)exact, (uint32_t)((uint64_t)cycles * scale % ref_hz), &max_err);
+    }
+
+    printf("errors=%u\n", errors);
+    printf("%s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -34,6 +34,7 @@ outputs:
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include "math.h"
 #include "Xtal_TRIM.h"
 #include "Xtal_TRIM_platform.h"
@@ -45,11 +46,9 @@ outputs:
  *  Macro definitions
  */
 
-#define MAX_VAL(val1, val2)             (val1 > val2) ? val1 : val2
-#define MIN_VAL(val1, val2)             (val1 < val2) ? val1 : val2
-
 // General parameters
 #define MAX_LOOPS                       (10)
+#define XTAL_TRIM_PROBE_DIV             (16)                // first step = trim range / 16
 #define DELAY_1MSEC                     (1777)              // delay x * 1 msec
 
 typedef enum __xtal_sections{
@@ -75,7 +74,7 @@ volatile uint32_t actual_trimming_value;
 void delay(uint32_t dd);
 void Setting_Trim(uint32_t Trim_Value);
 long Clock_Read(uint8_t port_number);
-int linearization(int C, int Cmin, int Cmax, int Tmin, int Tmax);
+int32_t secant_trim(int32_t T0, int32_t E0, int32_t T1, int32_t E1);
 
 // *** delay routine x * 1 msec / is controlled by 16M or 32M XTAL
 void delay(uint32_t dd)
@@ -148,14 +147,27 @@ long Clock_Read(uint8_t port_number)
     return cnt_output;
 }
 
-// *** calculate new TRIM via linear line algorithm
-int linearization(int C, int Cmin, int Cmax, int Tmin, int Tmax)
+// *** calculate new TRIM where the line through (T0, E0) and (T1, E1) crosses zero error
+// returns -1 if the line does not fall with the trim value (noise), the caller then bisects
+int32_t secant_trim(int32_t T0, int32_t E0, int32_t T1, int32_t E1)
 {
-    int T;
+    int32_t dT = T1 - T0;
+    int32_t dE = E1 - E0;
+    int32_t num;
+
+    if ((dT == 0) || (dE == 0) || ((dT > 0) == (dE > 0)))
+        return -1;
 
-    T = Tmin + (Cmax - C) * (Tmax - Tmin) / (Cmax - Cmin);
+    // T1 - E1 * dT / dE, rounded to the nearest trim value
+    num = E1 * dT;
+    if (dE < 0)
+    {
+        num = -num;
+        dE = -dE;
+    }
+    num = (num >= 0) ? (num + dE / 2) : (num - dE / 2);
 
-    return T;
+    return T1 - num / dE;
 }
 
 // *** main function is start of auto-calibration
@@ -164,10 +176,7 @@ int auto_trim(uint8_t XTAL_select, uint8_t port_number)
     int response = WRONG_XTAL_SOURCE_ERROR;
     uint8_t loop = 1;                               // loop 1 ... max 10
 
-    uint32_t Trim_low = 0;
-    uint32_t Trim_hi = 0;
     static volatile uint32_t Trim_curr = 0;
-    volatile uint32_t ticks_hi = 0, ticks_low = 0;
     volatile uint32_t ticks_curr = 0;
     static volatile uint32_t IDEAL_XTAL_count = 0;
     static volatile uint32_t PPM_1 = 0, PPM_2 = 0;
@@ -268,110 +277,115 @@ int auto_trim(uint8_t XTAL_select, uint8_t port_number)
     ////////////////////////////////////////////////////////////////////////////////////////////
 
     ////////////////////////////////////////////////////////////////////////////////////////////
-    // Run for the edge point that will be used
-    ////////////////////////////////////////////////////////////////////////////////////////////
-
-    // At this point we only have one measurement. We need a second to complete the triangles.
-    // This is going to be the opposite of the point that will change later on.
-    // Prepare the next point based on the calculation of the ideal value.
-    // Calculate the edge point to be used for the next measurement.
-    {
-        // ** 4e set Trim at Tmax or Tmin
-        if (ticks_curr > IDEAL_XTAL_count) //left part
-        {
-            Trim_hi = border[XTAL_SEC_MAX];
-            Setting_Trim(border[XTAL_SEC_MAX]); // start e.g. Trim at 250
-            // ** 5e Clock Read at Trim
-            ticks_hi = Clock_Read(port_number); // at Tmin (at C_max) or Tmax (at C_min)
-#if AUTO_XTAL_TEST_DBG_EN
-            debug_array_trim[1] = Trim_hi;
-            debug_array_diff_ticks[1] = ticks_hi;// - IDEAL_XTAL_count;
-#endif
-        }
-        else
-        {
-            Trim_low = border[XTAL_SEC_MIN];
-            Setting_Trim(border[XTAL_SEC_MIN]);
-            // ** 5e Clock Read at Trim
-            ticks_low = Clock_Read(port_number); // at Tmin (at C_max) or Tmax (at C_min)
-#if AUTO_XTAL_TEST_DBG_EN
-            debug_array_trim[1] = Trim_low;
-            debug_array_diff_ticks[1] = ticks_low;// - IDEAL_XTAL_count;
-#endif
-        }
-    }
-
-    ////////////////////////////////////////////////////////////////////////////////////////////
-    // End Run for the edge point that will be used
-    ////////////////////////////////////////////////////////////////////////////////////////////
-
-    ////////////////////////////////////////////////////////////////////////////////////////////
-    // Minimize the calculation error
+    // Search the trim value
     ////////////////////////////////////////////////////////////////////////////////////////////
 
-    /*  The following parameters are needed to enter the main loop
-        Trim_low
-        Trim_hi
-        Trim_curr
-        ticks_low       // Coupled to Trim_low
-        ticks_hi        // Coupled to Trim_hi
-        ticks_curr
+    /*  The count error decreases monotonically with the trim value (more load capacitance
+        means a slower XTAL). Every measurement costs a full pulse, so the search keeps the
+        number of measurements low:
+        - The first step probes a point near the start value to learn the local slope,
+          instead of measuring at a border where the curve is the least linear.
+        - All next steps are secant steps through the two latest points.
+        - Every measurement narrows the bracket [Trim_low, Trim_hi] that holds the target.
+          A secant step that leaves the bracket, or a secant with the wrong slope sign
+          (measurement noise), falls back to bisection of the bracket.
+        - The search ends as soon as a measurement is within PPM_1, or when the bracket
+          cannot be split any more (it is reopened once around the best value to cope
+          with noise). Then the best measured value is kept.
     */
-
-    // Try to minimilize the calculation error by continiously closing to the ideal count.
     {
-        // ** 6e loop
+        uint32_t Trim_low = border[XTAL_SEC_MIN];   // Target is above, error > 0
+        uint32_t Trim_hi = border[XTAL_SEC_MAX];    // Target is below, error < 0
+        uint32_t Trim_prev = 0;
+        uint32_t Trim_best = Trim_curr;
+        int32_t err_curr = (int32_t)ticks_curr - (int32_t)IDEAL_XTAL_count;
+        int32_t err_prev = 0;
+        int32_t err_best = err_curr;
+        int32_t Trim_next;
+        bool have_prev = false;
+        bool reopened = false;
+
         loop = 0;
-        do
+        while ((loop < MAX_LOOPS) && (PulseError == false))
         {
-            loop++; // max amount of loops
+            loop++;
+
+            // ** 6e narrow the bracket with the latest measurement
+            if (err_curr > 0)
+                Trim_low = Trim_curr;
+            else
+                Trim_hi = Trim_curr;
 
-            // Depending on the tick offset (positive or negative regarding the ideal count),
-            // determine the direction of the next measurement.
-            // Based on that decision, take a measurement on the edge of that direction.
+            if (Trim_hi - Trim_low <= 1)
+            {
+                // no trim value left between two measured ones. A noisy measurement may
+                // have closed the bracket on the wrong side, so reopen it once around the
+                // best value and measure its neighbours again.
+                if (reopened || (Trim_best <= border[XTAL_SEC_MIN]) || (Trim_best >= border[XTAL_SEC_MAX]))
+                    break;
+                reopened = true;
+                Trim_low = Trim_best - 2;
+                Trim_hi = Trim_best + 2;
+                have_prev = false;
+            }
 
-            // We have three types of points
-            // LOW, CURR, HIGH.
-            // In each iteration we should update our triangles and narrow them to the optimal value.
-            if (ticks_curr > IDEAL_XTAL_count)
+            // ** 7e next trim value
+            if (!have_prev)
             {
-                // Assign the current value as the low value
-                // High value remains the same.
-                Trim_low = Trim_curr;
-                ticks_low = ticks_curr;
+                int32_t probe = (int32_t)(TRIM_MAX - TRIM_MIN) / XTAL_TRIM_PROBE_DIV;
+
+                Trim_next = (err_curr > 0) ? (int32_t)Trim_curr + probe : (int32_t)Trim_curr - probe;
             }
             else
             {
-                // Assign the current value as the high value
-                // Low value remains the same.
-                Trim_hi = Trim_curr;
-                ticks_hi = ticks_curr;
+                Trim_next = secant_trim(Trim_prev, err_prev, Trim_curr, err_curr);
+
+                // The zero crossing is closer than half a step, try the neighbour towards it
+                if (Trim_next == (int32_t)Trim_curr)
+                    Trim_next = (err_curr > 0) ? (int32_t)Trim_curr + 1 : (int32_t)Trim_curr - 1;
             }
 
-            // **  8e  Trim_next = sub linearization
-            Trim_curr = linearization(IDEAL_XTAL_count, MIN_VAL(ticks_low, ticks_hi), MAX_VAL(ticks_low, ticks_hi), Trim_low, Trim_hi);
+            if ((Trim_next <= (int32_t)Trim_low) || (Trim_next >= (int32_t)Trim_hi))
+                Trim_next = (Trim_low + Trim_hi) / 2;
+
+            Trim_prev = Trim_curr;
+            err_prev = err_curr;
+            have_prev = true;
+            Trim_curr = Trim_next;
 
-            // **  9e Trim = Trim_next
+            // ** 8e Trim = Trim_next
             Setting_Trim(Trim_curr);
 
-            // ** 10e temp = Clock_Read()
+            // ** 9e temp = Clock_Read()
             ticks_curr = Clock_Read(port_number);
+            err_curr = (int32_t)ticks_curr - (int32_t)IDEAL_XTAL_count;
 
 #if AUTO_XTAL_TEST_DBG_EN
-            debug_array_trim[loop+1] = Trim_curr;
-            debug_array_diff_ticks[loop+1] = ticks_curr;// - IDEAL_XTAL_count;
+            debug_array_trim[loop] = Trim_curr;
+            debug_array_diff_ticks[loop] = ticks_curr;// - IDEAL_XTAL_count;
 #endif
-            // ** 11e if abs(temp - C_ideal) <= in spec => break
-            if ((ticks_curr >= IDEAL_XTAL_count) && ((ticks_curr - IDEAL_XTAL_count) <= PPM_1))   // XTAL32M = C_ideal (9.6M at 300ms)
-                break;  // out of while
-            if ((ticks_curr < IDEAL_XTAL_count) && ((IDEAL_XTAL_count - ticks_curr) <= PPM_1))    // XTAL32M = C_ideal (9.6M at 300ms)
-                break;  // out of while
+            if (abs(err_curr) < abs(err_best))
+            {
+                Trim_best = Trim_curr;
+                err_best = err_curr;
+            }
+
+            // ** 10e if abs(temp - C_ideal) <= in spec => break
+            if (abs(err_curr) <= (int32_t)PPM_1)
+                break;
+        }
+
+        // ** 11e keep the best measured value
+        if ((PulseError == false) && (Trim_best != Trim_curr))
+        {
+            Trim_curr = Trim_best;
+            ticks_curr = IDEAL_XTAL_count + err_best;
+            Setting_Trim(Trim_curr);
         }
-        while(loop < MAX_LOOPS/*=10*/);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////
-    // End of Minimize the calculation error
+    // End of Search the trim value
     ////////////////////////////////////////////////////////////////////////////////////////////
 
     ////////////////////////////////////////////////////////////////////////////////////////////
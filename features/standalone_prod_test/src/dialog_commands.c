@@ -131,6 +131,9 @@ extern uint32_t lp_clk_sel;
 extern void uart_finish_transfers_func(void);
 static uint8_t hci_otp_rd_data_cmd_cmp_evt_pk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len);
 static uint8_t hci_wr_otp_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len);
+static uint8_t hci_script_run_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len);
+static uint8_t hci_script_run_cmd_cmp_evt_pk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len);
+static uint8_t hci_otp_image_write_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len);
 static uint8_t hci_pack_bytes(uint8_t** pp_in, uint8_t** pp_out, uint8_t* p_in_end, uint8_t* p_out_end, uint8_t len);
 
 // HCI dialog command descriptors (OGF Vendor Specific)
@@ -168,10 +171,41 @@ const struct hci_cmd_desc_tag hci_cmd_desc_tab_dialog_vs[] =
     CMD(RESET_MODE               , DBG, 0, PK_GEN_GEN, "B"                    , "B"                            ),
 #endif
     CMD(PLATFORM_RESET           , DBG, 0, PK_GEN_GEN, "NULL"                 , "B"                            ),
+    CMD(SCRIPT_RUN               , DBG, 0, PK_SPE_SPE, &hci_script_run_cmd_upk, &hci_script_run_cmd_cmp_evt_pk ),
+    CMD(OTP_IMAGE_WRITE          , DBG, 0, PK_SPE_GEN, &hci_otp_image_write_cmd_upk, "BBBB8H"                ),
 };
 
 const uint8_t dialog_commands_num = ARRAY_LEN (hci_cmd_desc_tab_dialog_vs);
 
+/**
+ ****************************************************************************************
+ * @brief Samples the battery voltage with the ADC.
+ *
+ * @param[in] vbat_type Buck: 0x0=VBAT_HIGH, 0x1=VBAT_LOW. Boost: 0x0=VBAT_LOW, 0x1=VBAT_HIGH.
+ *                      Only used by DA14531.
+ *
+ * @return The ADC sample.
+ ****************************************************************************************
+ */
+uint16_t dialog_commands_vbat_sample(uint8_t vbat_type)
+{
+#if defined (__DA14531__)
+    return (uint16_t) adc_531_get_vbat_sample(vbat_type);
+#else
+    adc_offset_calibrate(ADC_INPUT_MODE_SINGLE_ENDED);
+    if (GetBits16(ANA_STATUS_REG, BOOST_SELECTED) == 0x1)
+    {
+        // Boost mode
+        return (uint16_t) adc_get_vbat_sample(true);
+    }
+    else
+    {
+        // Buck mode
+        return (uint16_t) adc_get_vbat_sample(false);
+    }
+#endif
+}
+
 /**
  ****************************************************************************************
  * @brief Handles the reception of the ADC read VBAT value command.
@@ -193,21 +227,7 @@ static int dialog_commands_adc_vbat_handler(ke_msg_id_t const msgid,
     struct hci_adc_vbat_dialog_cmd_cmp_evt *event =
         KE_MSG_ALLOC(HCI_CMD_CMP_EVENT, src_id, HCI_ADC_VBAT_CMD_OPCODE, hci_adc_vbat_dialog_cmd_cmp_evt);
 
-#if defined (__DA14531__)
-    event->vbat_lvl = (uint16_t) adc_531_get_vbat_sample(param->vbat_type);
-#else
-    adc_offset_calibrate(ADC_INPUT_MODE_SINGLE_ENDED);
-    if (GetBits16(ANA_STATUS_REG, BOOST_SELECTED) == 0x1)
-    {
-        // Boost mode
-        event->vbat_lvl = (uint16_t) adc_get_vbat_sample(true);
-    }
-    else
-    {
-        // Buck mode
-        event->vbat_lvl = (uint16_t) adc_get_vbat_sample(false);
-    }
-#endif
+    event->vbat_lvl = dialog_commands_vbat_sample(param->vbat_type);
 
     hci_send_2_host(event);
 
@@ -764,18 +784,36 @@ static int dialog_commands_tx_end_continue_test_handler(ke_msg_id_t const msgid,
     // structure type for the complete command event
     void *event = ke_msg_alloc(HCI_CMD_CMP_EVENT , src_id, HCI_TX_END_CONTINUE_TEST_CMD_OPCODE, 0);
 
-    if (test_state == STATE_START_CONTINUE_TX)
+    if (dialog_commands_tx_end_continue())
     {
-#if defined (__DA14531__)
-        stop_refresh_timer();
-#endif
-        set_state_stop();
-        SetWord32(BLE_RFTESTCNTL_REG,0);
         hci_send_2_host(event);
     }
     return (KE_MSG_CONSUMED);
 }
 
+/**
+ ****************************************************************************************
+ * @brief Stops the continuous modulated TX test.
+ *
+ * @return False if the test was not running.
+ ****************************************************************************************
+ */
+bool dialog_commands_tx_end_continue(void)
+{
+    if (test_state != STATE_START_CONTINUE_TX)
+    {
+        return false;
+    }
+
+#if defined (__DA14531__)
+    stop_refresh_timer();
+#endif
+    set_state_stop();
+    SetWord32(BLE_RFTESTCNTL_REG,0);
+
+    return true;
+}
+
 /**
  ****************************************************************************************
  * @brief Handles the reception of the start_prod_rx_test dialog hci command.
@@ -857,10 +895,31 @@ static int dialog_commands_unmodulated_on_handler(ke_msg_id_t const msgid,
 {
     // structure type for the complete command event
     void *event = ke_msg_alloc(HCI_CMD_CMP_EVENT , src_id, HCI_UNMODULATED_ON_CMD_OPCODE, 0);
+
+    if (dialog_commands_unmodulated(param->operation, param->frequency))
+    {
+        hci_send_2_host(event);
+    }
+
+    return (KE_MSG_CONSUMED);
+}
+
+/**
+ ****************************************************************************************
+ * @brief Starts or stops the unmodulated TX/RX test.
+ *
+ * @param[in] operation UNMODULATED_CMD_MODE_TX, UNMODULATED_CMD_MODE_RX or UNMODULATED_CMD_MODE_OFF.
+ * @param[in] frequency RF channel.
+ *
+ * @return False if the operation is unknown.
+ ****************************************************************************************
+ */
+bool dialog_commands_unmodulated(uint8_t operation, uint8_t frequency)
+{
     uint16_t cn;
     bool cmd_flag =false;
 
-    switch(param->operation)
+    switch(operation)
     {
     case UNMODULATED_CMD_MODE_OFF: //UNMODULATED OFF
 #if !defined (__DA14531__)
@@ -892,7 +951,7 @@ static int dialog_commands_unmodulated_on_handler(ke_msg_id_t const msgid,
     case UNMODULATED_CMD_MODE_TX: //UNMODULATED TX
         NVIC_DisableIRQ(BLE_RF_DIAG_IRQn);
 
-        cn = param->frequency;
+        cn = frequency;
     
 #if !defined (__DA14531__)
 
@@ -940,7 +999,7 @@ static int dialog_commands_unmodulated_on_handler(ke_msg_id_t const msgid,
     case UNMODULATED_CMD_MODE_RX: //UNMODULATED RX
         NVIC_DisableIRQ(BLE_RF_DIAG_IRQn);
 
-        cn = param->frequency;
+        cn = frequency;
 
 #if !defined (__DA14531__)
 
@@ -988,12 +1047,7 @@ static int dialog_commands_unmodulated_on_handler(ke_msg_id_t const msgid,
         break;
     }
 
-    if(cmd_flag)
-    {
-        hci_send_2_host(event);
-    }
-
-    return (KE_MSG_CONSUMED);
+    return cmd_flag;
 }
 
 /**
@@ -2155,6 +2209,191 @@ static int dialog_commands_set_reset_mode_handler(ke_msg_id_t const msgid,
 
 #endif // __DA14531__
 
+/**
+ ****************************************************************************************
+ * @brief Handles the reception of the script_run dialog hci command. The script is
+ *        executed from the main loop, the command complete event with the results of
+ *        all steps is sent when it ends.
+ *
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ *
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int dialog_commands_script_run_handler(ke_msg_id_t const msgid,
+                                              struct hci_script_run_dialog_cmd const *param,
+                                              ke_task_id_t const dest_id,
+                                              ke_task_id_t const src_id)
+{
+    uint8_t status = prod_test_script_start(param->script, param->length);
+
+    // A started script answers with its results when it completes, a rejected one right away
+    if (status != CO_ERROR_NO_ERROR)
+    {
+        struct hci_script_run_dialog_cmd_cmp_evt *event = KE_MSG_ALLOC(HCI_CMD_CMP_EVENT , src_id, HCI_SCRIPT_RUN_CMD_OPCODE, hci_script_run_dialog_cmd_cmp_evt);
+
+        memset(event, 0, sizeof(*event));
+        event->status = status;
+        event->first_failed = 0xFF;
+        hci_send_2_host(event);
+    }
+
+    return (KE_MSG_CONSUMED);
+}
+
+/// Special unpacking function for HCI Script Run Command
+static uint8_t hci_script_run_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len)
+{
+    struct hci_script_run_dialog_cmd* cmd = (struct hci_script_run_dialog_cmd*) out;
+    uint8_t* p_in = in;
+    uint8_t* p_out = out;
+    uint8_t* p_out_end = out + *out_len;
+    uint8_t status = HCI_PACK_OK;
+
+    // Check if there is input data to parse
+    if(in != NULL)
+    {
+        if(in_len > PROD_TEST_SCRIPT_MAX_LEN)
+        {
+            status = HCI_PACK_OUT_BUF_OVFLW;
+        }
+        else
+        {
+            // The whole parameter block is the script
+            cmd->length = (uint8_t)in_len;
+            p_out = &cmd->script[0];
+            status = hci_pack_bytes(&p_in, &p_out, in + in_len, p_out_end, (uint8_t)in_len);
+        }
+
+        *out_len =  (uint16_t)(p_out - out);
+    }
+    else
+    {
+        // If no input data, size max is returned
+        *out_len = sizeof(struct hci_script_run_dialog_cmd);
+    }
+
+    return status;
+}
+
+/// Special packing function for Command Complete Event of HCI Script Run Command
+static uint8_t hci_script_run_cmd_cmp_evt_pk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len)
+{
+    struct hci_script_run_dialog_cmd_cmp_evt* evt = (struct hci_script_run_dialog_cmd_cmp_evt*)(in);
+    uint8_t* p_in = in;
+    uint8_t* p_out = out;
+    uint8_t* p_in_end = in + in_len;
+    uint8_t* p_out_end = out + *out_len;
+    uint8_t status = HCI_PACK_OK;
+
+    // Check if there is input data to parse
+    if(in != NULL)
+    {
+        do
+        {
+            // Status, number of steps, failed steps, first failed step
+            p_in = &evt->status;
+            status = hci_pack_bytes(&p_in, &p_out, p_in_end, p_out_end, 4);
+            if(status != HCI_PACK_OK)
+                break;
+
+            // Duration
+            p_in = (uint8_t*) &evt->duration_ms;
+            status = hci_pack_bytes(&p_in, &p_out, p_in_end, p_out_end, 4);
+            if(status != HCI_PACK_OK)
+                break;
+
+            // Step results, without the structure padding
+            for(uint8_t i = 0; (i < evt->steps) && (i < PROD_TEST_SCRIPT_MAX_STEPS); i++)
+            {
+                p_in = &evt->step[i].status;
+                status = hci_pack_bytes(&p_in, &p_out, p_in_end, p_out_end, 1);
+                if(status != HCI_PACK_OK)
+                    break;
+
+                p_in = (uint8_t*) &evt->step[i].value;
+                status = hci_pack_bytes(&p_in, &p_out, p_in_end, p_out_end, 2);
+                if(status != HCI_PACK_OK)
+                    break;
+            }
+
+        } while(0);
+
+        *out_len =  (uint16_t)(p_out - out);
+    }
+    else
+    {
+        *out_len = 0;
+    }
+
+    return status;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Handles the reception of the otp_image_write dialog hci command. The image is
+ *        programmed and verified in one pass, see otp_image.h.
+ *
+ * @param[in] msgid Id of the message received (probably unused).
+ * @param[in] param Pointer to the parameters of the message.
+ * @param[in] dest_id ID of the receiving task instance (probably unused).
+ * @param[in] src_id ID of the sending task instance.
+ *
+ * @return If the message was consumed or not.
+ ****************************************************************************************
+ */
+static int dialog_commands_otp_image_write_handler(ke_msg_id_t const msgid,
+                                                   struct hci_otp_image_write_dialog_cmd const *param,
+                                                   ke_task_id_t const dest_id,
+                                                   ke_task_id_t const src_id)
+{
+    // structure type for the complete command event
+    struct hci_otp_image_write_dialog_cmd_cmp_evt *event = KE_MSG_ALLOC(HCI_CMD_CMP_EVENT , src_id, HCI_OTP_IMAGE_WRITE_CMD_OPCODE, hci_otp_image_write_dialog_cmd_cmp_evt);
+
+    otp_image_program(param->image, param->length, &event->report);
+
+    hci_send_2_host(event);
+    return (KE_MSG_CONSUMED);
+}
+
+/// Special unpacking function for HCI OTP Image Write Command
+static uint8_t hci_otp_image_write_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len)
+{
+    struct hci_otp_image_write_dialog_cmd* cmd = (struct hci_otp_image_write_dialog_cmd*) out;
+    uint8_t* p_in = in;
+    uint8_t* p_out = out;
+    uint8_t* p_out_end = out + *out_len;
+    uint8_t status = HCI_PACK_OK;
+
+    // Check if there is input data to parse
+    if(in != NULL)
+    {
+        if(in_len > OTP_IMAGE_MAX_LEN)
+        {
+            status = HCI_PACK_OUT_BUF_OVFLW;
+        }
+        else
+        {
+            // The whole parameter block is the image
+            cmd->length = (uint8_t)in_len;
+            p_out = &cmd->image[0];
+            status = hci_pack_bytes(&p_in, &p_out, in + in_len, p_out_end, (uint8_t)in_len);
+        }
+
+        *out_len =  (uint16_t)(p_out - out);
+    }
+    else
+    {
+        // If no input data, size max is returned
+        *out_len = sizeof(struct hci_otp_image_write_dialog_cmd);
+    }
+
+    return status;
+}
+
 /// Special unpacking function for HCI Debug Write OTP Command
 static uint8_t hci_wr_otp_cmd_upk(uint8_t *out, uint8_t *in, uint16_t* out_len, uint16_t in_len)
 {
@@ -2328,6 +2567,8 @@ const struct ke_msg_handler dialog_commands_handler_tab[] =
         {HCI_RESET_MODE_CMD_OPCODE              ,  (ke_msg_func_t)dialog_commands_set_reset_mode_handler         },
 #endif
         {HCI_PLATFORM_RESET_CMD_OPCODE          ,  (ke_msg_func_t)dialog_commands_platform_reset_handler         },
+        {HCI_SCRIPT_RUN_CMD_OPCODE              ,  (ke_msg_func_t)dialog_commands_script_run_handler             },
+        {HCI_OTP_IMAGE_WRITE_CMD_OPCODE         ,  (ke_msg_func_t)dialog_commands_otp_image_write_handler        },
 };
 
 const uint8_t dialog_commands_handler_num = ARRAY_LEN (dialog_commands_handler_tab);
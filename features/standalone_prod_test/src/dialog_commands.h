@@ -21,8 +21,11 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "hci_int.h"
 #include "ke_task.h"
+#include "prod_test_script.h"
+#include "otp_image.h"
 
 /*
  * DEFINES
@@ -64,6 +67,8 @@ enum
     HCI_CONFIGURE_TEST_MODE_CMD_OPCODE,                             /* 0xFE1C */
     HCI_PLATFORM_RESET_CMD_OPCODE,                                  /* 0xFE1D */
     HCI_RESET_MODE_CMD_OPCODE,                                      /* 0xFE1E */
+    HCI_SCRIPT_RUN_CMD_OPCODE,                                      /* 0xFE1F */
+    HCI_OTP_IMAGE_WRITE_CMD_OPCODE,                                 /* 0xFE20 */
     HCI_VS_LAST_DIALOG_CMD_OPCODE           // DO NOT MOVE. Must always be last and opcodes linear (00,01,02 ...)
 };
 
@@ -459,6 +464,44 @@ struct hci_set_reset_mode_dialog_cmd_cmp_evt
 };
 #endif
 
+// HCI dialog script_run command parameters - vendor specific
+struct hci_script_run_dialog_cmd
+{
+    uint8_t length;
+    uint8_t script[PROD_TEST_SCRIPT_MAX_LEN];
+};
+
+// Result of one script step
+struct hci_script_step_result
+{
+    uint8_t status;     /* PROD_TEST_SCRIPT_STEP_PASS, _FAIL or _SKIPPED. */
+    uint16_t value;     /* Measured value, depends on the step opcode. */
+};
+
+// HCI dialog script_run complete event parameters - vendor specific
+struct hci_script_run_dialog_cmd_cmp_evt
+{
+    uint8_t status;
+    uint8_t steps;
+    uint8_t failed;
+    uint8_t first_failed;   /* 0xFF if no step failed. */
+    uint32_t duration_ms;
+    struct hci_script_step_result step[PROD_TEST_SCRIPT_MAX_STEPS];
+};
+
+// HCI dialog otp_image_write command parameters - vendor specific
+struct hci_otp_image_write_dialog_cmd
+{
+    uint8_t length;
+    uint8_t image[OTP_IMAGE_MAX_LEN];
+};
+
+// HCI dialog otp_image_write complete event parameters - vendor specific
+struct hci_otp_image_write_dialog_cmd_cmp_evt
+{
+    struct otp_image_report report;
+};
+
 /*
  * GLOBAL VARIABLES
  ****************************************************************************************
@@ -473,4 +516,13 @@ extern const struct hci_cmd_desc_tag hci_cmd_desc_tab_dialog_vs[];
 // Dialog HCI commands handlers
 extern const struct ke_msg_handler dialog_commands_handler_tab[];
 
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+uint16_t dialog_commands_vbat_sample(uint8_t vbat_type);
+bool dialog_commands_unmodulated(uint8_t operation, uint8_t frequency);
+bool dialog_commands_tx_end_continue(void);
+
 #endif // DIALOG_COMMANDS_H_
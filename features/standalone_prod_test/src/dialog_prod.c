@@ -44,6 +44,7 @@
 #if defined (__DA14531__)
 #include "adc_531.h"
 #include "rf_531.h"
+#include "user_delay.h"
 #endif
 
 /*
@@ -333,6 +334,9 @@ void user_app_on_init(void)
 #if defined (__DA14531__)
     rf_pa_pwr_set(RADIO_INIT_TX_POWER);
     rf_reinit();
+
+    // The ADC settling wait of adc_531_get_vbat_sample() runs on the calibrated delay
+    user_delay_calibrate();
 #endif
 
 #if defined (BATCH_REMOTE_MODE) || defined(REMOTE_MODE)
@@ -356,11 +360,11 @@ int otp_write_words(uint32_t otp_pos, uint32_t *val_addr, uint8_t words_count)
 
         if (result == false)
         {
-            break;
+            return -1;
         }
     }
 #else
-    int result;
+    int result = 0;
     uint32_t otp_addr;
 
     for(uint16_t i = 0; i < words_count; i += 2)
@@ -369,7 +373,7 @@ int otp_write_words(uint32_t otp_pos, uint32_t *val_addr, uint8_t words_count)
         //Initialize OTP Controller
         hw_otpc_init();
         //write the OTP
-        result = hw_otpc_fifo_prog((const uint32_t *) (val_addr), otp_addr >> 3, HW_OTPC_WORD_LOW, 2, false) ? 0 : 1;
+        result = hw_otpc_fifo_prog((const uint32_t *) (val_addr + i), otp_addr >> 3, HW_OTPC_WORD_LOW, 2, false) ? 0 : 1;
 
         hw_otpc_disable();
         otp_pos += 8;
@@ -380,6 +384,11 @@ int otp_write_words(uint32_t otp_pos, uint32_t *val_addr, uint8_t words_count)
 
     //Close the OTP Controller
     hw_otpc_close();
+
+    if (result != 0)
+    {
+        return -1;
+    }
 #endif // defined (__DA14531__)
 
     return 0;
@@ -851,24 +860,6 @@ void apply_radio_arp_tx_configuration(void)
     }
 }
 
-static void usDelay(uint32_t nof_us)
-{
-    while ( nof_us-- )
-    {
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-        __NOP();
-    }
-}
-
 uint32_t adc_531_get_vbat_sample(uint8_t vbat_type)
 {
     uint32_t adc_sample;
@@ -896,7 +887,7 @@ uint32_t adc_531_get_vbat_sample(uint8_t vbat_type)
 
     adc_init(&cfg);
 
-    usDelay(40);
+    user_delay_us(40);
 
     adc_sample = adc_correct_sample(adc_get_sample());
 
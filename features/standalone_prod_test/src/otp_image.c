@@ -0,0 +1,323 @@
+/**
+ ****************************************************************************************
+ *
+ * @file otp_image.c
+ *
+ * @brief Bulk OTP image programming source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "datasheet.h"
+#include "dialog_prod.h"
+#include "otp_image.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define OTP_IMAGE_TO_WRITE(cell)    (write_map[(cell) / 32] & (1UL << ((cell) % 32)))
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct otp_image_record
+{
+    uint16_t offset;
+    uint8_t cells;
+    const uint8_t *data;
+};
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+static struct otp_image_record records[OTP_IMAGE_MAX_RECORDS];
+static uint8_t record_count;
+
+// Cells to program, one bit per cell of the image in record order
+static uint32_t write_map[OTP_IMAGE_MAX_CELLS / 32];
+
+static uint8_t otp_buf[OTP_IMAGE_MAX_LEN];
+static uint32_t word_buf[OTP_IMAGE_MAX_LEN / 4];
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t otp_image_crc32(const uint8_t *data, uint8_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint8_t i, bit;
+
+    for (i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+static uint8_t otp_image_parse(const uint8_t *image, uint8_t len)
+{
+    uint16_t pos = 1;
+    uint16_t cells = 0;
+    uint16_t end = len - OTP_IMAGE_CRC_LEN;
+    uint32_t crc;
+    uint8_t i, j;
+
+    if (len < 1 + OTP_IMAGE_CRC_LEN)
+    {
+        return OTP_IMAGE_BAD_FORMAT;
+    }
+
+    crc = image[end] | (image[end + 1] << 8) | (image[end + 2] << 16) | ((uint32_t)image[end + 3] << 24);
+    if (crc != otp_image_crc32(image, end))
+    {
+        return OTP_IMAGE_BAD_CRC;
+    }
+
+    record_count = image[0];
+    if ((record_count == 0) || (record_count > OTP_IMAGE_MAX_RECORDS))
+    {
+        return OTP_IMAGE_BAD_FORMAT;
+    }
+
+    for (i = 0; i < record_count; i++)
+    {
+        uint16_t size;
+
+        if (pos + OTP_IMAGE_RECORD_HDR_LEN > end)
+        {
+            return OTP_IMAGE_BAD_FORMAT;
+        }
+
+        records[i].offset = image[pos] | (image[pos + 1] << 8);
+        size = image[pos + 2] * 4;
+        records[i].cells = size / OTP_IMAGE_CELL_SIZE;
+        records[i].data = &image[pos + OTP_IMAGE_RECORD_HDR_LEN];
+        pos += OTP_IMAGE_RECORD_HDR_LEN + size;
+
+        if ((size == 0) || (pos > end) ||
+            (size % OTP_IMAGE_CELL_SIZE) || (records[i].offset % OTP_IMAGE_CELL_SIZE))
+        {
+            return OTP_IMAGE_BAD_FORMAT;
+        }
+
+        if ((uint32_t)records[i].offset + size > OTP_IMAGE_OTP_SIZE)
+        {
+            return OTP_IMAGE_OUT_OF_RANGE;
+        }
+
+        // Two records for the same cell would program it twice
+        for (j = 0; j < i; j++)
+        {
+            if ((records[i].offset < records[j].offset + records[j].cells * OTP_IMAGE_CELL_SIZE) &&
+                (records[j].offset < records[i].offset + size))
+            {
+                return OTP_IMAGE_BAD_FORMAT;
+            }
+        }
+
+        cells += records[i].cells;
+    }
+
+    if ((pos != end) || (cells > OTP_IMAGE_MAX_CELLS))
+    {
+        return OTP_IMAGE_BAD_FORMAT;
+    }
+
+    return OTP_IMAGE_OK;
+}
+
+static void otp_image_fail(struct otp_image_report *report, uint16_t offset)
+{
+    if (report->failed < OTP_IMAGE_MAX_REPORTED)
+    {
+        report->failed_offset[report->failed] = offset;
+    }
+    report->failed++;
+}
+
+static bool otp_image_blank(const uint8_t *cell)
+{
+    uint8_t i;
+
+    for (i = 0; i < OTP_IMAGE_CELL_SIZE; i++)
+    {
+        if (cell[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Reads every cell of the image. Cells holding the value are skipped. Only blank
+ *        cells are programmed: the DA14585/586 stores an ECC per cell, so adding bits to
+ *        a programmed cell corrupts it.
+ ****************************************************************************************
+ */
+static void otp_image_plan(struct otp_image_report *report)
+{
+    uint8_t i, c;
+    uint8_t cell = 0;
+
+    memset(write_map, 0, sizeof(write_map));
+
+    for (i = 0; i < record_count; i++)
+    {
+        otp_read(MEMORY_OTP_BASE + records[i].offset, otp_buf, records[i].cells * OTP_IMAGE_CELL_SIZE);
+
+        for (c = 0; c < records[i].cells; c++, cell++)
+        {
+            const uint8_t *cur = &otp_buf[c * OTP_IMAGE_CELL_SIZE];
+
+            if (memcmp(cur, &records[i].data[c * OTP_IMAGE_CELL_SIZE], OTP_IMAGE_CELL_SIZE) == 0)
+            {
+                report->skipped++;
+            }
+            else if (otp_image_blank(cur))
+            {
+                write_map[cell / 32] |= 1UL << (cell % 32);
+            }
+            else
+            {
+                otp_image_fail(report, records[i].offset + c * OTP_IMAGE_CELL_SIZE);
+            }
+        }
+    }
+}
+
+static bool otp_image_write_run(const struct otp_image_record *rec, uint8_t first, uint8_t count)
+{
+    const uint8_t *src = &rec->data[first * OTP_IMAGE_CELL_SIZE];
+    uint8_t words = count * (OTP_IMAGE_CELL_SIZE / 4);
+    uint8_t w;
+
+    for (w = 0; w < words; w++)
+    {
+        word_buf[w] = src[w * 4] | (src[w * 4 + 1] << 8) | (src[w * 4 + 2] << 16) | ((uint32_t)src[w * 4 + 3] << 24);
+    }
+
+    return (otp_write_words(rec->offset + first * OTP_IMAGE_CELL_SIZE, word_buf, words) == 0);
+}
+
+static bool otp_image_write(struct otp_image_report *report)
+{
+    uint8_t i, c, next;
+    uint8_t base = 0;
+
+    for (i = 0; i < record_count; i++)
+    {
+        for (c = 0; c < records[i].cells; c = next)
+        {
+            next = c + 1;
+            if (!OTP_IMAGE_TO_WRITE(base + c))
+            {
+                continue;
+            }
+
+            // Program consecutive cells with a single call
+            while ((next < records[i].cells) && OTP_IMAGE_TO_WRITE(base + next))
+            {
+                next++;
+            }
+
+            if (!otp_image_write_run(&records[i], c, next - c))
+            {
+                return false;
+            }
+            report->written += next - c;
+        }
+        base += records[i].cells;
+    }
+
+    return true;
+}
+
+static void otp_image_verify(struct otp_image_report *report)
+{
+    uint8_t i, c;
+
+    for (i = 0; i < record_count; i++)
+    {
+        otp_read(MEMORY_OTP_BASE + records[i].offset, otp_buf, records[i].cells * OTP_IMAGE_CELL_SIZE);
+
+        for (c = 0; c < records[i].cells; c++)
+        {
+            if (memcmp(&otp_buf[c * OTP_IMAGE_CELL_SIZE], &records[i].data[c * OTP_IMAGE_CELL_SIZE], OTP_IMAGE_CELL_SIZE) != 0)
+            {
+                otp_image_fail(report, records[i].offset + c * OTP_IMAGE_CELL_SIZE);
+            }
+        }
+    }
+}
+
+void otp_image_program(const uint8_t *image, uint8_t len, struct otp_image_report *report)
+{
+    memset(report, 0, sizeof(struct otp_image_report));
+
+    report->status = otp_image_parse(image, len);
+    if (report->status != OTP_IMAGE_OK)
+    {
+        return;
+    }
+
+    otp_image_plan(report);
+    if (report->failed > 0)
+    {
+        report->status = OTP_IMAGE_CONFLICT;
+        return;
+    }
+
+    if (!otp_image_write(report))
+    {
+        report->status = OTP_IMAGE_WRITE_FAILED;
+    }
+
+    otp_image_verify(report);
+    if ((report->failed > 0) && (report->status == OTP_IMAGE_OK))
+    {
+        report->status = OTP_IMAGE_VERIFY_FAILED;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ ****************************************************************************************
+ *
+ * @file otp_image.h
+ *
+ * @brief Bulk OTP image programming header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef OTP_IMAGE_H_
+#define OTP_IMAGE_H_
+
+/*
+ * Image format, carried by the HCI_OTP_IMAGE_WRITE command (multi-byte fields little endian):
+ *
+ *   | record_count (1) | record ... | crc32 (4) |
+ *
+ *   record: | offset (2) | num_of_words (1) | words (4 * num_of_words) |
+ *
+ * offset is relative to the OTP start. The CRC is the IEEE 802.3 CRC-32 of all bytes
+ * before it. Records are programmed per OTP cell: 4 bytes on DA14531, 8 bytes on
+ * DA14585/586, so offset and length must be cell aligned.
+ *
+ * The image is programmed in three passes over the OTP:
+ *   1. Plan:   every cell is read. Cells that already hold the value are skipped, cells
+ *              that need a programmed bit to be cleared are conflicts. A single conflict
+ *              rejects the whole image before anything is written.
+ *   2. Write:  the remaining cells are programmed, one controller session per run of
+ *              consecutive cells.
+ *   3. Verify: every cell of the image is read back and compared.
+ *
+ * tools/otp_image.py builds images and sends them to the device.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#if defined (__DA14531__)
+#define OTP_IMAGE_CELL_SIZE         (4)
+#define OTP_IMAGE_OTP_SIZE          (0x8000)
+#else
+#define OTP_IMAGE_CELL_SIZE         (8)
+#define OTP_IMAGE_OTP_SIZE          (0x10000)
+#endif
+
+#define OTP_IMAGE_RECORD_HDR_LEN    (3)
+#define OTP_IMAGE_CRC_LEN           (4)
+
+// Maximum image size, bounded by the HCI command parameter length
+#define OTP_IMAGE_MAX_LEN           (255)
+
+// Maximum number of records in an image
+#define OTP_IMAGE_MAX_RECORDS       (16)
+
+// Maximum number of cells in an image
+#define OTP_IMAGE_MAX_CELLS         (64)
+
+// Number of failed cell offsets returned in the report
+#define OTP_IMAGE_MAX_REPORTED      (8)
+
+enum
+{
+    OTP_IMAGE_OK,
+    OTP_IMAGE_BAD_FORMAT,       // Truncated image, misaligned or overlapping records
+    OTP_IMAGE_BAD_CRC,
+    OTP_IMAGE_OUT_OF_RANGE,     // Record beyond the OTP end
+    OTP_IMAGE_CONFLICT,         // A cell cannot take the value, nothing was written
+    OTP_IMAGE_WRITE_FAILED,
+    OTP_IMAGE_VERIFY_FAILED
+};
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct otp_image_report
+{
+    uint8_t status;
+    uint8_t written;    // Cells programmed
+    uint8_t skipped;    // Cells that already held the value
+    uint8_t failed;     // Conflicting or mismatching cells
+    uint16_t failed_offset[OTP_IMAGE_MAX_REPORTED];
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Programs and verifies an OTP image.
+ *
+ * @param[in]  image    Image bytes.
+ * @param[in]  len      Image length.
+ * @param[out] report   Outcome of the operation.
+ ****************************************************************************************
+ */
+void otp_image_program(const uint8_t *image, uint8_t len, struct otp_image_report *report);
+
+#endif // OTP_IMAGE_H_
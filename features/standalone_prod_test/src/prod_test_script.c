@@ -0,0 +1,467 @@
+/**
+ ****************************************************************************************
+ *
+ * @file prod_test_script.c
+ *
+ * @brief Production test script engine source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "co_error.h"
+#include "hci.h"
+#include "ke_msg.h"
+#include "rwip.h"
+#include "ea.h"
+#include "llm.h"
+#include "lld.h"
+#include "reg_ble_em_cs.h"
+#include "gpio.h"
+#include "user_periph_setup.h"
+#include "system_library.h"
+#include "dialog_commands.h"
+#include "dialog_prod.h"
+#include "prod_test_script.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+// BLE time wraps at 27 bits
+#define SCRIPT_TIME_MASK            (0x07FFFFFF)
+
+#define SCRIPT_MS_TO_HS(ms)         (((uint32_t)(ms) * 16) / 5)
+#define SCRIPT_HS_TO_MS(hs)         (((uint32_t)(hs) * 5) / 16)
+
+// Time the input pull of a GPIO_CHECK settles before the pin is read (in half slots)
+#define SCRIPT_GPIO_SETTLE_HS       (2)
+
+#define SCRIPT_RD16(p)              ((uint16_t)((p)[0] | ((p)[1] << 8)))
+
+/*
+ * LOCAL VARIABLES
+ ****************************************************************************************
+ */
+
+// Parameter length of every opcode, OTP_VERIFY adds its data length
+static const uint8_t script_param_len[PROD_TEST_SCRIPT_OP_LAST] =
+{
+    [PROD_TEST_SCRIPT_OP_DELAY]      = 2,
+    [PROD_TEST_SCRIPT_OP_TX_TONE]    = 3,
+    [PROD_TEST_SCRIPT_OP_RX_TONE]    = 3,
+    [PROD_TEST_SCRIPT_OP_CONT_TX]    = 4,
+    [PROD_TEST_SCRIPT_OP_RX_PER]     = 5,
+    [PROD_TEST_SCRIPT_OP_VBAT]       = 5,
+    [PROD_TEST_SCRIPT_OP_GPIO_CHECK] = 3,
+    [PROD_TEST_SCRIPT_OP_GPIO_SET]   = 2,
+    [PROD_TEST_SCRIPT_OP_OTP_VERIFY] = 3,
+};
+
+static uint8_t script_buf[PROD_TEST_SCRIPT_MAX_LEN];
+static uint8_t script_steps;
+
+// Offset of the next step in script_buf and its index
+static uint8_t script_pos;
+static uint8_t script_step;
+
+// Step that waits for its deadline, NULL if none
+static const uint8_t *script_wait;
+static uint32_t script_deadline;
+static uint32_t script_start_time;
+static bool script_active;
+static bool script_stopped;
+
+static struct hci_script_run_dialog_cmd_cmp_evt script_result;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint32_t script_now(void)
+{
+    return (ea_time_get_halfslot_rounded() & SCRIPT_TIME_MASK);
+}
+
+static uint8_t script_step_len(const uint8_t *step)
+{
+    uint8_t len = PROD_TEST_SCRIPT_STEP_HDR_LEN + script_param_len[step[0]];
+
+    if (step[0] == PROD_TEST_SCRIPT_OP_OTP_VERIFY)
+    {
+        len += step[4];
+    }
+
+    return len;
+}
+
+static bool script_step_valid(const uint8_t *step, uint8_t avail)
+{
+    const uint8_t *p = &step[PROD_TEST_SCRIPT_STEP_HDR_LEN];
+
+    if ((avail < PROD_TEST_SCRIPT_STEP_HDR_LEN) || (step[0] == 0) || (step[0] >= PROD_TEST_SCRIPT_OP_LAST))
+    {
+        return false;
+    }
+
+    if ((avail < PROD_TEST_SCRIPT_STEP_HDR_LEN + script_param_len[step[0]]) || (avail < script_step_len(step)))
+    {
+        return false;
+    }
+
+    switch (step[0])
+    {
+        case PROD_TEST_SCRIPT_OP_TX_TONE:
+        case PROD_TEST_SCRIPT_OP_RX_TONE:
+        case PROD_TEST_SCRIPT_OP_RX_PER:
+            return (p[0] <= 39);
+        case PROD_TEST_SCRIPT_OP_CONT_TX:
+            return ((p[0] <= 39) && (p[1] <= 7));
+        case PROD_TEST_SCRIPT_OP_VBAT:
+            return (SCRIPT_RD16(&p[1]) <= SCRIPT_RD16(&p[3]));
+        case PROD_TEST_SCRIPT_OP_GPIO_CHECK:
+            return ((p[1] <= PROD_TEST_SCRIPT_PULL_DOWN) && (p[2] <= 1));
+        case PROD_TEST_SCRIPT_OP_GPIO_SET:
+            return (p[1] <= 1);
+        case PROD_TEST_SCRIPT_OP_OTP_VERIFY:
+            return ((p[2] > 0) && (p[2] <= PROD_TEST_SCRIPT_MAX_OTP_LEN));
+        default:
+            return true;
+    }
+}
+
+bool prod_test_script_validate(const uint8_t *script, uint8_t len, uint8_t *err_step)
+{
+    uint8_t pos = PROD_TEST_SCRIPT_HDR_LEN;
+    uint8_t i;
+
+    *err_step = 0xFF;
+
+    if ((len < PROD_TEST_SCRIPT_HDR_LEN) ||
+        (script[0] != PROD_TEST_SCRIPT_MAGIC) ||
+        (script[1] != PROD_TEST_SCRIPT_VERSION) ||
+        (script[2] == 0) || (script[2] > PROD_TEST_SCRIPT_MAX_STEPS))
+    {
+        return false;
+    }
+
+    for (i = 0; i < script[2]; i++)
+    {
+        if (!script_step_valid(&script[pos], len - pos))
+        {
+            *err_step = i;
+            return false;
+        }
+        pos += script_step_len(&script[pos]);
+    }
+
+    // Trailing bytes point to a wrong step count
+    return (pos == len);
+}
+
+static bool script_gpio(uint8_t gpio_pad, GPIO_PORT *port, GPIO_PIN *pin)
+{
+#if defined(__DA14531__)
+    *port = GPIO_PORT_0;
+    *pin = (GPIO_PIN) (gpio_pad);
+#else
+    *port = (GPIO_PORT) (gpio_pad / 10);
+    *pin = (GPIO_PIN) (gpio_pad % 10);
+#endif
+
+    if (!GPIO_is_valid(*port, *pin))
+    {
+        return false;
+    }
+
+    handle_jtag(*port, *pin);
+#if defined (__DA14531__)
+    handle_reset_state(*port, *pin);
+#endif
+
+    return true;
+}
+
+static void script_set_result(uint8_t status, uint16_t value)
+{
+    script_result.step[script_step].status = status;
+    script_result.step[script_step].value = value;
+
+    if (status == PROD_TEST_SCRIPT_STEP_FAIL)
+    {
+        if (script_result.failed == 0)
+        {
+            script_result.first_failed = script_step;
+        }
+        script_result.failed++;
+    }
+}
+
+static void script_wait_for(const uint8_t *step, uint32_t halfslots)
+{
+    script_wait = step;
+    script_deadline = (script_now() + halfslots) & SCRIPT_TIME_MASK;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Starts a step. Steps with a duration set script_wait and finish in
+ *        script_step_finish(), the others complete immediately.
+ ****************************************************************************************
+ */
+static void script_step_start(const uint8_t *step)
+{
+    const uint8_t *p = &step[PROD_TEST_SCRIPT_STEP_HDR_LEN];
+    GPIO_PORT port;
+    GPIO_PIN pin;
+
+    switch (step[0])
+    {
+        case PROD_TEST_SCRIPT_OP_DELAY:
+            script_wait_for(step, SCRIPT_MS_TO_HS(SCRIPT_RD16(&p[0])));
+            break;
+
+        case PROD_TEST_SCRIPT_OP_TX_TONE:
+        case PROD_TEST_SCRIPT_OP_RX_TONE:
+            dialog_commands_unmodulated((step[0] == PROD_TEST_SCRIPT_OP_TX_TONE) ?
+                                        UNMODULATED_CMD_MODE_TX : UNMODULATED_CMD_MODE_RX, p[0]);
+            script_wait_for(step, SCRIPT_MS_TO_HS(SCRIPT_RD16(&p[1])));
+            break;
+
+        case PROD_TEST_SCRIPT_OP_CONT_TX:
+            test_freq = p[0];
+            test_data_pattern = p[1];
+            set_state_start_continue_tx();
+            script_wait_for(step, SCRIPT_MS_TO_HS(SCRIPT_RD16(&p[2])));
+            break;
+
+        case PROD_TEST_SCRIPT_OP_RX_PER:
+            test_freq = p[0];
+            set_state_start_rx();
+            script_wait_for(step, SCRIPT_MS_TO_HS(SCRIPT_RD16(&p[1])));
+            break;
+
+        case PROD_TEST_SCRIPT_OP_VBAT:
+        {
+            uint16_t vbat = dialog_commands_vbat_sample(p[0]);
+
+            script_set_result(((vbat >= SCRIPT_RD16(&p[1])) && (vbat <= SCRIPT_RD16(&p[3]))) ?
+                              PROD_TEST_SCRIPT_STEP_PASS : PROD_TEST_SCRIPT_STEP_FAIL, vbat);
+        } break;
+
+        case PROD_TEST_SCRIPT_OP_GPIO_CHECK:
+            if (!script_gpio(p[0], &port, &pin))
+            {
+                script_set_result(PROD_TEST_SCRIPT_STEP_FAIL, 0xFFFF);
+                break;
+            }
+            GPIO_ConfigurePin(port, pin, (p[1] == PROD_TEST_SCRIPT_PULL_UP) ? INPUT_PULLUP :
+                                         (p[1] == PROD_TEST_SCRIPT_PULL_DOWN) ? INPUT_PULLDOWN : INPUT,
+                              PID_GPIO, false);
+            script_wait_for(step, SCRIPT_GPIO_SETTLE_HS);
+            break;
+
+        case PROD_TEST_SCRIPT_OP_GPIO_SET:
+            if (!script_gpio(p[0], &port, &pin))
+            {
+                script_set_result(PROD_TEST_SCRIPT_STEP_FAIL, 0xFFFF);
+                break;
+            }
+            GPIO_ConfigurePin(port, pin, OUTPUT, PID_GPIO, p[1] != 0);
+            script_set_result(PROD_TEST_SCRIPT_STEP_PASS, p[1]);
+            break;
+
+        case PROD_TEST_SCRIPT_OP_OTP_VERIFY:
+        {
+            uint8_t otp[PROD_TEST_SCRIPT_MAX_OTP_LEN];
+            uint16_t mismatch = 0;
+            uint8_t i;
+
+            otp_read(MEMORY_OTP_BASE + SCRIPT_RD16(&p[0]), otp, p[2]);
+            for (i = 0; i < p[2]; i++)
+            {
+                if (otp[i] != p[3 + i])
+                {
+                    mismatch++;
+                }
+            }
+            script_set_result((mismatch == 0) ? PROD_TEST_SCRIPT_STEP_PASS : PROD_TEST_SCRIPT_STEP_FAIL, mismatch);
+        } break;
+
+        default:
+            break;
+    }
+}
+
+static void script_step_finish(const uint8_t *step)
+{
+    const uint8_t *p = &step[PROD_TEST_SCRIPT_STEP_HDR_LEN];
+    GPIO_PORT port;
+    GPIO_PIN pin;
+
+    switch (step[0])
+    {
+        case PROD_TEST_SCRIPT_OP_TX_TONE:
+        case PROD_TEST_SCRIPT_OP_RX_TONE:
+            dialog_commands_unmodulated(UNMODULATED_CMD_MODE_OFF, p[0]);
+            script_set_result(PROD_TEST_SCRIPT_STEP_PASS, 0);
+            break;
+
+        case PROD_TEST_SCRIPT_OP_CONT_TX:
+            script_set_result(dialog_commands_tx_end_continue() ?
+                              PROD_TEST_SCRIPT_STEP_PASS : PROD_TEST_SCRIPT_STEP_FAIL, 0);
+            break;
+
+        case PROD_TEST_SCRIPT_OP_RX_PER:
+        {
+            uint16_t packets;
+
+            set_state_stop();
+            // Packets received with a correct CRC, the counter HCI_LE_TEST_END reports
+            packets = ble_rxccmpktcnt0_get(LLD_ADV_HDL);
+            script_set_result((packets >= SCRIPT_RD16(&p[3])) ?
+                              PROD_TEST_SCRIPT_STEP_PASS : PROD_TEST_SCRIPT_STEP_FAIL, packets);
+        } break;
+
+        case PROD_TEST_SCRIPT_OP_GPIO_CHECK:
+        {
+            uint8_t level;
+
+            script_gpio(p[0], &port, &pin);
+            level = GPIO_GetPinStatus(port, pin) ? 1 : 0;
+            script_set_result((level == p[2]) ? PROD_TEST_SCRIPT_STEP_PASS : PROD_TEST_SCRIPT_STEP_FAIL, level);
+        } break;
+
+        default:
+            script_set_result(PROD_TEST_SCRIPT_STEP_PASS, 0);
+            break;
+    }
+}
+
+static void script_complete(void)
+{
+    uint8_t i;
+    struct hci_script_run_dialog_cmd_cmp_evt *event = KE_MSG_ALLOC(HCI_CMD_CMP_EVENT, 0, HCI_SCRIPT_RUN_CMD_OPCODE,
+                                                                   hci_script_run_dialog_cmd_cmp_evt);
+
+    for (i = script_step; i < script_steps; i++)
+    {
+        script_result.step[i].status = PROD_TEST_SCRIPT_STEP_SKIPPED;
+        script_result.step[i].value = 0;
+    }
+
+    script_result.status = CO_ERROR_NO_ERROR;
+    script_result.duration_ms = SCRIPT_HS_TO_MS((script_now() - script_start_time) & SCRIPT_TIME_MASK);
+
+    memcpy(event, &script_result, sizeof(script_result));
+    hci_send_2_host(event);
+
+    script_active = false;
+}
+
+uint8_t prod_test_script_start(const uint8_t *script, uint8_t len)
+{
+    uint8_t err_step;
+
+    if (script_active || (test_state != STATE_IDLE))
+    {
+        return CO_ERROR_COMMAND_DISALLOWED;
+    }
+
+    if (!prod_test_script_validate(script, len, &err_step))
+    {
+        return CO_ERROR_INVALID_HCI_PARAM;
+    }
+
+    memcpy(script_buf, script, len);
+    memset(&script_result, 0, sizeof(script_result));
+    script_steps = script[2];
+    script_result.steps = script_steps;
+    script_result.first_failed = 0xFF;
+
+    script_pos = PROD_TEST_SCRIPT_HDR_LEN;
+    script_step = 0;
+    script_wait = NULL;
+    script_stopped = false;
+    script_start_time = script_now();
+    script_active = true;
+
+    return CO_ERROR_NO_ERROR;
+}
+
+void prod_test_script_process(void)
+{
+    const uint8_t *step;
+
+    if (!script_active)
+    {
+        return;
+    }
+
+    if (script_wait != NULL)
+    {
+        // Deadline not reached yet
+        if (((script_now() - script_deadline) & SCRIPT_TIME_MASK) > (SCRIPT_TIME_MASK >> 1))
+        {
+            return;
+        }
+
+        step = script_wait;
+        script_wait = NULL;
+        script_step_finish(step);
+        script_stopped = (script_result.step[script_step].status == PROD_TEST_SCRIPT_STEP_FAIL) &&
+                         (step[1] & PROD_TEST_SCRIPT_FLAG_STOP_ON_FAIL);
+        script_step++;
+    }
+
+    // Run the immediate steps up to the next one that takes time
+    while (!script_stopped && (script_step < script_steps))
+    {
+        step = &script_buf[script_pos];
+        script_pos += script_step_len(step);
+
+        script_step_start(step);
+        if (script_wait != NULL)
+        {
+            return;
+        }
+
+        script_stopped = (script_result.step[script_step].status == PROD_TEST_SCRIPT_STEP_FAIL) &&
+                         (step[1] & PROD_TEST_SCRIPT_FLAG_STOP_ON_FAIL);
+        script_step++;
+    }
+
+    script_complete();
+}
+
+bool prod_test_script_running(void)
+{
+    return script_active;
+}
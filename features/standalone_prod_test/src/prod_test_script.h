@@ -0,0 +1,167 @@
+/**
+ ****************************************************************************************
+ *
+ * @file prod_test_script.h
+ *
+ * @brief Production test script engine header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef PROD_TEST_SCRIPT_H_
+#define PROD_TEST_SCRIPT_H_
+
+/*
+ * Script format, carried by the HCI_SCRIPT_RUN command (multi-byte fields little endian):
+ *
+ *   | magic (1) | version (1) | step_count (1) | step ... |
+ *
+ * Every step starts with | opcode (1) | flags (1) | followed by the opcode parameters:
+ *
+ *   DELAY       duration_ms (2)
+ *   TX_TONE     channel (1), duration_ms (2)               unmodulated TX
+ *   RX_TONE     channel (1), duration_ms (2)               unmodulated RX
+ *   CONT_TX     channel (1), payload_type (1), duration_ms (2)
+ *   RX_PER      channel (1), duration_ms (2), min_packets (2)  packets with a correct CRC
+ *   VBAT        vbat_type (1), min (2), max (2)            ADC sample within [min, max]
+ *   GPIO_CHECK  gpio_pad (1), pull (1), level (1)
+ *   GPIO_SET    gpio_pad (1), level (1)
+ *   OTP_VERIFY  address (2), length (1), data (length)
+ *
+ * gpio_pad is encoded as in HCI_GPIO_READ. The engine runs the steps from the main loop
+ * and answers with one command complete event holding a status and a measured value per
+ * step, see struct hci_script_run_dialog_cmd_cmp_evt. A rejected script is answered right
+ * away with the error status and no steps.
+ *
+ * tools/prod_test_script.py compiles and validates scripts on the host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+#define PROD_TEST_SCRIPT_MAGIC          (0x50)
+#define PROD_TEST_SCRIPT_VERSION        (0x01)
+
+// Header and step header sizes
+#define PROD_TEST_SCRIPT_HDR_LEN        (3)
+#define PROD_TEST_SCRIPT_STEP_HDR_LEN   (2)
+
+// Maximum script size, bounded by the HCI command parameter length
+#define PROD_TEST_SCRIPT_MAX_LEN        (255)
+
+// Maximum number of steps in a script
+#define PROD_TEST_SCRIPT_MAX_STEPS      (32)
+
+// Maximum number of bytes compared by one OTP_VERIFY step
+#define PROD_TEST_SCRIPT_MAX_OTP_LEN    (32)
+
+// Step flags
+#define PROD_TEST_SCRIPT_FLAG_STOP_ON_FAIL  (0x01)  // Skip the remaining steps if this one fails
+
+enum
+{
+    PROD_TEST_SCRIPT_OP_DELAY = 0x01,
+    PROD_TEST_SCRIPT_OP_TX_TONE,
+    PROD_TEST_SCRIPT_OP_RX_TONE,
+    PROD_TEST_SCRIPT_OP_CONT_TX,
+    PROD_TEST_SCRIPT_OP_RX_PER,
+    PROD_TEST_SCRIPT_OP_VBAT,
+    PROD_TEST_SCRIPT_OP_GPIO_CHECK,
+    PROD_TEST_SCRIPT_OP_GPIO_SET,
+    PROD_TEST_SCRIPT_OP_OTP_VERIFY,
+    PROD_TEST_SCRIPT_OP_LAST
+};
+
+// GPIO_CHECK pull configuration
+enum
+{
+    PROD_TEST_SCRIPT_PULL_NONE,
+    PROD_TEST_SCRIPT_PULL_UP,
+    PROD_TEST_SCRIPT_PULL_DOWN
+};
+
+// Step result
+enum
+{
+    PROD_TEST_SCRIPT_STEP_PASS,
+    PROD_TEST_SCRIPT_STEP_FAIL,
+    PROD_TEST_SCRIPT_STEP_SKIPPED
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Checks the structure and the parameter ranges of a script.
+ *
+ * @param[in]  script   Script bytes.
+ * @param[in]  len      Script length.
+ * @param[out] err_step Index of the first invalid step, 0xFF for a header error.
+ *
+ * @return True if the script is valid.
+ ****************************************************************************************
+ */
+bool prod_test_script_validate(const uint8_t *script, uint8_t len, uint8_t *err_step);
+
+/**
+ ****************************************************************************************
+ * @brief Validates a script and starts its execution.
+ *
+ * @param[in] script    Script bytes, copied by the engine.
+ * @param[in] len       Script length.
+ *
+ * @return HCI status, CO_ERROR_NO_ERROR if the script was started.
+ ****************************************************************************************
+ */
+uint8_t prod_test_script_start(const uint8_t *script, uint8_t len);
+
+/**
+ ****************************************************************************************
+ * @brief Runs the script steps that are due. Called from the main loop.
+ ****************************************************************************************
+ */
+void prod_test_script_process(void);
+
+/**
+ ****************************************************************************************
+ * @brief Tells whether a script is running.
+ *
+ * @return True if a script is running.
+ ****************************************************************************************
+ */
+bool prod_test_script_running(void);
+
+#endif // PROD_TEST_SCRIPT_H_
@@ -22,6 +22,7 @@
 #include "hci.h"
 #include "system_library.h"
 #include "mainloop_callbacks.h"
+#include "prod_test_script.h"
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -43,6 +44,8 @@ arch_main_loop_callback_ret_t app_on_ble_powered(void)
     arch_main_loop_callback_ret_t ret = GOTO_SLEEP;
     static int cnt2sleep=100;
 
+    prod_test_script_process();
+
     do {
         if(test_state == STATE_START_TX)
         {
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: otp_image.py
+#
+# @brief    :: Builds OTP images for the HCI_OTP_IMAGE_WRITE command (0xFE20) of the
+#              standalone_prod_test firmware and programs them on a DUT.
+#
+#              An image source is a text file with one record per line, '#' starts a
+#              comment. A record is an OTP offset followed by the data in hex:
+#                  0x7F00  0011223344556677
+#                  0x7FC0  C0FFEE00DEADBEEF
+#              Offsets and lengths must be multiples of the OTP cell size (4 bytes on
+#              DA14531, 8 bytes on DA14585/586).
+#
+#                  python3 otp_image.py build   --chip 531 image.txt image.bin
+#                  python3 otp_image.py program --chip 531 image.txt /dev/ttyUSB0
+#
+#              The binary format is described in src/otp_image.h.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import tty
+import zlib
+
+MAX_LEN = 255
+MAX_RECORDS = 16
+MAX_CELLS = 64
+MAX_REPORTED = 8
+
+# chip: (cell size, OTP size)
+CHIPS = {'531': (4, 0x8000), '585': (8, 0x10000)}
+
+HCI_OTP_IMAGE_WRITE_CMD_OPCODE = 0xFE20
+HCI_CMD_CMP_EVT = 0x0E
+
+STATUS = ['ok', 'bad format', 'bad crc', 'out of range', 'conflict, nothing written',
+          'write failed', 'verify failed']
+
+
+class ImageError(Exception):
+    pass
+
+
+def build_image(text, chip):
+    cell, size = CHIPS[chip]
+    records = []
+    for lineno, line in enumerate(text.splitlines(), 1):
+        words = line.split('#', 1)[0].split()
+        if not words:
+            continue
+        if len(words) != 2:
+            raise ImageError('line %d: expected "offset data"' % lineno)
+        try:
+            offset = int(words[0], 0)
+            data = bytes.fromhex(words[1])
+        except ValueError:
+            raise ImageError('line %d: bad offset or data' % lineno)
+        if offset % cell or len(data) % cell or not data:
+            raise ImageError('line %d: offset and length must be multiples of %d bytes' % (lineno, cell))
+        if offset + len(data) > size:
+            raise ImageError('line %d: record ends beyond the OTP (0x%X)' % (lineno, size))
+        if len(data) // 4 > 0xFF:
+            raise ImageError('line %d: record too long' % lineno)
+        for other, odata in records:
+            if offset < other + len(odata) and other < offset + len(data):
+                raise ImageError('line %d: overlaps record at 0x%04X' % (lineno, other))
+        records.append((offset, data))
+
+    if not records:
+        raise ImageError('empty image')
+    if len(records) > MAX_RECORDS:
+        raise ImageError('%d records, at most %d fit' % (len(records), MAX_RECORDS))
+    cells = sum(len(d) for _, d in records) // cell
+    if cells > MAX_CELLS:
+        raise ImageError('%d cells, at most %d fit' % (cells, MAX_CELLS))
+
+    blob = struct.pack('<B', len(records))
+    for offset, data in records:
+        blob += struct.pack('<HB', offset, len(data) // 4) + data
+    blob += struct.pack('<I', zlib.crc32(blob) & 0xFFFFFFFF)
+    if len(blob) > MAX_LEN:
+        raise ImageError('%d bytes, at most %d fit in one HCI command' % (len(blob), MAX_LEN))
+    return cells, blob
+
+
+def open_port(path, baudrate):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, 'B%d' % baudrate)
+    attrs[4] = attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def read_exact(fd, n, timeout):
+    data = b''
+    while len(data) < n:
+        ready, _, _ = select.select([fd], [], [], timeout)
+        if not ready:
+            raise ImageError('timeout waiting for the DUT')
+        data += os.read(fd, n - len(data))
+    return data
+
+
+def program_image(fd, blob, timeout):
+    os.write(fd, struct.pack('<BHB', 0x01, HCI_OTP_IMAGE_WRITE_CMD_OPCODE, len(blob)) + blob)
+    while True:
+        while read_exact(fd, 1, timeout) != b'\x04':
+            pass
+        code, length = struct.unpack('<BB', read_exact(fd, 2, timeout))
+        params = read_exact(fd, length, timeout)
+        if code == HCI_CMD_CMP_EVT and struct.unpack('<H', params[1:3])[0] == HCI_OTP_IMAGE_WRITE_CMD_OPCODE:
+            return params[3:]
+
+
+def print_report(report):
+    status, written, skipped, failed = struct.unpack('<BBBB', report[:4])
+    offsets = struct.unpack('<%dH' % MAX_REPORTED, report[4:4 + 2 * MAX_REPORTED])
+    name = STATUS[status] if status < len(STATUS) else '0x%02X' % status
+    print('%s: %d cells written, %d already programmed, %d failed' % (name, written, skipped, failed))
+    for offset in offsets[:min(failed, MAX_REPORTED)]:
+        print('  cell 0x%04X' % offset)
+    return status == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='OTP image builder for standalone_prod_test.')
+    sub = parser.add_subparsers(dest='cmd')
+    p = sub.add_parser('build', help='build the binary image')
+    p.add_argument('source')
+    p.add_argument('output')
+    p = sub.add_parser('program', help='program and verify the image on a DUT in HCI mode')
+    p.add_argument('source')
+    p.add_argument('port')
+    p.add_argument('-b', '--baudrate', type=int, default=115200, help='serial baud rate (default 115200)')
+    p.add_argument('-t', '--timeout', type=float, default=10.0, help='seconds to wait for the report')
+    for p in sub.choices.values():
+        p.add_argument('-c', '--chip', choices=sorted(CHIPS), default='531', help='target device (default 531)')
+    args = parser.parse_args()
+    if args.cmd is None:
+        parser.error('missing command')
+
+    try:
+        with open(args.source) as f:
+            cells, blob = build_image(f.read(), args.chip)
+        sys.stderr.write('%d cells, %d bytes\n' % (cells, len(blob)))
+        if args.cmd == 'build':
+            with open(args.output, 'wb') as f:
+                f.write(blob)
+        else:
+            fd = open_port(args.port, args.baudrate)
+            try:
+                ok = print_report(program_image(fd, blob, args.timeout))
+            finally:
+                os.close(fd)
+            sys.exit(0 if ok else 1)
+    except ImageError as e:
+        sys.stderr.write('error: %s\n' % e)
+        sys.exit(2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,286 @@
+/**
+ ****************************************************************************************
+ *
+ * @file otp_image_test.c
+ *
+ * @brief Host test of the OTP image programming.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs otp_image.c against a simulated OTP, for the DA14531 and the DA14585/586 cell sizes:
+ *
+ *     gcc -O2 -D__DA14531__ -I../../helpers/host_stub -Isrc -o otp_image_test tools/otp_image_test.c src/otp_image.c
+ *     gcc -O2 -I../../helpers/host_stub -Isrc -o otp_image_test_585 tools/otp_image_test.c src/otp_image.c
+ *     ./otp_image_test [image.bin]
+ *
+ * The simulated OTP only sets bits, as the real one. The checks cover a fresh image, the
+ * same image again, a conflicting cell, a bad CRC, a partly programmed image, a failing
+ * write, overlapping, out of range and misaligned records and random images with a valid
+ * CRC. An image built by otp_image.py can be given as argument, it is programmed in a
+ * blank OTP and the report is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dialog_prod.h"
+#include "otp_image.h"
+
+#define CELL_WORDS              (OTP_IMAGE_CELL_SIZE / 4)
+
+static uint8_t otp[OTP_IMAGE_OTP_SIZE];
+static uint32_t write_calls;
+static int32_t fail_at = -1;
+
+void otp_read(uint32_t otp_pos, uint8_t *val, uint8_t len)
+{
+    if ((otp_pos < MEMORY_OTP_BASE) || (otp_pos - MEMORY_OTP_BASE + len > OTP_IMAGE_OTP_SIZE))
+    {
+        printf("otp_read out of range 0x%08X\n", otp_pos);
+        exit(1);
+    }
+    memcpy(val, &otp[otp_pos - MEMORY_OTP_BASE], len);
+}
+
+int otp_write_words(uint32_t otp_pos, uint32_t *val_addr, uint8_t words_count)
+{
+    uint8_t i, b;
+
+    write_calls++;
+    if ((otp_pos % OTP_IMAGE_CELL_SIZE) || (otp_pos + 4 * words_count > OTP_IMAGE_OTP_SIZE))
+    {
+        printf("otp_write_words out of range 0x%04X\n", otp_pos);
+        exit(1);
+    }
+    for (i = 0; i < words_count; i++)
+    {
+        if (fail_at == (int32_t)(otp_pos + 4 * i))
+        {
+            return -1;
+        }
+        // Programming only sets bits
+        for (b = 0; b < 4; b++)
+        {
+            otp[otp_pos + 4 * i + b] |= (uint8_t)(val_addr[i] >> (8 * b));
+        }
+    }
+    return 0;
+}
+
+static uint32_t crc32(const uint8_t *data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t i, k;
+
+    for (i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (k = 0; k < 8; k++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+/// Builds an image of records of cells, the data of record r is data[r]
+static uint8_t build(uint8_t *image, uint8_t records, const uint16_t *offset, const uint8_t *cells,
+                     uint8_t data[][64])
+{
+    uint32_t pos = 1;
+    uint32_t crc;
+    uint8_t r;
+
+    image[0] = records;
+    for (r = 0; r < records; r++)
+    {
+        image[pos++] = (uint8_t)offset[r];
+        image[pos++] = (uint8_t)(offset[r] >> 8);
+        image[pos++] = cells[r] * CELL_WORDS;
+        memcpy(&image[pos], data[r], cells[r] * OTP_IMAGE_CELL_SIZE);
+        pos += cells[r] * OTP_IMAGE_CELL_SIZE;
+    }
+    crc = crc32(image, pos);
+    memcpy(&image[pos], &crc, sizeof(crc));
+    return (uint8_t)(pos + sizeof(crc));
+}
+
+static void show(const char *name, const struct otp_image_report *report)
+{
+    uint8_t i;
+
+    printf("%-18s status %u written %2u skipped %2u failed %u writes %u", name, report->status,
+           report->written, report->skipped, report->failed, write_calls);
+    for (i = 0; (i < report->failed) && (i < OTP_IMAGE_MAX_REPORTED); i++)
+    {
+        printf(" 0x%04X", report->failed_offset[i]);
+    }
+    printf("\n");
+}
+
+#define CHECK(cond) do { if (!(cond)) { printf("check failed, line %d: %s\n", __LINE__, #cond); fails++; } } while (0)
+
+int main(int argc, char **argv)
+{
+    static uint8_t data[3][64];
+    const uint16_t offset[3] = {0x7F00, 0x7F40, 0x0100};
+    const uint8_t cells[3] = {24 / OTP_IMAGE_CELL_SIZE, 32 / OTP_IMAGE_CELL_SIZE, 8 / OTP_IMAGE_CELL_SIZE};
+    uint8_t image[OTP_IMAGE_MAX_LEN];
+    uint8_t saved[OTP_IMAGE_OTP_SIZE];
+    struct otp_image_report report;
+    uint32_t total = cells[0] + cells[1] + cells[2];
+    uint32_t fails = 0;
+    uint32_t i, j;
+    uint8_t len;
+
+    if (argc > 1)
+    {
+        FILE *f = fopen(argv[1], "rb");
+
+        if (f == NULL)
+        {
+            perror(argv[1]);
+            return 2;
+        }
+        len = (uint8_t)fread(image, 1, sizeof(image), f);
+        fclose(f);
+        otp_image_program(image, len, &report);
+        show(argv[1], &report);
+        return (report.status == OTP_IMAGE_OK) ? 0 : 1;
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        data[0][i] = (uint8_t)(i + 1);
+        data[1][i] = (uint8_t)(0xA0 + i);
+        data[2][i] = 0x55;
+    }
+
+    // Blank OTP, every cell is written and verified
+    len = build(image, 3, offset, cells, data);
+    otp_image_program(image, len, &report);
+    show("fresh", &report);
+    CHECK(report.status == OTP_IMAGE_OK);
+    CHECK((report.written == total) && (report.skipped == 0) && (report.failed == 0));
+    CHECK(memcmp(&otp[0x7F40], data[1], cells[1] * OTP_IMAGE_CELL_SIZE) == 0);
+    // One write per run of consecutive cells
+    CHECK(write_calls == 3);
+
+    // Programming the same image again writes nothing
+    write_calls = 0;
+    otp_image_program(image, len, &report);
+    show("again", &report);
+    CHECK((report.status == OTP_IMAGE_OK) && (report.written == 0) && (report.skipped == total));
+    CHECK(write_calls == 0);
+
+    // A programmed cell holding another value rejects the whole image before any write
+    write_calls = 0;
+    memcpy(saved, otp, sizeof(otp));
+    data[1][5] ^= 0x01;
+    len = build(image, 3, offset, cells, data);
+    otp_image_program(image, len, &report);
+    show("conflict", &report);
+    CHECK(report.status == OTP_IMAGE_CONFLICT);
+    CHECK((report.failed == 1) && (report.failed_offset[0] == 0x7F40 + 5 / OTP_IMAGE_CELL_SIZE * OTP_IMAGE_CELL_SIZE));
+    CHECK((write_calls == 0) && (memcmp(saved, otp, sizeof(otp)) == 0));
+    data[1][5] ^= 0x01;
+
+    // A corrupted image is rejected
+    write_calls = 0;
+    len = build(image, 3, offset, cells, data);
+    image[10] ^= 1;
+    otp_image_program(image, len, &report);
+    show("bad crc", &report);
+    CHECK((report.status == OTP_IMAGE_BAD_CRC) && (write_calls == 0));
+
+    // Cells that already hold their value are skipped
+    write_calls = 0;
+    memset(otp, 0, sizeof(otp));
+    memcpy(&otp[0x7F00 + OTP_IMAGE_CELL_SIZE], &data[0][OTP_IMAGE_CELL_SIZE], OTP_IMAGE_CELL_SIZE);
+    len = build(image, 3, offset, cells, data);
+    otp_image_program(image, len, &report);
+    show("one cell written", &report);
+    CHECK((report.status == OTP_IMAGE_OK) && (report.written == total - 1) && (report.skipped == 1));
+    // The skipped cell splits the first record in two writes
+    CHECK(write_calls == 4);
+
+    // A failing write stops at the failed cell and reports it
+    memset(otp, 0, sizeof(otp));
+    fail_at = 0x7F48;
+    otp_image_program(image, len, &report);
+    show("write failure", &report);
+    CHECK(report.status == OTP_IMAGE_WRITE_FAILED);
+    CHECK((report.failed > 0) && (report.failed_offset[0] == 0x7F48));
+    fail_at = -1;
+
+    // Format errors
+    {
+        const uint16_t overlap[2] = {0x0100, 0x0100 + OTP_IMAGE_CELL_SIZE};
+        const uint8_t two[2] = {2, 2};
+        const uint16_t end[1] = {OTP_IMAGE_OTP_SIZE - OTP_IMAGE_CELL_SIZE};
+        const uint16_t misaligned[1] = {0x0102};
+
+        write_calls = 0;
+        len = build(image, 2, overlap, two, data);
+        otp_image_program(image, len, &report);
+        show("overlap", &report);
+        CHECK(report.status == OTP_IMAGE_BAD_FORMAT);
+
+        len = build(image, 1, end, two, data);
+        otp_image_program(image, len, &report);
+        show("out of range", &report);
+        CHECK(report.status == OTP_IMAGE_OUT_OF_RANGE);
+
+        len = build(image, 1, misaligned, two, data);
+        otp_image_program(image, len, &report);
+        show("misaligned", &report);
+        CHECK(report.status == OTP_IMAGE_BAD_FORMAT);
+        CHECK(write_calls == 0);
+    }
+
+    // Random images with a valid CRC must not write outside their records or crash
+    srand(3);
+    for (i = 0; i < 300000; i++)
+    {
+        uint32_t l = rand() % (OTP_IMAGE_MAX_LEN + 1);
+
+        for (j = 0; j < l; j++)
+        {
+            image[j] = (uint8_t)rand();
+        }
+        if (l > OTP_IMAGE_CRC_LEN)
+        {
+            uint32_t crc = crc32(image, l - OTP_IMAGE_CRC_LEN);
+
+            memcpy(&image[l - OTP_IMAGE_CRC_LEN], &crc, sizeof(crc));
+        }
+        memset(&report, 0xA5, sizeof(report));
+        otp_image_program(image, (uint8_t)l, &report);
+        CHECK(report.status <= OTP_IMAGE_VERIFY_FAILED);
+    }
+
+    printf("%s\n", fails ? "FAILED" : "OK");
+
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: prod_test_script.py
+#
+# @brief    :: Compiles, validates and runs production test scripts for the HCI_SCRIPT_RUN
+#              command (0xFE1F) of the standalone_prod_test firmware.
+#
+#              A script is a text file with one step per line, '#' starts a comment:
+#                  tx_tone     ch=19 ms=500
+#                  rx_per      ch=19 ms=1000 min=900 stop
+#                  vbat        type=0 min=600 max=900
+#                  gpio_check  pad=5 pull=up level=1
+#                  gpio_set    pad=9 level=0
+#                  otp_verify  addr=0x7F40 data=0011223344
+#              "stop" skips the remaining steps when the step fails.
+#
+#                  python3 prod_test_script.py check plan.txt
+#                  python3 prod_test_script.py compile plan.txt plan.bin
+#                  python3 prod_test_script.py run plan.txt /dev/ttyUSB0
+#
+#              The binary format is described in src/prod_test_script.h.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import tty
+
+MAGIC = 0x50
+VERSION = 0x01
+MAX_LEN = 255
+MAX_STEPS = 32
+MAX_OTP_LEN = 32
+FLAG_STOP_ON_FAIL = 0x01
+
+HCI_SCRIPT_RUN_CMD_OPCODE = 0xFE1F
+HCI_CMD_CMP_EVT = 0x0E
+
+PULL = {'none': 0, 'up': 1, 'down': 2}
+RESULT = {0: 'pass', 1: 'FAIL', 2: 'skipped'}
+
+# name: (opcode, [(parameter, struct format, minimum, maximum)], HCI commands it replaces)
+STEPS = {
+    'delay':      (0x01, [('ms', 'H', 0, 0xFFFF)], 0),
+    'tx_tone':    (0x02, [('ch', 'B', 0, 39), ('ms', 'H', 0, 0xFFFF)], 2),
+    'rx_tone':    (0x03, [('ch', 'B', 0, 39), ('ms', 'H', 0, 0xFFFF)], 2),
+    'cont_tx':    (0x04, [('ch', 'B', 0, 39), ('payload', 'B', 0, 7), ('ms', 'H', 0, 0xFFFF)], 2),
+    'rx_per':     (0x05, [('ch', 'B', 0, 39), ('ms', 'H', 0, 0xFFFF), ('min', 'H', 0, 0xFFFF)], 2),
+    'vbat':       (0x06, [('type', 'B', 0, 1), ('min', 'H', 0, 0xFFFF), ('max', 'H', 0, 0xFFFF)], 1),
+    'gpio_check': (0x07, [('pad', 'B', 0, 0xFF), ('pull', 'B', 0, 2), ('level', 'B', 0, 1)], 2),
+    'gpio_set':   (0x08, [('pad', 'B', 0, 0xFF), ('level', 'B', 0, 1)], 1),
+    'otp_verify': (0x09, [('addr', 'H', 0, 0xFFFF)], 1),
+}
+
+
+class ScriptError(Exception):
+    pass
+
+
+def parse_value(key, text):
+    if key == 'pull' and text in PULL:
+        return PULL[text]
+    return int(text, 0)
+
+
+def compile_step(lineno, words):
+    name = words[0].lower()
+    if name not in STEPS:
+        raise ScriptError('line %d: unknown step "%s"' % (lineno, name))
+    opcode, params, _ = STEPS[name]
+    flags = 0
+    args = {}
+    for word in words[1:]:
+        if word == 'stop':
+            flags |= FLAG_STOP_ON_FAIL
+            continue
+        if '=' not in word:
+            raise ScriptError('line %d: expected key=value, got "%s"' % (lineno, word))
+        key, text = word.split('=', 1)
+        try:
+            args[key] = text if key == 'data' else parse_value(key, text)
+        except ValueError:
+            raise ScriptError('line %d: bad value "%s"' % (lineno, word))
+
+    out = struct.pack('<BB', opcode, flags)
+    values = {}
+    for key, fmt, lo, hi in params:
+        if key not in args:
+            raise ScriptError('line %d: %s needs %s=' % (lineno, name, key))
+        values[key] = args.pop(key)
+        if not lo <= values[key] <= hi:
+            raise ScriptError('line %d: %s=%d out of range [%d, %d]' % (lineno, key, values[key], lo, hi))
+        out += struct.pack('<' + fmt, values[key])
+
+    if name == 'vbat' and values['min'] > values['max']:
+        raise ScriptError('line %d: min above max' % lineno)
+    if name == 'otp_verify':
+        try:
+            data = bytes.fromhex(args.pop('data', ''))
+        except ValueError:
+            raise ScriptError('line %d: data is not hex' % lineno)
+        if not 0 < len(data) <= MAX_OTP_LEN:
+            raise ScriptError('line %d: data must be 1 to %d bytes' % (lineno, MAX_OTP_LEN))
+        out += struct.pack('<B', len(data)) + data
+    if args:
+        raise ScriptError('line %d: unknown parameter(s) %s' % (lineno, ', '.join(sorted(args))))
+    return name, out
+
+
+def compile_script(text):
+    steps = []
+    for lineno, line in enumerate(text.splitlines(), 1):
+        words = line.split('#', 1)[0].split()
+        if words:
+            steps.append(compile_step(lineno, words))
+    if not steps:
+        raise ScriptError('empty script')
+    if len(steps) > MAX_STEPS:
+        raise ScriptError('%d steps, at most %d fit' % (len(steps), MAX_STEPS))
+    blob = struct.pack('<BBB', MAGIC, VERSION, len(steps)) + b''.join(s[1] for s in steps)
+    if len(blob) > MAX_LEN:
+        raise ScriptError('%d bytes, at most %d fit in one HCI command' % (len(blob), MAX_LEN))
+    return [s[0] for s in steps], blob
+
+
+def round_trips(names):
+    '''Number of single HCI commands the script replaces.'''
+    return sum(STEPS[n][2] for n in names)
+
+
+def open_port(path, baudrate):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, 'B%d' % baudrate)
+    attrs[4] = attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def read_exact(fd, n, timeout):
+    data = b''
+    while len(data) < n:
+        ready, _, _ = select.select([fd], [], [], timeout)
+        if not ready:
+            raise ScriptError('timeout waiting for the DUT')
+        data += os.read(fd, n - len(data))
+    return data
+
+
+def read_event(fd, timeout):
+    while read_exact(fd, 1, timeout) != b'\x04':
+        pass
+    code, length = struct.unpack('<BB', read_exact(fd, 2, timeout))
+    return code, read_exact(fd, length, timeout)
+
+
+def run_script(fd, names, blob, timeout):
+    os.write(fd, struct.pack('<BHB', 0x01, HCI_SCRIPT_RUN_CMD_OPCODE, len(blob)) + blob)
+    while True:
+        code, params = read_event(fd, timeout)
+        if code == HCI_CMD_CMP_EVT and struct.unpack('<H', params[1:3])[0] == HCI_SCRIPT_RUN_CMD_OPCODE:
+            if params[3] != 0:
+                raise ScriptError('script rejected, status 0x%02X' % params[3])
+            return params[3:]
+
+
+def print_result(names, record):
+    status, steps, failed, first_failed, duration = struct.unpack('<BBBBI', record[:8])
+    print('status 0x%02X, %d steps, %d failed, %d ms' % (status, steps, failed, duration))
+    for i in range(steps):
+        result, value = struct.unpack('<BH', record[8 + i * 3:11 + i * 3])
+        name = names[i] if i < len(names) else '?'
+        print('  %2d %-10s %-7s %d' % (i, name, RESULT.get(result, '?'), value))
+    return failed == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Production test script compiler for standalone_prod_test.')
+    sub = parser.add_subparsers(dest='cmd')
+    p = sub.add_parser('check', help='validate a script')
+    p.add_argument('script')
+    p = sub.add_parser('compile', help='compile a script to its binary form')
+    p.add_argument('script')
+    p.add_argument('output')
+    p = sub.add_parser('run', help='run a script on a DUT in HCI mode')
+    p.add_argument('script')
+    p.add_argument('port')
+    p.add_argument('-b', '--baudrate', type=int, default=115200, help='serial baud rate (default 115200)')
+    p.add_argument('-t', '--timeout', type=float, default=30.0, help='seconds to wait for the result')
+    args = parser.parse_args()
+    if args.cmd is None:
+        parser.error('missing command')
+
+    try:
+        with open(args.script) as f:
+            names, blob = compile_script(f.read())
+        sys.stderr.write('%d steps, %d bytes, replaces %d HCI round trips with 1\n'
+                         % (len(names), len(blob), round_trips(names)))
+        if args.cmd == 'compile':
+            with open(args.output, 'wb') as f:
+                f.write(blob)
+        elif args.cmd == 'run':
+            fd = open_port(args.port, args.baudrate)
+            try:
+                ok = print_result(names, run_script(fd, names, blob, args.timeout))
+            finally:
+                os.close(fd)
+            sys.exit(0 if ok else 1)
+    except ScriptError as e:
+        sys.stderr.write('error: %s\n' % e)
+        sys.exit(2)
+
+
+if __name__ == '__main__':
+    main()
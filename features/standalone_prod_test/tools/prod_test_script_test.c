@@ -0,0 +1,386 @@
+/**
+ ****************************************************************************************
+ *
+ * @file prod_test_script_test.c
+ *
+ * @brief Host test of the production test script engine.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs prod_test_script.c against a simulated DUT:
+ *
+ *     gcc -O2 -D__DA14531__ -I../../helpers/host_stub -Isrc -o prod_test_script_test \
+ *         tools/prod_test_script_test.c src/prod_test_script.c
+ *     ./prod_test_script_test [script.bin]
+ *
+ * The BLE time starts just before its wrap and advances in random steps between the calls of
+ * prod_test_script_process(). The RX test counts a fixed number of packets per second, pad 4
+ * is tied high, pad 8 drives pad 9 and the OTP byte at offset a reads (7 * a + 3). The checks
+ * cover a passing script, a failing step with "stop", the rejections of the engine, all the
+ * truncations of a valid script and random scripts, every started script must be answered
+ * with exactly one Command Complete event. A script compiled by prod_test_script.py can be
+ * given as argument, its result record is then printed in the format run_script() reads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dialog_prod.h"
+#include "dialog_commands.h"
+#include "prod_test_script.h"
+
+#define HS_PER_S                (3200)
+#define RX_PACKETS_PER_S        (950)
+#define VBAT_MV                 (750)
+#define PADS                    (12)
+
+volatile uint8_t test_state;
+volatile uint8_t test_freq;
+volatile uint8_t test_data_pattern;
+
+static uint64_t now_hs;
+static uint64_t rx_start_hs;
+static uint16_t rx_packets;
+static uint32_t rx_reads_running;
+static uint8_t pad_mode[PADS];
+static bool pad_out[PADS];
+
+static struct hci_script_run_dialog_cmd_cmp_evt event_buf;
+static uint32_t events, bad_events;
+
+static const uint8_t script_pass[] =
+{
+    PROD_TEST_SCRIPT_MAGIC, PROD_TEST_SCRIPT_VERSION, 8,
+    PROD_TEST_SCRIPT_OP_TX_TONE,    0, 19, 0xF4, 0x01,
+    PROD_TEST_SCRIPT_OP_RX_PER,     0, 19, 0xE8, 0x03, 0x84, 0x03,
+    PROD_TEST_SCRIPT_OP_VBAT,       0, 0, 0x58, 0x02, 0x84, 0x03,
+    PROD_TEST_SCRIPT_OP_GPIO_CHECK, 0, 4, PROD_TEST_SCRIPT_PULL_NONE, 1,
+    PROD_TEST_SCRIPT_OP_GPIO_SET,   0, 8, 1,
+    PROD_TEST_SCRIPT_OP_GPIO_CHECK, 0, 9, PROD_TEST_SCRIPT_PULL_DOWN, 1,
+    PROD_TEST_SCRIPT_OP_OTP_VERIFY, 0, 0x40, 0x7F, 4, 0xC3, 0xCA, 0xD1, 0xD8,
+    PROD_TEST_SCRIPT_OP_DELAY,      0, 0x64, 0x00,
+};
+
+static const uint8_t script_stop[] =
+{
+    PROD_TEST_SCRIPT_MAGIC, PROD_TEST_SCRIPT_VERSION, 3,
+    PROD_TEST_SCRIPT_OP_RX_PER,     PROD_TEST_SCRIPT_FLAG_STOP_ON_FAIL, 19, 0xE8, 0x03, 0xE8, 0x03,
+    PROD_TEST_SCRIPT_OP_VBAT,       0, 0, 0x58, 0x02, 0x84, 0x03,
+    PROD_TEST_SCRIPT_OP_DELAY,      0, 0x0A, 0x00,
+};
+
+uint32_t ea_time_get_halfslot_rounded(void)
+{
+    // Starts 5000 half slots before the wrap of the 27-bit BLE time
+    return (uint32_t)(now_hs + 0x7FFFFFF - 5000) & 0x7FFFFFF;
+}
+
+void *host_msg_alloc(ke_msg_id_t id, ke_task_id_t dest, ke_task_id_t src, uint16_t len)
+{
+    (void)dest;
+
+    if ((id != HCI_CMD_CMP_EVENT) || (src != HCI_SCRIPT_RUN_CMD_OPCODE) || (len != sizeof(event_buf)))
+    {
+        bad_events++;
+    }
+    memset(&event_buf, 0xA5, sizeof(event_buf));
+    return &event_buf;
+}
+
+void hci_send_2_host(void *param)
+{
+    (void)param;
+    events++;
+}
+
+void set_state_start_rx(void)
+{
+    test_state = STATE_START_RX;
+    rx_start_hs = now_hs;
+}
+
+void set_state_stop(void)
+{
+    if (test_state == STATE_START_RX)
+    {
+        rx_packets = (uint16_t)((now_hs - rx_start_hs) * RX_PACKETS_PER_S / HS_PER_S);
+    }
+    test_state = STATE_IDLE;
+}
+
+void set_state_start_continue_tx(void)
+{
+    test_state = STATE_START_CONTINUE_TX;
+}
+
+bool dialog_commands_tx_end_continue(void)
+{
+    test_state = STATE_IDLE;
+    return true;
+}
+
+bool dialog_commands_unmodulated(uint8_t operation, uint8_t frequency)
+{
+    (void)frequency;
+    test_state = (operation == UNMODULATED_CMD_MODE_OFF) ? STATE_IDLE :
+                 (operation == UNMODULATED_CMD_MODE_TX) ? STATE_UNMODULATED_ON : STATE_UNMODULATED_RX_ON;
+    return true;
+}
+
+uint16_t dialog_commands_vbat_sample(uint8_t vbat_type)
+{
+    (void)vbat_type;
+    return VBAT_MV;
+}
+
+uint16_t ble_rxccmpktcnt0_get(uint16_t elt_idx)
+{
+    (void)elt_idx;
+    // The counter is only final once the RX test is stopped
+    if (test_state != STATE_IDLE)
+    {
+        rx_reads_running++;
+    }
+    return rx_packets;
+}
+
+void otp_read(uint32_t otp_pos, uint8_t *val, uint8_t len)
+{
+    uint8_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        val[i] = (uint8_t)(7 * (otp_pos - MEMORY_OTP_BASE + i) + 3);
+    }
+}
+
+bool GPIO_is_valid(GPIO_PORT port, GPIO_PIN pin)
+{
+    return (port == GPIO_PORT_0) && (pin < PADS);
+}
+
+void GPIO_ConfigurePin(GPIO_PORT port, GPIO_PIN pin, GPIO_PUPD mode, GPIO_FUNCTION function, const bool high)
+{
+    (void)port;
+    (void)function;
+    pad_mode[pin] = mode;
+    pad_out[pin] = high;
+}
+
+bool GPIO_GetPinStatus(GPIO_PORT port, GPIO_PIN pin)
+{
+    (void)port;
+    if (pad_mode[pin] == OUTPUT)
+    {
+        return pad_out[pin];
+    }
+    if (pin == 4)
+    {
+        return true;
+    }
+    if ((pin == 9) && (pad_mode[8] == OUTPUT))
+    {
+        return pad_out[8];
+    }
+    return pad_mode[pin] == INPUT_PULLUP;
+}
+
+void handle_jtag(GPIO_PORT port, GPIO_PIN pin)
+{
+    (void)port;
+    (void)pin;
+}
+
+void handle_reset_state(GPIO_PORT port, GPIO_PIN pin)
+{
+    (void)port;
+    (void)pin;
+}
+
+/// Runs the started script to its end, returns the number of calls of the main loop
+static uint32_t run(uint32_t max_step_hs)
+{
+    uint32_t loops = 0;
+
+    while (prod_test_script_running())
+    {
+        now_hs += 1 + rand() % max_step_hs;
+        prod_test_script_process();
+        loops++;
+    }
+    return loops;
+}
+
+static void reset_dut(void)
+{
+    memset(pad_mode, 0, sizeof(pad_mode));
+    memset(pad_out, 0, sizeof(pad_out));
+    test_state = STATE_IDLE;
+    rx_packets = 0;
+    events = 0;
+}
+
+static void print_record(const struct hci_script_run_dialog_cmd_cmp_evt *evt)
+{
+    uint8_t i;
+
+    // Same layout as hci_script_run_cmd_cmp_evt_pk() puts on the wire
+    printf("%02X%02X%02X%02X%02X%02X%02X%02X", evt->status, evt->steps, evt->failed, evt->first_failed,
+           (uint8_t)evt->duration_ms, (uint8_t)(evt->duration_ms >> 8),
+           (uint8_t)(evt->duration_ms >> 16), (uint8_t)(evt->duration_ms >> 24));
+    for (i = 0; i < evt->steps; i++)
+    {
+        printf("%02X%02X%02X", evt->step[i].status, (uint8_t)evt->step[i].value, (uint8_t)(evt->step[i].value >> 8));
+    }
+    printf("\n");
+}
+
+#define CHECK(cond) do { if (!(cond)) { printf("check failed, line %d: %s\n", __LINE__, #cond); fails++; } } while (0)
+
+int main(int argc, char **argv)
+{
+    uint32_t fails = 0;
+    uint32_t valid = 0, started = 0;
+    uint8_t buf[PROD_TEST_SCRIPT_MAX_LEN];
+    uint8_t err_step;
+    uint32_t i, j;
+
+    srand(1);
+
+    if (argc > 1)
+    {
+        FILE *f = fopen(argv[1], "rb");
+        size_t len;
+        uint8_t status;
+
+        if (f == NULL)
+        {
+            perror(argv[1]);
+            return 2;
+        }
+        len = fread(buf, 1, sizeof(buf), f);
+        fclose(f);
+
+        reset_dut();
+        status = prod_test_script_start(buf, (uint8_t)len);
+        if (status != CO_ERROR_NO_ERROR)
+        {
+            printf("rejected, status 0x%02X\n", status);
+            return 1;
+        }
+        run(16);
+        print_record(&event_buf);
+        return 0;
+    }
+
+    // Every step passes, the RX count is the one of the packet counter
+    reset_dut();
+    CHECK(prod_test_script_start(script_pass, sizeof(script_pass)) == CO_ERROR_NO_ERROR);
+    run(16);
+    print_record(&event_buf);
+    CHECK(events == 1);
+    CHECK(event_buf.status == CO_ERROR_NO_ERROR);
+    CHECK(event_buf.steps == 8);
+    CHECK(event_buf.failed == 0);
+    CHECK(event_buf.first_failed == 0xFF);
+    for (i = 0; i < 8; i++)
+    {
+        CHECK(event_buf.step[i].status == PROD_TEST_SCRIPT_STEP_PASS);
+    }
+    CHECK((event_buf.step[1].value >= RX_PACKETS_PER_S) && (event_buf.step[1].value <= RX_PACKETS_PER_S + 5));
+    CHECK(event_buf.step[2].value == VBAT_MV);
+    // Five steps wait, each may end up to one main loop step (16 half slots) late
+    CHECK((event_buf.duration_ms >= 1600) && (event_buf.duration_ms <= 1600 + 5 * 5));
+    CHECK(test_state == STATE_IDLE);
+
+    // A failing step with the stop flag skips the rest of the script
+    reset_dut();
+    CHECK(prod_test_script_start(script_stop, sizeof(script_stop)) == CO_ERROR_NO_ERROR);
+    run(16);
+    print_record(&event_buf);
+    CHECK(events == 1);
+    CHECK(event_buf.failed == 1);
+    CHECK(event_buf.first_failed == 0);
+    CHECK(event_buf.step[0].status == PROD_TEST_SCRIPT_STEP_FAIL);
+    CHECK(event_buf.step[0].value < 1000);
+    CHECK(event_buf.step[1].status == PROD_TEST_SCRIPT_STEP_SKIPPED);
+    CHECK(event_buf.step[2].status == PROD_TEST_SCRIPT_STEP_SKIPPED);
+
+    // Rejected scripts send nothing, the command handler answers them
+    reset_dut();
+    CHECK(prod_test_script_start(script_pass, sizeof(script_pass) - 1) == CO_ERROR_INVALID_HCI_PARAM);
+    CHECK(prod_test_script_start(script_stop, sizeof(script_stop)) == CO_ERROR_NO_ERROR);
+    CHECK(prod_test_script_start(script_pass, sizeof(script_pass)) == CO_ERROR_COMMAND_DISALLOWED);
+    run(16);
+    test_state = STATE_DIRECT_RX_TEST;
+    CHECK(prod_test_script_start(script_pass, sizeof(script_pass)) == CO_ERROR_COMMAND_DISALLOWED);
+    CHECK(events == 1);
+
+    // No truncation of a valid script is valid
+    for (i = 0; i < sizeof(script_pass); i++)
+    {
+        CHECK(!prod_test_script_validate(script_pass, (uint8_t)i, &err_step));
+    }
+
+    // Random scripts, the valid ones are run and each gives one event
+    for (i = 0; i < 200000; i++)
+    {
+        uint32_t len = rand() % (PROD_TEST_SCRIPT_MAX_LEN + 1);
+
+        for (j = 0; j < len; j++)
+        {
+            buf[j] = (j < 3) ? script_pass[j] : (uint8_t)rand();
+        }
+        if (len > 2)
+        {
+            buf[2] = (uint8_t)(rand() % 4);
+            for (j = PROD_TEST_SCRIPT_HDR_LEN; j < len; j += 1 + rand() % 8)
+            {
+                buf[j] = (uint8_t)(1 + rand() % (PROD_TEST_SCRIPT_OP_LAST - 1));
+            }
+        }
+        if (!prod_test_script_validate(buf, (uint8_t)len, &err_step))
+        {
+            continue;
+        }
+        valid++;
+        if (started < 200)
+        {
+            reset_dut();
+            CHECK(prod_test_script_start(buf, (uint8_t)len) == CO_ERROR_NO_ERROR);
+            run(4096);
+            CHECK(events == 1);
+            CHECK(test_state == STATE_IDLE);
+            started++;
+        }
+    }
+
+    CHECK(bad_events == 0);
+    CHECK(rx_reads_running == 0);
+
+    printf("random scripts: %u valid of 200000, %u run\n", valid, started);
+    printf("%s\n", fails ? "FAILED" : "OK");
+
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+/**
+ ****************************************************************************************
+ *
+ * @file xtal_trim_sim.c
+ *
+ * @brief Host simulation of the automatic XTAL trim search.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+/*
+ * Runs auto_trim() of Xtal_TRIM.c against simulated crystals:
+ *
+ *     gcc -O2 -D__DA14531__ -I../../helpers/host_stub -Isrc -o xtal_trim_sim tools/xtal_trim_sim.c \
+ *         src/Xtal_TRIM.c -lm
+ *     ./xtal_trim_sim [units] [count noise] [seed]
+ *
+ * Every unit has its own pulling curve, frequency offset = A / (C0 + trim) - offset, with
+ * the trim that cancels the offset somewhere in the middle of the trim range. Every gate
+ * counts the 8MHz reference pulse with Gaussian noise of the given standard deviation in
+ * counts. The number of gates per unit and the residual frequency error of the returned
+ * trim are printed. Near the lower end of the trim range some curves are so steep that no
+ * trim value meets PPM_1 with a margin of three times the noise, these units may fail.
+ * The exit status is non-zero if any other unit fails or a unit ends outside PPM_2.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Xtal_TRIM.h"
+#include "Xtal_TRIM_platform.h"
+
+host_systick_t host_systick;
+
+static uint32_t trim_reg;
+static uint32_t gates;
+static double curve_a, curve_c0, curve_off, noise;
+
+static double gauss(void)
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+/// Frequency error of the crystal in ppm at a trim value
+static double ppm(double trim)
+{
+    return curve_a / (curve_c0 + trim) - curve_off;
+}
+
+int xtal_pltfrm_get_port_pin_reg(uint8_t port_number, uint32_t *port_reg, uint16_t *pin_bit)
+{
+    (void)port_number;
+    *port_reg = 0;
+    *pin_bit = 1;
+    return XTAL_PLTFRM_NO_ERROR;
+}
+
+int xtal_pltfrm_set_port_in_pu(uint8_t port_number)
+{
+    (void)port_number;
+    return XTAL_PLTFRM_NO_ERROR;
+}
+
+int xtal_pltfrm_get_val_from_reg(volatile uint32_t *Trim_Value)
+{
+    *Trim_Value = trim_reg;
+    return XTAL_PLTFRM_NO_ERROR;
+}
+
+int xtal_pltfrm_set_val_to_reg(uint32_t Trim_Value)
+{
+    trim_reg = Trim_Value;
+    return XTAL_PLTFRM_NO_ERROR;
+}
+
+uint32_t xtal_pltfrm_measure_pulse(uint32_t datareg, uint16_t shift_bit)
+{
+    double ticks = XTAL16M * (1 + ppm(trim_reg) * 1e-6) + gauss() * noise;
+
+    (void)datareg;
+    (void)shift_bit;
+    gates++;
+
+    // The SysTick counts down from 0xFFFFFF
+    return 0xFFFFFF - (uint32_t)lround(ticks);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t units = (argc > 1) ? strtoul(argv[1], NULL, 0) : 2000;
+    uint32_t seed = (argc > 3) ? strtoul(argv[3], NULL, 0) : 1;
+    uint32_t total = 0, max_gates = 0, fails = 0, untrimmable = 0, out_of_spec = 0;
+    // PPM_1 and PPM_2 are given in counts of the 8MHz gate
+    double limit = PPM_2_16M * 1e6 / XTAL16M;
+    double pass = PPM_1_16M * 1e6 / XTAL16M;
+    double err_sum = 0, err_max = 0;
+    uint32_t i, t;
+
+    noise = (argc > 2) ? atof(argv[2]) : 2.0;
+
+    for (i = 0; i < units; i++)
+    {
+        double target;
+        double best = INFINITY;
+        int trim;
+
+        srand(seed * 100003 + i);
+        curve_a = 20000 + 8000.0 * rand() / RAND_MAX;
+        curve_c0 = 40 + 40.0 * rand() / RAND_MAX;
+        target = 30 + 200.0 * rand() / RAND_MAX;
+        curve_off = curve_a / (curve_c0 + target);
+
+        for (t = TRIM_MIN_16M; t <= TRIM_MAX_16M; t++)
+        {
+            best = (fabs(ppm(t)) < best) ? fabs(ppm(t)) : best;
+        }
+
+        gates = 0;
+        trim = auto_trim(0, 1);
+        total += gates;
+        if (gates > max_gates)
+        {
+            max_gates = gates;
+        }
+
+        if (trim < 0)
+        {
+            if (best > pass - 3 * noise * 1e6 / XTAL16M)
+            {
+                untrimmable++;
+            }
+            else
+            {
+                fails++;
+            }
+            continue;
+        }
+
+        err_sum += fabs(ppm(trim));
+        if (fabs(ppm(trim)) > err_max)
+        {
+            err_max = fabs(ppm(trim));
+        }
+        if (fabs(ppm(trim)) > limit)
+        {
+            out_of_spec++;
+        }
+    }
+
+    printf("units %u, gates mean %.2f max %u, failed %u (marginal %u), outside %.2f ppm %u, "
+           "|error| mean %.3f max %.3f ppm\n",
+           units, (double)total / units, max_gates, fails + untrimmable, untrimmable, limit, out_of_spec,
+           (units > fails + untrimmable) ? err_sum / (units - fails - untrimmable) : 0.0, err_max);
+
+    printf("%s\n", (fails || out_of_spec) ? "FAILED" : "OK");
+
+    return (fails || out_of_spec) ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+/**
+ ****************************************************************************************
+ *
+ * @file delay_sim.c
+ *
+ * @brief Host check of the delay calibration and of the spin or sleep choice.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from helpers/calibrated_delay:
+ *
+ *   gcc -O2 -I. -o delay_sim tools/delay_sim.c -lm
+ *   ./delay_sim
+ *
+ * The calibration of user_delay.c is run against a simulated CPU: system clock of 2 to
+ * 32 MHz, 3 to 6 cycles per spin loop, and the SysTick counting the 1 MHz reference from
+ * an unknown phase, so the timed loops read one microsecond short or long.
+ *
+ * Checked: with the measured rate no spin wait is shorter than requested, beyond the
+ * resolution of the calibration, nor longer by more than one loop and 1 %; before the
+ * calibration the default rate errs on the long side at the fastest clock; the spin or
+ * sleep choice at USER_DELAY_SLEEP_MIN_US and in exception handlers; the limits of the
+ * fixed point math.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "user_delay.h"
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+static const double clocks_mhz[] = {2, 4, 8, 16, 32};
+static const double loop_cycles[] = {3, 4, 6};
+static const uint32_t waits_us[] = {1, 2, 5, 20, 40, USER_DELAY_SLEEP_MIN_US - 1};
+
+#define COUNT(a)    (sizeof(a) / sizeof((a)[0]))
+
+static void check_calibration(double mhz, double cycles)
+{
+    double us_per_loop = cycles / mhz;
+    // Calibration resolution: one tick of the reference over the timed loops
+    double resolution = 1.0 / (USER_DELAY_CAL_LOOPS * us_per_loop);
+
+    for (int phase = 0; phase < 2; phase++)
+    {
+        uint32_t elapsed = (uint32_t)floor(USER_DELAY_CAL_LOOPS * us_per_loop) + phase;
+        uint32_t rate = user_delay_rate(USER_DELAY_CAL_LOOPS, elapsed);
+
+        for (unsigned i = 0; i < COUNT(waits_us); i++)
+        {
+            double us = waits_us[i];
+            double t = user_delay_loops(rate, waits_us[i]) * us_per_loop;
+
+            CHECK(t >= us * (1 - resolution) - 1e-9);
+            CHECK(t <= us * 1.01 + us_per_loop + 1e-9);
+        }
+    }
+
+    printf("%2g MHz, %g cycles per loop: 40 us wait takes %.2f us\n", mhz, cycles,
+           user_delay_loops(user_delay_rate(USER_DELAY_CAL_LOOPS,
+                                            (uint32_t)floor(USER_DELAY_CAL_LOOPS * us_per_loop)),
+                            40) * us_per_loop);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < COUNT(clocks_mhz); i++)
+    {
+        for (unsigned j = 0; j < COUNT(loop_cycles); j++)
+        {
+            check_calibration(clocks_mhz[i], loop_cycles[j]);
+        }
+    }
+
+    // Not calibrated yet: too long rather than too short, fastest clock and shortest loop
+    CHECK(user_delay_loops(USER_DELAY_DEFAULT_RATE, 40) * (3 / 32.0) >= 40);
+
+    CHECK(user_delay_mode(USER_DELAY_SLEEP_MIN_US - 1, false) == USER_DELAY_SPIN);
+    CHECK(user_delay_mode(USER_DELAY_SLEEP_MIN_US, false) == USER_DELAY_SLEEP);
+    CHECK(user_delay_mode(100000, true) == USER_DELAY_SPIN);
+
+    CHECK(user_delay_rate(USER_DELAY_CAL_LOOPS, 0) == USER_DELAY_DEFAULT_RATE);
+    CHECK(user_delay_rate(1, UINT32_MAX) == 1);
+    CHECK(user_delay_loops(UINT32_MAX, UINT32_MAX) == UINT32_MAX);
+
+    printf(fails ? "FAILED\n" : "OK\n");
+    return fails != 0;
+}
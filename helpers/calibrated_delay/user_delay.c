@@ -0,0 +1,150 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_delay.c
+ *
+ * @brief Calibrated delay service source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include "arch.h"
+#include "datasheet.h"
+#include "systick.h"
+#include "user_delay.h"
+
+/*
+ * GLOBAL VARIABLE DEFINITIONS
+ ****************************************************************************************
+ */
+
+uint32_t user_delay_rate_q16                    __SECTION_ZERO("retention_mem_area0"); //@ RETENTION MEMORY
+
+static volatile bool user_delay_expired;
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief The calibrated loop. Kept out of line so that the calibration and the waits run
+ *        the same code.
+ ****************************************************************************************
+ */
+static void __attribute__((noinline)) user_delay_spin(uint32_t loops)
+{
+    while (loops--)
+    {
+        __NOP();
+    }
+}
+
+static void user_delay_systick_cb(void)
+{
+    user_delay_expired = true;
+}
+
+static void user_delay_sleep(uint32_t us)
+{
+    user_delay_expired = false;
+    systick_register_callback(user_delay_systick_cb);
+    systick_start(us, true);
+
+    // The flag is tested with the interrupts disabled, a pending interrupt still ends the
+    // WFI and is served when they are restored
+    while (!user_delay_expired)
+    {
+        GLOBAL_INT_DISABLE();
+        if (!user_delay_expired)
+        {
+            __WFI();
+        }
+        GLOBAL_INT_RESTORE();
+    }
+
+    systick_stop();
+}
+
+void user_delay_calibrate(void)
+{
+    uint32_t elapsed;
+
+    GLOBAL_INT_DISABLE();
+    systick_start(USER_DELAY_SYSTICK_MAX_US, false);
+    user_delay_spin(USER_DELAY_CAL_LOOPS);
+    elapsed = USER_DELAY_SYSTICK_MAX_US - systick_value();
+    systick_stop();
+    GLOBAL_INT_RESTORE();
+
+    user_delay_rate_q16 = user_delay_rate(USER_DELAY_CAL_LOOPS, elapsed);
+}
+
+void user_delay_us(uint32_t us)
+{
+    uint32_t period;
+
+    if (user_delay_mode(us, __get_IPSR() != 0) == USER_DELAY_SPIN)
+    {
+        user_delay_spin(user_delay_loops(user_delay_get_rate(), us));
+        return;
+    }
+
+    while (us > 0)
+    {
+        period = (us > USER_DELAY_SYSTICK_MAX_US) ? USER_DELAY_SYSTICK_MAX_US : us;
+        user_delay_sleep(period);
+        us -= period;
+    }
+}
+
+void user_delay_ms(uint32_t ms)
+{
+    while (ms > 0)
+    {
+        uint32_t step = (ms > 1000) ? 1000 : ms;
+
+        user_delay_us(step * 1000);
+        ms -= step;
+    }
+}
+
+uint32_t user_delay_get_rate(void)
+{
+    return (user_delay_rate_q16 != 0) ? user_delay_rate_q16 : USER_DELAY_DEFAULT_RATE;
+}
+
+/// @} APP
@@ -0,0 +1,189 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_delay.h
+ *
+ * @brief Calibrated delay service header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_DELAY_H_
+#define _USER_DELAY_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * Microsecond delays that do not depend on the system clock. At boot the spin loop is
+ * timed against the 1 MHz reference of the SysTick, which gives the loop count per
+ * microsecond at the current clock settings. Waits shorter than USER_DELAY_SLEEP_MIN_US
+ * spin on the calibrated loop. Longer waits run on the SysTick with the CPU in WFI until
+ * its interrupt, other interrupts are served meanwhile.
+ *
+ * The module is shared by the examples, which add this directory to their include path
+ * and user_delay.c to their sources.
+ *
+ * The calculations are inline functions with no SDK dependency so that they can be
+ * compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Spin loop iterations timed by the calibration
+#define USER_DELAY_CAL_LOOPS            (4096)
+
+/// Rate used before the calibration, loops per us in 16.16 fixed point. Set above any
+/// clock setting, so that waits are too long rather than too short
+#define USER_DELAY_DEFAULT_RATE         (16UL << 16)
+
+/// Shortest wait that sleeps, below it the SysTick interrupt latency is not negligible
+#define USER_DELAY_SLEEP_MIN_US         (100)
+
+/// Longest wait of one SysTick period, the counter has 24 bits
+#define USER_DELAY_SYSTICK_MAX_US       (0x1000000UL)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+enum user_delay_mode
+{
+    /// Spin on the calibrated loop
+    USER_DELAY_SPIN,
+    /// Sleep until the SysTick interrupt
+    USER_DELAY_SLEEP,
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Spin loop rate from a calibration run.
+ * @param[in] loops     Loop iterations run.
+ * @param[in] elapsed   Microseconds they took.
+ * @return Loops per microsecond, 16.16 fixed point.
+ ****************************************************************************************
+ */
+static inline uint32_t user_delay_rate(uint32_t loops, uint32_t elapsed)
+{
+    uint64_t rate;
+
+    if (elapsed == 0)
+    {
+        return USER_DELAY_DEFAULT_RATE;
+    }
+
+    rate = ((uint64_t)loops << 16) / elapsed;
+
+    return (rate > 0) ? (uint32_t)rate : 1;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Loop iterations for a wait, rounded up.
+ * @param[in] rate      Loops per microsecond, 16.16 fixed point.
+ * @param[in] us        Wait in microseconds.
+ * @return Loop iterations.
+ ****************************************************************************************
+ */
+static inline uint32_t user_delay_loops(uint32_t rate, uint32_t us)
+{
+    uint64_t loops = ((uint64_t)rate * us + 0xFFFF) >> 16;
+
+    return (loops > UINT32_MAX) ? UINT32_MAX : (uint32_t)loops;
+}
+
+/**
+ ****************************************************************************************
+ * @brief Chooses between spinning and sleeping.
+ * @param[in] us        Wait in microseconds.
+ * @param[in] in_isr    True if called from an exception handler, where the SysTick
+ *                      interrupt may not be taken.
+ * @return How to wait.
+ ****************************************************************************************
+ */
+static inline enum user_delay_mode user_delay_mode(uint32_t us, bool in_isr)
+{
+    return (in_isr || (us < USER_DELAY_SLEEP_MIN_US)) ? USER_DELAY_SPIN : USER_DELAY_SLEEP;
+}
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Times the spin loop against the SysTick reference. Must be called at boot and
+ *        after every change of the system clock. Uses the SysTick.
+ ****************************************************************************************
+ */
+void user_delay_calibrate(void);
+
+/**
+ ****************************************************************************************
+ * @brief Waits at least the given time. Uses the SysTick for waits that sleep.
+ * @param[in] us        Wait in microseconds.
+ ****************************************************************************************
+ */
+void user_delay_us(uint32_t us);
+
+/**
+ ****************************************************************************************
+ * @brief Waits at least the given time.
+ * @param[in] ms        Wait in milliseconds.
+ ****************************************************************************************
+ */
+void user_delay_ms(uint32_t ms);
+
+/**
+ ****************************************************************************************
+ * @brief Spin loop rate in use.
+ * @return Loops per microsecond, 16.16 fixed point.
+ ****************************************************************************************
+ */
+uint32_t user_delay_get_rate(void);
+
+/// @} APP
+
+#endif // _USER_DELAY_H_
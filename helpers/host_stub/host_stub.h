@@ -0,0 +1,330 @@
+/**
+ ****************************************************************************************
+ *
+ * @file host_stub.h
+ *
+ * @brief Minimal SDK declarations to build the modules of the examples on a host.
+ *
+ * The headers of this directory stand in for the SDK headers of the same name, they are
+ * only used by the host tests in the tools/ directory of the examples. Every test defines
+ * the functions and the data it uses, the configuration of an example stays in its test.
+ *
+ ****************************************************************************************
+ */
+
+#ifndef _HOST_STUB_H_
+#define _HOST_STUB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Compiler and architecture
+ ****************************************************************************************
+ */
+
+#define __SECTION_ZERO(sec_name)
+#define __ARRAY_EMPTY
+
+#define GLOBAL_INT_DISABLE()
+#define GLOBAL_INT_RESTORE()
+#define __NOP()
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+} host_systick_t;
+
+extern host_systick_t host_systick;
+
+#define SysTick                         (&host_systick)
+
+#define MEMORY_OTP_BASE                 (0x07F80000)
+
+void arch_force_active_mode(void);
+void arch_restore_sleep_mode(void);
+
+/*
+ * Kernel
+ ****************************************************************************************
+ */
+
+#define TASK_APP                        (0)
+#define TASK_GAPM                       (1)
+#define APP_CONNECTABLE                 (1)
+
+typedef uint16_t ke_msg_id_t;
+typedef uint16_t ke_task_id_t;
+typedef uint8_t ke_state_t;
+
+struct ke_msg_handler
+{
+    ke_msg_id_t id;
+};
+
+void *host_msg_alloc(ke_msg_id_t id, ke_task_id_t dest, ke_task_id_t src, uint16_t len);
+void ke_msg_send(void const *param_ptr);
+ke_state_t ke_state_get(ke_task_id_t id);
+void ke_state_set(ke_task_id_t id, ke_state_t state);
+
+#define KE_MSG_ALLOC(id, dest, src, param_str) \
+    (struct param_str *)host_msg_alloc(id, dest, src, sizeof(struct param_str))
+
+/*
+ * BLE time base, link layer and HCI
+ ****************************************************************************************
+ */
+
+#define CO_ERROR_NO_ERROR               (0x00)
+#define CO_ERROR_COMMAND_DISALLOWED     (0x0C)
+#define CO_ERROR_INVALID_HCI_PARAM      (0x12)
+
+#define HCI_CMD_CMP_EVENT               (0x0E)
+#define HCI_CMD_STAT_EVENT              (0x0F)
+
+#define LLD_ADV_HDL                     (1)
+
+struct hci_cmd_desc_tag
+{
+    uint16_t opcode;
+};
+
+uint32_t ea_time_get_halfslot_rounded(void);
+uint16_t ble_rxccmpktcnt0_get(uint16_t elt_idx);
+void hci_send_2_host(void *param);
+
+/*
+ * GAP
+ ****************************************************************************************
+ */
+
+#define BD_ADDR_LEN                     (6)
+#define ADV_DATA_LEN                    (31)
+#define SCAN_RSP_DATA_LEN               (31)
+
+#define ADDR_PUBLIC                     (0)
+#define ADV_CONN_UNDIR                  (0)
+#define ADV_DISC_UNDIR                  (2)
+
+#define ADV_CHNL_37_EN                  (0x01)
+#define ADV_ALL_CHNLS_EN                (0x07)
+
+#define GAPM_START_ADVERTISE_CMD        (0x0D0D)
+
+// Operation codes of the GAPM air operations
+#define GAPM_ADV_NON_CONN               (0x0D)
+#define GAPM_ADV_UNDIRECT               (0x0E)
+#define GAPM_SCAN_ACTIVE                (0x12)
+#define GAPM_SCAN_PASSIVE               (0x13)
+
+struct bd_addr
+{
+    uint8_t addr[BD_ADDR_LEN];
+};
+
+struct gap_bdaddr
+{
+    struct bd_addr addr;
+    uint8_t addr_type;
+};
+
+// Same layout as the SDK structures
+struct adv_report
+{
+    uint8_t evt_type;
+    uint8_t adv_addr_type;
+    struct bd_addr adv_addr;
+    uint8_t data_len;
+    uint8_t data[ADV_DATA_LEN];
+    int8_t rssi;
+};
+
+struct gapm_air_operation
+{
+    uint8_t code;
+    uint8_t addr_src;
+    uint16_t state;
+    uint16_t renew_dur;
+    struct bd_addr addr;
+};
+
+struct gapm_adv_host
+{
+    uint8_t mode;
+    uint8_t adv_filt_policy;
+    uint8_t adv_data_len;
+    uint8_t adv_data[ADV_DATA_LEN - 3];
+    uint8_t scan_rsp_data_len;
+    uint8_t scan_rsp_data[SCAN_RSP_DATA_LEN];
+    struct gap_bdaddr peer_info;
+};
+
+struct gapm_start_advertise_cmd
+{
+    struct gapm_air_operation op;
+    uint16_t intv_min;
+    uint16_t intv_max;
+    uint8_t channel_map;
+    union
+    {
+        struct gapm_adv_host host;
+        struct gap_bdaddr direct;
+    } info;
+};
+
+struct gapm_start_scan_cmd
+{
+    struct gapm_air_operation op;
+    uint16_t interval;
+    uint16_t window;
+    uint8_t mode;
+    uint8_t filt_policy;
+    uint8_t filter_duplic;
+};
+
+struct gapc_connection_req_ind;
+struct gapc_disconnect_ind;
+struct gapm_adv_report_ind;
+
+/*
+ * GATT client
+ ****************************************************************************************
+ */
+
+enum gattc_sdp_att_type
+{
+    GATTC_SDP_NONE,
+    GATTC_SDP_INC_SVC,
+    GATTC_SDP_ATT_CHAR,
+    GATTC_SDP_ATT_VAL,
+    GATTC_SDP_ATT_DESC,
+};
+
+// Same layout as the SDK structures
+struct gattc_sdp_att_char
+{
+    uint8_t att_type;
+    uint8_t prop;
+    uint16_t handle;
+};
+
+struct gattc_sdp_include
+{
+    uint8_t att_type;
+    uint8_t uuid_len;
+    uint8_t uuid[16];
+    uint16_t start_hdl;
+    uint16_t end_hdl;
+};
+
+struct gattc_sdp_att
+{
+    uint8_t att_type;
+    uint8_t uuid_len;
+    uint8_t uuid[16];
+};
+
+union gattc_sdp_att_info
+{
+    uint8_t att_type;
+    struct gattc_sdp_att_char att_char;
+    struct gattc_sdp_include inc_svc;
+    struct gattc_sdp_att att;
+};
+
+struct gattc_sdp_svc_ind
+{
+    uint8_t uuid_len;
+    uint8_t uuid[16];
+    uint16_t start_hdl;
+    uint16_t end_hdl;
+    union gattc_sdp_att_info info[__ARRAY_EMPTY];
+};
+
+/*
+ * Application framework
+ ****************************************************************************************
+ */
+
+#define EASY_TIMER_INVALID_TIMER        (0)
+
+#define DEF_ADV_FOREVER                 (0)
+#define DEF_ADV_WITH_TIMEOUT            (1)
+
+typedef uint8_t timer_hnd;
+
+typedef enum
+{
+    GOTO_SLEEP = 0,
+    KEEP_POWERED,
+} arch_main_loop_callback_ret_t;
+
+struct advertise_configuration
+{
+    uint8_t addr_src;
+    uint16_t intv_min;
+    uint16_t intv_max;
+    uint8_t channel_map;
+    uint8_t mode;
+    uint8_t adv_filt_policy;
+    struct gap_bdaddr peer_addr;
+};
+
+struct default_handlers_configuration
+{
+    uint8_t adv_scenario;
+    uint16_t advertise_period;
+    uint8_t security_request_scenario;
+};
+
+timer_hnd app_easy_timer(const uint32_t delay, void (*fn)(void));
+void app_easy_timer_cancel(const timer_hnd timer_id);
+
+struct gapm_start_advertise_cmd *app_easy_gap_undirected_advertise_get_active(void);
+void app_easy_gap_undirected_advertise_start(void);
+void app_easy_gap_advertise_stop(void);
+
+/*
+ * Peripherals
+ ****************************************************************************************
+ */
+
+#define UART2                           (0)
+#define UART_OP_INTR                    (1)
+
+void uart_send(int uart, const uint8_t *data, uint16_t len, int op);
+
+typedef enum
+{
+    GPIO_PORT_0 = 0,
+} GPIO_PORT;
+
+typedef enum
+{
+    GPIO_PIN_0 = 0,
+    GPIO_PIN_11 = 11,
+} GPIO_PIN;
+
+typedef enum
+{
+    INPUT = 0,
+    INPUT_PULLUP,
+    INPUT_PULLDOWN,
+    OUTPUT,
+} GPIO_PUPD;
+
+typedef enum
+{
+    PID_GPIO = 0,
+} GPIO_FUNCTION;
+
+bool GPIO_is_valid(GPIO_PORT port, GPIO_PIN pin);
+void GPIO_ConfigurePin(GPIO_PORT port, GPIO_PIN pin, GPIO_PUPD mode, GPIO_FUNCTION function, const bool high);
+bool GPIO_GetPinStatus(GPIO_PORT port, GPIO_PIN pin);
+void handle_jtag(GPIO_PORT port, GPIO_PIN pin);
+void handle_reset_state(GPIO_PORT port, GPIO_PIN pin);
+
+#endif // _HOST_STUB_H_
@@ -0,0 +1,2 @@
+// Host stub of the example header, see host_stub.h
+#include "host_stub.h"
@@ -41,6 +41,7 @@
  #include "arch_console.h"
  #include "app_entry_point.h"
  #include "adc.h"
+ #include "user_delay.h"
 
  
  /*
@@ -96,6 +97,8 @@ void user_gamepad_button_config(void){
  ****************************************************************************************
  */
 void user_gamepad_init(void){
+	// The ADC settling waits of adc_get_raw_sample() run on the calibrated delay
+	user_delay_calibrate();
 	memset(&gamepad_status, 0, sizeof(gamepad_status));
 	user_gamepad_button_config();
 	user_gamepad_config_digitizer();
@@ -283,36 +286,6 @@ void user_gamepad_config_digitizer(void){
 	user_gamepad_config_joystick(&RS_config, DEFAULT_RS_CONFIG);
 }
 
-/**
- ****************************************************************************************
- * @brief Introduces a variable microsend delay for use with ADC peripheral.
- * @param[in] nof_us Number of microseconds to delay
- * @return void
- ****************************************************************************************
- */
-static inline void __nop(void)
-{
-    __asm volatile ("nop");
-}
-
-void user_usDelay(uint32_t nof_us)
-{
-    while( nof_us-- ){
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-        __nop();
-    }
-}
-
-
 /**
  ****************************************************************************************
  * @brief Gets ADC sample using the 20 usec delay.
@@ -346,12 +319,12 @@ uint32_t adc_get_raw_sample(adc_input_se_t channel)
         .attn = true
     };
     adc_init(&cfg);
-    user_usDelay(20);
+    user_delay_us(20);
 
     adc_set_se_input(channel);
 
     adc_sample = adc_get_sample();
-    user_usDelay(1);
+    user_delay_us(1);
 
     //cfg.sign = false;
     adc_init(&cfg);
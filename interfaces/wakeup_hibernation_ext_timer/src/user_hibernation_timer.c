@@ -49,6 +49,8 @@
 #include "battery.h"
 #include "adc.h"
 #include "arch_hibernation.h"
+#include "user_config.h"
+#include "user_telemetry.h"
 
 #include "user_periph_setup.h"
 #include "spi_flash.h"
@@ -71,9 +73,11 @@
 #define RTC_TIMEOUT                     ADV_TIMER_CANCEL_TIMEOUT / 100              //In seconds
 #endif
 
-#define ADV_DATA_BATTERY_OFFSET         10                                          //Byte offset of battery level in Advertising Data
-#define ADV_DATA_TEMPER_OFFSET          12                                          //Byte offset of temperature level in Advertising Data
-#define ADV_DATA_ADV_COUNT_OFFSET       14                                          //Byte offset of advertising counter in Advertising Data
+#define APP_AD_MSD_COMPANY_ID           (0xABCD)                                    //Company ID of the Manufacturer Specific Data
+#define APP_AD_MSD_HEADER_LEN           (4)                                         //AD length, AD type and Company ID
+
+//The telemetry fills the advertising data left after USER_ADVERTISE_DATA, 3 bytes are taken by the flags
+#define APP_AD_MSD_DATA_LEN             (ADV_DATA_LEN - 3 - USER_ADVERTISE_DATA_LEN - APP_AD_MSD_HEADER_LEN)
 
 /*
  * GLOBAL VARIABLE DEFINITIONS
@@ -82,7 +86,7 @@
 
 // Retained variables
 uint32_t wakeup_count                         __SECTION_ZERO("retention_mem_area_uninit"); //Wake-up counter
-uint32_t adv_count                            __SECTION_ZERO("retention_mem_area_uninit"); //Advertising counter          
+struct telemetry_history telemetry            __SECTION_ZERO("retention_mem_area_uninit"); //Battery and temperature history
 
 timer_hnd adv_timer                           __SECTION_ZERO("retention_mem_area_uninit"); //Advertising cancel event timer
 
@@ -206,30 +210,24 @@ static void user_non_connectable_advertise_with_timeout_start(void)
 
 /**
  ****************************************************************************************
- * @brief Handles the update of the Advertising Data fields and starts advertising.
+ * @brief Samples the telemetry, puts it in the Advertising Data and starts advertising.
  * @return void
  ****************************************************************************************
 */
 void user_app_adv_start(void)
 {
-    uint8_t stored_adv_data[ADV_DATA_LEN];
-    int32_t next_temper;
-    uint16_t next_battery;
+    struct telemetry_sample sample;
+    uint8_t *adv_data;
+    uint8_t payload_len;
     
     //Get the active advertising configuration struct
     struct gapm_start_advertise_cmd* cmd;
     cmd = app_easy_gap_non_connectable_advertise_get_active();
-    
-    //Store advertising data
-    memcpy(stored_adv_data, cmd->info.host.adv_data, cmd->info.host.adv_data_len);
 
-    //Update advertising battery voltage
-    next_battery = battery_get_voltage(BATT_CR2032);
+    //Sample the battery voltage
+    sample.battery = battery_get_voltage(BATT_CR2032);
     
-    stored_adv_data[ADV_DATA_BATTERY_OFFSET]     = (uint8_t) ((next_battery & 0xFF00) >> 8);
-    stored_adv_data[ADV_DATA_BATTERY_OFFSET + 1] = (uint8_t) (next_battery & 0x00FF);
-    
-    //Update advertising temperature
+    //Sample the temperature
     adc_config_t cfg =
     {
         .input_mode = ADC_INPUT_MODE_SINGLE_ENDED,
@@ -240,19 +238,23 @@ void user_app_adv_start(void)
     // Initialize and enable ADC
     adc_init(&cfg);
     
-    next_temper = (uint32_t) adc_get_temp();
+    sample.temperature = (int8_t) adc_get_temp();
 
-    stored_adv_data[ADV_DATA_TEMPER_OFFSET]     = next_temper;
-    stored_adv_data[ADV_DATA_TEMPER_OFFSET + 1] = 0;
-    
-    //Update the advertising count
-    stored_adv_data[ADV_DATA_ADV_COUNT_OFFSET]     = (uint8_t) ((adv_count & 0xFF000000) >> 24);
-    stored_adv_data[ADV_DATA_ADV_COUNT_OFFSET + 1] = (uint8_t) ((adv_count & 0x00FF0000) >> 16);
-    stored_adv_data[ADV_DATA_ADV_COUNT_OFFSET + 2] = (uint8_t) ((adv_count & 0x0000FF00) >> 8);
-    stored_adv_data[ADV_DATA_ADV_COUNT_OFFSET + 3] = (uint8_t) (adv_count & 0x000000FF);
-
-    //Copy the updated fields into the advertising data
-    memcpy(cmd->info.host.adv_data, stored_adv_data, cmd->info.host.adv_data_len);
+    telemetry_add(&telemetry, &sample);
+
+    //Rebuild the advertising data, the device name does not fit next to the telemetry
+    adv_data = cmd->info.host.adv_data;
+    memcpy(adv_data, USER_ADVERTISE_DATA, USER_ADVERTISE_DATA_LEN);
+    adv_data += USER_ADVERTISE_DATA_LEN;
+
+    payload_len = telemetry_encode(&telemetry, &adv_data[APP_AD_MSD_HEADER_LEN], APP_AD_MSD_DATA_LEN);
+
+    adv_data[0] = APP_AD_MSD_HEADER_LEN - 1 + payload_len;
+    adv_data[1] = GAP_AD_TYPE_MANU_SPECIFIC_DATA;
+    adv_data[2] = APP_AD_MSD_COMPANY_ID & 0xFF;
+    adv_data[3] = (APP_AD_MSD_COMPANY_ID >> 8) & 0xFF;
+
+    cmd->info.host.adv_data_len = USER_ADVERTISE_DATA_LEN + APP_AD_MSD_HEADER_LEN + payload_len;
   
     //Start non-connectable advertising
     user_non_connectable_advertise_with_timeout_start();
@@ -260,7 +262,7 @@ void user_app_adv_start(void)
 
 /**
  ****************************************************************************************
- * @brief Initializes the temperature values and the advertising counter on a power-on 
+ * @brief Initializes the wake-up counter and the telemetry history on a power-on 
  *        reset
  * @return void
  ****************************************************************************************
@@ -269,9 +271,14 @@ void user_app_on_init(void)
 {
     //Check if the system was power-cycled
     if(reset_stat_local == 15) {
-        //Initialize advertising and wake-up count to zero
+        //Initialize the wake-up count to zero
         wakeup_count = 0;
-        adv_count = 0;
+    }
+
+    //Start a new telemetry history after a power-on or if the retained one is corrupted
+    if ((reset_stat_local == 15) || !telemetry_valid(&telemetry))
+    {
+        telemetry_init(&telemetry);
     }
     
 #ifdef CFG_HIBERNATION_MODE    
@@ -333,17 +340,6 @@ void user_app_on_adv_nonconn_complete(uint8_t status)
 */
 arch_main_loop_callback_ret_t user_on_ble_powered(void)
 {
-    uint8_t last_ble_event;
-
-    last_ble_event = arch_last_rwble_evt_get();
-
-    if (last_ble_event  == BLE_EVT_END)
-    {
-        adv_count = adv_count/3;
-        adv_count++;
-        adv_count = 3*adv_count;
-    }
-
     return GOTO_SLEEP;
 }
 
@@ -0,0 +1,237 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_telemetry.c
+ *
+ * @brief Delta encoded telemetry history source code.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "user_telemetry.h"
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Codes of the battery field
+#define BATTERY_SMALL_MAX               (13)
+#define BATTERY_DELTA8                  (14)
+#define BATTERY_ABSOLUTE                (15)
+
+/// Codes of the temperature field
+#define TEMPERATURE_SMALL_MAX           (14)
+#define TEMPERATURE_ABSOLUTE            (15)
+
+/// Largest count of older samples in the payload
+#define OLDER_MAX                       (0x0F)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+/// Nibble stream writer
+struct nibble_writer
+{
+    uint8_t *buf;
+    /// Nibbles written
+    uint16_t pos;
+};
+
+/*
+ * FUNCTION DEFINITIONS
+ ****************************************************************************************
+ */
+
+static uint16_t zigzag(int32_t d)
+{
+    return (d >= 0) ? (uint16_t)(2 * d) : (uint16_t)(-2 * d - 1);
+}
+
+static const struct telemetry_sample *sample_at(const struct telemetry_history *hist, uint8_t age)
+{
+    return &hist->samples[(hist->head + TELEMETRY_HISTORY_LEN - age) % TELEMETRY_HISTORY_LEN];
+}
+
+/**
+ ****************************************************************************************
+ * @brief Nibbles taken by an older sample.
+ * @param[in] newer     Next newer sample.
+ * @param[in] older     Sample to encode.
+ * @return Nibbles.
+ ****************************************************************************************
+ */
+static uint8_t older_cost(const struct telemetry_sample *newer, const struct telemetry_sample *older)
+{
+    int32_t db = (int32_t)older->battery - newer->battery;
+    int32_t dt = (int32_t)older->temperature - newer->temperature;
+    uint8_t cost;
+
+    if (zigzag(db) <= BATTERY_SMALL_MAX)
+    {
+        cost = 1;
+    }
+    else if ((db >= INT8_MIN) && (db <= INT8_MAX))
+    {
+        cost = 3;
+    }
+    else
+    {
+        cost = 5;
+    }
+
+    return cost + ((zigzag(dt) <= TEMPERATURE_SMALL_MAX) ? 1 : 3);
+}
+
+static void put_nibble(struct nibble_writer *wr, uint8_t value)
+{
+    uint8_t *byte = &wr->buf[wr->pos / 2];
+
+    if (wr->pos & 1)
+    {
+        *byte |= value & 0x0F;
+    }
+    else
+    {
+        *byte = (uint8_t)(value << 4);
+    }
+    wr->pos++;
+}
+
+static void put_older(struct nibble_writer *wr, const struct telemetry_sample *newer,
+                      const struct telemetry_sample *older)
+{
+    int32_t db = (int32_t)older->battery - newer->battery;
+    int32_t dt = (int32_t)older->temperature - newer->temperature;
+
+    if (zigzag(db) <= BATTERY_SMALL_MAX)
+    {
+        put_nibble(wr, (uint8_t)zigzag(db));
+    }
+    else if ((db >= INT8_MIN) && (db <= INT8_MAX))
+    {
+        put_nibble(wr, BATTERY_DELTA8);
+        put_nibble(wr, (uint8_t)db >> 4);
+        put_nibble(wr, (uint8_t)db);
+    }
+    else
+    {
+        put_nibble(wr, BATTERY_ABSOLUTE);
+        put_nibble(wr, (uint8_t)(older->battery >> 12));
+        put_nibble(wr, (uint8_t)(older->battery >> 8));
+        put_nibble(wr, (uint8_t)(older->battery >> 4));
+        put_nibble(wr, (uint8_t)older->battery);
+    }
+
+    if (zigzag(dt) <= TEMPERATURE_SMALL_MAX)
+    {
+        put_nibble(wr, (uint8_t)zigzag(dt));
+    }
+    else
+    {
+        put_nibble(wr, TEMPERATURE_ABSOLUTE);
+        put_nibble(wr, (uint8_t)older->temperature >> 4);
+        put_nibble(wr, (uint8_t)older->temperature);
+    }
+}
+
+void telemetry_init(struct telemetry_history *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->seq = UINT16_MAX;
+    hist->magic = TELEMETRY_MAGIC;
+}
+
+bool telemetry_valid(const struct telemetry_history *hist)
+{
+    return (hist->magic == TELEMETRY_MAGIC) &&
+           (hist->count <= TELEMETRY_HISTORY_LEN) &&
+           (hist->head < TELEMETRY_HISTORY_LEN);
+}
+
+void telemetry_add(struct telemetry_history *hist, const struct telemetry_sample *sample)
+{
+    hist->head = (hist->head + 1) % TELEMETRY_HISTORY_LEN;
+    hist->samples[hist->head] = *sample;
+    hist->seq++;
+
+    if (hist->count < TELEMETRY_HISTORY_LEN)
+    {
+        hist->count++;
+    }
+}
+
+uint8_t telemetry_encode(const struct telemetry_history *hist, uint8_t *buf, uint8_t len)
+{
+    const struct telemetry_sample *newest = sample_at(hist, 0);
+    struct nibble_writer wr = {&buf[TELEMETRY_HEADER_LEN], 0};
+    uint16_t room;
+    uint8_t older = 0;
+
+    if ((hist->count == 0) || (len < TELEMETRY_HEADER_LEN))
+    {
+        return 0;
+    }
+
+    room = 2 * (len - TELEMETRY_HEADER_LEN);
+
+    // Greedy, an older sample is only useful if all newer ones are in the payload
+    while ((older < OLDER_MAX) && (older + 1 < hist->count))
+    {
+        const struct telemetry_sample *newer = sample_at(hist, older);
+        const struct telemetry_sample *sample = sample_at(hist, older + 1);
+
+        if (wr.pos + older_cost(newer, sample) > room)
+        {
+            break;
+        }
+        put_older(&wr, newer, sample);
+        older++;
+    }
+
+    buf[0] = (uint8_t)((TELEMETRY_FORMAT << 4) | older);
+    buf[1] = (uint8_t)hist->seq;
+    buf[2] = (uint8_t)(hist->seq >> 8);
+    buf[3] = (uint8_t)newest->battery;
+    buf[4] = (uint8_t)(newest->battery >> 8);
+    buf[5] = (uint8_t)newest->temperature;
+
+    return (uint8_t)(TELEMETRY_HEADER_LEN + (wr.pos + 1) / 2);
+}
+
+/// @} APP
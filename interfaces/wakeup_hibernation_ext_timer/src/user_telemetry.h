@@ -0,0 +1,167 @@
+/**
+ ****************************************************************************************
+ *
+ * @file user_telemetry.h
+ *
+ * @brief Delta encoded telemetry history header file.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+#ifndef _USER_TELEMETRY_H_
+#define _USER_TELEMETRY_H_
+
+/**
+ ****************************************************************************************
+ * @addtogroup APP
+ * @{
+ ****************************************************************************************
+ */
+
+/*
+ * The beacon takes one sample of the battery voltage and the die temperature on every
+ * wake-up and keeps the last TELEMETRY_HISTORY_LEN of them in a retained history. Each
+ * sample gets a 16-bit sequence number. The advertised payload carries the newest sample
+ * in full, followed by as many older samples as fit, each one delta encoded against the
+ * next newer one. A scanner that misses some wake-ups rebuilds the gap from the next
+ * payload it receives.
+ *
+ * Payload format, multi-byte fields are little endian:
+ *
+ *   byte 0      bits 7-4: TELEMETRY_FORMAT, bits 3-0: number of older samples
+ *   byte 1-2    sequence number of the newest sample
+ *   byte 3-4    battery voltage of the newest sample in mV
+ *   byte 5      die temperature of the newest sample in degrees Celsius, signed
+ *   byte 6-     older samples, newest first, as a stream of 4-bit codes packed high
+ *               nibble first. The last byte is padded with a zero nibble.
+ *
+ * An older sample is the battery code followed by the temperature code. With d the
+ * older value minus the newer one and z(d) = 2d for d >= 0 and -2d - 1 otherwise:
+ *
+ *   battery     0-13: z(d), 14: two more nibbles with d as int8, 15: four more nibbles
+ *               with the absolute value
+ *   temperature 0-14: z(d), 15: two more nibbles with the absolute value as int8
+ *
+ * tools/telemetry_decode.py decodes the payload and simulates the reconstruction under
+ * packet loss, its check command verifies the payloads of tools/telemetry_encode.c.
+ *
+ * This file has no SDK dependency and can be compiled on a host.
+ */
+
+/*
+ * INCLUDE FILES
+ ****************************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DEFINES
+ ****************************************************************************************
+ */
+
+/// Samples kept in the history, the count field of the payload limits the older samples
+/// to 15
+#define TELEMETRY_HISTORY_LEN           (16)
+
+/// Payload format version
+#define TELEMETRY_FORMAT                (1)
+
+/// Length of the fixed part of the payload
+#define TELEMETRY_HEADER_LEN            (6)
+
+/// Marks a history that has been initialized
+#define TELEMETRY_MAGIC                 (0x544C4D31UL)
+
+/*
+ * TYPE DEFINITIONS
+ ****************************************************************************************
+ */
+
+struct telemetry_sample
+{
+    /// Battery voltage in mV
+    uint16_t battery;
+    /// Die temperature in degrees Celsius
+    int8_t temperature;
+};
+
+struct telemetry_history
+{
+    /// TELEMETRY_MAGIC once initialized
+    uint32_t magic;
+    /// Sequence number of the newest sample
+    uint16_t seq;
+    /// Samples held
+    uint8_t count;
+    /// Index of the newest sample
+    uint8_t head;
+    struct telemetry_sample samples[TELEMETRY_HISTORY_LEN];
+};
+
+/*
+ * FUNCTION DECLARATIONS
+ ****************************************************************************************
+ */
+
+/**
+ ****************************************************************************************
+ * @brief Empties the history. The next sample gets sequence number 0.
+ * @param[in] hist      History.
+ ****************************************************************************************
+ */
+void telemetry_init(struct telemetry_history *hist);
+
+/**
+ ****************************************************************************************
+ * @brief Checks a history kept in uninitialized memory.
+ * @param[in] hist      History.
+ * @return True if it has been initialized and is consistent.
+ ****************************************************************************************
+ */
+bool telemetry_valid(const struct telemetry_history *hist);
+
+/**
+ ****************************************************************************************
+ * @brief Adds a sample as the newest one, the oldest is dropped when the history is full.
+ * @param[in] hist      History.
+ * @param[in] sample    New sample.
+ ****************************************************************************************
+ */
+void telemetry_add(struct telemetry_history *hist, const struct telemetry_sample *sample);
+
+/**
+ ****************************************************************************************
+ * @brief Encodes the newest samples into a payload.
+ * @param[in] hist      History, must hold at least one sample.
+ * @param[out] buf      Payload buffer.
+ * @param[in] len       Size of the buffer, at least TELEMETRY_HEADER_LEN.
+ * @return Payload length, 0 if the history is empty or the buffer is too short.
+ ****************************************************************************************
+ */
+uint8_t telemetry_encode(const struct telemetry_history *hist, uint8_t *buf, uint8_t len);
+
+/// @} APP
+
+#endif // _USER_TELEMETRY_H_
@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+'''
+###########################################################################################
+# @file     :: telemetry_decode.py
+#
+# @brief    :: Decodes the telemetry payload of the wakeup_hibernation_ext_timer beacon and
+#              rebuilds the sample series from the payloads a scanner received.
+#
+#              Each input is the hex dump of the advertising data, or of the manufacturer
+#              specific data payload alone, one per argument or one per line on stdin:
+#                  python3 telemetry_decode.py 0303 0a18 1aff cdab 1c07 00ee 0b19 ...
+#                  python3 telemetry_decode.py < captured_adv_data.txt
+#
+#              The simulate command runs the encoder on a synthetic series, drops
+#              advertisements at random and reports how much of the series the decoder
+#              rebuilds for each payload size:
+#                  python3 telemetry_decode.py simulate --loss 0.2 0.5 0.8
+#
+#              The check command reads the payloads encoded on a host by the C encoder,
+#              tools/telemetry_encode.c, decodes them and encodes them again:
+#                  ./telemetry_encode | python3 telemetry_decode.py check
+#
+#              The payload format is described in src/user_telemetry.h.
+#
+# Copyright (c) 2026 Renesas Electronics Corporation and/or its affiliates
+# The MIT License (MIT)
+###########################################################################################
+'''
+
+import argparse
+import random
+import struct
+import sys
+
+COMPANY_ID = 0xABCD
+AD_TYPE_MANU_SPECIFIC_DATA = 0xFF
+
+FORMAT = 1
+HEADER_LEN = 6
+HISTORY_LEN = 16
+OLDER_MAX = 15
+
+BATTERY_SMALL_MAX = 13
+BATTERY_DELTA8 = 14
+BATTERY_ABSOLUTE = 15
+TEMPERATURE_SMALL_MAX = 14
+TEMPERATURE_ABSOLUTE = 15
+
+# Manufacturer specific data payload in the advertising data of the beacon
+PAYLOAD_LEN = 20
+
+
+def zigzag(d):
+    return 2 * d if d >= 0 else -2 * d - 1
+
+
+def unzigzag(z):
+    return z // 2 if z % 2 == 0 else -(z + 1) // 2
+
+
+def int8(v):
+    v &= 0xFF
+    return v - 0x100 if v & 0x80 else v
+
+
+class NibbleReader(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def get(self, count=1):
+        value = 0
+        for _ in range(count):
+            if self.pos // 2 >= len(self.data):
+                raise ValueError('payload truncated')
+            byte = self.data[self.pos // 2]
+            value = (value << 4) | ((byte & 0x0F) if self.pos & 1 else (byte >> 4))
+            self.pos += 1
+        return value
+
+
+class NibbleWriter(object):
+    def __init__(self):
+        self.nibbles = []
+
+    def put(self, value, count=1):
+        for shift in range(4 * (count - 1), -4, -4):
+            self.nibbles.append((value >> shift) & 0x0F)
+
+    def data(self):
+        nibbles = self.nibbles + [0] * (len(self.nibbles) & 1)
+        return bytes((nibbles[i] << 4) | nibbles[i + 1] for i in range(0, len(nibbles), 2))
+
+
+def older_cost(newer, older):
+    db = older[0] - newer[0]
+    dt = older[1] - newer[1]
+    if zigzag(db) <= BATTERY_SMALL_MAX:
+        cost = 1
+    elif -128 <= db <= 127:
+        cost = 3
+    else:
+        cost = 5
+    return cost + (1 if zigzag(dt) <= TEMPERATURE_SMALL_MAX else 3)
+
+
+def encode(seq, samples, length=PAYLOAD_LEN):
+    '''Mirror of telemetry_encode(). samples are (battery mV, temperature C), newest first.'''
+    wr = NibbleWriter()
+    room = 2 * (length - HEADER_LEN)
+    older = 0
+    while older < OLDER_MAX and older + 1 < len(samples):
+        newer, sample = samples[older], samples[older + 1]
+        if len(wr.nibbles) + older_cost(newer, sample) > room:
+            break
+        db = sample[0] - newer[0]
+        dt = sample[1] - newer[1]
+        if zigzag(db) <= BATTERY_SMALL_MAX:
+            wr.put(zigzag(db))
+        elif -128 <= db <= 127:
+            wr.put(BATTERY_DELTA8)
+            wr.put(db & 0xFF, 2)
+        else:
+            wr.put(BATTERY_ABSOLUTE)
+            wr.put(sample[0], 4)
+        if zigzag(dt) <= TEMPERATURE_SMALL_MAX:
+            wr.put(zigzag(dt))
+        else:
+            wr.put(TEMPERATURE_ABSOLUTE)
+            wr.put(sample[1] & 0xFF, 2)
+        older += 1
+    header = struct.pack('<BHHb', (FORMAT << 4) | older, seq & 0xFFFF, samples[0][0], samples[0][1])
+    return header + wr.data()
+
+
+def decode(payload):
+    '''Returns the sequence number of the newest sample and the samples, newest first.'''
+    if len(payload) < HEADER_LEN:
+        raise ValueError('payload too short')
+    info, seq, battery, temperature = struct.unpack('<BHHb', payload[:HEADER_LEN])
+    if info >> 4 != FORMAT:
+        raise ValueError('unknown format %d' % (info >> 4))
+    samples = [(battery, temperature)]
+    rd = NibbleReader(payload[HEADER_LEN:])
+    for _ in range(info & 0x0F):
+        code = rd.get()
+        if code <= BATTERY_SMALL_MAX:
+            battery += unzigzag(code)
+        elif code == BATTERY_DELTA8:
+            battery += int8(rd.get(2))
+        else:
+            battery = rd.get(4)
+        code = rd.get()
+        if code <= TEMPERATURE_SMALL_MAX:
+            temperature += unzigzag(code)
+        else:
+            temperature = int8(rd.get(2))
+        samples.append((battery, temperature))
+    return seq, samples
+
+
+def find_payload(data):
+    '''Extracts the payload from advertising data, or takes the data as the payload.'''
+    pos = 0
+    while pos < len(data):
+        length = data[pos]
+        if length == 0 or pos + 1 + length > len(data):
+            break
+        if (length >= 3 and data[pos + 1] == AD_TYPE_MANU_SPECIFIC_DATA and
+                struct.unpack('<H', data[pos + 2:pos + 4])[0] == COMPANY_ID):
+            return data[pos + 4:pos + 1 + length]
+        pos += 1 + length
+    return data
+
+
+class Series(object):
+    '''Rebuilds the sample series, sequence numbers are unwrapped to 32 bits.'''
+
+    def __init__(self):
+        self.samples = {}
+        self.last = None
+
+    def feed(self, seq, samples):
+        if self.last is None:
+            self.last = seq
+        else:
+            delta = (seq - self.last) & 0xFFFF
+            # A large step back means the beacon was power cycled and restarted from 0
+            if delta >= 0x8000 and seq < HISTORY_LEN:
+                self.last = (self.last | 0xFFFF) + 1 + seq
+            elif delta >= 0x8000:
+                self.last -= 0x10000 - delta
+            else:
+                self.last += delta
+        for age, sample in enumerate(samples):
+            self.samples[self.last - age] = sample
+        return self.last
+
+    def gaps(self):
+        if not self.samples:
+            return []
+        out = []
+        keys = sorted(self.samples)
+        for a, b in zip(keys, keys[1:]):
+            if b - a > 1:
+                out.append((a + 1, b - 1))
+        return out
+
+
+def simulate(args):
+    rng = random.Random(args.seed)
+    sizes = range(HEADER_LEN, PAYLOAD_LEN + 1, 2)
+
+    # Battery drains slowly with a few mV of noise, the temperature drifts
+    series = []
+    battery, temperature = 3000.0, 22.0
+    for _ in range(args.count):
+        battery -= rng.uniform(0, 0.5)
+        temperature += rng.gauss(0, 0.3)
+        series.append((int(battery + rng.gauss(0, 3)), int(round(temperature))))
+
+    sys.stdout.write('loss  ' + ''.join('%7dB' % size for size in sizes) + '\n')
+    for loss in args.loss:
+        received = [rng.random() >= loss for _ in series]
+        rates = []
+        for size in sizes:
+            rebuilt = Series()
+            for seq, ok in enumerate(received):
+                if not ok:
+                    continue
+                history = series[max(0, seq - HISTORY_LEN + 1):seq + 1][::-1]
+                rebuilt.feed(*decode(encode(seq, history, size)))
+            good = sum(1 for seq, sample in rebuilt.samples.items()
+                       if 0 <= seq < len(series) and series[seq] == sample)
+            rates.append(100.0 * good / len(series))
+        sys.stdout.write('%4.2f  ' % loss + ''.join('%7.1f%%' % rate for rate in rates) + '\n')
+
+
+def check(lines):
+    '''Checks payloads of the C encoder: <size> <seq> <payload hex> <battery>,<temperature>;...'''
+    count = 0
+    errors = 0
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        size, seq, payload = int(fields[0]), int(fields[1]), bytes.fromhex(fields[2])
+        held = [tuple(int(v) for v in sample.split(','))
+                for sample in fields[3].strip(';').split(';')] if len(fields) > 3 else []
+        try:
+            got_seq, samples = decode(payload)
+        except ValueError as e:
+            got_seq, samples = None, str(e)
+        if got_seq != seq or samples != held[:len(samples)]:
+            sys.stderr.write('%s: decoded %s %s\n' % (line.strip(), got_seq, samples))
+            errors += 1
+        elif encode(seq, held, size) != payload:
+            sys.stderr.write('%s: encoded %s\n' % (line.strip(), encode(seq, held, size).hex()))
+            errors += 1
+        count += 1
+    sys.stdout.write('%d payloads, %d errors\n' % (count, errors))
+    return 1 if errors or not count else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the hibernation timer beacon telemetry.')
+    sub = parser.add_subparsers(dest='command')
+    sim = sub.add_parser('simulate', help='report the reconstruction rate against payload size')
+    sim.add_argument('--loss', type=float, nargs='+', default=[0.1, 0.3, 0.5, 0.7, 0.9],
+                     help='advertisement loss ratios')
+    sim.add_argument('--count', type=int, default=10000, help='samples in the series')
+    sim.add_argument('--seed', type=int, default=1)
+    sub.add_parser('check', help='check the payloads of tools/telemetry_encode.c read on stdin')
+    args, hex_args = parser.parse_known_args()
+
+    if args.command == 'simulate':
+        simulate(args)
+        return
+    if args.command == 'check':
+        sys.exit(check(sys.stdin))
+
+    lines = [' '.join(hex_args)] if hex_args else sys.stdin
+    rebuilt = Series()
+    for line in lines:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            seq, samples = decode(find_payload(bytes.fromhex(line)))
+        except ValueError as e:
+            sys.stderr.write('%s: %s\n' % (line, e))
+            continue
+        last = rebuilt.feed(seq, samples)
+        for age, (battery, temperature) in enumerate(samples):
+            sys.stdout.write('%8d  %5d mV  %4d C\n' % (last - age, battery, temperature))
+    for first, last in rebuilt.gaps():
+        sys.stderr.write('missing %d-%d\n' % (first, last))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,159 @@
+/**
+ ****************************************************************************************
+ *
+ * @file telemetry_encode.c
+ *
+ * @brief Host driver of the telemetry encoder, its payloads are checked by telemetry_decode.py.
+ *
+ * Copyright (C) 2026 Renesas Electronics Corporation and/or its affiliates
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ * OR OTHER DEALINGS IN THE SOFTWARE.
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run from the example directory:
+ *
+ *   gcc -O2 -Isrc -o telemetry_encode tools/telemetry_encode.c src/user_telemetry.c
+ *   ./telemetry_encode | python3 tools/telemetry_decode.py check
+ *
+ * A series of samples is added to the history with user_telemetry.c: slow battery drift
+ * with jumps that need the 8-bit and absolute escapes, temperature steps and the int8
+ * limits, the 16-bit sequence number wrapping. After each sample the history is encoded
+ * into payloads of 6, 13 and 20 bytes. Each payload is printed on one line with its
+ * buffer size, the sequence number of the newest sample and the samples held, newest
+ * first:
+ *
+ *   <size> <sequence number> <payload hex> <battery>,<temperature>;...
+ *
+ * The check command of telemetry_decode.py decodes every payload, compares it with the
+ * sequence number and the samples held and encodes the samples again with the Python encoder, which must give
+ * the same bytes. The program itself checks that no payload overruns its buffer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "user_telemetry.h"
+
+#define SERIES_LEN          (400)
+/// Sequence number set halfway, so that the series wraps
+#define SERIES_WRAP_SEQ     (0xFFF0)
+
+static const uint8_t payload_sizes[] = {TELEMETRY_HEADER_LEN, 13, 20};
+
+static int fails;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond))                                                        \
+        {                                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fails++;                                                        \
+        }                                                                   \
+    } while (0)
+
+static int clamp(int v, int lo, int hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+static void print_payloads(const struct telemetry_history *hist)
+{
+    for (unsigned i = 0; i < sizeof(payload_sizes); i++)
+    {
+        uint8_t buf[32] = {0};
+        uint8_t len = telemetry_encode(hist, buf, payload_sizes[i]);
+
+        CHECK(len >= TELEMETRY_HEADER_LEN && len <= payload_sizes[i]);
+        // Nothing written past the returned length
+        for (unsigned k = len; k < sizeof(buf); k++)
+        {
+            CHECK(buf[k] == 0);
+        }
+
+        printf("%d %u ", payload_sizes[i], hist->seq);
+        for (unsigned k = 0; k < len; k++)
+        {
+            printf("%02x", buf[k]);
+        }
+        printf(" ");
+        for (unsigned age = 0; age < hist->count; age++)
+        {
+            const struct telemetry_sample *s =
+                &hist->samples[(hist->head + TELEMETRY_HISTORY_LEN - age) % TELEMETRY_HISTORY_LEN];
+
+            printf("%d,%d;", s->battery, s->temperature);
+        }
+        printf("\n");
+    }
+}
+
+int main(void)
+{
+    struct telemetry_history hist;
+    int battery = 3000, temperature = 22;
+
+    telemetry_init(&hist);
+    CHECK(telemetry_valid(&hist));
+    srand(3);
+
+    for (int i = 0; i < SERIES_LEN; i++)
+    {
+        struct telemetry_sample sample;
+        int r = rand() % 20;
+
+        if (i == SERIES_LEN / 2)
+        {
+            hist.seq = SERIES_WRAP_SEQ;
+        }
+
+        // Mostly small steps, some that need the 8-bit delta, a few absolute values
+        if (r == 0)
+        {
+            battery += rand() % 600 - 300;
+        }
+        else if (r < 3)
+        {
+            battery += rand() % 100 - 50;
+        }
+        else
+        {
+            battery += rand() % 9 - 4;
+        }
+        if (rand() % 10 == 0)
+        {
+            temperature += rand() % 120 - 60;
+        }
+        else
+        {
+            temperature += rand() % 3 - 1;
+        }
+        battery = clamp(battery, 0, UINT16_MAX);
+        temperature = clamp(temperature, INT8_MIN, INT8_MAX);
+
+        sample.battery = (uint16_t)battery;
+        sample.temperature = (int8_t)temperature;
+        telemetry_add(&hist, &sample);
+        CHECK(telemetry_valid(&hist));
+        print_payloads(&hist);
+    }
+
+    return fails != 0;
+}